@@ -0,0 +1,133 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+
+#include "common/log/log.h"
+#include "storage/clog/clog.h"
+#include "storage/record/record.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/*
+ * 多个线程同时提交事务时的提交吞吐量。
+ * 每个事务写一条数据日志和一条提交日志，提交时要等日志落盘。
+ * 组提交让一个leader线程一次write+一次fsync把所有等待中的日志都写下去，
+ * 等待窗口大于0时leader会先等一会儿，让更多的事务加入同一批。
+ * 异步提交(AsyncCommit)不等日志落盘，日志由后台线程定期刷盘，用来对比fsync的开销。
+ */
+
+struct TestRecord
+{
+  int32_t int_fields[15];
+};
+
+class GroupCommitBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    LoggerFactory::init_default("clog_group_commit.log", LOG_LEVEL_WARN);
+
+    filesystem::remove_all(path_);
+    filesystem::create_directories(path_);
+
+    log_manager_ = make_unique<CLogManager>();
+    RC rc        = log_manager_->init(path_.c_str());
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init clog manager");
+    }
+    log_manager_->set_group_commit_window(static_cast<int>(state.range(0)));
+  }
+
+  void TearDown(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    log_manager_.reset();
+    filesystem::remove_all(path_);
+  }
+
+  void Commit(int64_t trx_id, bool durable = true)
+  {
+    TestRecord record{};
+    RID        rid(1, trx_id % 100);
+    RC         rc = log_manager_->append_log(CLogType::INSERT,
+        trx_id,
+        1 /*table_id*/,
+        rid,
+        static_cast<int32_t>(sizeof(record)),
+        0 /*data_offset*/,
+        reinterpret_cast<const char *>(&record));
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to append log");
+    }
+
+    rc = log_manager_->commit_trx(trx_id, trx_id, nullptr /*lsn*/, durable);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to commit trx");
+    }
+  }
+
+protected:
+  string                  path_ = "clog_group_commit";
+  unique_ptr<CLogManager> log_manager_;
+};
+
+BENCHMARK_DEFINE_F(GroupCommitBenchmark, Commit)(State &state)
+{
+  int64_t trx_id = static_cast<int64_t>(state.thread_index()) << 20;
+  for (auto _ : state) {
+    Commit(++trx_id);
+  }
+
+  state.counters["commits"] = Counter(static_cast<double>(state.iterations()), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(GroupCommitBenchmark, Commit)
+    ->ArgName("window_us")
+    ->Arg(0)
+    ->Arg(100)
+    ->Arg(1000)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_DEFINE_F(GroupCommitBenchmark, AsyncCommit)(State &state)
+{
+  int64_t trx_id = static_cast<int64_t>(state.thread_index()) << 20;
+  for (auto _ : state) {
+    Commit(++trx_id, false /*durable*/);
+  }
+
+  state.counters["commits"] = Counter(static_cast<double>(state.iterations()), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(GroupCommitBenchmark, AsyncCommit)
+    ->ArgName("window_us")
+    ->Arg(0)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,169 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "common/global_context.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/clog/clog.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/*
+ * 恢复时重做日志的耗时与重做线程数的关系。
+ * 先建好几张空表并做一次 checkpoint，然后插入数据。数据页面分配时就已经写到了磁盘，但是插入的数据都还在
+ * buffer pool中，这时把数据库目录拷贝出来，就相当于进程在这里崩溃了，每次恢复时所有的插入都需要重做。
+ * 线程数为0时由读日志的线程自己重做，大于0时按照页面分发给多个线程并行重做。
+ */
+
+once_flag         init_flag;
+BufferPoolManager bpm{16384};
+
+static const char  *DB_NAME       = "sys";
+static const int    TABLE_NUM     = 4;
+static const int    RECORD_NUM    = 100 * 1000;
+static const int    TRX_SIZE      = 1000;  ///< 每个事务插入的记录数
+static const string BASE_PATH     = "clog_redo/base";
+static const string SNAPSHOT_PATH = "clog_redo/snapshot";
+static const string RUN_PATH      = "clog_redo/run";
+
+/**
+ * @brief 生成日志已经落盘、数据页面还没有写到磁盘的数据库目录
+ */
+static void prepare_snapshot()
+{
+  filesystem::remove_all("clog_redo");
+  filesystem::create_directories(BASE_PATH);
+
+  unique_ptr<Db> db = make_unique<Db>();
+  if (db->init(DB_NAME, BASE_PATH.c_str()) != RC::SUCCESS) {
+    throw runtime_error("failed to init db");
+  }
+
+  AttrInfoSqlNode attrs[3];
+  attrs[0] = AttrInfoSqlNode{INTS, "id", 4, ""};
+  attrs[1] = AttrInfoSqlNode{CHARS, "name", 16, ""};
+  attrs[2] = AttrInfoSqlNode{INTS, "v", 4, ""};
+  for (int i = 0; i < TABLE_NUM; i++) {
+    const string table_name = "t" + to_string(i);
+    if (db->create_table(table_name.c_str(), 3, attrs) != RC::SUCCESS) {
+      throw runtime_error("failed to create table");
+    }
+  }
+
+  if (db->sync() != RC::SUCCESS) {
+    throw runtime_error("failed to sync db");
+  }
+
+  TrxKit *trx_kit = GCTX.trx_kit_;
+  Trx    *trx     = nullptr;
+  for (int i = 0; i < RECORD_NUM; i++) {
+    if (nullptr == trx) {
+      trx = trx_kit->create_trx(db->clog_manager());
+      trx->start_if_need();
+    }
+
+    const string table_name = "t" + to_string(i % TABLE_NUM);
+    Table       *table      = db->find_table(table_name.c_str());
+    const string name       = "name" + to_string(i);
+    Value        values[3]  = {Value(i), Value(name.c_str()), Value(i * 7)};
+    Record       record;
+    if (table->make_record(3, values, record) != RC::SUCCESS || trx->insert_record(table, record) != RC::SUCCESS) {
+      throw runtime_error("failed to insert record");
+    }
+
+    if ((i + 1) % TRX_SIZE == 0 || i + 1 == RECORD_NUM) {
+      if (trx->commit() != RC::SUCCESS) {
+        throw runtime_error("failed to commit trx");
+      }
+      trx_kit->destroy_trx(trx);
+      trx = nullptr;
+    }
+  }
+
+  // 提交时日志已经落盘了，数据页面都还在 buffer pool 中
+  filesystem::copy(BASE_PATH, SNAPSHOT_PATH, filesystem::copy_options::recursive);
+  db.reset();
+}
+
+class RedoBenchmark : public Fixture
+{
+public:
+  ~RedoBenchmark() override { BufferPoolManager::set_instance(nullptr); }
+
+  void SetUp(const State &state) override
+  {
+    std::call_once(init_flag, []() {
+      LoggerFactory::init_default("clog_redo.log", LOG_LEVEL_WARN);
+      BufferPoolManager::set_instance(&bpm);
+      TrxKit::init_global("mvcc");
+      GCTX.trx_kit_ = TrxKit::instance();
+      prepare_snapshot();
+    });
+
+    GCTX.redo_worker_num_ = static_cast<int>(state.range(0));
+  }
+
+  void TearDown(const State &) override
+  {
+    GCTX.redo_worker_num_ = 0;
+    filesystem::remove_all(RUN_PATH);
+  }
+
+  void Recover()
+  {
+    unique_ptr<Db> db = make_unique<Db>();
+    RC             rc = db->init(DB_NAME, RUN_PATH.c_str());
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to recover db");
+    }
+  }
+};
+
+BENCHMARK_DEFINE_F(RedoBenchmark, Recover)(State &state)
+{
+  for (auto _ : state) {
+    state.PauseTiming();
+    filesystem::remove_all(RUN_PATH);
+    filesystem::copy(SNAPSHOT_PATH, RUN_PATH, filesystem::copy_options::recursive);
+    state.ResumeTiming();
+
+    Recover();
+  }
+
+  state.counters["records"] = Counter(static_cast<double>(RECORD_NUM) * state.iterations(), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(RedoBenchmark, Recover)
+    ->ArgName("workers")
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,252 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <stdexcept>
+#include <string.h>
+
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/common/condition_filter.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table_meta.h"
+#include "storage/trx/vacuous_trx.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/*
+ * 对比行存、不编码的PAX以及编码后的PAX三种页面格式的磁盘占用(页面个数)和扫描速度。
+ * 表结构为 (id int, status char(8), category char(8), v int)：
+ * - id 是连续的整数，使用FOR编码
+ * - status 只有几个不同的值，使用字典编码
+ * - category 按照插入顺序成片出现，使用RLE编码
+ * - v 是随机数，不编码
+ * 扫描时带有条件 status = 'status1'，分别测试条件只由上层过滤，以及条件下推到页面上计算两种情况。
+ */
+
+once_flag         init_flag;
+BufferPoolManager bpm{4096};
+
+enum class PageFormat
+{
+  ROW,
+  PAX_PLAIN,
+  PAX_ENCODED,
+};
+
+static const int  STATUS_NUM       = 8;
+static const int  CATEGORY_RUN_LEN = 1000;
+static const char QUERY_STATUS[]   = "status1";
+
+struct TestRecord
+{
+  int32_t id;
+  char    status[8];
+  char    category[8];
+  int32_t v;
+};
+
+class StatusConditionFilter : public ConditionFilter
+{
+public:
+  bool filter(const Record &rec) const override
+  {
+    const TestRecord *record = reinterpret_cast<const TestRecord *>(rec.data());
+    return 0 == strncmp(record->status, QUERY_STATUS, sizeof(record->status));
+  }
+};
+
+class ColumnEncodingBenchmark : public Fixture
+{
+public:
+  ~ColumnEncodingBenchmark() override { BufferPoolManager::set_instance(nullptr); }
+
+  void SetUp(const State &state) override
+  {
+    format_     = static_cast<PageFormat>(state.range(0));
+    record_num_ = static_cast<int>(state.range(1));
+
+    string name      = "column_encoding_" + to_string(state.range(0));
+    record_filename_ = name + ".record";
+    LoggerFactory::init_default((name + ".log").c_str(), LOG_LEVEL_WARN);
+
+    std::call_once(init_flag, []() {
+      BufferPoolManager::set_instance(&bpm);
+      TrxKit::init_global("vacuous");
+    });
+
+    init_table_meta();
+
+    ::remove(record_filename_.c_str());
+    RC rc = bpm.create_file(record_filename_.c_str());
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to create record buffer pool file.");
+    }
+
+    rc = bpm.open_file(record_filename_.c_str(), buffer_pool_);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to open record file");
+    }
+
+    rc = handler_.init(buffer_pool_, &table_meta_);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init record file handler");
+    }
+
+    FillUp();
+  }
+
+  void TearDown(const State &) override
+  {
+    handler_.close();
+    bpm.close_file(record_filename_.c_str());
+    buffer_pool_ = nullptr;
+    ::remove(record_filename_.c_str());
+  }
+
+  void init_table_meta()
+  {
+    AttrInfoSqlNode attrs[4];
+    attrs[0] = AttrInfoSqlNode{INTS, "id", sizeof(int32_t), ""};
+    attrs[1] = AttrInfoSqlNode{CHARS, "status", 8, ""};
+    attrs[2] = AttrInfoSqlNode{CHARS, "category", 8, ""};
+    attrs[3] = AttrInfoSqlNode{INTS, "v", sizeof(int32_t), ""};
+
+    StorageFormat storage_format = StorageFormat::ROW_FORMAT;
+    if (format_ != PageFormat::ROW) {
+      storage_format = StorageFormat::PAX_FORMAT;
+    }
+    if (format_ == PageFormat::PAX_ENCODED) {
+      attrs[0].encoding = "for";
+      attrs[1].encoding = "dict";
+      attrs[2].encoding = "rle";
+    }
+
+    RC rc = table_meta_.init(0, "t", 4, attrs, storage_format);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init table meta");
+    }
+  }
+
+  void FillUp()
+  {
+    mt19937    random_generator(0);
+    TestRecord record;
+    RID        rid;
+    for (int i = 0; i < record_num_; i++) {
+      memset(&record, 0, sizeof(record));
+      record.id = i;
+      snprintf(record.status, sizeof(record.status), "status%d", static_cast<int>(random_generator() % STATUS_NUM));
+      snprintf(record.category, sizeof(record.category), "cat%d", (i / CATEGORY_RUN_LEN) % 1000);
+      record.v = static_cast<int32_t>(random_generator());
+
+      RC rc = handler_.insert_record(reinterpret_cast<const char *>(&record), sizeof(record), &rid);
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to insert record");
+      }
+    }
+  }
+
+  int64_t PageCount() const
+  {
+    BufferPoolIterator iterator;
+    iterator.init(*buffer_pool_);
+
+    int64_t count = 0;
+    while (iterator.has_next()) {
+      iterator.next();
+      count++;
+    }
+    return count;
+  }
+
+  int64_t Scan(bool push_down)
+  {
+    StatusConditionFilter condition_filter;
+    ColumnFilter          column_filter;
+    if (push_down) {
+      // 第0列是id，status是第1列
+      column_filter.add_condition(1, EQUAL_TO, Value(QUERY_STATUS));
+    }
+
+    RecordFileScanner scanner;
+    VacuousTrx        trx;
+    scanner.set_column_filter(&column_filter);
+    RC rc = scanner.open_scan(nullptr /*table*/, *buffer_pool_, &trx, true /*readonly*/, &condition_filter, &handler_);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to open scan");
+    }
+
+    int64_t count = 0;
+    Record  record;
+    while (scanner.has_next()) {
+      rc = scanner.next(record);
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to get record");
+      }
+      count++;
+    }
+    scanner.close_scan();
+    return count;
+  }
+
+protected:
+  PageFormat        format_     = PageFormat::ROW;
+  int               record_num_ = 0;
+  string            record_filename_;
+  TableMeta         table_meta_;
+  DiskBufferPool   *buffer_pool_ = nullptr;
+  RecordFileHandler handler_;
+};
+
+static void ScanArguments(internal::Benchmark *benchmark)
+{
+  for (PageFormat format : {PageFormat::ROW, PageFormat::PAX_PLAIN, PageFormat::PAX_ENCODED}) {
+    benchmark->Args({static_cast<int64_t>(format), 100 * 1000});
+  }
+  benchmark->ArgNames({"format", "records"});
+}
+
+BENCHMARK_DEFINE_F(ColumnEncodingBenchmark, FullScan)(State &state)
+{
+  int64_t matched = 0;
+  for (auto _ : state) {
+    matched = Scan(false /*push_down*/);
+  }
+
+  state.counters["pages"]   = Counter(static_cast<double>(PageCount()));
+  state.counters["matched"] = Counter(static_cast<double>(matched));
+  state.counters["records"] = Counter(static_cast<double>(record_num_) * state.iterations(), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(ColumnEncodingBenchmark, FullScan)->Apply(ScanArguments)->Unit(kMillisecond);
+
+BENCHMARK_DEFINE_F(ColumnEncodingBenchmark, PushDownScan)(State &state)
+{
+  int64_t matched = 0;
+  for (auto _ : state) {
+    matched = Scan(true /*push_down*/);
+  }
+
+  state.counters["pages"]   = Counter(static_cast<double>(PageCount()));
+  state.counters["matched"] = Counter(static_cast<double>(matched));
+  state.counters["records"] = Counter(static_cast<double>(record_num_) * state.iterations(), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(ColumnEncodingBenchmark, PushDownScan)->Apply(ScanArguments)->Unit(kMillisecond);
+
+BENCHMARK_MAIN();
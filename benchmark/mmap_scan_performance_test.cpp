@@ -0,0 +1,208 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <stdexcept>
+#include <string.h>
+
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/mapped_file.h"
+#include "storage/record/record_manager.h"
+#include "storage/trx/vacuous_trx.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/*
+ * 对比只读扫描时经过buffer pool与直接读取映射文件的速度。
+ * 数据写完之后刷到磁盘，两种方式读取的是同样的页面：
+ * - buffer pool：每个页面都要在frame manager中查找、pin、加读锁，第一次访问时还要从文件复制到frame
+ * - mmap：直接访问page cache中的页面，不需要复制和加锁
+ */
+
+once_flag         init_flag;
+BufferPoolManager bpm{4096};
+
+enum class ScanMode
+{
+  BUFFER_POOL,
+  MMAP,
+};
+
+struct TestRecord
+{
+  int32_t id;
+  char    name[16];
+  int32_t v;
+};
+
+class MmapScanBenchmark : public Fixture
+{
+public:
+  ~MmapScanBenchmark() override { BufferPoolManager::set_instance(nullptr); }
+
+  void SetUp(const State &state) override
+  {
+    mode_       = static_cast<ScanMode>(state.range(0));
+    record_num_ = static_cast<int>(state.range(1));
+
+    string name      = "mmap_scan_" + to_string(state.range(0));
+    record_filename_ = name + ".record";
+    LoggerFactory::init_default((name + ".log").c_str(), LOG_LEVEL_WARN);
+
+    std::call_once(init_flag, []() {
+      BufferPoolManager::set_instance(&bpm);
+      TrxKit::init_global("vacuous");
+    });
+
+    ::remove(record_filename_.c_str());
+    RC rc = bpm.create_file(record_filename_.c_str());
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to create record buffer pool file.");
+    }
+
+    rc = bpm.open_file(record_filename_.c_str(), buffer_pool_);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to open record file");
+    }
+
+    rc = handler_.init(buffer_pool_);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init record file handler");
+    }
+
+    FillUp();
+
+    rc = buffer_pool_->flush_all_pages();
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to flush record file");
+    }
+
+    if (mode_ == ScanMode::MMAP) {
+      mapped_file_ = make_shared<MappedFile>();
+      rc           = mapped_file_->open(record_filename_.c_str());
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to map record file");
+      }
+    }
+  }
+
+  void TearDown(const State &) override
+  {
+    mapped_file_.reset();
+    handler_.close();
+    bpm.close_file(record_filename_.c_str());
+    buffer_pool_ = nullptr;
+    ::remove(record_filename_.c_str());
+  }
+
+  void FillUp()
+  {
+    TestRecord record;
+    RID        rid;
+    for (int i = 0; i < record_num_; i++) {
+      memset(&record, 0, sizeof(record));
+      record.id = i;
+      snprintf(record.name, sizeof(record.name), "name%d", i);
+      record.v = i * 7;
+
+      RC rc = handler_.insert_record(reinterpret_cast<const char *>(&record), sizeof(record), &rid);
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to insert record");
+      }
+    }
+  }
+
+  int64_t Scan()
+  {
+    RecordFileScanner scanner;
+    VacuousTrx        trx;
+    scanner.set_mapped_file(mapped_file_);
+    RC rc = scanner.open_scan(nullptr /*table*/, *buffer_pool_, &trx, true /*readonly*/, nullptr /*condition*/, &handler_);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to open scan");
+    }
+
+    int64_t sum = 0;
+    Record  record;
+    while (scanner.has_next()) {
+      rc = scanner.next(record);
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to get record");
+      }
+      sum += reinterpret_cast<const TestRecord *>(record.data())->v;
+    }
+    scanner.close_scan();
+    return sum;
+  }
+
+protected:
+  ScanMode               mode_       = ScanMode::BUFFER_POOL;
+  int                    record_num_ = 0;
+  string                 record_filename_;
+  DiskBufferPool        *buffer_pool_ = nullptr;
+  RecordFileHandler      handler_;
+  shared_ptr<MappedFile> mapped_file_;
+};
+
+static void ScanArguments(internal::Benchmark *benchmark)
+{
+  for (ScanMode mode : {ScanMode::BUFFER_POOL, ScanMode::MMAP}) {
+    for (int64_t record_num : {100 * 1000, 1000 * 1000}) {
+      benchmark->Args({static_cast<int64_t>(mode), record_num});
+    }
+  }
+  benchmark->ArgNames({"mmap", "records"});
+}
+
+BENCHMARK_DEFINE_F(MmapScanBenchmark, FullScan)(State &state)
+{
+  int64_t sum = 0;
+  for (auto _ : state) {
+    sum = Scan();
+    DoNotOptimize(sum);
+  }
+
+  state.counters["records"] = Counter(static_cast<double>(record_num_) * state.iterations(), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(MmapScanBenchmark, FullScan)->Apply(ScanArguments)->Unit(kMillisecond);
+
+/*
+ * 冷数据扫描：每次扫描前都把页面从buffer pool中清掉，buffer pool需要重新从文件读取每个页面
+ */
+BENCHMARK_DEFINE_F(MmapScanBenchmark, ColdScan)(State &state)
+{
+  int64_t sum = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    RC rc = buffer_pool_->purge_all_pages();
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to purge pages");
+    }
+    state.ResumeTiming();
+
+    sum = Scan();
+    DoNotOptimize(sum);
+  }
+
+  state.counters["records"] = Counter(static_cast<double>(record_num_) * state.iterations(), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(MmapScanBenchmark, ColdScan)->Apply(ScanArguments)->Unit(kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,179 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "common/log/log.h"
+#include "storage/trx/mvcc_trx.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/*
+ * 事务表的并发性能。
+ * BeginCommit 每个线程不断地开始、提交一个不修改数据的事务，并像提交之后清理旧版本那样查询一次最老的事务号，
+ * 结果是不同线程数下的开始/提交吞吐量。
+ * BeginCommitWithRunning 与 BeginCommit 相同，只是先开始若干个(参数)一直不结束的事务，
+ * 开始和提交的开销不应该随着正在运行的事务数增长。
+ * ReadOnlyBeginEnd 与 BeginCommit 相同，只是开始和结束的是只读事务。
+ * FindTrx 事务表中有若干个正在运行的事务(参数)，多个线程按照事务号查找事务。
+ */
+
+class TrxKitBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    LoggerFactory::init_default("trx_kit_performance.log", LOG_LEVEL_WARN);
+
+    trx_kit_ = make_unique<MvccTrxKit>();
+    RC rc    = trx_kit_->init();
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init trx kit");
+    }
+    trxes_.assign(state.threads(), nullptr);
+  }
+
+  void TearDown(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    for (Trx *trx : trxes_) {
+      if (trx != nullptr) {
+        trx_kit_->destroy_trx(trx);
+      }
+    }
+    trxes_.clear();
+
+    for (const pair<int64_t, Trx *> &running_trx : running_trxes_) {
+      trx_kit_->abort_trx(running_trx.first);
+      trx_kit_->end_trx(running_trx.first);
+      delete running_trx.second;
+    }
+    running_trxes_.clear();
+    trx_kit_.reset();
+  }
+
+protected:
+  unique_ptr<MvccTrxKit>       trx_kit_;
+  vector<Trx *>                trxes_;          ///< 每个线程使用的事务对象
+  vector<pair<int64_t, Trx *>> running_trxes_;  ///< 一直不结束的事务以及它们的事务号
+};
+
+BENCHMARK_DEFINE_F(TrxKitBenchmark, BeginCommit)(State &state)
+{
+  // 只有0号线程会创建trx_kit_，其它线程开始计时之后才能使用它
+  for (auto _ : state) {
+    Trx *&trx = trxes_[state.thread_index()];
+    if (nullptr == trx) {
+      trx = trx_kit_->create_trx(nullptr /*log_manager*/);
+    }
+
+    ReadView read_view;
+    int64_t  trx_id = trx_kit_->begin_trx(trx, read_view);
+    trx_kit_->commit_trx(trx_id, trx_kit_->prepare_commit(trx_id), -1 /*commit_lsn*/);
+    trx_kit_->end_trx(trx_id);
+    DoNotOptimize(trx_kit_->oldest_active_trx_id());
+  }
+
+  state.counters["trxes"] = Counter(static_cast<double>(state.iterations()), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(TrxKitBenchmark, BeginCommit)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_DEFINE_F(TrxKitBenchmark, BeginCommitWithRunning)(State &state)
+{
+  if (0 == state.thread_index()) {
+    for (int64_t i = 0; i < state.range(0); i++) {
+      Trx     *trx = trx_kit_->create_trx(nullptr /*log_manager*/);
+      ReadView read_view;
+      running_trxes_.emplace_back(trx_kit_->begin_trx(trx, read_view), trx);
+    }
+  }
+
+  for (auto _ : state) {
+    Trx *&trx = trxes_[state.thread_index()];
+    if (nullptr == trx) {
+      trx = trx_kit_->create_trx(nullptr /*log_manager*/);
+    }
+
+    ReadView read_view;
+    int64_t  trx_id = trx_kit_->begin_trx(trx, read_view);
+    trx_kit_->commit_trx(trx_id, trx_kit_->prepare_commit(trx_id), -1 /*commit_lsn*/);
+    trx_kit_->end_trx(trx_id);
+    DoNotOptimize(trx_kit_->oldest_active_trx_id());
+  }
+
+  state.counters["trxes"] = Counter(static_cast<double>(state.iterations()), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(TrxKitBenchmark, BeginCommitWithRunning)
+    ->ArgName("running")
+    ->Arg(100)
+    ->Arg(10000)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_DEFINE_F(TrxKitBenchmark, ReadOnlyBeginEnd)(State &state)
+{
+  for (auto _ : state) {
+    ReadView read_view;
+    trx_kit_->begin_read_only_trx(read_view);
+    trx_kit_->end_read_only_trx(read_view);
+    DoNotOptimize(trx_kit_->oldest_active_trx_id());
+  }
+
+  state.counters["trxes"] = Counter(static_cast<double>(state.iterations()), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(TrxKitBenchmark, ReadOnlyBeginEnd)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_DEFINE_F(TrxKitBenchmark, FindTrx)(State &state)
+{
+  const int64_t trx_num = static_cast<int64_t>(state.range(0));
+  if (0 == state.thread_index()) {
+    // 恢复时按照事务号创建的事务会一直留在事务表中，直到被销毁
+    for (int64_t trx_id = 1; trx_id <= trx_num; trx_id++) {
+      trx_kit_->create_trx(trx_id);
+    }
+  }
+
+  mt19937                            random(state.thread_index());
+  uniform_int_distribution<int64_t> distribution(1, trx_num);
+  for (auto _ : state) {
+    DoNotOptimize(trx_kit_->find_trx(distribution(random)));
+  }
+
+  state.counters["finds"] = Counter(static_cast<double>(state.iterations()), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(TrxKitBenchmark, FindTrx)
+    ->ArgName("trxes")
+    ->Arg(100)
+    ->Arg(10000)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
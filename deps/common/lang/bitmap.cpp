@@ -77,9 +77,10 @@ int Bitmap::next_unsetted_bit(int start)
         ret = iter * 8 + index_in_byte;
         break;
       }
-
-      start_in_byte = 0;
     }
+
+    // 只有第一个字节需要从start_in_byte开始查找，后面的字节都要从头开始
+    start_in_byte = 0;
   }
 
   if (ret >= size_) {
@@ -100,9 +101,10 @@ int Bitmap::next_setted_bit(int start)
         ret = iter * 8 + index_in_byte;
         break;
       }
-
-      start_in_byte = 0;
     }
+
+    // 只有第一个字节需要从start_in_byte开始查找，后面的字节都要从头开始
+    start_in_byte = 0;
   }
 
   if (ret >= size_) {
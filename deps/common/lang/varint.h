@@ -0,0 +1,80 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include <stdint.h>
+
+namespace common {
+
+/**
+ * @brief 变长整数编码
+ * @details 每个字节存放7位数据，最高位表示后面是否还有字节，小的数字只需要很少的字节。
+ * 有符号数先做zigzag转换，让绝对值小的负数也只占用很少的字节。
+ */
+static const int MAX_VARINT_SIZE = 10;
+
+inline uint64_t zigzag_encode(int64_t value) { return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+
+inline int64_t zigzag_decode(uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+/**
+ * @brief 编码之后的长度
+ */
+inline int varint_size(uint64_t value)
+{
+  int size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+/**
+ * @brief 把数字编码到buf中，buf至少要有 MAX_VARINT_SIZE 个字节
+ * @return 编码之后的长度
+ */
+inline int encode_varint(char *buf, uint64_t value)
+{
+  uint8_t *ptr = reinterpret_cast<uint8_t *>(buf);
+  int      len = 0;
+  while (value >= 0x80) {
+    ptr[len++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  ptr[len++] = static_cast<uint8_t>(value);
+  return len;
+}
+
+/**
+ * @brief 从buf中解码一个数字
+ * @param len buf中可以读取的长度
+ * @return 读取的字节数，数据不完整或者不合法时返回0
+ */
+inline int decode_varint(const char *buf, int len, uint64_t &value)
+{
+  const uint8_t *ptr    = reinterpret_cast<const uint8_t *>(buf);
+  uint64_t       result = 0;
+  for (int i = 0; i < len && i < MAX_VARINT_SIZE; i++) {
+    result |= static_cast<uint64_t>(ptr[i] & 0x7f) << (7 * i);
+    if ((ptr[i] & 0x80) == 0) {
+      value = result;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+}  // namespace common
@@ -0,0 +1,90 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include "common/math/crc32c.h"
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+namespace common {
+
+/// CRC32C 多项式的反转表示
+static const uint32_t CRC32C_POLY = 0x82f63b78;
+
+struct Crc32cTable
+{
+  uint32_t table[256];
+
+  Crc32cTable()
+  {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (int j = 0; j < 8; j++) {
+        crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLY : 0);
+      }
+      table[i] = crc;
+    }
+  }
+};
+
+static uint32_t crc32c_software(uint32_t crc, const uint8_t *data, size_t len)
+{
+  static const Crc32cTable crc_table;
+  for (size_t i = 0; i < len; i++) {
+    crc = crc_table.table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) static uint32_t crc32c_sse42(uint32_t crc, const uint8_t *data, size_t len)
+{
+  uint64_t crc64 = crc;
+  for (; len >= 8; len -= 8, data += 8) {
+    uint64_t value;
+    __builtin_memcpy(&value, data, sizeof(value));
+    crc64 = _mm_crc32_u64(crc64, value);
+  }
+
+  uint32_t crc32 = static_cast<uint32_t>(crc64);
+  for (; len > 0; len--, data++) {
+    crc32 = _mm_crc32_u8(crc32, *data);
+  }
+  return crc32;
+}
+#endif
+
+using Crc32cFunc = uint32_t (*)(uint32_t, const uint8_t *, size_t);
+
+static Crc32cFunc choose_crc32c_func()
+{
+#if defined(__x86_64__)
+  if (__builtin_cpu_supports("sse4.2")) {
+    return crc32c_sse42;
+  }
+#endif
+  return crc32c_software;
+}
+
+static const Crc32cFunc crc32c_func = choose_crc32c_func();
+
+uint32_t crc32c_extend(uint32_t crc, const void *data, size_t len)
+{
+  return ~crc32c_func(~crc, reinterpret_cast<const uint8_t *>(data), len);
+}
+
+bool crc32c_hardware_accelerated() { return crc32c_func != crc32c_software; }
+
+}  // namespace common
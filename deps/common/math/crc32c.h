@@ -0,0 +1,39 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace common {
+
+/**
+ * @brief 计算CRC32C(Castagnoli)校验码
+ * @details 支持SSE4.2的CPU上使用crc32指令计算，否则使用查表的方式计算。
+ * 可以分段计算：crc32c_extend(crc32c(a), b) 等于 a 和 b 连在一起计算的结果。
+ * @param crc  前面的数据的校验码，第一段数据传0
+ * @param data 数据
+ * @param len  数据的长度
+ */
+uint32_t crc32c_extend(uint32_t crc, const void *data, size_t len);
+
+inline uint32_t crc32c(const void *data, size_t len) { return crc32c_extend(0, data, len); }
+
+/**
+ * @brief 当前是否使用硬件指令计算CRC32C
+ */
+bool crc32c_hardware_accelerated();
+
+}  // namespace common
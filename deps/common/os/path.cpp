@@ -153,6 +153,12 @@ bool check_directory(std::string &path)
     if (sep_state)
       continue;
 
+    // 绝对路径开头的 '/' 是根目录，不需要创建
+    if (0 == i) {
+      sep_state = true;
+      continue;
+    }
+
     path[i] = '\0';
     if (0 != mkdir(path.c_str(), 0777) && !is_directory(path.c_str()))
       return false;
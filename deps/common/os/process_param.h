@@ -76,6 +76,14 @@ public:
 
   int buffer_pool_memory_size() const { return buffer_pool_memory_size_; }
 
+  void set_redo_worker_num(int worker_num) { redo_worker_num_ = worker_num; }
+
+  int redo_worker_num() const { return redo_worker_num_; }
+
+  void set_clog_archive_path(const char *path) { clog_archive_path_ = path; }
+
+  const std::string &clog_archive_path() const { return clog_archive_path_; }
+
 private:
   std::string              std_out_;           // The output file
   std::string              std_err_;           // The err output file
@@ -88,6 +96,8 @@ private:
   std::string              protocol_;
   std::string              trx_kit_name_;
   int                      buffer_pool_memory_size_ = -1;
+  int                      redo_worker_num_         = 0;  // threads to redo logs while recovering
+  std::string              clog_archive_path_;             // directory to archive clog segments, empty means disabled
 };
 
 ProcessParam *&the_process_param();
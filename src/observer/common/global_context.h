@@ -14,6 +14,8 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <string>
+
 class BufferPoolManager;
 class DefaultHandler;
 class TrxKit;
@@ -27,6 +29,8 @@ struct GlobalContext
   BufferPoolManager *buffer_pool_manager_ = nullptr;
   DefaultHandler    *handler_             = nullptr;
   TrxKit            *trx_kit_             = nullptr;
+  int                redo_worker_num_     = 0;  ///< 恢复时并行重做日志的线程数，0表示不并行
+  std::string        clog_archive_path_;        ///< 日志归档的目录，为空时不归档
 
   static GlobalContext &instance();
 };
@@ -154,6 +154,9 @@ int init_global_objects(ProcessParam *process_param, Ini &properties)
   }
   GCTX.trx_kit_ = TrxKit::instance();
 
+  GCTX.redo_worker_num_   = process_param->redo_worker_num();
+  GCTX.clog_archive_path_ = process_param->clog_archive_path();
+
   rc = GCTX.handler_->init("miniob");
   if (OB_FAIL(rc)) {
     LOG_ERROR("failed to init handler. rc=%s", strrc(rc));
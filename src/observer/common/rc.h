@@ -44,6 +44,7 @@ See the Mulan PSL v2 for more details. */
   DEFINE_RC(SCHEMA_DB_NOT_OPENED)        \
   DEFINE_RC(SCHEMA_TABLE_NOT_EXIST)      \
   DEFINE_RC(SCHEMA_TABLE_EXIST)          \
+  DEFINE_RC(SCHEMA_TABLE_READ_ONLY)      \
   DEFINE_RC(SCHEMA_FIELD_NOT_EXIST)      \
   DEFINE_RC(SCHEMA_FIELD_MISSING)        \
   DEFINE_RC(SCHEMA_FIELD_TYPE_MISMATCH)  \
@@ -59,6 +60,9 @@ See the Mulan PSL v2 for more details. */
   DEFINE_RC(LOCKED_UNLOCK)               \
   DEFINE_RC(LOCKED_NEED_WAIT)            \
   DEFINE_RC(LOCKED_CONCURRENCY_CONFLICT) \
+  DEFINE_RC(LOCKED_WAIT_TIMEOUT)         \
+  DEFINE_RC(LOCKED_DEADLOCK)             \
+  DEFINE_RC(TRX_READ_ONLY)               \
   DEFINE_RC(FILE_EXIST)                  \
   DEFINE_RC(FILE_NOT_EXIST)              \
   DEFINE_RC(FILE_NAME)                   \
@@ -73,7 +77,8 @@ See the Mulan PSL v2 for more details. */
   DEFINE_RC(FILE_WRITE)                  \
   DEFINE_RC(VARIABLE_NOT_EXISTS)         \
   DEFINE_RC(VARIABLE_NOT_VALID)          \
-  DEFINE_RC(LOGBUF_FULL)
+  DEFINE_RC(LOGBUF_FULL)                 \
+  DEFINE_RC(LOG_CORRUPTED)
 
 enum class RC
 {
@@ -24,5 +24,25 @@ using PageNum = int32_t;
 /// 每一行(row/record)，都占用一个槽位(slot)，这些槽有一个编号，称为SlotNum
 using SlotNum = int32_t;
 
-/// LSN for log sequence number
-using LSN = int32_t;
+/// LSN for log sequence number。日志在日志流中的字节偏移
+using LSN = int64_t;
+
+/// 数据文件中页面的组织格式，创建表时指定
+/// ROW_FORMAT 按行存放，每条记录连续存放；PAX_FORMAT 页面内按列存放，每一列的数据连续存放在一个小页(minipage)中
+enum class StorageFormat
+{
+  UNKNOWN_FORMAT = 0,
+  ROW_FORMAT,
+  PAX_FORMAT
+};
+
+/// PAX格式的页面中，每一列可以选择的编码方式，创建表时指定
+/// PLAIN 不编码；DICT 页内字典编码；RLE 游程编码；FOR 以页内基准值为参照的位压缩(frame of reference)
+enum class ColumnEncoding
+{
+  UNKNOWN_ENCODING = 0,
+  PLAIN_ENCODING,
+  DICT_ENCODING,
+  RLE_ENCODING,
+  FOR_ENCODING
+};
@@ -43,6 +43,8 @@ void usage()
   cout << "-P: protocol. {plain(default), mysql, cli}." << endl;
   cout << "-t: transaction model. {vacuous(default), mvcc}." << endl;
   cout << "-n: buffer pool memory size in byte" << endl;
+  cout << "-r: number of threads to redo logs while recovering. 0(default) means redo in one thread" << endl;
+  cout << "-a: directory to archive full clog segments for point-in-time recovery. disabled if not specified" << endl;
 }
 
 void parse_parameter(int argc, char **argv)
@@ -56,7 +58,7 @@ void parse_parameter(int argc, char **argv)
   // Process args
   int          opt;
   extern char *optarg;
-  while ((opt = getopt(argc, argv, "dp:P:s:t:f:o:e:hn:")) > 0) {
+  while ((opt = getopt(argc, argv, "dp:P:s:t:f:o:e:hn:r:a:")) > 0) {
     switch (opt) {
       case 's': process_param->set_unix_socket_path(optarg); break;
       case 'p': process_param->set_server_port(atoi(optarg)); break;
@@ -66,6 +68,8 @@ void parse_parameter(int argc, char **argv)
       case 'e': process_param->set_std_err(optarg); break;
       case 't': process_param->set_trx_kit_name(optarg); break;
       case 'n': process_param->set_buffer_pool_memory_size(atoi(optarg)); break;
+      case 'r': process_param->set_redo_worker_num(atoi(optarg)); break;
+      case 'a': process_param->set_clog_archive_path(optarg); break;
       case 'h':
         usage();
         exit(0);
@@ -81,7 +81,7 @@ public:
 
 protected:
   Session        *session_ = nullptr;
-  struct event    read_event_;
+  struct event    read_event_ = {};
   std::string     addr_;
   BufferedWriter *writer_ = nullptr;
   int             fd_     = -1;
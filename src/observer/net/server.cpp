@@ -82,6 +82,20 @@ void Server::close_connection(Communicator *communicator)
   delete communicator;
 }
 
+void Server::resume_connection(Communicator *communicator)
+{
+  // 标准输入输出方式不使用libevent，没有需要恢复监听的事件
+  if (!event_initialized(&communicator->read_event())) {
+    return;
+  }
+
+  int ret = event_add(&communicator->read_event(), nullptr);
+  if (ret < 0) {
+    LOG_ERROR("Failed to event_add for read event of %s into libevent, %s", communicator->addr(), strerror(errno));
+    close_connection(communicator);
+  }
+}
+
 void Server::recv(int fd, short ev, void *arg)
 {
   Communicator *comm = (Communicator *)arg;
@@ -98,6 +112,9 @@ void Server::recv(int fd, short ev, void *arg)
     LOG_WARN("event is null while read event return success");
     return;
   }
+
+  // 请求处理完之前不再接收这个连接上的消息，包括对端关闭连接，处理完以后由 resume_connection 恢复
+  event_del(&comm->read_event());
   session_stage_->add_event(event);
 }
 
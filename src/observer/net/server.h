@@ -35,6 +35,13 @@ public:
   static void init();
   static void close_connection(Communicator *comm);
 
+  /**
+   * @brief 连接上的请求处理完以后，重新开始接收这个连接上的消息
+   * @details 请求交给会话线程处理期间不再监听这个连接，客户端在此期间断开连接时，要等请求处理完才会发现，
+   * 避免请求还在等待行锁时会话就被删除了。参考 Server::recv
+   */
+  static void resume_connection(Communicator *comm);
+
 public:
   int  serve();
   void shutdown();
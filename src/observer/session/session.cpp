@@ -68,10 +68,19 @@ Trx *Session::current_trx()
 {
   if (trx_ == nullptr) {
     trx_ = GCTX.trx_kit_->create_trx(db_->clog_manager());
+    trx_->set_async_commit(async_commit_);
   }
   return trx_;
 }
 
+void Session::set_async_commit(bool async_commit)
+{
+  async_commit_ = async_commit;
+  if (trx_ != nullptr) {
+    trx_->set_async_commit(async_commit);
+  }
+}
+
 thread_local Session *thread_session = nullptr;
 
 void Session::set_current_session(Session *session) { thread_session = session; }
@@ -79,6 +79,13 @@ public:
   void set_sql_debug(bool sql_debug) { sql_debug_ = sql_debug; }
   bool sql_debug_on() const { return sql_debug_; }
 
+  /**
+   * @brief 设置当前会话的事务是否异步提交
+   * @details 异步提交时不等待提交日志落盘，宕机时可能丢失最近提交的事务，参考 CLogManager::commit_trx
+   */
+  void set_async_commit(bool async_commit);
+  bool async_commit() const { return async_commit_; }
+
   /**
    * @brief 将指定会话设置到线程变量中
    *
@@ -98,5 +105,6 @@ private:
 
   bool trx_multi_operation_mode_ = false;  ///< 当前事务的模式，是否多语句模式. 单语句模式自动提交
 
-  bool sql_debug_ = false;  ///< 是否输出SQL调试信息
+  bool sql_debug_    = false;  ///< 是否输出SQL调试信息
+  bool async_commit_ = false;  ///< 提交事务时是否不等待日志落盘
 };
@@ -84,8 +84,11 @@ void SessionStage::handle_request(StageEvent *event)
     return;
   }
 
+  Communicator *communicator = sev->get_communicator();
+
   std::string sql = sev->query();
   if (common::is_blank(sql.c_str())) {
+    Server::resume_connection(communicator);
     return;
   }
 
@@ -94,15 +97,18 @@ void SessionStage::handle_request(StageEvent *event)
   SQLStageEvent sql_event(sev, sql);
   (void)handle_sql(&sql_event);
 
-  Communicator *communicator    = sev->get_communicator();
-  bool          need_disconnect = false;
-  RC            rc              = communicator->write_result(sev, need_disconnect);
+  bool need_disconnect = false;
+  RC   rc              = communicator->write_result(sev, need_disconnect);
   LOG_INFO("write result return %s", strrc(rc));
+  sev->session()->set_current_request(nullptr);
+  Session::set_current_session(nullptr);
+
+  // 关闭连接会删除会话，所以放在最后
   if (need_disconnect) {
     Server::close_connection(communicator);
+  } else {
+    Server::resume_connection(communicator);
   }
-  sev->session()->set_current_request(nullptr);
-  Session::set_current_session(nullptr);
 }
 
 /**
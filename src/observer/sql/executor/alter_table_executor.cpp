@@ -0,0 +1,40 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include "sql/executor/alter_table_executor.h"
+
+#include "common/log/log.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/stmt/alter_table_stmt.h"
+#include "storage/db/db.h"
+
+RC AlterTableExecutor::execute(SQLStageEvent *sql_event)
+{
+  Stmt    *stmt    = sql_event->stmt();
+  Session *session = sql_event->session_event()->session();
+  ASSERT(stmt->type() == StmtType::ALTER_TABLE,
+      "alter table executor can not run this command: %d",
+      static_cast<int>(stmt->type()));
+
+  AlterTableStmt *alter_table_stmt = static_cast<AlterTableStmt *>(stmt);
+
+  const char *table_name = alter_table_stmt->table_name().c_str();
+  RC          rc = session->get_current_db()->set_table_read_only(table_name, alter_table_stmt->read_only());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to alter table. table=%s, rc=%s", table_name, strrc(rc));
+  }
+  return rc;
+}
@@ -0,0 +1,65 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include <memory>
+
+#include "sql/executor/backup_executor.h"
+
+#include "common/log/log.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/operator/string_list_physical_operator.h"
+#include "sql/stmt/backup_stmt.h"
+#include "storage/db/db.h"
+#include "storage/db/db_backup.h"
+
+using namespace std;
+
+RC BackupExecutor::execute(SQLStageEvent *sql_event)
+{
+  Stmt         *stmt          = sql_event->stmt();
+  SessionEvent *session_event = sql_event->session_event();
+  Session      *session       = session_event->session();
+  ASSERT(stmt->type() == StmtType::BACKUP,
+      "backup executor can not run this command: %d",
+      static_cast<int>(stmt->type()));
+
+  BackupStmt *backup_stmt = static_cast<BackupStmt *>(stmt);
+  SqlResult  *sql_result  = session_event->sql_result();
+  Db         *db          = session->get_current_db();
+
+  BackupStat stat;
+  RC         rc = db->backup(backup_stmt->path().c_str(), stat);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to backup db. db=%s, path=%s, rc=%s", db->name(), backup_stmt->path().c_str(), strrc(rc));
+    return rc;
+  }
+
+  TupleSchema tuple_schema;
+  tuple_schema.append_cell("Variable_name");
+  tuple_schema.append_cell("Value");
+  sql_result->set_tuple_schema(tuple_schema);
+
+  auto oper = new StringListPhysicalOperator;
+  oper->append({"tables", to_string(stat.tables)});
+  oper->append({"data_bytes", to_string(stat.data_bytes)});
+  oper->append({"log_bytes", to_string(stat.log_bytes)});
+  oper->append({"checkpoint_lsn", to_string(stat.checkpoint_lsn)});
+  oper->append({"redo_lsn", to_string(stat.redo_lsn)});
+  oper->append({"end_lsn", to_string(stat.end_lsn)});
+  oper->append({"elapsed_ms", to_string(stat.elapsed_ms)});
+
+  sql_result->set_operator(unique_ptr<PhysicalOperator>(oper));
+  return RC::SUCCESS;
+}
@@ -19,11 +19,16 @@ See the Mulan PSL v2 for more details. */
 #include "sql/executor/create_table_executor.h"
 #include "sql/executor/desc_table_executor.h"
 #include "sql/executor/help_executor.h"
+#include "sql/executor/show_status_executor.h"
 #include "sql/executor/show_tables_executor.h"
+#include "sql/executor/sync_executor.h"
 #include "sql/executor/trx_begin_executor.h"
 #include "sql/executor/trx_end_executor.h"
 #include "sql/executor/set_variable_executor.h"
 #include "sql/executor/load_data_executor.h"
+#include "sql/executor/vacuum_executor.h"
+#include "sql/executor/alter_table_executor.h"
+#include "sql/executor/backup_executor.h"
 #include "common/log/log.h"
 #include "drop_table_executor.h"
 
@@ -62,6 +67,11 @@ RC CommandExecutor::execute(SQLStageEvent *sql_event)
       return executor.execute(sql_event);
     }
 
+    case StmtType::SHOW_STATUS: {
+      ShowStatusExecutor executor;
+      return executor.execute(sql_event);
+    }
+
     case StmtType::BEGIN: {
       TrxBeginExecutor executor;
       return executor.execute(sql_event);
@@ -83,6 +93,26 @@ RC CommandExecutor::execute(SQLStageEvent *sql_event)
       return executor.execute(sql_event);
     }
 
+    case StmtType::VACUUM: {
+      VacuumExecutor executor;
+      return executor.execute(sql_event);
+    }
+
+    case StmtType::ALTER_TABLE: {
+      AlterTableExecutor executor;
+      return executor.execute(sql_event);
+    }
+
+    case StmtType::BACKUP: {
+      BackupExecutor executor;
+      return executor.execute(sql_event);
+    }
+
+    case StmtType::SYNC: {
+      SyncExecutor executor;
+      return executor.execute(sql_event);
+    }
+
     case StmtType::EXIT: {
       return RC::SUCCESS;
     }
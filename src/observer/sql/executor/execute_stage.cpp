@@ -20,11 +20,13 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "event/session_event.h"
 #include "event/sql_event.h"
+#include "session/session.h"
 #include "sql/executor/command_executor.h"
 #include "sql/operator/calc_physical_operator.h"
 #include "sql/stmt/select_stmt.h"
 #include "sql/stmt/stmt.h"
 #include "storage/default/default_handler.h"
+#include "storage/trx/trx.h"
 
 using namespace std;
 using namespace common;
@@ -45,6 +47,12 @@ RC ExecuteStage::handle_request(SQLStageEvent *sql_event)
     CommandExecutor command_executor;
     rc = command_executor.execute(sql_event);
     session_event->sql_result()->set_return_code(rc);
+
+    // 命令的结果(比如 SHOW STATUS)不读取表中的数据，自动提交时同样使用只读事务
+    Session *session = session_event->session();
+    if (session_event->sql_result()->has_operator() && !session->is_trx_multi_operation_mode()) {
+      session->current_trx()->set_read_only(true);
+    }
   } else {
     return RC::INTERNAL;
   }
@@ -93,6 +101,21 @@ RC ExecuteStage::handle_request_with_physical_operator(SQLStageEvent *sql_event)
   }
 
   SqlResult *sql_result = sql_event->session_event()->sql_result();
+
+  // 自动提交的查询语句不会修改数据，使用只读事务，不分配事务号也不写日志
+  Session   *session        = sql_event->session_event()->session();
+  Trx       *trx            = session->current_trx();
+  const bool read_only_stmt = stmt->type() == StmtType::SELECT || stmt->type() == StmtType::CALC ||
+                              stmt->type() == StmtType::EXPLAIN;
+  if (!session->is_trx_multi_operation_mode()) {
+    trx->set_read_only(read_only_stmt);
+  } else if (trx->read_only() && !read_only_stmt) {
+    LOG_WARN("cannot execute statement in a read only transaction. sql=%s", sql_event->sql().c_str());
+    rc = RC::TRX_READ_ONLY;
+    sql_result->set_return_code(rc);
+    return rc;
+  }
+
   sql_result->set_tuple_schema(schema);
   sql_result->set_operator(std::move(physical_operator));
   return rc;
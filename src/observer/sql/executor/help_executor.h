@@ -33,13 +33,19 @@ public:
   RC execute(SQLStageEvent *sql_event)
   {
     const char *strings[] = {"show tables;",
+        "show status;",
         "desc `table name`;",
         "create table `table name` (`column name` `column type`, ...);",
         "create index `index name` on `table` (`column`);",
         "insert into `table` values(`value1`,`value2`);",
         "update `table` set column=value [where `column`=`value`];",
         "delete from `table` [where `column`=`value`];",
-        "select [ * | `columns` ] from `table`;"};
+        "select [ * | `columns` ] from `table`;",
+        "vacuum [`table`];",
+        "alter table `table` read only | read write;",
+        "backup to '`path`';",
+        "begin [read only];",
+        "sync;"};
 
     auto oper = new StringListPhysicalOperator();
     for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
@@ -14,11 +14,16 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/global_context.h"
 #include "common/rc.h"
 #include "event/session_event.h"
 #include "event/sql_event.h"
 #include "session/session.h"
 #include "sql/stmt/set_variable_stmt.h"
+#include "storage/clog/clog.h"
+#include "storage/db/db.h"
+#include "storage/trx/lock_manager.h"
+#include "storage/trx/trx.h"
 
 /**
  * @brief SetVariable语句执行器
@@ -48,6 +53,51 @@ public:
 
       session->set_sql_debug(bool_value);
       LOG_TRACE("set sql_debug to %d", bool_value);
+    } else if (strcasecmp(var_name, "autovacuum_interval") == 0) {
+      // 后台自动整理(VACUUM)所有表的间隔秒数，0表示关闭
+      if (var_value.attr_type() != AttrType::INTS || var_value.get_int() < 0) {
+        return RC::VARIABLE_NOT_VALID;
+      }
+
+      session->get_current_db()->set_autovacuum_interval(var_value.get_int());
+    } else if (strcasecmp(var_name, "group_commit_window") == 0) {
+      // 组提交时leader等待其它事务加入的微秒数，0表示不等待
+      if (var_value.attr_type() != AttrType::INTS || var_value.get_int() < 0) {
+        return RC::VARIABLE_NOT_VALID;
+      }
+
+      session->get_current_db()->clog_manager()->set_group_commit_window(var_value.get_int());
+    } else if (strcasecmp(var_name, "async_commit") == 0) {
+      // 当前会话提交事务时不等待日志落盘
+      bool bool_value = false;
+      rc              = var_value_to_boolean(var_value, bool_value);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+
+      session->set_async_commit(bool_value);
+    } else if (strcasecmp(var_name, "async_commit_flush_interval") == 0) {
+      // 异步提交的日志由后台线程刷盘的间隔毫秒数
+      if (var_value.attr_type() != AttrType::INTS || var_value.get_int() <= 0) {
+        return RC::VARIABLE_NOT_VALID;
+      }
+
+      session->get_current_db()->clog_manager()->set_async_flush_interval(var_value.get_int());
+    } else if (strcasecmp(var_name, "backup_rate_limit") == 0) {
+      // 在线备份时复制文件的速度上限(MB/s)，0表示不限制
+      if (var_value.attr_type() != AttrType::INTS || var_value.get_int() < 0) {
+        return RC::VARIABLE_NOT_VALID;
+      }
+
+      session->get_current_db()->set_backup_rate_limit(var_value.get_int());
+    } else if (strcasecmp(var_name, "lock_wait_timeout") == 0) {
+      // 等待行锁的毫秒数，超时后语句失败
+      LockManager *lock_manager = GCTX.trx_kit_->lock_manager();
+      if (nullptr == lock_manager || var_value.attr_type() != AttrType::INTS || var_value.get_int() < 0) {
+        return RC::VARIABLE_NOT_VALID;
+      }
+
+      lock_manager->set_wait_timeout(var_value.get_int());
     } else {
       rc = RC::VARIABLE_NOT_EXISTS;
     }
@@ -0,0 +1,86 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include <string>
+
+#include "common/global_context.h"
+#include "common/rc.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/executor/sql_result.h"
+#include "sql/operator/string_list_physical_operator.h"
+#include "storage/clog/clog.h"
+#include "storage/db/db.h"
+#include "storage/trx/lock_manager.h"
+#include "storage/trx/trx.h"
+
+/**
+ * @brief 显示运行状态的执行器
+ * @ingroup Executor
+ * @details 每行是一个状态的名字和值。当前包括日志的位置和提交相关的设置：
+ * durable_lsn 之前的日志已经落盘，durable_lag_bytes 是还没有落盘的日志量，
+ * 异步提交的事务在这部分日志落盘之前宕机会丢失。
+ * lock_* 是等待行锁的统计，时间的单位是微秒，lock_waiting 是当前正在等待的事务个数
+ */
+class ShowStatusExecutor
+{
+public:
+  ShowStatusExecutor()          = default;
+  virtual ~ShowStatusExecutor() = default;
+
+  RC execute(SQLStageEvent *sql_event)
+  {
+    SqlResult *sql_result = sql_event->session_event()->sql_result();
+    Session   *session    = sql_event->session_event()->session();
+    Db        *db         = session->get_current_db();
+    if (nullptr == db) {
+      return RC::SCHEMA_DB_NOT_OPENED;
+    }
+
+    TupleSchema tuple_schema;
+    tuple_schema.append_cell("Variable_name");
+    tuple_schema.append_cell("Value");
+    sql_result->set_tuple_schema(tuple_schema);
+
+    CLogManager  *clog_manager = db->clog_manager();
+    const int64_t current_lsn  = clog_manager->current_lsn();
+    const int64_t durable_lsn  = clog_manager->durable_lsn();
+
+    auto oper = new StringListPhysicalOperator;
+    oper->append({"current_lsn", std::to_string(current_lsn)});
+    oper->append({"durable_lsn", std::to_string(durable_lsn)});
+    oper->append({"durable_lag_bytes", std::to_string(current_lsn - durable_lsn)});
+    oper->append({"async_commit", session->async_commit() ? "on" : "off"});
+    oper->append({"async_commit_flush_interval", std::to_string(clog_manager->async_flush_interval())});
+    oper->append({"group_commit_window", std::to_string(clog_manager->group_commit_window())});
+
+    LockManager *lock_manager = GCTX.trx_kit_->lock_manager();
+    if (nullptr != lock_manager) {
+      const LockStat lock_stat = lock_manager->stat();
+      oper->append({"lock_wait_timeout", std::to_string(lock_manager->wait_timeout())});
+      oper->append({"lock_waits", std::to_string(lock_stat.wait_count)});
+      oper->append({"lock_wait_time_us", std::to_string(lock_stat.wait_time_us)});
+      oper->append({"lock_wait_max_us", std::to_string(lock_stat.max_wait_time_us)});
+      oper->append({"lock_wait_timeouts", std::to_string(lock_stat.timeout_count)});
+      oper->append({"lock_deadlocks", std::to_string(lock_stat.deadlock_count)});
+      oper->append({"lock_waiting", std::to_string(lock_stat.waiting_count)});
+    }
+
+    sql_result->set_operator(std::unique_ptr<PhysicalOperator>(oper));
+    return RC::SUCCESS;
+  }
+};
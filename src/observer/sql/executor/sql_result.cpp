@@ -29,6 +29,7 @@ RC SqlResult::open()
   }
 
   Trx *trx = session_->current_trx();
+  trx->set_single_statement(!session_->is_trx_multi_operation_mode());
   trx->start_if_need();
   return operator_->open(trx);
 }
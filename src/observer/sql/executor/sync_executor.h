@@ -0,0 +1,43 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include "common/rc.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "storage/db/db.h"
+
+/**
+ * @brief Sync 语句的执行器
+ * @ingroup Executor
+ * @details 把当前数据库的数据写到磁盘，然后做一次 checkpoint，参考 Db::sync
+ */
+class SyncExecutor
+{
+public:
+  SyncExecutor()          = default;
+  virtual ~SyncExecutor() = default;
+
+  RC execute(SQLStageEvent *sql_event)
+  {
+    Session *session = sql_event->session_event()->session();
+    Db      *db      = session->get_current_db();
+    if (nullptr == db) {
+      return RC::SCHEMA_DB_NOT_OPENED;
+    }
+    return db->sync();
+  }
+};
@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include "event/session_event.h"
 #include "event/sql_event.h"
 #include "session/session.h"
+#include "sql/stmt/trx_begin_stmt.h"
 #include "storage/trx/trx.h"
 
 /**
@@ -34,9 +35,14 @@ public:
   {
     SessionEvent *session_event = sql_event->session_event();
 
-    Session *session = session_event->session();
-    Trx     *trx     = session->current_trx();
+    Session      *session    = session_event->session();
+    Trx          *trx        = session->current_trx();
+    TrxBeginStmt *begin_stmt = static_cast<TrxBeginStmt *>(sql_event->stmt());
 
+    // 已经在事务中时再执行BEGIN不会开始新的事务，也不能改变事务是否只读
+    if (!session->is_trx_multi_operation_mode()) {
+      trx->set_read_only(begin_stmt->read_only());
+    }
     session->set_trx_multi_operation_mode(true);
 
     return trx->start_if_need();
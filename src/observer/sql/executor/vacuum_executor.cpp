@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#include <memory>
+
+#include "sql/executor/vacuum_executor.h"
+
+#include "common/log/log.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/operator/string_list_physical_operator.h"
+#include "sql/stmt/vacuum_stmt.h"
+#include "storage/db/db.h"
+#include "storage/table/table_vacuum.h"
+
+using namespace std;
+
+RC VacuumExecutor::execute(SQLStageEvent *sql_event)
+{
+  Stmt         *stmt          = sql_event->stmt();
+  SessionEvent *session_event = sql_event->session_event();
+  Session      *session       = session_event->session();
+  ASSERT(stmt->type() == StmtType::VACUUM,
+      "vacuum executor can not run this command: %d",
+      static_cast<int>(stmt->type()));
+
+  VacuumStmt *vacuum_stmt = static_cast<VacuumStmt *>(stmt);
+  SqlResult  *sql_result  = session_event->sql_result();
+  Db         *db          = session->get_current_db();
+
+  vector<string> table_names;
+  if (vacuum_stmt->table_name().empty()) {
+    db->all_tables(table_names);
+  } else {
+    table_names.push_back(vacuum_stmt->table_name());
+  }
+
+  TupleSchema tuple_schema;
+  tuple_schema.append_cell(TupleCellSpec("", "Table", "Table"));
+  tuple_schema.append_cell(TupleCellSpec("", "Purged Records", "Purged Records"));
+  tuple_schema.append_cell(TupleCellSpec("", "Moved Records", "Moved Records"));
+  tuple_schema.append_cell(TupleCellSpec("", "Freed Pages", "Freed Pages"));
+  sql_result->set_tuple_schema(tuple_schema);
+
+  auto oper = new StringListPhysicalOperator;
+  for (const string &table_name : table_names) {
+    VacuumStat stat;
+    RC         rc = db->vacuum(table_name.c_str(), stat);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to vacuum table. table=%s, rc=%s", table_name.c_str(), strrc(rc));
+      delete oper;
+      return rc;
+    }
+
+    oper->append({table_name,
+        to_string(stat.purged_records),
+        to_string(stat.moved_records),
+        to_string(stat.freed_pages)});
+  }
+
+  sql_result->set_operator(unique_ptr<PhysicalOperator>(oper));
+  return RC::SUCCESS;
+}
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/operator/index_scan_physical_operator.h"
+#include <algorithm>
 #include "storage/index/index.h"
 #include "storage/trx/trx.h"
 
@@ -56,52 +57,149 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
   index_scanner_ = index_scanner;
+  record_page_handler_.reset(record_handler_->create_page_handler());
 
   tuple_.set_schema(table_, table_->table_meta().field_metas());
 
-  trx_ = trx;
+  trx_               = trx;
+  index_eof_         = false;
+  old_version_index_ = 0;
   return RC::SUCCESS;
 }
 
 RC IndexScanPhysicalOperator::next()
 {
-  RID rid;
-  RC  rc = RC::SUCCESS;
+  RID  rid;
+  RC   rc    = RC::SUCCESS;
+  bool found = false;
+
+  record_page_handler_->cleanup();
+
+  if (!index_eof_) {
+    while (RC::SUCCESS == (rc = index_scanner_->next_entry(&rid))) {
+      if (readonly_) {
+        visited_rids_.push_back(rid);
+      }
+
+      rc = fetch_record(rid, found);
+      if (rc != RC::SUCCESS || found) {
+        return rc;
+      }
+    }
 
-  record_page_handler_.cleanup();
+    if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
 
-  bool filter_result = false;
-  while (RC::SUCCESS == (rc = index_scanner_->next_entry(&rid))) {
-    rc = record_handler_->get_record(record_page_handler_, &rid, readonly_, &current_record_);
-    if (rc != RC::SUCCESS) {
+    index_eof_ = true;
+    if (readonly_) {
+      collect_old_version_rids();
+    }
+  }
+
+  while (old_version_index_ < old_version_rids_.size()) {
+    rc = fetch_record(old_version_rids_[old_version_index_++], found);
+    if (rc != RC::SUCCESS || found) {
       return rc;
     }
+  }
+
+  return RC::RECORD_EOF;
+}
 
-    tuple_.set_record(&current_record_);
-    rc = filter(tuple_, filter_result);
+RC IndexScanPhysicalOperator::fetch_record(const RID &rid, bool &found)
+{
+  found = false;
+
+  while (true) {
+    RC rc = record_handler_->get_record(*record_page_handler_, &rid, readonly_, &current_record_);
+    if (rc == RC::RECORD_NOT_EXIST) {
+      // 记录已经被VACUUM清理掉了，对当前事务来说它本来就不可见
+      record_page_handler_->cleanup();
+      return RC::SUCCESS;
+    }
     if (rc != RC::SUCCESS) {
       return rc;
     }
 
-    if (!filter_result) {
-      continue;
+    // 只读时先找到可见的版本再过滤，看到的可能是旧版本。修改时先过滤，不满足条件的记录不会产生冲突
+    bool filter_result = false;
+    if (!readonly_) {
+      tuple_.set_record(&current_record_);
+      rc = filter(tuple_, filter_result);
+      if (rc != RC::SUCCESS || !filter_result) {
+        return rc;
+      }
     }
 
     rc = trx_->visit_record(table_, current_record_, readonly_);
-    if (rc == RC::RECORD_INVISIBLE) {
+    if (rc == RC::LOCKED_NEED_WAIT) {
+      // 记录被其它事务锁住了，释放记录页面和索引的叶子页面等待，持有行锁的事务可能要修改它们。
+      // 拿到锁以后重新读取记录，索引扫描器在下次取数据时重新定位
+      record_page_handler_->cleanup();
+      if (index_scanner_ != nullptr && !index_eof_) {
+        index_scanner_->release_latches();
+      }
+      rc = trx_->wait_for_record(table_, rid);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
       continue;
-    } else {
+    }
+    if (rc == RC::RECORD_INVISIBLE) {
+      return RC::SUCCESS;
+    }
+    if (rc != RC::SUCCESS) {
       return rc;
     }
+
+    if (readonly_) {
+      tuple_.set_record(&current_record_);
+      rc = filter(tuple_, filter_result);
+      if (rc != RC::SUCCESS || !filter_result) {
+        return rc;
+      }
+    }
+
+    found = true;
+    return RC::SUCCESS;
   }
+}
 
-  return rc;
+void IndexScanPhysicalOperator::collect_old_version_rids()
+{
+  if (!trx_->has_old_versions(table_)) {
+    return;
+  }
+
+  old_version_tuple_.set_schema(table_, table_->table_meta().field_metas());
+  auto match = [this](const char *data, int len) {
+    Record record;
+    record.set_data(const_cast<char *>(data), len);
+    old_version_tuple_.set_record(&record);
+
+    bool result = false;
+    return filter(old_version_tuple_, result) == RC::SUCCESS && result;
+  };
+  trx_->old_version_rids(table_, match, old_version_rids_);
+
+  // 索引中已经访问过的记录不再重复访问
+  auto rid_less = [](const RID &left, const RID &right) {
+    return left.page_num != right.page_num ? left.page_num < right.page_num : left.slot_num < right.slot_num;
+  };
+  std::sort(visited_rids_.begin(), visited_rids_.end(), rid_less);
+  auto removed = std::remove_if(old_version_rids_.begin(), old_version_rids_.end(), [this, &rid_less](const RID &rid) {
+    return std::binary_search(visited_rids_.begin(), visited_rids_.end(), rid, rid_less);
+  });
+  old_version_rids_.erase(removed, old_version_rids_.end());
 }
 
 RC IndexScanPhysicalOperator::close()
 {
   index_scanner_->destroy();
   index_scanner_ = nullptr;
+  visited_rids_.clear();
+  old_version_rids_.clear();
   return RC::SUCCESS;
 }
 
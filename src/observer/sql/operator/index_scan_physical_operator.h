@@ -46,6 +46,18 @@ private:
   // 与TableScanPhysicalOperator代码相同，可以优化
   RC filter(RowTuple &tuple, bool &result);
 
+  /**
+   * @brief 读取记录并判断可见性和过滤条件
+   * @param found 返回记录是否可见并且满足条件
+   */
+  RC fetch_record(const RID &rid, bool &found);
+
+  /**
+   * @brief 索引遍历结束后，找出只有旧版本上的键满足条件的记录
+   * @details 索引只指向记录的最新版本，其它事务更新了索引键以后，旧的键在索引中就找不到了
+   */
+  void collect_old_version_rids();
+
 private:
   Trx               *trx_            = nullptr;
   Table             *table_          = nullptr;
@@ -54,9 +66,9 @@ private:
   IndexScanner      *index_scanner_  = nullptr;
   RecordFileHandler *record_handler_ = nullptr;
 
-  RecordPageHandler record_page_handler_;
-  Record            current_record_;
-  RowTuple          tuple_;
+  std::unique_ptr<RecordPageHandler> record_page_handler_;
+  Record                             current_record_;
+  RowTuple                           tuple_;
 
   Value left_value_;
   Value right_value_;
@@ -64,4 +76,10 @@ private:
   bool  right_inclusive_ = false;
 
   std::vector<std::unique_ptr<Expression>> predicates_;
+
+  bool             index_eof_ = false;       ///< 索引已经遍历完了
+  std::vector<RID> visited_rids_;            ///< 只读扫描时从索引中找到的记录
+  std::vector<RID> old_version_rids_;        ///< 索引中没有，但是旧版本满足条件的记录
+  size_t           old_version_index_ = 0;   ///< 下一个要访问的 old_version_rids_
+  RowTuple         old_version_tuple_;       ///< 在旧版本上判断过滤条件
 };
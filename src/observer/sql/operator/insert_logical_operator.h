@@ -26,16 +26,16 @@ See the Mulan PSL v2 for more details. */
 class InsertLogicalOperator : public LogicalOperator
 {
 public:
-  InsertLogicalOperator(Table *table, std::vector<Value> values);
+  InsertLogicalOperator(Table *table, std::vector<std::vector<Value>> rows);
   virtual ~InsertLogicalOperator() = default;
 
   LogicalOperatorType type() const override { return LogicalOperatorType::INSERT; }
 
-  Table                    *table() const { return table_; }
-  const std::vector<Value> &values() const { return values_; }
-  std::vector<Value>       &values() { return values_; }
+  Table                                 *table() const { return table_; }
+  const std::vector<std::vector<Value>> &rows() const { return rows_; }
+  std::vector<std::vector<Value>>       &rows() { return rows_; }
 
 private:
-  Table             *table_ = nullptr;
-  std::vector<Value> values_;
+  Table                          *table_ = nullptr;
+  std::vector<std::vector<Value>> rows_;  ///< 要插入的行，可以是多行
 };
\ No newline at end of file
@@ -23,11 +23,13 @@ class InsertStmt;
 /**
  * @brief 插入物理算子
  * @ingroup PhysicalOperator
+ * @details 多行插入时，先把所有的行都构造成记录，再一次性交给事务批量插入，
+ * 这样记录可以连续地放到同一个页面中，日志也可以一起写入
  */
 class InsertPhysicalOperator : public PhysicalOperator
 {
 public:
-  InsertPhysicalOperator(Table *table, std::vector<Value> &&values);
+  InsertPhysicalOperator(Table *table, std::vector<std::vector<Value>> &&rows);
 
   virtual ~InsertPhysicalOperator() = default;
 
@@ -40,6 +42,6 @@ public:
   Tuple *current_tuple() override { return nullptr; }
 
 private:
-  Table             *table_ = nullptr;
-  std::vector<Value> values_;
+  Table                          *table_ = nullptr;
+  std::vector<std::vector<Value>> rows_;
 };
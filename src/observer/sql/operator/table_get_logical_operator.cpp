@@ -14,10 +14,46 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/table_get_logical_operator.h"
 
+#include <string.h>
+
+#include "sql/stmt/filter_stmt.h"
+
 TableGetLogicalOperator::TableGetLogicalOperator(Table *table, const std::vector<Field> &fields, bool readonly)
     : table_(table), fields_(fields), readonly_(readonly)
 {}
 
+std::vector<Field> TableGetLogicalOperator::fields_to_read(
+    Table *table, const std::vector<Field> &query_fields, const FilterStmt *filter_stmt)
+{
+  std::vector<Field> fields;
+  auto add_field = [&fields, table](const Field &field) {
+    if (0 != strcmp(field.table_name(), table->name())) {
+      return;
+    }
+    for (const Field &exist_field : fields) {
+      if (exist_field.meta() == field.meta()) {
+        return;
+      }
+    }
+    fields.push_back(field);
+  };
+
+  for (const Field &field : query_fields) {
+    add_field(field);
+  }
+
+  // 过滤条件中用到的字段也需要从表中读取出来，PAX格式的表只会读取这里列出的字段
+  for (const FilterUnit *filter_unit : filter_stmt->filter_units()) {
+    if (filter_unit->left().is_attr) {
+      add_field(filter_unit->left().field);
+    }
+    if (filter_unit->right().is_attr) {
+      add_field(filter_unit->right().field);
+    }
+  }
+  return fields;
+}
+
 void TableGetLogicalOperator::set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs)
 {
   predicates_ = std::move(exprs);
@@ -16,6 +16,8 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/logical_operator.h"
 #include "storage/field/field.h"
 
+class FilterStmt;
+
 /**
  * @brief 表示从表中获取数据的算子
  * @details 比如使用全表扫描、通过索引获取数据等
@@ -32,6 +34,21 @@ public:
   Table *table() const { return table_; }
   bool   readonly() const { return readonly_; }
 
+  /**
+   * @brief 上层算子会访问到的字段，获取数据时可以只读取这些字段
+   */
+  const std::vector<Field> &fields() const { return fields_; }
+
+  /**
+   * @brief 收集查询中需要从表中读取的字段
+   * @details 包括查询结果中属于这张表的字段，以及过滤条件中用到的这张表的字段，重复的字段只保留一个
+   * @param table        要读取的表
+   * @param query_fields 查询结果中的字段，可能属于多张表
+   * @param filter_stmt  查询的过滤条件
+   */
+  static std::vector<Field> fields_to_read(
+      Table *table, const std::vector<Field> &query_fields, const FilterStmt *filter_stmt);
+
   void                                      set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
   std::vector<std::unique_ptr<Expression>> &predicates() { return predicates_; }
 
@@ -14,34 +14,43 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/table_scan_physical_operator.h"
 #include "event/sql_debug.h"
+#include "sql/expr/expression.h"
 #include "storage/table/table.h"
 
 using namespace std;
 
 RC TableScanPhysicalOperator::open(Trx *trx)
 {
-  RC rc = table_->get_record_scanner(record_scanner_, trx, readonly_);
-  if (rc == RC::SUCCESS) {
-    tuple_.set_schema(table_, table_->table_meta().field_metas());
-  }
-  trx_ = trx;
+  record_scanner_.set_projection(projection_);
+  record_scanner_.set_column_filter(&column_filter_);
+  tuple_.set_schema(table_, table_->table_meta().field_metas());
+  filter_tuple_.set_schema(table_, table_->table_meta().field_metas());
+
+  // 只读时可能读到旧版本，要先找到可见的版本再过滤，所以只在修改数据时提前过滤
+  ConditionFilter *condition_filter = (readonly_ || predicates_.empty()) ? nullptr : &predicate_filter_;
+
+  RC rc = table_->get_record_scanner(record_scanner_, trx, readonly_, &zone_map_filter_, condition_filter);
+  records_.clear();
+  record_index_ = 0;
+  trx_          = trx;
   return rc;
 }
 
 RC TableScanPhysicalOperator::next()
 {
-  if (!record_scanner_.has_next()) {
-    return RC::RECORD_EOF;
-  }
-
   RC   rc            = RC::SUCCESS;
   bool filter_result = false;
-  while (record_scanner_.has_next()) {
-    rc = record_scanner_.next(current_record_);
-    if (rc != RC::SUCCESS) {
-      return rc;
+  while (true) {
+    if (record_index_ >= records_.size()) {
+      rc = record_scanner_.next_batch(records_);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      record_index_ = 0;
     }
 
+    current_record_ = records_[record_index_++];
+
     tuple_.set_record(&current_record_);
     rc = filter(tuple_, filter_result);
     if (rc != RC::SUCCESS) {
@@ -50,16 +59,21 @@ RC TableScanPhysicalOperator::next()
 
     if (filter_result) {
       sql_debug("get a tuple: %s", tuple_.to_string().c_str());
-      break;
-    } else {
-      sql_debug("a tuple is filtered: %s", tuple_.to_string().c_str());
-      rc = RC::RECORD_EOF;
+      return rc;
     }
+    sql_debug("a tuple is filtered: %s", tuple_.to_string().c_str());
   }
-  return rc;
 }
 
-RC TableScanPhysicalOperator::close() { return record_scanner_.close_scan(); }
+RC TableScanPhysicalOperator::close()
+{
+  if (!zone_map_filter_.empty()) {
+    sql_debug("table %s skipped %d pages by zone map", table_->name(), record_scanner_.skipped_page_count());
+  }
+  records_.clear();
+  record_index_ = 0;
+  return record_scanner_.close_scan();
+}
 
 Tuple *TableScanPhysicalOperator::current_tuple()
 {
@@ -67,11 +81,114 @@ Tuple *TableScanPhysicalOperator::current_tuple()
   return &tuple_;
 }
 
-string TableScanPhysicalOperator::param() const { return table_->name(); }
+string TableScanPhysicalOperator::param() const
+{
+  if (zone_map_filter_.empty()) {
+    return table_->name();
+  }
+
+  // EXPLAIN 不会真正执行扫描，这里给出的是按照当前页面摘要估计的可以跳过的页面数。
+  // 执行时实际跳过的页面数在扫描结束时通过 sql_debug 输出，有旧版本时不会跳过页面，两者可能不同
+  const ZoneMap &zone_map = table_->record_handler()->zone_map();
+  return string(table_->name()) + ", zone map estimated skip pages=" +
+         to_string(zone_map_filter_.skippable_page_count()) + "/" + to_string(zone_map.pages().size());
+}
 
 void TableScanPhysicalOperator::set_predicates(vector<unique_ptr<Expression>> &&exprs)
 {
   predicates_ = std::move(exprs);
+
+  zone_map_filter_ = ZoneMapFilter();
+  zone_map_filter_.init(&table_->record_handler()->zone_map());
+  column_filter_ = ColumnFilter();
+  for (unique_ptr<Expression> &expr : predicates_) {
+    collect_page_filter_conditions(expr.get());
+  }
+}
+
+void TableScanPhysicalOperator::set_projection(const vector<Field> &fields)
+{
+  const TableMeta &table_meta = table_->table_meta();
+  projection_.assign(table_meta.field_num(), false);
+
+  // 系统字段总是需要的，比如事务判断可见性时会用到
+  for (int i = 0; i < table_meta.sys_field_num(); i++) {
+    projection_[i] = true;
+  }
+
+  for (const Field &field : fields) {
+    for (int i = table_meta.sys_field_num(); i < table_meta.field_num(); i++) {
+      if (table_meta.field(i) == field.meta()) {
+        projection_[i] = true;
+        break;
+      }
+    }
+  }
+}
+
+void TableScanPhysicalOperator::collect_page_filter_conditions(Expression *expr)
+{
+  if (expr->type() == ExprType::CONJUNCTION) {
+    auto conjunction_expr = static_cast<ConjunctionExpr *>(expr);
+    if (conjunction_expr->conjunction_type() != ConjunctionExpr::Type::AND) {
+      return;
+    }
+    for (unique_ptr<Expression> &child : conjunction_expr->children()) {
+      collect_page_filter_conditions(child.get());
+    }
+    return;
+  }
+
+  if (expr->type() != ExprType::COMPARISON) {
+    return;
+  }
+
+  auto        comparison_expr = static_cast<ComparisonExpr *>(expr);
+  Expression *left            = comparison_expr->left().get();
+  Expression *right           = comparison_expr->right().get();
+  CompOp      comp            = comparison_expr->comp();
+
+  // 常量在左边时，交换左右两边，同时把比较符号反过来
+  if (left->type() == ExprType::VALUE && right->type() == ExprType::FIELD) {
+    std::swap(left, right);
+    switch (comp) {
+      case LESS_THAN: comp = GREAT_THAN; break;
+      case LESS_EQUAL: comp = GREAT_EQUAL; break;
+      case GREAT_THAN: comp = LESS_THAN; break;
+      case GREAT_EQUAL: comp = LESS_EQUAL; break;
+      default: break;
+    }
+  }
+
+  if (left->type() != ExprType::FIELD || right->type() != ExprType::VALUE) {
+    return;
+  }
+
+  const Field &field = static_cast<FieldExpr *>(left)->field();
+  if (field.table() != table_) {
+    return;
+  }
+
+  const Value &value = static_cast<ValueExpr *>(right)->get_value();
+  zone_map_filter_.add_condition(*field.meta(), comp, value);
+
+  const TableMeta &table_meta = table_->table_meta();
+  for (int i = 0; i < table_meta.field_num(); i++) {
+    if (table_meta.field(i) == field.meta()) {
+      column_filter_.add_condition(i, comp, value);
+      break;
+    }
+  }
+}
+
+bool TableScanPhysicalOperator::PredicateFilter::filter(const Record &rec) const
+{
+  oper_.filter_tuple_.set_record(const_cast<Record *>(&rec));
+
+  // 计算出错时不在这里过滤掉，next 中再计算一次时返回错误
+  bool result = false;
+  RC   rc     = oper_.filter(oper_.filter_tuple_, result);
+  return rc != RC::SUCCESS || result;
 }
 
 RC TableScanPhysicalOperator::filter(RowTuple &tuple, bool &result)
@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/rc.h"
 #include "sql/operator/physical_operator.h"
+#include "storage/common/condition_filter.h"
 #include "storage/record/record_manager.h"
 
 class Table;
@@ -23,6 +24,10 @@ class Table;
 /**
  * @brief 表扫描物理算子
  * @ingroup PhysicalOperator
+ * @details 从 RecordFileScanner 中一次取出一个页面上的所有可见记录，再逐条做过滤。
+ * 谓词中 `字段 比较 常量` 形式的条件会同时用来构造页面摘要过滤器，跳过不可能有满足条件记录的页面；
+ * 对于有编码列的PAX页面，这些条件还会直接在编码值上计算，不满足条件的记录不需要解码。
+ * 修改数据时谓词在事务访问记录之前计算，不满足条件的记录不会与其它事务冲突
  */
 class TableScanPhysicalOperator : public PhysicalOperator
 {
@@ -43,15 +48,47 @@ public:
 
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /**
+   * @brief 设置上层算子需要的字段，PAX格式的表只会读取这些字段以及系统字段
+   */
+  void set_projection(const std::vector<Field> &fields);
+
+private:
+  /**
+   * @brief 把谓词交给 RecordFileScanner，在事务访问记录(加锁或者等待行锁)之前过滤
+   */
+  class PredicateFilter : public ConditionFilter
+  {
+  public:
+    explicit PredicateFilter(TableScanPhysicalOperator &oper) : oper_(oper) {}
+
+    bool filter(const Record &rec) const override;
+
+  private:
+    TableScanPhysicalOperator &oper_;
+  };
+
 private:
   RC filter(RowTuple &tuple, bool &result);
 
+  /**
+   * @brief 从谓词中提取可以用页面摘要或者编码后的列判断的条件
+   */
+  void collect_page_filter_conditions(Expression *expr);
+
 private:
   Table                                   *table_    = nullptr;
   Trx                                     *trx_      = nullptr;
   bool                                     readonly_ = false;
   RecordFileScanner                        record_scanner_;
+  std::vector<Record>                      records_;           ///< 当前页面上的一批记录
+  size_t                                   record_index_ = 0;  ///< 下一条要访问的记录在records_中的位置
   Record                                   current_record_;
   RowTuple                                 tuple_;
   std::vector<std::unique_ptr<Expression>> predicates_;  // TODO chang predicate to table tuple filter
+  ZoneMapFilter                            zone_map_filter_;  ///< 使用页面摘要过滤页面
+  ColumnFilter                             column_filter_;    ///< 在编码后的列上直接过滤记录
+  std::vector<bool>                        projection_;       ///< 需要读取的字段，为空表示所有字段
+  PredicateFilter                          predicate_filter_{*this};
+  RowTuple                                 filter_tuple_;  ///< predicate_filter_ 使用，tuple_ 可能还被上层算子引用
 };
@@ -123,6 +123,11 @@ RC UpdatePhysicalOperator::next()
       return rc;
     }
   }
+  // 扫描时的错误，比如等待行锁超时，不能当作数据已经读完了
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to get next record to update: %s", strrc(rc));
+    return rc;
+  }
   return RC::RECORD_EOF;
 }
 
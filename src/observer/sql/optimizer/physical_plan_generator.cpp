@@ -146,6 +146,10 @@ RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, u
   } else {
     auto table_scan_oper = new TableScanPhysicalOperator(table, table_get_oper.readonly());
     table_scan_oper->set_predicates(std::move(predicates));
+    if (table_get_oper.readonly()) {
+      // 修改数据时需要完整的记录，比如删除索引项，所以只对只读扫描做投影
+      table_scan_oper->set_projection(table_get_oper.fields());
+    }
     oper = unique_ptr<PhysicalOperator>(table_scan_oper);
     LOG_TRACE("use table scan");
   }
@@ -213,8 +217,8 @@ RC PhysicalPlanGenerator::create_plan(ProjectLogicalOperator &project_oper, uniq
 RC PhysicalPlanGenerator::create_plan(InsertLogicalOperator &insert_oper, unique_ptr<PhysicalOperator> &oper)
 {
   Table                  *table           = insert_oper.table();
-  vector<Value>          &values          = insert_oper.values();
-  InsertPhysicalOperator *insert_phy_oper = new InsertPhysicalOperator(table, std::move(values));
+  vector<vector<Value>>  &rows            = insert_oper.rows();
+  InsertPhysicalOperator *insert_phy_oper = new InsertPhysicalOperator(table, std::move(rows));
   oper.reset(insert_phy_oper);
   return RC::SUCCESS;
 }
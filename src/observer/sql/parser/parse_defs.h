@@ -111,8 +111,8 @@ struct CalcSqlNode
  */
 struct InsertSqlNode
 {
-  std::string        relation_name;  ///< Relation to insert into
-  std::vector<Value> values;         ///< 要插入的值
+  std::string                     relation_name;  ///< Relation to insert into
+  std::vector<std::vector<Value>> rows;           ///< 要插入的值，每个元素是一行。INSERT ... VALUES (...), (...)
 };
 
 /**
@@ -145,9 +145,10 @@ struct UpdateSqlNode
  */
 struct AttrInfoSqlNode
 {
-  AttrType    type;    ///< Type of attribute
-  std::string name;    ///< Attribute name
-  size_t      length;  ///< Length of attribute
+  AttrType    type;      ///< Type of attribute
+  std::string name;      ///< Attribute name
+  size_t      length;    ///< Length of attribute
+  std::string encoding;  ///< 列的编码方式(encoding dict/rle/for)，为空表示不编码
 };
 
 /**
@@ -157,8 +158,9 @@ struct AttrInfoSqlNode
  */
 struct CreateTableSqlNode
 {
-  std::string                  relation_name;  ///< Relation name
-  std::vector<AttrInfoSqlNode> attr_infos;     ///< attributes
+  std::string                  relation_name;   ///< Relation name
+  std::vector<AttrInfoSqlNode> attr_infos;      ///< attributes
+  std::string                  storage_format;  ///< 数据页面的组织格式，比如row、pax，为空表示默认格式
 };
 
 /**
@@ -203,6 +205,47 @@ struct DescTableSqlNode
   std::string relation_name;
 };
 
+/**
+ * @brief 描述一个vacuum语句
+ * @ingroup SQLParser
+ * @details 整理表，回收被删除的记录占用的空间。没有指定表名时整理所有的表
+ */
+struct VacuumSqlNode
+{
+  std::string relation_name;
+};
+
+/**
+ * @brief 描述一个backup语句
+ * @ingroup SQLParser
+ * @details 在线备份当前的数据库：BACKUP TO 'path'
+ */
+struct BackupSqlNode
+{
+  std::string path;
+};
+
+/**
+ * @brief 描述一个alter table语句
+ * @ingroup SQLParser
+ * @details 当前只支持修改表的只读状态：ALTER TABLE `table` READ ONLY | READ WRITE
+ */
+struct AlterTableSqlNode
+{
+  std::string relation_name;
+  bool        read_only = false;
+};
+
+/**
+ * @brief 描述一个begin语句
+ * @ingroup SQLParser
+ * @details BEGIN [READ ONLY]，只读事务不能修改数据
+ */
+struct BeginSqlNode
+{
+  bool read_only = false;
+};
+
 /**
  * @brief 描述一个load data语句
  * @ingroup SQLParser
@@ -269,8 +312,9 @@ enum SqlCommandFlag
   SCF_DROP_INDEX,
   SCF_SYNC,
   SCF_SHOW_TABLES,
+  SCF_SHOW_STATUS,  ///< 显示运行状态，比如日志的落盘位置
   SCF_DESC_TABLE,
-  SCF_BEGIN,  ///< 事务开始语句，可以在这里扩展只读事务
+  SCF_BEGIN,  ///< 事务开始语句，可以开始只读事务
   SCF_COMMIT,
   SCF_CLOG_SYNC,
   SCF_ROLLBACK,
@@ -279,6 +323,9 @@ enum SqlCommandFlag
   SCF_EXIT,
   SCF_EXPLAIN,
   SCF_SET_VARIABLE,  ///< 设置变量
+  SCF_VACUUM,
+  SCF_ALTER_TABLE,
+  SCF_BACKUP,  ///< 在线备份
 };
 /**
  * @brief 表示一个SQL语句
@@ -302,6 +349,10 @@ public:
   LoadDataSqlNode     load_data;
   ExplainSqlNode      explain;
   SetVariableSqlNode  set_variable;
+  VacuumSqlNode       vacuum;
+  AlterTableSqlNode   alter_table;
+  BackupSqlNode       backup;
+  BeginSqlNode        begin;
 
 public:
   ParsedSqlNode();
@@ -202,42 +202,50 @@ enum yysymbol_kind_t
   YYSYMBOL_exit_stmt = 60,                 /* exit_stmt  */
   YYSYMBOL_help_stmt = 61,                 /* help_stmt  */
   YYSYMBOL_sync_stmt = 62,                 /* sync_stmt  */
-  YYSYMBOL_begin_stmt = 63,                /* begin_stmt  */
-  YYSYMBOL_commit_stmt = 64,               /* commit_stmt  */
-  YYSYMBOL_rollback_stmt = 65,             /* rollback_stmt  */
-  YYSYMBOL_drop_table_stmt = 66,           /* drop_table_stmt  */
-  YYSYMBOL_show_tables_stmt = 67,          /* show_tables_stmt  */
-  YYSYMBOL_desc_table_stmt = 68,           /* desc_table_stmt  */
-  YYSYMBOL_create_index_stmt = 69,         /* create_index_stmt  */
-  YYSYMBOL_drop_index_stmt = 70,           /* drop_index_stmt  */
-  YYSYMBOL_create_table_stmt = 71,         /* create_table_stmt  */
-  YYSYMBOL_attr_def_list = 72,             /* attr_def_list  */
-  YYSYMBOL_attr_def = 73,                  /* attr_def  */
-  YYSYMBOL_number = 74,                    /* number  */
-  YYSYMBOL_type = 75,                      /* type  */
-  YYSYMBOL_insert_stmt = 76,               /* insert_stmt  */
-  YYSYMBOL_value_list = 77,                /* value_list  */
-  YYSYMBOL_value = 78,                     /* value  */
-  YYSYMBOL_delete_stmt = 79,               /* delete_stmt  */
-  YYSYMBOL_update_stmt = 80,               /* update_stmt  */
-  YYSYMBOL_set_list = 81,                  /* set_list  */
-  YYSYMBOL_set = 82,                       /* set  */
-  YYSYMBOL_select_stmt = 83,               /* select_stmt  */
-  YYSYMBOL_calc_stmt = 84,                 /* calc_stmt  */
-  YYSYMBOL_expression_list = 85,           /* expression_list  */
-  YYSYMBOL_expression = 86,                /* expression  */
-  YYSYMBOL_select_attr = 87,               /* select_attr  */
-  YYSYMBOL_rel_attr = 88,                  /* rel_attr  */
-  YYSYMBOL_attr_list = 89,                 /* attr_list  */
-  YYSYMBOL_rel_list = 90,                  /* rel_list  */
-  YYSYMBOL_where = 91,                     /* where  */
-  YYSYMBOL_condition_list = 92,            /* condition_list  */
-  YYSYMBOL_condition = 93,                 /* condition  */
-  YYSYMBOL_comp_op = 94,                   /* comp_op  */
-  YYSYMBOL_load_data_stmt = 95,            /* load_data_stmt  */
-  YYSYMBOL_explain_stmt = 96,              /* explain_stmt  */
-  YYSYMBOL_set_variable_stmt = 97,         /* set_variable_stmt  */
-  YYSYMBOL_opt_semicolon = 98              /* opt_semicolon  */
+  YYSYMBOL_vacuum_stmt = 63,               /* vacuum_stmt  */
+  YYSYMBOL_backup_stmt = 64,               /* backup_stmt  */
+  YYSYMBOL_alter_table_stmt = 65,          /* alter_table_stmt  */
+  YYSYMBOL_begin_stmt = 66,                /* begin_stmt  */
+  YYSYMBOL_commit_stmt = 67,               /* commit_stmt  */
+  YYSYMBOL_rollback_stmt = 68,             /* rollback_stmt  */
+  YYSYMBOL_drop_table_stmt = 69,           /* drop_table_stmt  */
+  YYSYMBOL_show_tables_stmt = 70,          /* show_tables_stmt  */
+  YYSYMBOL_show_status_stmt = 71,          /* show_status_stmt  */
+  YYSYMBOL_desc_table_stmt = 72,           /* desc_table_stmt  */
+  YYSYMBOL_create_index_stmt = 73,         /* create_index_stmt  */
+  YYSYMBOL_drop_index_stmt = 74,           /* drop_index_stmt  */
+  YYSYMBOL_create_table_stmt = 75,         /* create_table_stmt  */
+  YYSYMBOL_storage_format = 76,            /* storage_format  */
+  YYSYMBOL_attr_def_list = 77,             /* attr_def_list  */
+  YYSYMBOL_attr_def = 78,                  /* attr_def  */
+  YYSYMBOL_column_encoding = 79,           /* column_encoding  */
+  YYSYMBOL_number = 80,                    /* number  */
+  YYSYMBOL_type = 81,                      /* type  */
+  YYSYMBOL_insert_stmt = 82,               /* insert_stmt  */
+  YYSYMBOL_value_row = 83,                 /* value_row  */
+  YYSYMBOL_value_row_list = 84,            /* value_row_list  */
+  YYSYMBOL_value_list = 85,                /* value_list  */
+  YYSYMBOL_value = 86,                     /* value  */
+  YYSYMBOL_delete_stmt = 87,               /* delete_stmt  */
+  YYSYMBOL_update_stmt = 88,               /* update_stmt  */
+  YYSYMBOL_set_list = 89,                  /* set_list  */
+  YYSYMBOL_set = 90,                       /* set  */
+  YYSYMBOL_select_stmt = 91,               /* select_stmt  */
+  YYSYMBOL_calc_stmt = 92,                 /* calc_stmt  */
+  YYSYMBOL_expression_list = 93,           /* expression_list  */
+  YYSYMBOL_expression = 94,                /* expression  */
+  YYSYMBOL_select_attr = 95,               /* select_attr  */
+  YYSYMBOL_rel_attr = 96,                  /* rel_attr  */
+  YYSYMBOL_attr_list = 97,                 /* attr_list  */
+  YYSYMBOL_rel_list = 98,                  /* rel_list  */
+  YYSYMBOL_where = 99,                     /* where  */
+  YYSYMBOL_condition_list = 100,           /* condition_list  */
+  YYSYMBOL_condition = 101,                /* condition  */
+  YYSYMBOL_comp_op = 102,                  /* comp_op  */
+  YYSYMBOL_load_data_stmt = 103,           /* load_data_stmt  */
+  YYSYMBOL_explain_stmt = 104,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 105,        /* set_variable_stmt  */
+  YYSYMBOL_opt_semicolon = 106             /* opt_semicolon  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -566,18 +574,18 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  65
+#define YYFINAL  74
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   141
+#define YYLAST   164
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  57
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  42
+#define YYNNTS  50
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  92
+#define YYNRULES  109
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  168
+#define YYNSTATES  196
 
 /* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   307
@@ -631,16 +639,17 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   179,   179,   187,   188,   189,   190,   191,   192,   193,
-     194,   195,   196,   197,   198,   199,   200,   201,   202,   203,
-     204,   205,   206,   210,   216,   221,   227,   233,   239,   245,
-     252,   258,   266,   280,   290,   309,   312,   325,   333,   343,
-     346,   347,   348,   351,   367,   370,   381,   385,   389,   397,
-     409,   428,   431,   442,   447,   469,   479,   484,   495,   498,
-     501,   504,   507,   511,   514,   522,   529,   541,   546,   557,
-     560,   574,   577,   590,   593,   599,   602,   607,   614,   626,
-     638,   650,   665,   666,   667,   668,   669,   670,   674,   687,
-     695,   705,   706
+       0,   188,   188,   196,   197,   198,   199,   200,   201,   202,
+     203,   204,   205,   206,   207,   208,   209,   210,   211,   212,
+     213,   214,   215,   216,   217,   218,   219,   223,   229,   234,
+     241,   251,   268,   288,   310,   313,   328,   334,   340,   347,
+     354,   366,   374,   388,   398,   422,   426,   441,   444,   457,
+     469,   484,   488,   501,   504,   505,   506,   509,   525,   540,
+     543,   557,   560,   571,   575,   579,   587,   599,   618,   621,
+     632,   637,   659,   669,   674,   685,   688,   691,   694,   697,
+     701,   704,   712,   719,   731,   736,   747,   750,   764,   767,
+     780,   783,   789,   792,   797,   804,   816,   828,   840,   855,
+     856,   857,   858,   859,   860,   864,   877,   885,   895,   896
 };
 #endif
 
@@ -664,15 +673,18 @@ static const char *const yytname[] =
   "FROM", "WHERE", "AND", "SET", "ON", "LOAD", "DATA", "INFILE", "EXPLAIN",
   "EQ", "LT", "GT", "LE", "GE", "NE", "NUMBER", "FLOAT", "ID", "SSS",
   "'+'", "'-'", "'*'", "'/'", "UMINUS", "$accept", "commands",
-  "command_wrapper", "exit_stmt", "help_stmt", "sync_stmt", "begin_stmt",
-  "commit_stmt", "rollback_stmt", "drop_table_stmt", "show_tables_stmt",
-  "desc_table_stmt", "create_index_stmt", "drop_index_stmt",
-  "create_table_stmt", "attr_def_list", "attr_def", "number", "type",
-  "insert_stmt", "value_list", "value", "delete_stmt", "update_stmt",
-  "set_list", "set", "select_stmt", "calc_stmt", "expression_list",
-  "expression", "select_attr", "rel_attr", "attr_list", "rel_list",
-  "where", "condition_list", "condition", "comp_op", "load_data_stmt",
-  "explain_stmt", "set_variable_stmt", "opt_semicolon", YY_NULLPTR
+  "command_wrapper", "exit_stmt", "help_stmt", "sync_stmt", "vacuum_stmt",
+  "backup_stmt", "alter_table_stmt", "begin_stmt", "commit_stmt",
+  "rollback_stmt", "drop_table_stmt", "show_tables_stmt",
+  "show_status_stmt", "desc_table_stmt", "create_index_stmt",
+  "drop_index_stmt", "create_table_stmt", "storage_format",
+  "attr_def_list", "attr_def", "column_encoding", "number", "type",
+  "insert_stmt", "value_row", "value_row_list", "value_list", "value",
+  "delete_stmt", "update_stmt", "set_list", "set", "select_stmt",
+  "calc_stmt", "expression_list", "expression", "select_attr", "rel_attr",
+  "attr_list", "rel_list", "where", "condition_list", "condition",
+  "comp_op", "load_data_stmt", "explain_stmt", "set_variable_stmt",
+  "opt_semicolon", YY_NULLPTR
 };
 
 static const char *
@@ -682,7 +694,7 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-91)
+#define YYPACT_NINF (-102)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
@@ -696,23 +708,26 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
-      -1,    17,    44,     0,   -48,   -45,    11,   -91,    -5,    -3,
-     -17,   -91,   -91,   -91,   -91,   -91,    23,    35,    -1,    61,
-      72,   -91,   -91,   -91,   -91,   -91,   -91,   -91,   -91,   -91,
-     -91,   -91,   -91,   -91,   -91,   -91,   -91,   -91,   -91,   -91,
-     -91,    26,    36,    37,    38,     0,   -91,   -91,   -91,     0,
-     -91,   -91,     5,    54,   -91,    56,    71,   -91,   -91,    41,
-      42,    57,    52,    55,   -91,   -91,   -91,   -91,    79,    60,
-     -91,    62,   -11,   -91,     0,     0,     0,     0,     0,    48,
-      50,    51,   -91,    70,    69,    58,    34,    53,    59,    63,
-      64,   -91,   -91,   -16,   -16,   -91,   -91,   -91,    86,    71,
-      89,    30,   -91,    65,    91,   -91,    80,    22,    93,    98,
-     -91,    66,    69,   -91,    34,    25,    25,   -91,    82,    34,
-      58,    69,   112,   -91,   -91,   -91,   102,    59,   103,    73,
-      86,   -91,   101,   -91,   -91,   -91,   -91,   -91,   -91,    30,
-      30,    30,   -91,    91,   -91,    74,    77,    93,   -91,   104,
-     -91,    34,   108,   -91,   -91,   -91,   -91,   -91,   -91,   -91,
-     -91,   109,   -91,   -91,   101,   -91,   -91,   -91
+      -1,    62,    87,    16,   -25,   -45,    -5,  -102,    -8,    -3,
+     -19,   -14,  -102,  -102,  -102,  -102,    -2,     8,    -1,     0,
+      55,    57,  -102,  -102,  -102,  -102,  -102,  -102,  -102,  -102,
+    -102,  -102,  -102,  -102,  -102,  -102,  -102,  -102,  -102,  -102,
+    -102,  -102,  -102,  -102,  -102,  -102,    21,    28,    44,    46,
+      16,  -102,  -102,  -102,    16,  -102,  -102,    27,    36,  -102,
+      64,    58,  -102,  -102,  -102,    48,    49,    65,    50,    61,
+      66,  -102,    52,    53,  -102,  -102,  -102,    88,    70,  -102,
+      71,   -11,  -102,    16,    16,    16,    16,    16,    59,    63,
+      67,  -102,    78,    77,    68,  -102,    25,    69,    72,  -102,
+      73,    74,    75,  -102,  -102,   -38,   -38,  -102,  -102,  -102,
+      93,    58,    97,     3,  -102,    79,    96,  -102,    85,    76,
+      60,   100,   110,  -102,    80,    77,  -102,    25,   109,    45,
+      45,  -102,    94,    25,    68,    77,   125,  -102,  -102,  -102,
+    -102,    22,    73,   114,    83,    93,  -102,   115,    97,  -102,
+    -102,  -102,  -102,  -102,  -102,  -102,     3,     3,     3,  -102,
+      96,  -102,    86,    89,    90,  -102,   100,    91,   117,  -102,
+      25,   120,   109,  -102,  -102,  -102,  -102,  -102,  -102,  -102,
+    -102,   121,  -102,  -102,    92,  -102,  -102,   115,  -102,  -102,
+      95,   101,  -102,  -102,    98,  -102
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -720,43 +735,46 @@ static const yytype_int8 yypact[] =
    means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
-       0,     0,     0,     0,     0,     0,     0,    25,     0,     0,
-       0,    26,    27,    28,    24,    23,     0,     0,     0,     0,
-      91,    22,    21,    14,    15,    16,    17,     9,    10,    11,
-      12,    13,     8,     5,     7,     6,     4,     3,    18,    19,
-      20,     0,     0,     0,     0,     0,    46,    47,    48,     0,
-      64,    55,    56,    67,    65,     0,    69,    31,    30,     0,
-       0,     0,     0,     0,    89,     1,    92,     2,     0,     0,
-      29,     0,     0,    63,     0,     0,     0,     0,     0,     0,
-       0,     0,    66,     0,    73,     0,     0,     0,     0,     0,
-       0,    62,    57,    58,    59,    60,    61,    68,    71,    69,
-       0,    75,    49,     0,    51,    90,     0,     0,    35,     0,
-      33,     0,    73,    70,     0,     0,     0,    74,    76,     0,
-       0,    73,     0,    40,    41,    42,    38,     0,     0,     0,
-      71,    54,    44,    82,    83,    84,    85,    86,    87,     0,
-       0,    75,    53,    51,    50,     0,     0,    35,    34,     0,
-      72,     0,     0,    79,    81,    78,    80,    77,    52,    88,
-      39,     0,    36,    32,    44,    43,    37,    45
+       0,     0,     0,     0,     0,     0,     0,    29,     0,     0,
+       0,    34,    36,    37,    28,    27,     0,     0,     0,    30,
+       0,   108,    26,    25,    15,    16,    17,    18,    19,    20,
+      21,     9,    10,    11,    12,    13,    14,     8,     5,     7,
+       6,     4,     3,    22,    23,    24,     0,     0,     0,     0,
+       0,    63,    64,    65,     0,    81,    72,    73,    84,    82,
+       0,    86,    41,    39,    40,     0,     0,     0,     0,     0,
+       0,   106,     0,    31,     1,   109,     2,     0,     0,    38,
+       0,     0,    80,     0,     0,     0,     0,     0,     0,     0,
+       0,    83,     0,    90,     0,    35,     0,     0,     0,    32,
+       0,     0,     0,    79,    74,    75,    76,    77,    78,    85,
+      88,    86,     0,    92,    66,     0,    68,   107,     0,     0,
+       0,    47,     0,    43,     0,    90,    87,     0,    59,     0,
+       0,    91,    93,     0,     0,    90,     0,    33,    54,    55,
+      56,    51,     0,     0,     0,    88,    71,    61,     0,    57,
+      99,   100,   101,   102,   103,   104,     0,     0,    92,    70,
+      68,    67,     0,     0,     0,    50,    47,    45,     0,    89,
+       0,     0,    59,    96,    98,    95,    97,    94,    69,   105,
+      53,     0,    52,    48,     0,    44,    42,    61,    58,    60,
+      51,     0,    62,    49,     0,    46
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -91,   -91,   110,   -91,   -91,   -91,   -91,   -91,   -91,   -91,
-     -91,   -91,   -91,   -91,   -91,   -18,     3,   -91,   -91,   -91,
-     -33,   -85,   -91,   -91,   -10,    12,   -91,   -91,    67,   -13,
-     -91,    -4,    39,     4,   -90,    -2,   -91,    21,   -91,   -91,
-     -91,   -91
+    -102,  -102,   126,  -102,  -102,  -102,  -102,  -102,  -102,  -102,
+    -102,  -102,  -102,  -102,  -102,  -102,  -102,  -102,  -102,  -102,
+     -20,     5,   -41,  -102,  -102,  -102,     2,   -21,   -33,   -95,
+    -102,  -102,     1,    23,  -102,  -102,    81,   -28,  -102,    -4,
+      47,    10,  -101,     4,  -102,    26,  -102,  -102,  -102,  -102
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_uint8 yydefgoto[] =
 {
-       0,    19,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    29,    30,    31,    32,   128,   108,   161,   126,    33,
-     152,    50,    34,    35,   121,   104,    36,    37,    51,    52,
-      55,   116,    82,   112,   102,   117,   118,   139,    38,    39,
-      40,    67
+       0,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,    35,    36,    37,   185,
+     143,   121,   165,   181,   141,    38,   128,   149,   171,    55,
+      39,    40,   135,   116,    41,    42,    56,    57,    60,   130,
+      91,   125,   114,   131,   132,   156,    43,    44,    45,    76
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -764,40 +782,44 @@ static const yytype_uint8 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_uint8 yytable[] =
 {
-      56,   105,    53,     1,     2,    57,    54,    91,     3,     4,
-       5,     6,     7,     8,     9,    10,   115,    45,    58,    11,
-      12,    13,   131,    41,    74,    42,    59,    14,    15,   132,
-      60,   144,    72,    61,   142,    16,    73,    17,    77,    78,
-      18,    75,    76,    77,    78,   123,   124,   125,    46,    47,
-      43,    48,    44,    49,   153,   155,   115,    75,    76,    77,
-      78,    65,    93,    94,    95,    96,   164,   133,   134,   135,
-     136,   137,   138,    62,    63,    66,    68,    99,    46,    47,
-      53,    48,    46,    47,    79,    48,    69,    70,    71,    80,
-      81,    83,    84,    85,    86,    87,    88,    89,    97,    90,
-      98,    53,   100,   101,   106,   111,   114,   119,   103,   107,
-     120,   122,   127,   109,   110,   129,   130,   141,   145,   146,
-     151,   148,   163,   149,   159,   160,   165,   166,    64,   162,
-     147,   167,   143,   158,   150,   154,   156,   140,   113,   157,
-       0,    92
+      61,   117,    63,     1,     2,    62,    72,   103,     3,     4,
+       5,     6,     7,     8,     9,    10,    86,    87,   129,    11,
+      12,    13,    81,    65,   146,    58,    82,    14,    15,    59,
+      66,    67,   147,    50,   161,    16,    68,    17,   159,   163,
+      18,    84,    85,    86,    87,    64,    83,    70,    69,    19,
+      73,    51,    52,    58,    53,    74,   105,   106,   107,   108,
+      75,   173,   175,   129,    51,    52,    88,    53,    46,    54,
+      47,    77,   164,    51,    52,   187,    53,    90,    78,    84,
+      85,    86,    87,   138,   139,   140,   111,   150,   151,   152,
+     153,   154,   155,    48,    79,    49,    80,    89,    92,    93,
+      95,    94,    98,    96,    99,   100,    97,   101,   102,   109,
+     112,   113,   124,   110,   127,   134,   136,    58,   115,   142,
+     118,   133,   119,   120,   122,   123,   137,   144,   148,   158,
+     145,   162,   167,   168,   170,   186,   179,   180,   188,   190,
+     182,   184,   191,   194,    71,   164,   183,   166,   195,   193,
+     172,   189,   174,   176,   192,   169,   157,   160,   126,     0,
+       0,   178,   177,     0,   104
 };
 
 static const yytype_int16 yycheck[] =
 {
-       4,    86,    50,     4,     5,    50,    54,    18,     9,    10,
-      11,    12,    13,    14,    15,    16,   101,    17,     7,    20,
-      21,    22,   112,     6,    19,     8,    31,    28,    29,   114,
-      33,   121,    45,    50,   119,    36,    49,    38,    54,    55,
-      41,    52,    53,    54,    55,    23,    24,    25,    48,    49,
-       6,    51,     8,    53,   139,   140,   141,    52,    53,    54,
-      55,     0,    75,    76,    77,    78,   151,    42,    43,    44,
-      45,    46,    47,    50,    39,     3,    50,    81,    48,    49,
-      50,    51,    48,    49,    30,    51,    50,    50,    50,    33,
-      19,    50,    50,    36,    42,    40,    17,    37,    50,    37,
-      50,    50,    32,    34,    51,    19,    17,    42,    50,    50,
-      19,    31,    19,    50,    50,    17,    50,    35,     6,    17,
-      19,    18,    18,    50,    50,    48,    18,    18,    18,   147,
-     127,   164,   120,   143,   130,   139,   140,   116,    99,   141,
-      -1,    74
+       4,    96,     7,     4,     5,    50,     6,    18,     9,    10,
+      11,    12,    13,    14,    15,    16,    54,    55,   113,    20,
+      21,    22,    50,    31,   125,    50,    54,    28,    29,    54,
+      33,    50,   127,    17,   135,    36,    50,    38,   133,    17,
+      41,    52,    53,    54,    55,    50,    19,    39,    50,    50,
+      50,    48,    49,    50,    51,     0,    84,    85,    86,    87,
+       3,   156,   157,   158,    48,    49,    30,    51,     6,    53,
+       8,    50,    50,    48,    49,   170,    51,    19,    50,    52,
+      53,    54,    55,    23,    24,    25,    90,    42,    43,    44,
+      45,    46,    47,     6,    50,     8,    50,    33,    50,    50,
+      50,    36,    50,    42,    51,    17,    40,    37,    37,    50,
+      32,    34,    19,    50,    17,    19,    31,    50,    50,    19,
+      51,    42,    50,    50,    50,    50,    50,    17,    19,    35,
+      50,     6,    18,    50,    19,    18,    50,    48,    18,    18,
+      50,    50,    50,    42,    18,    50,   166,   142,    50,   190,
+     148,   172,   156,   157,   187,   145,   130,   134,   111,    -1,
+      -1,   160,   158,    -1,    83
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
@@ -805,22 +827,25 @@ static const yytype_int16 yycheck[] =
 static const yytype_int8 yystos[] =
 {
        0,     4,     5,     9,    10,    11,    12,    13,    14,    15,
-      16,    20,    21,    22,    28,    29,    36,    38,    41,    58,
-      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
-      69,    70,    71,    76,    79,    80,    83,    84,    95,    96,
-      97,     6,     8,     6,     8,    17,    48,    49,    51,    53,
-      78,    85,    86,    50,    54,    87,    88,    50,     7,    31,
-      33,    50,    50,    39,    59,     0,     3,    98,    50,    50,
-      50,    50,    86,    86,    19,    52,    53,    54,    55,    30,
-      33,    19,    89,    50,    50,    36,    42,    40,    17,    37,
-      37,    18,    85,    86,    86,    86,    86,    50,    50,    88,
-      32,    34,    91,    50,    82,    78,    51,    50,    73,    50,
-      50,    19,    90,    89,    17,    78,    88,    92,    93,    42,
-      19,    81,    31,    23,    24,    25,    75,    19,    72,    17,
-      50,    91,    78,    42,    43,    44,    45,    46,    47,    94,
-      94,    35,    78,    82,    91,     6,    17,    73,    18,    50,
-      90,    19,    77,    78,    88,    78,    88,    92,    81,    50,
-      48,    74,    72,    18,    78,    18,    18,    77
+      16,    20,    21,    22,    28,    29,    36,    38,    41,    50,
+      58,    59,    60,    61,    62,    63,    64,    65,    66,    67,
+      68,    69,    70,    71,    72,    73,    74,    75,    82,    87,
+      88,    91,    92,   103,   104,   105,     6,     8,     6,     8,
+      17,    48,    49,    51,    53,    86,    93,    94,    50,    54,
+      95,    96,    50,     7,    50,    31,    33,    50,    50,    50,
+      39,    59,     6,    50,     0,     3,   106,    50,    50,    50,
+      50,    94,    94,    19,    52,    53,    54,    55,    30,    33,
+      19,    97,    50,    50,    36,    50,    42,    40,    50,    51,
+      17,    37,    37,    18,    93,    94,    94,    94,    94,    50,
+      50,    96,    32,    34,    99,    50,    90,    86,    51,    50,
+      50,    78,    50,    50,    19,    98,    97,    17,    83,    86,
+      96,   100,   101,    42,    19,    89,    31,    50,    23,    24,
+      25,    81,    19,    77,    17,    50,    99,    86,    19,    84,
+      42,    43,    44,    45,    46,    47,   102,   102,    35,    86,
+      90,    99,     6,    17,    50,    79,    78,    18,    50,    98,
+      19,    85,    83,    86,    96,    86,    96,   100,    89,    50,
+      48,    80,    50,    77,    50,    76,    18,    86,    18,    84,
+      18,    50,    85,    79,    42,    50
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
@@ -828,14 +853,15 @@ static const yytype_int8 yyr1[] =
 {
        0,    57,    58,    59,    59,    59,    59,    59,    59,    59,
       59,    59,    59,    59,    59,    59,    59,    59,    59,    59,
-      59,    59,    59,    60,    61,    62,    63,    64,    65,    66,
-      67,    68,    69,    70,    71,    72,    72,    73,    73,    74,
-      75,    75,    75,    76,    77,    77,    78,    78,    78,    79,
-      80,    81,    81,    82,    83,    84,    85,    85,    86,    86,
-      86,    86,    86,    86,    86,    87,    87,    88,    88,    89,
-      89,    90,    90,    91,    91,    92,    92,    92,    93,    93,
-      93,    93,    94,    94,    94,    94,    94,    94,    95,    96,
-      97,    98,    98
+      59,    59,    59,    59,    59,    59,    59,    60,    61,    62,
+      63,    63,    64,    65,    66,    66,    67,    68,    69,    70,
+      71,    72,    73,    74,    75,    76,    76,    77,    77,    78,
+      78,    79,    79,    80,    81,    81,    81,    82,    83,    84,
+      84,    85,    85,    86,    86,    86,    87,    88,    89,    89,
+      90,    91,    92,    93,    93,    94,    94,    94,    94,    94,
+      94,    94,    95,    95,    96,    96,    97,    97,    98,    98,
+      99,    99,   100,   100,   100,   101,   101,   101,   101,   102,
+     102,   102,   102,   102,   102,   103,   104,   105,   106,   106
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
@@ -843,14 +869,15 @@ static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
-       2,     2,     8,     5,     7,     0,     3,     5,     2,     1,
-       1,     1,     1,     8,     0,     3,     1,     1,     1,     4,
-       6,     0,     3,     3,     6,     2,     1,     3,     3,     3,
-       3,     3,     3,     2,     1,     1,     2,     1,     3,     0,
-       3,     0,     3,     0,     2,     0,     1,     3,     3,     3,
-       3,     3,     1,     1,     1,     1,     1,     1,     7,     2,
-       4,     0,     1
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     2,     3,     5,     1,     3,     1,     1,     3,     2,
+       2,     2,     8,     5,     8,     0,     4,     0,     3,     6,
+       3,     0,     2,     1,     1,     1,     1,     6,     4,     0,
+       3,     0,     3,     1,     1,     1,     4,     6,     0,     3,
+       3,     6,     2,     1,     3,     3,     3,     3,     3,     3,
+       2,     1,     1,     2,     1,     3,     0,     3,     0,     3,
+       0,     2,     0,     1,     3,     3,     3,     3,     3,     1,
+       1,     1,     1,     1,     1,     7,     2,     4,     0,     1
 };
 
 
@@ -1712,93 +1739,196 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* commands: command_wrapper opt_semicolon  */
-#line 180 "yacc_sql.y"
+#line 189 "yacc_sql.y"
   {
     std::unique_ptr<ParsedSqlNode> sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
     sql_result->add_sql_node(std::move(sql_node));
   }
-#line 1721 "yacc_sql.cpp"
+#line 1748 "yacc_sql.cpp"
     break;
 
-  case 23: /* exit_stmt: EXIT  */
-#line 210 "yacc_sql.y"
+  case 27: /* exit_stmt: EXIT  */
+#line 223 "yacc_sql.y"
          {
       (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
     }
-#line 1730 "yacc_sql.cpp"
+#line 1757 "yacc_sql.cpp"
     break;
 
-  case 24: /* help_stmt: HELP  */
-#line 216 "yacc_sql.y"
+  case 28: /* help_stmt: HELP  */
+#line 229 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
     }
-#line 1738 "yacc_sql.cpp"
+#line 1765 "yacc_sql.cpp"
     break;
 
-  case 25: /* sync_stmt: SYNC  */
-#line 221 "yacc_sql.y"
+  case 29: /* sync_stmt: SYNC  */
+#line 234 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
     }
-#line 1746 "yacc_sql.cpp"
+#line 1773 "yacc_sql.cpp"
+    break;
+
+  case 30: /* vacuum_stmt: ID  */
+#line 242 "yacc_sql.y"
+    {
+      bool valid = (0 == strcasecmp((yyvsp[0].string), "vacuum"));
+      free((yyvsp[0].string));
+      if (!valid) {
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      (yyval.sql_node) = new ParsedSqlNode(SCF_VACUUM);
+    }
+#line 1787 "yacc_sql.cpp"
+    break;
+
+  case 31: /* vacuum_stmt: ID ID  */
+#line 252 "yacc_sql.y"
+    {
+      bool valid = (0 == strcasecmp((yyvsp[-1].string), "vacuum"));
+      free((yyvsp[-1].string));
+      if (!valid) {
+        free((yyvsp[0].string));
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      (yyval.sql_node) = new ParsedSqlNode(SCF_VACUUM);
+      (yyval.sql_node)->vacuum.relation_name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 1804 "yacc_sql.cpp"
+    break;
+
+  case 32: /* backup_stmt: ID ID SSS  */
+#line 269 "yacc_sql.y"
+    {
+      bool valid = (0 == strcasecmp((yyvsp[-2].string), "backup")) && (0 == strcasecmp((yyvsp[-1].string), "to"));
+      free((yyvsp[-2].string));
+      free((yyvsp[-1].string));
+      if (!valid) {
+        free((yyvsp[0].string));
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      char *tmp_path = common::substr((yyvsp[0].string), 1, strlen((yyvsp[0].string)) - 2);
+      (yyval.sql_node) = new ParsedSqlNode(SCF_BACKUP);
+      (yyval.sql_node)->backup.path = tmp_path;
+      free(tmp_path);
+      free((yyvsp[0].string));
+    }
+#line 1824 "yacc_sql.cpp"
+    break;
+
+  case 33: /* alter_table_stmt: ID TABLE ID ID ID  */
+#line 289 "yacc_sql.y"
+    {
+      bool valid = (0 == strcasecmp((yyvsp[-4].string), "alter")) && (0 == strcasecmp((yyvsp[-1].string), "read"))
+          && (0 == strcasecmp((yyvsp[0].string), "only") || 0 == strcasecmp((yyvsp[0].string), "write"));
+      bool read_only = valid && (0 == strcasecmp((yyvsp[0].string), "only"));
+      free((yyvsp[-4].string));
+      free((yyvsp[-1].string));
+      free((yyvsp[0].string));
+      if (!valid) {
+        free((yyvsp[-2].string));
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      (yyval.sql_node) = new ParsedSqlNode(SCF_ALTER_TABLE);
+      (yyval.sql_node)->alter_table.relation_name = (yyvsp[-2].string);
+      (yyval.sql_node)->alter_table.read_only = read_only;
+      free((yyvsp[-2].string));
+    }
+#line 1846 "yacc_sql.cpp"
     break;
 
-  case 26: /* begin_stmt: TRX_BEGIN  */
-#line 227 "yacc_sql.y"
+  case 34: /* begin_stmt: TRX_BEGIN  */
+#line 310 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
     }
-#line 1754 "yacc_sql.cpp"
+#line 1854 "yacc_sql.cpp"
     break;
 
-  case 27: /* commit_stmt: TRX_COMMIT  */
-#line 233 "yacc_sql.y"
+  case 35: /* begin_stmt: TRX_BEGIN ID ID  */
+#line 314 "yacc_sql.y"
+    {
+      bool valid = (0 == strcasecmp((yyvsp[-1].string), "read")) && (0 == strcasecmp((yyvsp[0].string), "only"));
+      free((yyvsp[-1].string));
+      free((yyvsp[0].string));
+      if (!valid) {
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
+      (yyval.sql_node)->begin.read_only = true;
+    }
+#line 1870 "yacc_sql.cpp"
+    break;
+
+  case 36: /* commit_stmt: TRX_COMMIT  */
+#line 328 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
     }
-#line 1762 "yacc_sql.cpp"
+#line 1878 "yacc_sql.cpp"
     break;
 
-  case 28: /* rollback_stmt: TRX_ROLLBACK  */
-#line 239 "yacc_sql.y"
+  case 37: /* rollback_stmt: TRX_ROLLBACK  */
+#line 334 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
     }
-#line 1770 "yacc_sql.cpp"
+#line 1886 "yacc_sql.cpp"
     break;
 
-  case 29: /* drop_table_stmt: DROP TABLE ID  */
-#line 245 "yacc_sql.y"
+  case 38: /* drop_table_stmt: DROP TABLE ID  */
+#line 340 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
       (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1780 "yacc_sql.cpp"
+#line 1896 "yacc_sql.cpp"
     break;
 
-  case 30: /* show_tables_stmt: SHOW TABLES  */
-#line 252 "yacc_sql.y"
+  case 39: /* show_tables_stmt: SHOW TABLES  */
+#line 347 "yacc_sql.y"
                 {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
     }
-#line 1788 "yacc_sql.cpp"
+#line 1904 "yacc_sql.cpp"
+    break;
+
+  case 40: /* show_status_stmt: SHOW ID  */
+#line 354 "yacc_sql.y"
+            {
+      bool valid = (0 == strcasecmp((yyvsp[0].string), "status"));
+      free((yyvsp[0].string));
+      if (!valid) {
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_STATUS);
+    }
+#line 1918 "yacc_sql.cpp"
     break;
 
-  case 31: /* desc_table_stmt: DESC ID  */
-#line 258 "yacc_sql.y"
+  case 41: /* desc_table_stmt: DESC ID  */
+#line 366 "yacc_sql.y"
              {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
       (yyval.sql_node)->desc_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1798 "yacc_sql.cpp"
+#line 1928 "yacc_sql.cpp"
     break;
 
-  case 32: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID RBRACE  */
-#line 267 "yacc_sql.y"
+  case 42: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID RBRACE  */
+#line 375 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
@@ -1809,11 +1939,11 @@ yyreduce:
       free((yyvsp[-3].string));
       free((yyvsp[-1].string));
     }
-#line 1813 "yacc_sql.cpp"
+#line 1943 "yacc_sql.cpp"
     break;
 
-  case 33: /* drop_index_stmt: DROP INDEX ID ON ID  */
-#line 281 "yacc_sql.y"
+  case 43: /* drop_index_stmt: DROP INDEX ID ON ID  */
+#line 389 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
       (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].string);
@@ -1821,39 +1951,68 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 1825 "yacc_sql.cpp"
+#line 1955 "yacc_sql.cpp"
     break;
 
-  case 34: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE  */
-#line 291 "yacc_sql.y"
+  case 44: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format  */
+#line 399 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
-      create_table.relation_name = (yyvsp[-4].string);
-      free((yyvsp[-4].string));
+      create_table.relation_name = (yyvsp[-5].string);
+      free((yyvsp[-5].string));
 
-      std::vector<AttrInfoSqlNode> *src_attrs = (yyvsp[-1].attr_infos);
+      std::vector<AttrInfoSqlNode> *src_attrs = (yyvsp[-2].attr_infos);
 
       if (src_attrs != nullptr) {
         create_table.attr_infos.swap(*src_attrs);
       }
-      create_table.attr_infos.emplace_back(*(yyvsp[-2].attr_info));
+      create_table.attr_infos.emplace_back(*(yyvsp[-3].attr_info));
       std::reverse(create_table.attr_infos.begin(), create_table.attr_infos.end());
-      delete (yyvsp[-2].attr_info);
+      delete (yyvsp[-3].attr_info);
+
+      if ((yyvsp[0].string) != nullptr) {
+        create_table.storage_format = (yyvsp[0].string);
+        free((yyvsp[0].string));
+      }
     }
-#line 1845 "yacc_sql.cpp"
+#line 1980 "yacc_sql.cpp"
     break;
 
-  case 35: /* attr_def_list: %empty  */
-#line 309 "yacc_sql.y"
+  case 45: /* storage_format: %empty  */
+#line 422 "yacc_sql.y"
+    {
+      (yyval.string) = nullptr;
+    }
+#line 1988 "yacc_sql.cpp"
+    break;
+
+  case 46: /* storage_format: ID ID EQ ID  */
+#line 427 "yacc_sql.y"
+    {
+      bool valid = (0 == strcasecmp((yyvsp[-3].string), "storage") && 0 == strcasecmp((yyvsp[-2].string), "format"));
+      free((yyvsp[-3].string));
+      free((yyvsp[-2].string));
+      if (!valid) {
+        free((yyvsp[0].string));
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "expect STORAGE FORMAT = <format>");
+        YYERROR;
+      }
+      (yyval.string) = (yyvsp[0].string);
+    }
+#line 2004 "yacc_sql.cpp"
+    break;
+
+  case 47: /* attr_def_list: %empty  */
+#line 441 "yacc_sql.y"
     {
       (yyval.attr_infos) = nullptr;
     }
-#line 1853 "yacc_sql.cpp"
+#line 2012 "yacc_sql.cpp"
     break;
 
-  case 36: /* attr_def_list: COMMA attr_def attr_def_list  */
-#line 313 "yacc_sql.y"
+  case 48: /* attr_def_list: COMMA attr_def attr_def_list  */
+#line 445 "yacc_sql.y"
     {
       if ((yyvsp[0].attr_infos) != nullptr) {
         (yyval.attr_infos) = (yyvsp[0].attr_infos);
@@ -1863,83 +2022,152 @@ yyreduce:
       (yyval.attr_infos)->emplace_back(*(yyvsp[-1].attr_info));
       delete (yyvsp[-1].attr_info);
     }
-#line 1867 "yacc_sql.cpp"
+#line 2026 "yacc_sql.cpp"
     break;
 
-  case 37: /* attr_def: ID type LBRACE number RBRACE  */
-#line 326 "yacc_sql.y"
+  case 49: /* attr_def: ID type LBRACE number RBRACE column_encoding  */
+#line 458 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
-      (yyval.attr_info)->type = (AttrType)(yyvsp[-3].number);
-      (yyval.attr_info)->name = (yyvsp[-4].string);
-      (yyval.attr_info)->length = (yyvsp[-1].number);
-      free((yyvsp[-4].string));
+      (yyval.attr_info)->type = (AttrType)(yyvsp[-4].number);
+      (yyval.attr_info)->name = (yyvsp[-5].string);
+      (yyval.attr_info)->length = (yyvsp[-2].number);
+      if ((yyvsp[0].string) != nullptr) {
+        (yyval.attr_info)->encoding = (yyvsp[0].string);
+        free((yyvsp[0].string));
+      }
+      free((yyvsp[-5].string));
     }
-#line 1879 "yacc_sql.cpp"
+#line 2042 "yacc_sql.cpp"
     break;
 
-  case 38: /* attr_def: ID type  */
-#line 334 "yacc_sql.y"
+  case 50: /* attr_def: ID type column_encoding  */
+#line 470 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
-      (yyval.attr_info)->type = (AttrType)(yyvsp[0].number);
-      (yyval.attr_info)->name = (yyvsp[-1].string);
+      (yyval.attr_info)->type = (AttrType)(yyvsp[-1].number);
+      (yyval.attr_info)->name = (yyvsp[-2].string);
       (yyval.attr_info)->length = 4;
+      if ((yyvsp[0].string) != nullptr) {
+        (yyval.attr_info)->encoding = (yyvsp[0].string);
+        free((yyvsp[0].string));
+      }
+      free((yyvsp[-2].string));
+    }
+#line 2058 "yacc_sql.cpp"
+    break;
+
+  case 51: /* column_encoding: %empty  */
+#line 484 "yacc_sql.y"
+    {
+      (yyval.string) = nullptr;
+    }
+#line 2066 "yacc_sql.cpp"
+    break;
+
+  case 52: /* column_encoding: ID ID  */
+#line 489 "yacc_sql.y"
+    {
+      bool valid = (0 == strcasecmp((yyvsp[-1].string), "encoding"));
       free((yyvsp[-1].string));
+      if (!valid) {
+        free((yyvsp[0].string));
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "expect ENCODING <encoding>");
+        YYERROR;
+      }
+      (yyval.string) = (yyvsp[0].string);
     }
-#line 1891 "yacc_sql.cpp"
+#line 2081 "yacc_sql.cpp"
     break;
 
-  case 39: /* number: NUMBER  */
-#line 343 "yacc_sql.y"
+  case 53: /* number: NUMBER  */
+#line 501 "yacc_sql.y"
            {(yyval.number) = (yyvsp[0].number);}
-#line 1897 "yacc_sql.cpp"
+#line 2087 "yacc_sql.cpp"
     break;
 
-  case 40: /* type: INT_T  */
-#line 346 "yacc_sql.y"
+  case 54: /* type: INT_T  */
+#line 504 "yacc_sql.y"
                { (yyval.number)=INTS; }
-#line 1903 "yacc_sql.cpp"
+#line 2093 "yacc_sql.cpp"
     break;
 
-  case 41: /* type: STRING_T  */
-#line 347 "yacc_sql.y"
+  case 55: /* type: STRING_T  */
+#line 505 "yacc_sql.y"
                { (yyval.number)=CHARS; }
-#line 1909 "yacc_sql.cpp"
+#line 2099 "yacc_sql.cpp"
     break;
 
-  case 42: /* type: FLOAT_T  */
-#line 348 "yacc_sql.y"
+  case 56: /* type: FLOAT_T  */
+#line 506 "yacc_sql.y"
                { (yyval.number)=FLOATS; }
-#line 1915 "yacc_sql.cpp"
+#line 2105 "yacc_sql.cpp"
     break;
 
-  case 43: /* insert_stmt: INSERT INTO ID VALUES LBRACE value value_list RBRACE  */
-#line 352 "yacc_sql.y"
+  case 57: /* insert_stmt: INSERT INTO ID VALUES value_row value_row_list  */
+#line 510 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
-      (yyval.sql_node)->insertion.relation_name = (yyvsp[-5].string);
+      (yyval.sql_node)->insertion.relation_name = (yyvsp[-3].string);
+      if ((yyvsp[0].value_row_list) != nullptr) {
+        (yyval.sql_node)->insertion.rows.swap(*(yyvsp[0].value_row_list));
+        delete (yyvsp[0].value_row_list);
+      }
+      (yyval.sql_node)->insertion.rows.emplace_back(std::move(*(yyvsp[-1].value_list)));
+      std::reverse((yyval.sql_node)->insertion.rows.begin(), (yyval.sql_node)->insertion.rows.end());
+      delete (yyvsp[-1].value_list);
+      free((yyvsp[-3].string));
+    }
+#line 2122 "yacc_sql.cpp"
+    break;
+
+  case 58: /* value_row: LBRACE value value_list RBRACE  */
+#line 526 "yacc_sql.y"
+    {
       if ((yyvsp[-1].value_list) != nullptr) {
-        (yyval.sql_node)->insertion.values.swap(*(yyvsp[-1].value_list));
+        (yyval.value_list) = (yyvsp[-1].value_list);
+      } else {
+        (yyval.value_list) = new std::vector<Value>;
       }
-      (yyval.sql_node)->insertion.values.emplace_back(*(yyvsp[-2].value));
-      std::reverse((yyval.sql_node)->insertion.values.begin(), (yyval.sql_node)->insertion.values.end());
+      (yyval.value_list)->emplace_back(*(yyvsp[-2].value));
+      std::reverse((yyval.value_list)->begin(), (yyval.value_list)->end());
       delete (yyvsp[-2].value);
-      free((yyvsp[-5].string));
     }
-#line 1931 "yacc_sql.cpp"
+#line 2137 "yacc_sql.cpp"
+    break;
+
+  case 59: /* value_row_list: %empty  */
+#line 540 "yacc_sql.y"
+    {
+      (yyval.value_row_list) = nullptr;
+    }
+#line 2145 "yacc_sql.cpp"
     break;
 
-  case 44: /* value_list: %empty  */
-#line 367 "yacc_sql.y"
+  case 60: /* value_row_list: COMMA value_row value_row_list  */
+#line 544 "yacc_sql.y"
+    {
+      if ((yyvsp[0].value_row_list) != nullptr) {
+        (yyval.value_row_list) = (yyvsp[0].value_row_list);
+      } else {
+        (yyval.value_row_list) = new std::vector<std::vector<Value>>;
+      }
+      (yyval.value_row_list)->emplace_back(std::move(*(yyvsp[-1].value_list)));
+      delete (yyvsp[-1].value_list);
+    }
+#line 2159 "yacc_sql.cpp"
+    break;
+
+  case 61: /* value_list: %empty  */
+#line 557 "yacc_sql.y"
     {
       (yyval.value_list) = nullptr;
     }
-#line 1939 "yacc_sql.cpp"
+#line 2167 "yacc_sql.cpp"
     break;
 
-  case 45: /* value_list: COMMA value value_list  */
-#line 370 "yacc_sql.y"
+  case 62: /* value_list: COMMA value value_list  */
+#line 560 "yacc_sql.y"
                               { 
       if ((yyvsp[0].value_list) != nullptr) {
         (yyval.value_list) = (yyvsp[0].value_list);
@@ -1949,39 +2177,39 @@ yyreduce:
       (yyval.value_list)->emplace_back(*(yyvsp[-1].value));
       delete (yyvsp[-1].value);
     }
-#line 1953 "yacc_sql.cpp"
+#line 2181 "yacc_sql.cpp"
     break;
 
-  case 46: /* value: NUMBER  */
-#line 381 "yacc_sql.y"
+  case 63: /* value: NUMBER  */
+#line 571 "yacc_sql.y"
            {
       (yyval.value) = new Value((int)(yyvsp[0].number));
       (yyloc) = (yylsp[0]);
     }
-#line 1962 "yacc_sql.cpp"
+#line 2190 "yacc_sql.cpp"
     break;
 
-  case 47: /* value: FLOAT  */
-#line 385 "yacc_sql.y"
+  case 64: /* value: FLOAT  */
+#line 575 "yacc_sql.y"
            {
       (yyval.value) = new Value((float)(yyvsp[0].floats));
       (yyloc) = (yylsp[0]);
     }
-#line 1971 "yacc_sql.cpp"
+#line 2199 "yacc_sql.cpp"
     break;
 
-  case 48: /* value: SSS  */
-#line 389 "yacc_sql.y"
+  case 65: /* value: SSS  */
+#line 579 "yacc_sql.y"
          {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       (yyval.value) = new Value(tmp);
       free(tmp);
     }
-#line 1981 "yacc_sql.cpp"
+#line 2209 "yacc_sql.cpp"
     break;
 
-  case 49: /* delete_stmt: DELETE FROM ID where  */
-#line 398 "yacc_sql.y"
+  case 66: /* delete_stmt: DELETE FROM ID where  */
+#line 588 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
       (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].string);
@@ -1991,11 +2219,11 @@ yyreduce:
       }
       free((yyvsp[-1].string));
     }
-#line 1995 "yacc_sql.cpp"
+#line 2223 "yacc_sql.cpp"
     break;
 
-  case 50: /* update_stmt: UPDATE ID SET set set_list where  */
-#line 410 "yacc_sql.y"
+  case 67: /* update_stmt: UPDATE ID SET set set_list where  */
+#line 600 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
       (yyval.sql_node)->update.relation_name = (yyvsp[-4].string);
@@ -2011,19 +2239,19 @@ yyreduce:
       }
       free((yyvsp[-4].string));
     }
-#line 2015 "yacc_sql.cpp"
+#line 2243 "yacc_sql.cpp"
     break;
 
-  case 51: /* set_list: %empty  */
-#line 428 "yacc_sql.y"
+  case 68: /* set_list: %empty  */
+#line 618 "yacc_sql.y"
     {
       (yyval.set_list) = nullptr;
     }
-#line 2023 "yacc_sql.cpp"
+#line 2251 "yacc_sql.cpp"
     break;
 
-  case 52: /* set_list: COMMA set set_list  */
-#line 431 "yacc_sql.y"
+  case 69: /* set_list: COMMA set set_list  */
+#line 621 "yacc_sql.y"
                          {
       if ((yyvsp[0].set_list) != nullptr) {
         (yyval.set_list) = (yyvsp[0].set_list);
@@ -2033,19 +2261,19 @@ yyreduce:
       (yyval.set_list)->emplace_back(*(yyvsp[-1].set));
       delete (yyvsp[-1].set);
     }
-#line 2037 "yacc_sql.cpp"
+#line 2265 "yacc_sql.cpp"
     break;
 
-  case 53: /* set: ID EQ value  */
-#line 442 "yacc_sql.y"
+  case 70: /* set: ID EQ value  */
+#line 632 "yacc_sql.y"
                 {
       (yyval.set) = new std::pair<std::string, Value>((yyvsp[-2].string), *(yyvsp[0].value));
     }
-#line 2045 "yacc_sql.cpp"
+#line 2273 "yacc_sql.cpp"
     break;
 
-  case 54: /* select_stmt: SELECT select_attr FROM ID rel_list where  */
-#line 448 "yacc_sql.y"
+  case 71: /* select_stmt: SELECT select_attr FROM ID rel_list where  */
+#line 638 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
       if ((yyvsp[-4].rel_attr_list) != nullptr) {
@@ -2065,31 +2293,31 @@ yyreduce:
       }
       free((yyvsp[-2].string));
     }
-#line 2069 "yacc_sql.cpp"
+#line 2297 "yacc_sql.cpp"
     break;
 
-  case 55: /* calc_stmt: CALC expression_list  */
-#line 470 "yacc_sql.y"
+  case 72: /* calc_stmt: CALC expression_list  */
+#line 660 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
       std::reverse((yyvsp[0].expression_list)->begin(), (yyvsp[0].expression_list)->end());
       (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
       delete (yyvsp[0].expression_list);
     }
-#line 2080 "yacc_sql.cpp"
+#line 2308 "yacc_sql.cpp"
     break;
 
-  case 56: /* expression_list: expression  */
-#line 480 "yacc_sql.y"
+  case 73: /* expression_list: expression  */
+#line 670 "yacc_sql.y"
     {
       (yyval.expression_list) = new std::vector<Expression*>;
       (yyval.expression_list)->emplace_back((yyvsp[0].expression));
     }
-#line 2089 "yacc_sql.cpp"
+#line 2317 "yacc_sql.cpp"
     break;
 
-  case 57: /* expression_list: expression COMMA expression_list  */
-#line 485 "yacc_sql.y"
+  case 74: /* expression_list: expression COMMA expression_list  */
+#line 675 "yacc_sql.y"
     {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2098,70 +2326,70 @@ yyreduce:
       }
       (yyval.expression_list)->emplace_back((yyvsp[-2].expression));
     }
-#line 2102 "yacc_sql.cpp"
+#line 2330 "yacc_sql.cpp"
     break;
 
-  case 58: /* expression: expression '+' expression  */
-#line 495 "yacc_sql.y"
+  case 75: /* expression: expression '+' expression  */
+#line 685 "yacc_sql.y"
                               {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2110 "yacc_sql.cpp"
+#line 2338 "yacc_sql.cpp"
     break;
 
-  case 59: /* expression: expression '-' expression  */
-#line 498 "yacc_sql.y"
+  case 76: /* expression: expression '-' expression  */
+#line 688 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2118 "yacc_sql.cpp"
+#line 2346 "yacc_sql.cpp"
     break;
 
-  case 60: /* expression: expression '*' expression  */
-#line 501 "yacc_sql.y"
+  case 77: /* expression: expression '*' expression  */
+#line 691 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2126 "yacc_sql.cpp"
+#line 2354 "yacc_sql.cpp"
     break;
 
-  case 61: /* expression: expression '/' expression  */
-#line 504 "yacc_sql.y"
+  case 78: /* expression: expression '/' expression  */
+#line 694 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2134 "yacc_sql.cpp"
+#line 2362 "yacc_sql.cpp"
     break;
 
-  case 62: /* expression: LBRACE expression RBRACE  */
-#line 507 "yacc_sql.y"
+  case 79: /* expression: LBRACE expression RBRACE  */
+#line 697 "yacc_sql.y"
                                {
       (yyval.expression) = (yyvsp[-1].expression);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2143 "yacc_sql.cpp"
+#line 2371 "yacc_sql.cpp"
     break;
 
-  case 63: /* expression: '-' expression  */
-#line 511 "yacc_sql.y"
+  case 80: /* expression: '-' expression  */
+#line 701 "yacc_sql.y"
                                   {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, (yyvsp[0].expression), nullptr, sql_string, &(yyloc));
     }
-#line 2151 "yacc_sql.cpp"
+#line 2379 "yacc_sql.cpp"
     break;
 
-  case 64: /* expression: value  */
-#line 514 "yacc_sql.y"
+  case 81: /* expression: value  */
+#line 704 "yacc_sql.y"
             {
       (yyval.expression) = new ValueExpr(*(yyvsp[0].value));
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].value);
     }
-#line 2161 "yacc_sql.cpp"
+#line 2389 "yacc_sql.cpp"
     break;
 
-  case 65: /* select_attr: '*'  */
-#line 522 "yacc_sql.y"
+  case 82: /* select_attr: '*'  */
+#line 712 "yacc_sql.y"
         {
       (yyval.rel_attr_list) = new std::vector<RelAttrSqlNode>;
       RelAttrSqlNode attr;
@@ -2169,11 +2397,11 @@ yyreduce:
       attr.attribute_name = "*";
       (yyval.rel_attr_list)->emplace_back(attr);
     }
-#line 2173 "yacc_sql.cpp"
+#line 2401 "yacc_sql.cpp"
     break;
 
-  case 66: /* select_attr: rel_attr attr_list  */
-#line 529 "yacc_sql.y"
+  case 83: /* select_attr: rel_attr attr_list  */
+#line 719 "yacc_sql.y"
                          {
       if ((yyvsp[0].rel_attr_list) != nullptr) {
         (yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
@@ -2183,21 +2411,21 @@ yyreduce:
       (yyval.rel_attr_list)->emplace_back(*(yyvsp[-1].rel_attr));
       delete (yyvsp[-1].rel_attr);
     }
-#line 2187 "yacc_sql.cpp"
+#line 2415 "yacc_sql.cpp"
     break;
 
-  case 67: /* rel_attr: ID  */
-#line 541 "yacc_sql.y"
+  case 84: /* rel_attr: ID  */
+#line 731 "yacc_sql.y"
        {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->attribute_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 2197 "yacc_sql.cpp"
+#line 2425 "yacc_sql.cpp"
     break;
 
-  case 68: /* rel_attr: ID DOT ID  */
-#line 546 "yacc_sql.y"
+  case 85: /* rel_attr: ID DOT ID  */
+#line 736 "yacc_sql.y"
                 {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->relation_name  = (yyvsp[-2].string);
@@ -2205,19 +2433,19 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 2209 "yacc_sql.cpp"
+#line 2437 "yacc_sql.cpp"
     break;
 
-  case 69: /* attr_list: %empty  */
-#line 557 "yacc_sql.y"
+  case 86: /* attr_list: %empty  */
+#line 747 "yacc_sql.y"
     {
       (yyval.rel_attr_list) = nullptr;
     }
-#line 2217 "yacc_sql.cpp"
+#line 2445 "yacc_sql.cpp"
     break;
 
-  case 70: /* attr_list: COMMA rel_attr attr_list  */
-#line 560 "yacc_sql.y"
+  case 87: /* attr_list: COMMA rel_attr attr_list  */
+#line 750 "yacc_sql.y"
                                {
       if ((yyvsp[0].rel_attr_list) != nullptr) {
         (yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
@@ -2228,19 +2456,19 @@ yyreduce:
       (yyval.rel_attr_list)->emplace_back(*(yyvsp[-1].rel_attr));
       delete (yyvsp[-1].rel_attr);
     }
-#line 2232 "yacc_sql.cpp"
+#line 2460 "yacc_sql.cpp"
     break;
 
-  case 71: /* rel_list: %empty  */
-#line 574 "yacc_sql.y"
+  case 88: /* rel_list: %empty  */
+#line 764 "yacc_sql.y"
     {
       (yyval.relation_list) = nullptr;
     }
-#line 2240 "yacc_sql.cpp"
+#line 2468 "yacc_sql.cpp"
     break;
 
-  case 72: /* rel_list: COMMA ID rel_list  */
-#line 577 "yacc_sql.y"
+  case 89: /* rel_list: COMMA ID rel_list  */
+#line 767 "yacc_sql.y"
                         {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
@@ -2251,55 +2479,55 @@ yyreduce:
       (yyval.relation_list)->push_back((yyvsp[-1].string));
       free((yyvsp[-1].string));
     }
-#line 2255 "yacc_sql.cpp"
+#line 2483 "yacc_sql.cpp"
     break;
 
-  case 73: /* where: %empty  */
-#line 590 "yacc_sql.y"
+  case 90: /* where: %empty  */
+#line 780 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 2263 "yacc_sql.cpp"
+#line 2491 "yacc_sql.cpp"
     break;
 
-  case 74: /* where: WHERE condition_list  */
-#line 593 "yacc_sql.y"
+  case 91: /* where: WHERE condition_list  */
+#line 783 "yacc_sql.y"
                            {
       (yyval.condition_list) = (yyvsp[0].condition_list);  
     }
-#line 2271 "yacc_sql.cpp"
+#line 2499 "yacc_sql.cpp"
     break;
 
-  case 75: /* condition_list: %empty  */
-#line 599 "yacc_sql.y"
+  case 92: /* condition_list: %empty  */
+#line 789 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 2279 "yacc_sql.cpp"
+#line 2507 "yacc_sql.cpp"
     break;
 
-  case 76: /* condition_list: condition  */
-#line 602 "yacc_sql.y"
+  case 93: /* condition_list: condition  */
+#line 792 "yacc_sql.y"
                 {
       (yyval.condition_list) = new std::vector<ConditionSqlNode>;
       (yyval.condition_list)->emplace_back(*(yyvsp[0].condition));
       delete (yyvsp[0].condition);
     }
-#line 2289 "yacc_sql.cpp"
+#line 2517 "yacc_sql.cpp"
     break;
 
-  case 77: /* condition_list: condition AND condition_list  */
-#line 607 "yacc_sql.y"
+  case 94: /* condition_list: condition AND condition_list  */
+#line 797 "yacc_sql.y"
                                    {
       (yyval.condition_list) = (yyvsp[0].condition_list);
       (yyval.condition_list)->emplace_back(*(yyvsp[-2].condition));
       delete (yyvsp[-2].condition);
     }
-#line 2299 "yacc_sql.cpp"
+#line 2527 "yacc_sql.cpp"
     break;
 
-  case 78: /* condition: rel_attr comp_op value  */
-#line 615 "yacc_sql.y"
+  case 95: /* condition: rel_attr comp_op value  */
+#line 805 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 1;
@@ -2311,11 +2539,11 @@ yyreduce:
       delete (yyvsp[-2].rel_attr);
       delete (yyvsp[0].value);
     }
-#line 2315 "yacc_sql.cpp"
+#line 2543 "yacc_sql.cpp"
     break;
 
-  case 79: /* condition: value comp_op value  */
-#line 627 "yacc_sql.y"
+  case 96: /* condition: value comp_op value  */
+#line 817 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 0;
@@ -2327,11 +2555,11 @@ yyreduce:
       delete (yyvsp[-2].value);
       delete (yyvsp[0].value);
     }
-#line 2331 "yacc_sql.cpp"
+#line 2559 "yacc_sql.cpp"
     break;
 
-  case 80: /* condition: rel_attr comp_op rel_attr  */
-#line 639 "yacc_sql.y"
+  case 97: /* condition: rel_attr comp_op rel_attr  */
+#line 829 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 1;
@@ -2343,11 +2571,11 @@ yyreduce:
       delete (yyvsp[-2].rel_attr);
       delete (yyvsp[0].rel_attr);
     }
-#line 2347 "yacc_sql.cpp"
+#line 2575 "yacc_sql.cpp"
     break;
 
-  case 81: /* condition: value comp_op rel_attr  */
-#line 651 "yacc_sql.y"
+  case 98: /* condition: value comp_op rel_attr  */
+#line 841 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 0;
@@ -2359,47 +2587,47 @@ yyreduce:
       delete (yyvsp[-2].value);
       delete (yyvsp[0].rel_attr);
     }
-#line 2363 "yacc_sql.cpp"
+#line 2591 "yacc_sql.cpp"
     break;
 
-  case 82: /* comp_op: EQ  */
-#line 665 "yacc_sql.y"
+  case 99: /* comp_op: EQ  */
+#line 855 "yacc_sql.y"
          { (yyval.comp) = EQUAL_TO; }
-#line 2369 "yacc_sql.cpp"
+#line 2597 "yacc_sql.cpp"
     break;
 
-  case 83: /* comp_op: LT  */
-#line 666 "yacc_sql.y"
+  case 100: /* comp_op: LT  */
+#line 856 "yacc_sql.y"
          { (yyval.comp) = LESS_THAN; }
-#line 2375 "yacc_sql.cpp"
+#line 2603 "yacc_sql.cpp"
     break;
 
-  case 84: /* comp_op: GT  */
-#line 667 "yacc_sql.y"
+  case 101: /* comp_op: GT  */
+#line 857 "yacc_sql.y"
          { (yyval.comp) = GREAT_THAN; }
-#line 2381 "yacc_sql.cpp"
+#line 2609 "yacc_sql.cpp"
     break;
 
-  case 85: /* comp_op: LE  */
-#line 668 "yacc_sql.y"
+  case 102: /* comp_op: LE  */
+#line 858 "yacc_sql.y"
          { (yyval.comp) = LESS_EQUAL; }
-#line 2387 "yacc_sql.cpp"
+#line 2615 "yacc_sql.cpp"
     break;
 
-  case 86: /* comp_op: GE  */
-#line 669 "yacc_sql.y"
+  case 103: /* comp_op: GE  */
+#line 859 "yacc_sql.y"
          { (yyval.comp) = GREAT_EQUAL; }
-#line 2393 "yacc_sql.cpp"
+#line 2621 "yacc_sql.cpp"
     break;
 
-  case 87: /* comp_op: NE  */
-#line 670 "yacc_sql.y"
+  case 104: /* comp_op: NE  */
+#line 860 "yacc_sql.y"
          { (yyval.comp) = NOT_EQUAL; }
-#line 2399 "yacc_sql.cpp"
+#line 2627 "yacc_sql.cpp"
     break;
 
-  case 88: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
-#line 675 "yacc_sql.y"
+  case 105: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
+#line 865 "yacc_sql.y"
     {
       char *tmp_file_name = common::substr((yyvsp[-3].string), 1, strlen((yyvsp[-3].string)) - 2);
       
@@ -2409,20 +2637,20 @@ yyreduce:
       free((yyvsp[0].string));
       free(tmp_file_name);
     }
-#line 2413 "yacc_sql.cpp"
+#line 2641 "yacc_sql.cpp"
     break;
 
-  case 89: /* explain_stmt: EXPLAIN command_wrapper  */
-#line 688 "yacc_sql.y"
+  case 106: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 878 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
       (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
     }
-#line 2422 "yacc_sql.cpp"
+#line 2650 "yacc_sql.cpp"
     break;
 
-  case 90: /* set_variable_stmt: SET ID EQ value  */
-#line 696 "yacc_sql.y"
+  case 107: /* set_variable_stmt: SET ID EQ value  */
+#line 886 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
       (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
@@ -2430,11 +2658,11 @@ yyreduce:
       free((yyvsp[-2].string));
       delete (yyvsp[0].value);
     }
-#line 2434 "yacc_sql.cpp"
+#line 2662 "yacc_sql.cpp"
     break;
 
 
-#line 2438 "yacc_sql.cpp"
+#line 2666 "yacc_sql.cpp"
 
       default: break;
     }
@@ -2663,7 +2891,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 708 "yacc_sql.y"
+#line 898 "yacc_sql.y"
 
 //_____________________________________________________________________
 extern void scan_string(const char *str, yyscan_t scanner);
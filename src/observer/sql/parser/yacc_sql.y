@@ -112,6 +112,7 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
   Expression *                      expression;
   std::vector<Expression *> *       expression_list;
   std::vector<Value> *              value_list;
+  std::vector<std::vector<Value>> * value_row_list;
   std::vector<ConditionSqlNode> *   condition_list;
   std::vector<RelAttrSqlNode> *     rel_attr_list;
   std::vector<std::string> *        relation_list;
@@ -134,11 +135,15 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <value>               value
 %type <set>                 set
 %type <number>              number
+%type <string>              storage_format
+%type <string>              column_encoding
 %type <comp>                comp_op
 %type <rel_attr>            rel_attr
 %type <attr_infos>          attr_def_list
 %type <attr_info>           attr_def
 %type <value_list>          value_list
+%type <value_list>          value_row
+%type <value_row_list>      value_row_list
 %type <set_list>            set_list
 %type <condition_list>      where
 %type <condition_list>      condition_list
@@ -155,10 +160,14 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <sql_node>            create_table_stmt
 %type <sql_node>            drop_table_stmt
 %type <sql_node>            show_tables_stmt
+%type <sql_node>            show_status_stmt
 %type <sql_node>            desc_table_stmt
 %type <sql_node>            create_index_stmt
 %type <sql_node>            drop_index_stmt
 %type <sql_node>            sync_stmt
+%type <sql_node>            vacuum_stmt
+%type <sql_node>            backup_stmt
+%type <sql_node>            alter_table_stmt
 %type <sql_node>            begin_stmt
 %type <sql_node>            commit_stmt
 %type <sql_node>            rollback_stmt
@@ -192,10 +201,14 @@ command_wrapper:
   | create_table_stmt
   | drop_table_stmt
   | show_tables_stmt
+  | show_status_stmt
   | desc_table_stmt
   | create_index_stmt
   | drop_index_stmt
   | sync_stmt
+  | vacuum_stmt
+  | backup_stmt
+  | alter_table_stmt
   | begin_stmt
   | commit_stmt
   | rollback_stmt
@@ -223,10 +236,92 @@ sync_stmt:
     }
     ;
 
+/* VACUUM [table]，与 STORAGE FORMAT 一样没有单独定义关键字 */
+vacuum_stmt:
+    ID
+    {
+      bool valid = (0 == strcasecmp($1, "vacuum"));
+      free($1);
+      if (!valid) {
+        yyerror(&@$, sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      $$ = new ParsedSqlNode(SCF_VACUUM);
+    }
+    | ID ID
+    {
+      bool valid = (0 == strcasecmp($1, "vacuum"));
+      free($1);
+      if (!valid) {
+        free($2);
+        yyerror(&@$, sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      $$ = new ParsedSqlNode(SCF_VACUUM);
+      $$->vacuum.relation_name = $2;
+      free($2);
+    }
+    ;
+
+/* BACKUP TO 'path'，同样没有单独定义关键字 */
+backup_stmt:
+    ID ID SSS
+    {
+      bool valid = (0 == strcasecmp($1, "backup")) && (0 == strcasecmp($2, "to"));
+      free($1);
+      free($2);
+      if (!valid) {
+        free($3);
+        yyerror(&@$, sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      char *tmp_path = common::substr($3, 1, strlen($3) - 2);
+      $$ = new ParsedSqlNode(SCF_BACKUP);
+      $$->backup.path = tmp_path;
+      free(tmp_path);
+      free($3);
+    }
+    ;
+
+/* ALTER TABLE table READ ONLY | READ WRITE，同样没有单独定义关键字 */
+alter_table_stmt:
+    ID TABLE ID ID ID
+    {
+      bool valid = (0 == strcasecmp($1, "alter")) && (0 == strcasecmp($4, "read"))
+          && (0 == strcasecmp($5, "only") || 0 == strcasecmp($5, "write"));
+      bool read_only = valid && (0 == strcasecmp($5, "only"));
+      free($1);
+      free($4);
+      free($5);
+      if (!valid) {
+        free($3);
+        yyerror(&@$, sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      $$ = new ParsedSqlNode(SCF_ALTER_TABLE);
+      $$->alter_table.relation_name = $3;
+      $$->alter_table.read_only = read_only;
+      free($3);
+    }
+    ;
+
+/* BEGIN READ ONLY，READ 和 ONLY 也没有单独定义关键字 */
 begin_stmt:
     TRX_BEGIN  {
       $$ = new ParsedSqlNode(SCF_BEGIN);
     }
+    | TRX_BEGIN ID ID
+    {
+      bool valid = (0 == strcasecmp($2, "read")) && (0 == strcasecmp($3, "only"));
+      free($2);
+      free($3);
+      if (!valid) {
+        yyerror(&@$, sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      $$ = new ParsedSqlNode(SCF_BEGIN);
+      $$->begin.read_only = true;
+    }
     ;
 
 commit_stmt:
@@ -254,6 +349,19 @@ show_tables_stmt:
     }
     ;
 
+/* SHOW STATUS，没有单独定义关键字 */
+show_status_stmt:
+    SHOW ID {
+      bool valid = (0 == strcasecmp($2, "status"));
+      free($2);
+      if (!valid) {
+        yyerror(&@$, sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      $$ = new ParsedSqlNode(SCF_SHOW_STATUS);
+    }
+    ;
+
 desc_table_stmt:
     DESC ID  {
       $$ = new ParsedSqlNode(SCF_DESC_TABLE);
@@ -287,7 +395,7 @@ drop_index_stmt:      /*drop index 语句的语法解析树*/
     }
     ;
 create_table_stmt:    /*create table 语句的语法解析树*/
-    CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE
+    CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format
     {
       $$ = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = $$->create_table;
@@ -302,6 +410,30 @@ create_table_stmt:    /*create table 语句的语法解析树*/
       create_table.attr_infos.emplace_back(*$5);
       std::reverse(create_table.attr_infos.begin(), create_table.attr_infos.end());
       delete $5;
+
+      if ($8 != nullptr) {
+        create_table.storage_format = $8;
+        free($8);
+      }
+    }
+    ;
+storage_format:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    /* STORAGE FORMAT = xxx，这里没有单独定义关键字，避免影响使用这些名字的表和字段 */
+    | ID ID EQ ID
+    {
+      bool valid = (0 == strcasecmp($1, "storage") && 0 == strcasecmp($2, "format"));
+      free($1);
+      free($2);
+      if (!valid) {
+        free($4);
+        yyerror(&@$, sql_string, sql_result, scanner, "expect STORAGE FORMAT = <format>");
+        YYERROR;
+      }
+      $$ = $4;
     }
     ;
 attr_def_list:
@@ -322,23 +454,49 @@ attr_def_list:
     ;
     
 attr_def:
-    ID type LBRACE number RBRACE 
+    ID type LBRACE number RBRACE column_encoding
     {
       $$ = new AttrInfoSqlNode;
       $$->type = (AttrType)$2;
       $$->name = $1;
       $$->length = $4;
+      if ($6 != nullptr) {
+        $$->encoding = $6;
+        free($6);
+      }
       free($1);
     }
-    | ID type
+    | ID type column_encoding
     {
       $$ = new AttrInfoSqlNode;
       $$->type = (AttrType)$2;
       $$->name = $1;
       $$->length = 4;
+      if ($3 != nullptr) {
+        $$->encoding = $3;
+        free($3);
+      }
       free($1);
     }
     ;
+column_encoding:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    /* ENCODING xxx，与 STORAGE FORMAT 一样没有单独定义关键字 */
+    | ID ID
+    {
+      bool valid = (0 == strcasecmp($1, "encoding"));
+      free($1);
+      if (!valid) {
+        free($2);
+        yyerror(&@$, sql_string, sql_result, scanner, "expect ENCODING <encoding>");
+        YYERROR;
+      }
+      $$ = $2;
+    }
+    ;
 number:
     NUMBER {$$ = $1;}
     ;
@@ -348,20 +506,52 @@ type:
     | FLOAT_T  { $$=FLOATS; }
     ;
 insert_stmt:        /*insert   语句的语法解析树*/
-    INSERT INTO ID VALUES LBRACE value value_list RBRACE 
+    INSERT INTO ID VALUES value_row value_row_list
     {
       $$ = new ParsedSqlNode(SCF_INSERT);
       $$->insertion.relation_name = $3;
-      if ($7 != nullptr) {
-        $$->insertion.values.swap(*$7);
+      if ($6 != nullptr) {
+        $$->insertion.rows.swap(*$6);
+        delete $6;
       }
-      $$->insertion.values.emplace_back(*$6);
-      std::reverse($$->insertion.values.begin(), $$->insertion.values.end());
-      delete $6;
+      $$->insertion.rows.emplace_back(std::move(*$5));
+      std::reverse($$->insertion.rows.begin(), $$->insertion.rows.end());
+      delete $5;
       free($3);
     }
     ;
 
+value_row:
+    LBRACE value value_list RBRACE
+    {
+      if ($3 != nullptr) {
+        $$ = $3;
+      } else {
+        $$ = new std::vector<Value>;
+      }
+      $$->emplace_back(*$2);
+      std::reverse($$->begin(), $$->end());
+      delete $2;
+    }
+    ;
+
+value_row_list:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | COMMA value_row value_row_list
+    {
+      if ($3 != nullptr) {
+        $$ = $3;
+      } else {
+        $$ = new std::vector<std::vector<Value>>;
+      }
+      $$->emplace_back(std::move(*$2));
+      delete $2;
+    }
+    ;
+
 value_list:
     /* empty */
     {
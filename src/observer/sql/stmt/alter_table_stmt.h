@@ -0,0 +1,44 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include <string>
+
+#include "sql/stmt/stmt.h"
+
+class Db;
+
+/**
+ * @brief 修改表属性的语句
+ * @ingroup Statement
+ * @details 当前只能修改表的只读状态
+ */
+class AlterTableStmt : public Stmt
+{
+public:
+  AlterTableStmt(const std::string &table_name, bool read_only) : table_name_(table_name), read_only_(read_only) {}
+  virtual ~AlterTableStmt() = default;
+
+  StmtType type() const override { return StmtType::ALTER_TABLE; }
+
+  const std::string &table_name() const { return table_name_; }
+  bool               read_only() const { return read_only_; }
+
+  static RC create(Db *db, const AlterTableSqlNode &alter_table, Stmt *&stmt);
+
+private:
+  std::string table_name_;
+  bool        read_only_ = false;
+};
@@ -0,0 +1,26 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include "sql/stmt/backup_stmt.h"
+#include "common/lang/string.h"
+#include "common/log/log.h"
+
+RC BackupStmt::create(const BackupSqlNode &backup, Stmt *&stmt)
+{
+  if (common::is_blank(backup.path.c_str())) {
+    LOG_WARN("backup path cannot be empty");
+    return RC::INVALID_ARGUMENT;
+  }
+  stmt = new BackupStmt(backup.path);
+  return RC::SUCCESS;
+}
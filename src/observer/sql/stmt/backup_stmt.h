@@ -0,0 +1,41 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#pragma once
+
+#include <string>
+
+#include "sql/stmt/stmt.h"
+
+/**
+ * @brief 在线备份数据库的语句
+ * @ingroup Statement
+ */
+class BackupStmt : public Stmt
+{
+public:
+  BackupStmt(const std::string &path) : path_(path) {}
+  virtual ~BackupStmt() = default;
+
+  StmtType type() const override { return StmtType::BACKUP; }
+
+  /**
+   * @brief 备份目录
+   */
+  const std::string &path() const { return path_; }
+
+  static RC create(const BackupSqlNode &backup, Stmt *&stmt);
+
+private:
+  std::string path_;
+};
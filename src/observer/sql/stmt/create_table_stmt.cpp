@@ -13,11 +13,55 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/stmt/create_table_stmt.h"
+#include "common/log/log.h"
 #include "event/sql_debug.h"
+#include "storage/table/table_meta.h"
 
 RC CreateTableStmt::create(Db *db, const CreateTableSqlNode &create_table, Stmt *&stmt)
 {
-  stmt = new CreateTableStmt(create_table.relation_name, create_table.attr_infos);
+  StorageFormat storage_format = StorageFormat::ROW_FORMAT;
+  if (!create_table.storage_format.empty()) {
+    storage_format = storage_format_from_string(create_table.storage_format.c_str());
+    if (storage_format == StorageFormat::UNKNOWN_FORMAT) {
+      LOG_WARN("unknown storage format: %s", create_table.storage_format.c_str());
+      return RC::INVALID_ARGUMENT;
+    }
+  }
+
+  // 列编码只对按列存放的PAX页面有效。没有指定存放格式时，使用了列编码的表默认使用PAX格式
+  bool has_encoding = false;
+  for (const AttrInfoSqlNode &attr_info : create_table.attr_infos) {
+    if (attr_info.encoding.empty()) {
+      continue;
+    }
+
+    ColumnEncoding encoding = column_encoding_from_string(attr_info.encoding.c_str());
+    bool           valid    = false;
+    switch (encoding) {
+      case ColumnEncoding::PLAIN_ENCODING:
+      case ColumnEncoding::RLE_ENCODING: valid = true; break;
+      case ColumnEncoding::DICT_ENCODING: valid = (attr_info.type == CHARS); break;
+      case ColumnEncoding::FOR_ENCODING: valid = (attr_info.type == INTS || attr_info.type == DATES); break;
+      default: break;
+    }
+    if (!valid) {
+      LOG_WARN("invalid column encoding. field=%s, type=%s, encoding=%s",
+               attr_info.name.c_str(), attr_type_to_string(attr_info.type), attr_info.encoding.c_str());
+      return RC::INVALID_ARGUMENT;
+    }
+    has_encoding = has_encoding || encoding != ColumnEncoding::PLAIN_ENCODING;
+  }
+
+  if (has_encoding) {
+    if (create_table.storage_format.empty()) {
+      storage_format = StorageFormat::PAX_FORMAT;
+    } else if (storage_format != StorageFormat::PAX_FORMAT) {
+      LOG_WARN("column encoding requires pax storage format. table=%s", create_table.relation_name.c_str());
+      return RC::INVALID_ARGUMENT;
+    }
+  }
+
+  stmt = new CreateTableStmt(create_table.relation_name, create_table.attr_infos, storage_format);
   sql_debug("create table statement: table name %s", create_table.relation_name.c_str());
   return RC::SUCCESS;
 }
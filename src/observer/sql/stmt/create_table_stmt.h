@@ -17,6 +17,7 @@ See the Mulan PSL v2 for more details. */
 #include <string>
 #include <vector>
 
+#include "common/types.h"
 #include "sql/stmt/stmt.h"
 
 class Db;
@@ -29,8 +30,9 @@ class Db;
 class CreateTableStmt : public Stmt
 {
 public:
-  CreateTableStmt(const std::string &table_name, const std::vector<AttrInfoSqlNode> &attr_infos)
-      : table_name_(table_name), attr_infos_(attr_infos)
+  CreateTableStmt(
+      const std::string &table_name, const std::vector<AttrInfoSqlNode> &attr_infos, StorageFormat storage_format)
+      : table_name_(table_name), attr_infos_(attr_infos), storage_format_(storage_format)
   {}
   virtual ~CreateTableStmt() = default;
 
@@ -38,10 +40,12 @@ public:
 
   const std::string                  &table_name() const { return table_name_; }
   const std::vector<AttrInfoSqlNode> &attr_infos() const { return attr_infos_; }
+  StorageFormat                       storage_format() const { return storage_format_; }
 
   static RC create(Db *db, const CreateTableSqlNode &create_table, Stmt *&stmt);
 
 private:
   std::string                  table_name_;
   std::vector<AttrInfoSqlNode> attr_infos_;
+  StorageFormat                storage_format_ = StorageFormat::ROW_FORMAT;
 };
\ No newline at end of file
@@ -43,6 +43,11 @@ RC DeleteStmt::create(Db *db, const DeleteSqlNode &delete_sql, Stmt *&stmt)
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
 
+  if (table->table_meta().read_only()) {
+    LOG_WARN("table is read only. db=%s, table_name=%s", db->name(), table_name);
+    return RC::SCHEMA_TABLE_READ_ONLY;
+  }
+
   std::unordered_map<std::string, Table *> table_map;
   table_map.insert(std::pair<std::string, Table *>(std::string(table_name), table));
 
@@ -14,6 +14,8 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <vector>
+
 #include "common/rc.h"
 #include "sql/stmt/stmt.h"
 
@@ -23,12 +25,13 @@ class Db;
 /**
  * @brief 插入语句
  * @ingroup Statement
+ * @details 支持一次插入多行，即 INSERT INTO t VALUES (...), (...)。每一行都已经做过字段个数与类型的校验
  */
 class InsertStmt : public Stmt
 {
 public:
   InsertStmt() = default;
-  InsertStmt(Table *table, const Value *values, int value_amount);
+  InsertStmt(Table *table, const std::vector<std::vector<Value>> &rows);
 
   StmtType type() const override { return StmtType::INSERT; }
 
@@ -36,12 +39,10 @@ public:
   static RC create(Db *db, const InsertSqlNode &insert_sql, Stmt *&stmt);
 
 public:
-  Table       *table() const { return table_; }
-  const Value *values() const { return values_; }
-  int          value_amount() const { return value_amount_; }
+  Table                                 *table() const { return table_; }
+  const std::vector<std::vector<Value>> &rows() const { return rows_; }
 
 private:
-  Table       *table_        = nullptr;
-  const Value *values_       = nullptr;
-  int          value_amount_ = 0;
+  Table                          *table_ = nullptr;
+  std::vector<std::vector<Value>> rows_;  ///< 要插入的所有行
 };
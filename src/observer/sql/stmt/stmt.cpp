@@ -26,9 +26,14 @@ See the Mulan PSL v2 for more details. */
 #include "sql/stmt/load_data_stmt.h"
 #include "sql/stmt/select_stmt.h"
 #include "sql/stmt/set_variable_stmt.h"
+#include "sql/stmt/show_status_stmt.h"
 #include "sql/stmt/show_tables_stmt.h"
+#include "sql/stmt/sync_stmt.h"
 #include "sql/stmt/trx_begin_stmt.h"
 #include "sql/stmt/trx_end_stmt.h"
+#include "sql/stmt/vacuum_stmt.h"
+#include "sql/stmt/backup_stmt.h"
+#include "sql/stmt/alter_table_stmt.h"
 #include "sql/stmt/exit_stmt.h"
 #include "sql/stmt/set_variable_stmt.h"
 #include "sql/stmt/load_data_stmt.h"
@@ -81,8 +86,12 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
       return ShowTablesStmt::create(db, stmt);
     }
 
+    case SCF_SHOW_STATUS: {
+      return ShowStatusStmt::create(stmt);
+    }
+
     case SCF_BEGIN: {
-      return TrxBeginStmt::create(stmt);
+      return TrxBeginStmt::create(sql_node.begin, stmt);
     }
 
     case SCF_COMMIT:
@@ -94,6 +103,10 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
       return ExitStmt::create(stmt);
     }
 
+    case SCF_SYNC: {
+      return SyncStmt::create(stmt);
+    }
+
     case SCF_SET_VARIABLE: {
       return SetVariableStmt::create(sql_node.set_variable, stmt);
     }
@@ -102,6 +115,18 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
       return LoadDataStmt::create(db, sql_node.load_data, stmt);
     }
 
+    case SCF_VACUUM: {
+      return VacuumStmt::create(db, sql_node.vacuum, stmt);
+    }
+
+    case SCF_ALTER_TABLE: {
+      return AlterTableStmt::create(db, sql_node.alter_table, stmt);
+    }
+
+    case SCF_BACKUP: {
+      return BackupStmt::create(sql_node.backup, stmt);
+    }
+
     case SCF_CALC: {
       return CalcStmt::create(sql_node.calc, stmt);
     }
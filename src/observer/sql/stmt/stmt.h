@@ -41,6 +41,7 @@ class Db;
   DEFINE_ENUM_ITEM(DROP_INDEX)   \
   DEFINE_ENUM_ITEM(SYNC)         \
   DEFINE_ENUM_ITEM(SHOW_TABLES)  \
+  DEFINE_ENUM_ITEM(SHOW_STATUS)  \
   DEFINE_ENUM_ITEM(DESC_TABLE)   \
   DEFINE_ENUM_ITEM(BEGIN)        \
   DEFINE_ENUM_ITEM(COMMIT)       \
@@ -50,7 +51,10 @@ class Db;
   DEFINE_ENUM_ITEM(EXIT)         \
   DEFINE_ENUM_ITEM(EXPLAIN)      \
   DEFINE_ENUM_ITEM(PREDICATE)    \
-  DEFINE_ENUM_ITEM(SET_VARIABLE)
+  DEFINE_ENUM_ITEM(SET_VARIABLE) \
+  DEFINE_ENUM_ITEM(VACUUM)       \
+  DEFINE_ENUM_ITEM(ALTER_TABLE)  \
+  DEFINE_ENUM_ITEM(BACKUP)
 
 enum class StmtType
 {
@@ -0,0 +1,36 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include "sql/stmt/stmt.h"
+
+/**
+ * @brief Sync 语句，把数据写到磁盘并做一次 checkpoint
+ * @ingroup Statement
+ */
+class SyncStmt : public Stmt
+{
+public:
+  SyncStmt() {}
+  virtual ~SyncStmt() = default;
+
+  StmtType type() const override { return StmtType::SYNC; }
+
+  static RC create(Stmt *&stmt)
+  {
+    stmt = new SyncStmt();
+    return RC::SUCCESS;
+  }
+};
@@ -20,20 +20,25 @@ See the Mulan PSL v2 for more details. */
 #include "sql/stmt/stmt.h"
 
 /**
- * @brief 事务的Begin 语句，现在什么成员都没有
+ * @brief 事务的Begin 语句
  * @ingroup Statement
  */
 class TrxBeginStmt : public Stmt
 {
 public:
-  TrxBeginStmt() {}
+  TrxBeginStmt(bool read_only) : read_only_(read_only) {}
   virtual ~TrxBeginStmt() = default;
 
   StmtType type() const override { return StmtType::BEGIN; }
 
-  static RC create(Stmt *&stmt)
+  bool read_only() const { return read_only_; }
+
+  static RC create(const BeginSqlNode &begin, Stmt *&stmt)
   {
-    stmt = new TrxBeginStmt();
+    stmt = new TrxBeginStmt(begin.read_only);
     return RC::SUCCESS;
   }
+
+private:
+  bool read_only_ = false;  ///< 是否开始只读事务
 };
\ No newline at end of file
@@ -45,6 +45,11 @@ RC UpdateStmt::create(Db *db, const UpdateSqlNode &update, Stmt *&stmt)
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
 
+  if (table->table_meta().read_only()) {
+    LOG_WARN("table is read only. db=%s, table_name=%s", db->name(), table_name);
+    return RC::SCHEMA_TABLE_READ_ONLY;
+  }
+
   const TableMeta &table_meta = table->table_meta();
 
   for (auto pair : update.values) {
@@ -0,0 +1,25 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#include "sql/stmt/vacuum_stmt.h"
+#include "storage/db/db.h"
+
+RC VacuumStmt::create(Db *db, const VacuumSqlNode &vacuum, Stmt *&stmt)
+{
+  if (!vacuum.relation_name.empty() && db->find_table(vacuum.relation_name.c_str()) == nullptr) {
+    return RC::SCHEMA_TABLE_NOT_EXIST;
+  }
+  stmt = new VacuumStmt(vacuum.relation_name);
+  return RC::SUCCESS;
+}
@@ -0,0 +1,44 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#pragma once
+
+#include <string>
+
+#include "sql/stmt/stmt.h"
+
+class Db;
+
+/**
+ * @brief 整理表的语句
+ * @ingroup Statement
+ */
+class VacuumStmt : public Stmt
+{
+public:
+  VacuumStmt(const std::string &table_name) : table_name_(table_name) {}
+  virtual ~VacuumStmt() = default;
+
+  StmtType type() const override { return StmtType::VACUUM; }
+
+  /**
+   * @brief 要整理的表，为空表示整理所有的表
+   */
+  const std::string &table_name() const { return table_name_; }
+
+  static RC create(Db *db, const VacuumSqlNode &vacuum, Stmt *&stmt);
+
+private:
+  std::string table_name_;
+};
@@ -11,19 +11,28 @@ See the Mulan PSL v2 for more details. */
 //
 // Created by Meiyi & Longda on 2021/4/13.
 //
+#include <algorithm>
 #include <errno.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #include "common/io/io.h"
 #include "common/lang/mutex.h"
 #include "common/log/log.h"
 #include "storage/buffer/disk_buffer_pool.h"
+#include "storage/common/file_copy.h"
 
 using namespace common;
 using namespace std;
 
 static const int MEM_POOL_ITEM_NUM = 20;
 
+/// 页面写入磁盘之前用来刷日志，参考 DiskBufferPool::set_log_flusher
+static function<RC(LSN)> log_flusher;
+
+/// 在线备份时每次拿着锁复制的数据量，是页面大小的整数倍
+static const int64_t BACKUP_CHUNK_SIZE = 128 * BP_PAGE_SIZE;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 string BPFileHeader::to_string() const
@@ -188,6 +197,23 @@ RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
   return RC::SUCCESS;
 }
 
+RC BufferPoolIterator::init(const MappedFile &file, PageNum start_page /* = 0 */)
+{
+  const BPFileHeader *file_header = file.file_header();
+  if (nullptr == file_header) {
+    return RC::FILE_NOT_OPENED;
+  }
+
+  // 只会读取位图，不会修改映射的内存
+  bitmap_.init(const_cast<char *>(file_header->bitmap), file.page_count());
+  if (start_page <= 0) {
+    current_page_num_ = 0;
+  } else {
+    current_page_num_ = start_page;
+  }
+  return RC::SUCCESS;
+}
+
 bool BufferPoolIterator::has_next() { return bitmap_.next_setted_bit(current_page_num_ + 1) != -1; }
 
 PageNum BufferPoolIterator::next()
@@ -391,13 +417,31 @@ RC DiskBufferPool::allocate_page(Frame **frame)
 RC DiskBufferPool::dispose_page(PageNum page_num)
 {
   std::scoped_lock lock_guard(lock_);
-  Frame           *used_frame = frame_manager_.get(file_desc_, page_num);
+  if (page_num <= 0 || page_num >= file_header_->page_count ||
+      (file_header_->bitmap[page_num / 8] & (1 << (page_num % 8))) == 0) {
+    LOG_WARN("the page to dispose is not allocated. file=%s, pageNum=%d", file_name_.c_str(), page_num);
+    return RC::NOTFOUND;
+  }
+
+  // 页面不在缓存中时，只需要修改页面分配状态
+  Frame *used_frame = frame_manager_.get(file_desc_, page_num);
   if (used_frame != nullptr) {
-    ASSERT("the page try to dispose is in use. frame:%s", to_string(*used_frame).c_str());
+    if (used_frame->pin_count() > 1) {
+      used_frame->unpin();
+      LOG_INFO("the page to dispose is in use. frame=%s", to_string(*used_frame).c_str());
+      return RC::LOCKED_UNLOCK;
+    }
+
+    // 把页面最后的样子写回磁盘，避免磁盘上留下旧的内容
+    if (used_frame->dirty()) {
+      RC rc = flush_page_internal(*used_frame);
+      if (rc != RC::SUCCESS) {
+        used_frame->unpin();
+        LOG_WARN("failed to flush page while disposing it. pageNum=%d, rc=%s", page_num, strrc(rc));
+        return rc;
+      }
+    }
     frame_manager_.free(file_desc_, page_num, used_frame);
-  } else {
-    LOG_WARN("failed to fetch the page while disposing it. pageNum=%d", page_num);
-    return RC::NOTFOUND;
   }
 
   hdr_frame_->mark_dirty();
@@ -488,7 +532,17 @@ RC DiskBufferPool::flush_page_internal(Frame &frame)
   // The better way is use mmap the block into memory,
   // so it is easier to flush data to file.
 
-  Page   &page   = frame.page();
+  Page &page = frame.page();
+  if (log_flusher) {
+    // WAL: 修改页面的日志要先于页面落盘
+    RC rc = log_flusher(page.lsn);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to flush log before flushing page. page num=%d, lsn=%ld, rc=%s",
+                page.page_num, static_cast<long>(page.lsn), strrc(rc));
+      return rc;
+    }
+  }
+
   int64_t offset = ((int64_t)page.page_num) * sizeof(Page);
   if (lseek(file_desc_, offset, SEEK_SET) == offset - 1) {
     LOG_ERROR("Failed to flush page %lld of %d due to failed to seek %s.", offset, file_desc_, strerror(errno));
@@ -507,17 +561,71 @@ RC DiskBufferPool::flush_page_internal(Frame &frame)
 
 RC DiskBufferPool::flush_all_pages()
 {
+  // find_list 会把返回的页帧都pin住，刷完之后要unpin
+  RC                 rc   = RC::SUCCESS;
   std::list<Frame *> used = frame_manager_.find_list(file_desc_);
   for (Frame *frame : used) {
-    RC rc = flush_page(*frame);
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to flush all pages");
-      return rc;
+    if (OB_SUCC(rc)) {
+      rc = flush_page(*frame);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to flush all pages");
+      }
     }
+    frame->unpin();
   }
-  return RC::SUCCESS;
+  return rc;
 }
 
+RC DiskBufferPool::flush_pages_before(LSN lsn, LSN &min_rec_lsn)
+{
+  RC                 rc   = RC::SUCCESS;
+  std::list<Frame *> used = frame_manager_.find_list(file_desc_);
+  for (Frame *frame : used) {
+    if (OB_SUCC(rc)) {
+      frame->read_latch();
+      if (frame->dirty()) {
+        if (frame->rec_lsn() <= lsn) {
+          rc = flush_page(*frame);
+          if (OB_FAIL(rc)) {
+            LOG_WARN("failed to flush page. file=%s, page num=%d, rc=%s", file_name_.c_str(), frame->page_num(), strrc(rc));
+          }
+        } else {
+          min_rec_lsn = std::min(min_rec_lsn, frame->rec_lsn());
+        }
+      }
+      frame->read_unlatch();
+    }
+    frame->unpin();
+  }
+  return rc;
+}
+
+RC DiskBufferPool::get_page_lsn(PageNum page_num, LSN &lsn)
+{
+  {
+    // 从较早的备份恢复时，页面可能还不在文件中，相当于一个没有应用过任何日志的空页面
+    std::scoped_lock lock_guard(lock_);
+    if (page_num >= file_header_->page_count) {
+      lsn = 0;
+      return RC::SUCCESS;
+    }
+  }
+
+  Frame *frame = nullptr;
+  RC     rc    = get_this_page(page_num, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get page. file=%s, page num=%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+    return rc;
+  }
+
+  frame->read_latch();
+  lsn = frame->lsn();
+  frame->read_unlatch();
+  return unpin_page(frame);
+}
+
+void DiskBufferPool::set_log_flusher(std::function<RC(LSN)> flusher) { log_flusher = std::move(flusher); }
+
 RC DiskBufferPool::recover_page(PageNum page_num)
 {
   int byte = 0, bit = 0;
@@ -525,15 +633,111 @@ RC DiskBufferPool::recover_page(PageNum page_num)
   bit  = page_num % 8;
 
   std::scoped_lock lock_guard(lock_);
+  if (page_num >= BPFileHeader::MAX_PAGE_NUM) {
+    LOG_WARN("page num is out of range. file=%s, pageNum=%d", file_name_.c_str(), page_num);
+    return RC::BUFFERPOOL_INVALID_PAGE_NUM;
+  }
+
+  // 分配页面时会立即写出空页面，但是文件头可能还没有落盘，这时只需要更新文件头。
+  // 从较早的备份恢复时文件中还没有这个页面，与 allocate_page 一样通过写出空页面来扩展文件。中间的页面都是空闲页
+  struct stat st;
+  if (fstat(file_desc_, &st) != 0) {
+    LOG_ERROR("Failed to stat file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+    return RC::IOERR_ACCESS;
+  }
+  const PageNum file_pages = static_cast<PageNum>(st.st_size / BP_PAGE_SIZE);
+
+  while (file_header_->page_count <= page_num) {
+    PageNum new_page = file_header_->page_count;
+    if (new_page < file_pages) {
+      file_header_->page_count++;
+      hdr_frame_->mark_dirty();
+      continue;
+    }
+
+    Frame *frame = nullptr;
+    RC     rc    = allocate_frame(new_page, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to allocate frame while recovering page. file=%s, pageNum=%d", file_name_.c_str(), new_page);
+      return rc;
+    }
+
+    frame->set_file_desc(file_desc_);
+    frame->access();
+    frame->clear_page();
+    frame->set_page_num(new_page);
+    rc = flush_page_internal(*frame);
+    frame->unpin();
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to extend file while recovering page. file=%s, pageNum=%d", file_name_.c_str(), new_page);
+      return rc;
+    }
+
+    file_header_->page_count++;
+    hdr_frame_->mark_dirty();
+    LOG_INFO("extend file while recovering. file=%s, pageNum=%d", file_name_.c_str(), new_page);
+  }
+
   if (!(file_header_->bitmap[byte] & (1 << bit))) {
     file_header_->bitmap[byte] |= (1 << bit);
     file_header_->allocated_pages++;
-    file_header_->page_count++;
     hdr_frame_->mark_dirty();
   }
   return RC::SUCCESS;
 }
 
+RC DiskBufferPool::backup(const char *dst_file, IoThrottle *throttle, int64_t &copied_bytes)
+{
+  int dst_fd = ::open(dst_file, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (dst_fd < 0) {
+    LOG_ERROR("Failed to create backup file. file=%s, error=%s", dst_file, strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  // 备份期间文件还在变大，每次都重新获取文件的大小，复制到文件结尾为止
+  RC      rc     = RC::SUCCESS;
+  int64_t offset = 0;
+  while (OB_SUCC(rc)) {
+    int64_t length = 0;
+    {
+      std::scoped_lock lock_guard(lock_);
+      struct stat      st;
+      if (fstat(file_desc_, &st) != 0) {
+        LOG_ERROR("Failed to stat file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+        rc = RC::IOERR_ACCESS;
+        break;
+      }
+
+      length = std::min(static_cast<int64_t>(st.st_size) - offset, BACKUP_CHUNK_SIZE);
+      if (length <= 0) {
+        break;
+      }
+      rc = copy_file_data(file_desc_, dst_fd, offset, length);
+    }
+
+    if (OB_SUCC(rc)) {
+      offset += length;
+      copied_bytes += length;
+      if (throttle != nullptr) {
+        throttle->acquire(length);
+      }
+    }
+  }
+
+  if (OB_SUCC(rc) && fsync(dst_fd) != 0) {
+    LOG_ERROR("Failed to sync backup file. file=%s, error=%s", dst_file, strerror(errno));
+    rc = RC::IOERR_SYNC;
+  }
+  close(dst_fd);
+
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to backup file. file=%s, backup file=%s, rc=%s", file_name_.c_str(), dst_file, strrc(rc));
+  } else {
+    LOG_INFO("Backup file done. file=%s, backup file=%s, size=%ld", file_name_.c_str(), dst_file, static_cast<long>(offset));
+  }
+  return rc;
+}
+
 RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
 {
   auto purger = [this](Frame *frame) {
@@ -32,10 +32,12 @@ See the Mulan PSL v2 for more details. */
 #include "common/rc.h"
 #include "common/types.h"
 #include "storage/buffer/frame.h"
+#include "storage/buffer/mapped_file.h"
 #include "storage/buffer/page.h"
 
 class BufferPoolManager;
 class DiskBufferPool;
+class IoThrottle;
 
 /**
  * @brief BufferPool 的实现
@@ -163,6 +165,11 @@ public:
   ~BufferPoolIterator();
 
   RC      init(DiskBufferPool &bp, PageNum start_page = 0);
+
+  /**
+   * @brief 遍历映射到内存的文件中的所有页面
+   */
+  RC      init(const MappedFile &file, PageNum start_page = 0);
   bool    has_next();
   PageNum next();
   RC      reset();
@@ -211,7 +218,7 @@ public:
 
   /**
    * @brief 释放某个页面，将此页面设置为未分配状态
-   *
+   * @details 调用者不能再持有这个页面。如果还有其它人在使用这个页面，返回 RC::LOCKED_UNLOCK
    * @param page_num 待释放的页面
    */
   RC dispose_page(PageNum page_num);
@@ -250,11 +257,43 @@ public:
    */
   RC flush_all_pages();
 
+  /**
+   * @brief checkpoint时刷新页面
+   * @details 在 lsn 之前就已经变脏的页面刷到磁盘，之后才变脏的页面不刷，返回它们中最小的 recovery LSN。
+   * 刷页面时拿着页面的读锁，不会写出修改了一半的页面
+   * @param lsn         开始checkpoint时的日志位置
+   * @param min_rec_lsn 没有刷盘的脏页中最小的 recovery LSN，没有这样的页面时不修改
+   */
+  RC flush_pages_before(LSN lsn, LSN &min_rec_lsn);
+
+  /**
+   * @brief 获取页面的LSN，即最后一条修改这个页面的日志的位置
+   * @details 修改页面的人在写完日志、释放页面写锁之前设置页面的LSN，参考 RecordPageHandler::set_lsn
+   */
+  RC get_page_lsn(PageNum page_num, LSN &lsn);
+
+  /**
+   * @brief 设置刷日志的函数
+   * @details 页面写入磁盘之前，先把LSN不大于页面LSN的日志都刷到磁盘(WAL)。由日志模块在初始化时设置
+   */
+  static void set_log_flusher(std::function<RC(LSN)> log_flusher);
+
   /**
    * 回放日志时处理page0中已被认定为不存在的page
+   * @details 从较早的备份恢复时，页面可能是备份之后才分配的，文件中还没有这个页面，需要先扩展文件
    */
   RC recover_page(PageNum page_num);
 
+  /**
+   * @brief 在线备份时把分页文件复制到 dst_file
+   * @details 复制的是磁盘上的文件，不会刷新缓存中的脏页。每次拿着锁复制一大块连续的页面，
+   * 页面只会在持有这把锁时写到磁盘，所以不会复制到写了一半的页面。复制到的页面可能是不同时刻的，
+   * 需要用备份期间的日志重做才能得到一致的数据，参考 DbBackup
+   * @param throttle     限速，可以为空
+   * @param copied_bytes 累加复制的字节数
+   */
+  RC backup(const char *dst_file, IoThrottle *throttle, int64_t &copied_bytes);
+
 protected:
   RC allocate_frame(PageNum page_num, Frame **buf);
 
@@ -279,6 +279,18 @@ unsigned long current_time()
   return tp.tv_sec * 1000 * 1000 * 1000UL + tp.tv_nsec;
 }
 
+static std::function<LSN()> lsn_source;
+
+void Frame::set_lsn_source(std::function<LSN()> source) { lsn_source = std::move(source); }
+
+void Frame::mark_dirty()
+{
+  if (!dirty_) {
+    rec_lsn_ = lsn_source ? lsn_source() : 0;
+  }
+  dirty_ = true;
+}
+
 void Frame::access()
 {
   acc_time_ = current_time();
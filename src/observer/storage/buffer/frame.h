@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <mutex>
 #include <pthread.h>
 #include <set>
@@ -93,10 +94,22 @@ public:
    * @brief 标记指定页面为“脏”页。如果修改了页面的内容，则应调用此函数，
    * 以便该页面被淘汰出缓冲区时系统将新的页面数据写入磁盘文件
    */
-  void mark_dirty() { dirty_ = true; }
+  void mark_dirty();
   void clear_dirty() { dirty_ = false; }
   bool dirty() const { return dirty_; }
 
+  /**
+   * @brief 页面从干净变脏时的日志位置(recovery LSN)
+   * @details 页面上还没有刷到磁盘的修改，都记录在这个位置之后的日志中。checkpoint据此计算重做的起点
+   */
+  LSN rec_lsn() const { return rec_lsn_; }
+
+  /**
+   * @brief 设置获取当前日志位置的函数
+   * @details 由日志模块在初始化时设置，没有设置时 recovery LSN 总是0
+   */
+  static void set_lsn_source(std::function<LSN()> lsn_source);
+
   char *data() { return page_.data; }
 
   bool can_purge() { return pin_count_.load() == 0; }
@@ -133,6 +146,7 @@ private:
   friend class BufferPool;
 
   bool             dirty_ = false;
+  LSN              rec_lsn_ = 0;
   std::atomic<int> pin_count_{0};
   unsigned long    acc_time_  = 0;
   int              file_desc_ = -1;
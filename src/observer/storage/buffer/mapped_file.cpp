@@ -0,0 +1,105 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "storage/buffer/mapped_file.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+MappedFile::~MappedFile() { close(); }
+
+RC MappedFile::open(const char *file_name)
+{
+  if (addr_ != nullptr) {
+    LOG_WARN("file has been mapped. file=%s", file_name_.c_str());
+    return RC::FILE_OPEN;
+  }
+
+  int fd = ::open(file_name, O_RDONLY);
+  if (fd < 0) {
+    LOG_ERROR("failed to open file for mapping. file=%s, errmsg=%s", file_name, strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    LOG_ERROR("failed to stat file for mapping. file=%s, errmsg=%s", file_name, strerror(errno));
+    ::close(fd);
+    return RC::IOERR_ACCESS;
+  }
+
+  if (st.st_size < BP_PAGE_SIZE) {
+    LOG_ERROR("file is too small to map. file=%s, size=%ld", file_name, static_cast<long>(st.st_size));
+    ::close(fd);
+    return RC::IOERR_READ;
+  }
+
+  void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  // 映射建立之后就不再需要文件描述符了
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    LOG_ERROR("failed to map file. file=%s, errmsg=%s", file_name, strerror(errno));
+    return RC::IOERR_READ;
+  }
+
+  if (madvise(addr, st.st_size, MADV_SEQUENTIAL) != 0) {
+    LOG_WARN("failed to advise sequential access. file=%s, errmsg=%s", file_name, strerror(errno));
+  }
+
+  file_name_ = file_name;
+  addr_      = static_cast<char *>(addr);
+  size_      = st.st_size;
+
+  // 文件末尾可能有还没有写完整的页面，只访问完整的页面
+  const int file_pages = static_cast<int>(size_ / BP_PAGE_SIZE);
+  page_count_          = std::min(file_header()->page_count, file_pages);
+
+  LOG_INFO("mapped file. file=%s, size=%ld, page count=%d", file_name, static_cast<long>(size_), page_count_);
+  return RC::SUCCESS;
+}
+
+void MappedFile::close()
+{
+  if (addr_ == nullptr) {
+    return;
+  }
+
+  if (munmap(addr_, size_) != 0) {
+    LOG_WARN("failed to unmap file. file=%s, errmsg=%s", file_name_.c_str(), strerror(errno));
+  }
+  addr_       = nullptr;
+  size_       = 0;
+  page_count_ = 0;
+}
+
+const BPFileHeader *MappedFile::file_header() const
+{
+  return reinterpret_cast<const BPFileHeader *>(page_data(BP_HEADER_PAGE));
+}
+
+const char *MappedFile::page_data(PageNum page_num) const
+{
+  if (addr_ == nullptr || page_num < 0 || static_cast<size_t>(page_num + 1) * BP_PAGE_SIZE > size_) {
+    return nullptr;
+  }
+  const Page *page = reinterpret_cast<const Page *>(addr_ + static_cast<size_t>(page_num) * BP_PAGE_SIZE);
+  return page->data;
+}
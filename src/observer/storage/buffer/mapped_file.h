@@ -0,0 +1,72 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include <string>
+
+#include "common/rc.h"
+#include "common/types.h"
+#include "storage/buffer/page.h"
+
+struct BPFileHeader;
+
+/**
+ * @brief 以只读的方式把buffer pool文件映射到内存
+ * @ingroup BufferPool
+ * @details 很少修改的表(比如归档数据)扫描时，从内核复制页面到Frame以及管理Frame的开销都是多余的。
+ * 映射之后直接访问文件在page cache中的页面，并且通过 madvise(MADV_SEQUENTIAL) 让内核按顺序预读。
+ * 页面格式与buffer pool文件相同，映射期间文件不能被buffer pool修改，否则会读到不一致的数据，
+ * 这由上层(只读表)来保证。页面个数在映射时就确定了，之后文件变长也不会访问到新的页面。
+ */
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile &)            = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /**
+   * @brief 映射指定的文件。文件必须是buffer pool创建的，并且页面都已经刷到磁盘上
+   */
+  RC open(const char *file_name);
+
+  void close();
+
+  const char *file_name() const { return file_name_.c_str(); }
+
+  /**
+   * @brief 文件头，其中有页面的分配位图
+   */
+  const BPFileHeader *file_header() const;
+
+  /**
+   * @brief 映射范围内的页面个数
+   */
+  int page_count() const { return page_count_; }
+
+  /**
+   * @brief 页面上的数据部分，与 Frame::data 对应
+   * @return 页面不在映射范围内时返回nullptr
+   */
+  const char *page_data(PageNum page_num) const;
+
+private:
+  std::string file_name_;
+  char       *addr_       = nullptr;  ///< 映射的起始地址
+  size_t      size_       = 0;        ///< 映射的长度
+  int         page_count_ = 0;
+};
@@ -29,10 +29,13 @@ static constexpr const int BP_PAGE_DATA_SIZE = (BP_PAGE_SIZE - sizeof(PageNum) -
 /**
  * @brief 表示一个页面，可能放在内存或磁盘上
  * @ingroup BufferPool
+ * @details lsn 放在最前面，这样页面结构没有对齐的空洞，大小正好是 BP_PAGE_SIZE
  */
 struct Page
 {
+  LSN     lsn;  ///< 最后一条修改这个页面的日志的LSN，恢复时跳过不大于它的日志
   PageNum page_num;
-  LSN     lsn;
   char    data[BP_PAGE_DATA_SIZE];
 };
+
+static_assert(sizeof(Page) == BP_PAGE_SIZE, "the size of page should be BP_PAGE_SIZE");
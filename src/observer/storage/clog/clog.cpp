@@ -12,22 +12,53 @@ See the Mulan PSL v2 for more details. */
 // Created by huhaosheng.hhs on 2022
 //
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <sys/stat.h>
+#include <thread>
 #include <vector>
 
 #include "common/global_context.h"
 #include "common/io/io.h"
+#include "common/lang/defer.h"
+#include "common/lang/varint.h"
 #include "common/log/log.h"
+#include "common/math/crc32c.h"
+#include "common/os/path.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/frame.h"
 #include "storage/clog/clog.h"
+#include "storage/clog/parallel_redoer.h"
+#include "storage/common/file_copy.h"
+#include "storage/db/db.h"
 #include "storage/trx/trx.h"
 
 using namespace std;
 using namespace common;
 
 /**
- * @brief 当前的日志使用固定的文件名，而且就这一个文件
+ * @brief 日志段文件的名字是这个前缀加上段文件的起始LSN
  */
-const char *CLOG_FILE_NAME = "clog";
+static const char *CLOG_FILE_PREFIX  = "clog_";
+static const char *CLOG_FILE_PATTERN = "^clog_[0-9][0-9]*$";
+
+/**
+ * @brief 控制文件的名字。控制文件中记录最近一次 checkpoint 日志的位置
+ */
+static const char *CLOG_CONTROL_FILE_NAME = "clog_control";
+
+/**
+ * @brief 控制文件的内容
+ */
+struct CLogControlData
+{
+  static const int32_t MAGIC = 0x434b5054;
+
+  int32_t magic_          = MAGIC;
+  int32_t reserved_       = 0;
+  int64_t checkpoint_lsn_ = -1;  ///< 最近一次 checkpoint 日志的LSN
+};
 
 const char *clog_type_name(CLogType type)
 {
@@ -83,9 +114,139 @@ string CLogRecordData::to_string() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * @brief 事务号是64位的 checkpoint 数据以这个值开头
+ * @details 之前的格式以 begin_lsn 开头，事务号是32位的。LSN不会是负数，可以用它识别出旧的格式。
+ * 旧格式的数据库不能直接打开，需要先用 xid_upgrade 离线升级
+ */
+static const int64_t CHECKPOINT_FORMAT_XID64 = -2;
+
+void CLogCheckpoint::serialize(vector<char> &buffer) const
+{
+  const int32_t count = static_cast<int32_t>(active_trxes_.size());
+  buffer.clear();
+  auto append = [&buffer](const void *data, size_t len) {
+    const char *ptr = static_cast<const char *>(data);
+    buffer.insert(buffer.end(), ptr, ptr + len);
+  };
+
+  append(&CHECKPOINT_FORMAT_XID64, sizeof(CHECKPOINT_FORMAT_XID64));
+  append(&begin_lsn_, sizeof(begin_lsn_));
+  append(&redo_lsn_, sizeof(redo_lsn_));
+  append(&max_trx_id_, sizeof(max_trx_id_));
+  append(&count, sizeof(count));
+  for (const pair<int64_t, int64_t> &trx : active_trxes_) {
+    append(&trx.first, sizeof(trx.first));
+    append(&trx.second, sizeof(trx.second));
+  }
+}
+
+RC CLogCheckpoint::deserialize(const char *data, int32_t len)
+{
+  int32_t offset = 0;
+  auto    fetch  = [data, len, &offset](void *value, int32_t size) {
+    if (offset + size > len) {
+      return false;
+    }
+    memcpy(value, data + offset, size);
+    offset += size;
+    return true;
+  };
+
+  int64_t format = 0;
+  if (!fetch(&format, sizeof(format))) {
+    LOG_WARN("invalid checkpoint data. len=%d", len);
+    return RC::INVALID_ARGUMENT;
+  }
+  if (format != CHECKPOINT_FORMAT_XID64) {
+    LOG_ERROR("checkpoint was written with 32 bits transaction ids, upgrade the database with xid_upgrade first");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  int32_t count = 0;
+  if (!fetch(&begin_lsn_, sizeof(begin_lsn_)) || !fetch(&redo_lsn_, sizeof(redo_lsn_)) ||
+      !fetch(&max_trx_id_, sizeof(max_trx_id_)) || !fetch(&count, sizeof(count)) || count < 0) {
+    LOG_WARN("invalid checkpoint data. len=%d", len);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  active_trxes_.clear();
+  for (int32_t i = 0; i < count; i++) {
+    pair<int64_t, int64_t> trx;
+    if (!fetch(&trx.first, sizeof(trx.first)) || !fetch(&trx.second, sizeof(trx.second))) {
+      LOG_WARN("invalid checkpoint data. len=%d, active trx count=%d", len, count);
+      return RC::INVALID_ARGUMENT;
+    }
+    active_trxes_.push_back(trx);
+  }
+  return RC::SUCCESS;
+}
+
+bool CLogCheckpoint::is_legacy(const char *data, int32_t len)
+{
+  int64_t format = 0;
+  if (len < static_cast<int32_t>(sizeof(format))) {
+    return false;
+  }
+  memcpy(&format, data, sizeof(format));
+  return format != CHECKPOINT_FORMAT_XID64;
+}
+
+RC CLogCheckpoint::deserialize_legacy(const char *data, int32_t len)
+{
+  int32_t offset = 0;
+  auto    fetch  = [data, len, &offset](void *value, int32_t size) {
+    if (offset + size > len) {
+      return false;
+    }
+    memcpy(value, data + offset, size);
+    offset += size;
+    return true;
+  };
+
+  // 旧格式：begin_lsn、redo_lsn、32位的最大事务号、事务个数，以及每个事务的32位事务号和第一条日志的LSN
+  int32_t max_trx_id = 0;
+  int32_t count      = 0;
+  if (!fetch(&begin_lsn_, sizeof(begin_lsn_)) || !fetch(&redo_lsn_, sizeof(redo_lsn_)) ||
+      !fetch(&max_trx_id, sizeof(max_trx_id)) || !fetch(&count, sizeof(count)) || count < 0) {
+    LOG_WARN("invalid legacy checkpoint data. len=%d", len);
+    return RC::INVALID_ARGUMENT;
+  }
+  max_trx_id_ = max_trx_id;
+
+  active_trxes_.clear();
+  for (int32_t i = 0; i < count; i++) {
+    int32_t trx_id = 0;
+    int64_t lsn    = 0;
+    if (!fetch(&trx_id, sizeof(trx_id)) || !fetch(&lsn, sizeof(lsn))) {
+      LOG_WARN("invalid legacy checkpoint data. len=%d, active trx count=%d", len, count);
+      return RC::INVALID_ARGUMENT;
+    }
+    active_trxes_.emplace_back(trx_id, lsn);
+  }
+  return RC::SUCCESS;
+}
+
+string CLogCheckpoint::to_string() const
+{
+  stringstream ss;
+  ss << "begin_lsn:" << begin_lsn_ << ", redo_lsn:" << redo_lsn_ << ", max_trx_id:" << max_trx_id_
+     << ", active_trxes:[";
+  for (size_t i = 0; i < active_trxes_.size(); i++) {
+    if (i != 0) {
+      ss << ", ";
+    }
+    ss << active_trxes_[i].first << "@" << active_trxes_[i].second;
+  }
+  ss << "]";
+  return ss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 int _align8(int size) { return size / 8 * 8 + ((size % 8 == 0) ? 0 : 8); }
 
-CLogRecord *CLogRecord::build_mtr_record(CLogType type, int32_t trx_id)
+CLogRecord *CLogRecord::build_mtr_record(CLogType type, int64_t trx_id)
 {
   CLogRecord       *log_record = new CLogRecord();
   CLogRecordHeader &header     = log_record->header_;
@@ -94,7 +255,7 @@ CLogRecord *CLogRecord::build_mtr_record(CLogType type, int32_t trx_id)
   return log_record;
 }
 
-CLogRecord *CLogRecord::build_commit_record(int32_t trx_id, int32_t commit_xid)
+CLogRecord *CLogRecord::build_commit_record(int64_t trx_id, int64_t commit_xid)
 {
   CLogRecord       *log_record = new CLogRecord();
   CLogRecordHeader &header     = log_record->header_;
@@ -107,7 +268,7 @@ CLogRecord *CLogRecord::build_commit_record(int32_t trx_id, int32_t commit_xid)
   return log_record;
 }
 
-CLogRecord *CLogRecord::build_data_record(CLogType type, int32_t trx_id, int32_t table_id, const RID &rid,
+CLogRecord *CLogRecord::build_data_record(CLogType type, int64_t trx_id, int32_t table_id, const RID &rid,
     int32_t data_len, int32_t data_offset, const char *data)
 {
   CLogRecord       *log_record = new CLogRecord();
@@ -135,34 +296,154 @@ CLogRecord *CLogRecord::build_data_record(CLogType type, int32_t trx_id, int32_t
   return log_record;
 }
 
-CLogRecord *CLogRecord::build(const CLogRecordHeader &header, char *data)
+const int32_t CLogRecord::CHECKSUM_SIZE   = sizeof(uint32_t);
+const int32_t CLogRecord::MAX_FIELDS_SIZE = 1 + 5 * MAX_VARINT_SIZE;
+
+/**
+ * @brief 按顺序解码body中的字段
+ */
+class CLogFieldDecoder
 {
-  CLogRecord *log_record = new CLogRecord();
-  log_record->header_    = header;
+public:
+  CLogFieldDecoder(const char *data, int32_t len) : data_(data), len_(len) {}
+
+  bool decode(int64_t &value)
+  {
+    uint64_t raw  = 0;
+    int      size = decode_varint(data_ + pos_, len_ - pos_, raw);
+    pos_ += size;
+    value = zigzag_decode(raw);
+    return size > 0;
+  }
 
-  if (header.logrec_len_ <= 0) {
-    return log_record;
+  bool decode(int32_t &value)
+  {
+    int64_t value64 = 0;
+    if (!decode(value64) || value64 < INT32_MIN || value64 > INT32_MAX) {
+      return false;
+    }
+    value = static_cast<int32_t>(value64);
+    return true;
   }
 
-  if (header.type_ == clog_type_to_integer(CLogType::MTR_COMMIT)) {
-    ASSERT(header.logrec_len_ == sizeof(CLogRecordCommitData), "invalid length of mtr commit. expect %d, got %d",
-           sizeof(CLogRecordCommitData), header.logrec_len_);
+  int32_t pos() const { return pos_; }
 
-    CLogRecordCommitData &commit_record = log_record->commit_record();
-    memcpy(reinterpret_cast<void *>(&commit_record), data, sizeof(CLogRecordCommitData));
+private:
+  const char *data_ = nullptr;
+  int32_t     len_  = 0;
+  int32_t     pos_  = 0;
+};
 
-    LOG_DEBUG("got a commit record %s", log_record->to_string().c_str());
-  } else {
-    /// 当前日志拥有数据，但是不是COMMIT，就认为是普通的修改数据的日志，简单粗暴
-    CLogRecordData &data_record = log_record->data_record();
-    memcpy(reinterpret_cast<void *>(&data_record), data, CLogRecordData::HEADER_SIZE);
-    if (header.logrec_len_ > CLogRecordData::HEADER_SIZE) {
-      int data_len      = header.logrec_len_ - CLogRecordData::HEADER_SIZE;
-      data_record.data_ = new char[data_len];
-      memcpy(data_record.data_, data + CLogRecordData::HEADER_SIZE, data_len);
-    }
+CLogRecord *CLogRecord::decode(int64_t lsn, const char *body, int32_t len)
+{
+  if (len < 1) {
+    return nullptr;
   }
-  return log_record;
+
+  const int32_t type = static_cast<uint8_t>(body[0]);
+  if (type <= clog_type_to_integer(CLogType::ERROR) || type > clog_type_to_integer(CLogType::CHECKPOINT)) {
+    LOG_WARN("invalid clog type. lsn=%ld, type=%d", static_cast<long>(lsn), type);
+    return nullptr;
+  }
+
+  unique_ptr<CLogRecord> log_record(new CLogRecord());
+  CLogRecordHeader      &header = log_record->header_;
+  header.lsn_                   = lsn;
+  header.type_                  = type;
+
+  CLogFieldDecoder decoder(body + 1, len - 1);
+  if (!decoder.decode(header.trx_id_)) {
+    return nullptr;
+  }
+
+  switch (log_record->log_type()) {
+    case CLogType::MTR_BEGIN:
+    case CLogType::MTR_ROLLBACK: {
+      // 没有其它数据
+    } break;
+
+    case CLogType::MTR_COMMIT: {
+      if (!decoder.decode(log_record->commit_record_.commit_xid_)) {
+        return nullptr;
+      }
+      header.logrec_len_ = sizeof(CLogRecordCommitData);
+    } break;
+
+    default: {
+      CLogRecordData &data_record = log_record->data_record_;
+      if (!decoder.decode(data_record.table_id_) || !decoder.decode(data_record.rid_.page_num) ||
+          !decoder.decode(data_record.rid_.slot_num) || !decoder.decode(data_record.data_offset_)) {
+        return nullptr;
+      }
+
+      // 字段后面剩下的都是数据
+      const int32_t data_pos = 1 + decoder.pos();
+      data_record.data_len_  = len - data_pos;
+      if (data_record.data_len_ > 0) {
+        data_record.data_ = new char[data_record.data_len_];
+        memcpy(data_record.data_, body + data_pos, data_record.data_len_);
+      }
+      header.logrec_len_ = CLogRecordData::HEADER_SIZE + data_record.data_len_;
+    } break;
+  }
+  return log_record.release();
+}
+
+int32_t CLogRecord::encode_fields(char *buf) const
+{
+  int32_t pos = 0;
+  buf[pos++]  = static_cast<char>(header_.type_);
+  pos += encode_varint(buf + pos, zigzag_encode(header_.trx_id_));
+
+  switch (log_type()) {
+    case CLogType::MTR_BEGIN:
+    case CLogType::MTR_ROLLBACK: {
+    } break;
+
+    case CLogType::MTR_COMMIT: {
+      pos += encode_varint(buf + pos, zigzag_encode(commit_record_.commit_xid_));
+    } break;
+
+    default: {
+      pos += encode_varint(buf + pos, zigzag_encode(data_record_.table_id_));
+      pos += encode_varint(buf + pos, zigzag_encode(data_record_.rid_.page_num));
+      pos += encode_varint(buf + pos, zigzag_encode(data_record_.rid_.slot_num));
+      pos += encode_varint(buf + pos, zigzag_encode(data_record_.data_offset_));
+    } break;
+  }
+  return pos;
+}
+
+const char *CLogRecord::payload() const
+{
+  switch (log_type()) {
+    case CLogType::MTR_BEGIN:
+    case CLogType::MTR_ROLLBACK:
+    case CLogType::MTR_COMMIT: return nullptr;
+    default: return data_record_.data_;
+  }
+}
+
+int32_t CLogRecord::payload_len() const { return payload() == nullptr ? 0 : data_record_.data_len_; }
+
+int64_t CLogRecord::serialized_size() const
+{
+  char          fields[MAX_FIELDS_SIZE];
+  const int32_t body_len = encode_fields(fields) + payload_len();
+  return CHECKSUM_SIZE + varint_size(body_len) + body_len;
+}
+
+CLogRecord *CLogRecord::build_checkpoint_record(const CLogCheckpoint &checkpoint)
+{
+  vector<char> buffer;
+  checkpoint.serialize(buffer);
+  return build_data_record(CLogType::CHECKPOINT,
+      -1 /*trx_id*/,
+      -1 /*table_id*/,
+      RID(-1, -1),
+      static_cast<int32_t>(buffer.size()),
+      0 /*data_offset*/,
+      buffer.data());
 }
 
 CLogRecord::~CLogRecord() {}
@@ -173,315 +454,1333 @@ string CLogRecord::to_string() const
     return header_.to_string();
   } else if (header_.type_ == clog_type_to_integer(CLogType::MTR_COMMIT)) {
     return header_.to_string() + ", " + commit_record().to_string();
+  } else if (header_.type_ == clog_type_to_integer(CLogType::CHECKPOINT)) {
+    CLogCheckpoint checkpoint;
+    if (OB_FAIL(checkpoint.deserialize(data_record().data_, data_record().data_len_))) {
+      return header_.to_string() + ", invalid checkpoint";
+    }
+    return header_.to_string() + ", " + checkpoint.to_string();
   } else {
     return header_.to_string() + ", " + data_record().to_string();
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-static const int CLOG_BUFFER_SIZE = 4 * 1024 * 1024;
+/// 日志缓存的大小，必须是2的幂，这样LSN对应的缓存位置可以直接用掩码计算
+static const int64_t CLOG_BUFFER_SIZE = 4 * 1024 * 1024;
+static const int64_t CLOG_BUFFER_MASK = CLOG_BUFFER_SIZE - 1;
 
 CLogBuffer::CLogBuffer() {}
 
-CLogBuffer::~CLogBuffer() {}
-
-RC CLogBuffer::append_log_record(CLogRecord *log_record)
+CLogBuffer::~CLogBuffer()
 {
-  if (nullptr == log_record) {
-    return RC::INVALID_ARGUMENT;
-  }
+  delete[] buffer_;
+  buffer_ = nullptr;
+}
 
-  /// total_size_ 的计算没有考虑日志头
-  if (total_size_ + log_record->logrec_len() >= CLOG_BUFFER_SIZE) {
-    return RC::LOGBUF_FULL;
+RC CLogBuffer::init(CLogFile *log_file, int64_t lsn)
+{
+  buffer_ = new (nothrow) char[CLOG_BUFFER_SIZE];
+  if (nullptr == buffer_) {
+    LOG_WARN("failed to allocate log buffer. size=%ld", static_cast<long>(CLOG_BUFFER_SIZE));
+    return RC::NOMEM;
   }
 
-  lock_guard<Mutex> lock_guard(lock_);
-  log_records_.emplace_back(log_record);
-  total_size_ += log_record->logrec_len();
-  LOG_DEBUG("append log. log_record={%s}", log_record->to_string().c_str());
+  log_file_ = log_file;
+  reserved_lsn_.store(lsn);
+  filled_lsn_.store(lsn);
+  written_lsn_.store(lsn);
+  flushed_lsn_.store(lsn);
+  LOG_INFO("init log buffer. lsn=%ld", static_cast<long>(lsn));
   return RC::SUCCESS;
 }
 
-RC CLogBuffer::flush_buffer(CLogFile &log_file)
+void CLogBuffer::reset(int64_t lsn)
 {
-  RC  rc    = RC::SUCCESS;
-  int count = 0;
-  while (!log_records_.empty()) {
-    lock_.lock();
-    if (log_records_.empty()) {
-      lock_.unlock();
-      return RC::SUCCESS;
-    }
-
-    // log buffer 需要支持并发，所以要考虑加锁
-    // 从队列中取出日志记录然后写入到文件中
-    unique_ptr<CLogRecord> log_record = std::move(log_records_.front());
-    log_records_.pop_front();
-
-    rc = write_log_record(log_file, log_record.get());
-    // 当前无法处理日志写不完整的情况，所以直接粗暴退出
-    ASSERT(rc == RC::SUCCESS, "failed to write log record. log_record=%s, rc=%s",
-           log_record->to_string().c_str(), strrc(rc));
-
-    lock_.unlock();
-    total_size_ -= log_record->logrec_len();
-    count++;
-  }
-
-  LOG_WARN("flush log buffer done. write log record number=%d", count);
-  return log_file.sync();
+  reserved_lsn_.store(lsn);
+  filled_lsn_.store(lsn);
+  written_lsn_.store(lsn);
+  flushed_lsn_.store(lsn);
+  LOG_INFO("reset log buffer. lsn=%ld", static_cast<long>(lsn));
 }
 
-RC CLogBuffer::write_log_record(CLogFile &log_file, CLogRecord *log_record)
+RC CLogBuffer::append_log_record(CLogRecord &log_record, int64_t *end_lsn /*=nullptr*/)
 {
-  // TODO 看起来每种类型的日志自己实现 serialize 接口更好一点
-  const CLogRecordHeader &header = log_record->header();
-
-  RC rc = log_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to write log record header. size=%d, rc=%s", sizeof(header), strrc(rc));
+  int64_t lsn = 0;
+  RC      rc  = reserve(log_record.serialized_size(), lsn);
+  if (OB_FAIL(rc)) {
     return rc;
   }
 
-  switch (log_record->log_type()) {
-    case CLogType::MTR_BEGIN:
-    case CLogType::MTR_ROLLBACK: {
-      // do nothing
-    } break;
-
-    case CLogType::MTR_COMMIT: {
-      rc = log_file.write(
-          reinterpret_cast<const char *>(&log_record->commit_record()), log_record->header().logrec_len_);
-    } break;
-
-    default: {
-      rc = log_file.write(reinterpret_cast<const char *>(&log_record->data_record()), CLogRecordData::HEADER_SIZE);
-      if (OB_FAIL(rc)) {
-        LOG_WARN("failed to write data record header. size=%d, rc=%s", CLogRecordData::HEADER_SIZE, strrc(rc));
-        return rc;
-      }
+  int64_t end = serialize_log_record(log_record, lsn);
+  publish(lsn, end);
 
-      rc = log_file.write(log_record->data_record().data_, log_record->data_record().data_len_);
-      if (OB_FAIL(rc)) {
-        LOG_WARN("failed to write log data. size=%d, rc=%s", log_record->data_record().data_len_, strrc(rc));
-        return rc;
-      }
-    } break;
+  if (end_lsn != nullptr) {
+    *end_lsn = end;
   }
-
-  return rc;
+  LOG_DEBUG("append log. log_record={%s}", log_record.to_string().c_str());
+  return RC::SUCCESS;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-
-RC CLogFile::init(const char *path)
+RC CLogBuffer::append_log_records(const vector<unique_ptr<CLogRecord>> &log_records)
 {
-  RC rc = RC::SUCCESS;
+  int64_t logs_size = 0;
+  for (const unique_ptr<CLogRecord> &log_record : log_records) {
+    if (nullptr == log_record) {
+      return RC::INVALID_ARGUMENT;
+    }
+    logs_size += log_record->serialized_size();
+  }
 
-  std::string clog_file_path = std::string(path) + common::FILE_PATH_SPLIT_STR + CLOG_FILE_NAME;
+  if (logs_size == 0) {
+    return RC::SUCCESS;
+  }
 
-  int fd = ::open(clog_file_path.c_str(), O_RDWR | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR);
-  if (fd < 0) {
-    rc = RC::IOERR_OPEN;
-    LOG_WARN("failed to open clog file. filename=%s, error=%s", clog_file_path.c_str(), strerror(errno));
+  int64_t lsn = 0;
+  RC      rc  = reserve(logs_size, lsn);
+  if (OB_FAIL(rc)) {
     return rc;
   }
 
-  filename_ = clog_file_path;
-  fd_       = fd;
-  LOG_INFO("open clog file success. file=%s, fd=%d", filename_.c_str(), fd_);
-  return rc;
+  int64_t start = lsn;
+  for (const unique_ptr<CLogRecord> &log_record : log_records) {
+    lsn = serialize_log_record(*log_record, lsn);
+    LOG_DEBUG("append log. log_record={%s}", log_record->to_string().c_str());
+  }
+  publish(start, lsn);
+  return RC::SUCCESS;
 }
 
-CLogFile::~CLogFile()
+RC CLogBuffer::reserve(int64_t size, int64_t &lsn)
 {
-  if (fd_ >= 0) {
-    LOG_INFO("close clog file. file=%s, fd=%d", filename_.c_str(), fd_);
-    ::close(fd_);
-    fd_ = -1;
+  if (size > CLOG_BUFFER_SIZE) {
+    LOG_WARN("log is larger than log buffer. size=%ld", static_cast<long>(size));
+    return RC::LOGBUF_FULL;
+  }
+
+  lsn = reserved_lsn_.fetch_add(size);
+
+  // 缓存中这段空间上的旧日志还没有写入文件，先把已经序列化好的日志写出去。
+  // 前面的日志总会序列化完成，所以最终总能等到足够的空间
+  const int64_t end = lsn + size;
+  while (end - written_lsn_.load() > CLOG_BUFFER_SIZE) {
+    lock_guard<mutex> flush_guard(flush_lock_);
+    const int64_t     filled = filled_lsn_.load();
+    if (filled == written_lsn_.load()) {
+      this_thread::yield();
+      continue;
+    }
+
+    RC rc = write_to(filled);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
   }
+  return RC::SUCCESS;
 }
 
-RC CLogFile::write(const char *data, int len)
+void CLogBuffer::publish(int64_t start_lsn, int64_t end_lsn)
 {
-  int ret = writen(fd_, data, len);
-  if (0 != ret) {
-    LOG_WARN("failed to write data to file. filename=%s, data len=%d, error=%s", filename_.c_str(), len, strerror(ret));
-    return RC::IOERR_WRITE;
+  // 日志序列化的顺序是不确定的，filled_lsn_ 必须按照LSN的顺序推进，保证它之前没有空洞
+  while (filled_lsn_.load(memory_order_acquire) != start_lsn) {
+    this_thread::yield();
   }
-  return RC::SUCCESS;
+  filled_lsn_.store(end_lsn, memory_order_release);
 }
 
-RC CLogFile::read(char *data, int len)
+int64_t CLogBuffer::serialize_log_record(CLogRecord &log_record, int64_t lsn)
 {
-  int ret = readn(fd_, data, len);
-  if (ret != 0) {
-    if (ret == -1) {
-      eof_ = true;
-      LOG_TRACE("file read touch eof. filename=%s", filename_.c_str());
-    } else {
-      LOG_WARN("failed to read data from file. file=%s, data len=%d, error=%s", filename_.c_str(), len, strerror(ret));
+  CLogRecordHeader &header = log_record.header();
+  header.lsn_              = lsn;
+
+  char          fields[CLogRecord::MAX_FIELDS_SIZE];
+  const int32_t fields_len  = log_record.encode_fields(fields);
+  const char   *payload     = log_record.payload();
+  const int32_t payload_len = log_record.payload_len();
+
+  char          body_len[MAX_VARINT_SIZE];
+  const int32_t body_len_size = encode_varint(body_len, fields_len + payload_len);
+
+  // 校验码覆盖长度和body，分段计算，不需要先把整条日志拼接起来
+  uint32_t checksum = crc32c(body_len, body_len_size);
+  checksum          = crc32c_extend(checksum, fields, fields_len);
+  checksum          = crc32c_extend(checksum, payload, payload_len);
+
+  int64_t pos = lsn;
+  auto    append = [this, &pos](const void *data, int len) {
+    if (len > 0) {
+      copy_to_buffer(pos, data, len);
+      pos += len;
     }
-    return RC::IOERR_READ;
+  };
+
+  append(&checksum, CLogRecord::CHECKSUM_SIZE);
+  append(body_len, body_len_size);
+  append(fields, fields_len);
+  append(payload, payload_len);
+  return pos;
+}
+
+void CLogBuffer::copy_to_buffer(int64_t lsn, const void *data, int len)
+{
+  const char   *src    = reinterpret_cast<const char *>(data);
+  const int64_t pos    = lsn & CLOG_BUFFER_MASK;
+  const int64_t first  = std::min(static_cast<int64_t>(len), CLOG_BUFFER_SIZE - pos);
+  memcpy(buffer_ + pos, src, first);
+  if (first < len) {
+    memcpy(buffer_, src + first, len - first);
   }
-  return RC::SUCCESS;
 }
 
-RC CLogFile::sync()
+RC CLogBuffer::write_to(int64_t lsn)
 {
-  int ret = fsync(fd_);
-  if (ret != 0) {
-    LOG_WARN("failed to sync file. file=%s, error=%s", filename_.c_str(), strerror(errno));
-    return RC::IOERR_SYNC;
+  int64_t written = written_lsn_.load();
+  while (written < lsn) {
+    // 缓存绕回时分成两段写，每段都是一次pwrite
+    const int64_t pos = written & CLOG_BUFFER_MASK;
+    const int64_t len = std::min(lsn - written, CLOG_BUFFER_SIZE - pos);
+
+    RC rc = log_file_->write(written, buffer_ + pos, static_cast<int>(len));
+    // 当前无法处理日志写不完整的情况，所以直接粗暴退出
+    ASSERT(rc == RC::SUCCESS, "failed to write log. lsn=%ld, size=%ld, rc=%s", 
+           static_cast<long>(written), static_cast<long>(len), strrc(rc));
+
+    written += len;
+    written_lsn_.store(written);
   }
   return RC::SUCCESS;
 }
 
-RC CLogFile::offset(int64_t &off) const
+RC CLogBuffer::flush_buffer()
 {
-  off_t pos = lseek(fd_, 0, SEEK_CUR);
-  if (pos == -1) {
-    LOG_WARN("failed to seek. error=%s", strerror(errno));
-    return RC::IOERR_SEEK;
+  lock_guard<mutex> flush_guard(flush_lock_);
+
+  // 只刷已经序列化完成的日志，之后新增的日志不需要等待这次刷盘
+  const int64_t lsn = filled_lsn_.load(memory_order_acquire);
+  if (lsn == flushed_lsn_.load()) {
+    return RC::SUCCESS;
   }
 
-  off = static_cast<int64_t>(pos);
-  return RC::SUCCESS;
+  RC rc = write_to(lsn);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = log_file_->sync();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sync log file. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  LOG_DEBUG("flush log buffer done. lsn range=[%ld, %ld)",
+      static_cast<long>(flushed_lsn_.load()), static_cast<long>(lsn));
+  flushed_lsn_.store(lsn);
+  return rc;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-RC CLogRecordIterator::init(CLogFile &log_file)
+
+const int32_t CLogSegmentHeader::MAGIC = 0x434c4f47;  // "CLOG"
+
+string CLogSegmentHeader::to_string() const
 {
-  log_file_ = &log_file;
-  return RC::SUCCESS;
+  stringstream ss;
+  ss << "magic:" << hex << magic_ << dec << ", header_size:" << header_size_ << ", segment_size:" << segment_size_
+     << ", start_lsn:" << start_lsn_;
+  return ss.str();
 }
 
-bool CLogRecordIterator::valid() const { return nullptr != log_record_; }
+////////////////////////////////////////////////////////////////////////////////
 
-RC CLogRecordIterator::next()
+const int64_t CLogFile::DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024;
+
+RC CLogFile::init(const char *path, int64_t segment_size /*=DEFAULT_SEGMENT_SIZE*/)
 {
-  delete log_record_;
-  log_record_ = nullptr;
+  if (segment_size <= 0) {
+    LOG_WARN("invalid clog segment size. size=%ld", static_cast<long>(segment_size));
+    return RC::INVALID_ARGUMENT;
+  }
 
-  CLogRecordHeader header;
-  RC               rc = log_file_->read(reinterpret_cast<char *>(&header), sizeof(header));
-  if (rc != RC::SUCCESS) {
-    if (log_file_->eof()) {
-      return RC::RECORD_EOF;
+  path_         = path;
+  segment_size_ = segment_size;
+  header_size_  = sizeof(CLogSegmentHeader);
+
+  vector<string> files;
+  int            ret = common::list_file(path, CLOG_FILE_PATTERN, files);
+  if (ret < 0) {
+    LOG_WARN("failed to list clog files. path=%s", path);
+    return RC::IOERR_READ;
+  }
+
+  RC rc = RC::SUCCESS;
+  for (const string &file : files) {
+    string            filename = path_ + common::FILE_PATH_SPLIT_STR + file;
+    CLogSegmentHeader header;
+    int               fd = -1;
+    rc                   = open_segment(filename, header, fd);
+    if (OB_FAIL(rc)) {
+      return rc;
     }
 
-    LOG_WARN("failed to read log header. rc=%s", strrc(rc));
-    return rc;
+    // 已经存在的段文件决定了段文件的大小
+    segment_size_ = header.segment_size_;
+    header_size_  = header.header_size_;
+    segments_[header.start_lsn_] = Segment{filename, fd};
   }
 
-  char   *data        = nullptr;
-  int32_t record_size = header.logrec_len_;
-  if (record_size > 0) {
-    data = new char[record_size];
-    rc   = log_file_->read(data, record_size);
+  if (segments_.empty()) {
+    rc = create_segment(0);
     if (OB_FAIL(rc)) {
-      if (log_file_->eof()) {
-        // TODO 遇到了没有写完整数据的log，应该truncate一部分数据, 但是现在不管
-      }
-      LOG_WARN("failed to read log data. data size=%d, rc=%s", record_size, strrc(rc));
-      delete[] data;
-      data = nullptr;
       return rc;
     }
+    end_lsn_ = 0;
+  } else {
+    // 只有最后一个段文件可能没有写满
+    auto        last = segments_.rbegin();
+    struct stat st;
+    if (fstat(last->second.fd, &st) != 0) {
+      LOG_WARN("failed to stat clog file. file=%s, error=%s", last->second.filename.c_str(), strerror(errno));
+      return RC::IOERR_ACCESS;
+    }
+    end_lsn_ = last->first + std::max(static_cast<int64_t>(st.st_size) - header_size_, static_cast<int64_t>(0));
   }
 
-  delete log_record_;
-  log_record_ = CLogRecord::build(header, data);
-  delete[] data;
+  read_lsn_ = segments_.begin()->first;
+  LOG_INFO("open clog files success. path=%s, segment number=%d, segment size=%ld, lsn range=[%ld, %ld)",
+      path, static_cast<int>(segments_.size()), static_cast<long>(segment_size_),
+      static_cast<long>(read_lsn_), static_cast<long>(end_lsn_));
   return rc;
 }
 
-const CLogRecord &CLogRecordIterator::log_record() { return *log_record_; }
-
-////////////////////////////////////////////////////////////////////////////////
+CLogFile::~CLogFile()
+{
+  for (auto &item : segments_) {
+    Segment &segment = item.second;
+    if (segment.fd >= 0) {
+      LOG_INFO("close clog file. file=%s, fd=%d", segment.filename.c_str(), segment.fd);
+      ::close(segment.fd);
+      segment.fd = -1;
+    }
+  }
+  segments_.clear();
+}
 
-RC CLogManager::init(const char *path)
+string CLogFile::segment_filename(int64_t start_lsn) const
 {
-  log_buffer_ = new CLogBuffer();
-  log_file_   = new CLogFile();
-  return log_file_->init(path);
+  char name[64];
+  snprintf(name, sizeof(name), "%s%020ld", CLOG_FILE_PREFIX, static_cast<long>(start_lsn));
+  return path_ + common::FILE_PATH_SPLIT_STR + name;
 }
 
-CLogManager::~CLogManager()
+RC CLogFile::open_segment(const string &filename, CLogSegmentHeader &header, int &fd)
 {
-  if (log_buffer_) {
-    delete log_buffer_;
-    log_buffer_ = nullptr;
+  fd = ::open(filename.c_str(), O_RDWR);
+  if (fd < 0) {
+    LOG_WARN("failed to open clog file. filename=%s, error=%s", filename.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
   }
 
-  if (log_file_ != nullptr) {
-    delete log_file_;
-    log_file_ = nullptr;
+  ssize_t ret = ::pread(fd, &header, sizeof(header), 0);
+  if (ret != static_cast<ssize_t>(sizeof(header)) || header.magic_ != CLogSegmentHeader::MAGIC ||
+      header.header_size_ < static_cast<int32_t>(sizeof(header)) || header.segment_size_ <= 0) {
+    LOG_WARN("invalid clog segment header. filename=%s, header={%s}", filename.c_str(), header.to_string().c_str());
+    ::close(fd);
+    fd = -1;
+    return RC::IOERR_READ;
   }
+
+  LOG_INFO("open clog file success. file=%s, fd=%d, header={%s}", filename.c_str(), fd, header.to_string().c_str());
+  return RC::SUCCESS;
 }
 
-RC CLogManager::append_log(CLogType type, int32_t trx_id, int32_t table_id, const RID &rid, int32_t data_len,
-    int32_t data_offset, const char *data)
+RC CLogFile::create_segment(int64_t start_lsn)
 {
-  CLogRecord *log_record = CLogRecord::build_data_record(type, trx_id, table_id, rid, data_len, data_offset, data);
-  if (nullptr == log_record) {
-    LOG_WARN("failed to create log record");
-    return RC::NOMEM;
+  string filename = segment_filename(start_lsn);
+  int    fd       = ::open(filename.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    LOG_WARN("failed to create clog file. filename=%s, error=%s", filename.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  CLogSegmentHeader header;
+  header.header_size_  = header_size_;
+  header.segment_size_ = segment_size_;
+  header.start_lsn_    = start_lsn;
+
+  int ret = writen(fd, &header, sizeof(header));
+  if (ret != 0 || fsync(fd) != 0) {
+    LOG_WARN("failed to write clog segment header. filename=%s, error=%s", filename.c_str(), strerror(errno));
+    ::close(fd);
+    ::unlink(filename.c_str());
+    return RC::IOERR_WRITE;
+  }
+
+  // 新建的文件要sync所在的目录，否则宕机之后文件可能不存在
+  int dir_fd = ::open(path_.c_str(), O_RDONLY);
+  if (dir_fd >= 0) {
+    (void)fsync(dir_fd);
+    ::close(dir_fd);
   }
-  return append_log(log_record);
+
+  lock_guard<mutex> guard(lock_);
+  segments_[start_lsn] = Segment{filename, fd};
+  LOG_INFO("create clog file. file=%s, fd=%d, start lsn=%ld", filename.c_str(), fd, static_cast<long>(start_lsn));
+  return RC::SUCCESS;
 }
 
-RC CLogManager::begin_trx(int32_t trx_id)
+CLogFile::Segment *CLogFile::find_segment(int64_t lsn)
 {
-  return append_log(CLogRecord::build_mtr_record(CLogType::MTR_BEGIN, trx_id));
+  lock_guard<mutex> guard(lock_);
+  auto              iter = segments_.upper_bound(lsn);
+  if (iter == segments_.begin()) {
+    return nullptr;
+  }
+  --iter;
+  if (lsn >= iter->first + segment_size_) {
+    return nullptr;
+  }
+  return &iter->second;
 }
 
-RC CLogManager::commit_trx(int32_t trx_id, int32_t commit_xid)
+RC CLogFile::write(int64_t lsn, const char *data, int len)
 {
-  RC rc = append_log(CLogRecord::build_commit_record(trx_id, commit_xid));
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to append trx commit log. trx id=%d, rc=%s", trx_id, strrc(rc));
+  while (len > 0) {
+    // 写满一个段文件之后切换到下一个段文件
+    const int64_t start_lsn = lsn - lsn % segment_size_;
+    Segment      *segment   = find_segment(lsn);
+    if (nullptr == segment) {
+      RC rc = create_segment(start_lsn);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      segment = find_segment(lsn);
+    }
+
+    const int write_len = static_cast<int>(std::min(static_cast<int64_t>(len), start_lsn + segment_size_ - lsn));
+    const off_t offset   = static_cast<off_t>(header_size_ + lsn - start_lsn);
+    ssize_t     ret      = ::pwrite(segment->fd, data, write_len, offset);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_WARN("failed to write data to file. filename=%s, lsn=%ld, data len=%d, error=%s",
+          segment->filename.c_str(), static_cast<long>(lsn), write_len, strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+
+    unsynced_.insert(start_lsn);
+    data += ret;
+    lsn += ret;
+    len -= static_cast<int>(ret);
+    end_lsn_ = std::max(end_lsn_, lsn);
+  }
+  return RC::SUCCESS;
+}
+
+RC CLogFile::read(char *data, int len)
+{
+  while (len > 0) {
+    if (read_lsn_ >= end_lsn_) {
+      eof_ = true;
+      LOG_TRACE("file read touch eof. lsn=%ld", static_cast<long>(read_lsn_));
+      return RC::IOERR_READ;
+    }
+
+    Segment *segment = find_segment(read_lsn_);
+    if (nullptr == segment) {
+      LOG_WARN("cannot find clog segment. lsn=%ld", static_cast<long>(read_lsn_));
+      return RC::IOERR_READ;
+    }
+
+    const int64_t start_lsn = read_lsn_ - read_lsn_ % segment_size_;
+    const int64_t limit     = std::min(start_lsn + segment_size_, end_lsn_);
+    const int     read_len  = static_cast<int>(std::min(static_cast<int64_t>(len), limit - read_lsn_));
+    const off_t   offset    = static_cast<off_t>(header_size_ + read_lsn_ - start_lsn);
+    ssize_t       ret       = ::pread(segment->fd, data, read_len, offset);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_WARN("failed to read data from file. file=%s, data len=%d, error=%s",
+          segment->filename.c_str(), read_len, strerror(errno));
+      return RC::IOERR_READ;
+    }
+    if (ret == 0) {
+      eof_ = true;
+      LOG_TRACE("file read touch eof. file=%s", segment->filename.c_str());
+      return RC::IOERR_READ;
+    }
+
+    data += ret;
+    read_lsn_ += ret;
+    len -= static_cast<int>(ret);
+  }
+  return RC::SUCCESS;
+}
+
+RC CLogFile::seek(int64_t lsn)
+{
+  if (lsn < start_lsn() || lsn > end_lsn_) {
+    LOG_WARN("invalid lsn to seek. lsn=%ld, lsn range=[%ld, %ld]",
+        static_cast<long>(lsn), static_cast<long>(start_lsn()), static_cast<long>(end_lsn_));
+    return RC::INVALID_ARGUMENT;
+  }
+
+  read_lsn_ = lsn;
+  eof_      = false;
+  return RC::SUCCESS;
+}
+
+RC CLogFile::sync()
+{
+  set<int64_t> unsynced;
+  unsynced.swap(unsynced_);
+  for (int64_t start_lsn : unsynced) {
+    Segment *segment = find_segment(start_lsn);
+    if (nullptr == segment) {
+      continue;
+    }
+
+    int ret = fsync(segment->fd);
+    if (ret != 0) {
+      LOG_WARN("failed to sync file. file=%s, error=%s", segment->filename.c_str(), strerror(errno));
+      return RC::IOERR_SYNC;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC CLogFile::offset(int64_t &off) const
+{
+  off = read_lsn_;
+  return RC::SUCCESS;
+}
+
+int64_t CLogFile::start_lsn() const
+{
+  lock_guard<mutex> guard(lock_);
+  return segments_.empty() ? end_lsn_ : segments_.begin()->first;
+}
+
+RC CLogFile::truncate(int64_t lsn)
+{
+  if (lsn < start_lsn() || lsn > end_lsn_) {
+    LOG_WARN("invalid lsn to truncate. lsn=%ld, lsn range=[%ld, %ld]",
+        static_cast<long>(lsn), static_cast<long>(start_lsn()), static_cast<long>(end_lsn_));
+    return RC::INVALID_ARGUMENT;
+  }
+
+  vector<Segment> removed;
+  {
+    lock_guard<mutex> guard(lock_);
+    // 第一个段文件总是保留
+    while (segments_.size() > 1 && segments_.rbegin()->first > lsn) {
+      auto iter = std::prev(segments_.end());
+      removed.push_back(iter->second);
+      unsynced_.erase(iter->first);
+      segments_.erase(iter);
+    }
+  }
+
+  for (Segment &segment : removed) {
+    ::close(segment.fd);
+    if (::unlink(segment.filename.c_str()) != 0) {
+      LOG_WARN("failed to remove clog file. file=%s, error=%s", segment.filename.c_str(), strerror(errno));
+      return RC::IOERR_ACCESS;
+    }
+    LOG_INFO("remove clog file while truncating. file=%s", segment.filename.c_str());
+  }
+
+  Segment *segment = find_segment(lsn);
+  if (nullptr != segment) {
+    const int64_t start = lsn - lsn % segment_size_;
+    if (::ftruncate(segment->fd, static_cast<off_t>(header_size_ + lsn - start)) != 0 || fsync(segment->fd) != 0) {
+      LOG_WARN("failed to truncate clog file. file=%s, lsn=%ld, error=%s",
+          segment->filename.c_str(), static_cast<long>(lsn), strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+  }
+
+  LOG_INFO("truncate clog. lsn=%ld, old end lsn=%ld", static_cast<long>(lsn), static_cast<long>(end_lsn_));
+  end_lsn_ = lsn;
+  if (read_lsn_ > lsn) {
+    read_lsn_ = lsn;
+  }
+  return RC::SUCCESS;
+}
+
+RC CLogFile::remove_segments_before(int64_t lsn)
+{
+  vector<Segment> removed;
+  {
+    lock_guard<mutex> guard(lock_);
+    while (segments_.size() > 1) {
+      auto iter = segments_.begin();
+      if (iter->first + segment_size_ > lsn) {
+        break;
+      }
+      removed.push_back(iter->second);
+      segments_.erase(iter);
+    }
+  }
+
+  RC rc = RC::SUCCESS;
+  for (Segment &segment : removed) {
+    ::close(segment.fd);
+    if (::unlink(segment.filename.c_str()) != 0) {
+      LOG_WARN("failed to remove clog file. file=%s, error=%s", segment.filename.c_str(), strerror(errno));
+      rc = RC::IOERR_ACCESS;
+    } else {
+      LOG_INFO("remove clog file. file=%s", segment.filename.c_str());
+    }
+  }
+  return rc;
+}
+
+void CLogFile::segments(vector<int64_t> &start_lsns) const
+{
+  lock_guard<mutex> guard(lock_);
+  start_lsns.clear();
+  for (const auto &item : segments_) {
+    start_lsns.push_back(item.first);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// 遍历日志时每次从文件中预读的数据量
+static const int32_t CLOG_READ_AHEAD_SIZE = 256 * 1024;
+
+RC CLogRecordIterator::init(CLogFile &log_file, int64_t lsn /*=-1*/)
+{
+  log_file_  = &log_file;
+  lsn_       = lsn < 0 ? log_file.start_lsn() : lsn;
+  torn_tail_ = false;
+  buffer_.clear();
+  buffer_lsn_ = lsn_;
+  return log_file.seek(lsn_);
+}
+
+bool CLogRecordIterator::valid() const { return nullptr != log_record_; }
+
+RC CLogRecordIterator::read(int64_t lsn, int32_t len, const char *&data)
+{
+  if (lsn >= buffer_lsn_ && lsn + len <= buffer_lsn_ + static_cast<int64_t>(buffer_.size())) {
+    data = buffer_.data() + (lsn - buffer_lsn_);
+    return RC::SUCCESS;
+  }
+
+  const int64_t end_lsn = log_file_->end_lsn();
+  if (lsn + len > end_lsn) {
+    return RC::RECORD_EOF;
+  }
+
+  const int32_t read_len = static_cast<int32_t>(std::max(static_cast<int64_t>(len),
+                                                         std::min(static_cast<int64_t>(CLOG_READ_AHEAD_SIZE), end_lsn - lsn)));
+  buffer_.resize(read_len);
+  buffer_lsn_ = lsn;
+
+  RC rc = log_file_->seek(lsn);
+  if (OB_SUCC(rc)) {
+    rc = log_file_->read(buffer_.data(), read_len);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to read log. lsn=%ld, len=%d, rc=%s", static_cast<long>(lsn), read_len, strrc(rc));
+    buffer_.clear();
+    return rc;
+  }
+
+  data = buffer_.data();
+  return RC::SUCCESS;
+}
+
+RC CLogRecordIterator::parse(int64_t lsn, const char *&body, int32_t &body_len, int64_t &next_lsn)
+{
+  const int64_t end_lsn = log_file_->end_lsn();
+  if (lsn >= end_lsn) {
+    return RC::RECORD_EOF;
+  }
+
+  // 先读出校验码和长度，最后一条日志可能比校验码加上最长的长度字段还要短
+  const int32_t prefix_len = static_cast<int32_t>(std::min(static_cast<int64_t>(CLogRecord::CHECKSUM_SIZE + MAX_VARINT_SIZE), end_lsn - lsn));
+  const char   *data       = nullptr;
+  RC            rc         = read(lsn, prefix_len, data);
+  if (OB_FAIL(rc)) {
+    return rc == RC::RECORD_EOF ? RC::LOG_CORRUPTED : rc;
+  }
+
+  uint64_t  len           = 0;
+  const int body_len_size = prefix_len > CLogRecord::CHECKSUM_SIZE
+                                ? decode_varint(data + CLogRecord::CHECKSUM_SIZE, prefix_len - CLogRecord::CHECKSUM_SIZE, len)
+                                : 0;
+  if (body_len_size == 0 || len == 0 || len > static_cast<uint64_t>(end_lsn - lsn)) {
+    return RC::LOG_CORRUPTED;
+  }
+
+  body_len                 = static_cast<int32_t>(len);
+  const int32_t record_len = CLogRecord::CHECKSUM_SIZE + body_len_size + body_len;
+  next_lsn                 = lsn + record_len;
+  rc                       = read(lsn, record_len, data);
+  if (OB_FAIL(rc)) {
+    return rc == RC::RECORD_EOF ? RC::LOG_CORRUPTED : rc;
+  }
+
+  uint32_t checksum = 0;
+  memcpy(&checksum, data, CLogRecord::CHECKSUM_SIZE);
+  if (checksum != crc32c(data + CLogRecord::CHECKSUM_SIZE, record_len - CLogRecord::CHECKSUM_SIZE)) {
+    return RC::LOG_CORRUPTED;
+  }
+
+  body = data + CLogRecord::CHECKSUM_SIZE + body_len_size;
+  return RC::SUCCESS;
+}
+
+bool CLogRecordIterator::is_torn_tail(int64_t lsn, int64_t next_lsn)
+{
+  // 长度字段完整，并且日志在结尾之前就结束了，后面只能是没有写入数据的0
+  const int64_t end_lsn = log_file_->end_lsn();
+  if (next_lsn > lsn && next_lsn < end_lsn) {
+    return zero_to_end(next_lsn);
+  }
+  if (zero_to_end(lsn)) {
+    return true;
+  }
+
+  // 没有写完整的日志比一条日志还短，只需要查找很少的位置。中间的日志损坏时，下一条日志一般就在不远的地方
+  for (int64_t pos = lsn + 1; pos < end_lsn; pos++) {
+    const char *body     = nullptr;
+    int32_t     body_len = 0;
+    int64_t     pos_next = 0;
+    if (OB_SUCC(parse(pos, body, body_len, pos_next))) {
+      LOG_WARN("found complete log after corrupted log. corrupted lsn=%ld, lsn=%ld",
+               static_cast<long>(lsn), static_cast<long>(pos));
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CLogRecordIterator::zero_to_end(int64_t lsn)
+{
+  const int64_t end_lsn = log_file_->end_lsn();
+  while (lsn < end_lsn) {
+    const int32_t len  = static_cast<int32_t>(std::min(static_cast<int64_t>(CLOG_READ_AHEAD_SIZE), end_lsn - lsn));
+    const char   *data = nullptr;
+    if (OB_FAIL(read(lsn, len, data))) {
+      return false;
+    }
+    for (int32_t i = 0; i < len; i++) {
+      if (data[i] != 0) {
+        return false;
+      }
+    }
+    lsn += len;
+  }
+  return true;
+}
+
+RC CLogRecordIterator::next()
+{
+  delete log_record_;
+  log_record_ = nullptr;
+
+  const char *body     = nullptr;
+  int32_t     body_len = 0;
+  int64_t     next_lsn = lsn_;
+  RC          rc       = parse(lsn_, body, body_len, next_lsn);
+  if (rc == RC::LOG_CORRUPTED) {
+    // 只有最后一次写日志没有写完整时，日志才到这里结束。中间的日志损坏了不能丢掉后面的日志，恢复时直接报错
+    if (!is_torn_tail(lsn_, next_lsn)) {
+      LOG_ERROR("clog is corrupted. lsn=%ld, end lsn=%ld", static_cast<long>(lsn_), static_cast<long>(log_file_->end_lsn()));
+      return rc;
+    }
+
+    LOG_WARN("found torn log at the tail. lsn=%ld, end lsn=%ld", static_cast<long>(lsn_), static_cast<long>(log_file_->end_lsn()));
+    torn_tail_ = true;
+    return RC::RECORD_EOF;
+  }
+  if (OB_FAIL(rc)) {
+    if (rc != RC::RECORD_EOF) {
+      LOG_WARN("failed to read log. lsn=%ld, rc=%s", static_cast<long>(lsn_), strrc(rc));
+    }
     return rc;
   }
 
-  rc = sync();  // 事务提交时需要把当前事务关联的日志，都写入到磁盘中，这样做是保证不丢数据
+  log_record_ = CLogRecord::decode(lsn_, body, body_len);
+  if (nullptr == log_record_) {
+    LOG_ERROR("failed to decode log record. lsn=%ld, len=%d", static_cast<long>(lsn_), body_len);
+    return RC::LOG_CORRUPTED;
+  }
+
+  lsn_ = next_lsn;
+  return RC::SUCCESS;
+}
+
+const CLogRecord &CLogRecordIterator::log_record() { return *log_record_; }
+
+CLogRecord *CLogRecordIterator::release_log_record()
+{
+  CLogRecord *log_record = log_record_;
+  log_record_            = nullptr;
+  return log_record;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RC CLogManager::init(const char *path, int64_t segment_size /*=CLogFile::DEFAULT_SEGMENT_SIZE*/)
+{
+  path_       = path;
+  log_buffer_ = new CLogBuffer();
+  log_file_   = new CLogFile();
+  RC rc       = log_file_->init(path, segment_size);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 新的日志从已有日志的结尾开始写
+  rc = log_buffer_->init(log_file_, log_file_->end_lsn());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 页面变脏时记录当前的日志位置，checkpoint时用来计算重做的起点
+  CLogBuffer *log_buffer = log_buffer_;
+  Frame::set_lsn_source([log_buffer]() { return log_buffer->current_lsn(); });
+  // 页面写入磁盘之前先把它的日志刷到磁盘
+  DiskBufferPool::set_log_flusher([this](LSN lsn) { return flush_to(lsn); });
   return rc;
 }
 
-RC CLogManager::rollback_trx(int32_t trx_id)
+CLogManager::~CLogManager()
 {
-  return append_log(CLogRecord::build_mtr_record(CLogType::MTR_ROLLBACK, trx_id));
+  if (archiver_) {
+    archiver_->stop();
+  }
+
+  {
+    lock_guard<mutex> guard(async_flush_lock_);
+    async_flush_stopped_ = true;
+  }
+  async_flush_cond_.notify_all();
+  if (async_flush_thread_.joinable()) {
+    async_flush_thread_.join();
+    // 异步提交的事务正常关闭时不能丢失
+    RC rc = sync();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to flush log while closing. rc=%s", strrc(rc));
+    }
+  }
+
+  // 归档线程会读取日志文件，要在日志文件关闭之前停止
+  archiver_.reset();
+
+  if (log_buffer_ != nullptr) {
+    Frame::set_lsn_source(nullptr);
+    DiskBufferPool::set_log_flusher(nullptr);
+  }
+
+  if (log_buffer_) {
+    delete log_buffer_;
+    log_buffer_ = nullptr;
+  }
+
+  if (log_file_ != nullptr) {
+    delete log_file_;
+    log_file_ = nullptr;
+  }
 }
 
-RC CLogManager::append_log(CLogRecord *log_record)
+RC CLogManager::append_log(CLogType type, int64_t trx_id, int32_t table_id, const RID &rid, int32_t data_len,
+    int32_t data_offset, const char *data, int64_t *lsn /*=nullptr*/)
+{
+  CLogRecord *log_record = CLogRecord::build_data_record(type, trx_id, table_id, rid, data_len, data_offset, data);
+  if (nullptr == log_record) {
+    LOG_WARN("failed to create log record");
+    return RC::NOMEM;
+  }
+  return append_log(log_record, lsn);
+}
+
+RC CLogManager::append_logs(vector<unique_ptr<CLogRecord>> &log_records)
+{
+  RC rc = log_buffer_->append_log_records(log_records);
+  if (rc == RC::LOGBUF_FULL) {
+    // 整组日志比缓存还大，只能分开写入
+    for (unique_ptr<CLogRecord> &log_record : log_records) {
+      rc = log_buffer_->append_log_record(*log_record);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append log. log_record={%s}, rc=%s", log_record->to_string().c_str(), strrc(rc));
+        return rc;
+      }
+    }
+  }
+  return rc;
+}
+
+RC CLogManager::begin_trx(int64_t trx_id)
+{
+  unique_ptr<CLogRecord> log_record(CLogRecord::build_mtr_record(CLogType::MTR_BEGIN, trx_id));
+
+  // 在锁内写日志并记录事务，这样 checkpoint 拿到的LSN和正在运行的事务是一致的
+  lock_guard<mutex> guard(trx_lock_);
+  RC rc = log_buffer_->append_log_record(*log_record);
+  if (OB_SUCC(rc)) {
+    active_trxes_.emplace(trx_id, log_record->header().lsn_);
+  }
+  return rc;
+}
+
+RC CLogManager::commit_trx(int64_t trx_id, int64_t commit_xid, int64_t *lsn /*=nullptr*/, bool durable /*=true*/,
+    const function<void(int64_t lsn)> &appended /*=nullptr*/)
+{
+  unique_ptr<CLogRecord> log_record(CLogRecord::build_commit_record(trx_id, commit_xid));
+  int64_t                end_lsn = 0;
+
+  RC rc = log_buffer_->append_log_record(*log_record, &end_lsn);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to append trx commit log. trx id=%ld, rc=%s", trx_id, strrc(rc));
+    return rc;
+  }
+
+  if (lsn != nullptr) {
+    *lsn = log_record->header().lsn_;
+  }
+  if (appended) {
+    appended(log_record->header().lsn_);
+  }
+
+  if (!durable) {
+    // 异步提交不等待日志落盘，后台线程会定期刷盘
+    lock_guard<mutex> guard(async_flush_lock_);
+    if (!async_flush_thread_.joinable() && !async_flush_stopped_) {
+      async_flush_thread_ = thread(&CLogManager::async_flush_loop, this);
+    }
+    return RC::SUCCESS;
+  }
+
+  // 事务提交时需要把当前事务关联的日志，都写入到磁盘中，这样做是保证不丢数据
+  return wait_for_flush(end_lsn);
+}
+
+void CLogManager::set_async_flush_interval(int milliseconds)
+{
+  async_flush_interval_ms_ = milliseconds;
+  async_flush_cond_.notify_all();
+  LOG_INFO("set async flush interval to %d ms", milliseconds);
+}
+
+int64_t CLogManager::current_lsn() const { return log_buffer_->current_lsn(); }
+
+int64_t CLogManager::durable_lsn() const { return log_buffer_->flushed_lsn(); }
+
+void CLogManager::async_flush_loop()
+{
+  LOG_INFO("async flush thread started");
+  unique_lock<mutex> guard(async_flush_lock_);
+  while (!async_flush_stopped_) {
+    // 被唤醒说明间隔修改了或者要退出了，重新等待
+    if (async_flush_cond_.wait_for(guard, chrono::milliseconds(async_flush_interval_ms_.load())) ==
+        cv_status::no_timeout) {
+      continue;
+    }
+
+    guard.unlock();
+    const int64_t lsn = log_buffer_->current_lsn();
+    if (log_buffer_->flushed_lsn() < lsn) {
+      // 与提交事务的刷盘一样走组提交，不会和其它leader同时刷日志
+      RC rc = wait_for_flush(lsn);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to flush log in background. lsn=%ld, rc=%s", static_cast<long>(lsn), strrc(rc));
+      }
+    }
+    guard.lock();
+  }
+  LOG_INFO("async flush thread stopped");
+}
+
+RC CLogManager::wait_for_flush(int64_t lsn)
+{
+  unique_lock<mutex> lock(group_commit_lock_);
+  while (log_buffer_->flushed_lsn() < lsn) {
+    if (flushing_) {
+      // 已经有leader在刷日志了，等它刷完再看看自己的日志有没有被带上
+      group_commit_cond_.wait(lock);
+      continue;
+    }
+
+    flushing_ = true;
+    lock.unlock();
+
+    // 等待一小段时间，让更多的事务把提交日志放进来，这样一次sync可以提交更多事务
+    const int window_us = group_commit_window_us_.load();
+    if (window_us > 0) {
+      this_thread::sleep_for(chrono::microseconds(window_us));
+    }
+
+    RC rc = log_buffer_->flush_buffer();
+
+    lock.lock();
+    flushing_ = false;
+    group_commit_cond_.notify_all();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to flush log buffer. lsn=%ld, rc=%s", static_cast<long>(lsn), strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+void CLogManager::end_trx(int64_t trx_id)
+{
+  lock_guard<mutex> guard(trx_lock_);
+  active_trxes_.erase(trx_id);
+}
+
+RC CLogManager::rollback_trx(int64_t trx_id, int64_t *lsn /*=nullptr*/)
+{
+  return append_log(CLogRecord::build_mtr_record(CLogType::MTR_ROLLBACK, trx_id), lsn);
+}
+
+RC CLogManager::append_log(CLogRecord *log_record, int64_t *lsn /*=nullptr*/)
 {
   if (nullptr == log_record) {
     return RC::INVALID_ARGUMENT;
   }
-  return log_buffer_->append_log_record(log_record);
+
+  unique_ptr<CLogRecord> log_record_guard(log_record);
+  RC rc = log_buffer_->append_log_record(*log_record);
+  if (OB_SUCC(rc) && lsn != nullptr) {
+    *lsn = log_record->header().lsn_;
+  }
+  return rc;
+}
+
+RC CLogManager::sync() { return log_buffer_->flush_buffer(); }
+
+RC CLogManager::flush_to(int64_t lsn)
+{
+  // 要求 flushed_lsn 超过 lsn，这条日志就完整地落盘了。新的页面LSN可能还没有对应的日志，不能超过当前的位置
+  const int64_t target_lsn = std::min(lsn + 1, log_buffer_->current_lsn());
+  if (log_buffer_->flushed_lsn() >= target_lsn) {
+    return RC::SUCCESS;
+  }
+  return wait_for_flush(target_lsn);
+}
+
+RC CLogManager::checkpoint(Db *db, int64_t *checkpoint_lsn_ptr /*= nullptr*/, int64_t *redo_lsn_ptr /*= nullptr*/)
+{
+  lock_guard<mutex> checkpoint_guard(checkpoint_lock_);
+
+  // 先记下开始的位置和正在运行的事务。不在其中的事务如果已经提交，修改过的记录都已经交给了事务管理器，
+  // 参考 end_trx，下面改写事务号时不会漏掉它们
+  CLogCheckpoint checkpoint;
+  {
+    lock_guard<mutex> guard(trx_lock_);
+    checkpoint.begin_lsn_ = log_buffer_->current_lsn();
+    checkpoint.active_trxes_.assign(active_trxes_.begin(), active_trxes_.end());
+  }
+
+  // 提交时不改写记录上的事务号，页面可能带着未提交标记写到磁盘，恢复时只能通过重做提交日志知道它们已经提交。
+  // 先把已经提交的事务的事务号改写掉，改写时变脏的页面在下面和其它脏页一起刷盘
+  TrxKit::instance()->rewrite_committed_xids();
+  const int64_t flush_lsn = log_buffer_->current_lsn();
+
+  // 页面写到磁盘之前，修改它的日志要先落盘
+  RC rc = sync();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sync log before checkpoint. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  int64_t min_rec_lsn = flush_lsn;
+  rc = db->flush_pages_before(flush_lsn, min_rec_lsn);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to flush dirty pages while doing checkpoint. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 正在运行的事务需要从它们的第一条日志开始重做，这样恢复时才能重建这些事务。
+  // begin_lsn_ 之后提交的事务，提交日志都要重做
+  checkpoint.redo_lsn_ = std::min(min_rec_lsn, checkpoint.begin_lsn_);
+  for (const pair<int64_t, int64_t> &trx : checkpoint.active_trxes_) {
+    checkpoint.redo_lsn_ = std::min(checkpoint.redo_lsn_, trx.second);
+  }
+  checkpoint.max_trx_id_ = TrxKit::instance()->current_trx_id();
+
+  unique_ptr<CLogRecord> log_record(CLogRecord::build_checkpoint_record(checkpoint));
+  int64_t                end_lsn = 0;
+  rc = log_buffer_->append_log_record(*log_record, &end_lsn);
+  if (OB_SUCC(rc)) {
+    rc = wait_for_flush(end_lsn);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write checkpoint log. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  const int64_t checkpoint_lsn = log_record->header().lsn_;
+  rc = write_control_file(path_, checkpoint_lsn);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  if (checkpoint_lsn_ptr != nullptr) {
+    *checkpoint_lsn_ptr = checkpoint_lsn;
+  }
+  if (redo_lsn_ptr != nullptr) {
+    *redo_lsn_ptr = checkpoint.redo_lsn_;
+  }
+
+  LOG_INFO("checkpoint done. checkpoint lsn=%ld, %s", static_cast<long>(checkpoint_lsn), checkpoint.to_string().c_str());
+
+  // 控制文件更新之后，恢复时不会再读取 redo_lsn_ 之前的日志了。开启归档时还要保留没有归档的段文件，
+  // 正在备份时还要保留备份需要的段文件
+  int64_t remove_lsn = std::min(checkpoint.redo_lsn_, retain_lsn_.load());
+  if (archiver_) {
+    remove_lsn = std::min(remove_lsn, archiver_->archived_lsn());
+  }
+  rc = log_file_->remove_segments_before(remove_lsn);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to remove log segments before checkpoint. remove lsn=%ld, rc=%s",
+             static_cast<long>(remove_lsn), strrc(rc));
+  }
+  return rc;
 }
 
-RC CLogManager::sync() { return log_buffer_->flush_buffer(*log_file_); }
+RC CLogManager::enable_archive(const char *archive_path)
+{
+  unique_ptr<CLogArchiver> archiver = make_unique<CLogArchiver>();
+
+  CLogBuffer *log_buffer = log_buffer_;
+  RC rc = archiver->init(archive_path, log_file_, [log_buffer]() { return log_buffer->flushed_lsn(); });
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init clog archiver. archive path=%s, rc=%s", archive_path, strrc(rc));
+    return rc;
+  }
+
+  archiver_ = std::move(archiver);
+  return rc;
+}
+
+RC CLogManager::read_control_file(const string &path, int64_t &checkpoint_lsn)
+{
+  string filename = path + "/" + CLOG_CONTROL_FILE_NAME;
+  int    fd       = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    if (errno == ENOENT) {
+      return RC::FILE_NOT_EXIST;
+    }
+    LOG_ERROR("failed to open clog control file. file=%s, error=%s", filename.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  CLogControlData control_data;
+  int             ret = readn(fd, &control_data, sizeof(control_data));
+  close(fd);
+  if (ret != 0 || control_data.magic_ != CLogControlData::MAGIC) {
+    LOG_ERROR("invalid clog control file. file=%s, ret=%d, magic=%x", filename.c_str(), ret, control_data.magic_);
+    return RC::IOERR_READ;
+  }
+
+  checkpoint_lsn = control_data.checkpoint_lsn_;
+  return RC::SUCCESS;
+}
+
+RC CLogManager::write_control_file(const string &path, int64_t checkpoint_lsn)
+{
+  string filename     = path + "/" + CLOG_CONTROL_FILE_NAME;
+  string tmp_filename = filename + ".tmp";
+
+  int fd = ::open(tmp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    LOG_ERROR("failed to create clog control file. file=%s, error=%s", tmp_filename.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  CLogControlData control_data;
+  control_data.checkpoint_lsn_ = checkpoint_lsn;
+
+  int ret = writen(fd, &control_data, sizeof(control_data));
+  if (ret != 0 || fsync(fd) != 0) {
+    LOG_ERROR("failed to write clog control file. file=%s, error=%s", tmp_filename.c_str(), strerror(errno));
+    close(fd);
+    return RC::IOERR_WRITE;
+  }
+  close(fd);
+
+  if (rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+    LOG_ERROR("failed to rename clog control file. %s -> %s, error=%s",
+              tmp_filename.c_str(), filename.c_str(), strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+
+  int dir_fd = ::open(path.c_str(), O_RDONLY);
+  if (dir_fd >= 0) {
+    (void)fsync(dir_fd);
+    close(dir_fd);
+  }
+  return RC::SUCCESS;
+}
+
+RC CLogManager::backup_log(const char *dest_path, int64_t begin_lsn, int64_t checkpoint_lsn, IoThrottle *throttle,
+                           int64_t &end_lsn, int64_t &copied_bytes)
+{
+  // 备份的数据页面可能是复制时最新的，它们的日志都已经落盘(WAL)，复制到落盘的位置就能覆盖所有页面的修改
+  RC rc = sync();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sync log before backup. rc=%s", strrc(rc));
+    return rc;
+  }
+  end_lsn = durable_lsn();
+
+  const int64_t segment_size = log_file_->segment_size();
+  vector<int64_t> start_lsns;
+  log_file_->segments(start_lsns);
+  for (int64_t start_lsn : start_lsns) {
+    if (start_lsn + segment_size <= begin_lsn) {
+      continue;
+    }
+    if (start_lsn >= end_lsn) {
+      break;
+    }
+
+    const string src_file = log_file_->segment_filename(start_lsn);
+    const string dst_file = string(dest_path) + "/" + src_file.substr(src_file.find_last_of('/') + 1);
+    const int64_t length  = log_file_->header_size() + std::min(end_lsn, start_lsn + segment_size) - start_lsn;
+
+    int src_fd = ::open(src_file.c_str(), O_RDONLY);
+    if (src_fd < 0) {
+      LOG_WARN("failed to open clog file. file=%s, error=%s", src_file.c_str(), strerror(errno));
+      return RC::IOERR_OPEN;
+    }
+    int dst_fd = ::open(dst_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (dst_fd < 0) {
+      LOG_WARN("failed to create clog file. file=%s, error=%s", dst_file.c_str(), strerror(errno));
+      ::close(src_fd);
+      return RC::IOERR_OPEN;
+    }
+
+    rc = copy_file_data(src_fd, dst_fd, 0, length);
+    if (OB_SUCC(rc) && fsync(dst_fd) != 0) {
+      LOG_WARN("failed to sync clog file. file=%s, error=%s", dst_file.c_str(), strerror(errno));
+      rc = RC::IOERR_SYNC;
+    }
+    ::close(src_fd);
+    ::close(dst_fd);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to backup clog file. file=%s, rc=%s", src_file.c_str(), strrc(rc));
+      return rc;
+    }
+
+    copied_bytes += length;
+    if (throttle != nullptr) {
+      throttle->acquire(length);
+    }
+  }
+
+  rc = write_control_file(dest_path, checkpoint_lsn);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  LOG_INFO("backup clog done. dest=%s, begin lsn=%ld, checkpoint lsn=%ld, end lsn=%ld",
+           dest_path, static_cast<long>(begin_lsn), static_cast<long>(checkpoint_lsn), static_cast<long>(end_lsn));
+  return RC::SUCCESS;
+}
+
+RC CLogManager::read_checkpoint(int64_t checkpoint_lsn, CLogCheckpoint &checkpoint)
+{
+  CLogRecordIterator log_record_iterator;
+  RC                 rc = log_record_iterator.init(*log_file_, checkpoint_lsn);
+  if (OB_SUCC(rc)) {
+    rc = log_record_iterator.next();
+  }
+  if (OB_FAIL(rc) || !log_record_iterator.valid()) {
+    LOG_ERROR("failed to read checkpoint log. lsn=%ld, rc=%s", static_cast<long>(checkpoint_lsn), strrc(rc));
+    return OB_FAIL(rc) ? rc : RC::INTERNAL;
+  }
+
+  const CLogRecord &log_record = log_record_iterator.log_record();
+  if (log_record.log_type() != CLogType::CHECKPOINT) {
+    LOG_ERROR("not a checkpoint log. lsn=%ld, log_record={%s}",
+              static_cast<long>(checkpoint_lsn), log_record.to_string().c_str());
+    return RC::INTERNAL;
+  }
+
+  const CLogRecordData &data_record = log_record.data_record();
+  return checkpoint.deserialize(data_record.data_, data_record.data_len_);
+}
 
 RC CLogManager::recover(Db *db)
 {
+  TrxKit *trx_manager = GCTX.trx_kit_;
+  ASSERT(trx_manager != nullptr, "cannot do recover that trx_manager is null");
+
+  int64_t        checkpoint_lsn = -1;
+  CLogCheckpoint last_checkpoint;
+  last_checkpoint.begin_lsn_ = -1;
+
+  RC rc = read_control_file(path_, checkpoint_lsn);
+  if (OB_SUCC(rc)) {
+    rc = read_checkpoint(checkpoint_lsn, last_checkpoint);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    trx_manager->update_trx_id(last_checkpoint.max_trx_id_);
+    LOG_INFO("recover from checkpoint. lsn=%ld, %s", static_cast<long>(checkpoint_lsn), last_checkpoint.to_string().c_str());
+  } else if (rc == RC::FILE_NOT_EXIST) {
+    // 还没有做过 checkpoint，从头开始重做
+    last_checkpoint.redo_lsn_ = -1;
+  } else {
+    return rc;
+  }
+
+  set<int64_t> active_trx_ids;
+  for (const pair<int64_t, int64_t> &trx : last_checkpoint.active_trxes_) {
+    active_trx_ids.insert(trx.first);
+  }
+
   CLogRecordIterator log_record_iterator;
-  RC                 rc = log_record_iterator.init(*log_file_);
+  rc = log_record_iterator.init(*log_file_, last_checkpoint.redo_lsn_);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to init log record iterator. rc=%s", strrc(rc));
     return rc;
   }
 
-  TrxKit *trx_manager = GCTX.trx_kit_;
-  ASSERT(trx_manager != nullptr, "cannot do recover that trx_manager is null");
+  // 日志的结尾可能有没有写完整的日志，遍历完成之后才知道日志真正的结尾，到时候新的日志要从那里开始写。
+  // 恢复时变脏的页面都当作是从开始重做的位置变脏的，这样恢复结束时的 checkpoint 一定会把它们写到磁盘
+  const int64_t redo_start_lsn = log_record_iterator.lsn();
+  Frame::set_lsn_source([redo_start_lsn]() { return redo_start_lsn; });
+  CLogBuffer *log_buffer = log_buffer_;
+  DEFER([log_buffer]() { Frame::set_lsn_source([log_buffer]() { return log_buffer->current_lsn(); }); });
+
+  // 数据日志可以按照页面分发给多个线程并行重做
+  unique_ptr<ParallelRedoer> redoer;
+  if (redo_worker_num_ > 0) {
+    redoer = make_unique<ParallelRedoer>(db, redo_worker_num_);
+    rc     = redoer->start();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
 
   /// 遍历所有的日志，然后做redo
   // 在做redo时，需要记录处理的事务。在所有的日志都重做完成时，如果有事务没有结束，那这些事务就需要回滚
   for (rc = log_record_iterator.next(); OB_SUCC(rc) && log_record_iterator.valid(); rc = log_record_iterator.next()) {
     const CLogRecord &log_record = log_record_iterator.log_record();
     LOG_TRACE("begin to redo log={%s}", log_record.to_string().c_str());
+
+    // checkpoint 开始之前的日志只需要重做当时正在运行的事务，其它事务在这之前就已经结束了，
+    // 它们修改的页面以及改写过事务号的页面都已经写到了磁盘，直接跳过。
+    // 写完提交日志但是还没有把记录交给事务管理器的事务也算作正在运行，它们的提交日志会从 redo_lsn_ 开始重做
+    if (log_record.header().lsn_ < last_checkpoint.begin_lsn_ && active_trx_ids.count(log_record.trx_id()) == 0) {
+      LOG_TRACE("skip log of trx finished before checkpoint. log={%s}", log_record.to_string().c_str());
+      continue;
+    }
+
     switch (log_record.log_type()) {
+      case CLogType::CHECKPOINT: {
+        // checkpoint 日志只在开始恢复时使用
+      } break;
+
       case CLogType::MTR_BEGIN: {
         Trx *trx = trx_manager->create_trx(log_record.trx_id());
         if (trx == nullptr) {
@@ -494,24 +1793,45 @@ RC CLogManager::recover(Db *db)
       case CLogType::MTR_ROLLBACK: {
         Trx *trx = trx_manager->find_trx(log_record.trx_id());
         if (nullptr == trx) {
-          LOG_WARN("no such trx. trx id=%d, log_record={%s}", log_record.trx_id(), log_record.to_string().c_str());
+          LOG_WARN("no such trx. trx id=%ld, log_record={%s}", log_record.trx_id(), log_record.to_string().c_str());
           return RC::INTERNAL;
         }
+
+        // 提交和回滚会修改事务涉及的所有页面，要等之前的日志都重做完
+        if (redoer) {
+          rc = redoer->barrier();
+          if (OB_FAIL(rc)) {
+            return rc;
+          }
+        }
         rc = trx->redo(db, log_record);
         if (OB_FAIL(rc)) {
-          LOG_WARN("failed to redo log. trx id=%d, log_record={%s}, rc=%s", 
+          LOG_WARN("failed to redo log. trx id=%ld, log_record={%s}, rc=%s", 
                    log_record.trx_id(), log_record.to_string().c_str(), strrc(rc));
           return rc;
         }
 
+        // 提交事务号也是从事务号中分配的，恢复之后新的事务号不能与它重复
+        if (log_record.log_type() == CLogType::MTR_COMMIT) {
+          trx_manager->update_trx_id(log_record.commit_record().commit_xid_);
+        }
+        trx_manager->destroy_trx(trx);
       } break;
 
       default: {
         Trx *trx = GCTX.trx_kit_->find_trx(log_record.trx_id());
         ASSERT(trx != nullptr,
-              "cannot find such trx. trx id=%d, log_record={%s}",
+              "cannot find such trx. trx id=%ld, log_record={%s}",
               log_record.trx_id(), log_record.to_string().c_str());
 
+        if (redoer) {
+          rc = redoer->dispatch(trx, log_record_iterator.release_log_record());
+          if (OB_FAIL(rc)) {
+            return rc;
+          }
+          break;
+        }
+
         rc = trx->redo(db, log_record);
         if (rc != RC::SUCCESS) {
           LOG_WARN("failed to redo log record. log_record={%s}, rc=%s", log_record.to_string().c_str(), strrc(rc));
@@ -530,8 +1850,27 @@ RC CLogManager::recover(Db *db)
     return rc;
   }
 
+  if (redoer) {
+    rc = redoer->barrier();
+    redoer->stop();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
   LOG_TRACE("recover redo log done");
 
+  if (log_record_iterator.torn_tail()) {
+    // 丢掉没有写完整的日志，否则新的日志会写在它们后面，下次恢复时就读不到了
+    const int64_t valid_lsn = log_record_iterator.lsn();
+    rc = log_file_->truncate(valid_lsn);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("failed to truncate torn log tail. lsn=%ld, rc=%s", static_cast<long>(valid_lsn), strrc(rc));
+      return rc;
+    }
+    log_buffer_->reset(valid_lsn);
+  }
+
   vector<Trx *> uncommitted_trxes;
   trx_manager->all_trxes(uncommitted_trxes);
   LOG_INFO("find %d uncommitted trx", uncommitted_trxes.size());
@@ -540,5 +1879,14 @@ RC CLogManager::recover(Db *db)
     trx_manager->destroy_trx(trx);
   }
 
-  return RC::SUCCESS;
+  // 日志的结尾已经确定，可以开始归档了
+  if (archiver_) {
+    rc = archiver_->start();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  // 回滚没有记录日志，做一次 checkpoint 把恢复的结果写到磁盘，下次恢复时就不会再重做这些事务了
+  return checkpoint(db);
 }
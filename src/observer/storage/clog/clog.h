@@ -17,20 +17,27 @@ See the Mulan PSL v2 for more details. */
 #include <stddef.h>
 #include <stdint.h>
 #include <list>
+#include <map>
+#include <set>
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <unordered_map>
-#include <deque>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "storage/clog/clog_archiver.h"
 #include "storage/record/record.h"
 #include "storage/persist/persist.h"
-#include "common/lang/mutex.h"
 
 class CLogManager;
 class CLogBuffer;
 class CLogFile;
 class Db;
+class IoThrottle;
 
 /**
  * @defgroup CLog
@@ -56,7 +63,8 @@ class Db;
   DEFINE_CLOG_TYPE(MTR_ROLLBACK)      \
   DEFINE_CLOG_TYPE(INSERT)            \
   DEFINE_CLOG_TYPE(DELETE)            \
-  DEFINE_CLOG_TYPE(UPDATE)
+  DEFINE_CLOG_TYPE(UPDATE)            \
+  DEFINE_CLOG_TYPE(CHECKPOINT)
 
 enum class CLogType 
 { 
@@ -85,13 +93,15 @@ CLogType clog_type_from_integer(int32_t value);
 /**
  * @brief CLog的记录头。每个日志都带有这个信息
  * @ingroup CLog
+ * @details 这是日志在内存中的表示，写入文件时使用紧凑的编码，参考 CLogRecord。
+ * lsn_ 就是日志在日志流中的位置，不需要写入文件。
  */
 struct CLogRecordHeader 
 {
-  int32_t lsn_ = -1;     ///< log sequence number。当前没有使用
-  int32_t trx_id_ = -1;  ///< 日志所属事务的编号
+  int64_t lsn_ = -1;     ///< log sequence number。日志在日志流中的字节偏移，也就是日志在文件中的位置
+  int64_t trx_id_ = -1;  ///< 日志所属事务的编号
   int32_t type_ = clog_type_to_integer(CLogType::ERROR); ///< 日志类型
-  int32_t logrec_len_ = 0;  ///< record的长度，不包含header长度
+  int32_t logrec_len_ = 0;  ///< record的长度，不包含header长度。只在内存中使用，与日志文件中的长度无关
 
   bool operator==(const CLogRecordHeader &other) const
   {
@@ -108,7 +118,7 @@ struct CLogRecordHeader
  */
 struct CLogRecordCommitData
 {
-  int32_t commit_xid_ = -1; ///< 事务提交的事务号
+  int64_t commit_xid_ = -1; ///< 事务提交的事务号
 
   bool operator == (const CLogRecordCommitData &other) const
   {
@@ -122,6 +132,8 @@ struct CLogRecordCommitData
  * @brief 有具体数据修改的事务日志数据
  * @ingroup CLog
  * @details 这里记录的都是操作的记录，比如插入、删除一条数据。
+ * 插入日志的数据是完整的记录，删除日志没有数据。更新日志只记录发生变化的那一段，
+ * 数据是这一段的新数据后面跟着同样长度的旧数据，data_len_ 是两者长度之和，恢复时回滚未完成的事务要用到旧数据
  */
 struct CLogRecordData
 {
@@ -147,11 +159,52 @@ struct CLogRecordData
   const static int32_t HEADER_SIZE;  ///< 指RecordData的头长度，即不包含data_的长度
 };
 
+/**
+ * @brief checkpoint 日志的数据
+ * @ingroup CLog
+ * @details checkpoint 不会停止其它事务的运行。开始时记录下当前的LSN(begin_lsn_)和正在运行的事务，
+ * 再改写已经提交的事务留在记录上的事务号，然后把改写完成之前就变脏的页面都刷到磁盘，
+ * 其它的脏页中最小的 rec_lsn、begin_lsn_ 和正在运行的事务的第一条日志，决定了恢复时需要从哪里开始重做(redo_lsn_)。
+ * 这些数据作为 CHECKPOINT 日志的数据部分写入日志，日志的位置再写入控制文件中。
+ * 事务号改成64位之前写入的 checkpoint 数据要用 deserialize_legacy 读取，这样的数据库需要先离线升级，参考 DbXidUpgrade。
+ */
+struct CLogCheckpoint
+{
+  int64_t begin_lsn_  = 0;  ///< checkpoint 开始时的LSN，在这之前结束的事务修改的页面都已经写到磁盘
+  int64_t redo_lsn_   = 0;  ///< 恢复时从这个位置开始重做
+  int64_t max_trx_id_ = 0;  ///< checkpoint 时已经分配的最大的事务号
+
+  /// checkpoint 开始时正在运行的事务，以及事务第一条日志的LSN
+  std::vector<std::pair<int64_t, int64_t>> active_trxes_;
+
+  void serialize(std::vector<char> &buffer) const;
+  RC   deserialize(const char *data, int32_t len);
+
+  /**
+   * @brief checkpoint 数据是不是事务号改成64位之前的格式
+   */
+  static bool is_legacy(const char *data, int32_t len);
+
+  /**
+   * @brief 读取事务号改成64位之前的格式的 checkpoint 数据，只在离线升级时使用
+   */
+  RC deserialize_legacy(const char *data, int32_t len);
+
+  std::string to_string() const;
+};
+
 /**
  * @brief 表示一条日志记录
  * @ingroup CLog
  * @details 一条日志记录由一个日志头和具体的数据构成。
  * 具体的数据根据日志类型不同，也是不同的类型。
+ * 日志文件中的一条日志的格式是：
+ * | crc32c(4字节) | body长度(varint) | body |
+ * body 以一个字节的日志类型开始，后面是变长编码的字段：
+ * - 所有日志：事务编号；
+ * - MTR_COMMIT：提交事务号；
+ * - 数据日志：表ID、页面号、槽位号、数据偏移量，剩下的就是数据，数据长度不再单独记录。
+ * 有符号的字段使用zigzag编码。校验码覆盖body长度和body，可以发现没有写完整的日志和损坏的日志。
  */
 class CLogRecord 
 {
@@ -170,7 +223,7 @@ public:
    * @param type 日志类型
    * @param trx_id 事务编号
    */
-  static CLogRecord *build_mtr_record(CLogType type, int32_t trx_id);
+  static CLogRecord *build_mtr_record(CLogType type, int64_t trx_id);
 
   /**
    * @brief 创建一个表示提交事务的日志对象
@@ -178,7 +231,7 @@ public:
    * @param trx_id 事务编号
    * @param commit_xid 事务提交时使用的编号
    */
-  static CLogRecord *build_commit_record(int32_t trx_id, int32_t commit_xid);
+  static CLogRecord *build_commit_record(int64_t trx_id, int64_t commit_xid);
 
   /**
    * @brief 创建一个表示数据操作的日志对象
@@ -192,7 +245,7 @@ public:
    * @param data 具体的数据
    */
   static CLogRecord *build_data_record(CLogType type,
-                                       int32_t trx_id,
+                                       int64_t trx_id,
                                        int32_t table_id,
                                        const RID &rid,
                                        int32_t data_len,
@@ -200,15 +253,23 @@ public:
                                        const char *data);
   
   /**
-   * @brief 根据二进制数据创建日志对象
-   * @details 通常是从日志文件中读取数据，然后调用此函数创建日志对象
-   * @param header 日志头信息
-   * @param data   读取的剩余数据信息，长度是header.logrec_len_
+   * @brief 根据日志文件中的数据创建日志对象
+   * @details 通常是从日志文件中读取数据并检查过校验码之后，调用此函数创建日志对象
+   * @param lsn  日志的位置
+   * @param body 日志的body部分，不包含校验码和长度
+   * @param len  body的长度
+   * @return 数据不合法时返回nullptr
+   */
+  static CLogRecord *decode(int64_t lsn, const char *body, int32_t len);
+
+  /**
+   * @brief 创建一个 checkpoint 日志对象
+   * @details checkpoint 的数据序列化之后放在 CLogRecordData 的数据部分，不属于任何表和事务
    */
-  static CLogRecord *build(const CLogRecordHeader &header, char *data);
+  static CLogRecord *build_checkpoint_record(const CLogCheckpoint &checkpoint);
 
   CLogType log_type() const  { return clog_type_from_integer(header_.type_); }
-  int32_t  trx_id() const { return header_.trx_id_; }
+  int64_t  trx_id() const { return header_.trx_id_; }
   int32_t  logrec_len() const { return header_.logrec_len_; }
 
   CLogRecordHeader &header() { return header_; }
@@ -219,8 +280,28 @@ public:
   const CLogRecordCommitData &commit_record() const { return commit_record_; }
   const CLogRecordData   &data_record() const { return data_record_; }
 
+  /**
+   * @brief 把body中数据之前的字段编码到buf中，buf至少要有 MAX_FIELDS_SIZE 个字节
+   * @return 编码之后的长度
+   */
+  int32_t encode_fields(char *buf) const;
+
+  /**
+   * @brief body中跟在字段后面的数据，只有数据日志有
+   */
+  const char *payload() const;
+  int32_t     payload_len() const;
+
+  /**
+   * @brief 日志写入文件之后占用的空间，包括校验码和长度
+   */
+  int64_t serialized_size() const;
+
   std::string to_string() const;
 
+  static const int32_t CHECKSUM_SIZE;    ///< 校验码的长度
+  static const int32_t MAX_FIELDS_SIZE;  ///< body中数据之前的字段编码之后的最大长度
+
 protected:
   CLogRecordHeader header_; ///< 日志头信息
 
@@ -229,11 +310,15 @@ protected:
 };
 
 /**
- * @brief 缓存运行时产生的日志对象
+ * @brief 缓存运行时产生的日志
  * @ingroup CLog
- * @details 当前的实现非常简单，没有采用其它数据库中常用的将日志序列化到二进制buffer，
- * 管理二进制buffer的方法。这里仅仅把日志记录下来，放到链表中。如果达到一定量的日志，
- * 或者日志数量超过某个阈值，就会调用flush_buffer将日志刷新到磁盘中。
+ * @details 日志缓存是一块固定大小的环形内存，日志在其中的位置由LSN决定(LSN对缓存大小取模)。
+ * 写日志分成三步：
+ * 1. 预留：通过原子加法在日志流中预留一段空间，得到日志的LSN，不需要加锁；
+ * 2. 序列化：把日志直接序列化到预留的空间中，多个线程可以同时进行；
+ * 3. 发布：按照LSN的顺序推进 filled_lsn_，它之前的日志都已经序列化完成，可以写入文件。
+ * 刷盘时把 [written_lsn_, filled_lsn_) 这段连续的数据用一次pwrite写到文件的对应位置上。
+ * 缓存中的空间写入文件之后就可以重新使用，预留的空间超出缓存时，写日志的线程会先刷盘腾出空间。
  */
 class CLogBuffer 
 {
@@ -241,39 +326,117 @@ public:
   CLogBuffer();
   ~CLogBuffer();
 
+  /**
+   * @brief 初始化
+   * @param log_file 日志写入的文件
+   * @param lsn      下一条日志的LSN，也就是当前日志文件的长度
+   */
+  RC init(CLogFile *log_file, int64_t lsn);
+
+  /**
+   * @brief 重新设置下一条日志的位置
+   * @details 恢复时截断了日志文件尾部没有写完整的日志之后调用。调用时不能有其它线程在写日志
+   */
+  void reset(int64_t lsn);
+
   /**
    * @brief 增加一条日志
-   * @details 如果当前的日志达到一定量，就会刷新数据
+   * @details 日志被序列化到缓存中，调用者仍然拥有日志对象
+   * @param end_lsn 返回这条日志结束的位置。flushed_lsn() 不小于这个值时说明日志已经落盘
+   */
+  RC append_log_record(CLogRecord &log_record, int64_t *end_lsn = nullptr);
+
+  /**
+   * @brief 一次增加一组日志
+   * @details 整组日志一次预留空间，保证这组日志在文件中是连续的。
+   * 整组日志超过了缓存大小时返回 RC::LOGBUF_FULL，调用者可以分开写入
    */
-  RC append_log_record(CLogRecord *log_record);
+  RC append_log_records(const std::vector<std::unique_ptr<CLogRecord>> &log_records);
 
   /**
    * @brief 将当前的日志都刷新到日志文件中
-   * @details 因为多线程访问与日志管理的问题，只能有一个线程调用此函数
-   * @param log_file 日志文件
+   * @details 把已经序列化完成的日志一次写入文件并sync。
+   * 多个线程同时调用时会依次执行，保证日志按照LSN的顺序写入
+   */
+  RC flush_buffer();
+
+  /**
+   * @brief 下一条日志的LSN
+   */
+  int64_t current_lsn() const { return reserved_lsn_.load(); }
+
+  /**
+   * @brief 已经写入文件并且sync过的位置
    */
-  RC flush_buffer(CLogFile &log_file);
+  int64_t flushed_lsn() const { return flushed_lsn_.load(); }
 
 private:
   /**
-   * @brief 将日志记录写入到日志文件中
+   * @brief 在日志流中预留一段空间，缓存中没有足够的空闲空间时会先刷盘
+   * @return 预留空间的起始LSN
+   */
+  RC reserve(int64_t size, int64_t &lsn);
+
+  /**
+   * @brief 等前面的日志都序列化完成之后，把 filled_lsn_ 推进到当前日志的结尾
+   */
+  void publish(int64_t start_lsn, int64_t end_lsn);
+
+  /**
+   * @brief 将日志记录序列化到缓存中
    * 
-   * @param log_file 日志文件，概念上来讲不一定是某个特定的文件
-   * @param log_record 要写入的日志记录
+   * @param log_record 要写入的日志记录，LSN会设置成 lsn
+   * @param lsn        日志的位置
+   * @return 日志结束的位置
+   */
+  int64_t serialize_log_record(CLogRecord &log_record, int64_t lsn);
+
+  /**
+   * @brief 把数据复制到缓存中LSN对应的位置，可能会绕回到缓存的开头
+   */
+  void copy_to_buffer(int64_t lsn, const void *data, int len);
+
+  /**
+   * @brief 把 [written_lsn_, lsn) 之间的数据写入文件，不做sync。需要持有 flush_lock_
    */
-  RC write_log_record(CLogFile &log_file, CLogRecord *log_record);
+  RC write_to(int64_t lsn);
 
 private:
-  common::Mutex lock_;  ///< 加锁支持多线程并发写入
-  std::deque<std::unique_ptr<CLogRecord>> log_records_;  ///< 当前等待刷数据的日志记录
-  std::atomic_int32_t total_size_;  ///< 当前缓存中的日志记录的总大小
+  CLogFile  *log_file_ = nullptr;
+  char      *buffer_   = nullptr;  ///< 环形缓存
+  std::mutex flush_lock_;          ///< 同一时间只有一个线程在写文件
+
+  std::atomic_int64_t reserved_lsn_{0};  ///< 下一条日志预留空间的起始位置
+  std::atomic_int64_t filled_lsn_{0};    ///< 这之前的日志都已经序列化到缓存中
+  std::atomic_int64_t written_lsn_{0};   ///< 这之前的日志都已经写入文件，缓存中的空间可以重用
+  std::atomic_int64_t flushed_lsn_{0};   ///< 这之前的日志都已经sync到磁盘
+};
+
+/**
+ * @brief 日志段文件的文件头
+ * @ingroup CLog
+ * @details 每个段文件的开头都有这样一个头，后面紧跟着日志数据。
+ * 段文件中的日志数据在日志流中的位置是 [start_lsn_, start_lsn_ + segment_size_)。
+ */
+struct CLogSegmentHeader
+{
+  static const int32_t MAGIC;
+
+  int32_t magic_        = MAGIC;
+  int32_t header_size_  = 0;  ///< 文件头的长度，日志数据从这个位置开始
+  int64_t segment_size_ = 0;  ///< 每个段文件能存放的日志数据长度，不包含文件头
+  int64_t start_lsn_    = 0;  ///< 段文件中第一个字节的LSN
+
+  std::string to_string() const;
 };
 
 /**
  * @brief 读写日志文件
  * @ingroup CLog
- * @details 这里的名字不太贴切，因为这个类希望管理所有日志文件，而不是特定的某个文件。不过当前
- * 只有一个文件，并且文件名是固定的。
+ * @details 日志分成多个固定大小的段文件(segment)存放，文件名是 clog_<起始LSN>。
+ * LSN是日志在整个日志流中的字节偏移，与段文件无关，写到一个段文件的结尾时自动切换到下一个段文件，
+ * 一条日志可能跨越两个段文件。读取时按照LSN的顺序依次读取所有的段文件。
+ * checkpoint之后，它之前的段文件不再需要，可以通过 remove_segments_before 删除。
  */
 class CLogFile 
 {
@@ -283,35 +446,45 @@ public:
 
   /**
    * @brief 初始化
-   * 
-   * @param path 日志文件存放的路径。会打开这个目录下叫做 clog 的文件。
+   * @details 打开目录下所有的段文件，没有段文件时创建第一个。
+   * 段文件的大小记录在文件头中，已经存在的日志总是使用原来的大小，参数只在创建第一个段文件时生效
+   * @param path 日志文件存放的路径
+   * @param segment_size 每个段文件存放的日志数据长度
    */
-  RC init(const char *path);
+  RC init(const char *path, int64_t segment_size = DEFAULT_SEGMENT_SIZE);
 
   /**
-   * @brief 写入指定数据，全部写入成功返回成功，否则返回失败
-   * @details 作为日志文件读写的类，实现一个write_log_record可能更合适。
+   * @brief 在指定位置写入数据，全部写入成功返回成功，否则返回失败
+   * @details 数据跨越段文件时分别写入，需要的时候创建新的段文件。
+   * 同一时间只能有一个线程写入。
    * @note  如果日志文件写入一半失败了，应该做特殊处理，但是这里什么都没管。
+   * @param lsn  写入的位置
    * @param data 写入的数据
    * @param len  数据的长度
    */
-  RC write(const char *data, int len);
+  RC write(int64_t lsn, const char *data, int len);
 
   /**
-   * @brief 读取指定长度的数据。全部读取成功返回成功，否则返回失败
-   * @details 与 write 有类似的问题。如果读取到了文件尾，会标记eof，可以通过eof()函数来判断。
+   * @brief 从当前读取的位置开始读取指定长度的数据。全部读取成功返回成功，否则返回失败
+   * @details 如果读取到了日志的结尾，会标记eof，可以通过eof()函数来判断。
    * @param data 数据读出来放这里
    * @param len  读取的长度
    */
   RC read(char *data, int len);
 
   /**
-   * @brief 将当前写的文件执行sync同步数据到磁盘
+   * @brief 设置读取的位置
+   * @param lsn 不能小于第一个段文件的起始LSN
+   */
+  RC seek(int64_t lsn);
+
+  /**
+   * @brief 将上次sync之后写过的段文件都同步到磁盘
    */
   RC sync();
 
   /**
-   * @brief 获取当前读取的文件位置
+   * @brief 获取当前读取的位置
    */
   RC offset(int64_t &off) const;
 
@@ -320,16 +493,95 @@ public:
    */
   bool eof() const { return eof_; }
 
+  /**
+   * @brief 第一个段文件的起始LSN，也就是可以读取到的最小的LSN
+   */
+  int64_t start_lsn() const;
+
+  /**
+   * @brief 日志文件中已有数据的结尾，新的日志从这里开始写
+   */
+  int64_t end_lsn() const { return end_lsn_; }
+
+  /**
+   * @brief 截断日志，丢弃 lsn 之后的所有数据
+   * @details 用来丢弃日志尾部没有写完整的日志。lsn 之后开始的段文件会被删除
+   */
+  RC truncate(int64_t lsn);
+
+  /**
+   * @brief 删除所有数据都在 lsn 之前的段文件
+   * @details 正在写入的段文件不会被删除
+   */
+  RC remove_segments_before(int64_t lsn);
+
+  /**
+   * @brief 当前所有段文件的起始LSN
+   */
+  void segments(std::vector<int64_t> &start_lsns) const;
+
+  /**
+   * @brief 每个段文件存放的日志数据长度
+   */
+  int64_t segment_size() const { return segment_size_; }
+
+  /**
+   * @brief 段文件头的长度，段文件中LSN为 lsn 的数据在文件中的偏移是 header_size + lsn - 起始LSN
+   */
+  int32_t header_size() const { return header_size_; }
+
+  /**
+   * @brief 起始LSN为 start_lsn 的段文件的完整路径
+   */
+  std::string segment_filename(int64_t start_lsn) const;
+
+  static const int64_t DEFAULT_SEGMENT_SIZE;
+
+private:
+  /**
+   * @brief 一个段文件
+   */
+  struct Segment
+  {
+    std::string filename;
+    int         fd = -1;
+  };
+
+  /**
+   * @brief 打开已有的段文件并检查文件头
+   */
+  RC open_segment(const std::string &filename, CLogSegmentHeader &header, int &fd);
+
+  /**
+   * @brief 创建新的段文件，写入文件头并sync
+   */
+  RC create_segment(int64_t start_lsn);
+
+  /**
+   * @brief 获取LSN所在的段文件，不存在时返回nullptr
+   */
+  Segment *find_segment(int64_t lsn);
+
 protected:
-  std::string filename_;  ///< 日志文件名。总是init函数参数path路径下的clog文件
-  int fd_ = -1;           ///< 操作的文件描述符
-  bool eof_ = false;      ///< 是否已经读取到文件尾
+  std::string path_;                 ///< 日志文件所在的目录
+  int64_t     segment_size_ = 0;     ///< 每个段文件存放的日志数据长度
+  int32_t     header_size_  = 0;     ///< 段文件头的长度
+  int64_t     end_lsn_      = 0;     ///< 已经写入的数据的结尾
+  int64_t     read_lsn_     = 0;     ///< 当前读取的位置
+  bool        eof_          = false; ///< 是否已经读取到文件尾
+
+  mutable std::mutex         lock_;      ///< 保护段文件列表
+  std::map<int64_t, Segment> segments_;  ///< 所有的段文件，key是起始LSN
+  std::set<int64_t>          unsynced_;  ///< 上次sync之后写过的段文件
 };
 
 /**
  * @brief 日志记录遍历器
  * @ingroup CLog
  * @details 使用时先执行初始化(init)，然后多次调用next，直到valid返回false。
+ * 读取时会检查每条日志的校验码。如果日志文件的最后一条日志没有写完整(torn write)，
+ * 就当作日志已经结束，next 返回 RECORD_EOF，通过 torn_tail 可以知道是否遇到了这种情况；
+ * 如果出错的日志后面还有完整的日志，说明日志文件损坏了，next 返回 LOG_CORRUPTED。
  */
 class CLogRecordIterator
 {
@@ -337,15 +589,69 @@ public:
   CLogRecordIterator() = default;
   ~CLogRecordIterator() = default;
 
-  RC init(CLogFile &log_file);
+  /**
+   * @brief 初始化
+   * @param lsn 从这个位置开始遍历，小于0表示从第一个段文件开始
+   */
+  RC init(CLogFile &log_file, int64_t lsn = -1);
 
   bool valid() const;
   RC next();
   const CLogRecord &log_record();
 
+  /**
+   * @brief 取走当前的日志对象，由调用者负责释放
+   */
+  CLogRecord *release_log_record();
+
+  /**
+   * @brief 下一条日志的位置。遍历结束时就是最后一条完整日志的结尾
+   */
+  int64_t lsn() const { return lsn_; }
+
+  /**
+   * @brief 是否在日志的结尾遇到了没有写完整的日志
+   */
+  bool torn_tail() const { return torn_tail_; }
+
 private:
-  CLogFile *log_file_ = nullptr;
+  /**
+   * @brief 获取日志流中 [lsn, lsn + len) 的数据
+   * @details 每次从文件中预读一大块数据，避免每条日志都要读取多次文件
+   * @return 数据超过了日志文件的结尾时返回 RECORD_EOF
+   */
+  RC read(int64_t lsn, int32_t len, const char *&data);
+
+  /**
+   * @brief 检查 lsn 位置的日志是否完整
+   * @param body     日志的body
+   * @param body_len body的长度
+   * @param next_lsn 下一条日志的位置
+   * @return 已经到了日志的结尾返回 RECORD_EOF，日志不完整或者校验码不正确返回 LOG_CORRUPTED
+   */
+  RC parse(int64_t lsn, const char *&body, int32_t &body_len, int64_t &next_lsn);
+
+  /**
+   * @brief 判断 lsn 位置损坏的日志是不是最后一次写日志时没有写完整的日志
+   * @details 没有写完整的日志一直延伸到日志的结尾，后面不会再有完整的日志，或者后面只剩下没有写入数据的0。
+   * 长度字段损坏时不知道日志在哪里结束，从 lsn 之后逐个位置查找，找到完整的日志就说明是中间的日志损坏了
+   * @param next_lsn 按照长度字段计算的下一条日志的位置，长度字段无法解析时等于 lsn
+   */
+  bool is_torn_tail(int64_t lsn, int64_t next_lsn);
+
+  /**
+   * @brief [lsn, 日志结尾) 是否都是0
+   */
+  bool zero_to_end(int64_t lsn);
+
+private:
+  CLogFile   *log_file_   = nullptr;
   CLogRecord *log_record_ = nullptr;
+
+  int64_t           lsn_        = 0;      ///< 下一条日志的位置
+  bool              torn_tail_  = false;  ///< 是否遇到了没有写完整的日志
+  std::vector<char> buffer_;              ///< 预读的数据
+  int64_t           buffer_lsn_ = 0;      ///< buffer_ 中第一个字节的LSN
 };
 
 /**
@@ -364,60 +670,225 @@ public:
    * @brief 初始化日志管理器
    * 
    * @param path 日志都放在这个目录下。当前就是数据库的目录
+   * @param segment_size 每个日志段文件的大小，参考 CLogFile::init
    */
-  RC init(const char *path);
+  RC init(const char *path, int64_t segment_size = CLogFile::DEFAULT_SEGMENT_SIZE);
 
   /**
    * @brief 新增一条数据更新的日志
+   * @param lsn 返回日志的LSN，修改的页面要记录这个LSN
    */
   RC append_log(CLogType type,
-                int32_t trx_id,
+                int64_t trx_id,
                 int32_t table_id,
                 const RID &rid,
                 int32_t data_len,
                 int32_t data_offset,
-                const char *data);
+                const char *data,
+                int64_t *lsn = nullptr);
+
+  /**
+   * @brief 一次增加一组日志，比如批量插入时每条记录的日志
+   * @details 如果整组日志超过了日志缓存的大小，就一条一条地写入。
+   * 写入之后每条日志的LSN可以从日志头中获取
+   */
+  RC append_logs(std::vector<std::unique_ptr<CLogRecord>> &log_records);
 
   /**
    * @brief 开启一个事务
    * 
    * @param trx_id 事务编号
    */
-  RC begin_trx(int32_t trx_id);
+  RC begin_trx(int64_t trx_id);
 
   /**
    * @brief 提交一个事务
+   * @details 提交日志刷盘之后才返回。同时提交的多个事务会组成一组(group commit)，
+   * 由其中一个事务(leader)把所有等待的日志一次写入并sync，其它事务等待leader完成即可
    * 
+   * 异步提交(durable 为 false)时提交日志放到日志缓存中就返回，由后台线程定期刷盘，参考 set_async_flush_interval。
+   * 宕机时可能丢失最后一段时间内异步提交的事务，但是不会破坏数据的一致性
+   *
    * @param trx_id 事务编号
    * @param commit_xid 事务提交时使用的编号
+   * @param lsn 返回提交日志的LSN
+   * @param durable 是否等待提交日志落盘
+   * @param appended 提交日志放到日志缓存以后、等待落盘之前调用，参数是提交日志的LSN。
+   * 事务在这里公布提交状态，之后依赖它的事务的日志都在它的提交日志后面
+   * @note 写完提交日志以后，checkpoint 仍然把事务当作正在运行，直到调用 end_trx
+   */
+  RC commit_trx(int64_t trx_id, int64_t commit_xid, int64_t *lsn = nullptr, bool durable = true,
+      const std::function<void(int64_t lsn)> &appended = nullptr);
+
+  /**
+   * @brief 提交的事务把修改过的记录交给事务管理器以后调用，回滚的事务恢复完所有页面以后调用
+   * @details 在这之前 checkpoint 把它当作正在运行的事务，恢复时会重做它所有的日志。
+   * 在这之后 checkpoint 改写记录上的事务号时一定能找到它修改过的记录
    */
-  RC commit_trx(int32_t trx_id, int32_t commit_xid);
+  void end_trx(int64_t trx_id);
 
   /**
    * @brief 回滚一个事务
-   * 
+   * @details 回滚日志在恢复页面之前写入，重做回滚日志时恢复还没有恢复的页面。
+   * 页面都恢复以后再调用 end_trx
+   *
    * @param trx_id 事务编号
+   * @param lsn 返回回滚日志的LSN
    */
-  RC rollback_trx(int32_t trx_id);
+  RC rollback_trx(int64_t trx_id, int64_t *lsn = nullptr);
 
   /**
    * @brief 也可以调用这个函数直接增加一条日志
+   * @details 日志对象由管理器负责释放
    */
-  RC append_log(CLogRecord *log_record);
+  RC append_log(CLogRecord *log_record, int64_t *lsn = nullptr);
 
   /**
    * @brief 刷新日志到磁盘
    */
   RC sync();
 
+  /**
+   * @brief 保证LSN为 lsn 的日志已经落盘
+   * @details 页面写入磁盘之前调用，保证WAL。日志已经落盘时直接返回
+   */
+  RC flush_to(int64_t lsn);
+
+  /**
+   * @brief 设置组提交的等待时间
+   * @details leader在刷日志之前先等待一段时间，让更多提交的事务加入到这一组中，用提交延迟换取更少的sync次数
+   * @param microseconds 等待的微秒数，0表示不等待
+   */
+  void set_group_commit_window(int microseconds) { group_commit_window_us_ = microseconds; }
+  int  group_commit_window() const { return group_commit_window_us_.load(); }
+
+  /**
+   * @brief 设置后台刷日志的间隔
+   * @details 异步提交的事务不等待日志落盘，由后台线程每隔这么长时间把日志刷到磁盘。
+   * 宕机时最多丢失这段时间内异步提交的事务
+   * @param milliseconds 间隔的毫秒数，必须大于0
+   */
+  void set_async_flush_interval(int milliseconds);
+  int  async_flush_interval() const { return async_flush_interval_ms_.load(); }
+
+  /**
+   * @brief 下一条日志的LSN
+   */
+  int64_t current_lsn() const;
+
+  /**
+   * @brief 已经落盘的日志的结尾，这之前提交的事务都不会丢失
+   */
+  int64_t durable_lsn() const;
+
+  /**
+   * @brief 设置恢复时并行重做日志的线程数
+   * @details 0表示由读日志的线程自己重做，参考 ParallelRedoer
+   */
+  void set_redo_worker_num(int worker_num) { redo_worker_num_ = worker_num; }
+  int  redo_worker_num() const { return redo_worker_num_; }
+
+  /**
+   * @brief 做一次 checkpoint
+   * @details 不会阻塞其它事务，过程参考 CLogCheckpoint。完成后把 checkpoint 日志的位置写入控制文件，
+   * 并删除恢复时不再需要的日志段文件。同一时间只有一个 checkpoint 在运行
+   * @param checkpoint_lsn 返回 checkpoint 日志的位置，可以为空
+   * @param redo_lsn       返回从这个 checkpoint 恢复时开始重做的位置，可以为空
+   */
+  RC checkpoint(Db *db, int64_t *checkpoint_lsn = nullptr, int64_t *redo_lsn = nullptr);
+
+  /**
+   * @brief 保留从 lsn 开始的日志段文件，checkpoint 时不会删除它们，直到调用 release_log
+   * @details 在线备份期间使用，备份结束前要复制这些日志
+   */
+  void retain_log(int64_t lsn) { retain_lsn_.store(lsn); }
+  void release_log() { retain_lsn_.store(INT64_MAX); }
+
+  /**
+   * @brief 在线备份时复制日志
+   * @details 先把日志刷到磁盘，然后复制 [begin_lsn, 落盘位置) 之间的日志所在的段文件，最后一个段文件只复制到落盘的位置。
+   * 再在 dest_path 中写一个指向 checkpoint_lsn 的控制文件，从备份启动时就会从这个 checkpoint 开始恢复
+   * @param dest_path      备份目录
+   * @param begin_lsn      开始复制的日志位置，通常是 checkpoint 的 redo LSN
+   * @param checkpoint_lsn 备份开始时做的 checkpoint 日志的位置
+   * @param end_lsn        返回复制的日志的结尾
+   */
+  RC backup_log(const char *dest_path, int64_t begin_lsn, int64_t checkpoint_lsn, IoThrottle *throttle,
+                int64_t &end_lsn, int64_t &copied_bytes);
+
+  /**
+   * @brief 开启日志归档
+   * @details 写满并且已经落盘的段文件会被复制到归档目录，参考 CLogArchiver。
+   * 开启归档之后，checkpoint 只会删除已经归档的段文件
+   * @param archive_path 归档目录
+   */
+  RC enable_archive(const char *archive_path);
+
+  /**
+   * @brief 日志归档器，没有开启归档时返回nullptr
+   */
+  CLogArchiver *archiver() { return archiver_.get(); }
+
+  /**
+   * @brief 读取日志目录中的控制文件，没有控制文件时返回 RC::FILE_NOT_EXIST
+   * @param path 日志所在的目录
+   * @param checkpoint_lsn 返回最近一次 checkpoint 日志的位置
+   */
+  static RC read_control_file(const std::string &path, int64_t &checkpoint_lsn);
+
+  /**
+   * @brief 原子地更新日志目录中的控制文件：先写临时文件，再重命名
+   */
+  static RC write_control_file(const std::string &path, int64_t checkpoint_lsn);
+
   /**
    * @brief 重做
-   * @details 当前会重做所有日志。也就是说，所有buffer pool页面都不会写入到磁盘中，
-   * 否则可能无法恢复成功。
+   * @details 如果有控制文件，就从其中记录的 checkpoint 开始重做，否则重做所有日志。
+   * checkpoint 之前已经结束的事务的日志会被跳过，它们修改的页面在 checkpoint 时已经写入了磁盘。
+   * 其它日志由事务重做，LSN不大于页面LSN的修改已经在页面上了，不会重复执行。
+   * 恢复完成后会再做一次 checkpoint。
    */
   RC recover(Db *db);
 
+private:
+  /**
+   * @brief 读取指定位置的 checkpoint 日志
+   */
+  RC read_checkpoint(int64_t checkpoint_lsn, CLogCheckpoint &checkpoint);
+
+
+  /**
+   * @brief 等待指定LSN之前的日志都刷到磁盘
+   * @details 没有线程在刷日志时，当前线程成为leader负责刷盘，否则等待leader刷完再检查
+   */
+  RC wait_for_flush(int64_t lsn);
+
+  /**
+   * @brief 后台刷日志的线程，第一次异步提交时启动
+   */
+  void async_flush_loop();
+
 private:
   CLogBuffer *log_buffer_ = nullptr;   ///< 日志缓存。新增日志时先放到内存，也就是这个buffer中
   CLogFile *  log_file_   = nullptr;   ///< 管理日志，比如读写日志
+
+  std::unique_ptr<CLogArchiver> archiver_;  ///< 日志归档，没有开启时为空
+
+  std::mutex              group_commit_lock_;
+  std::condition_variable group_commit_cond_;  ///< leader刷完日志后通知等待的事务
+  bool                    flushing_ = false;    ///< 是否已经有leader在刷日志
+  std::atomic_int32_t     group_commit_window_us_{0};  ///< leader刷日志前等待其它事务加入的时间
+  int                     redo_worker_num_ = 0;        ///< 恢复时并行重做日志的线程数
+
+  std::mutex              async_flush_lock_;
+  std::condition_variable async_flush_cond_;
+  std::atomic_int32_t     async_flush_interval_ms_{200};  ///< 后台刷日志的间隔
+  bool                    async_flush_stopped_ = false;
+  std::thread             async_flush_thread_;            ///< 异步提交的日志由这个线程刷盘
+
+  std::string                path_;            ///< 日志所在的目录，控制文件也放在这里
+  std::mutex                 trx_lock_;        ///< 保护 active_trxes_
+  std::map<int64_t, int64_t> active_trxes_;    ///< 正在运行的事务以及它们 MTR_BEGIN 日志的LSN
+  std::mutex                 checkpoint_lock_; ///< 同一时间只做一个 checkpoint
+  std::atomic_int64_t        retain_lsn_{INT64_MAX};  ///< 在线备份时需要保留的日志位置，参考 retain_log
 };
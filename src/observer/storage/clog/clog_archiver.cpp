@@ -0,0 +1,540 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include "common/io/io.h"
+#include "common/log/log.h"
+#include "common/math/crc32c.h"
+#include "common/os/path.h"
+#include "storage/clog/clog.h"
+#include "storage/clog/clog_archiver.h"
+
+using namespace std;
+
+const char *CLogArchiveManifest::MANIFEST_FILE_NAME = "clog_manifest";
+
+/// 复制文件时每次读写的数据量
+static const int ARCHIVE_COPY_BUFFER_SIZE = 1024 * 1024;
+
+static void sync_directory(const string &path)
+{
+  int dir_fd = ::open(path.c_str(), O_RDONLY);
+  if (dir_fd >= 0) {
+    (void)fsync(dir_fd);
+    ::close(dir_fd);
+  }
+}
+
+static string base_name(const string &filename)
+{
+  size_t pos = filename.find_last_of('/');
+  return pos == string::npos ? filename : filename.substr(pos + 1);
+}
+
+/**
+ * @brief 计算文件的校验码。dst 不为空时同时把文件复制过去并sync
+ */
+static RC checksum_file(const string &src, const string *dst, uint32_t &crc, int64_t &size)
+{
+  int src_fd = ::open(src.c_str(), O_RDONLY);
+  if (src_fd < 0) {
+    LOG_WARN("failed to open file. file=%s, error=%s", src.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  int dst_fd = -1;
+  if (dst != nullptr) {
+    dst_fd = ::open(dst->c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (dst_fd < 0) {
+      LOG_WARN("failed to create file. file=%s, error=%s", dst->c_str(), strerror(errno));
+      ::close(src_fd);
+      return RC::IOERR_OPEN;
+    }
+  }
+
+  RC           rc = RC::SUCCESS;
+  vector<char> buffer(ARCHIVE_COPY_BUFFER_SIZE);
+  crc  = 0;
+  size = 0;
+  while (true) {
+    ssize_t ret = ::read(src_fd, buffer.data(), buffer.size());
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_WARN("failed to read file. file=%s, error=%s", src.c_str(), strerror(errno));
+      rc = RC::IOERR_READ;
+      break;
+    }
+    if (ret == 0) {
+      break;
+    }
+
+    crc = common::crc32c_extend(crc, buffer.data(), ret);
+    size += ret;
+    if (dst_fd >= 0 && common::writen(dst_fd, buffer.data(), static_cast<int>(ret)) != 0) {
+      LOG_WARN("failed to write file. file=%s, error=%s", dst->c_str(), strerror(errno));
+      rc = RC::IOERR_WRITE;
+      break;
+    }
+  }
+
+  if (OB_SUCC(rc) && dst_fd >= 0 && fsync(dst_fd) != 0) {
+    LOG_WARN("failed to sync file. file=%s, error=%s", dst->c_str(), strerror(errno));
+    rc = RC::IOERR_SYNC;
+  }
+
+  ::close(src_fd);
+  if (dst_fd >= 0) {
+    ::close(dst_fd);
+  }
+  return rc;
+}
+
+/**
+ * @brief 把文件复制到目标目录，先写临时文件，sync之后再重命名
+ */
+static RC copy_file_atomic(const string &src, const string &dst_dir, const string &dst_name, uint32_t &crc, int64_t &size)
+{
+  const string dst     = dst_dir + "/" + dst_name;
+  const string dst_tmp = dst + ".tmp";
+
+  RC rc = checksum_file(src, &dst_tmp, crc, size);
+  if (OB_FAIL(rc)) {
+    ::unlink(dst_tmp.c_str());
+    return rc;
+  }
+
+  if (::rename(dst_tmp.c_str(), dst.c_str()) != 0) {
+    LOG_WARN("failed to rename file. %s -> %s, error=%s", dst_tmp.c_str(), dst.c_str(), strerror(errno));
+    ::unlink(dst_tmp.c_str());
+    return RC::IOERR_WRITE;
+  }
+
+  sync_directory(dst_dir);
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+string CLogArchiveEntry::to_string() const
+{
+  stringstream ss;
+  ss << "filename:" << filename << ", start_lsn:" << start_lsn << ", end_lsn:" << end_lsn << ", checksum:" << hex
+     << checksum;
+  return ss.str();
+}
+
+RC CLogArchiveManifest::load(const string &archive_path)
+{
+  filename_ = archive_path + "/" + MANIFEST_FILE_NAME;
+  entries_.clear();
+
+  if (::access(filename_.c_str(), F_OK) != 0) {
+    return RC::SUCCESS;
+  }
+
+  ifstream file(filename_);
+  if (!file.is_open()) {
+    LOG_ERROR("failed to open clog manifest. file=%s, error=%s", filename_.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  string line;
+  int    line_no = 0;
+  while (getline(file, line)) {
+    line_no++;
+    if (line.empty()) {
+      continue;
+    }
+
+    CLogArchiveEntry entry;
+    istringstream    iss(line);
+    string           checksum;
+    iss >> entry.filename >> entry.start_lsn >> entry.end_lsn >> checksum;
+    if (iss.fail() || checksum.empty() || entry.end_lsn <= entry.start_lsn ||
+        (!entries_.empty() && entry.start_lsn < entries_.back().end_lsn)) {
+      if (file.peek() == EOF) {
+        // 追加最后一行时宕机
+        LOG_WARN("ignore incomplete line at the end of clog manifest. file=%s, line=%d", filename_.c_str(), line_no);
+        break;
+      }
+      LOG_ERROR("invalid line in clog manifest. file=%s, line=%d, content=%s", filename_.c_str(), line_no, line.c_str());
+      return RC::LOG_CORRUPTED;
+    }
+    entry.checksum = static_cast<uint32_t>(strtoul(checksum.c_str(), nullptr, 16));
+    entries_.push_back(entry);
+  }
+
+  LOG_INFO("load clog manifest. file=%s, entries=%d, end lsn=%ld",
+           filename_.c_str(), static_cast<int>(entries_.size()), static_cast<long>(end_lsn()));
+  return RC::SUCCESS;
+}
+
+RC CLogArchiveManifest::append(const CLogArchiveEntry &entry)
+{
+  char line[256];
+  int  len = snprintf(line, sizeof(line), "%s %" PRId64 " %" PRId64 " %08x\n",
+      entry.filename.c_str(), entry.start_lsn, entry.end_lsn, entry.checksum);
+
+  int fd = ::open(filename_.c_str(), O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    LOG_ERROR("failed to open clog manifest. file=%s, error=%s", filename_.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  int ret = common::writen(fd, line, len);
+  if (ret != 0 || fsync(fd) != 0) {
+    LOG_ERROR("failed to append clog manifest. file=%s, error=%s", filename_.c_str(), strerror(errno));
+    ::close(fd);
+    return RC::IOERR_WRITE;
+  }
+  ::close(fd);
+
+  entries_.push_back(entry);
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+CLogArchiver::~CLogArchiver() { stop(); }
+
+RC CLogArchiver::init(const char *archive_path, CLogFile *log_file, function<int64_t()> durable_lsn)
+{
+  archive_path_ = archive_path;
+  log_file_     = log_file;
+  durable_lsn_  = std::move(durable_lsn);
+
+  if (!common::check_directory(archive_path_)) {
+    LOG_ERROR("failed to create clog archive directory. path=%s", archive_path);
+    return RC::IOERR_ACCESS;
+  }
+
+  RC rc = manifest_.load(archive_path_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const int64_t archived_end = manifest_.end_lsn();
+  if (archived_end < 0) {
+    // 第一次归档，从现有的第一个段文件开始
+    next_lsn_ = log_file_->start_lsn();
+  } else if (archived_end > log_file_->end_lsn()) {
+    // 归档的日志比现在的日志还长，说明归档目录属于别的数据库或者数据库从旧的备份恢复过
+    LOG_ERROR("clog archive is ahead of the log, the archive may belong to another database. "
+              "archive path=%s, archived lsn=%ld, log end lsn=%ld",
+              archive_path, static_cast<long>(archived_end), static_cast<long>(log_file_->end_lsn()));
+    return RC::INVALID_ARGUMENT;
+  } else {
+    next_lsn_ = archived_end;
+    if (archived_end < log_file_->start_lsn()) {
+      LOG_WARN("some log segments were removed before archived, the archive has a gap. "
+               "archived lsn=%ld, log start lsn=%ld",
+               static_cast<long>(archived_end), static_cast<long>(log_file_->start_lsn()));
+      next_lsn_ = log_file_->start_lsn();
+    }
+  }
+
+  LOG_INFO("init clog archiver. path=%s, next lsn=%ld", archive_path, static_cast<long>(next_lsn_.load()));
+  return RC::SUCCESS;
+}
+
+RC CLogArchiver::start()
+{
+  lock_guard<mutex> guard(thread_lock_);
+  if (thread_.joinable()) {
+    return RC::SUCCESS;
+  }
+  stopped_ = false;
+  thread_  = thread(&CLogArchiver::archive_loop, this);
+  return RC::SUCCESS;
+}
+
+void CLogArchiver::stop()
+{
+  {
+    lock_guard<mutex> guard(thread_lock_);
+    if (!thread_.joinable()) {
+      return;
+    }
+    stopped_ = true;
+  }
+  thread_cond_.notify_all();
+  thread_.join();
+
+  RC rc = archive();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to archive clog while stopping. rc=%s", strrc(rc));
+  }
+}
+
+void CLogArchiver::archive_loop()
+{
+  LOG_INFO("clog archiver thread started. interval=%dms", interval_ms_);
+  unique_lock<mutex> guard(thread_lock_);
+  while (!stopped_) {
+    thread_cond_.wait_for(guard, chrono::milliseconds(interval_ms_), [this]() { return stopped_; });
+    if (stopped_) {
+      break;
+    }
+
+    guard.unlock();
+    RC rc = archive();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to archive clog. rc=%s", strrc(rc));
+    }
+    guard.lock();
+  }
+  LOG_INFO("clog archiver thread stopped");
+}
+
+int64_t CLogArchiver::archived_lsn() const { return next_lsn_.load(); }
+
+RC CLogArchiver::archive()
+{
+  lock_guard<mutex> guard(lock_);
+
+  const int64_t segment_size = log_file_->segment_size();
+  const int64_t durable_lsn  = durable_lsn_();
+
+  vector<int64_t> start_lsns;
+  log_file_->segments(start_lsns);
+  for (int64_t start_lsn : start_lsns) {
+    if (start_lsn < next_lsn_) {
+      continue;
+    }
+    if (start_lsn + segment_size > durable_lsn) {
+      break;
+    }
+
+    if (start_lsn > next_lsn_) {
+      LOG_WARN("clog archive has a gap. archived lsn=%ld, next segment=%ld",
+               static_cast<long>(next_lsn_.load()), static_cast<long>(start_lsn));
+    }
+
+    RC rc = archive_segment(start_lsn);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    next_lsn_ = start_lsn + segment_size;
+  }
+  return RC::SUCCESS;
+}
+
+RC CLogArchiver::archive_segment(int64_t start_lsn)
+{
+  CLogArchiveEntry entry;
+  const string     src = log_file_->segment_filename(start_lsn);
+  entry.filename       = base_name(src);
+  entry.start_lsn      = start_lsn;
+  entry.end_lsn        = start_lsn + log_file_->segment_size();
+
+  int64_t size = 0;
+  RC      rc   = copy_file_atomic(src, archive_path_, entry.filename, entry.checksum, size);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to archive clog segment. file=%s, rc=%s", src.c_str(), strrc(rc));
+    return rc;
+  }
+
+  rc = manifest_.append(entry);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  LOG_INFO("archive clog segment. %s, size=%ld", entry.to_string().c_str(), static_cast<long>(size));
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+CLogRestorer::CLogRestorer(const char *archive_path, const char *log_path)
+    : archive_path_(archive_path), log_path_(log_path)
+{}
+
+RC CLogRestorer::restore()
+{
+  CLogArchiveManifest manifest;
+  RC                  rc = manifest.load(archive_path_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = verify_archive(manifest);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 从基础备份的 checkpoint 开始找目标位置，它之前的日志在恢复时也用不到
+  int64_t checkpoint_lsn = -1;
+  rc                     = CLogManager::read_control_file(log_path_, checkpoint_lsn);
+  if (OB_FAIL(rc) && rc != RC::FILE_NOT_EXIST) {
+    return rc;
+  }
+
+  int64_t base_end_lsn = 0;
+  {
+    CLogFile base_log_file;
+    rc = base_log_file.init(log_path_.c_str());
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("failed to open clog of base backup. path=%s, rc=%s", log_path_.c_str(), strrc(rc));
+      return rc;
+    }
+    base_end_lsn = base_log_file.end_lsn();
+
+    if (!manifest.entries().empty() && manifest.entries().front().end_lsn - manifest.entries().front().start_lsn !=
+                                           base_log_file.segment_size()) {
+      LOG_ERROR("segment size of the archive does not match the base backup. archive=%s, base segment size=%ld",
+                manifest.entries().front().to_string().c_str(), static_cast<long>(base_log_file.segment_size()));
+      return RC::INVALID_ARGUMENT;
+    }
+  }
+
+  rc = copy_segments(manifest, base_end_lsn);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  CLogFile log_file;
+  rc = log_file.init(log_path_.c_str());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = find_stop_lsn(log_file, checkpoint_lsn);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 基础备份中的页面可能已经包含了它的日志结尾之前的任何修改，没有办法撤销到更早的位置
+  if (stop_lsn_ < base_end_lsn) {
+    LOG_ERROR("cannot restore to a point before the base backup. stop lsn=%ld, base backup end lsn=%ld",
+              static_cast<long>(stop_lsn_), static_cast<long>(base_end_lsn));
+    return RC::INVALID_ARGUMENT;
+  }
+
+  rc = log_file.truncate(stop_lsn_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  LOG_INFO("restore clog done. stop lsn=%ld, last commit xid=%ld, base backup end lsn=%ld",
+           static_cast<long>(stop_lsn_), last_commit_xid_, static_cast<long>(base_end_lsn));
+  return RC::SUCCESS;
+}
+
+RC CLogRestorer::verify_archive(const CLogArchiveManifest &manifest)
+{
+  const vector<CLogArchiveEntry> &entries = manifest.entries();
+  for (size_t i = 0; i < entries.size(); i++) {
+    const CLogArchiveEntry &entry = entries[i];
+    if (i > 0 && entry.start_lsn != entries[i - 1].end_lsn) {
+      // 有缺口的话只能恢复到缺口之前
+      LOG_WARN("clog archive has a gap. previous={%s}, next={%s}",
+               entries[i - 1].to_string().c_str(), entry.to_string().c_str());
+    }
+
+    uint32_t crc  = 0;
+    int64_t  size = 0;
+    RC       rc   = checksum_file(archive_path_ + "/" + entry.filename, nullptr, crc, size);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    if (crc != entry.checksum) {
+      LOG_ERROR("checksum mismatch of archived clog segment. %s, actual checksum=%x", entry.to_string().c_str(), crc);
+      return RC::LOG_CORRUPTED;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC CLogRestorer::copy_segments(const CLogArchiveManifest &manifest, int64_t base_end_lsn)
+{
+  // 基础备份之后的日志必须连续，遇到缺口就停下来
+  int64_t next_lsn = base_end_lsn;
+  for (const CLogArchiveEntry &entry : manifest.entries()) {
+    if (entry.end_lsn <= base_end_lsn) {
+      // 基础备份中已经有完整的段文件
+      continue;
+    }
+    if (entry.start_lsn > next_lsn) {
+      LOG_WARN("clog archive has a gap, stop copying. next lsn=%ld, entry={%s}",
+               static_cast<long>(next_lsn), entry.to_string().c_str());
+      break;
+    }
+
+    uint32_t crc  = 0;
+    int64_t  size = 0;
+    RC       rc   = copy_file_atomic(archive_path_ + "/" + entry.filename, log_path_, entry.filename, crc, size);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    if (crc != entry.checksum) {
+      LOG_ERROR("checksum mismatch while copying archived clog segment. %s", entry.to_string().c_str());
+      return RC::LOG_CORRUPTED;
+    }
+    next_lsn = entry.end_lsn;
+    LOG_INFO("copy archived clog segment. %s", entry.to_string().c_str());
+  }
+  return RC::SUCCESS;
+}
+
+RC CLogRestorer::find_stop_lsn(CLogFile &log_file, int64_t start_lsn)
+{
+  CLogRecordIterator iterator;
+  RC                 rc = iterator.init(log_file, start_lsn);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  for (rc = iterator.next(); OB_SUCC(rc) && iterator.valid(); rc = iterator.next()) {
+    const CLogRecord &log_record = iterator.log_record();
+    const int64_t     lsn        = log_record.header().lsn_;
+    if (lsn >= target_lsn_) {
+      stop_lsn_ = lsn;
+      return RC::SUCCESS;
+    }
+
+    if (log_record.log_type() == CLogType::MTR_COMMIT) {
+      const int64_t commit_xid = log_record.commit_record().commit_xid_;
+      if (commit_xid > target_xid_) {
+        stop_lsn_ = lsn;
+        return RC::SUCCESS;
+      }
+      last_commit_xid_ = commit_xid;
+    }
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_ERROR("failed to read clog while looking for the restore point. lsn=%ld, rc=%s",
+              static_cast<long>(iterator.lsn()), strrc(rc));
+    return rc;
+  }
+
+  // 没有到达目标位置，恢复到日志的结尾
+  stop_lsn_ = iterator.lsn();
+  if (target_lsn_ != INT64_MAX || target_xid_ != INT64_MAX) {
+    LOG_WARN("restore target is beyond the archived log, restore to the end of log. stop lsn=%ld",
+             static_cast<long>(stop_lsn_));
+  }
+  return RC::SUCCESS;
+}
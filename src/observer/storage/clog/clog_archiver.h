@@ -0,0 +1,203 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/rc.h"
+
+class CLogFile;
+
+/**
+ * @brief 一个归档的日志段文件
+ * @ingroup CLog
+ */
+struct CLogArchiveEntry
+{
+  std::string filename;       ///< 归档目录中的文件名，与日志目录中的段文件同名
+  int64_t     start_lsn = 0;  ///< 段文件中第一个字节的LSN
+  int64_t     end_lsn   = 0;  ///< 段文件结束的LSN，归档的段文件都是写满的
+  uint32_t    checksum  = 0;  ///< 整个文件(包含段文件头)的CRC32C
+
+  std::string to_string() const;
+};
+
+/**
+ * @brief 归档清单
+ * @ingroup CLog
+ * @details 归档目录中的文本文件，每个归档的段文件一行：文件名 起始LSN 结束LSN 校验码。
+ * 段文件复制完成并且sync之后才会追加到清单中，所以清单中的文件总是完整的。
+ * 追加到一半时宕机，清单最后会有一行不完整的内容，加载时忽略。
+ */
+class CLogArchiveManifest
+{
+public:
+  /**
+   * @brief 加载归档目录中的清单，清单文件不存在时当作空的清单
+   */
+  RC load(const std::string &archive_path);
+
+  /**
+   * @brief 追加一个归档的段文件并sync清单文件
+   */
+  RC append(const CLogArchiveEntry &entry);
+
+  const std::vector<CLogArchiveEntry> &entries() const { return entries_; }
+
+  /**
+   * @brief 归档的日志结束的位置。空的清单返回-1
+   */
+  int64_t end_lsn() const { return entries_.empty() ? -1 : entries_.back().end_lsn; }
+
+  static const char *MANIFEST_FILE_NAME;
+
+private:
+  std::string                   filename_;
+  std::vector<CLogArchiveEntry> entries_;
+};
+
+/**
+ * @brief 日志归档
+ * @ingroup CLog
+ * @details 把写满并且已经落盘的日志段文件复制到归档目录，配合一个数据目录的基础备份，
+ * 就可以用 CLogRestorer 把数据恢复到基础备份之后的任意位置(point-in-time recovery)。
+ * 段文件按照LSN的顺序归档，先复制到临时文件，sync之后再重命名，最后追加到清单中。
+ * 后台线程定期检查有没有新写满的段文件，也可以调用 archive 立即归档。
+ * 开启归档之后，checkpoint 不会删除还没有归档的段文件。
+ */
+class CLogArchiver
+{
+public:
+  CLogArchiver() = default;
+  ~CLogArchiver();
+
+  /**
+   * @param archive_path 归档目录，不存在时会创建
+   * @param log_file     要归档的日志
+   * @param durable_lsn  返回已经落盘的日志位置，只有这之前的段文件才会归档
+   */
+  RC init(const char *archive_path, CLogFile *log_file, std::function<int64_t()> durable_lsn);
+
+  /**
+   * @brief 启动后台归档线程
+   * @details 恢复完成之后再启动，恢复时日志结尾可能会被截断
+   */
+  RC start();
+
+  /**
+   * @brief 停止后台线程，停止之前把已经写满的段文件都归档
+   */
+  void stop();
+
+  /**
+   * @brief 归档所有写满并且已经落盘的段文件
+   */
+  RC archive();
+
+  /**
+   * @brief 这个位置之前的段文件已经归档或者不需要归档，可以删除
+   */
+  int64_t archived_lsn() const;
+
+  /**
+   * @brief 后台线程检查的时间间隔，单位毫秒
+   */
+  void set_interval(int interval_ms) { interval_ms_ = interval_ms; }
+
+  const std::string &archive_path() const { return archive_path_; }
+
+private:
+  RC   archive_segment(int64_t start_lsn);
+  void archive_loop();
+
+private:
+  std::string              archive_path_;
+  CLogFile                *log_file_ = nullptr;
+  std::function<int64_t()> durable_lsn_;
+
+  std::mutex           lock_;          ///< 保护清单，同一时间只有一个线程在归档
+  CLogArchiveManifest  manifest_;
+  std::atomic_int64_t  next_lsn_{0};   ///< 下一个要归档的段文件的起始LSN
+
+  std::mutex              thread_lock_;
+  std::condition_variable thread_cond_;
+  bool                    stopped_     = false;
+  int                     interval_ms_ = 1000;
+  std::thread             thread_;
+};
+
+/**
+ * @brief 从归档中恢复日志(point-in-time recovery)
+ * @ingroup CLog
+ * @details 基础备份是在某个时刻复制的数据目录，它的数据页面可能包含直到它的日志结尾的修改。
+ * 恢复时先把归档的段文件复制到基础备份的日志目录中，补齐基础备份之后的日志，
+ * 再找到目标位置，把之后的日志截断。之后正常打开数据库，由 CLogManager::recover 重做日志，
+ * 回滚在目标位置还没有提交的事务。
+ * 目标位置不能早于基础备份的日志结尾，否则基础备份中的页面可能已经包含了之后的修改。
+ */
+class CLogRestorer
+{
+public:
+  /**
+   * @param archive_path 归档目录
+   * @param log_path     基础备份的日志目录，也就是数据库的目录
+   */
+  CLogRestorer(const char *archive_path, const char *log_path);
+
+  /**
+   * @brief 恢复到这个LSN之前，也就是丢弃LSN不小于它的日志
+   */
+  void set_target_lsn(int64_t lsn) { target_lsn_ = lsn; }
+
+  /**
+   * @brief 恢复到这个提交号为止，提交号比它大的事务都不再提交
+   */
+  void set_target_xid(int64_t xid) { target_xid_ = xid; }
+
+  /**
+   * @brief 检查归档，复制段文件，截断目标位置之后的日志
+   */
+  RC restore();
+
+  /**
+   * @brief 恢复之后日志结束的位置
+   */
+  int64_t stop_lsn() const { return stop_lsn_; }
+
+  /**
+   * @brief 恢复到的最后一个事务的提交号，没有提交的事务时是-1
+   */
+  int64_t last_commit_xid() const { return last_commit_xid_; }
+
+private:
+  RC verify_archive(const CLogArchiveManifest &manifest);
+  RC copy_segments(const CLogArchiveManifest &manifest, int64_t base_end_lsn);
+  RC find_stop_lsn(CLogFile &log_file, int64_t start_lsn);
+
+private:
+  std::string archive_path_;
+  std::string log_path_;
+  int64_t     target_lsn_      = INT64_MAX;
+  int64_t     target_xid_      = INT64_MAX;
+  int64_t     stop_lsn_        = -1;
+  int64_t     last_commit_xid_ = -1;
+};
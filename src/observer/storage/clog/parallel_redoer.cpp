@@ -0,0 +1,158 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include "storage/clog/parallel_redoer.h"
+#include "common/log/log.h"
+#include "storage/clog/clog.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+ParallelRedoer::ParallelRedoer(Db *db, int worker_num) : db_(db), worker_num_(worker_num) {}
+
+ParallelRedoer::~ParallelRedoer() { stop(); }
+
+RC ParallelRedoer::start()
+{
+  if (worker_num_ <= 0) {
+    LOG_WARN("invalid redo worker num. worker num=%d", worker_num_);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  for (int i = 0; i < worker_num_; i++) {
+    workers_.emplace_back(make_unique<Worker>());
+    Worker &worker = *workers_.back();
+    worker.thread  = thread(&ParallelRedoer::run, this, std::ref(worker));
+  }
+  LOG_INFO("parallel redo started. worker num=%d", worker_num_);
+  return RC::SUCCESS;
+}
+
+void ParallelRedoer::stop()
+{
+  for (unique_ptr<Worker> &worker : workers_) {
+    {
+      lock_guard<mutex> guard(worker->lock);
+      worker->stopped = true;
+    }
+    worker->cond.notify_all();
+  }
+
+  for (unique_ptr<Worker> &worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+  workers_.clear();
+}
+
+RC ParallelRedoer::dispatch(Trx *trx, CLogRecord *log_record)
+{
+  unique_ptr<CLogRecord> log_record_guard(log_record);
+  if (workers_.empty()) {
+    LOG_WARN("parallel redoer is not started");
+    return RC::INTERNAL;
+  }
+
+  // 同一个页面的日志总是交给同一个线程，保证它们按照日志的顺序重做
+  const CLogRecordData &data_record = log_record->data_record();
+  const uint64_t        page_key    = (static_cast<uint64_t>(static_cast<uint32_t>(data_record.table_id_)) << 32) |
+                             static_cast<uint32_t>(data_record.rid_.page_num);
+  Worker &worker = *workers_[hash<uint64_t>()(page_key) % workers_.size()];
+
+  worker.batch.push_back(Task{trx, std::move(log_record_guard)});
+  if (worker.batch.size() >= BATCH_SIZE) {
+    submit_batch(worker);
+  }
+  return RC::SUCCESS;
+}
+
+RC ParallelRedoer::barrier()
+{
+  for (unique_ptr<Worker> &worker : workers_) {
+    submit_batch(*worker);
+  }
+
+  unique_lock<mutex> lock(finish_lock_);
+  finish_cond_.wait(lock, [this]() { return pending_num_ == 0; });
+  return rc_;
+}
+
+void ParallelRedoer::submit_batch(Worker &worker)
+{
+  if (worker.batch.empty()) {
+    return;
+  }
+
+  // 先计数再交给工作线程，否则工作线程可能在计数之前就做完了
+  {
+    lock_guard<mutex> guard(finish_lock_);
+    pending_num_ += static_cast<int64_t>(worker.batch.size());
+  }
+
+  {
+    unique_lock<mutex> lock(worker.lock);
+    worker.cond.wait(lock, [&worker]() { return worker.tasks.size() < MAX_QUEUE_SIZE; });
+    for (Task &task : worker.batch) {
+      worker.tasks.push_back(std::move(task));
+    }
+  }
+  worker.batch.clear();
+  worker.cond.notify_all();
+}
+
+void ParallelRedoer::run(Worker &worker)
+{
+  vector<Task> tasks;
+  while (true) {
+    {
+      unique_lock<mutex> lock(worker.lock);
+      worker.cond.wait(lock, [&worker]() { return worker.stopped || !worker.tasks.empty(); });
+      if (worker.tasks.empty()) {
+        break;
+      }
+      tasks.swap(worker.tasks);
+    }
+    worker.cond.notify_all();
+
+    RC rc = RC::SUCCESS;
+    {
+      lock_guard<mutex> guard(finish_lock_);
+      rc = rc_;
+    }
+    for (Task &task : tasks) {
+      if (OB_FAIL(rc)) {
+        break;
+      }
+      rc = task.trx->redo(db_, *task.log_record);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to redo log record. log_record={%s}, rc=%s", task.log_record->to_string().c_str(), strrc(rc));
+      }
+    }
+    finish_tasks(static_cast<int64_t>(tasks.size()), rc);
+    tasks.clear();
+  }
+}
+
+void ParallelRedoer::finish_tasks(int64_t task_num, RC rc)
+{
+  lock_guard<mutex> guard(finish_lock_);
+  if (OB_FAIL(rc) && OB_SUCC(rc_)) {
+    rc_ = rc;
+  }
+  pending_num_ -= task_num;
+  if (pending_num_ == 0) {
+    finish_cond_.notify_all();
+  }
+}
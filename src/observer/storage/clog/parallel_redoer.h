@@ -0,0 +1,100 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/rc.h"
+
+class CLogRecord;
+class Db;
+class Trx;
+
+/**
+ * @brief 并行重做日志
+ * @ingroup CLog
+ * @details 恢复时由读日志的线程把数据日志按照 (table_id, page_num) 分发给多个工作线程，
+ * 同一个页面上的日志总是由同一个线程按照日志的顺序重做。
+ * 事务提交和回滚会修改多个页面，读日志的线程在重做它们之前要调用 barrier，
+ * 等所有已经分发的日志都重做完成。
+ */
+class ParallelRedoer
+{
+public:
+  /**
+   * @param worker_num 工作线程的个数
+   */
+  ParallelRedoer(Db *db, int worker_num);
+  ~ParallelRedoer();
+
+  RC start();
+
+  /**
+   * @brief 停止工作线程
+   * @details 已经交给工作线程的日志会先重做完，还没有攒够一批的日志直接丢弃
+   */
+  void stop();
+
+  /**
+   * @brief 分发一条数据日志，由工作线程调用 trx->redo 重做
+   * @details 日志对象由重做器负责释放。日志先攒成一批再交给工作线程，工作线程的队列满了时会等待
+   */
+  RC dispatch(Trx *trx, CLogRecord *log_record);
+
+  /**
+   * @brief 等待已经分发的日志都重做完成
+   * @return 重做时遇到的第一个错误。出错之后分发的日志都不会再重做
+   */
+  RC barrier();
+
+private:
+  struct Task
+  {
+    Trx                        *trx = nullptr;
+    std::unique_ptr<CLogRecord> log_record;
+  };
+
+  struct Worker
+  {
+    std::mutex              lock;
+    std::condition_variable cond;  ///< 队列有新的任务、队列有空位或者需要停止时通知
+    std::vector<Task>       tasks;
+    bool                    stopped = false;
+    std::thread             thread;
+
+    std::vector<Task> batch;  ///< 分发线程攒的一批任务，不需要加锁
+  };
+
+  void submit_batch(Worker &worker);
+  void run(Worker &worker);
+  void finish_tasks(int64_t task_num, RC rc);
+
+private:
+  static constexpr size_t BATCH_SIZE     = 64;    ///< 每次交给工作线程的日志数
+  static constexpr size_t MAX_QUEUE_SIZE = 4096;  ///< 每个工作线程最多缓存的日志数
+
+  Db                                  *db_         = nullptr;
+  int                                  worker_num_ = 0;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::mutex              finish_lock_;
+  std::condition_variable finish_cond_;        ///< 所有分发的日志都重做完成时通知
+  int64_t                 pending_num_ = 0;    ///< 已经分发还没有重做完成的日志数
+  RC                      rc_          = RC::SUCCESS;  ///< 重做时遇到的第一个错误
+};
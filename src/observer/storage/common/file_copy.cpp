@@ -0,0 +1,155 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include "storage/common/file_copy.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+/// 不能使用 copy_file_range 时，每次读写的数据量
+static const int64_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+/// 复制文件时每次复制的数据量，每块之间检查一次限速
+static const int64_t COPY_CHUNK_SIZE = 4 * 1024 * 1024;
+
+IoThrottle::IoThrottle(int64_t bytes_per_second)
+    : bytes_per_second_(bytes_per_second), start_time_(chrono::steady_clock::now())
+{}
+
+void IoThrottle::acquire(int64_t bytes)
+{
+  total_bytes_ += bytes;
+  if (bytes_per_second_ <= 0) {
+    return;
+  }
+
+  // 按照限速，复制这么多数据至少需要的时间
+  const auto expected = chrono::microseconds(total_bytes_ * 1000000 / bytes_per_second_);
+  const auto elapsed  = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time_);
+  if (expected > elapsed) {
+    this_thread::sleep_for(expected - elapsed);
+  }
+}
+
+static RC copy_file_data_by_pread(int src_fd, int dst_fd, int64_t offset, int64_t length)
+{
+  unique_ptr<char[]> buffer(new char[COPY_BUFFER_SIZE]);
+  while (length > 0) {
+    const size_t read_len = static_cast<size_t>(min(length, COPY_BUFFER_SIZE));
+    ssize_t      ret      = ::pread(src_fd, buffer.get(), read_len, static_cast<off_t>(offset));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      LOG_WARN("failed to read file. fd=%d, offset=%ld, ret=%d, error=%s",
+               src_fd, static_cast<long>(offset), static_cast<int>(ret), strerror(errno));
+      return RC::IOERR_READ;
+    }
+
+    ssize_t written = 0;
+    while (written < ret) {
+      ssize_t w = ::pwrite(dst_fd, buffer.get() + written, ret - written, static_cast<off_t>(offset + written));
+      if (w < 0 && errno == EINTR) {
+        continue;
+      }
+      if (w <= 0) {
+        LOG_WARN("failed to write file. fd=%d, offset=%ld, error=%s",
+                 dst_fd, static_cast<long>(offset + written), strerror(errno));
+        return RC::IOERR_WRITE;
+      }
+      written += w;
+    }
+
+    offset += ret;
+    length -= ret;
+  }
+  return RC::SUCCESS;
+}
+
+RC copy_file_data(int src_fd, int dst_fd, int64_t offset, int64_t length)
+{
+  loff_t src_offset = static_cast<loff_t>(offset);
+  loff_t dst_offset = static_cast<loff_t>(offset);
+  while (length > 0) {
+    ssize_t ret = ::copy_file_range(src_fd, &src_offset, dst_fd, &dst_offset, static_cast<size_t>(length), 0);
+    if (ret > 0) {
+      length -= ret;
+      continue;
+    }
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+
+    // 内核或者文件系统不支持(比如跨文件系统的老内核)，剩下的数据用普通的读写复制
+    if (ret < 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)) {
+      return copy_file_data_by_pread(src_fd, dst_fd, static_cast<int64_t>(src_offset), length);
+    }
+
+    LOG_WARN("failed to copy file data. src fd=%d, dst fd=%d, offset=%ld, ret=%d, error=%s",
+             src_fd, dst_fd, static_cast<long>(src_offset), static_cast<int>(ret), strerror(errno));
+    return RC::IOERR_READ;
+  }
+  return RC::SUCCESS;
+}
+
+RC copy_file(const string &src, const string &dst, IoThrottle *throttle, int64_t &copied_bytes)
+{
+  int src_fd = ::open(src.c_str(), O_RDONLY);
+  if (src_fd < 0) {
+    LOG_WARN("failed to open file. file=%s, error=%s", src.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  int dst_fd = ::open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (dst_fd < 0) {
+    LOG_WARN("failed to create file. file=%s, error=%s", dst.c_str(), strerror(errno));
+    ::close(src_fd);
+    return RC::IOERR_OPEN;
+  }
+
+  RC          rc = RC::SUCCESS;
+  struct stat st;
+  if (::fstat(src_fd, &st) != 0) {
+    LOG_WARN("failed to stat file. file=%s, error=%s", src.c_str(), strerror(errno));
+    rc = RC::IOERR_ACCESS;
+  }
+
+  for (int64_t offset = 0; OB_SUCC(rc) && offset < st.st_size; offset += COPY_CHUNK_SIZE) {
+    const int64_t length = min(COPY_CHUNK_SIZE, static_cast<int64_t>(st.st_size) - offset);
+    rc                   = copy_file_data(src_fd, dst_fd, offset, length);
+    if (OB_SUCC(rc)) {
+      copied_bytes += length;
+      if (throttle != nullptr) {
+        throttle->acquire(length);
+      }
+    }
+  }
+
+  if (OB_SUCC(rc) && ::fsync(dst_fd) != 0) {
+    LOG_WARN("failed to sync file. file=%s, error=%s", dst.c_str(), strerror(errno));
+    rc = RC::IOERR_SYNC;
+  }
+
+  ::close(src_fd);
+  ::close(dst_fd);
+  return rc;
+}
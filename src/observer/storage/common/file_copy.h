@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <string>
+
+#include "common/rc.h"
+
+/**
+ * @brief 限制读写文件的速度
+ * @details 在线备份时复制文件会占用磁盘带宽，用它限制每秒复制的字节数，减少对正在运行的事务的影响。
+ * 每复制一块数据调用一次 acquire，超出速度限制时睡眠等待
+ */
+class IoThrottle
+{
+public:
+  /**
+   * @param bytes_per_second 每秒最多读写的字节数，不大于0表示不限制
+   */
+  explicit IoThrottle(int64_t bytes_per_second);
+
+  /**
+   * @brief 记录已经读写了 bytes 字节，如果超过了速度限制就等待
+   * @note 不要在持有锁的时候调用
+   */
+  void acquire(int64_t bytes);
+
+  int64_t total_bytes() const { return total_bytes_; }
+
+private:
+  int64_t                               bytes_per_second_ = 0;
+  int64_t                               total_bytes_      = 0;
+  std::chrono::steady_clock::time_point start_time_;
+};
+
+/**
+ * @brief 把文件 src_fd 中 [offset, offset + length) 的数据复制到 dst_fd 的相同位置
+ * @details 优先使用 copy_file_range，数据不需要经过用户态，同一个文件系统上还可能直接共享数据块。
+ * 不支持时退化成大块的 pread/pwrite。不会修改两个文件的读写位置
+ */
+RC copy_file_data(int src_fd, int dst_fd, int64_t offset, int64_t length);
+
+/**
+ * @brief 复制整个文件，不存在的目标文件会被创建，已经存在的会被覆盖
+ * @param throttle 限速，可以为空
+ * @param copied_bytes 累加复制的字节数
+ */
+RC copy_file(const std::string &src, const std::string &dst, IoThrottle *throttle, int64_t &copied_bytes);
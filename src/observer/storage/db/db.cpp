@@ -15,20 +15,34 @@ See the Mulan PSL v2 for more details. */
 #include "storage/db/db.h"
 
 #include <fcntl.h>
+#include <string.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #include <vector>
 
+#include "common/global_context.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
 #include "common/os/path.h"
 #include "storage/clog/clog.h"
 #include "storage/common/meta_util.h"
+#include "storage/db/db_backup.h"
 #include "storage/table/table.h"
 #include "storage/table/table_meta.h"
+#include "storage/table/table_vacuum.h"
 #include "storage/trx/trx.h"
 
 Db::~Db()
 {
+  {
+    std::lock_guard<std::mutex> guard(autovacuum_lock_);
+    autovacuum_stopped_ = true;
+  }
+  autovacuum_cond_.notify_all();
+  if (autovacuum_thread_.joinable()) {
+    autovacuum_thread_.join();
+  }
+
   for (auto &iter : opened_tables_) {
     delete iter.second;
   }
@@ -58,6 +72,17 @@ RC Db::init(const char *name, const char *dbpath)
     LOG_WARN("failed to init clog manager. dbpath=%s, rc=%s", dbpath, strrc(rc));
     return rc;
   }
+  clog_manager_->set_redo_worker_num(GCTX.redo_worker_num_);
+
+  // 每个数据库的日志归档到归档目录下以数据库命名的子目录中
+  if (!GCTX.clog_archive_path_.empty()) {
+    std::string archive_path = GCTX.clog_archive_path_ + common::FILE_PATH_SPLIT_STR + name;
+    rc = clog_manager_->enable_archive(archive_path.c_str());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to enable clog archive. archive path=%s, rc=%s", archive_path.c_str(), strrc(rc));
+      return rc;
+    }
+  }
 
   name_ = name;
   path_ = dbpath;
@@ -73,12 +98,51 @@ RC Db::init(const char *name, const char *dbpath)
     LOG_WARN("failed to recover db. dbpath=%s, rc=%s", dbpath, strrc(rc));
     return rc;
   }
+
+  rc = rebuild_indexes_if_restored();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to rebuild indexes of restored db. dbpath=%s, rc=%s", dbpath, strrc(rc));
+    return rc;
+  }
   return rc;
 }
 
-RC Db::create_table(const char *table_name, int attribute_count, const AttrInfoSqlNode *attributes)
+RC Db::rebuild_indexes_if_restored()
 {
+  const std::string label_file = path_ + common::FILE_PATH_SPLIT_STR + DbBackup::LABEL_FILE_NAME;
+  if (access(label_file.c_str(), F_OK) != 0) {
+    return RC::SUCCESS;
+  }
+
   RC rc = RC::SUCCESS;
+  for (const auto &table_pair : opened_tables_) {
+    rc = table_pair.second->rebuild_indexes();
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("failed to rebuild indexes. table=%s, rc=%s", table_pair.first.c_str(), strrc(rc));
+      return rc;
+    }
+  }
+
+  // 索引页面没有日志，先写到磁盘再改名标签文件。改名之前宕机的话，下次启动时会再重建一次
+  rc = sync();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const std::string used_label_file = label_file + DbBackup::USED_LABEL_SUFFIX;
+  if (rename(label_file.c_str(), used_label_file.c_str()) != 0) {
+    LOG_ERROR("failed to rename backup label file. file=%s, error=%s", label_file.c_str(), strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+  LOG_INFO("rebuild indexes of restored db done. db=%s, tables=%d", name_.c_str(), static_cast<int>(opened_tables_.size()));
+  return rc;
+}
+
+RC Db::create_table(
+    const char *table_name, int attribute_count, const AttrInfoSqlNode *attributes, StorageFormat storage_format)
+{
+  RC rc = RC::SUCCESS;
+  std::lock_guard<std::mutex> guard(vacuum_lock_);
   // check table_name
   if (opened_tables_.count(table_name) != 0) {
     LOG_WARN("%s has been opened before.", table_name);
@@ -89,7 +153,8 @@ RC Db::create_table(const char *table_name, int attribute_count, const AttrInfoS
   std::string table_file_path = table_meta_file(path_.c_str(), table_name);
   Table      *table           = new Table();
   int32_t     table_id        = next_table_id_++;
-  rc = table->create(table_id, table_file_path.c_str(), table_name, path_.c_str(), attribute_count, attributes);
+  rc = table->create(
+      table_id, table_file_path.c_str(), table_name, path_.c_str(), attribute_count, attributes, storage_format);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to create table %s.", table_name);
     delete table;
@@ -102,11 +167,15 @@ RC Db::create_table(const char *table_name, int attribute_count, const AttrInfoS
 }
 
 RC Db::drop_table(const char* table_name) {
+  std::lock_guard<std::mutex> guard(vacuum_lock_);
   auto it = opened_tables_.find(table_name);
   if (it == opened_tables_.end()) {
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
   Table* table = it->second;
+  // 改写事务号时会访问表上的记录，要在删除表文件之前去掉
+  TrxKit::instance()->remove_table_versions(table->table_id());
+
   RC rc = table->destroy(path_.c_str());
   if (rc != RC::SUCCESS) return rc;
 
@@ -192,10 +261,135 @@ RC Db::sync()
     }
     LOG_INFO("Successfully sync table db:%s, table:%s.", name_.c_str(), table->name());
   }
+
+  rc = clog_manager_->checkpoint(this);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to do checkpoint. db=%s, rc=%s", name_.c_str(), strrc(rc));
+    return rc;
+  }
   LOG_INFO("Successfully sync db. db=%s", name_.c_str());
   return rc;
 }
 
+RC Db::flush_pages_before(LSN lsn, LSN &min_rec_lsn)
+{
+  RC rc = RC::SUCCESS;
+  for (const auto &table_pair : opened_tables_) {
+    rc = table_pair.second->flush_pages_before(lsn, min_rec_lsn);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("Failed to flush pages of table. table=%s.%s, rc=%s", name_.c_str(), table_pair.first.c_str(), strrc(rc));
+      return rc;
+    }
+  }
+  return rc;
+}
+
 RC Db::recover() { return clog_manager_->recover(this); }
 
-CLogManager *Db::clog_manager() { return clog_manager_.get(); }
\ No newline at end of file
+CLogManager *Db::clog_manager() { return clog_manager_.get(); }
+
+RC Db::vacuum(const char *table_name, VacuumStat &stat)
+{
+  std::lock_guard<std::mutex> guard(vacuum_lock_);
+
+  Table *table = find_table(table_name);
+  if (nullptr == table) {
+    LOG_WARN("no such table to vacuum. table=%s", table_name);
+    return RC::SCHEMA_TABLE_NOT_EXIST;
+  }
+
+  // 只读表的数据文件映射到了内存中，不能修改
+  if (table->table_meta().read_only()) {
+    LOG_INFO("skip vacuuming read only table. table=%s", table_name);
+    return RC::SUCCESS;
+  }
+
+  TableVacuum table_vacuum(table, *TrxKit::instance(), clog_manager_.get());
+  return table_vacuum.run(stat);
+}
+
+RC Db::set_table_read_only(const char *table_name, bool read_only)
+{
+  std::lock_guard<std::mutex> guard(vacuum_lock_);
+
+  Table *table = find_table(table_name);
+  if (nullptr == table) {
+    LOG_WARN("no such table. table=%s", table_name);
+    return RC::SCHEMA_TABLE_NOT_EXIST;
+  }
+
+  // 没有其它事务时，所有的修改都已经提交并且在buffer pool中，刷盘之后磁盘上的数据就是完整的
+  TrxKit *trx_kit = TrxKit::instance();
+  Trx    *trx     = trx_kit->create_trx(clog_manager_.get());
+  if (nullptr == trx) {
+    LOG_WARN("failed to create trx. table=%s", table_name);
+    return RC::NOMEM;
+  }
+
+  if (!trx_kit->begin_exclusive(trx)) {
+    LOG_WARN("cannot change table read only state because other transactions are running. table=%s", table_name);
+    trx_kit->destroy_trx(trx);
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  RC rc = table->set_read_only(read_only);
+
+  trx_kit->end_exclusive(trx);
+  trx_kit->destroy_trx(trx);
+  return rc;
+}
+
+RC Db::backup(const char *path, BackupStat &stat)
+{
+  // 备份期间表的集合和元数据不能变化，整理表也会修改没有日志的页面，都要等备份结束
+  std::lock_guard<std::mutex> guard(vacuum_lock_);
+
+  const int64_t bytes_per_second = static_cast<int64_t>(backup_rate_limit_mb_.load()) * 1024 * 1024;
+  DbBackup      db_backup(this, clog_manager_.get(), path, bytes_per_second);
+  return db_backup.run(stat);
+}
+
+void Db::set_autovacuum_interval(int seconds)
+{
+  std::lock_guard<std::mutex> guard(autovacuum_lock_);
+  autovacuum_interval_ = seconds;
+  if (seconds > 0 && !autovacuum_thread_.joinable()) {
+    autovacuum_thread_ = std::thread(&Db::autovacuum_loop, this);
+  }
+  autovacuum_cond_.notify_all();
+  LOG_INFO("set autovacuum interval to %d seconds. db=%s", seconds, name_.c_str());
+}
+
+void Db::autovacuum_loop()
+{
+  std::unique_lock<std::mutex> guard(autovacuum_lock_);
+  while (!autovacuum_stopped_) {
+    if (autovacuum_interval_ <= 0) {
+      autovacuum_cond_.wait(guard);
+      continue;
+    }
+
+    // 被唤醒说明间隔修改了或者要退出了，重新等待
+    if (autovacuum_cond_.wait_for(guard, std::chrono::seconds(autovacuum_interval_)) == std::cv_status::no_timeout) {
+      continue;
+    }
+
+    guard.unlock();
+
+    std::vector<std::string> table_names;
+    {
+      std::lock_guard<std::mutex> vacuum_guard(vacuum_lock_);
+      all_tables(table_names);
+    }
+
+    for (const std::string &table_name : table_names) {
+      VacuumStat stat;
+      RC         rc = vacuum(table_name.c_str(), stat);
+      if (OB_FAIL(rc) && rc != RC::SCHEMA_TABLE_NOT_EXIST) {
+        LOG_WARN("failed to vacuum table in background. table=%s, rc=%s", table_name.c_str(), strrc(rc));
+      }
+    }
+
+    guard.lock();
+  }
+}
\ No newline at end of file
@@ -14,16 +14,23 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
-#include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
-#include <memory>
+#include <vector>
 
 #include "common/rc.h"
+#include "common/types.h"
 #include "sql/parser/parse_defs.h"
 
 class Table;
 class CLogManager;
+struct VacuumStat;
+struct BackupStat;
 
 /**
  * @brief 一个DB实例负责管理一批表
@@ -45,7 +52,8 @@ public:
    */
   RC init(const char *name, const char *dbpath);
 
-  RC create_table(const char *table_name, int attribute_count, const AttrInfoSqlNode *attributes);
+  RC create_table(const char *table_name, int attribute_count, const AttrInfoSqlNode *attributes,
+      StorageFormat storage_format = StorageFormat::ROW_FORMAT);
   RC drop_table(const char *table_name);
 
   Table *find_table(const char *table_name) const;
@@ -55,21 +63,76 @@ public:
 
   void all_tables(std::vector<std::string> &table_names) const;
 
+  /**
+   * @brief 把所有表的数据写到磁盘，然后做一次 checkpoint
+   */
   RC sync();
 
+  /**
+   * @brief checkpoint时刷新所有表的页面，参考 DiskBufferPool::flush_pages_before
+   */
+  RC flush_pages_before(LSN lsn, LSN &min_rec_lsn);
+
   RC recover();
 
   CLogManager *clog_manager();
 
+  /**
+   * @brief 整理指定的表，回收被删除的记录占用的空间
+   * @details 同一时间只有一个整理任务在运行。整理的过程参考 TableVacuum
+   */
+  RC vacuum(const char *table_name, VacuumStat &stat);
+
+  /**
+   * @brief 设置后台自动整理所有表的时间间隔
+   * @param seconds 间隔的秒数，0表示不自动整理
+   */
+  void set_autovacuum_interval(int seconds);
+
+  /**
+   * @brief 设置表是否只读
+   * @details 只读的表扫描时直接读取映射到内存的数据文件。切换时不能有其它事务在运行，
+   * 否则返回 RC::LOCKED_CONCURRENCY_CONFLICT
+   */
+  RC set_table_read_only(const char *table_name, bool read_only);
+
+  /**
+   * @brief 在线备份数据库到指定的目录
+   * @details 备份期间可以继续读写数据，但是不能执行DDL和VACUUM。过程参考 DbBackup
+   */
+  RC backup(const char *path, BackupStat &stat);
+
+  /**
+   * @brief 设置备份时复制文件的速度上限(MB/s)，0表示不限制
+   */
+  void set_backup_rate_limit(int mb_per_second) { backup_rate_limit_mb_.store(mb_per_second); }
+
 private:
   RC open_all_tables();
 
+  /**
+   * @brief 从在线备份启动时，恢复完数据以后重新建立所有的索引
+   * @details 目录下有备份标签文件说明是从备份启动的，参考 DbBackup。建立完成后把标签文件改名，以后启动时不再重建
+   */
+  RC rebuild_indexes_if_restored();
+
+  void autovacuum_loop();
+
 private:
   std::string                              name_;
   std::string                              path_;
   std::unordered_map<std::string, Table *> opened_tables_;
   std::unique_ptr<CLogManager>             clog_manager_;
 
+  std::mutex              vacuum_lock_;  ///< 整理表时不能同时创建或删除表
+  std::mutex              autovacuum_lock_;
+  std::condition_variable autovacuum_cond_;
+  int                     autovacuum_interval_ = 0;      ///< 后台自动整理的间隔(秒)，0表示不自动整理
+  bool                    autovacuum_stopped_  = false;
+  std::thread             autovacuum_thread_;
+
+  std::atomic_int backup_rate_limit_mb_{0};  ///< 备份时复制文件的速度上限(MB/s)，0表示不限制
+
   /// 给每个table都分配一个ID，用来记录日志。这里假设所有的DDL都不会并发操作，所以相关的数据都不上锁
   int32_t next_table_id_ = 0;
 };
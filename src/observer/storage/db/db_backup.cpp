@@ -0,0 +1,147 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+#include "storage/db/db_backup.h"
+#include "common/io/io.h"
+#include "common/log/log.h"
+#include "common/os/path.h"
+#include "storage/clog/clog.h"
+#include "storage/common/file_copy.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+
+using namespace std;
+
+const char *DbBackup::LABEL_FILE_NAME   = "backup_label";
+const char *DbBackup::USED_LABEL_SUFFIX = ".old";
+
+RC DbBackup::run(BackupStat &stat)
+{
+  const auto begin_time = chrono::steady_clock::now();
+
+  RC rc = prepare_dest_path();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 先保留所有的日志，checkpoint 完成之后再缩小到它的 redo LSN，避免中间有其它 checkpoint 删除需要的日志
+  log_manager_->retain_log(0);
+  rc = log_manager_->checkpoint(db_, &stat.checkpoint_lsn, &stat.redo_lsn);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to do checkpoint before backup. rc=%s", strrc(rc));
+    log_manager_->release_log();
+    return rc;
+  }
+  log_manager_->retain_log(stat.redo_lsn);
+
+  IoThrottle     throttle(bytes_per_second_);
+  vector<string> table_names;
+  db_->all_tables(table_names);
+  for (const string &table_name : table_names) {
+    Table *table = db_->find_table(table_name.c_str());
+    rc           = table->backup(dest_path_.c_str(), &throttle, stat.data_bytes);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to backup table. table=%s, rc=%s", table_name.c_str(), strrc(rc));
+      break;
+    }
+    stat.tables++;
+  }
+
+  if (OB_SUCC(rc)) {
+    rc = log_manager_->backup_log(
+        dest_path_.c_str(), stat.redo_lsn, stat.checkpoint_lsn, &throttle, stat.end_lsn, stat.log_bytes);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to backup clog. rc=%s", strrc(rc));
+    }
+  }
+  log_manager_->release_log();
+
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  stat.elapsed_ms =
+      chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - begin_time).count();
+  rc = write_label(stat);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  LOG_INFO("backup done. db=%s, dest=%s, tables=%d, data bytes=%ld, log bytes=%ld, "
+           "checkpoint lsn=%ld, redo lsn=%ld, end lsn=%ld, elapsed=%ldms",
+           db_->name(), dest_path_.c_str(), stat.tables, static_cast<long>(stat.data_bytes),
+           static_cast<long>(stat.log_bytes), static_cast<long>(stat.checkpoint_lsn),
+           static_cast<long>(stat.redo_lsn), static_cast<long>(stat.end_lsn), static_cast<long>(stat.elapsed_ms));
+  return RC::SUCCESS;
+}
+
+RC DbBackup::prepare_dest_path()
+{
+  if (!common::check_directory(dest_path_)) {
+    LOG_WARN("failed to create backup directory. path=%s", dest_path_.c_str());
+    return RC::IOERR_ACCESS;
+  }
+
+  // 不能覆盖已有的文件，否则备份里可能混进其它数据库或者上一次备份的文件
+  vector<string> files;
+  if (common::list_file(dest_path_.c_str(), ".*", files) < 0) {
+    LOG_WARN("failed to list backup directory. path=%s", dest_path_.c_str());
+    return RC::IOERR_ACCESS;
+  }
+  if (!files.empty()) {
+    LOG_WARN("backup directory is not empty. path=%s, files=%d", dest_path_.c_str(), static_cast<int>(files.size()));
+    return RC::FILE_EXIST;
+  }
+  return RC::SUCCESS;
+}
+
+RC DbBackup::write_label(const BackupStat &stat)
+{
+  stringstream ss;
+  ss << "db: " << db_->name() << "\n"
+     << "checkpoint_lsn: " << stat.checkpoint_lsn << "\n"
+     << "redo_lsn: " << stat.redo_lsn << "\n"
+     << "end_lsn: " << stat.end_lsn << "\n"
+     << "tables: " << stat.tables << "\n";
+
+  const string filename = dest_path_ + "/" + LABEL_FILE_NAME;
+  const string content  = ss.str();
+  int          fd       = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    LOG_WARN("failed to create backup label file. file=%s, error=%s", filename.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  int ret = common::writen(fd, content.data(), static_cast<int>(content.size()));
+  if (ret != 0 || fsync(fd) != 0) {
+    LOG_WARN("failed to write backup label file. file=%s, error=%s", filename.c_str(), strerror(errno));
+    ::close(fd);
+    return RC::IOERR_WRITE;
+  }
+  ::close(fd);
+
+  // 目录中新建的文件都要在目录落盘之后才算持久化
+  int dir_fd = ::open(dest_path_.c_str(), O_RDONLY);
+  if (dir_fd >= 0) {
+    (void)fsync(dir_fd);
+    ::close(dir_fd);
+  }
+  return RC::SUCCESS;
+}
@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "common/rc.h"
+
+class Db;
+class CLogManager;
+
+/**
+ * @brief 一次在线备份的结果
+ */
+struct BackupStat
+{
+  int     tables         = 0;  ///< 备份的表的个数
+  int64_t data_bytes     = 0;  ///< 复制的表数据和元数据文件的字节数
+  int64_t log_bytes      = 0;  ///< 复制的日志的字节数
+  int64_t checkpoint_lsn = 0;  ///< 备份开始时做的 checkpoint 日志的位置
+  int64_t redo_lsn       = 0;  ///< 从备份启动时开始重做的位置
+  int64_t end_lsn        = 0;  ///< 复制的日志的结尾，从备份启动时会重做到这里
+  int64_t elapsed_ms     = 0;  ///< 备份花费的时间
+};
+
+/**
+ * @brief 在线备份(hot copy)一个数据库
+ * @details 备份期间其它事务可以继续读写，只是不能执行DDL和VACUUM。过程如下：
+ * 1. 做一次 checkpoint，之前修改的页面都已经写到磁盘。从 checkpoint 的 redo LSN 开始的日志会被保留，
+ *    之后的 checkpoint 不会删除它们；
+ * 2. 依次复制每张表的元数据和数据文件。复制的是磁盘上的文件，页面可能是 checkpoint 之后任意时刻的版本，
+ *    但是一定不会比 checkpoint 更旧，并且它们的日志都已经落盘。索引页面没有日志，复制到的索引文件可能是
+ *    分裂到一半的B+树，所以不复制索引文件，只创建空的索引；
+ * 3. 把日志刷到磁盘，复制 [redo LSN, 落盘位置) 之间的日志，并写一个指向 checkpoint 的控制文件。
+ *    所有页面的修改都包含在这段日志中，重做时LSN不大于页面LSN的日志会被跳过，所以各个页面都会恢复到同一个时刻；
+ * 4. 写一个 backup_label 文件，记录备份的日志范围。
+ * 使用备份时直接把备份目录当做数据库目录启动，启动时的恢复流程会把数据重做到备份结束时的状态，
+ * 没有提交的事务会被回滚。之后发现目录下有 backup_label，就用数据文件重新建立所有的索引，
+ * 完成以后 backup_label 改名为 backup_label.old，参考 Db::init。
+ */
+class DbBackup
+{
+public:
+  /**
+   * @param dest_path        备份目录，不存在时会创建，已经存在时必须是空的
+   * @param bytes_per_second 复制文件的速度限制，不大于0表示不限制
+   */
+  DbBackup(Db *db, CLogManager *log_manager, const char *dest_path, int64_t bytes_per_second)
+      : db_(db), log_manager_(log_manager), dest_path_(dest_path), bytes_per_second_(bytes_per_second)
+  {}
+
+  RC run(BackupStat &stat);
+
+  static const char *LABEL_FILE_NAME;
+  static const char *USED_LABEL_SUFFIX;  ///< 从备份启动并重建索引以后，标签文件加上这个后缀
+
+private:
+  RC prepare_dest_path();
+  RC write_label(const BackupStat &stat);
+
+private:
+  Db          *db_          = nullptr;
+  CLogManager *log_manager_ = nullptr;
+  std::string  dest_path_;
+  int64_t      bytes_per_second_ = 0;
+};
@@ -0,0 +1,433 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "storage/db/db_xid_upgrade.h"
+#include "common/log/log.h"
+#include "common/os/path.h"
+#include "storage/clog/clog.h"
+#include "storage/common/meta_util.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/xid.h"
+
+using namespace std;
+
+const char *DbXidUpgrade::UPGRADE_DIR_NAME = "xid_upgrade";
+const char *DbXidUpgrade::DONE_FILE_NAME   = "DONE";
+
+/**
+ * @brief 把文件或者目录的内容刷到磁盘
+ */
+static RC sync_path(const string &path, bool directory)
+{
+  int fd = ::open(path.c_str(), directory ? O_RDONLY : O_RDWR);
+  if (fd < 0) {
+    LOG_WARN("failed to open file to sync. file=%s, error=%s", path.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  if (fsync(fd) != 0) {
+    LOG_WARN("failed to sync file. file=%s, error=%s", path.c_str(), strerror(errno));
+    ::close(fd);
+    return RC::IOERR_SYNC;
+  }
+  ::close(fd);
+  return RC::SUCCESS;
+}
+
+string DbXidUpgrade::upgrade_dir() const { return db_path_ + "/" + UPGRADE_DIR_NAME; }
+
+RC DbXidUpgrade::upgrade()
+{
+  // 上次升级可能在移动文件的过程中失败了，先把它做完
+  RC rc = finish_table();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = check_log();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  if (log_upgraded_) {
+    // 新的 checkpoint 在所有的表改写完之后才写入
+    LOG_INFO("database has already been upgraded. path=%s", db_path_.c_str());
+    return RC::SUCCESS;
+  }
+
+  vector<string> table_meta_files;
+  if (common::list_file(db_path_.c_str(), TABLE_META_FILE_PATTERN, table_meta_files) < 0) {
+    LOG_ERROR("failed to list table meta files. path=%s", db_path_.c_str());
+    return RC::IOERR_READ;
+  }
+  for (const string &meta_file : table_meta_files) {
+    rc = upgrade_table(meta_file);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return write_checkpoint();
+}
+
+RC DbXidUpgrade::check_log()
+{
+  int64_t checkpoint_lsn = -1;
+  RC      rc             = CLogManager::read_control_file(db_path_, checkpoint_lsn);
+  if (rc == RC::FILE_NOT_EXIST) {
+    LOG_ERROR("no checkpoint found, the database was not shut down cleanly. path=%s", db_path_.c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  CLogFile log_file;
+  rc = log_file.init(db_path_.c_str());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open clog. path=%s, rc=%s", db_path_.c_str(), strrc(rc));
+    return rc;
+  }
+
+  CLogRecordIterator log_record_iterator;
+  rc = log_record_iterator.init(log_file, checkpoint_lsn);
+  if (OB_SUCC(rc)) {
+    rc = log_record_iterator.next();
+  }
+  if (OB_FAIL(rc) || !log_record_iterator.valid() ||
+      log_record_iterator.log_record().log_type() != CLogType::CHECKPOINT) {
+    LOG_ERROR("failed to read checkpoint log. lsn=%ld, rc=%s", static_cast<long>(checkpoint_lsn), strrc(rc));
+    return OB_FAIL(rc) ? rc : RC::INTERNAL;
+  }
+
+  const CLogRecordData &data_record = log_record_iterator.log_record().data_record();
+  CLogCheckpoint        checkpoint;
+  if (!CLogCheckpoint::is_legacy(data_record.data_, data_record.data_len_)) {
+    rc = checkpoint.deserialize(data_record.data_, data_record.data_len_);
+    if (OB_SUCC(rc)) {
+      log_upgraded_ = true;
+      max_trx_id_   = checkpoint.max_trx_id_;
+    }
+    return rc;
+  }
+
+  rc = checkpoint.deserialize_legacy(data_record.data_, data_record.data_len_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  LOG_INFO("read legacy checkpoint. lsn=%ld, %s", static_cast<long>(checkpoint_lsn), checkpoint.to_string().c_str());
+
+  // 重做的起点就是 checkpoint 自己，说明所有的页面都已经写到磁盘了
+  if (!checkpoint.active_trxes_.empty() || checkpoint.redo_lsn_ != checkpoint_lsn) {
+    LOG_ERROR("the database was not shut down cleanly, start it with the old version and shut it down first. "
+              "checkpoint lsn=%ld, %s",
+              static_cast<long>(checkpoint_lsn), checkpoint.to_string().c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  for (rc = log_record_iterator.next(); OB_SUCC(rc) && log_record_iterator.valid(); rc = log_record_iterator.next()) {
+    const CLogRecord &log_record = log_record_iterator.log_record();
+    if (log_record.log_type() != CLogType::CHECKPOINT) {
+      LOG_ERROR("found log after the last checkpoint, the database was not shut down cleanly. log={%s}",
+                log_record.to_string().c_str());
+      return RC::INVALID_ARGUMENT;
+    }
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read clog after checkpoint. rc=%s", strrc(rc));
+    return rc;
+  }
+  if (log_record_iterator.torn_tail()) {
+    LOG_ERROR("found torn log after the last checkpoint, the database was not shut down cleanly. lsn=%ld",
+              static_cast<long>(log_record_iterator.lsn()));
+    return RC::INVALID_ARGUMENT;
+  }
+
+  max_trx_id_ = checkpoint.max_trx_id_;
+  return RC::SUCCESS;
+}
+
+RC DbXidUpgrade::upgrade_table(const string &meta_file)
+{
+  unique_ptr<Table> old_table = make_unique<Table>();
+  RC                rc        = old_table->open(meta_file.c_str(), db_path_.c_str(), true /*allow_legacy_xid*/);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open table to upgrade. file=%s, rc=%s", meta_file.c_str(), strrc(rc));
+    return rc;
+  }
+
+  const TableMeta                   &table_meta = old_table->table_meta();
+  const pair<const FieldMeta *, int> trx_fields = table_meta.trx_fields();
+  if (trx_fields.second == 0 || trx_fields.first[0].len() == Xid::LEN) {
+    return RC::SUCCESS;
+  }
+
+  const string dir = upgrade_dir();
+  error_code   ec;
+  filesystem::remove_all(dir, ec);
+  if (!filesystem::create_directories(dir, ec)) {
+    LOG_WARN("failed to create upgrade directory. dir=%s, error=%s", dir.c_str(), ec.message().c_str());
+    return RC::IOERR_ACCESS;
+  }
+
+  // 用户字段保持不变，事务号字段由表元数据按照当前的格式生成
+  vector<AttrInfoSqlNode> attributes;
+  for (int i = table_meta.sys_field_num(); i < table_meta.field_num(); i++) {
+    const FieldMeta *field_meta = table_meta.field(i);
+    AttrInfoSqlNode  attr_info;
+    attr_info.type   = field_meta->type();
+    attr_info.name   = field_meta->name();
+    attr_info.length = field_meta->len();
+    if (field_meta->encoding() != ColumnEncoding::PLAIN_ENCODING) {
+      attr_info.encoding = column_encoding_to_string(field_meta->encoding());
+    }
+    attributes.push_back(attr_info);
+  }
+
+  unique_ptr<Table> new_table = make_unique<Table>();
+  rc = new_table->create(table_meta.table_id(),
+      table_meta_file(dir.c_str(), old_table->name()).c_str(),
+      old_table->name(),
+      dir.c_str(),
+      static_cast<int>(attributes.size()),
+      attributes.data(),
+      table_meta.storage_format());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create upgraded table. table=%s, rc=%s", old_table->name(), strrc(rc));
+    return rc;
+  }
+
+  // 先建好索引，复制记录时一起插入索引项
+  for (int i = 0; i < table_meta.index_num() && OB_SUCC(rc); i++) {
+    const IndexMeta *index_meta = table_meta.index(i);
+    rc = new_table->create_index(nullptr, new_table->table_meta().field(index_meta->field()), index_meta->name());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to create index of upgraded table. table=%s, index=%s, rc=%s",
+               old_table->name(), index_meta->name(), strrc(rc));
+    }
+  }
+
+  if (OB_SUCC(rc)) {
+    rc = copy_records(old_table.get(), new_table.get());
+  }
+  if (OB_SUCC(rc) && table_meta.read_only()) {
+    rc = new_table->set_read_only(true);
+  }
+  if (OB_SUCC(rc)) {
+    rc = new_table->sync();
+  }
+  const string table_name = old_table->name();
+  new_table.reset();
+  old_table.reset();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to prepare upgraded table. table=%s, rc=%s", table_name.c_str(), strrc(rc));
+    return rc;
+  }
+
+  // 新表的文件都落盘以后才写完成标记
+  for (const filesystem::directory_entry &entry : filesystem::directory_iterator(dir, ec)) {
+    rc = sync_path(entry.path().string(), false /*directory*/);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  const string done_file = dir + "/" + DONE_FILE_NAME;
+  int          fd        = ::open(done_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd < 0 || fsync(fd) != 0) {
+    LOG_WARN("failed to create upgrade done file. file=%s, error=%s", done_file.c_str(), strerror(errno));
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    return RC::IOERR_WRITE;
+  }
+  ::close(fd);
+
+  rc = sync_path(dir, true /*directory*/);
+  if (OB_SUCC(rc)) {
+    rc = finish_table();
+  }
+  if (OB_SUCC(rc)) {
+    upgraded_tables_++;
+    LOG_INFO("upgraded table to 64 bits transaction id. table=%s", table_name.c_str());
+  }
+  return rc;
+}
+
+RC DbXidUpgrade::copy_records(Table *old_table, Table *new_table)
+{
+  const pair<const FieldMeta *, int> old_fields = old_table->table_meta().trx_fields();
+  const pair<const FieldMeta *, int> new_fields = new_table->table_meta().trx_fields();
+
+  // 事务号字段都在记录的最前面，后面的用户数据原样复制
+  const FieldMeta &old_last_field = old_fields.first[old_fields.second - 1];
+  const FieldMeta &new_last_field = new_fields.first[new_fields.second - 1];
+  const int        old_sys_len    = old_last_field.offset() + old_last_field.len();
+  const int        new_sys_len    = new_last_field.offset() + new_last_field.len();
+  const int        record_size    = new_table->table_meta().record_size();
+  const int        user_data_len  = old_table->table_meta().record_size() - old_sys_len;
+
+  RecordFileScanner scanner;
+  RC                rc = old_table->get_record_scanner(scanner, nullptr /*trx*/, true /*readonly*/);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open scanner of table to upgrade. table=%s, rc=%s", old_table->name(), strrc(rc));
+    return rc;
+  }
+
+  vector<char> data(record_size);
+  Record       new_record;
+  int          record_num = 0;
+  while (OB_SUCC(rc) && scanner.has_next()) {
+    Record old_record;
+    rc = scanner.next(old_record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to scan table to upgrade. table=%s, rc=%s", old_table->name(), strrc(rc));
+      break;
+    }
+
+    // 旧的事务号是32位的，负数表示没有提交，结束事务号是 INT32_MAX 时表示记录没有被删除。
+    // 正常关闭时所有的事务都已经结束，记录上只剩下提交事务号
+    new_record.set_data(data.data(), record_size);
+    for (int i = 0; i < new_fields.second; i++) {
+      int32_t legacy_xid = 0;
+      memcpy(&legacy_xid, old_record.data() + old_fields.first[i].offset(), sizeof(legacy_xid));
+      if (legacy_xid < 0) {
+        LOG_ERROR("found uncommitted transaction id on record, the database was not shut down cleanly. "
+                  "table=%s, rid=%s, field=%s, xid=%d",
+                  old_table->name(), old_record.rid().to_string().c_str(), old_fields.first[i].name(), legacy_xid);
+        rc = RC::INVALID_ARGUMENT;
+        break;
+      }
+
+      int64_t xid = legacy_xid;
+      if (i == 1 && (legacy_xid == numeric_limits<int32_t>::max() || legacy_xid == 0)) {
+        xid = Xid::MAX;
+      } else {
+        max_trx_id_ = std::max(max_trx_id_, xid);
+      }
+      XidField(&new_fields.first[i]).set(new_record, xid);
+    }
+    if (OB_FAIL(rc)) {
+      break;
+    }
+    memcpy(data.data() + new_sys_len, old_record.data() + old_sys_len, user_data_len);
+
+    rc = new_table->insert_record(new_record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert record into upgraded table. table=%s, rc=%s", old_table->name(), strrc(rc));
+      break;
+    }
+    record_num++;
+  }
+  scanner.close_scan();
+
+  if (OB_SUCC(rc)) {
+    LOG_INFO("copied records into upgraded table. table=%s, records=%d", old_table->name(), record_num);
+  }
+  return rc;
+}
+
+RC DbXidUpgrade::finish_table()
+{
+  const string dir = upgrade_dir();
+  error_code   ec;
+  if (!filesystem::exists(dir, ec)) {
+    return RC::SUCCESS;
+  }
+
+  if (!filesystem::exists(dir + "/" + DONE_FILE_NAME, ec)) {
+    // 新表还没有生成完，旧表没有被改动过
+    LOG_INFO("discard incomplete upgraded table. dir=%s", dir.c_str());
+    filesystem::remove_all(dir, ec);
+    return ec ? RC::IOERR_ACCESS : RC::SUCCESS;
+  }
+
+  // 元数据文件决定了按照哪种格式读取数据文件，最后再移动
+  vector<filesystem::path> data_files;
+  vector<filesystem::path> meta_files;
+  for (const filesystem::directory_entry &entry : filesystem::directory_iterator(dir, ec)) {
+    const filesystem::path &path = entry.path();
+    if (path.filename() == DONE_FILE_NAME) {
+      continue;
+    }
+    if (path.extension() == TABLE_META_SUFFIX) {
+      meta_files.push_back(path);
+    } else {
+      data_files.push_back(path);
+    }
+  }
+  data_files.insert(data_files.end(), meta_files.begin(), meta_files.end());
+
+  for (const filesystem::path &path : data_files) {
+    const string target = db_path_ + "/" + path.filename().string();
+    if (::rename(path.c_str(), target.c_str()) != 0) {
+      LOG_WARN("failed to move upgraded file. file=%s, target=%s, error=%s",
+               path.c_str(), target.c_str(), strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+  }
+
+  RC rc = sync_path(db_path_, true /*directory*/);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  filesystem::remove_all(dir, ec);
+  if (ec) {
+    LOG_WARN("failed to remove upgrade directory. dir=%s, error=%s", dir.c_str(), ec.message().c_str());
+    return RC::IOERR_ACCESS;
+  }
+  LOG_INFO("moved upgraded table files into db directory. dir=%s, files=%d",
+           db_path_.c_str(), static_cast<int>(data_files.size()));
+  return RC::SUCCESS;
+}
+
+RC DbXidUpgrade::write_checkpoint()
+{
+  CLogManager log_manager;
+  RC          rc = log_manager.init(db_path_.c_str());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open clog. path=%s, rc=%s", db_path_.c_str(), strrc(rc));
+    return rc;
+  }
+
+  // 之后打开数据库时从这里开始重做，旧格式的日志不会再被读取
+  CLogCheckpoint checkpoint;
+  checkpoint.begin_lsn_  = log_manager.current_lsn();
+  checkpoint.redo_lsn_   = checkpoint.begin_lsn_;
+  checkpoint.max_trx_id_ = max_trx_id_;
+
+  int64_t checkpoint_lsn = -1;
+  rc = log_manager.append_log(CLogRecord::build_checkpoint_record(checkpoint), &checkpoint_lsn);
+  if (OB_SUCC(rc)) {
+    rc = log_manager.sync();
+  }
+  if (OB_SUCC(rc)) {
+    rc = CLogManager::write_control_file(db_path_, checkpoint_lsn);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write upgraded checkpoint. path=%s, rc=%s", db_path_.c_str(), strrc(rc));
+    return rc;
+  }
+
+  LOG_INFO("upgraded checkpoint done. checkpoint lsn=%ld, %s",
+           static_cast<long>(checkpoint_lsn), checkpoint.to_string().c_str());
+  return RC::SUCCESS;
+}
@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "common/rc.h"
+
+class Table;
+
+/**
+ * @brief 离线升级事务号改成64位之前的数据库
+ * @details 旧的数据库中表上的事务号字段是4个字节，checkpoint 中的事务号是32位的，不能直接打开。
+ * 只能升级正常关闭的数据库：控制文件指向的 checkpoint 就是日志的结尾，重做的起点就是它自己，
+ * 并且没有正在运行的事务。这时所有的页面都已经写到磁盘，打开时不需要重做任何日志。
+ * 旧的日志中的记录数据都是4字节事务号的格式，升级之后不能再重做，所以这是必须满足的条件。过程如下：
+ * 1. 读取旧格式的 checkpoint 并检查上面的条件，记下已经分配的最大事务号；
+ * 2. 逐个改写4字节事务号的表：在临时目录中按照原来的表ID、字段、存储格式、索引和只读状态新建一张表，
+ *    复制所有记录并扩展事务号字段。数据页面的页头按照新的记录长度重新生成，索引也重新建立。
+ *    新表刷盘以后写入完成标记，再把文件移动到数据库目录中，元数据文件最后移动；
+ * 3. 在日志结尾追加一个新格式的 checkpoint，最大事务号不小于所有记录上的事务号，然后更新控制文件。
+ * 中途失败或者宕机时可以再次执行：已经改写完的表会被跳过，临时目录中有完成标记的表继续移动，否则丢弃重新改写。
+ * 升级之前的备份和归档日志不能用于升级之后的数据库，升级后要重新做一次备份。
+ */
+class DbXidUpgrade
+{
+public:
+  explicit DbXidUpgrade(const char *db_path) : db_path_(db_path) {}
+
+  RC upgrade();
+
+  /**
+   * @brief 这次改写的表的个数
+   */
+  int upgraded_tables() const { return upgraded_tables_; }
+
+  /**
+   * @brief 新的 checkpoint 中的最大事务号
+   */
+  int64_t max_trx_id() const { return max_trx_id_; }
+
+private:
+  /**
+   * @brief 读取控制文件指向的 checkpoint，检查数据库是不是正常关闭的
+   * @details 之前的升级可能已经在日志结尾追加过新的 checkpoint，但是还没有更新控制文件，
+   * 所以旧的 checkpoint 之后只允许出现 checkpoint 日志
+   */
+  RC check_log();
+
+  RC upgrade_table(const std::string &meta_file);
+  RC copy_records(Table *old_table, Table *new_table);
+
+  /**
+   * @brief 把临时目录中已经完整的新表移动到数据库目录中
+   * @details 没有临时目录时什么都不做，临时目录中没有完成标记时直接删除它
+   */
+  RC finish_table();
+
+  RC write_checkpoint();
+
+  std::string upgrade_dir() const;
+
+private:
+  static const char *UPGRADE_DIR_NAME;
+  static const char *DONE_FILE_NAME;
+
+private:
+  std::string db_path_;
+  bool        log_upgraded_    = false;  ///< 控制文件是否已经指向新格式的 checkpoint
+  int64_t     max_trx_id_      = 0;
+  int         upgraded_tables_ = 0;
+};
@@ -24,16 +24,40 @@ const static Json::StaticString FIELD_TYPE("type");
 const static Json::StaticString FIELD_OFFSET("offset");
 const static Json::StaticString FIELD_LEN("len");
 const static Json::StaticString FIELD_VISIBLE("visible");
+const static Json::StaticString FIELD_ENCODING("encoding");
+
+static const char *COLUMN_ENCODING_NAME[] = {"unknown", "plain", "dict", "rle", "for"};
+
+const char *column_encoding_to_string(ColumnEncoding encoding)
+{
+  const int index = static_cast<int>(encoding);
+  if (index >= 0 && index < static_cast<int>(sizeof(COLUMN_ENCODING_NAME) / sizeof(COLUMN_ENCODING_NAME[0]))) {
+    return COLUMN_ENCODING_NAME[index];
+  }
+  return "unknown";
+}
+
+ColumnEncoding column_encoding_from_string(const char *s)
+{
+  for (unsigned int i = 0; i < sizeof(COLUMN_ENCODING_NAME) / sizeof(COLUMN_ENCODING_NAME[0]); i++) {
+    if (0 == strcasecmp(COLUMN_ENCODING_NAME[i], s)) {
+      return static_cast<ColumnEncoding>(i);
+    }
+  }
+  return ColumnEncoding::UNKNOWN_ENCODING;
+}
 
 FieldMeta::FieldMeta() : attr_type_(AttrType::UNDEFINED), attr_offset_(-1), attr_len_(0), visible_(false) {}
 
-FieldMeta::FieldMeta(const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible)
+FieldMeta::FieldMeta(
+    const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible, ColumnEncoding encoding)
 {
-  [[maybe_unused]] RC rc = this->init(name, attr_type, attr_offset, attr_len, visible);
+  [[maybe_unused]] RC rc = this->init(name, attr_type, attr_offset, attr_len, visible, encoding);
   ASSERT(rc == RC::SUCCESS, "failed to init field meta. rc=%s", strrc(rc));
 }
 
-RC FieldMeta::init(const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible)
+RC FieldMeta::init(
+    const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible, ColumnEncoding encoding)
 {
   if (common::is_blank(name)) {
     LOG_WARN("Name cannot be empty");
@@ -51,6 +75,7 @@ RC FieldMeta::init(const char *name, AttrType attr_type, int attr_offset, int at
   attr_len_    = attr_len;
   attr_offset_ = attr_offset;
   visible_     = visible;
+  encoding_    = encoding;
 
   LOG_INFO("Init a field with name=%s", name);
   return RC::SUCCESS;
@@ -70,6 +95,9 @@ void FieldMeta::desc(std::ostream &os) const
 {
   os << "field name=" << name_ << ", type=" << attr_type_to_string(attr_type_) << ", len=" << attr_len_
      << ", visible=" << (visible_ ? "yes" : "no");
+  if (encoding_ != ColumnEncoding::PLAIN_ENCODING) {
+    os << ", encoding=" << column_encoding_to_string(encoding_);
+  }
 }
 
 void FieldMeta::to_json(Json::Value &json_value) const
@@ -79,6 +107,9 @@ void FieldMeta::to_json(Json::Value &json_value) const
   json_value[FIELD_OFFSET]  = attr_offset_;
   json_value[FIELD_LEN]     = attr_len_;
   json_value[FIELD_VISIBLE] = visible_;
+  if (encoding_ != ColumnEncoding::PLAIN_ENCODING) {
+    json_value[FIELD_ENCODING] = column_encoding_to_string(encoding_);
+  }
 }
 
 RC FieldMeta::from_json(const Json::Value &json_value, FieldMeta &field)
@@ -122,9 +153,24 @@ RC FieldMeta::from_json(const Json::Value &json_value, FieldMeta &field)
     return RC::INTERNAL;
   }
 
+  // 没有编码信息时表示不编码
+  ColumnEncoding encoding = ColumnEncoding::PLAIN_ENCODING;
+  if (json_value.isMember(FIELD_ENCODING)) {
+    const Json::Value &encoding_value = json_value[FIELD_ENCODING];
+    if (!encoding_value.isString()) {
+      LOG_ERROR("Encoding is not a string. json value=%s", encoding_value.toStyledString().c_str());
+      return RC::INTERNAL;
+    }
+    encoding = column_encoding_from_string(encoding_value.asCString());
+    if (ColumnEncoding::UNKNOWN_ENCODING == encoding) {
+      LOG_ERROR("Got invalid column encoding. encoding=%s", encoding_value.asCString());
+      return RC::INTERNAL;
+    }
+  }
+
   const char *name    = name_value.asCString();
   int         offset  = offset_value.asInt();
   int         len     = len_value.asInt();
   bool        visible = visible_value.asBool();
-  return field.init(name, type, offset, len, visible);
+  return field.init(name, type, offset, len, visible, encoding);
 }
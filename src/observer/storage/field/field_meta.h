@@ -17,12 +17,16 @@ See the Mulan PSL v2 for more details. */
 #include <string>
 
 #include "common/rc.h"
+#include "common/types.h"
 #include "sql/parser/parse_defs.h"
 
 namespace Json {
 class Value;
 }  // namespace Json
 
+const char    *column_encoding_to_string(ColumnEncoding encoding);
+ColumnEncoding column_encoding_from_string(const char *s);
+
 /**
  * @brief 字段元数据
  *
@@ -31,10 +35,12 @@ class FieldMeta
 {
 public:
   FieldMeta();
-  FieldMeta(const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible);
+  FieldMeta(const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible,
+      ColumnEncoding encoding = ColumnEncoding::PLAIN_ENCODING);
   ~FieldMeta() = default;
 
-  RC init(const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible);
+  RC init(const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible,
+      ColumnEncoding encoding = ColumnEncoding::PLAIN_ENCODING);
 
 public:
   const char *name() const;
@@ -43,6 +49,11 @@ public:
   int         len() const;
   bool        visible() const;
 
+  /**
+   * @brief 字段在PAX格式页面中的编码方式
+   */
+  ColumnEncoding encoding() const { return encoding_; }
+
 public:
   void desc(std::ostream &os) const;
 
@@ -51,9 +62,10 @@ public:
   static RC from_json(const Json::Value &json_value, FieldMeta &field);
 
 protected:
-  std::string name_;
-  AttrType    attr_type_;
-  int         attr_offset_;
-  int         attr_len_;
-  bool        visible_;
+  std::string    name_;
+  AttrType       attr_type_;
+  int            attr_offset_;
+  int            attr_len_;
+  bool           visible_;
+  ColumnEncoding encoding_ = ColumnEncoding::PLAIN_ENCODING;
 };
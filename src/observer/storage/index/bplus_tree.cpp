@@ -731,6 +731,11 @@ RC BplusTreeHandler::sync()
   return disk_buffer_pool_->flush_all_pages();
 }
 
+RC BplusTreeHandler::flush_pages_before(LSN lsn, LSN &min_rec_lsn)
+{
+  return disk_buffer_pool_->flush_pages_before(lsn, min_rec_lsn);
+}
+
 RC BplusTreeHandler::create(const char *file_name, AttrType attr_type, int attr_length, int internal_max_size /* = -1*/,
     int leaf_max_size /* = -1 */)
 {
@@ -1302,6 +1307,18 @@ void BplusTreeHandler::update_root_page_num_locked(PageNum root_page_num)
   file_header_.root_page = root_page_num;
   header_dirty_ = true;
   LOG_DEBUG("set root page to %d", root_page_num);
+
+  // 根节点变化时同时修改文件头页面，这样页面刷盘之后重新打开索引可以找到新的根节点
+  Frame *header_frame = nullptr;
+  RC     rc           = disk_buffer_pool_->get_this_page(FIRST_INDEX_PAGE, &header_frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to fetch index header page. rc=%s", strrc(rc));
+    return;
+  }
+  memcpy(header_frame->data(), &file_header_, sizeof(file_header_));
+  header_frame->mark_dirty();
+  header_dirty_ = false;
+  disk_buffer_pool_->unpin_page(header_frame);
 }
 
 RC BplusTreeHandler::create_new_tree(const char *key, const RID *rid)
@@ -1795,6 +1812,13 @@ bool BplusTreeScanner::touch_end()
 
 RC BplusTreeScanner::next_entry(RID &rid)
 {
+  if (last_key_ != nullptr) {
+    RC rc = reseek();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
   if (nullptr == current_frame_) {
     return RC::RECORD_EOF;
   }
@@ -1845,6 +1869,45 @@ RC BplusTreeScanner::next_entry(RID &rid)
   return next_entry(rid);
 }
 
+void BplusTreeScanner::release_latches()
+{
+  if (nullptr == current_frame_ || !first_emitted_) {
+    return;
+  }
+
+  LeafIndexNodeHandler node(tree_handler_.file_header_, current_frame_);
+  last_key_ = tree_handler_.mem_pool_item_->alloc_unique_ptr();
+  memcpy(last_key_.get(), node.key_at(iter_index_), tree_handler_.file_header_.key_length);
+
+  latch_memo_.release();
+  current_frame_ = nullptr;
+}
+
+RC BplusTreeScanner::reseek()
+{
+  MemPoolItem::unique_ptr last_key = std::move(last_key_);
+  const char             *key      = static_cast<const char *>(last_key.get());
+
+  RC rc = tree_handler_.find_leaf(latch_memo_, BplusTreeOperationType::READ, key, current_frame_);
+  if (rc == RC::EMPTY) {
+    latch_memo_.release();
+    current_frame_ = nullptr;
+    return RC::SUCCESS;
+  } else if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to find leaf page of last key. rc=%s", strrc(rc));
+    current_frame_ = nullptr;
+    return rc;
+  }
+
+  // lookup 返回第一个不小于上次返回的键值的位置。键值还在时它已经返回过了，next_entry 从它后面继续；
+  // 释放页面锁期间被删除了，就从这个位置开始。超出当前页面时 next_entry 会转到下一个页面
+  LeafIndexNodeHandler node(tree_handler_.file_header_, current_frame_);
+  bool                 found = false;
+  int                  index = node.lookup(tree_handler_.key_comparator_, key, &found);
+  iter_index_                = found ? index : index - 1;
+  return RC::SUCCESS;
+}
+
 RC BplusTreeScanner::close()
 {
   inited_ = false;
@@ -517,6 +517,11 @@ public:
 
   RC sync();
 
+  /**
+   * @brief checkpoint时刷新页面，参考 DiskBufferPool::flush_pages_before
+   */
+  RC flush_pages_before(LSN lsn, LSN &min_rec_lsn);
+
   /**
    * Check whether current B+ tree is invalid or not.
    * @return true means current tree is valid, return false means current tree is invalid.
@@ -620,6 +625,13 @@ public:
 
   RC next_entry(RID &rid);
 
+  /**
+   * @brief 释放扫描器持有的页面锁
+   * @details 要等待比较长的时间之前调用，比如等待行锁，否则修改这个叶子页面的线程也要一直等待。
+   * 之后调用 next_entry 时按照上次返回的键值重新定位，从它后面继续扫描
+   */
+  void release_latches();
+
   RC close();
 
 private:
@@ -628,6 +640,11 @@ private:
    */
   RC fix_user_key(const char *user_key, int key_len, bool want_greater, char **fixed_key, bool *should_inclusive);
 
+  /**
+   * @brief release_latches 之后重新找到上次返回的键值所在的叶子页面
+   */
+  RC reseek();
+
   void fetch_item(RID &rid);
   bool touch_end();
 
@@ -644,4 +661,6 @@ private:
   common::MemPoolItem::unique_ptr right_key_;
   int iter_index_ = -1;
   bool first_emitted_ = false;
+
+  common::MemPoolItem::unique_ptr last_key_;  ///< release_latches 时上次返回的键值，重新定位以后清空
 };
@@ -80,9 +80,21 @@ RC BplusTreeIndex::insert_entry(const char *record, const RID *rid)
 }
 RC BplusTreeIndex::update_entry(const char *target_record, const RID *rid, const char *record)
 {
-  // TODO
-  // return index_handler_.update_entry(target_record + field_meta_.offset(), rid, record + field_meta_.offset());
-  return RC::SUCCESS;
+  RC rc = index_handler_.delete_entry(target_record + field_meta_.offset(), rid);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to delete old entry while updating. rid=%s, rc=%s", rid->to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  rc = index_handler_.insert_entry(record + field_meta_.offset(), rid);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to insert new entry while updating. rid=%s, rc=%s", rid->to_string().c_str(), strrc(rc));
+    RC rc2 = index_handler_.insert_entry(target_record + field_meta_.offset(), rid);
+    if (rc2 != RC::SUCCESS) {
+      LOG_ERROR("failed to restore old entry. rid=%s, rc=%s", rid->to_string().c_str(), strrc(rc2));
+    }
+  }
+  return rc;
 }
 
 RC BplusTreeIndex::delete_entry(const char *record, const RID *rid)
@@ -105,6 +117,11 @@ IndexScanner *BplusTreeIndex::create_scanner(
 
 RC BplusTreeIndex::sync() { return index_handler_.sync(); }
 
+RC BplusTreeIndex::flush_pages_before(LSN lsn, LSN &min_rec_lsn)
+{
+  return index_handler_.flush_pages_before(lsn, min_rec_lsn);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 BplusTreeIndexScanner::BplusTreeIndexScanner(BplusTreeHandler &tree_handler) : tree_scanner_(tree_handler) {}
 
@@ -118,6 +135,8 @@ RC BplusTreeIndexScanner::open(
 
 RC BplusTreeIndexScanner::next_entry(RID *rid) { return tree_scanner_.next_entry(*rid); }
 
+void BplusTreeIndexScanner::release_latches() { tree_scanner_.release_latches(); }
+
 RC BplusTreeIndexScanner::destroy()
 {
   delete this;
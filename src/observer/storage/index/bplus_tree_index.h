@@ -42,6 +42,7 @@ public:
       int right_len, bool right_inclusive) override;
 
   RC sync() override;
+  RC flush_pages_before(LSN lsn, LSN &min_rec_lsn) override;
 
 private:
   bool             inited_ = false;
@@ -58,8 +59,9 @@ public:
   BplusTreeIndexScanner(BplusTreeHandler &tree_handle);
   ~BplusTreeIndexScanner() noexcept override;
 
-  RC next_entry(RID *rid) override;
-  RC destroy() override;
+  RC   next_entry(RID *rid) override;
+  RC   destroy() override;
+  void release_latches() override;
 
   RC open(const char *left_key, int left_len, bool left_inclusive, const char *right_key, int right_len,
       bool right_inclusive);
@@ -41,6 +41,7 @@ public:
   virtual ~Index() = default;
 
   const IndexMeta &index_meta() const { return index_meta_; }
+  const FieldMeta &field_meta() const { return field_meta_; }
 
   /**
    * @brief 插入一条数据
@@ -83,6 +84,11 @@ public:
    */
   virtual RC sync() = 0;
 
+  /**
+   * @brief checkpoint时刷新索引页面，参考 DiskBufferPool::flush_pages_before
+   */
+  virtual RC flush_pages_before(LSN lsn, LSN &min_rec_lsn) = 0;
+
 protected:
   RC init(const IndexMeta &index_meta, const FieldMeta &field_meta);
 
@@ -107,4 +113,10 @@ public:
    */
   virtual RC next_entry(RID *rid) = 0;
   virtual RC destroy()            = 0;
+
+  /**
+   * 释放扫描时持有的页面锁，之后再调用 next_entry 时从上次返回的位置之后继续
+   * 等待行锁之前调用，持有行锁的事务可能要修改这些页面
+   */
+  virtual void release_latches() {}
 };
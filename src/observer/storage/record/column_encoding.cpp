@@ -0,0 +1,634 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "storage/record/column_encoding.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief 按位压缩存放 capacity 个值需要的字节数
+ * @details 读写时一次访问8个字节，所以在最后多留8个字节，避免越界
+ */
+int packed_size(int capacity, int bits) { return static_cast<int>((static_cast<int64_t>(capacity) * bits + 7) / 8) + 8; }
+
+uint32_t packed_get(const char *base, int bits, int index)
+{
+  const int64_t bit_offset = static_cast<int64_t>(index) * bits;
+  uint64_t      word       = 0;
+  memcpy(&word, base + bit_offset / 8, sizeof(word));
+  return static_cast<uint32_t>((word >> (bit_offset % 8)) & ((1ULL << bits) - 1));
+}
+
+void packed_set(char *base, int bits, int index, uint32_t value)
+{
+  const int64_t  bit_offset = static_cast<int64_t>(index) * bits;
+  const int      shift      = static_cast<int>(bit_offset % 8);
+  const uint64_t mask       = ((1ULL << bits) - 1) << shift;
+  uint64_t       word       = 0;
+  memcpy(&word, base + bit_offset / 8, sizeof(word));
+  word = (word & ~mask) | ((static_cast<uint64_t>(value) << shift) & mask);
+  memcpy(base + bit_offset / 8, &word, sizeof(word));
+}
+
+bool compare_result_match(int result, CompOp comp)
+{
+  switch (comp) {
+    case EQUAL_TO: return result == 0;
+    case NOT_EQUAL: return result != 0;
+    case LESS_THAN: return result < 0;
+    case LESS_EQUAL: return result <= 0;
+    case GREAT_THAN: return result > 0;
+    case GREAT_EQUAL: return result >= 0;
+    default: return true;
+  }
+}
+
+/**
+ * @brief 编码值上的比较与 Value::compare 保持一致，只处理同类型或者都是数值类型的情况
+ */
+bool comparable(AttrType column_type, AttrType value_type)
+{
+  if (column_type == value_type) {
+    return true;
+  }
+  const bool column_numeric = (column_type == INTS || column_type == FLOATS);
+  const bool value_numeric  = (value_type == INTS || value_type == FLOATS);
+  return column_numeric && value_numeric;
+}
+
+Value make_value(const ColumnDesc &desc, const char *data)
+{
+  Value value;
+  value.set_type(desc.type);
+  value.set_data(const_cast<char *>(data), desc.len);
+  return value;
+}
+
+int32_t load_int32(const char *data)
+{
+  int32_t value = 0;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+void store_int32(char *data, int32_t value) { memcpy(data, &value, sizeof(value)); }
+
+/**
+ * @brief 重新编码时读出要保留的值，与 slot_num 上的新值一起按照槽位顺序排列
+ */
+vector<pair<SlotNum, string>> collect_values(
+    const ColumnCodec &codec, const ColumnMinipage &page, const vector<SlotNum> &slots, SlotNum slot_num, const char *value)
+{
+  const int                     len = page.desc.len;
+  vector<pair<SlotNum, string>> values;
+  values.reserve(slots.size() + 1);
+
+  string buffer(len, 0);
+  bool   added = false;
+  for (SlotNum slot : slots) {
+    if (!added && slot_num < slot) {
+      values.emplace_back(slot_num, string(value, len));
+      added = true;
+    }
+    codec.read(page, slot, &buffer[0]);
+    values.emplace_back(slot, buffer);
+  }
+  if (!added) {
+    values.emplace_back(slot_num, string(value, len));
+  }
+  return values;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 不编码，与没有编码的PAX页面一样，每个槽位存放原始的值
+ */
+class PlainCodec : public ColumnCodec
+{
+public:
+  int area_size(const ColumnDesc &desc, int capacity) const override { return desc.len * capacity; }
+
+  void init(ColumnMinipage & /*page*/) const override {}
+
+  bool can_write(const ColumnMinipage & /*page*/, SlotNum /*slot_num*/, const char * /*value*/) const override
+  {
+    return true;
+  }
+
+  void write(ColumnMinipage &page, SlotNum slot_num, const char *value) const override
+  {
+    memcpy(page.data + page.desc.len * slot_num, value, page.desc.len);
+  }
+
+  void read(const ColumnMinipage &page, SlotNum slot_num, char *dest) const override
+  {
+    memcpy(dest, page.data + page.desc.len * slot_num, page.desc.len);
+  }
+
+  bool reencode(ColumnMinipage & /*page*/, const vector<SlotNum> & /*slots*/, SlotNum /*slot_num*/,
+      const char * /*value*/) const override
+  {
+    return true;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 页内字典编码
+ * @details 小页布局：| 字典项个数(int32) | DICT_CAPACITY 个字典项 | 每个槽位4位的字典编号 |
+ */
+class DictCodec : public ColumnCodec
+{
+public:
+  static constexpr int DICT_CAPACITY = 16;
+  static constexpr int CODE_BITS     = 4;
+
+public:
+  int area_size(const ColumnDesc &desc, int capacity) const override
+  {
+    return static_cast<int>(sizeof(int32_t)) + DICT_CAPACITY * desc.len + packed_size(capacity, CODE_BITS);
+  }
+
+  void init(ColumnMinipage &page) const override { store_int32(page.data, 0); }
+
+  bool can_write(const ColumnMinipage &page, SlotNum /*slot_num*/, const char *value) const override
+  {
+    return find(page, value) >= 0 || entry_num(page) < DICT_CAPACITY;
+  }
+
+  void write(ColumnMinipage &page, SlotNum slot_num, const char *value) const override
+  {
+    int code = find(page, value);
+    if (code < 0) {
+      code = entry_num(page);
+      ASSERT(code < DICT_CAPACITY, "dictionary is full");
+      memcpy(entry(page, code), value, page.desc.len);
+      store_int32(page.data, code + 1);
+    }
+    packed_set(codes(page), CODE_BITS, slot_num, static_cast<uint32_t>(code));
+  }
+
+  void read(const ColumnMinipage &page, SlotNum slot_num, char *dest) const override
+  {
+    const int code = static_cast<int>(packed_get(codes(page), CODE_BITS, slot_num));
+    memcpy(dest, entry(page, code), page.desc.len);
+  }
+
+  bool reencode(ColumnMinipage &page, const vector<SlotNum> &slots, SlotNum slot_num, const char *value) const override
+  {
+    // 字典中只保留还有记录在使用的值
+    const vector<pair<SlotNum, string>> values = collect_values(*this, page, slots, slot_num, value);
+    vector<const string *>              distinct;
+    for (const pair<SlotNum, string> &slot_value : values) {
+      auto equal = [&slot_value](const string *v) { return *v == slot_value.second; };
+      if (std::none_of(distinct.begin(), distinct.end(), equal)) {
+        if (static_cast<int>(distinct.size()) == DICT_CAPACITY) {
+          return false;
+        }
+        distinct.push_back(&slot_value.second);
+      }
+    }
+
+    init(page);
+    for (const pair<SlotNum, string> &slot_value : values) {
+      write(page, slot_value.first, slot_value.second.data());
+    }
+    return true;
+  }
+
+  bool prepare(const ColumnMinipage &page, CompOp comp, const Value &value, EncodedCondition &condition) const override
+  {
+    if (!comparable(page.desc.type, value.attr_type())) {
+      condition.evaluable = false;
+      return true;
+    }
+
+    // 每个字典项只比较一次，之后只需要比较编号
+    const int num        = entry_num(page);
+    bool      any_match  = false;
+    condition.evaluable  = true;
+    condition.matches.assign(num, false);
+    for (int i = 0; i < num; i++) {
+      const bool matched   = compare_result_match(make_value(page.desc, entry(page, i)).compare(value), comp);
+      condition.matches[i] = matched;
+      any_match            = any_match || matched;
+    }
+    return any_match;
+  }
+
+  bool match(const ColumnMinipage &page, SlotNum slot_num, const EncodedCondition &condition) const override
+  {
+    const size_t code = packed_get(codes(page), CODE_BITS, slot_num);
+    return code >= condition.matches.size() || condition.matches[code];
+  }
+
+private:
+  static int entry_num(const ColumnMinipage &page) { return load_int32(page.data); }
+
+  static char *entry(const ColumnMinipage &page, int code)
+  {
+    return page.data + sizeof(int32_t) + static_cast<size_t>(code) * page.desc.len;
+  }
+
+  static char *codes(const ColumnMinipage &page) { return entry(page, DICT_CAPACITY); }
+
+  static int find(const ColumnMinipage &page, const char *value)
+  {
+    const int num = entry_num(page);
+    for (int i = 0; i < num; i++) {
+      if (0 == memcmp(entry(page, i), value, page.desc.len)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 游程编码
+ * @details 小页布局：| run个数(int32) | 覆盖到的槽位(int32) | run: (起始槽位(int32), 值) ... |
+ * run按照起始槽位排序，第一个run从槽位0开始，最后一个run一直覆盖到"覆盖到的槽位"之前。
+ * 没有记录的槽位也会被某个run覆盖，它们的值没有意义。
+ * 在中间修改一个值可能会把一个run拆成三个，run的个数超过上限时就不能写入了。
+ */
+class RleCodec : public ColumnCodec
+{
+public:
+  int area_size(const ColumnDesc &desc, int capacity) const override
+  {
+    return static_cast<int>(2 * sizeof(int32_t)) + max_runs(capacity) * run_size(desc);
+  }
+
+  void init(ColumnMinipage &page) const override
+  {
+    store_int32(page.data, 0);
+    store_int32(page.data + sizeof(int32_t), 0);
+  }
+
+  bool can_write(const ColumnMinipage &page, SlotNum slot_num, const char *value) const override
+  {
+    return runs_after_write(page, slot_num, value) <= max_runs(page.capacity);
+  }
+
+  bool can_overwrite(const ColumnMinipage &page, SlotNum slot_num, const char *value) const override
+  {
+    return slot_num < covered_end(page) && 0 == memcmp(run_value(page, find_run(page, slot_num)), value, page.desc.len);
+  }
+
+  void write(ColumnMinipage &page, SlotNum slot_num, const char *value) const override
+  {
+    const int len     = page.desc.len;
+    const int run_num = this->run_num(page);
+    const int end     = covered_end(page);
+
+    // 大部分情况是在最后追加记录
+    if (run_num == 0 || slot_num >= end) {
+      if (run_num == 0 || 0 != memcmp(run_value(page, run_num - 1), value, len)) {
+        store_int32(run_start_ptr(page, run_num), run_num == 0 ? 0 : end);
+        memcpy(run_value(page, run_num), value, len);
+        store_int32(page.data, run_num + 1);
+      }
+      store_int32(page.data + sizeof(int32_t), slot_num + 1);
+      return;
+    }
+
+    const int index = find_run(page, slot_num);
+    if (0 == memcmp(run_value(page, index), value, len)) {
+      return;
+    }
+
+    // 在中间修改，把相关的run拆开后重新合并
+    struct Run
+    {
+      int         start;
+      const char *value;
+    };
+    const string old_value(run_value(page, index), len);
+    const int    start = run_start(page, index);
+    const int    stop  = (index + 1 < run_num) ? run_start(page, index + 1) : end;
+
+    vector<Run> runs;
+    runs.reserve(run_num + 2);
+    for (int i = 0; i < index; i++) {
+      runs.push_back({run_start(page, i), run_value(page, i)});
+    }
+    if (slot_num > start) {
+      runs.push_back({start, old_value.data()});
+    }
+    runs.push_back({slot_num, value});
+    if (slot_num + 1 < stop) {
+      runs.push_back({slot_num + 1, old_value.data()});
+    }
+    for (int i = index + 1; i < run_num; i++) {
+      runs.push_back({run_start(page, i), run_value(page, i)});
+    }
+
+    // 值都先复制出来，再写回小页，避免覆盖还没有读取的run
+    string merged;
+    merged.reserve(runs.size() * len);
+    vector<int> starts;
+    starts.reserve(runs.size());
+    for (const Run &run : runs) {
+      if (!starts.empty() && 0 == memcmp(merged.data() + (starts.size() - 1) * len, run.value, len)) {
+        continue;
+      }
+      starts.push_back(run.start);
+      merged.append(run.value, len);
+    }
+
+    ASSERT(static_cast<int>(starts.size()) <= max_runs(page.capacity), "too many runs");
+    for (size_t i = 0; i < starts.size(); i++) {
+      store_int32(run_start_ptr(page, static_cast<int>(i)), starts[i]);
+      memcpy(run_value(page, static_cast<int>(i)), merged.data() + i * len, len);
+    }
+    store_int32(page.data, static_cast<int32_t>(starts.size()));
+  }
+
+  void read(const ColumnMinipage &page, SlotNum slot_num, char *dest) const override
+  {
+    if (run_num(page) == 0 || slot_num >= covered_end(page)) {
+      memset(dest, 0, page.desc.len);
+      return;
+    }
+    memcpy(dest, run_value(page, find_run(page, slot_num)), page.desc.len);
+  }
+
+  bool reencode(ColumnMinipage &page, const vector<SlotNum> &slots, SlotNum slot_num, const char *value) const override
+  {
+    // 没有记录的槽位可以归到任何一个run中，只有相邻的两条记录的值不同时才需要开始新的run
+    const vector<pair<SlotNum, string>> values = collect_values(*this, page, slots, slot_num, value);
+    int                                 runs   = 1;
+    for (size_t i = 1; i < values.size(); i++) {
+      if (values[i].second != values[i - 1].second) {
+        runs++;
+      }
+    }
+    if (runs > max_runs(page.capacity)) {
+      return false;
+    }
+
+    // 按照槽位顺序追加，每个值都写在最后一个run之后
+    init(page);
+    for (const pair<SlotNum, string> &slot_value : values) {
+      write(page, slot_value.first, slot_value.second.data());
+    }
+    return true;
+  }
+
+  bool prepare(const ColumnMinipage &page, CompOp comp, const Value &value, EncodedCondition &condition) const override
+  {
+    if (!comparable(page.desc.type, value.attr_type())) {
+      condition.evaluable = false;
+      return true;
+    }
+
+    // 每个run只比较一次
+    const int num       = run_num(page);
+    bool      any_match = false;
+    condition.evaluable = true;
+    condition.matches.assign(num, false);
+    for (int i = 0; i < num; i++) {
+      const bool matched   = compare_result_match(make_value(page.desc, run_value(page, i)).compare(value), comp);
+      condition.matches[i] = matched;
+      any_match            = any_match || matched;
+    }
+    return any_match;
+  }
+
+  bool match(const ColumnMinipage &page, SlotNum slot_num, const EncodedCondition &condition) const override
+  {
+    if (slot_num >= covered_end(page)) {
+      return true;
+    }
+    const size_t index = find_run(page, slot_num);
+    return index >= condition.matches.size() || condition.matches[index];
+  }
+
+private:
+  static int max_runs(int capacity) { return std::max(4, capacity / 8); }
+  static int run_size(const ColumnDesc &desc) { return static_cast<int>(sizeof(int32_t)) + desc.len; }
+
+  static int run_num(const ColumnMinipage &page) { return load_int32(page.data); }
+  static int covered_end(const ColumnMinipage &page) { return load_int32(page.data + sizeof(int32_t)); }
+
+  static char *run_start_ptr(const ColumnMinipage &page, int index)
+  {
+    return page.data + 2 * sizeof(int32_t) + static_cast<size_t>(index) * run_size(page.desc);
+  }
+  static int   run_start(const ColumnMinipage &page, int index) { return load_int32(run_start_ptr(page, index)); }
+  static char *run_value(const ColumnMinipage &page, int index) { return run_start_ptr(page, index) + sizeof(int32_t); }
+
+  /**
+   * @brief 找到覆盖指定槽位的run，即起始槽位不大于slot_num的最后一个run
+   */
+  static int find_run(const ColumnMinipage &page, SlotNum slot_num)
+  {
+    int low  = 0;
+    int high = run_num(page) - 1;
+    while (low < high) {
+      const int mid = (low + high + 1) / 2;
+      if (run_start(page, mid) <= slot_num) {
+        low = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
+    return low;
+  }
+
+  /**
+   * @brief 计算写入后run的个数，与 write 的逻辑保持一致
+   */
+  int runs_after_write(const ColumnMinipage &page, SlotNum slot_num, const char *value) const
+  {
+    const int len = page.desc.len;
+    const int num = run_num(page);
+    if (num == 0) {
+      return 1;
+    }
+
+    if (slot_num >= covered_end(page)) {
+      return 0 == memcmp(run_value(page, num - 1), value, len) ? num : num + 1;
+    }
+
+    const int index = find_run(page, slot_num);
+    if (0 == memcmp(run_value(page, index), value, len)) {
+      return num;
+    }
+
+    const int  start      = run_start(page, index);
+    const int  stop       = (index + 1 < num) ? run_start(page, index + 1) : covered_end(page);
+    const bool prev_equal = index > 0 && 0 == memcmp(run_value(page, index - 1), value, len);
+    const bool next_equal = index + 1 < num && 0 == memcmp(run_value(page, index + 1), value, len);
+    if (stop - start == 1) {
+      return num - (prev_equal ? 1 : 0) - (next_equal ? 1 : 0);
+    }
+    if (slot_num == start) {
+      return prev_equal ? num : num + 1;
+    }
+    if (slot_num == stop - 1) {
+      return next_equal ? num : num + 1;
+    }
+    return num + 2;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief FOR(frame of reference)编码
+ * @details 小页布局：| 是否已经确定基准值(int32) | 位宽(int32) | 基准值(int64) | 每个槽位的偏移量，按位宽压缩存放 |
+ * 基准值在第一次写入时确定，取第一个值减去表示范围的一半，这样比第一个值大或者小的值都可以放进来。
+ * 位宽根据页面容量确定，大约可以表示页面容量4倍的取值范围，对于连续的ID这样的数据足够了。
+ */
+class ForCodec : public ColumnCodec
+{
+public:
+  int area_size(const ColumnDesc & /*desc*/, int capacity) const override
+  {
+    return HEADER_SIZE + packed_size(capacity, bits_for_capacity(capacity));
+  }
+
+  void init(ColumnMinipage &page) const override
+  {
+    memset(page.data, 0, HEADER_SIZE);
+    store_int32(page.data + sizeof(int32_t), bits_for_capacity(page.capacity));
+  }
+
+  bool can_write(const ColumnMinipage &page, SlotNum /*slot_num*/, const char *value) const override
+  {
+    if (!initialized(page)) {
+      return true;
+    }
+    const int64_t offset = static_cast<int64_t>(load_int32(value)) - base(page);
+    return offset >= 0 && offset < (1LL << bits(page));
+  }
+
+  void write(ColumnMinipage &page, SlotNum slot_num, const char *value) const override
+  {
+    const int64_t v = load_int32(value);
+    if (!initialized(page)) {
+      const int64_t new_base = v - (1LL << (bits(page) - 1));
+      store_int32(page.data, 1);
+      memcpy(page.data + 2 * sizeof(int32_t), &new_base, sizeof(new_base));
+    }
+    packed_set(page.data + HEADER_SIZE, bits(page), slot_num, static_cast<uint32_t>(v - base(page)));
+  }
+
+  void read(const ColumnMinipage &page, SlotNum slot_num, char *dest) const override
+  {
+    const int64_t offset = packed_get(page.data + HEADER_SIZE, bits(page), slot_num);
+    store_int32(dest, static_cast<int32_t>(base(page) + offset));
+  }
+
+  bool reencode(ColumnMinipage &page, const vector<SlotNum> &slots, SlotNum slot_num, const char *value) const override
+  {
+    // 按照所有值的范围重新选择基准值，两边留出相同的空间
+    const vector<pair<SlotNum, string>> values    = collect_values(*this, page, slots, slot_num, value);
+    int64_t                             min_value = numeric_limits<int64_t>::max();
+    int64_t                             max_value = numeric_limits<int64_t>::min();
+    for (const pair<SlotNum, string> &slot_value : values) {
+      const int64_t v = load_int32(slot_value.second.data());
+      min_value       = std::min(min_value, v);
+      max_value       = std::max(max_value, v);
+    }
+
+    const int64_t range = 1LL << bits(page);
+    if (max_value - min_value >= range) {
+      return false;
+    }
+
+    const int64_t new_base = min_value - (range - 1 - (max_value - min_value)) / 2;
+    init(page);
+    store_int32(page.data, 1);
+    memcpy(page.data + 2 * sizeof(int32_t), &new_base, sizeof(new_base));
+    for (const pair<SlotNum, string> &slot_value : values) {
+      const int64_t v = load_int32(slot_value.second.data());
+      packed_set(page.data + HEADER_SIZE, bits(page), slot_value.first, static_cast<uint32_t>(v - new_base));
+    }
+    return true;
+  }
+
+  bool prepare(const ColumnMinipage &page, CompOp comp, const Value &value, EncodedCondition &condition) const override
+  {
+    // 常量转换成相对基准值的偏移量，之后直接比较偏移量。DATES常量无法直接取出整数值，交给上层过滤
+    if (page.desc.type != INTS || value.attr_type() != INTS || !initialized(page)) {
+      condition.evaluable = false;
+      return true;
+    }
+
+    condition.evaluable = true;
+    condition.comp      = comp;
+    condition.constant  = static_cast<int64_t>(value.get_int()) - base(page);
+    return true;
+  }
+
+  bool match(const ColumnMinipage &page, SlotNum slot_num, const EncodedCondition &condition) const override
+  {
+    const int64_t offset = packed_get(page.data + HEADER_SIZE, bits(page), slot_num);
+    const int     result = offset < condition.constant ? -1 : (offset > condition.constant ? 1 : 0);
+    return compare_result_match(result, condition.comp);
+  }
+
+private:
+  static constexpr int HEADER_SIZE = 2 * sizeof(int32_t) + sizeof(int64_t);
+
+  static int bits_for_capacity(int capacity)
+  {
+    int bits = 2;
+    while (bits < 32 && (1LL << (bits - 2)) < capacity) {
+      bits++;
+    }
+    return std::max(8, bits);
+  }
+
+  static bool    initialized(const ColumnMinipage &page) { return load_int32(page.data) != 0; }
+  static int     bits(const ColumnMinipage &page) { return load_int32(page.data + sizeof(int32_t)); }
+  static int64_t base(const ColumnMinipage &page)
+  {
+    int64_t value = 0;
+    memcpy(&value, page.data + 2 * sizeof(int32_t), sizeof(value));
+    return value;
+  }
+};
+
+}  // namespace
+
+const ColumnCodec *ColumnCodec::get(ColumnEncoding encoding)
+{
+  static const PlainCodec plain_codec;
+  static const DictCodec  dict_codec;
+  static const RleCodec   rle_codec;
+  static const ForCodec   for_codec;
+
+  switch (encoding) {
+    case ColumnEncoding::DICT_ENCODING: return &dict_codec;
+    case ColumnEncoding::RLE_ENCODING: return &rle_codec;
+    case ColumnEncoding::FOR_ENCODING: return &for_codec;
+    default: return &plain_codec;
+  }
+}
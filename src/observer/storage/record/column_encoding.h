@@ -0,0 +1,171 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/types.h"
+#include "sql/parser/parse_defs.h"
+#include "sql/parser/value.h"
+
+/**
+ * @brief PAX格式页面中一列的描述，决定了这一列的小页如何存放
+ * @ingroup RecordManager
+ */
+struct ColumnDesc
+{
+  int            len      = 0;                                ///< 每个值的长度
+  AttrType       type     = UNDEFINED;                        ///< 值的类型，在编码值上计算条件时使用
+  ColumnEncoding encoding = ColumnEncoding::PLAIN_ENCODING;  ///< 编码方式
+};
+
+/**
+ * @brief 页面中某一列的小页(minipage)
+ * @ingroup RecordManager
+ */
+struct ColumnMinipage
+{
+  char      *data     = nullptr;  ///< 小页的起始位置
+  ColumnDesc desc;
+  int        capacity = 0;        ///< 页面可以存放的记录个数
+};
+
+/**
+ * @brief 扫描时下推到页面上的列过滤条件，即 `column comp value`，多个条件之间是AND的关系
+ * @ingroup RecordManager
+ * @details column 是字段在记录中的序号(包括系统字段)。这些条件只用来提前排除记录，
+ * 上层算子仍然会对返回的记录做完整的过滤
+ */
+class ColumnFilter
+{
+public:
+  struct Condition
+  {
+    int    column;
+    CompOp comp;
+    Value  value;
+  };
+
+public:
+  void add_condition(int column, CompOp comp, const Value &value) { conditions_.push_back({column, comp, value}); }
+
+  bool empty() const { return conditions_.empty(); }
+
+  const std::vector<Condition> &conditions() const { return conditions_; }
+
+private:
+  std::vector<Condition> conditions_;
+};
+
+/**
+ * @brief 某个过滤条件转换到当前页面编码上的形式，由 ColumnCodec::prepare 生成
+ * @ingroup RecordManager
+ */
+struct EncodedCondition
+{
+  int               column    = 0;
+  CompOp            comp      = NO_OP;
+  bool              evaluable = false;  ///< 能否直接在编码值上计算，不能计算的条件总是认为满足
+  int64_t           constant  = 0;      ///< FOR编码：常量相对于页面基准值的偏移
+  std::vector<bool> matches;            ///< DICT编码：每个字典项是否满足条件；RLE编码：每个run是否满足条件
+};
+
+/**
+ * @brief 列编码的实现，负责一个列小页的布局以及值的读写
+ * @ingroup RecordManager
+ * @details 编码都是页面内的：字典、游程以及FOR的基准值都存放在小页的开头，所以每个页面可以独立解码。
+ * - DICT: 页内最多 DICT_CAPACITY 个不同的值，每个槽位存放4位的字典编号，适合取值很少的CHARS字段
+ * - RLE:  按照槽位顺序存放 (起始槽位, 值) 的run，连续相同的值只存放一次
+ * - FOR:  第一次写入时确定页面的基准值，每个槽位存放相对于基准值的偏移量，按位压缩存放，适合INTS/DATES字段
+ *
+ * 编码后的小页比原始数据小，所以同样大小的页面可以存放更多的记录。代价是写入的值可能无法编码，
+ * 比如字典已经满了，或者超出了FOR的表示范围，这时 can_write 返回false，插入时会换一个页面，
+ * 更新时会把记录搬到其它页面。
+ * 编码器本身没有状态，所有信息都在小页中。
+ */
+class ColumnCodec
+{
+public:
+  virtual ~ColumnCodec() = default;
+
+  static const ColumnCodec *get(ColumnEncoding encoding);
+
+  /**
+   * @brief 页面存放 capacity 条记录时，这一列的小页需要多少字节
+   */
+  virtual int area_size(const ColumnDesc &desc, int capacity) const = 0;
+
+  /**
+   * @brief 初始化一个空的小页
+   */
+  virtual void init(ColumnMinipage &page) const = 0;
+
+  /**
+   * @brief 能否把value写到指定的槽位上，不会修改小页
+   */
+  virtual bool can_write(const ColumnMinipage &page, SlotNum slot_num, const char *value) const = 0;
+
+  /**
+   * @brief 能否原地更新指定槽位上已有的值
+   * @details 回滚时要把更新前的值写回去，所以原地更新以后必须还能写回原来的值。
+   * 字典只会增加，FOR的基准值也不会变化，能写入的值总能写回；游程编码在中间修改会拆分run，
+   * 写回时不一定还有空间，所以只允许写入相同的值
+   */
+  virtual bool can_overwrite(const ColumnMinipage &page, SlotNum slot_num, const char *value) const
+  {
+    return can_write(page, slot_num, value);
+  }
+
+  /**
+   * @brief 把value写到指定的槽位上，调用者需要先用 can_write 确认可以写入
+   */
+  virtual void write(ColumnMinipage &page, SlotNum slot_num, const char *value) const = 0;
+
+  /**
+   * @brief 把指定槽位上的值解码到dest中
+   */
+  virtual void read(const ColumnMinipage &page, SlotNum slot_num, char *dest) const = 0;
+
+  /**
+   * @brief 按照 slots 上已有的值重新编码小页，使 value 可以写到 slot_num 上
+   * @details 恢复时页面上的编码状态可能与运行时不同(比如没有落盘的页面是按照另一个顺序写入的)，
+   * 运行时能写入的值在恢复时重新编码以后就能写入。其它槽位上的值没有意义，可以被覆盖
+   * @param slots 页面上还有记录的槽位，按槽位顺序排列，不包括 slot_num
+   * @return 重新编码以后仍然放不下时返回false，小页不会被修改
+   */
+  virtual bool reencode(
+      ColumnMinipage &page, const std::vector<SlotNum> &slots, SlotNum slot_num, const char *value) const = 0;
+
+  /**
+   * @brief 把过滤条件转换成当前小页上编码值的比较
+   * @return 小页上一定没有满足条件的值时返回false
+   */
+  virtual bool prepare(const ColumnMinipage & /*page*/, CompOp /*comp*/, const Value & /*value*/,
+      EncodedCondition &condition) const
+  {
+    condition.evaluable = false;
+    return true;
+  }
+
+  /**
+   * @brief 使用编码值判断指定槽位是否可能满足条件，不需要解码
+   */
+  virtual bool match(
+      const ColumnMinipage & /*page*/, SlotNum /*slot_num*/, const EncodedCondition & /*condition*/) const
+  {
+    return true;
+  }
+};
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <functional>
 #include <limits>
 #include <sstream>
 #include <stddef.h>
@@ -128,6 +129,11 @@ public:
 
   void set_data(char *data, int len = 0)
   {
+    if (owner_ && data_ != data) {
+      // 不再指向自己管理的内存，需要先释放掉
+      this->~Record();
+      owner_ = false;
+    }
     this->data_ = data;
     this->len_  = len;
   }
@@ -144,6 +150,7 @@ public:
   char       *data() { return this->data_; }
   const char *data() const { return this->data_; }
   int         len() const { return this->len_; }
+  bool        is_owner() const { return this->owner_; }
 
   void set_rid(const RID &rid) { this->rid_ = rid; }
   void set_rid(const PageNum page_num, const SlotNum slot_num)
@@ -161,3 +168,17 @@ private:
   int   len_   = 0;      /// 如果不是record自己来管理内存，这个字段可能是无效的
   bool  owner_ = false;  /// 表示当前是否由record来管理内存
 };
+
+/**
+ * @brief 修改记录页面之后写日志的回调
+ * @details 在页面修改之后、释放页面写锁之前调用，返回日志的LSN，会立即设置到页面上。
+ * 页面刷盘时也要拿页面锁，所以磁盘上不会出现比日志更新的页面(WAL)
+ */
+using RecordLogger = std::function<LSN(const RID &rid)>;
+
+/**
+ * @brief 批量插入记录时写日志的回调
+ * @details 与 RecordLogger 一样，每个页面放入一批记录之后、释放页面写锁之前调用。
+ * 参数是这个页面上的第一条记录在这一批记录中的位置，以及放入的记录个数
+ */
+using RecordBatchLogger = std::function<LSN(int first, int num)>;
@@ -15,12 +15,17 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/bitmap.h"
 #include "common/log/log.h"
 #include "storage/common/condition_filter.h"
+#include "storage/table/table_meta.h"
 #include "storage/trx/trx.h"
 
+using namespace std;
 using namespace common;
 
 static constexpr int PAGE_HEADER_SIZE = (sizeof(PageHeader));
 
+/// PAX页面的column index中，每一列占用的int32个数：偏移量、长度、类型、编码
+static constexpr int COLUMN_INDEX_ENTRY_SIZE = 4;
+
 /**
  * @brief 8字节对齐
  * 注: ceiling(a / b) = floor((a + b - 1) / b)
@@ -54,12 +59,33 @@ int page_bitmap_size(int record_capacity) { return (record_capacity + 7) / 8; }
 RecordPageIterator::RecordPageIterator() {}
 RecordPageIterator::~RecordPageIterator() {}
 
-void RecordPageIterator::init(RecordPageHandler &record_page_handler, SlotNum start_slot_num /*=0*/)
+void RecordPageIterator::init(RecordPageHandler &record_page_handler, SlotNum start_slot_num /*=0*/,
+    const std::vector<bool> *projection /*=nullptr*/, const ColumnFilter *column_filter /*=nullptr*/)
 {
   record_page_handler_ = &record_page_handler;
   page_num_            = record_page_handler.get_page_num();
+  projection_          = projection;
+  filtering_           = false;
   bitmap_.init(record_page_handler.bitmap_, record_page_handler.page_header_->record_capacity);
-  next_slot_num_ = bitmap_.next_setted_bit(start_slot_num);
+
+  if (column_filter != nullptr && !column_filter->empty()) {
+    if (!record_page_handler.prepare_filter(*column_filter)) {
+      // 页面上一定没有满足条件的记录，比如字典中没有要查找的值
+      next_slot_num_ = -1;
+      return;
+    }
+    filtering_ = true;
+  }
+  next_slot_num_ = next_slot(start_slot_num);
+}
+
+SlotNum RecordPageIterator::next_slot(SlotNum start_slot_num)
+{
+  SlotNum slot_num = bitmap_.next_setted_bit(start_slot_num);
+  while (filtering_ && slot_num != -1 && !record_page_handler_->slot_may_match(slot_num)) {
+    slot_num = bitmap_.next_setted_bit(slot_num + 1);
+  }
+  return slot_num;
 }
 
 bool RecordPageIterator::has_next() { return -1 != next_slot_num_; }
@@ -67,10 +93,12 @@ bool RecordPageIterator::has_next() { return -1 != next_slot_num_; }
 RC RecordPageIterator::next(Record &record)
 {
   record.set_rid(page_num_, next_slot_num_);
-  record.set_data(record_page_handler_->get_record_data(record.rid().slot_num));
+  if (next_slot_num_ >= 0) {
+    record_page_handler_->read_record(next_slot_num_, record, projection_);
+  }
 
   if (next_slot_num_ >= 0) {
-    next_slot_num_ = bitmap_.next_setted_bit(next_slot_num_ + 1);
+    next_slot_num_ = next_slot(next_slot_num_ + 1);
   }
   return record.rid().slot_num != -1 ? RC::SUCCESS : RC::RECORD_EOF;
 }
@@ -79,6 +107,14 @@ RC RecordPageIterator::next(Record &record)
 
 RecordPageHandler::~RecordPageHandler() { cleanup(); }
 
+RecordPageHandler *RecordPageHandler::create(StorageFormat format)
+{
+  if (format == StorageFormat::PAX_FORMAT) {
+    return new PaxRecordPageHandler();
+  }
+  return new RecordPageHandler();
+}
+
 RC RecordPageHandler::init(DiskBufferPool &buffer_pool, PageNum page_num, bool readonly)
 {
   if (disk_buffer_pool_ != nullptr) {
@@ -105,6 +141,9 @@ RC RecordPageHandler::init(DiskBufferPool &buffer_pool, PageNum page_num, bool r
   }
   disk_buffer_pool_ = &buffer_pool;
   readonly_         = readonly;
+  recovering_       = false;
+  page_num_         = page_num;
+  page_data_        = data;
   page_header_      = (PageHeader *)(data);
   bitmap_           = data + PAGE_HEADER_SIZE;
 
@@ -119,7 +158,13 @@ RC RecordPageHandler::recover_init(DiskBufferPool &buffer_pool, PageNum page_num
     return RC::RECORD_OPENNED;
   }
 
-  RC ret = RC::SUCCESS;
+  // 页面可能还没有记录到文件头中，甚至还不在文件中
+  RC ret = buffer_pool.recover_page(page_num);
+  if (OB_FAIL(ret)) {
+    LOG_ERROR("Failed to recover page. page_num=%d, rc=%s", page_num, strrc(ret));
+    return ret;
+  }
+
   if ((ret = buffer_pool.get_this_page(page_num, &frame_)) != RC::SUCCESS) {
     LOG_ERROR("Failed to get page handle from disk buffer pool. ret=%d:%s", ret, strrc(ret));
     return ret;
@@ -130,16 +175,56 @@ RC RecordPageHandler::recover_init(DiskBufferPool &buffer_pool, PageNum page_num
   frame_->write_latch();
   disk_buffer_pool_ = &buffer_pool;
   readonly_         = false;
+  recovering_       = true;
+  page_num_         = page_num;
+  page_data_        = data;
   page_header_      = (PageHeader *)(data);
   bitmap_           = data + PAGE_HEADER_SIZE;
 
-  buffer_pool.recover_page(page_num);
-
   LOG_TRACE("Successfully init page_num %d.", page_num);
   return ret;
 }
 
-RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, PageNum page_num, int record_size)
+RC RecordPageHandler::recover_init_empty_page(int record_size, const std::vector<ColumnDesc> &columns)
+{
+  if (page_header_->record_capacity > 0) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = init_page_layout(record_size, columns);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init page layout while recovering. page_num=%d, rc=%s", page_num_, strrc(rc));
+    return rc;
+  }
+
+  bitmap_ = page_data_ + PAGE_HEADER_SIZE;
+  memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
+  frame_->mark_dirty();
+  LOG_INFO("init empty page while recovering. page_num=%d", page_num_);
+  return RC::SUCCESS;
+}
+
+RC RecordPageHandler::init_mapped(const MappedFile &mapped_file, PageNum page_num)
+{
+  cleanup();
+
+  const char *data = mapped_file.page_data(page_num);
+  if (nullptr == data) {
+    LOG_WARN("page is out of mapped file. file=%s, page_num=%d", mapped_file.file_name(), page_num);
+    return RC::BUFFERPOOL_INVALID_PAGE_NUM;
+  }
+
+  // 映射的内存是只读的，只有读取路径会访问这些指针
+  readonly_    = true;
+  page_num_    = page_num;
+  page_data_   = const_cast<char *>(data);
+  page_header_ = (PageHeader *)(page_data_);
+  bitmap_      = page_data_ + PAGE_HEADER_SIZE;
+  return RC::SUCCESS;
+}
+
+RC RecordPageHandler::init_empty_page(
+    DiskBufferPool &buffer_pool, PageNum page_num, int record_size, const std::vector<ColumnDesc> &columns)
 {
   RC ret = init(buffer_pool, page_num, false /*readonly*/);
   if (ret != RC::SUCCESS) {
@@ -147,6 +232,25 @@ RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, PageNum page_
     return ret;
   }
 
+  ret = init_page_layout(record_size, columns);
+  if (ret != RC::SUCCESS) {
+    LOG_ERROR("Failed to init page layout. page_num:record_size %d:%d, rc=%s", page_num, record_size, strrc(ret));
+    return ret;
+  }
+
+  bitmap_ = page_data_ + PAGE_HEADER_SIZE;
+  memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
+
+  if ((ret = buffer_pool.flush_page(*frame_)) != RC::SUCCESS) {
+    LOG_ERROR("Failed to flush page header %d:%d.", buffer_pool.file_desc(), page_num);
+    return ret;
+  }
+
+  return RC::SUCCESS;
+}
+
+RC RecordPageHandler::init_page_layout(int record_size, const std::vector<ColumnDesc> & /*columns*/)
+{
   page_header_->record_num          = 0;
   page_header_->record_real_size    = record_size;
   page_header_->record_size         = align8(record_size);
@@ -155,18 +259,23 @@ RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, PageNum page_
   this->fix_record_capacity();
   ASSERT(page_header_->first_record_offset + 
          page_header_->record_capacity * page_header_->record_size <= BP_PAGE_DATA_SIZE, "Record overflow the page size");
+  return RC::SUCCESS;
+}
 
-  bitmap_ = frame_->data() + PAGE_HEADER_SIZE;
-  memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
-
-  if ((ret = buffer_pool.flush_page(*frame_)) != RC::SUCCESS) {
-    LOG_ERROR("Failed to flush page header %d:%d.", buffer_pool.file_desc(), page_num);
-    return ret;
+RC RecordPageHandler::write_record(SlotNum slot_num, const char *data)
+{
+  char *record_data = get_record_data(slot_num);
+  if (record_data != data) {
+    memmove(record_data, data, page_header_->record_real_size);
   }
-
   return RC::SUCCESS;
 }
 
+void RecordPageHandler::read_record(SlotNum slot_num, Record &record, const std::vector<bool> * /*projection*/)
+{
+  record.set_data(get_record_data(slot_num), page_header_->record_real_size);
+}
+
 RC RecordPageHandler::cleanup()
 {
   if (disk_buffer_pool_ != nullptr) {
@@ -187,23 +296,23 @@ RC RecordPageHandler::insert_record(const char *data, RID *rid)
   ASSERT(readonly_ == false, "cannot insert record into page while the page is readonly");
 
   if (page_header_->record_num == page_header_->record_capacity) {
-    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), page_num_);
     return RC::RECORD_NOMEM;
   }
 
   // 找到空闲位置
   Bitmap bitmap(bitmap_, page_header_->record_capacity);
   int    index = bitmap.next_unsetted_bit(0);
-  bitmap.set_bit(index);
-  page_header_->record_num++;
 
   // assert index < page_header_->record_capacity
-  char *record_data = get_record_data(index);
-  LOG_DEBUG("record_data: %p, data: %p, len: %d", record_data, data, page_header_->record_real_size);
-  // NOTE: !!!the record size here is wrong, it should be 8 but we get 1004, don't know why
-//  memcpy(record_data, data, page_header_->record_real_size);
-    memcpy(record_data, data, 8);
+  RC rc = write_record(index, data);
+  if (OB_FAIL(rc)) {
+    LOG_TRACE("cannot store record in page. page_num=%d, rc=%s", page_num_, strrc(rc));
+    return rc;
+  }
 
+  bitmap.set_bit(index);
+  page_header_->record_num++;
   frame_->mark_dirty();
 
   if (rid) {
@@ -215,6 +324,36 @@ RC RecordPageHandler::insert_record(const char *data, RID *rid)
   return RC::SUCCESS;
 }
 
+RC RecordPageHandler::insert_records(const char *const *datas, int record_num, RID *rids, int &inserted_num)
+{
+  ASSERT(readonly_ == false, "cannot insert record into page while the page is readonly");
+
+  inserted_num = 0;
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  int    index = 0;
+  while (inserted_num < record_num && page_header_->record_num < page_header_->record_capacity) {
+    // 空闲位置只会在上一个位置之后，不需要每次都从头开始找
+    index = bitmap.next_unsetted_bit(index);
+
+    // 记录无法按照页面的编码方式存放时，剩下的记录交给其它页面
+    if (OB_FAIL(write_record(index, datas[inserted_num]))) {
+      break;
+    }
+    bitmap.set_bit(index);
+    page_header_->record_num++;
+
+    rids[inserted_num].page_num = get_page_num();
+    rids[inserted_num].slot_num = index;
+    inserted_num++;
+  }
+
+  if (inserted_num > 0) {
+    frame_->mark_dirty();
+  }
+  return RC::SUCCESS;
+}
+
 RC RecordPageHandler::recover_insert_record(const char *data, const RID &rid)
 {
   if (rid.slot_num >= page_header_->record_capacity) {
@@ -222,6 +361,13 @@ RC RecordPageHandler::recover_insert_record(const char *data, const RID &rid)
     return RC::RECORD_INVALID_RID;
   }
 
+  // 恢复数据
+  RC rc = write_record(rid.slot_num, data);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to recover record data. page_num=%d, slot_num=%d, rc=%s", page_num_, rid.slot_num, strrc(rc));
+    return rc;
+  }
+
   // 更新位图
   Bitmap bitmap(bitmap_, page_header_->record_capacity);
   if (!bitmap.get_bit(rid.slot_num)) {
@@ -229,10 +375,6 @@ RC RecordPageHandler::recover_insert_record(const char *data, const RID &rid)
     page_header_->record_num++;
   }
 
-  // 恢复数据
-  char *record_data = get_record_data(rid.slot_num);
-  memcpy(record_data, data, page_header_->record_real_size);
-
   frame_->mark_dirty();
 
   return RC::SUCCESS;
@@ -243,7 +385,7 @@ RC RecordPageHandler::delete_record(const RID *rid)
   ASSERT(readonly_ == false, "cannot delete record from page while the page is readonly");
 
   if (rid->slot_num >= page_header_->record_capacity) {
-    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, page_num %d.", rid->slot_num, frame_->page_num());
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, page_num %d.", rid->slot_num, page_num_);
     return RC::INVALID_ARGUMENT;
   }
 
@@ -252,33 +394,59 @@ RC RecordPageHandler::delete_record(const RID *rid)
     bitmap.clear_bit(rid->slot_num);
     page_header_->record_num--;
     frame_->mark_dirty();
-
-    if (page_header_->record_num == 0) {
-      // PageNum page_num = get_page_num();
-      cleanup();
-    }
     return RC::SUCCESS;
   } else {
-    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid->slot_num, page_num_);
     return RC::RECORD_NOT_EXIST;
   }
 }
 
+RC RecordPageHandler::update_record(const RID &rid, const char *data)
+{
+  ASSERT(readonly_ == false, "cannot update record in page while the page is readonly");
+
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, page_num %d.", rid.slot_num, page_num_);
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid.slot_num, page_num_);
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  RC rc = write_record(rid.slot_num, data);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("cannot store updated record in page. page_num=%d, slot_num=%d, rc=%s", page_num_, rid.slot_num, strrc(rc));
+    return rc;
+  }
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
+void RecordPageHandler::set_lsn(LSN lsn)
+{
+  if (frame_->lsn() < lsn) {
+    frame_->set_lsn(lsn);
+  }
+}
+
 RC RecordPageHandler::get_record(const RID *rid, Record *rec)
 {
   if (rid->slot_num >= page_header_->record_capacity) {
-    LOG_ERROR("Invalid slot_num:%d, exceed page's record capacity, page_num %d.", rid->slot_num, frame_->page_num());
+    LOG_ERROR("Invalid slot_num:%d, exceed page's record capacity, page_num %d.", rid->slot_num, page_num_);
     return RC::RECORD_INVALID_RID;
   }
 
   Bitmap bitmap(bitmap_, page_header_->record_capacity);
   if (!bitmap.get_bit(rid->slot_num)) {
-    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid->slot_num, page_num_);
     return RC::RECORD_NOT_EXIST;
   }
 
   rec->set_rid(*rid);
-  rec->set_data(get_record_data(rid->slot_num), page_header_->record_real_size);
+  read_record(rid->slot_num, *rec, nullptr /*projection*/);
   return RC::SUCCESS;
 }
 
@@ -287,16 +455,229 @@ PageNum RecordPageHandler::get_page_num() const
   if (nullptr == page_header_) {
     return (PageNum)(-1);
   }
-  return frame_->page_num();
+  return page_num_;
 }
 
 bool RecordPageHandler::is_full() const { return page_header_->record_num >= page_header_->record_capacity; }
 
+bool RecordPageHandler::is_empty() const { return page_header_->record_num == 0; }
+
+bool RecordPageHandler::has_record(SlotNum slot_num) const
+{
+  if (slot_num < 0 || slot_num >= page_header_->record_capacity) {
+    return false;
+  }
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  return bitmap.get_bit(slot_num);
+}
+
+int RecordPageHandler::record_num() const { return page_header_->record_num; }
+
+int RecordPageHandler::record_capacity() const { return page_header_->record_capacity; }
+
+////////////////////////////////////////////////////////////////////////////////
+
+int32_t *PaxRecordPageHandler::column_index() const
+{
+  const int bitmap_size = page_bitmap_size(page_header_->record_capacity);
+  return reinterpret_cast<int32_t *>(page_data_ + align8(PAGE_HEADER_SIZE + bitmap_size));
+}
+
+ColumnMinipage PaxRecordPageHandler::column_minipage(int i) const
+{
+  const int32_t *index = column_index() + 1 + COLUMN_INDEX_ENTRY_SIZE * i;
+
+  ColumnMinipage minipage;
+  minipage.data          = page_data_ + index[0];
+  minipage.desc.len      = index[1];
+  minipage.desc.type     = static_cast<AttrType>(index[2]);
+  minipage.desc.encoding = static_cast<ColumnEncoding>(index[3]);
+  minipage.capacity      = page_header_->record_capacity;
+  return minipage;
+}
+
+int PaxRecordPageHandler::layout_size(const std::vector<ColumnDesc> &columns, int capacity)
+{
+  const int column_num        = static_cast<int>(columns.size());
+  const int column_index_size = static_cast<int>(sizeof(int32_t)) * (1 + COLUMN_INDEX_ENTRY_SIZE * column_num);
+
+  int size = align8(PAGE_HEADER_SIZE + page_bitmap_size(capacity)) + column_index_size;
+  for (const ColumnDesc &column : columns) {
+    size += ColumnCodec::get(column.encoding)->area_size(column, capacity);
+  }
+  return size;
+}
+
+RC PaxRecordPageHandler::init_page_layout(int record_size, const std::vector<ColumnDesc> &columns)
+{
+  const int column_num = static_cast<int>(columns.size());
+  if (column_num <= 0) {
+    LOG_ERROR("PAX page requires column layout. record size=%d", record_size);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 页面占用的空间随着容量单调增长，二分查找能放下的最大容量。
+  // 列之间不需要对齐，没有编码时每条记录在页面上只占用 record_size 个字节，外加bitmap中的一位
+  int low  = 0;
+  int high = BP_PAGE_DATA_SIZE * 8;
+  while (low < high) {
+    const int mid = (low + high + 1) / 2;
+    if (layout_size(columns, mid) <= BP_PAGE_DATA_SIZE) {
+      low = mid;
+    } else {
+      high = mid - 1;
+    }
+  }
+  if (low <= 0) {
+    LOG_ERROR("record is too large to store in a PAX page. record size=%d", record_size);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const int bitmap_size = page_bitmap_size(low);
+
+  page_header_->record_num          = 0;
+  page_header_->record_real_size    = record_size;
+  page_header_->record_size         = record_size;
+  page_header_->record_capacity     = low;
+  page_header_->first_record_offset = align8(PAGE_HEADER_SIZE + bitmap_size) +
+                                      static_cast<int>(sizeof(int32_t)) * (1 + COLUMN_INDEX_ENTRY_SIZE * column_num);
+
+  int32_t *index  = column_index();
+  int      offset = page_header_->first_record_offset;
+  int      total  = 0;
+  index[0]        = column_num;
+  for (int i = 0; i < column_num; i++) {
+    const ColumnDesc  &column = columns[i];
+    const ColumnCodec *codec  = ColumnCodec::get(column.encoding);
+
+    int32_t *entry = index + 1 + COLUMN_INDEX_ENTRY_SIZE * i;
+    entry[0]       = offset;
+    entry[1]       = column.len;
+    entry[2]       = static_cast<int32_t>(column.type);
+    entry[3]       = static_cast<int32_t>(column.encoding);
+
+    ColumnMinipage minipage = column_minipage(i);
+    codec->init(minipage);
+
+    offset += codec->area_size(column, page_header_->record_capacity);
+    total += column.len;
+  }
+  ASSERT(total == record_size, "column lens don't match record size. total=%d, record size=%d", total, record_size);
+  ASSERT(offset <= BP_PAGE_DATA_SIZE, "Record overflow the page size");
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::write_record(SlotNum slot_num, const char *data)
+{
+  const int  column_num = column_index()[0];
+  Bitmap     bitmap(bitmap_, page_header_->record_capacity);
+  const bool overwrite  = !recovering_ && bitmap.get_bit(slot_num);
+
+  // 先确认每一列都可以写入，避免只写入了一部分列。
+  // 运行时只有空页面才重新编码：有记录的页面上编码状态一直不变，回滚时写回旧值总能成功，
+  // 页面变成空页面之前的记录在恢复时也不会与之后的记录混在一起，参考 TableVacuum::purge。
+  // 恢复时页面上的编码状态可能与运行时不同，写不下时按照页面上现有的记录重新编码。
+  // 重新编码不会改变已有的值，即使后面的列写不下，页面上的数据也没有变化
+  const char *column_data = data;
+  for (int i = 0; i < column_num; i++) {
+    ColumnMinipage     minipage = column_minipage(i);
+    const ColumnCodec *codec    = ColumnCodec::get(minipage.desc.encoding);
+    const bool         writable = overwrite ? codec->can_overwrite(minipage, slot_num, column_data)
+                                            : codec->can_write(minipage, slot_num, column_data);
+    if (!writable) {
+      if (!recovering_ && page_header_->record_num > 0) {
+        return RC::RECORD_NOMEM;
+      }
+
+      vector<SlotNum> slots;
+      for (int slot = bitmap.next_setted_bit(0); slot != -1; slot = bitmap.next_setted_bit(slot + 1)) {
+        if (slot != slot_num) {
+          slots.push_back(slot);
+        }
+      }
+      if (!codec->reencode(minipage, slots, slot_num, column_data)) {
+        LOG_WARN("cannot encode value in page even after reencoding. page_num=%d, slot_num=%d, column=%d",
+                 page_num_, slot_num, i);
+        return RC::RECORD_NOMEM;
+      }
+    }
+    column_data += minipage.desc.len;
+  }
+
+  column_data = data;
+  for (int i = 0; i < column_num; i++) {
+    ColumnMinipage minipage = column_minipage(i);
+    ColumnCodec::get(minipage.desc.encoding)->write(minipage, slot_num, column_data);
+    column_data += minipage.desc.len;
+  }
+  return RC::SUCCESS;
+}
+
+void PaxRecordPageHandler::read_record(SlotNum slot_num, Record &record, const std::vector<bool> *projection)
+{
+  const int record_size = page_header_->record_real_size;
+  if (!record.is_owner() || record.len() != record_size) {
+    char *data = (char *)malloc(record_size);
+    ASSERT(nullptr != data, "failed to allocate memory. size=%d", record_size);
+    record.set_data_owner(data, record_size);
+  }
+
+  char     *dest       = record.data();
+  const int column_num = column_index()[0];
+  for (int i = 0; i < column_num; i++) {
+    const ColumnMinipage minipage = column_minipage(i);
+    if (projection == nullptr || projection->empty() || (i < (int)projection->size() && (*projection)[i])) {
+      ColumnCodec::get(minipage.desc.encoding)->read(minipage, slot_num, dest);
+    } else {
+      memset(dest, 0, minipage.desc.len);
+    }
+    dest += minipage.desc.len;
+  }
+}
+
+bool PaxRecordPageHandler::prepare_filter(const ColumnFilter &filter)
+{
+  conditions_.clear();
+
+  const int column_num = column_index()[0];
+  for (const ColumnFilter::Condition &condition : filter.conditions()) {
+    if (condition.column < 0 || condition.column >= column_num) {
+      continue;
+    }
+
+    const ColumnMinipage minipage = column_minipage(condition.column);
+    if (minipage.desc.encoding == ColumnEncoding::PLAIN_ENCODING) {
+      continue;
+    }
+
+    EncodedCondition encoded_condition;
+    encoded_condition.column = condition.column;
+    if (!ColumnCodec::get(minipage.desc.encoding)->prepare(minipage, condition.comp, condition.value, encoded_condition)) {
+      return false;
+    }
+    if (encoded_condition.evaluable) {
+      conditions_.push_back(std::move(encoded_condition));
+    }
+  }
+  return true;
+}
+
+bool PaxRecordPageHandler::slot_may_match(SlotNum slot_num) const
+{
+  for (const EncodedCondition &condition : conditions_) {
+    const ColumnMinipage minipage = column_minipage(condition.column);
+    if (!ColumnCodec::get(minipage.desc.encoding)->match(minipage, slot_num, condition)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RecordFileHandler::~RecordFileHandler() { this->close(); }
 
-RC RecordFileHandler::init(DiskBufferPool *buffer_pool)
+RC RecordFileHandler::init(DiskBufferPool *buffer_pool, const TableMeta *table_meta /*=nullptr*/)
 {
   if (disk_buffer_pool_ != nullptr) {
     LOG_ERROR("record file handler has been openned.");
@@ -305,6 +686,19 @@ RC RecordFileHandler::init(DiskBufferPool *buffer_pool)
 
   disk_buffer_pool_ = buffer_pool;
 
+  if (table_meta != nullptr) {
+    storage_format_ = table_meta->storage_format();
+
+    // 页面中按照字段在记录中的顺序存放每一列，包括系统字段
+    const std::vector<FieldMeta> *field_metas = table_meta->field_metas();
+    columns_.clear();
+    for (const FieldMeta &field_meta : *field_metas) {
+      columns_.push_back(ColumnDesc{field_meta.len(), field_meta.type(), field_meta.encoding()});
+    }
+
+    zone_map_.init(std::vector<FieldMeta>(field_metas->begin() + table_meta->sys_field_num(), field_metas->end()));
+  }
+
   RC rc = init_free_pages();
 
   LOG_INFO("open record file handle done. rc=%s", strrc(rc));
@@ -350,13 +744,12 @@ RC RecordFileHandler::init_free_pages()
   return rc;
 }
 
-RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
+RC RecordFileHandler::get_insertable_page(RecordPageHandler &record_page_handler, int record_size)
 {
   RC ret = RC::SUCCESS;
 
-  RecordPageHandler record_page_handler;
-  bool              page_found       = false;
-  PageNum           current_page_num = 0;
+  bool    page_found       = false;
+  PageNum current_page_num = 0;
 
   // 当前要访问free_pages对象，所以需要加锁。在非并发编译模式下，不需要考虑这个锁
   lock_.lock();
@@ -391,7 +784,7 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
 
     current_page_num = frame->page_num();
 
-    ret = record_page_handler.init_empty_page(*disk_buffer_pool_, current_page_num, record_size);
+    ret = record_page_handler.init_empty_page(*disk_buffer_pool_, current_page_num, record_size, columns_);
     if (ret != RC::SUCCESS) {
       frame->unpin();
       LOG_ERROR("Failed to init empty page. ret:%d", ret);
@@ -402,6 +795,9 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
     // frame 在allocate_page的时候，是有一个pin的，在init_empty_page时又会增加一个，所以这里手动释放一个
     frame->unpin();
 
+    // 新页面从一开始就跟踪它的取值范围
+    zone_map_.track_page(current_page_num);
+
     // 这里的加锁顺序看起来与上面是相反的，但是不会出现死锁
     // 上面的逻辑是先加lock锁，然后加页面写锁，这里是先加上
     // 了页面写锁，然后加lock的锁，但是不会引起死锁。
@@ -410,27 +806,239 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
     free_pages_.insert(current_page_num);
     lock_.unlock();
   }
+  return ret;
+}
 
-  // 找到空闲位置
-  return record_page_handler.insert_record(data, rid);
+RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid, const RecordLogger &logger /*=nullptr*/)
+{
+  unique_ptr<RecordPageHandler> record_page_handler(create_page_handler());
+
+  RC ret = RC::SUCCESS;
+  while (true) {
+    ret = get_insertable_page(*record_page_handler, record_size);
+    if (OB_FAIL(ret)) {
+      return ret;
+    }
+
+    // 找到空闲位置
+    ret = record_page_handler->insert_record(data, rid);
+    if (ret != RC::RECORD_NOMEM || record_page_handler->is_empty()) {
+      break;
+    }
+
+    // 页面还有空闲位置，但是记录无法按照页面的编码方式存放，换一个页面
+    remove_free_page(*record_page_handler);
+  }
+
+  if (OB_SUCC(ret)) {
+    if (logger) {
+      record_page_handler->set_lsn(logger(*rid));
+    }
+    zone_map_.update(rid->page_num, data);
+  }
+  return ret;
 }
 
-RC RecordFileHandler::recover_insert_record(const char *data, int record_size, const RID &rid)
+RC RecordFileHandler::insert_records(const std::vector<const char *> &datas, int record_size, std::vector<RID> &rids,
+    const RecordBatchLogger &logger /*=nullptr*/, const RecordLogger &undo_logger /*=nullptr*/)
 {
   RC ret = RC::SUCCESS;
 
+  const int record_num = static_cast<int>(datas.size());
+  rids.resize(record_num);
+
+  int inserted_num = 0;
+  while (inserted_num < record_num) {
+    unique_ptr<RecordPageHandler> record_page_handler(create_page_handler());
+
+    ret = get_insertable_page(*record_page_handler, record_size);
+    if (OB_FAIL(ret)) {
+      break;
+    }
+
+    // 在同一次页面加锁期间，把尽可能多的记录放到这个页面中
+    int page_inserted_num = 0;
+    ret = record_page_handler->insert_records(
+        datas.data() + inserted_num, record_num - inserted_num, rids.data() + inserted_num, page_inserted_num);
+    if (OB_FAIL(ret)) {
+      LOG_WARN("failed to insert records into page. page num=%d, rc=%s", record_page_handler->get_page_num(), strrc(ret));
+      break;
+    }
+    if (page_inserted_num == 0 && record_page_handler->is_empty()) {
+      LOG_WARN("cannot store record in an empty page. page num=%d", record_page_handler->get_page_num());
+      ret = RC::RECORD_NOMEM;
+      break;
+    }
+
+    if (page_inserted_num > 0 && logger) {
+      record_page_handler->set_lsn(logger(inserted_num, page_inserted_num));
+    }
+    zone_map_.update(record_page_handler->get_page_num(), datas.data() + inserted_num, page_inserted_num);
+    inserted_num += page_inserted_num;
+
+    // 页面没有放下所有剩余的记录，说明它已经满了，或者下一条记录无法按照页面的编码方式存放
+    if (inserted_num < record_num) {
+      remove_free_page(*record_page_handler);
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+    for (int i = 0; i < inserted_num; i++) {
+      RC rc2 = delete_record(&rids[i], undo_logger);
+      if (OB_FAIL(rc2)) {
+        LOG_ERROR("failed to rollback record after batch insert failed. rid=%s, rc=%s", rids[i].to_string().c_str(), strrc(rc2));
+      }
+    }
+    rids.clear();
+  }
+  return ret;
+}
+
+void RecordFileHandler::remove_free_page(RecordPageHandler &record_page_handler)
+{
+  const PageNum page_num = record_page_handler.get_page_num();
+  record_page_handler.cleanup();
+
+  // 页面中有记录被删除时会重新加入到 free_pages_ 中
+  remove_free_page(page_num);
+}
+
+void RecordFileHandler::remove_free_page(PageNum page_num)
+{
+  lock_.lock();
+  free_pages_.erase(page_num);
+  lock_.unlock();
+}
+
+void RecordFileHandler::add_free_page(PageNum page_num)
+{
+  lock_.lock();
+  free_pages_.insert(page_num);
+  lock_.unlock();
+}
+
+RC RecordFileHandler::get_page_usages(vector<RecordPageUsage> &usages)
+{
+  RC rc = RC::SUCCESS;
+
+  BufferPoolIterator bp_iterator;
+  bp_iterator.init(*disk_buffer_pool_);
+  RecordPageHandler record_page_handler;
+  while (bp_iterator.has_next()) {
+    const PageNum page_num = bp_iterator.next();
+
+    // 只需要读取页头，不关心页面的组织格式
+    rc = record_page_handler.init(*disk_buffer_pool_, page_num, true /*readonly*/);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to init record page handler. page num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    usages.push_back(RecordPageUsage{page_num, record_page_handler.record_num(), record_page_handler.record_capacity()});
+    record_page_handler.cleanup();
+  }
+  return rc;
+}
+
+RC RecordFileHandler::get_page_records(PageNum page_num, vector<Record> &records)
+{
+  unique_ptr<RecordPageHandler> record_page_handler(create_page_handler());
+
+  RC rc = record_page_handler->init(*disk_buffer_pool_, page_num, true /*readonly*/);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init record page handler. page num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+
+  RecordPageIterator iterator;
+  iterator.init(*record_page_handler);
+  Record record;
+  while (iterator.has_next()) {
+    rc = iterator.next(record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to read record from page. page num=%d, rc=%s", page_num, strrc(rc));
+      break;
+    }
+
+    char *data = static_cast<char *>(malloc(record.len()));
+    memcpy(data, record.data(), record.len());
+    records.emplace_back();
+    records.back().set_data_owner(data, record.len());
+    records.back().set_rid(record.rid());
+  }
+  record_page_handler->cleanup();
+  return rc;
+}
+
+RC RecordFileHandler::dispose_page(PageNum page_num)
+{
+  // 拿着 lock_ 释放页面，这样插入记录时不会在这期间又选中这个页面
+  lock_guard<common::Mutex> guard(lock_);
+
   RecordPageHandler record_page_handler;
+  RC                rc = record_page_handler.init(*disk_buffer_pool_, page_num, false /*readonly*/);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init record page handler. page num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+
+  const bool is_empty = record_page_handler.is_empty();
+  record_page_handler.cleanup();
+  if (!is_empty) {
+    return RC::LOCKED_UNLOCK;
+  }
 
-  ret = record_page_handler.recover_init(*disk_buffer_pool_, rid.page_num);
+  rc = disk_buffer_pool_->dispose_page(page_num);
+  if (OB_FAIL(rc)) {
+    LOG_INFO("failed to dispose record page. page num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+
+  free_pages_.erase(page_num);
+  zone_map_.untrack_page(page_num);
+  LOG_TRACE("dispose record page %d", page_num);
+  return rc;
+}
+
+RC RecordFileHandler::recover_insert_record(const char *data, int record_size, const RID &rid,
+    vector<char> *old_data /*=nullptr*/, const RecordLogger &logger /*=nullptr*/)
+{
+  RC ret = RC::SUCCESS;
+
+  unique_ptr<RecordPageHandler> record_page_handler(create_page_handler());
+
+  ret = record_page_handler->recover_init(*disk_buffer_pool_, rid.page_num);
   if (ret != RC::SUCCESS) {
     LOG_WARN("failed to init record page handler. page num=%d, rc=%s", rid.page_num, strrc(ret));
     return ret;
   }
 
-  return record_page_handler.recover_insert_record(data, rid);
+  ret = record_page_handler->recover_init_empty_page(record_size, columns_);
+  if (OB_FAIL(ret)) {
+    return ret;
+  }
+
+  if (old_data != nullptr && record_page_handler->has_record(rid.slot_num)) {
+    Record old_record;
+    ret = record_page_handler->get_record(&rid, &old_record);
+    if (OB_FAIL(ret)) {
+      LOG_WARN("failed to get old record. rid=%s, rc=%s", rid.to_string().c_str(), strrc(ret));
+      return ret;
+    }
+    old_data->assign(old_record.data(), old_record.data() + old_record.len());
+  }
+
+  ret = record_page_handler->recover_insert_record(data, rid);
+  if (OB_SUCC(ret)) {
+    if (logger) {
+      record_page_handler->set_lsn(logger(rid));
+    }
+    zone_map_.update(rid.page_num, data);
+  }
+  return ret;
 }
 
-RC RecordFileHandler::delete_record(const RID *rid)
+RC RecordFileHandler::delete_record(const RID *rid, const RecordLogger &logger /*=nullptr*/)
 {
   RC rc = RC::SUCCESS;
 
@@ -441,6 +1049,9 @@ RC RecordFileHandler::delete_record(const RID *rid)
   }
 
   rc = page_handler.delete_record(rid);
+  if (OB_SUCC(rc) && logger) {
+    page_handler.set_lsn(logger(*rid));
+  }
   // 📢 这里注意要清理掉资源，否则会与insert_record中的加锁顺序冲突而可能出现死锁
   // delete record的加锁逻辑是拿到页面锁，删除指定记录，然后加上和释放record manager锁
   // insert record是加上 record manager锁，然后拿到指定页面锁再释放record manager锁
@@ -456,6 +1067,65 @@ RC RecordFileHandler::delete_record(const RID *rid)
   return rc;
 }
 
+RC RecordFileHandler::update_record(const RID &rid, const char *data, const RecordLogger &logger /*=nullptr*/)
+{
+  unique_ptr<RecordPageHandler> page_handler(create_page_handler());
+
+  RC rc = page_handler->init(*disk_buffer_pool_, rid.page_num, false /*readonly*/);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init record page handler.page number=%d. rc=%s", rid.page_num, strrc(rc));
+    return rc;
+  }
+
+  rc = page_handler->update_record(rid, data);
+  if (OB_SUCC(rc)) {
+    if (logger) {
+      page_handler->set_lsn(logger(rid));
+    }
+    zone_map_.update(rid.page_num, data);
+  }
+  return rc;
+}
+
+RC RecordFileHandler::recover_update_record(const RID &rid, const char *data, const RecordLogger &logger /*=nullptr*/)
+{
+  unique_ptr<RecordPageHandler> page_handler(create_page_handler());
+
+  RC rc = page_handler->recover_init(*disk_buffer_pool_, rid.page_num);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init record page handler. page num=%d, rc=%s", rid.page_num, strrc(rc));
+    return rc;
+  }
+
+  rc = page_handler->update_record(rid, data);
+  if (OB_SUCC(rc)) {
+    if (logger) {
+      page_handler->set_lsn(logger(rid));
+    }
+    zone_map_.update(rid.page_num, data);
+  }
+  return rc;
+}
+
+RC RecordFileHandler::flush_page(PageNum page_num)
+{
+  Frame *frame = nullptr;
+  RC     rc    = disk_buffer_pool_->get_this_page(page_num, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get page. page num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+
+  // 拿着页面读锁，不会写出修改了一半的页面
+  frame->read_latch();
+  if (frame->dirty()) {
+    rc = disk_buffer_pool_->flush_page(*frame);
+  }
+  frame->read_unlatch();
+  disk_buffer_pool_->unpin_page(frame);
+  return rc;
+}
+
 RC RecordFileHandler::get_record(RecordPageHandler &page_handler, const RID *rid, bool readonly, Record *rec)
 {
   if (nullptr == rid || nullptr == rec) {
@@ -472,24 +1142,35 @@ RC RecordFileHandler::get_record(RecordPageHandler &page_handler, const RID *rid
   return page_handler.get_record(rid, rec);
 }
 
-RC RecordFileHandler::visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor)
+RC RecordFileHandler::visit_record(
+    const RID &rid, bool readonly, std::function<void(Record &)> visitor, const RecordLogger &logger /*=nullptr*/)
 {
-  RecordPageHandler page_handler;
+  unique_ptr<RecordPageHandler> page_handler(create_page_handler());
 
-  RC rc = page_handler.init(*disk_buffer_pool_, rid.page_num, readonly);
+  RC rc = page_handler->init(*disk_buffer_pool_, rid.page_num, readonly);
   if (OB_FAIL(rc)) {
     LOG_ERROR("Failed to init record page handler.page number=%d", rid.page_num);
     return rc;
   }
 
   Record record;
-  rc = page_handler.get_record(&rid, &record);
+  rc = page_handler->get_record(&rid, &record);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to get record from record page handle. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
     return rc;
   }
 
   visitor(record);
+
+  if (!readonly) {
+    // 按行存放时record直接指向页面，这里只是标记页面为脏页；其它格式需要把修改后的数据写回页面
+    rc = page_handler->update_record(rid, record.data());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to write back record after visiting. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+    } else if (logger) {
+      page_handler->set_lsn(logger(rid));
+    }
+  }
   return rc;
 }
 
@@ -497,17 +1178,28 @@ RC RecordFileHandler::visit_record(const RID &rid, bool readonly, std::function<
 
 RecordFileScanner::~RecordFileScanner() { close_scan(); }
 
-RC RecordFileScanner::open_scan(
-    Table *table, DiskBufferPool &buffer_pool, Trx *trx, bool readonly, ConditionFilter *condition_filter)
+RC RecordFileScanner::open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *trx, bool readonly,
+    ConditionFilter *condition_filter, RecordFileHandler *record_handler, const ZoneMapFilter *zone_map_filter)
 {
   close_scan();
 
-  table_            = table;
-  disk_buffer_pool_ = &buffer_pool;
-  trx_              = trx;
-  readonly_         = readonly;
+  table_              = table;
+  disk_buffer_pool_   = &buffer_pool;
+  trx_                = trx;
+  readonly_           = readonly;
+  zone_map_           = record_handler != nullptr ? &record_handler->zone_map() : nullptr;
+  zone_map_filter_    = zone_map_filter;
+  skipped_page_count_ = 0;
 
-  RC rc = bp_iterator_.init(buffer_pool);
+  const StorageFormat format = record_handler != nullptr ? record_handler->storage_format() : StorageFormat::ROW_FORMAT;
+  record_page_handler_.reset(RecordPageHandler::create(format));
+
+  RC rc = RC::SUCCESS;
+  if (use_mapped_file()) {
+    rc = bp_iterator_.init(*mapped_file_);
+  } else {
+    rc = bp_iterator_.init(buffer_pool);
+  }
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -544,15 +1236,39 @@ RC RecordFileScanner::fetch_next_record()
   // 上个页面遍历完了，或者还没有开始遍历某个页面，那么就从一个新的页面开始遍历查找
   while (bp_iterator_.has_next()) {
     PageNum page_num = bp_iterator_.next();
-    record_page_handler_.cleanup();
-    rc = record_page_handler_.init(*disk_buffer_pool_, page_num, readonly_);
+    record_page_handler_->cleanup();
+
+    // 页面摘要已经说明这个页面上没有满足条件的记录，不需要访问它。
+    // 页面摘要只反映记录的最新版本，当前事务可能读到旧版本时不能跳过
+    old_versions_ = trx_ != nullptr && readonly_ && trx_->has_old_versions(table_);
+    if (!old_versions_ && zone_map_filter_ != nullptr && !zone_map_filter_->may_match(page_num)) {
+      skipped_page_count_++;
+      continue;
+    }
+
+    if (use_mapped_file()) {
+      rc = record_page_handler_->init_mapped(*mapped_file_, page_num);
+    } else {
+      rc = record_page_handler_->init(*disk_buffer_pool_, page_num, readonly_);
+    }
     if (OB_FAIL(rc)) {
       LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
     }
 
-    record_page_iterator_.init(record_page_handler_);
+    if (zone_map_ != nullptr && zone_map_->enabled() && !zone_map_->contains(page_num)) {
+      zone_map_->build_page(page_num, *record_page_handler_);
+    }
+
+    // 拿到页面锁以后再判断一次，之后这个页面上的记录不会再被修改
+    old_versions_ = trx_ != nullptr && readonly_ && trx_->has_old_versions(table_);
+    record_page_iterator_.init(
+        *record_page_handler_, 0 /*start_slot_num*/, &projection_, old_versions_ ? nullptr : column_filter_);
     rc = fetch_next_record_in_page();
+    if (rc == RC::LOCKED_NEED_WAIT) {
+      // 这个页面上还没有返回过记录，可以直接释放页面等待
+      rc = wait_for_record();
+    }
     if (rc == RC::SUCCESS || rc != RC::RECORD_EOF) {
       // 有有效记录：RC::SUCCESS
       // 或者出现了错误，rc != (RC::SUCCESS or RC::RECORD_EOF)
@@ -563,7 +1279,7 @@ RC RecordFileScanner::fetch_next_record()
 
   // 所有的页面都遍历完了，没有数据了
   next_record_.rid().slot_num = -1;
-  record_page_handler_.cleanup();
+  record_page_handler_->cleanup();
   return RC::RECORD_EOF;
 }
 
@@ -576,13 +1292,13 @@ RC RecordFileScanner::fetch_next_record_in_page()
   while (record_page_iterator_.has_next()) {
     rc = record_page_iterator_.next(next_record_);
     if (rc != RC::SUCCESS) {
-      const auto page_num = record_page_handler_.get_page_num();
+      const auto page_num = record_page_handler_->get_page_num();
       LOG_TRACE("failed to get next record from page. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
     }
 
-    // 如果有过滤条件，就用过滤条件过滤一下
-    if (condition_filter_ != nullptr && !condition_filter_->filter(next_record_)) {
+    // 如果有过滤条件，就用过滤条件过滤一下。可能读到旧版本时要等找到可见的版本以后再过滤
+    if (condition_filter_ != nullptr && !old_versions_ && !condition_filter_->filter(next_record_)) {
       continue;
     }
 
@@ -598,6 +1314,9 @@ RC RecordFileScanner::fetch_next_record_in_page()
       // 这种模式仅在 readonly 事务下是有效的
       continue;
     }
+    if (rc == RC::SUCCESS && old_versions_ && condition_filter_ != nullptr && !condition_filter_->filter(next_record_)) {
+      continue;
+    }
     return rc;
   }
 
@@ -605,6 +1324,34 @@ RC RecordFileScanner::fetch_next_record_in_page()
   return RC::RECORD_EOF;
 }
 
+RC RecordFileScanner::wait_for_record()
+{
+  RC rc = RC::LOCKED_NEED_WAIT;
+  while (rc == RC::LOCKED_NEED_WAIT) {
+    // 持有锁的事务回滚时要修改这个页面，等待之前必须释放页面
+    const RID rid = next_record_.rid();
+    record_page_handler_->cleanup();
+    lock_waiting_ = false;
+
+    rc = trx_->wait_for_record(table_, rid);
+    if (OB_FAIL(rc)) {
+      next_record_.rid().slot_num = -1;
+      return rc;
+    }
+
+    rc = record_page_handler_->init(*disk_buffer_pool_, rid.page_num, readonly_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to init record page handler after waiting for lock. page_num=%d, rc=%s", rid.page_num, strrc(rc));
+      next_record_.rid().slot_num = -1;
+      return rc;
+    }
+    record_page_iterator_.init(
+        *record_page_handler_, rid.slot_num, &projection_, old_versions_ ? nullptr : column_filter_);
+    rc = fetch_next_record_in_page();
+  }
+  return rc;
+}
+
 RC RecordFileScanner::close_scan()
 {
   if (disk_buffer_pool_ != nullptr) {
@@ -615,7 +1362,14 @@ RC RecordFileScanner::close_scan()
     condition_filter_ = nullptr;
   }
 
-  record_page_handler_.cleanup();
+  zone_map_        = nullptr;
+  zone_map_filter_ = nullptr;
+
+  if (record_page_handler_ != nullptr) {
+    record_page_handler_->cleanup();
+  }
+  page_drained_ = false;
+  lock_waiting_ = false;
 
   return RC::SUCCESS;
 }
@@ -632,3 +1386,49 @@ RC RecordFileScanner::next(Record &record)
   }
   return rc;
 }
+
+RC RecordFileScanner::next_batch(std::vector<Record> &records)
+{
+  records.clear();
+
+  RC rc = RC::SUCCESS;
+  if (lock_waiting_) {
+    // 上一批记录返回时 next_record_ 上的锁被其它事务持有，现在调用者已经不再使用上一批记录了
+    rc = wait_for_record();
+    if (rc == RC::RECORD_EOF) {
+      rc = fetch_next_record();
+    }
+    if (OB_FAIL(rc) && rc != RC::RECORD_EOF) {
+      return rc;
+    }
+  } else if (page_drained_) {
+    // 上一批记录所在的页面已经访问完了，这时才释放该页面，然后从下一个页面开始查找
+    page_drained_ = false;
+    rc            = fetch_next_record();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  if (!has_next()) {
+    return RC::RECORD_EOF;
+  }
+
+  // next_record_ 是已经预读出来的记录，把它与当前页面上剩余的可见记录一起返回
+  records.push_back(next_record_);
+  while (OB_SUCC(rc = fetch_next_record_in_page())) {
+    records.push_back(next_record_);
+  }
+
+  if (rc == RC::LOCKED_NEED_WAIT) {
+    // 已经返回的记录还指向页面，先把它们交给调用者，下一批开始之前再释放页面等待
+    lock_waiting_ = true;
+    return RC::SUCCESS;
+  }
+  if (rc != RC::RECORD_EOF) {
+    return rc;
+  }
+
+  page_drained_ = true;
+  return RC::SUCCESS;
+}
@@ -16,15 +16,19 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/lang/bitmap.h"
 #include "storage/buffer/disk_buffer_pool.h"
+#include "storage/record/column_encoding.h"
 #include "storage/record/record.h"
+#include "storage/record/zone_map.h"
 #include "storage/trx/latch_memo.h"
 #include <limits>
+#include <memory>
 #include <sstream>
 
 class ConditionFilter;
 class RecordPageHandler;
 class Trx;
 class Table;
+class TableMeta;
 
 /**
  * @brief 这里负责管理在一个文件上表记录(行)的组织/管理
@@ -51,6 +55,12 @@ class Table;
  * - RecordFileScanner：可以用来遍历整个文件上的所有记录
  * - RecordPageIterator：可以用来遍历指定页面上的所有记录
  * - PageHeader：每个页面上都会记录的页面头信息
+ *
+ * 创建表时可以选择页面内记录的组织格式(StorageFormat)，默认按行存放(ROW_FORMAT)，也可以按照PAX格式存放
+ * (PAX_FORMAT)，即同一个页面内每一列的数据连续存放在一起，只访问少数几列时可以少读很多无关的数据。
+ * 两种格式共用同样的页头、bitmap和RID，所以对RecordFileHandler的使用者来说没有区别，
+ * 可以参考 RecordPageHandler 和 PaxRecordPageHandler。
+ * PAX格式的页面中，每一列还可以选择一种轻量级的编码(ColumnEncoding)，可以参考 ColumnCodec。
  */
 
 /**
@@ -66,7 +76,7 @@ struct PageHeader
   int32_t record_real_size;     ///< 每条记录的实际大小
   int32_t record_size;          ///< 每条记录占用实际空间大小(可能对齐)
   int32_t record_capacity;      ///< 最大记录个数
-  int32_t first_record_offset;  ///< 第一条记录的偏移量
+  int32_t first_record_offset;  ///< 第一条记录的偏移量。PAX格式中表示第一个列小页的偏移量
 };
 
 /**
@@ -84,8 +94,11 @@ public:
    *
    * @param record_page_handler 负责某个页面上记录增删改查的对象
    * @param start_slot_num      从哪个记录开始扫描，默认是0
+   * @param projection          需要读取哪些列，为空表示读取所有列。仅对PAX格式的页面有效
+   * @param column_filter       列过滤条件，编码后的列可以直接在编码值上排除不满足条件的记录，不需要解码
    */
-  void init(RecordPageHandler &record_page_handler, SlotNum start_slot_num = 0);
+  void init(RecordPageHandler &record_page_handler, SlotNum start_slot_num = 0,
+      const std::vector<bool> *projection = nullptr, const ColumnFilter *column_filter = nullptr);
 
   /**
    * @brief 判断是否有下一个记录
@@ -104,11 +117,19 @@ public:
    */
   bool is_valid() const { return record_page_handler_ != nullptr; }
 
+private:
+  /**
+   * @brief 从start_slot_num开始找到下一个有记录并且可能满足过滤条件的槽位，找不到返回-1
+   */
+  SlotNum next_slot(SlotNum start_slot_num);
+
 private:
   RecordPageHandler *record_page_handler_ = nullptr;
   PageNum            page_num_            = BP_INVALID_PAGE_NUM;
   common::Bitmap     bitmap_;             ///< bitmap 的相关信息可以参考 RecordPageHandler 的说明
   SlotNum            next_slot_num_ = 0;  ///< 当前遍历到了哪一个slot
+  const std::vector<bool> *projection_ = nullptr;  ///< 需要读取的列
+  bool                     filtering_  = false;    ///< 是否需要用列过滤条件跳过记录
 };
 
 /**
@@ -120,12 +141,19 @@ private:
  * |------------|------------------------|
  * | record1 | record2 | ..... | recordN |
  * @endcode
+ * 这是按行存放的格式(ROW_FORMAT)，其它格式的页面可以继承这个类，修改页面布局以及读写单条记录的方式，
+ * 比如 PaxRecordPageHandler。
  */
 class RecordPageHandler
 {
 public:
   RecordPageHandler() = default;
-  ~RecordPageHandler();
+  virtual ~RecordPageHandler();
+
+  /**
+   * @brief 根据页面的组织格式创建对应的处理器
+   */
+  static RecordPageHandler *create(StorageFormat format);
 
   /**
    * @brief 初始化
@@ -144,14 +172,33 @@ public:
    */
   RC recover_init(DiskBufferPool &buffer_pool, PageNum page_num);
 
+  /**
+   * @brief 恢复时初始化还没有格式化的页面
+   * @details 从较早的备份恢复时，备份之后才分配的页面在文件中是空的，要先按照表的记录格式初始化。
+   * 已经初始化过的页面不做任何修改
+   */
+  RC recover_init_empty_page(int record_size, const std::vector<ColumnDesc> &columns);
+
+  /**
+   * @brief 直接访问映射到内存的页面，不经过buffer pool，也不需要加锁
+   * @details 只能读取页面上的记录，修改映射的页面会导致进程崩溃
+   *
+   * @param mapped_file 映射到内存的数据文件
+   * @param page_num    当前处理哪个页面
+   */
+  RC init_mapped(const MappedFile &mapped_file, PageNum page_num);
+
   /**
    * @brief 对一个新的页面做初始化，初始化关于该页面记录信息的页头PageHeader
    *
    * @param buffer_pool 关联某个文件时，都通过buffer pool来做读写文件
    * @param page_num    当前处理哪个页面
    * @param record_size 每个记录的大小
+   * @param columns     每一列的描述，按照列在记录中的顺序排列，它们的长度之和等于record_size。
+   *                    按行存放的页面不关心列的信息
    */
-  RC init_empty_page(DiskBufferPool &buffer_pool, PageNum page_num, int record_size);
+  RC init_empty_page(
+      DiskBufferPool &buffer_pool, PageNum page_num, int record_size, const std::vector<ColumnDesc> &columns = {});
 
   /**
    * @brief 操作结束后做的清理工作，比如释放页面、解锁
@@ -166,6 +213,16 @@ public:
    */
   RC insert_record(const char *data, RID *rid);
 
+  /**
+   * @brief 批量插入记录，尽可能多地把记录放到当前页面中
+   * @details 整个过程只在当前页面上加一次写锁(init时已经加上)，页面放满或者遇到无法编码的记录后就停止
+   * @param datas        要插入的记录
+   * @param record_num   要插入的记录个数
+   * @param rids         返回每条插入成功的记录的位置
+   * @param inserted_num 返回实际插入的记录个数，可能小于record_num
+   */
+  RC insert_records(const char *const *datas, int record_num, RID *rids, int &inserted_num);
+
   /**
    * @brief 数据库恢复时，在指定位置插入数据
    *
@@ -181,11 +238,21 @@ public:
    */
   RC delete_record(const RID *rid);
 
+  /**
+   * @brief 原地更新指定的记录，记录的位置不会发生变化
+   * @details 有编码列的页面上，新的值可能无法原地存放，这时返回 RC::RECORD_NOMEM，调用者需要把记录搬到其它页面
+   *
+   * @param rid  要更新的记录标识
+   * @param data 新的记录数据，长度与页面上记录的长度相同
+   */
+  RC update_record(const RID &rid, const char *data);
+
   /**
    * @brief 获取指定位置的记录数据
    *
    * @param rid 指定的位置
-   * @param rec 返回指定的数据。这里不会将数据复制出来，而是使用指针，所以调用者必须保证数据使用期间受到保护
+   * @param rec 返回指定的数据。按行存放时不会将数据复制出来，而是使用指针，所以调用者必须保证数据使用期间受到保护。
+   *            其它格式的页面会把数据拼成一行复制出来，修改返回的数据不会影响页面，需要调用update_record写回
    */
   RC get_record(const RID *rid, Record *rec);
 
@@ -196,10 +263,65 @@ public:
 
   /**
    * @brief 当前页面是否已经没有空闲位置插入新的记录
+   * @details 有编码列的页面即使还有空闲位置，也可能因为值无法编码而插入失败
    */
   bool is_full() const;
 
+  /**
+   * @brief 当前页面上是否没有任何记录
+   */
+  bool is_empty() const;
+
+  /**
+   * @brief 指定槽位上是否有记录
+   */
+  bool has_record(SlotNum slot_num) const;
+
+  /**
+   * @brief 当前页面上的记录个数
+   */
+  int record_num() const;
+
+  /**
+   * @brief 当前页面最多可以存放的记录个数
+   */
+  int record_capacity() const;
+
+  /**
+   * @brief 修改页面的日志写入以后，在释放页面锁之前设置页面的LSN，参考 RecordLogger
+   * @details 页面LSN只会增大
+   */
+  void set_lsn(LSN lsn);
+
 protected:
+  /**
+   * @brief 初始化新页面的页头以及页面布局，bitmap以外的部分都由这里决定
+   */
+  virtual RC init_page_layout(int record_size, const std::vector<ColumnDesc> &columns);
+
+  /**
+   * @brief 把一行数据写入到指定的槽位
+   * @return 数据无法按照页面的编码方式存放时返回 RC::RECORD_NOMEM，页面不会被修改
+   */
+  virtual RC write_record(SlotNum slot_num, const char *data);
+
+  /**
+   * @brief 读取指定槽位的记录
+   * @param projection 需要读取哪些列，为空表示所有列。按行存放时总是返回整行数据
+   */
+  virtual void read_record(SlotNum slot_num, Record &record, const std::vector<bool> *projection);
+
+  /**
+   * @brief 把列过滤条件转换成当前页面上的形式，之后使用 slot_may_match 判断每条记录
+   * @return 页面上一定没有满足条件的记录时返回false。不支持的页面总是返回true
+   */
+  virtual bool prepare_filter(const ColumnFilter & /*filter*/) { return true; }
+
+  /**
+   * @brief 指定槽位上的记录是否可能满足 prepare_filter 中的条件
+   */
+  virtual bool slot_may_match(SlotNum /*slot_num*/) const { return true; }
+
   /**
    * @details
    * 前面在计算record_capacity时并没有考虑对齐，但第一个record需要8字节对齐
@@ -223,13 +345,16 @@ protected:
    */
   char *get_record_data(SlotNum slot_num)
   {
-    return frame_->data() + page_header_->first_record_offset + (page_header_->record_size * slot_num);
+    return page_data_ + page_header_->first_record_offset + (page_header_->record_size * slot_num);
   }
 
 protected:
   DiskBufferPool *disk_buffer_pool_ = nullptr;  ///< 当前操作的buffer pool(文件)
   Frame *frame_ = nullptr;  ///< 当前操作页面关联的frame(frame的更多概念可以参考buffer pool和frame)
   bool   readonly_         = false;    ///< 当前的操作是否都是只读的
+  bool   recovering_       = false;    ///< 是否是通过 recover_init 打开的，恢复时重做日志
+  PageNum page_num_        = BP_INVALID_PAGE_NUM;  ///< 当前页面的编号
+  char   *page_data_       = nullptr;  ///< 当前页面的数据，来自frame或者映射的文件
   PageHeader *page_header_ = nullptr;  ///< 当前页面上页面头
   char       *bitmap_      = nullptr;  ///< 当前页面上record分配状态信息bitmap内存起始位置
 
@@ -237,6 +362,65 @@ private:
   friend class RecordPageIterator;
 };
 
+/**
+ * @brief 按照PAX(Partition Attributes Across)格式组织的页面
+ * @ingroup RecordManager
+ * @details 页面中的记录仍然使用bitmap和槽位来管理，但是一条记录的每一列分开存放，
+ * 同一列在所有槽位上的数据连续存放在一个小页(minipage)中：
+ * @code
+ * | PageHeader | record allocate bitmap | column index |
+ * |---------------------------------------------------|
+ * | column1: slot1 slot2 ... | column2: slot1 slot2 ... | ... | columnN: ... |
+ * @endcode
+ * column index 中先存放列的个数，然后是每一列小页的偏移量、每个值的长度、值的类型以及编码方式。
+ * 读取记录时，只需要把关心的列拼成一行，其它列不会被访问。
+ * 每一列的小页由对应的 ColumnCodec 负责读写。有编码列时，页面容量按照编码后小页的大小计算，
+ * 所以一个页面可以存放更多的记录；扫描时下推的条件也可以直接在编码值上计算。
+ */
+class PaxRecordPageHandler : public RecordPageHandler
+{
+public:
+  PaxRecordPageHandler()          = default;
+  virtual ~PaxRecordPageHandler() = default;
+
+protected:
+  RC   init_page_layout(int record_size, const std::vector<ColumnDesc> &columns) override;
+  RC   write_record(SlotNum slot_num, const char *data) override;
+  void read_record(SlotNum slot_num, Record &record, const std::vector<bool> *projection) override;
+  bool prepare_filter(const ColumnFilter &filter) override;
+  bool slot_may_match(SlotNum slot_num) const override;
+
+private:
+  /**
+   * @brief column index 在页面中的起始位置。第一个int32是列的个数，之后每一列有(偏移量, 长度, 类型, 编码)四个int32
+   */
+  int32_t *column_index() const;
+
+  /**
+   * @brief 第i列的小页
+   */
+  ColumnMinipage column_minipage(int i) const;
+
+  /**
+   * @brief 页面存放 capacity 条记录时需要的空间
+   */
+  static int layout_size(const std::vector<ColumnDesc> &columns, int capacity);
+
+private:
+  std::vector<EncodedCondition> conditions_;  ///< prepare_filter 转换后的条件
+};
+
+/**
+ * @brief 某个记录页面的使用情况
+ * @ingroup RecordManager
+ */
+struct RecordPageUsage
+{
+  PageNum page_num        = BP_INVALID_PAGE_NUM;
+  int     record_num      = 0;  ///< 页面上的记录个数
+  int     record_capacity = 0;  ///< 页面最多可以存放的记录个数
+};
+
 /**
  * @brief 管理整个文件中记录的增删改查
  * @ingroup RecordManager
@@ -252,8 +436,9 @@ public:
    * @brief 初始化
    *
    * @param buffer_pool 当前操作的是哪个文件
+   * @param table_meta  记录所属表的元数据，决定了页面的组织格式以及页面摘要跟踪哪些列。为空时按行存放
    */
-  RC init(DiskBufferPool *buffer_pool);
+  RC init(DiskBufferPool *buffer_pool, const TableMeta *table_meta = nullptr);
 
   /**
    * @brief 关闭，做一些资源清理的工作
@@ -263,9 +448,32 @@ public:
   /**
    * @brief 从指定文件中删除指定槽位的记录
    *
-   * @param rid 待删除记录的标识符
+   * @param rid    待删除记录的标识符
+   * @param logger 删除之后、释放页面锁之前写日志，可以为空
    */
-  RC delete_record(const RID *rid);
+  RC delete_record(const RID *rid, const RecordLogger &logger = nullptr);
+
+  /**
+   * @brief 原地更新指定的记录，更新后记录的标识符不变
+   * @details 新的值无法按照页面的编码方式存放时返回 RC::RECORD_NOMEM
+   *
+   * @param rid    要更新的记录标识符
+   * @param data   新的记录内容
+   * @param logger 更新之后、释放页面锁之前写日志，可以为空
+   */
+  RC update_record(const RID &rid, const char *data, const RecordLogger &logger = nullptr);
+
+  /**
+   * @brief 数据库恢复时原地更新指定的记录
+   * @details 页面上的编码状态可能与运行时不同，放不下时会按照页面上现有的记录重新编码
+   */
+  RC recover_update_record(const RID &rid, const char *data, const RecordLogger &logger = nullptr);
+
+  /**
+   * @brief 把指定页面写到磁盘上
+   * @details 整理页面时清理记录不记录日志，清理之后立即写到磁盘，恢复时就不会再看到已经清理掉的记录
+   */
+  RC flush_page(PageNum page_num);
 
   /**
    * @brief 插入一个新的记录到指定文件中，并返回该记录的标识符
@@ -273,8 +481,22 @@ public:
    * @param data        纪录内容
    * @param record_size 记录大小
    * @param rid         返回该记录的标识符
+   * @param logger      插入之后、释放页面锁之前写日志，可以为空
    */
-  RC insert_record(const char *data, int record_size, RID *rid);
+  RC insert_record(const char *data, int record_size, RID *rid, const RecordLogger &logger = nullptr);
+
+  /**
+   * @brief 批量插入多条记录
+   * @details 与逐条调用insert_record不同，这里每拿到一个有空闲位置的页面，就会在一次加锁期间
+   * 把尽可能多的记录放进去。如果中途失败，已经插入的记录会被删除掉
+   * @param datas       每条记录的内容
+   * @param record_size 记录大小
+   * @param rids        返回每条记录的标识符，与datas一一对应
+   * @param logger      每个页面放入一批记录之后、释放页面锁之前写日志，可以为空
+   * @param undo_logger 中途失败、删除已经插入的记录时写日志，可以为空
+   */
+  RC insert_records(const std::vector<const char *> &datas, int record_size, std::vector<RID> &rids,
+      const RecordBatchLogger &logger = nullptr, const RecordLogger &undo_logger = nullptr);
 
   /**
    * @brief 数据库恢复时，在指定文件指定位置插入数据
@@ -282,8 +504,11 @@ public:
    * @param data        记录内容
    * @param record_size 记录大小
    * @param rid         要插入记录的指定标识符
+   * @param old_data    指定位置上已经有记录时(比如被VACUUM清理后又复用的槽位)，返回原来的记录内容
+   * @param logger      插入之后、释放页面锁之前设置页面LSN，可以为空
    */
-  RC recover_insert_record(const char *data, int record_size, const RID &rid);
+  RC recover_insert_record(const char *data, int record_size, const RID &rid, std::vector<char> *old_data = nullptr,
+      const RecordLogger &logger = nullptr);
 
   /**
    * @brief 获取指定文件中标识符为rid的记录内容到rec指向的记录结构中
@@ -303,8 +528,53 @@ public:
    * @param rid 想要访问的记录ID
    * @param readonly 是否会修改记录
    * @param visitor  访问记录的回调函数
+   * @param logger   修改记录之后、释放页面锁之前写日志，只读访问时不使用
+   */
+  RC visit_record(
+      const RID &rid, bool readonly, std::function<void(Record &)> visitor, const RecordLogger &logger = nullptr);
+
+  /**
+   * @brief 页面的组织格式
+   */
+  StorageFormat storage_format() const { return storage_format_; }
+
+  /**
+   * @brief 创建一个与当前文件页面格式一致的页面处理器
+   */
+  RecordPageHandler *create_page_handler() const { return RecordPageHandler::create(storage_format_); }
+
+  /**
+   * @brief 每个页面的最小最大值摘要，扫描时用来跳过页面
+   */
+  ZoneMap       &zone_map() { return zone_map_; }
+  const ZoneMap &zone_map() const { return zone_map_; }
+
+  /**
+   * @brief 统计文件中每个页面的使用情况，整理页面(VACUUM)时使用
+   */
+  RC get_page_usages(std::vector<RecordPageUsage> &usages);
+
+  /**
+   * @brief 读取指定页面上所有的记录，记录数据会复制出来，不再依赖页面
+   */
+  RC get_page_records(PageNum page_num, std::vector<Record> &records);
+
+  /**
+   * @brief 插入记录时不再使用这个页面，直到页面上有记录被删除或者调用 add_free_page
+   * @details 整理页面时，要把页面上的记录搬走，不能同时有新的记录插入进来
+   */
+  void remove_free_page(PageNum page_num);
+
+  /**
+   * @brief 插入记录时可以重新使用这个页面
+   */
+  void add_free_page(PageNum page_num);
+
+  /**
+   * @brief 释放一个已经没有任何记录的页面，页面会还给buffer pool，之后可以重新分配
+   * @return 页面上还有记录，或者页面还在被其它人使用时返回 RC::LOCKED_UNLOCK
    */
-  RC visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor);
+  RC dispose_page(PageNum page_num);
 
 private:
   /**
@@ -312,10 +582,26 @@ private:
    */
   RC init_free_pages();
 
+  /**
+   * @brief 找到一个有空闲位置的页面，找不到就分配一个新的页面
+   * @details 返回时，record_page_handler 已经拿到了该页面的写锁
+   * @param record_page_handler 用来操作找到的页面
+   * @param record_size         记录大小，初始化新页面时使用
+   */
+  RC get_insertable_page(RecordPageHandler &record_page_handler, int record_size);
+
+  /**
+   * @brief 页面已经不能再插入记录，从 free_pages_ 中移除，同时释放页面
+   */
+  void remove_free_page(RecordPageHandler &record_page_handler);
+
 private:
   DiskBufferPool             *disk_buffer_pool_ = nullptr;
+  StorageFormat               storage_format_   = StorageFormat::ROW_FORMAT;  ///< 页面的组织格式
+  std::vector<ColumnDesc>     columns_;  ///< 每一列的描述，初始化PAX格式的页面时使用
   std::unordered_set<PageNum> free_pages_;  ///< 没有填充满的页面集合
   common::Mutex               lock_;  ///< 当编译时增加-DCONCURRENCY=ON 选项时，才会真正的支持并发
+  ZoneMap                     zone_map_;  ///< 页面的最小最大值摘要
 };
 
 /**
@@ -337,14 +623,36 @@ public:
    * @param readonly         当前是否只读操作。访问数据时，需要对页面加锁。比如
    *                         删除时也需要遍历找到数据，然后删除，这时就需要加写锁
    * @param condition_filter 做一些初步过滤操作
+   * @param record_handler   文件对应的记录管理器，用来确定页面格式，以及为还没有页面摘要的页面建立摘要。
+   *                         为空时按行存放的格式访问页面
+   * @param zone_map_filter  使用页面摘要过滤页面，无法满足条件的页面不会被访问
    */
-  RC open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *trx, bool readonly, ConditionFilter *condition_filter);
+  RC open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *trx, bool readonly, ConditionFilter *condition_filter,
+      RecordFileHandler *record_handler = nullptr, const ZoneMapFilter *zone_map_filter = nullptr);
 
   /**
    * @brief 关闭一个文件扫描，释放相应的资源
    */
   RC close_scan();
 
+  /**
+   * @brief 设置需要读取的列，按照字段在表中的顺序排列(包括系统字段)。需要在open_scan之前设置
+   * @details 只对PAX格式的页面有效，没有设置的列不会被读取，返回的记录中对应的数据是0
+   */
+  void set_projection(const std::vector<bool> &projection) { projection_ = projection; }
+
+  /**
+   * @brief 设置下推到页面上的列过滤条件，需要在open_scan之前设置
+   * @details 编码后的列可以直接在编码值上排除不满足条件的记录。调用者需要保证扫描期间filter有效
+   */
+  void set_column_filter(const ColumnFilter *column_filter) { column_filter_ = column_filter; }
+
+  /**
+   * @brief 设置映射到内存的数据文件，需要在open_scan之前设置
+   * @details 只读扫描时直接从映射的文件中读取页面，不经过buffer pool。调用者需要保证文件映射之后没有被修改
+   */
+  void set_mapped_file(std::shared_ptr<MappedFile> mapped_file) { mapped_file_ = std::move(mapped_file); }
+
   /**
    * @brief 判断是否还有数据
    * @details 判断完成后调用next获取下一条数据
@@ -360,6 +668,22 @@ public:
    */
   RC next(Record &record);
 
+  /**
+   * @brief 按页面批量获取记录，一次返回当前页面上所有可见的记录
+   * @details 每个页面只加一次锁，返回的记录不会复制数据，而是直接指向页面内存。页面锁会一直保留到
+   * 下一次调用 next_batch 或者 close_scan，所以调用者在此期间可以安全地访问(或修改)这批记录。
+   * 修改时遇到被其它事务锁住的记录，先返回这条记录之前的一批，下一次调用时释放页面等待行锁。
+   * 不要与 has_next/next 混用。
+   * @param records 返回的一批记录，至少包含一条记录
+   * @return RC::SUCCESS 成功，RC::RECORD_EOF 没有更多数据，其它表示出错
+   */
+  RC next_batch(std::vector<Record> &records);
+
+  /**
+   * @brief 因为页面摘要不满足条件而跳过的页面个数
+   */
+  int skipped_page_count() const { return skipped_page_count_; }
+
 private:
   /**
    * @brief 获取该文件中的下一条记录
@@ -371,6 +695,18 @@ private:
    */
   RC fetch_next_record_in_page();
 
+  /**
+   * @brief 释放页面，等待 next_record_ 上的行锁，然后从这条记录开始继续遍历它所在的页面
+   * @details 调用时不能还有正在使用的、指向当前页面的记录
+   * @return RC::RECORD_EOF 表示这个页面已经遍历完了
+   */
+  RC wait_for_record();
+
+  /**
+   * @brief 只读扫描并且设置了映射文件时，不经过buffer pool访问页面
+   */
+  bool use_mapped_file() const { return readonly_ && mapped_file_ != nullptr; }
+
 private:
   // TODO 对于一个纯粹的record遍历器来说，不应该关心表和事务
   Table *table_ = nullptr;  ///< 当前遍历的是哪张表。这个字段仅供事务函数使用，如果设计合适，可以去掉
@@ -379,9 +715,18 @@ private:
   Trx            *trx_              = nullptr;  ///< 当前是哪个事务在遍历
   bool            readonly_         = false;    ///< 遍历出来的数据，是否可能对它做修改
 
-  BufferPoolIterator bp_iterator_;                 ///< 遍历buffer pool的所有页面
-  ConditionFilter   *condition_filter_ = nullptr;  ///< 过滤record
-  RecordPageHandler  record_page_handler_;         ///< 处理文件某页面的记录
-  RecordPageIterator record_page_iterator_;        ///< 遍历某个页面上的所有record
-  Record             next_record_;                 ///< 获取的记录放在这里缓存起来
+  BufferPoolIterator                 bp_iterator_;                ///< 遍历buffer pool的所有页面
+  std::shared_ptr<MappedFile>        mapped_file_;                ///< 只读扫描时直接访问的映射文件
+  ConditionFilter                   *condition_filter_ = nullptr;  ///< 过滤record
+  std::unique_ptr<RecordPageHandler> record_page_handler_;         ///< 处理文件某页面的记录
+  RecordPageIterator                 record_page_iterator_;        ///< 遍历某个页面上的所有record
+  Record                             next_record_;                 ///< 获取的记录放在这里缓存起来
+  bool page_drained_ = false;  ///< next_batch 已经返回了当前页面的所有记录，还没有切换到下一个页面
+  bool lock_waiting_ = false;  ///< next_record_ 被其它事务锁住了，下一次 next_batch 时等待
+  std::vector<bool>    projection_;                    ///< 需要读取的列，为空表示所有列
+  const ColumnFilter  *column_filter_      = nullptr;  ///< 列过滤条件
+  ZoneMap             *zone_map_           = nullptr;  ///< 页面摘要
+  const ZoneMapFilter *zone_map_filter_    = nullptr;  ///< 使用页面摘要过滤页面
+  int                  skipped_page_count_ = 0;        ///< 跳过的页面个数
+  bool old_versions_ = false;  ///< 当前页面上的记录可能读到旧版本，这时页面上的数据不能用来提前过滤
 };
\ No newline at end of file
@@ -0,0 +1,248 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#include "storage/record/zone_map.h"
+#include "common/log/log.h"
+#include "storage/record/record_manager.h"
+
+using namespace std;
+
+static bool is_numeric_type(AttrType type) { return type == INTS || type == FLOATS; }
+
+void ZoneMap::init(const vector<FieldMeta> &field_metas)
+{
+  lock_guard<common::Mutex> guard(lock_);
+  fields_.clear();
+  pages_.clear();
+  for (const FieldMeta &field_meta : field_metas) {
+    const AttrType type = field_meta.type();
+    if (is_numeric_type(type) || type == DATES) {
+      fields_.push_back(field_meta);
+    }
+  }
+}
+
+int ZoneMap::column_index(const FieldMeta &field_meta) const
+{
+  for (size_t i = 0; i < fields_.size(); i++) {
+    if (fields_[i].offset() == field_meta.offset()) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void ZoneMap::track_page(PageNum page_num)
+{
+  if (!enabled()) {
+    return;
+  }
+
+  lock_guard<common::Mutex> guard(lock_);
+  pages_[page_num] = vector<Range>(fields_.size());
+}
+
+void ZoneMap::untrack_page(PageNum page_num)
+{
+  lock_guard<common::Mutex> guard(lock_);
+  pages_.erase(page_num);
+}
+
+void ZoneMap::build_page(PageNum page_num, RecordPageHandler &page_handler)
+{
+  if (!enabled()) {
+    return;
+  }
+
+  vector<Range> ranges(fields_.size());
+
+  RecordPageIterator iterator;
+  iterator.init(page_handler);
+  Record record;
+  while (iterator.has_next()) {
+    if (OB_FAIL(iterator.next(record))) {
+      LOG_WARN("failed to iterate page while building zone map. page num=%d", page_num);
+      return;
+    }
+    update_ranges(ranges, record.data());
+  }
+
+  lock_guard<common::Mutex> guard(lock_);
+  // 并发扫描时可能有其它线程先建立好了摘要，两者的结果是一样的
+  pages_.emplace(page_num, std::move(ranges));
+}
+
+void ZoneMap::update(PageNum page_num, const char *record) { update(page_num, &record, 1); }
+
+void ZoneMap::update(PageNum page_num, const char *const *records, int record_num)
+{
+  if (!enabled()) {
+    return;
+  }
+
+  lock_guard<common::Mutex> guard(lock_);
+  auto iter = pages_.find(page_num);
+  if (iter == pages_.end()) {
+    // 启动前就存在的页面，等第一次扫描时再建立摘要
+    return;
+  }
+
+  for (int i = 0; i < record_num; i++) {
+    update_ranges(iter->second, records[i]);
+  }
+}
+
+bool ZoneMap::contains(PageNum page_num) const
+{
+  lock_guard<common::Mutex> guard(lock_);
+  return pages_.count(page_num) > 0;
+}
+
+bool ZoneMap::range(PageNum page_num, int column, Range &range) const
+{
+  lock_guard<common::Mutex> guard(lock_);
+  auto iter = pages_.find(page_num);
+  if (iter == pages_.end()) {
+    return false;
+  }
+
+  range = iter->second[column];
+  return true;
+}
+
+vector<PageNum> ZoneMap::pages() const
+{
+  lock_guard<common::Mutex> guard(lock_);
+  vector<PageNum> page_nums;
+  page_nums.reserve(pages_.size());
+  for (const auto &iter : pages_) {
+    page_nums.push_back(iter.first);
+  }
+  return page_nums;
+}
+
+void ZoneMap::update_ranges(vector<Range> &ranges, const char *record) const
+{
+  for (size_t i = 0; i < fields_.size(); i++) {
+    const FieldMeta &field_meta = fields_[i];
+
+    Value value;
+    value.set_type(field_meta.type());
+    value.set_data(record + field_meta.offset(), field_meta.len());
+
+    Range &range = ranges[i];
+    if (range.empty) {
+      range.empty = false;
+      range.min   = value;
+      range.max   = value;
+      continue;
+    }
+
+    if (value.compare(range.min) < 0) {
+      range.min = value;
+    }
+    if (value.compare(range.max) > 0) {
+      range.max = value;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ZoneMapFilter::add_condition(const FieldMeta &field_meta, CompOp comp, const Value &value)
+{
+  if (zone_map_ == nullptr) {
+    return false;
+  }
+
+  const int column = zone_map_->column_index(field_meta);
+  if (column < 0) {
+    return false;
+  }
+
+  const AttrType field_type = field_meta.type();
+  const AttrType value_type = value.attr_type();
+  const bool     comparable = (is_numeric_type(field_type) && is_numeric_type(value_type)) ||
+                          (field_type == DATES && value_type == DATES);
+  if (!comparable) {
+    return false;
+  }
+
+  switch (comp) {
+    case EQUAL_TO:
+    case NOT_EQUAL:
+    case LESS_THAN:
+    case LESS_EQUAL:
+    case GREAT_THAN:
+    case GREAT_EQUAL: {
+      conditions_.push_back(Condition{column, comp, value});
+    } break;
+    default: {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ZoneMapFilter::may_match(PageNum page_num) const
+{
+  if (empty()) {
+    return true;
+  }
+
+  ZoneMap::Range range;
+  for (const Condition &condition : conditions_) {
+    if (!zone_map_->range(page_num, condition.column, range)) {
+      return true;
+    }
+
+    if (!range_may_match(range, condition)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int ZoneMapFilter::skippable_page_count() const
+{
+  if (empty()) {
+    return 0;
+  }
+
+  int count = 0;
+  for (PageNum page_num : zone_map_->pages()) {
+    if (!may_match(page_num)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+bool ZoneMapFilter::range_may_match(const ZoneMap::Range &range, const Condition &condition)
+{
+  if (range.empty) {
+    return false;
+  }
+
+  const Value &value = condition.value;
+  switch (condition.comp) {
+    case EQUAL_TO: return range.min.compare(value) <= 0 && range.max.compare(value) >= 0;
+    case NOT_EQUAL: return !(range.min.compare(value) == 0 && range.max.compare(value) == 0);
+    case LESS_THAN: return range.min.compare(value) < 0;
+    case LESS_EQUAL: return range.min.compare(value) <= 0;
+    case GREAT_THAN: return range.max.compare(value) > 0;
+    case GREAT_EQUAL: return range.max.compare(value) >= 0;
+    default: return true;
+  }
+}
@@ -0,0 +1,158 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "common/lang/mutex.h"
+#include "common/types.h"
+#include "sql/parser/parse_defs.h"
+#include "sql/parser/value.h"
+#include "storage/field/field_meta.h"
+
+class RecordPageHandler;
+
+/**
+ * @brief 页面级别的数据摘要(zone map)，记录每个页面上每个数值/日期字段的最小值和最大值
+ * @ingroup RecordManager
+ * @details 扫描时，如果某个页面的最小最大值无法满足下推的比较条件，就可以直接跳过这个页面。
+ * 摘要只放在内存中：本次运行中新分配的页面从一开始就会被跟踪，插入和更新时会扩大范围；
+ * 启动前就存在的页面，在第一次被完整扫描时建立摘要。
+ * 删除记录时不会缩小范围，所以摘要总是保守的，不会错误地跳过页面。
+ */
+class ZoneMap
+{
+public:
+  /**
+   * @brief 某个页面上某个字段的取值范围
+   */
+  struct Range
+  {
+    bool  empty = true;  ///< 页面上还没有记录
+    Value min;
+    Value max;
+  };
+
+public:
+  ZoneMap()  = default;
+  ~ZoneMap() = default;
+
+  /**
+   * @brief 初始化需要跟踪的字段，仅跟踪INTS、FLOATS和DATES类型
+   *
+   * @param field_metas 表的所有用户字段
+   */
+  void init(const std::vector<FieldMeta> &field_metas);
+
+  /**
+   * @brief 有没有需要跟踪的字段
+   */
+  bool enabled() const { return !fields_.empty(); }
+
+  /**
+   * @brief 返回某个字段是第几个跟踪的字段，没有跟踪返回-1
+   */
+  int column_index(const FieldMeta &field_meta) const;
+
+  /**
+   * @brief 开始跟踪一个新的空页面
+   */
+  void track_page(PageNum page_num);
+
+  /**
+   * @brief 页面被释放后，不再跟踪它
+   */
+  void untrack_page(PageNum page_num);
+
+  /**
+   * @brief 使用页面上现有的所有记录建立页面的摘要
+   * @details 调用者需要拿着页面锁
+   */
+  void build_page(PageNum page_num, RecordPageHandler &page_handler);
+
+  /**
+   * @brief 记录被插入或者更新到了某个页面上，扩大该页面的取值范围
+   * @details 调用者需要拿着页面写锁。页面没有被跟踪时什么都不做
+   */
+  void update(PageNum page_num, const char *record);
+  void update(PageNum page_num, const char *const *records, int record_num);
+
+  bool contains(PageNum page_num) const;
+
+  /**
+   * @brief 获取某个页面上某个字段的取值范围
+   * @return 页面没有被跟踪时返回false
+   */
+  bool range(PageNum page_num, int column, Range &range) const;
+
+  /**
+   * @brief 当前跟踪的所有页面
+   */
+  std::vector<PageNum> pages() const;
+
+private:
+  void update_ranges(std::vector<Range> &ranges, const char *record) const;
+
+private:
+  std::vector<FieldMeta>                          fields_;  ///< 跟踪的字段
+  std::unordered_map<PageNum, std::vector<Range>> pages_;   ///< 每个页面上每个字段的取值范围
+  mutable common::Mutex                           lock_;
+};
+
+/**
+ * @brief 使用zone map过滤页面的条件，多个条件之间是AND的关系
+ * @ingroup RecordManager
+ */
+class ZoneMapFilter
+{
+public:
+  ZoneMapFilter() = default;
+
+  void init(const ZoneMap *zone_map) { zone_map_ = zone_map; }
+
+  /**
+   * @brief 增加一个比较条件，即 `field comp value`
+   * @return 字段没有被跟踪或者值的类型无法比较时返回false，条件不会被加入
+   */
+  bool add_condition(const FieldMeta &field_meta, CompOp comp, const Value &value);
+
+  bool empty() const { return zone_map_ == nullptr || conditions_.empty(); }
+
+  /**
+   * @brief 页面上是否可能存在满足所有条件的记录
+   * @details 没有被跟踪的页面总是返回true
+   */
+  bool may_match(PageNum page_num) const;
+
+  /**
+   * @brief 统计当前被跟踪的页面中，会被跳过的页面个数
+   */
+  int skippable_page_count() const;
+
+private:
+  struct Condition
+  {
+    int    column;
+    CompOp comp;
+    Value  value;
+  };
+
+  static bool range_may_match(const ZoneMap::Range &range, const Condition &condition);
+
+private:
+  const ZoneMap         *zone_map_ = nullptr;
+  std::vector<Condition> conditions_;
+};
@@ -20,7 +20,9 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/string.h"
 #include "common/log/log.h"
 #include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/mapped_file.h"
 #include "storage/common/condition_filter.h"
+#include "storage/common/file_copy.h"
 #include "storage/common/meta_util.h"
 #include "storage/index/bplus_tree_index.h"
 #include "storage/index/index.h"
@@ -51,7 +53,7 @@ Table::~Table()
 }
 
 RC Table::create(int32_t table_id, const char *path, const char *name, const char *base_dir, int attribute_count,
-    const AttrInfoSqlNode attributes[])
+    const AttrInfoSqlNode attributes[], StorageFormat storage_format /*=ROW_FORMAT*/)
 {
   if (table_id < 0) {
     LOG_WARN("invalid table id. table_id=%d, table_name=%s", table_id, name);
@@ -86,7 +88,7 @@ RC Table::create(int32_t table_id, const char *path, const char *name, const cha
   close(fd);
 
   // 创建文件
-  if ((rc = table_meta_.init(table_id, name, attribute_count, attributes)) != RC::SUCCESS) {
+  if ((rc = table_meta_.init(table_id, name, attribute_count, attributes, storage_format)) != RC::SUCCESS) {
     LOG_ERROR("Failed to init table meta. name:%s, ret:%d", name, rc);
     return rc;  // delete table file
   }
@@ -122,7 +124,7 @@ RC Table::create(int32_t table_id, const char *path, const char *name, const cha
   return rc;
 }
 
-RC Table::open(const char *meta_file, const char *base_dir)
+RC Table::open(const char *meta_file, const char *base_dir, bool allow_legacy_xid /*=false*/)
 {
   // 加载元数据文件
   std::fstream fs;
@@ -139,6 +141,18 @@ RC Table::open(const char *meta_file, const char *base_dir)
   }
   fs.close();
 
+  // 事务号改成64位之前创建的表，事务号字段只有4个字节，不能直接打开，需要先用 xid_upgrade 离线升级
+  const std::pair<const FieldMeta *, int> trx_fields         = table_meta_.trx_fields();
+  const std::vector<FieldMeta>           *current_trx_fields = TrxKit::instance()->trx_fields();
+  for (int i = 0; !allow_legacy_xid && current_trx_fields != nullptr && i < trx_fields.second; i++) {
+    if (i < static_cast<int>(current_trx_fields->size()) && trx_fields.first[i].len() != (*current_trx_fields)[i].len()) {
+      LOG_ERROR("Table was created with %d bytes transaction id fields, upgrade the database with xid_upgrade first. "
+                "table=%s, field=%s",
+                trx_fields.first[i].len(), table_meta_.name(), trx_fields.first[i].name());
+      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+    }
+  }
+
   // 加载数据文件
   RC rc = init_record_handler(base_dir);
   if (rc != RC::SUCCESS) {
@@ -149,6 +163,15 @@ RC Table::open(const char *meta_file, const char *base_dir)
 
   base_dir_ = base_dir;
 
+  if (table_meta_.read_only()) {
+    // 映射失败时仍然可以通过buffer pool访问数据
+    rc = init_mapped_file();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to map data file of read only table. table=%s, rc=%s", name(), strrc(rc));
+      rc = RC::SUCCESS;
+    }
+  }
+
   const int index_num = table_meta_.index_num();
   for (int i = 0; i < index_num; i++) {
     const IndexMeta *index_meta = table_meta_.index(i);
@@ -179,10 +202,10 @@ RC Table::open(const char *meta_file, const char *base_dir)
   return rc;
 }
 
-RC Table::insert_record(Record &record)
+RC Table::insert_record(Record &record, const RecordLogger &logger /*=nullptr*/, const RecordLogger &undo_logger /*=nullptr*/)
 {
   RC rc = RC::SUCCESS;
-  rc    = record_handler_->insert_record(record.data(), table_meta_.record_size(), &record.rid());
+  rc    = record_handler_->insert_record(record.data(), table_meta_.record_size(), &record.rid(), logger);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Insert record failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
     return rc;
@@ -195,7 +218,8 @@ RC Table::insert_record(Record &record)
       LOG_ERROR("Failed to rollback index data when insert index entries failed. table name=%s, rc=%d:%s",
                 name(), rc2, strrc(rc2));
     }
-    rc2 = record_handler_->delete_record(&record.rid());
+    // 插入记录的日志已经写了，删除也要写日志，否则恢复时会重做出这条记录
+    rc2 = record_handler_->delete_record(&record.rid(), undo_logger);
     if (rc2 != RC::SUCCESS) {
       LOG_PANIC("Failed to rollback record data when insert index entries failed. table name=%s, rc=%d:%s",
                 name(), rc2, strrc(rc2));
@@ -204,9 +228,54 @@ RC Table::insert_record(Record &record)
   return rc;
 }
 
-RC Table::visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor)
+RC Table::insert_records(std::vector<Record> &records, const RecordBatchLogger &logger /*=nullptr*/,
+    const RecordLogger &undo_logger /*=nullptr*/)
+{
+  std::vector<const char *> datas;
+  datas.reserve(records.size());
+  for (const Record &record : records) {
+    datas.push_back(record.data());
+  }
+
+  // 写日志时要用到这批记录的RID
+  std::vector<RID>  rids;
+  RecordBatchLogger page_logger = nullptr;
+  if (logger) {
+    page_logger = [&records, &rids, &logger](int first, int num) {
+      for (int i = first; i < first + num; i++) {
+        records[i].set_rid(rids[i]);
+      }
+      return logger(first, num);
+    };
+  }
+  RC rc = record_handler_->insert_records(datas, table_meta_.record_size(), rids, page_logger, undo_logger);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Insert records failed. table name=%s, record num=%d, rc=%s",
+              table_meta_.name(), static_cast<int>(records.size()), strrc(rc));
+    return rc;
+  }
+
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].set_rid(rids[i]);
+  }
+
+  rc = insert_entries_of_indexes(records);
+  if (rc != RC::SUCCESS) {  // 可能出现了键值重复
+    for (Record &record : records) {
+      RC rc2 = record_handler_->delete_record(&record.rid(), undo_logger);
+      if (rc2 != RC::SUCCESS) {
+        LOG_PANIC("Failed to rollback record data when insert index entries failed. table name=%s, rc=%d:%s",
+                  name(), rc2, strrc(rc2));
+      }
+    }
+  }
+  return rc;
+}
+
+RC Table::visit_record(
+    const RID &rid, bool readonly, std::function<void(Record &)> visitor, const RecordLogger &logger /*=nullptr*/)
 {
-  return record_handler_->visit_record(rid, readonly, visitor);
+  return record_handler_->visit_record(rid, readonly, visitor, logger);
 }
 
 RC Table::get_record(const RID &rid, Record &record)
@@ -230,15 +299,27 @@ RC Table::get_record(const RID &rid, Record &record)
   return rc;
 }
 
-RC Table::recover_insert_record(Record &record)
+RC Table::recover_insert_record(Record &record, const RecordLogger &logger /*=nullptr*/)
 {
-  RC rc = RC::SUCCESS;
-  rc    = record_handler_->recover_insert_record(record.data(), table_meta_.record_size(), record.rid());
+  RC                rc = RC::SUCCESS;
+  std::vector<char> old_data;
+  rc = record_handler_->recover_insert_record(
+      record.data(), table_meta_.record_size(), record.rid(), &old_data, logger);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Insert record failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
     return rc;
   }
 
+  // 槽位上原来的记录可能已经被清理(VACUUM)过，槽位又被新的记录复用，它的索引项也要一起删掉
+  if (!old_data.empty()) {
+    rc = delete_entry_of_indexes(old_data.data(), record.rid(), false /*error_on_not_exists*/);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to delete index entries of overwritten record. table name=%s, rid=%s, rc=%s",
+                name(), record.rid().to_string().c_str(), strrc(rc));
+      return rc;
+    }
+  }
+
   rc = insert_entry_of_indexes(record.data(), record.rid());
   if (rc != RC::SUCCESS) {  // 可能出现了键值重复
     RC rc2 = delete_entry_of_indexes(record.data(), record.rid(), false /*error_on_not_exists*/);
@@ -282,6 +363,7 @@ RC Table::make_record(int value_num, const Value *values, Record &record)
   // 复制所有字段的值
   int   record_size = table_meta_.record_size();
   char *record_data = (char *)malloc(record_size);
+  memset(record_data, 0, record_size);
 
   for (int i = 0; i < value_num; i++) {
     const FieldMeta *field    = table_meta_.field(i + normal_field_start_index);
@@ -314,7 +396,7 @@ RC Table::init_record_handler(const char *base_dir)
 
   record_handler_ = new RecordFileHandler();
 
-  rc = record_handler_->init(data_buffer_pool_);
+  rc = record_handler_->init(data_buffer_pool_, &table_meta_);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to init record handler. rc=%s", strrc(rc));
     data_buffer_pool_->close_file();
@@ -327,9 +409,13 @@ RC Table::init_record_handler(const char *base_dir)
   return rc;
 }
 
-RC Table::get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly)
+RC Table::get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly,
+    const ZoneMapFilter *zone_map_filter, ConditionFilter *condition_filter)
 {
-  RC rc = scanner.open_scan(this, *data_buffer_pool_, trx, readonly, nullptr);
+  // 表可能正在切换只读状态，拿到的映射文件在扫描期间都是有效的
+  scanner.set_mapped_file(std::atomic_load(&mapped_file_));
+  RC rc = scanner.open_scan(
+      this, *data_buffer_pool_, trx, readonly, condition_filter, record_handler_, zone_map_filter);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("failed to open scanner. rc=%s", strrc(rc));
   }
@@ -400,6 +486,18 @@ RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_
     return rc;
   }
 
+  rc = write_meta(new_table_meta);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to write table meta while creating index (%s) on table (%s). rc=%s", index_name, name(), strrc(rc));
+    return rc;  // 创建索引中途出错，要做还原操作
+  }
+
+  LOG_INFO("Successfully added a new index (%s) on the table (%s)", index_name, name());
+  return rc;
+}
+
+RC Table::write_meta(TableMeta &new_table_meta)
+{
   /// 内存中有一份元数据，磁盘文件也有一份元数据。修改磁盘文件时，先创建一个临时文件，写入完成后再rename为正式文件
   /// 这样可以防止文件内容不完整
   // 创建元数据临时文件
@@ -408,7 +506,7 @@ RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_
   fs.open(tmp_file, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
   if (!fs.is_open()) {
     LOG_ERROR("Failed to open file for write. file name=%s, errmsg=%s", tmp_file.c_str(), strerror(errno));
-    return RC::IOERR_OPEN;  // 创建索引中途出错，要做还原操作
+    return RC::IOERR_OPEN;
   }
   if (new_table_meta.serialize(fs) < 0) {
     LOG_ERROR("Failed to dump new table meta to file: %s. sys err=%d:%s", tmp_file.c_str(), errno, strerror(errno));
@@ -421,15 +519,69 @@ RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_
 
   int ret = rename(tmp_file.c_str(), meta_file.c_str());
   if (ret != 0) {
-    LOG_ERROR("Failed to rename tmp meta file (%s) to normal meta file (%s) while creating index (%s) on table (%s). "
-              "system error=%d:%s",
-              tmp_file.c_str(), meta_file.c_str(), index_name, name(), errno, strerror(errno));
+    LOG_ERROR("Failed to rename tmp meta file (%s) to normal meta file (%s) on table (%s). system error=%d:%s",
+              tmp_file.c_str(), meta_file.c_str(), name(), errno, strerror(errno));
     return RC::IOERR_WRITE;
   }
 
   table_meta_.swap(new_table_meta);
 
-  LOG_INFO("Successfully added a new index (%s) on the table (%s)", index_name, name());
+  return RC::SUCCESS;
+}
+
+RC Table::set_read_only(bool read_only)
+{
+  if (table_meta_.read_only() == read_only) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = RC::SUCCESS;
+  if (read_only) {
+    // 映射的文件直接读取磁盘上的页面，所以要先把buffer pool中的修改都写回去。
+    // 只读的记录上不能再改写事务号，写回之前先把已经提交的事务号改写掉
+    TrxKit::instance()->rewrite_committed_xids();
+    rc = data_buffer_pool_->flush_all_pages();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to flush data pages. table=%s, rc=%s", name(), strrc(rc));
+      return rc;
+    }
+  }
+
+  TableMeta new_table_meta(table_meta_);
+  new_table_meta.set_read_only(read_only);
+  rc = write_meta(new_table_meta);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write table meta. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+
+  if (read_only) {
+    rc = init_mapped_file();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to map data file, scan through buffer pool. table=%s, rc=%s", name(), strrc(rc));
+      rc = RC::SUCCESS;
+    }
+  } else {
+    // 正在进行的扫描还持有映射文件，扫描结束后才会真正解除映射
+    std::atomic_store(&mapped_file_, std::shared_ptr<MappedFile>());
+  }
+
+  LOG_INFO("set table read only. table=%s, read only=%d", name(), read_only);
+  return rc;
+}
+
+RC Table::init_mapped_file()
+{
+  std::string data_file   = table_data_file(base_dir_.c_str(), name());
+  auto        mapped_file = std::make_shared<MappedFile>();
+
+  RC rc = mapped_file->open(data_file.c_str());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to map data file. table=%s, file=%s, rc=%s", name(), data_file.c_str(), strrc(rc));
+    return rc;
+  }
+
+  std::atomic_store(&mapped_file_, mapped_file);
   return rc;
 }
 
@@ -466,7 +618,7 @@ RC Table::destroy(const char * dir)
   return RC::SUCCESS;
 }
 
-RC Table::delete_record(const Record &record)
+RC Table::delete_record(const Record &record, const RecordLogger &logger /*=nullptr*/)
 {
   RC rc = RC::SUCCESS;
   for (Index *index : indexes_) {
@@ -475,26 +627,100 @@ RC Table::delete_record(const Record &record)
            "failed to delete entry from index. table name=%s, index name=%s, rid=%s, rc=%s",
            name(), index->index_meta().name(), record.rid().to_string().c_str(), strrc(rc));
   }
-  rc = record_handler_->delete_record(&record.rid());
+  rc = record_handler_->delete_record(&record.rid(), logger);
   return rc;
 }
-RC Table::update_record(const Record &target_record, Record &record)
+RC Table::update_record(const Record &target_record, Record &record, const RecordLogger &logger /*=nullptr*/)
 {
-  RC rc = RC::SUCCESS;
-  for (Index *index : indexes_) {
-    rc = index->update_entry(target_record.data(), &target_record.rid(), record.data());
-    ASSERT(RC::SUCCESS == rc,
-           "failed to update entry from index. table name=%s, index name=%s, rid=%s, rc=%s",
-           name(), index->index_meta().name(), record.rid().to_string().c_str(), strrc(rc));
+  return update_record_in_place(target_record, record, false /*recovering*/, logger);
+}
+
+RC Table::recover_update_record(const Record &target_record, Record &record, const RecordLogger &logger /*=nullptr*/)
+{
+  return update_record_in_place(target_record, record, true /*recovering*/, logger);
+}
+
+RC Table::update_record_in_place(
+    const Record &target_record, Record &record, bool recovering, const RecordLogger &logger)
+{
+  // 定长记录可以直接原地更新，记录的位置(RID)不会改变
+  record.set_rid(target_record.rid());
+
+  RC rc = update_entry_of_indexes(target_record.data(), record.data(), record.rid());
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to update index entries. table name=%s, rid=%s, rc=%s",
+             name(), record.rid().to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  rc = recovering ? record_handler_->recover_update_record(record.rid(), record.data(), logger)
+                  : record_handler_->update_record(record.rid(), record.data(), logger);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to update record. table name=%s, rid=%s, rc=%s",
+             name(), record.rid().to_string().c_str(), strrc(rc));
+    RC rc2 = update_entry_of_indexes(record.data(), target_record.data(), record.rid());
+    if (rc2 != RC::SUCCESS) {
+      LOG_PANIC("Failed to rollback index data when update record failed. table name=%s, rc=%d:%s",
+                name(), rc2, strrc(rc2));
+    }
   }
-  rc = record_handler_->delete_record(&target_record.rid());
-  ASSERT(RC::SUCCESS == rc,
-      "failed to delete entry");
-  LOG_DEBUG("target id=%d, record id=%d", target_record.rid(), record.rid());
-  rc = record_handler_->insert_record(record.data(), table_meta_.record_size(), &record.rid());
   return rc;
 }
 
+RC Table::update_entry_of_indexes(const char *old_record, const char *new_record, const RID &rid)
+{
+  RC     rc         = RC::SUCCESS;
+  size_t update_num = 0;
+  for (; update_num < indexes_.size(); update_num++) {
+    Index           *index      = indexes_[update_num];
+    const FieldMeta &field_meta = index->field_meta();
+    // 索引键没有变化时，不需要访问索引
+    if (0 == memcmp(old_record + field_meta.offset(), new_record + field_meta.offset(), field_meta.len())) {
+      continue;
+    }
+
+    rc = index->update_entry(old_record, &rid, new_record);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to update entry of index. table name=%s, index name=%s, rid=%s, rc=%s",
+               name(), index->index_meta().name(), rid.to_string().c_str(), strrc(rc));
+      break;
+    }
+  }
+
+  if (rc != RC::SUCCESS) {
+    for (size_t i = 0; i < update_num; i++) {
+      const FieldMeta &field_meta = indexes_[i]->field_meta();
+      if (0 != memcmp(old_record + field_meta.offset(), new_record + field_meta.offset(), field_meta.len())) {
+        indexes_[i]->update_entry(new_record, &rid, old_record);
+      }
+    }
+  }
+  return rc;
+}
+
+RC Table::recover_insert_index_entries(const Record &record)
+{
+  // 索引项可能已经在索引中，先删掉再插入
+  RC rc = delete_entry_of_indexes(record.data(), record.rid(), false /*error_on_not_exists*/);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to delete index entries. table name=%s, rid=%s, rc=%s",
+              name(), record.rid().to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  rc = insert_entry_of_indexes(record.data(), record.rid());
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to insert index entries. table name=%s, rid=%s, rc=%s",
+              name(), record.rid().to_string().c_str(), strrc(rc));
+  }
+  return rc;
+}
+
+RC Table::recover_delete_index_entries(const Record &record)
+{
+  return delete_entry_of_indexes(record.data(), record.rid(), false /*error_on_not_exists*/);
+}
+
 RC Table::insert_entry_of_indexes(const char *record, const RID &rid)
 {
   RC rc = RC::SUCCESS;
@@ -507,15 +733,60 @@ RC Table::insert_entry_of_indexes(const char *record, const RID &rid)
   return rc;
 }
 
+RC Table::insert_entries_of_indexes(std::vector<Record> &records)
+{
+  RC rc = RC::SUCCESS;
+
+  std::vector<int> order(records.size());
+  for (size_t index_pos = 0; index_pos < indexes_.size() && rc == RC::SUCCESS; index_pos++) {
+    Index           *index      = indexes_[index_pos];
+    const FieldMeta &field_meta = index->field_meta();
+
+    // 按照索引键排序后再插入，避免每条记录都从不同的路径访问B+树
+    AttrComparator comparator;
+    comparator.init(field_meta.type(), field_meta.len());
+    const int offset = field_meta.offset();
+    for (size_t i = 0; i < order.size(); i++) {
+      order[i] = static_cast<int>(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&records, &comparator, offset](int left, int right) {
+      return comparator(records[left].data() + offset, records[right].data() + offset) < 0;
+    });
+
+    for (size_t i = 0; i < order.size(); i++) {
+      const Record &record = records[order[i]];
+      rc = index->insert_entry(record.data(), &record.rid());
+      if (rc == RC::SUCCESS) {
+        continue;
+      }
+
+      // 回滚当前索引中已经插入的数据，以及前面所有索引中的数据
+      for (size_t j = 0; j < i; j++) {
+        const Record &inserted_record = records[order[j]];
+        index->delete_entry(inserted_record.data(), &inserted_record.rid());
+      }
+      for (size_t j = 0; j < index_pos; j++) {
+        for (const Record &inserted_record : records) {
+          indexes_[j]->delete_entry(inserted_record.data(), &inserted_record.rid());
+        }
+      }
+      break;
+    }
+  }
+  return rc;
+}
+
 RC Table::delete_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists)
 {
   RC rc = RC::SUCCESS;
   for (Index *index : indexes_) {
     rc = index->delete_entry(record, &rid);
     if (rc != RC::SUCCESS) {
-      if (rc != RC::RECORD_INVALID_KEY || !error_on_not_exists) {
+      // 索引项不存在时，按照参数决定是否报错
+      if ((rc != RC::RECORD_INVALID_KEY && rc != RC::RECORD_NOT_EXIST) || error_on_not_exists) {
         break;
       }
+      rc = RC::SUCCESS;
     }
   }
   return rc;
@@ -542,7 +813,12 @@ Index *Table::find_index_by_field(const char *field_name) const
 
 RC Table::sync()
 {
-  RC rc = RC::SUCCESS;
+  RC rc = data_buffer_pool_->flush_all_pages();
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to flush table's data pages. table=%s, rc=%d:%s", name(), rc, strrc(rc));
+    return rc;
+  }
+
   for (Index *index : indexes_) {
     rc = index->sync();
     if (rc != RC::SUCCESS) {
@@ -557,3 +833,108 @@ RC Table::sync()
   LOG_INFO("Sync table over. table=%s", name());
   return rc;
 }
+
+RC Table::flush_pages_before(LSN lsn, LSN &min_rec_lsn)
+{
+  RC rc = data_buffer_pool_->flush_pages_before(lsn, min_rec_lsn);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to flush data pages. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+
+  for (Index *index : indexes_) {
+    rc = index->flush_pages_before(lsn, min_rec_lsn);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to flush index pages. table=%s, index=%s, rc=%s", name(), index->index_meta().name(), strrc(rc));
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC Table::backup(const char *dir, IoThrottle *throttle, int64_t &copied_bytes)
+{
+  // 元数据只有DDL会修改，直接复制
+  std::string meta_file = table_meta_file(dir, name());
+  RC          rc        = copy_file(table_meta_file(base_dir_.c_str(), name()), meta_file, throttle, copied_bytes);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to backup table meta file. table=%s, file=%s, rc=%s", name(), meta_file.c_str(), strrc(rc));
+    return rc;
+  }
+
+  std::string data_file = table_data_file(dir, name());
+  rc                    = data_buffer_pool_->backup(data_file.c_str(), throttle, copied_bytes);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to backup table data file. table=%s, file=%s, rc=%s", name(), data_file.c_str(), strrc(rc));
+    return rc;
+  }
+
+  // 备份中的索引是空的，启动时表能正常打开，恢复完数据以后再重新建立
+  const int index_num = table_meta_.index_num();
+  for (int i = 0; i < index_num; i++) {
+    const IndexMeta *index_meta = table_meta_.index(i);
+    std::string      index_file = table_index_file(dir, name(), index_meta->name());
+    BplusTreeIndex   empty_index;
+    rc = empty_index.create(index_file.c_str(), *index_meta, *table_meta_.field(index_meta->field()));
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to create empty index file for backup. table=%s, index=%s, file=%s, rc=%s",
+               name(), index_meta->name(), index_file.c_str(), strrc(rc));
+      return rc;
+    }
+  }
+
+  LOG_INFO("backup table done. table=%s, dir=%s", name(), dir);
+  return rc;
+}
+
+RC Table::rebuild_indexes()
+{
+  RC        rc        = RC::SUCCESS;
+  const int index_num = table_meta_.index_num();
+  for (int i = 0; i < index_num; i++) {
+    const IndexMeta *index_meta = table_meta_.index(i);
+    std::string      index_file = table_index_file(base_dir_.c_str(), name(), index_meta->name());
+    BplusTreeIndex  *index      = static_cast<BplusTreeIndex *>(indexes_[i]);
+
+    // 恢复时重做日志已经在索引中插入了一些索引项，全部丢掉
+    index->close();
+    if (::unlink(index_file.c_str()) != 0) {
+      LOG_ERROR("failed to remove index file. table=%s, file=%s, error=%s", name(), index_file.c_str(), strerror(errno));
+      return RC::IOERR_ACCESS;
+    }
+    rc = index->create(index_file.c_str(), *index_meta, *table_meta_.field(index_meta->field()));
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("failed to create index while rebuilding. table=%s, index=%s, rc=%s", name(), index_meta->name(), strrc(rc));
+      return rc;
+    }
+  }
+
+  // 不通过事务扫描，已经删除但是还没有被清理的记录在索引中也要有索引项
+  RecordFileScanner scanner;
+  rc = get_record_scanner(scanner, nullptr /*trx*/, true /*readonly*/);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create scanner while rebuilding indexes. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+
+  Record  record;
+  int64_t record_num = 0;
+  while (OB_SUCC(rc) && scanner.has_next()) {
+    rc = scanner.next(record);
+    if (OB_SUCC(rc)) {
+      rc = insert_entry_of_indexes(record.data(), record.rid());
+      record_num++;
+    }
+  }
+  scanner.close_scan();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to insert records into indexes while rebuilding. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+
+  LOG_INFO("rebuild indexes done. table=%s, indexes=%d, records=%ld", name(), index_num, static_cast<long>(record_num));
+  return rc;
+}
+
+RC Table::get_page_lsn(PageNum page_num, LSN &lsn) { return data_buffer_pool_->get_page_lsn(page_num, lsn); }
+
@@ -14,18 +14,23 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "storage/record/record.h"
 #include "storage/table/table_meta.h"
 #include <functional>
+#include <memory>
 
 struct RID;
 class Record;
 class DiskBufferPool;
+class MappedFile;
 class RecordFileHandler;
 class RecordFileScanner;
+class ZoneMapFilter;
 class ConditionFilter;
 class DefaultConditionFilter;
 class Index;
 class IndexScanner;
+class IoThrottle;
 class RecordDeleter;
 class Trx;
 
@@ -46,16 +51,19 @@ public:
    * @param base_dir 表数据存放的路径
    * @param attribute_count 字段个数
    * @param attributes 字段
+   * @param storage_format 数据页面的组织格式
    */
   RC create(int32_t table_id, const char *path, const char *name, const char *base_dir, int attribute_count,
-      const AttrInfoSqlNode attributes[]);
+      const AttrInfoSqlNode attributes[], StorageFormat storage_format = StorageFormat::ROW_FORMAT);
 
   /**
    * 打开一个表
    * @param meta_file 保存表元数据的文件完整路径
    * @param base_dir 表所在的文件夹，表记录数据文件、索引数据文件存放位置
+   * @param allow_legacy_xid 是否可以打开事务号改成64位之前创建的表(事务号字段只有4个字节)。
+   * 只有离线升级时才会打开这样的表，参考 DbXidUpgrade
    */
-  RC open(const char *meta_file, const char *base_dir);
+  RC open(const char *meta_file, const char *base_dir, bool allow_legacy_xid = false);
 
   /**
    * @brief 根据给定的字段生成一个记录/行
@@ -70,23 +78,78 @@ public:
    * @brief 在当前的表中插入一条记录
    * @details 在表文件和索引中插入关联数据。这里只管在表中插入数据，不关心事务相关操作。
    * @param record[in/out] 传入的数据包含具体的数据，插入成功会通过此字段返回RID
+   * @param logger      记录放到页面上之后写日志，参考 RecordLogger
+   * @param undo_logger 插入索引失败、删除刚插入的记录时写日志
    */
-  RC insert_record(Record &record);
-  RC delete_record(const Record &record);
-  RC update_record(const Record &target_record, Record &record);
-  RC visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor);
+  RC insert_record(Record &record, const RecordLogger &logger = nullptr, const RecordLogger &undo_logger = nullptr);
+
+  /**
+   * @brief 在当前的表中批量插入多条记录
+   * @details 记录会连续地放到数据页面中，每个页面只加一次锁。插入索引时，每个索引都先按照索引键
+   * 对记录排序再插入，相邻的插入大概率落在同一个叶子页面上。任何一条失败，所有记录都不会插入。
+   * @param records[in/out] 要插入的记录，插入成功会通过每个记录返回RID
+   * @param logger      每个页面放入一批记录之后写日志，调用时这批记录已经设置了RID，参考 RecordBatchLogger
+   * @param undo_logger 插入失败、删除已经插入的记录时写日志
+   */
+  RC insert_records(std::vector<Record> &records, const RecordBatchLogger &logger = nullptr,
+      const RecordLogger &undo_logger = nullptr);
+  RC delete_record(const Record &record, const RecordLogger &logger = nullptr);
+
+  /**
+   * @brief 原地更新一条记录
+   * @details 更新后记录的RID保持不变，只有索引键发生变化的索引才会被更新。
+   * 新的值无法按照页面的编码方式存放时返回 RC::RECORD_NOMEM，记录和索引都不会被修改
+   * @param target_record 更新前的记录
+   * @param record[in/out] 更新后的记录数据，成功后会设置为target_record的RID
+   * @param logger 记录更新之后写日志，参考 RecordLogger
+   */
+  RC update_record(const Record &target_record, Record &record, const RecordLogger &logger = nullptr);
+  RC visit_record(
+      const RID &rid, bool readonly, std::function<void(Record &)> visitor, const RecordLogger &logger = nullptr);
   RC get_record(const RID &rid, Record &record);
 
-  RC recover_insert_record(Record &record);
+  /**
+   * @brief 重做插入日志，logger 在释放页面锁之前设置页面LSN
+   */
+  RC recover_insert_record(Record &record, const RecordLogger &logger = nullptr);
+
+  /**
+   * @brief 重做更新日志或者恢复时回滚更新，参考 RecordFileHandler::recover_update_record
+   */
+  RC recover_update_record(const Record &target_record, Record &record, const RecordLogger &logger = nullptr);
+
+  /**
+   * @brief 重做时记录已经在页面上，只需要保证索引项存在
+   * @details 索引页面没有记录日志，需要根据记录数据重新建立索引项
+   */
+  RC recover_insert_index_entries(const Record &record);
+
+  /**
+   * @brief 重做时记录已经从页面上删除了，只需要删除它的索引项
+   */
+  RC recover_delete_index_entries(const Record &record);
 
   RC destroy(const char*);
   // TODO refactor
   RC create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name);
 
-  RC get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly);
+  /**
+   * @brief 打开表的记录扫描
+   * @param zone_map_filter 可以使用 record_handler()->zone_map() 上的页面摘要构造，扫描时跳过不满足条件的页面
+   * @param condition_filter 在事务访问记录之前过滤，修改数据时不满足条件的记录不会加锁，也不会等待行锁
+   */
+  RC get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly,
+      const ZoneMapFilter *zone_map_filter = nullptr, ConditionFilter *condition_filter = nullptr);
 
   RecordFileHandler *record_handler() const { return record_handler_; }
 
+  /**
+   * @brief 设置表是否只读
+   * @details 设置为只读时，先把数据页面都刷到磁盘，再把数据文件映射到内存，之后的只读扫描直接读取映射的文件，
+   * 不再经过buffer pool。调用者要保证此时没有其它事务在访问这张表，并且只读期间不会修改数据
+   */
+  RC set_read_only(bool read_only);
+
 public:
   int32_t     table_id() const { return table_meta_.table_id(); }
   const char *name() const;
@@ -95,12 +158,53 @@ public:
 
   RC sync();
 
+  /**
+   * @brief checkpoint时刷新数据和索引页面，参考 DiskBufferPool::flush_pages_before
+   */
+  RC flush_pages_before(LSN lsn, LSN &min_rec_lsn);
+
+  /**
+   * @brief 在线备份时把元数据和数据文件复制到 dir 目录下，文件名与原来的相同
+   * @details 复制时不会阻塞对这张表的读写，参考 DiskBufferPool::backup。调用者要保证期间没有DDL。
+   * 索引页面没有日志，复制过程中发生的分裂、合并无法通过重做修复，所以不复制索引文件，只在 dir 下创建空的索引，
+   * 从备份启动时再用 rebuild_indexes 重新建立
+   * @param throttle     限速，可以为空
+   * @param copied_bytes 累加复制的字节数
+   */
+  RC backup(const char *dir, IoThrottle *throttle, int64_t &copied_bytes);
+
+  /**
+   * @brief 丢掉现有的索引文件，用数据文件中的记录重新建立所有的索引
+   * @details 从在线备份启动时，恢复完数据以后调用，参考 DbBackup
+   */
+  RC rebuild_indexes();
+
+  /**
+   * @brief 获取数据页面的LSN，参考 DiskBufferPool::get_page_lsn
+   * @details 修改页面时通过 RecordLogger 在释放页面锁之前设置页面的LSN
+   */
+  RC get_page_lsn(PageNum page_num, LSN &lsn);
+
 private:
   RC insert_entry_of_indexes(const char *record, const RID &rid);
+  RC insert_entries_of_indexes(std::vector<Record> &records);
   RC delete_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists);
+  RC update_entry_of_indexes(const char *old_record, const char *new_record, const RID &rid);
+
+  /**
+   * @brief 原地更新记录数据以及索引，recovering 表示是否在恢复时重做
+   */
+  RC update_record_in_place(
+      const Record &target_record, Record &record, bool recovering, const RecordLogger &logger);
 
 private:
   RC init_record_handler(const char *base_dir);
+  RC init_mapped_file();
+
+  /**
+   * @brief 把新的元数据写到元数据文件中，成功后才会替换内存中的元数据
+   */
+  RC write_meta(TableMeta &new_table_meta);
 
 public:
   Index *find_index(const char *index_name) const;
@@ -111,5 +215,6 @@ private:
   TableMeta            table_meta_;
   DiskBufferPool      *data_buffer_pool_ = nullptr;  /// 数据文件关联的buffer pool
   RecordFileHandler   *record_handler_   = nullptr;  /// 记录操作
+  std::shared_ptr<MappedFile> mapped_file_;          /// 只读表映射到内存的数据文件
   std::vector<Index *> indexes_;
 };
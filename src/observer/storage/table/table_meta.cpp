@@ -26,13 +26,38 @@ static const Json::StaticString FIELD_TABLE_ID("table_id");
 static const Json::StaticString FIELD_TABLE_NAME("table_name");
 static const Json::StaticString FIELD_FIELDS("fields");
 static const Json::StaticString FIELD_INDEXES("indexes");
+static const Json::StaticString FIELD_STORAGE_FORMAT("storage_format");
+static const Json::StaticString FIELD_READ_ONLY("read_only");
+
+static const char *STORAGE_FORMAT_NAME[] = {"unknown", "row", "pax"};
+
+const char *storage_format_to_string(StorageFormat format)
+{
+  const int index = static_cast<int>(format);
+  if (index >= 0 && index < static_cast<int>(sizeof(STORAGE_FORMAT_NAME) / sizeof(STORAGE_FORMAT_NAME[0]))) {
+    return STORAGE_FORMAT_NAME[index];
+  }
+  return "unknown";
+}
+
+StorageFormat storage_format_from_string(const char *s)
+{
+  for (unsigned int i = 0; i < sizeof(STORAGE_FORMAT_NAME) / sizeof(STORAGE_FORMAT_NAME[0]); i++) {
+    if (0 == strcasecmp(STORAGE_FORMAT_NAME[i], s)) {
+      return static_cast<StorageFormat>(i);
+    }
+  }
+  return StorageFormat::UNKNOWN_FORMAT;
+}
 
 TableMeta::TableMeta(const TableMeta &other)
     : table_id_(other.table_id_),
       name_(other.name_),
       fields_(other.fields_),
       indexes_(other.indexes_),
-      record_size_(other.record_size_)
+      record_size_(other.record_size_),
+      storage_format_(other.storage_format_),
+      read_only_(other.read_only_)
 {}
 
 void TableMeta::swap(TableMeta &other) noexcept
@@ -41,9 +66,12 @@ void TableMeta::swap(TableMeta &other) noexcept
   fields_.swap(other.fields_);
   indexes_.swap(other.indexes_);
   std::swap(record_size_, other.record_size_);
+  std::swap(storage_format_, other.storage_format_);
+  std::swap(read_only_, other.read_only_);
 }
 
-RC TableMeta::init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[])
+RC TableMeta::init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[],
+    StorageFormat storage_format /*=ROW_FORMAT*/)
 {
   if (common::is_blank(name)) {
     LOG_ERROR("Name cannot be empty");
@@ -77,8 +105,19 @@ RC TableMeta::init(int32_t table_id, const char *name, int field_num, const Attr
 
   for (int i = 0; i < field_num; i++) {
     const AttrInfoSqlNode &attr_info = attributes[i];
-    rc                               = fields_[i + trx_field_num].init(
-        attr_info.name.c_str(), attr_info.type, field_offset, attr_info.length, true /*visible*/);
+
+    ColumnEncoding encoding = ColumnEncoding::PLAIN_ENCODING;
+    if (!attr_info.encoding.empty()) {
+      encoding = column_encoding_from_string(attr_info.encoding.c_str());
+      if (encoding == ColumnEncoding::UNKNOWN_ENCODING) {
+        LOG_ERROR("Unknown column encoding. table name=%s, field name=%s, encoding=%s",
+            name, attr_info.name.c_str(), attr_info.encoding.c_str());
+        return RC::INVALID_ARGUMENT;
+      }
+    }
+
+    rc = fields_[i + trx_field_num].init(
+        attr_info.name.c_str(), attr_info.type, field_offset, attr_info.length, true /*visible*/, encoding);
     if (rc != RC::SUCCESS) {
       LOG_ERROR("Failed to init field meta. table name=%s, field name: %s", name, attr_info.name.c_str());
       return rc;
@@ -89,9 +128,11 @@ RC TableMeta::init(int32_t table_id, const char *name, int field_num, const Attr
 
   record_size_ = field_offset;
 
-  table_id_ = table_id;
-  name_     = name;
-  LOG_INFO("Sussessfully initialized table meta. table id=%d, name=%s", table_id, name);
+  table_id_       = table_id;
+  name_           = name;
+  storage_format_ = storage_format;
+  LOG_INFO("Sussessfully initialized table meta. table id=%d, name=%s, storage format=%s",
+      table_id, name, storage_format_to_string(storage_format));
   return RC::SUCCESS;
 }
 
@@ -186,8 +227,10 @@ int TableMeta::serialize(std::ostream &ss) const
 {
 
   Json::Value table_value;
-  table_value[FIELD_TABLE_ID]   = table_id_;
-  table_value[FIELD_TABLE_NAME] = name_;
+  table_value[FIELD_TABLE_ID]       = table_id_;
+  table_value[FIELD_TABLE_NAME]     = name_;
+  table_value[FIELD_STORAGE_FORMAT] = storage_format_to_string(storage_format_);
+  table_value[FIELD_READ_ONLY]      = read_only_;
 
   Json::Value fields_value;
   for (const FieldMeta &field : fields_) {
@@ -245,6 +288,31 @@ int TableMeta::deserialize(std::istream &is)
 
   std::string table_name = table_name_value.asString();
 
+  // 早期创建的表没有这个字段，都是按行存放的
+  StorageFormat      storage_format       = StorageFormat::ROW_FORMAT;
+  const Json::Value &storage_format_value = table_value[FIELD_STORAGE_FORMAT];
+  if (!storage_format_value.isNull()) {
+    if (!storage_format_value.isString()) {
+      LOG_ERROR("Invalid storage format. json value=%s", storage_format_value.toStyledString().c_str());
+      return -1;
+    }
+    storage_format = storage_format_from_string(storage_format_value.asCString());
+    if (storage_format == StorageFormat::UNKNOWN_FORMAT) {
+      LOG_ERROR("Unknown storage format. table name=%s, format=%s", table_name.c_str(), storage_format_value.asCString());
+      return -1;
+    }
+  }
+
+  bool               read_only       = false;
+  const Json::Value &read_only_value = table_value[FIELD_READ_ONLY];
+  if (!read_only_value.isNull()) {
+    if (!read_only_value.isBool()) {
+      LOG_ERROR("Invalid read only flag. json value=%s", read_only_value.toStyledString().c_str());
+      return -1;
+    }
+    read_only = read_only_value.asBool();
+  }
+
   const Json::Value &fields_value = table_value[FIELD_FIELDS];
   if (!fields_value.isArray() || fields_value.size() <= 0) {
     LOG_ERROR("Invalid table meta. fields is not array, json value=%s", fields_value.toStyledString().c_str());
@@ -272,7 +340,9 @@ int TableMeta::deserialize(std::istream &is)
   table_id_ = table_id;
   name_.swap(table_name);
   fields_.swap(fields);
-  record_size_ = fields_.back().offset() + fields_.back().len() - fields_.begin()->offset();
+  record_size_    = fields_.back().offset() + fields_.back().len() - fields_.begin()->offset();
+  storage_format_ = storage_format;
+  read_only_      = read_only;
 
   const Json::Value &indexes_value = table_value[FIELD_INDEXES];
   if (!indexes_value.empty()) {
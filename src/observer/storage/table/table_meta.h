@@ -19,9 +19,13 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/lang/serializable.h"
 #include "common/rc.h"
+#include "common/types.h"
 #include "storage/field/field_meta.h"
 #include "storage/index/index_meta.h"
 
+const char   *storage_format_to_string(StorageFormat format);
+StorageFormat storage_format_from_string(const char *s);
+
 /**
  * @brief 表元数据
  *
@@ -36,7 +40,8 @@ public:
 
   void swap(TableMeta &other) noexcept;
 
-  RC init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[]);
+  RC init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[],
+      StorageFormat storage_format = StorageFormat::ROW_FORMAT);
 
   RC add_index(const IndexMeta &index);
 
@@ -64,6 +69,14 @@ public:
 
   int record_size() const;
 
+  StorageFormat storage_format() const { return storage_format_; }
+
+  /**
+   * @brief 只读的表不能插入、删除和修改数据，扫描时直接读取映射到内存的数据文件
+   */
+  bool read_only() const { return read_only_; }
+  void set_read_only(bool read_only) { read_only_ = read_only; }
+
 public:
   int  serialize(std::ostream &os) const override;
   int  deserialize(std::istream &is) override;
@@ -78,4 +91,7 @@ protected:
   std::vector<IndexMeta> indexes_;
 
   int record_size_ = 0;
+
+  StorageFormat storage_format_ = StorageFormat::ROW_FORMAT;  ///< 数据页面的组织格式
+  bool          read_only_      = false;                      ///< 表是否只读
 };
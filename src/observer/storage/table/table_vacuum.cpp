@@ -0,0 +1,294 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#include <algorithm>
+
+#include "storage/table/table_vacuum.h"
+#include "common/log/log.h"
+#include "storage/clog/clog.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+RC TableVacuum::run(VacuumStat &stat)
+{
+  vector<RecordPageUsage> usages;
+  RC                      rc = table_->record_handler()->get_page_usages(usages);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get page usages. table=%s, rc=%s", table_->name(), strrc(rc));
+    return rc;
+  }
+
+  vector<PageNum> page_nums;
+  page_nums.reserve(usages.size());
+  for (const RecordPageUsage &usage : usages) {
+    page_nums.push_back(usage.page_num);
+  }
+
+  unique_ptr<VacuumView> view;
+  rc = create_view(view);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = purge(*view, page_nums, stat);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 先释放清理后的空页面，避免压缩时把记录搬到空页面上
+  rc = dispose_empty_pages(stat);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = compact(stat);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = dispose_empty_pages(stat);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  LOG_INFO("vacuum table done. table=%s, purged records=%d, moved records=%d, freed pages=%d",
+      table_->name(), stat.purged_records, stat.moved_records, stat.freed_pages);
+  return rc;
+}
+
+RC TableVacuum::create_view(unique_ptr<VacuumView> &view)
+{
+  view = trx_kit_.create_vacuum_view();
+  if (log_manager_ == nullptr) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = log_manager_->sync();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sync log before purging. table=%s, rc=%s", table_->name(), strrc(rc));
+  }
+  return rc;
+}
+
+RC TableVacuum::purge(const VacuumView &view, const vector<PageNum> &page_nums, VacuumStat &stat)
+{
+  RC             rc = RC::SUCCESS;
+  vector<Record> records;
+  for (PageNum page_num : page_nums) {
+    records.clear();
+    rc = table_->record_handler()->get_page_records(page_num, records);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to read page records. table=%s, page num=%d, rc=%s", table_->name(), page_num, strrc(rc));
+      return rc;
+    }
+
+    // 读取页面时拿着页面锁，删除记录要在释放页面锁之后
+    int purged_num = 0;
+    for (const Record &record : records) {
+      if (!view.is_dead(table_, record)) {
+        continue;
+      }
+
+      rc = table_->delete_record(record);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to purge record. table=%s, rid=%s, rc=%s",
+            table_->name(), record.rid().to_string().c_str(), strrc(rc));
+        return rc;
+      }
+      purged_num++;
+    }
+    stat.purged_records += purged_num;
+
+    // 清理记录没有日志。PAX页面清空以后会重新编码，如果恢复时页面上还留着清理掉的记录，
+    // 重做之后写入的记录可能就无法编码了，所以清理之后立即把页面写到磁盘
+    if (purged_num > 0 && table_->table_meta().storage_format() == StorageFormat::PAX_FORMAT) {
+      rc = table_->record_handler()->flush_page(page_num);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to flush purged page. table=%s, page num=%d, rc=%s", table_->name(), page_num, strrc(rc));
+        return rc;
+      }
+    }
+  }
+  return rc;
+}
+
+RC TableVacuum::choose_sparse_pages(vector<PageNum> &page_nums)
+{
+  vector<RecordPageUsage> usages;
+  RC                      rc = table_->record_handler()->get_page_usages(usages);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get page usages. table=%s, rc=%s", table_->name(), strrc(rc));
+    return rc;
+  }
+
+  // 空闲位置不包括要腾空的页面，要搬走的记录必须能够放到其它页面的空闲位置上
+  int64_t free_slots = 0;
+  for (const RecordPageUsage &usage : usages) {
+    free_slots += usage.record_capacity - usage.record_num;
+  }
+
+  sort(usages.begin(), usages.end(), [](const RecordPageUsage &a, const RecordPageUsage &b) {
+    return a.record_num < b.record_num;
+  });
+
+  int64_t need_slots = 0;
+  for (const RecordPageUsage &usage : usages) {
+    // 空页面不需要搬动，最后直接释放。记录超过一半的页面不值得搬
+    if (usage.record_num == 0) {
+      continue;
+    }
+    if (usage.record_num * 2 > usage.record_capacity) {
+      break;
+    }
+
+    const int64_t page_free_slots = usage.record_capacity - usage.record_num;
+    if (need_slots + usage.record_num > free_slots - page_free_slots) {
+      break;
+    }
+
+    need_slots += usage.record_num;
+    free_slots -= page_free_slots;
+    page_nums.push_back(usage.page_num);
+  }
+  return rc;
+}
+
+RC TableVacuum::compact(VacuumStat &stat)
+{
+  vector<PageNum> page_nums;
+  RC              rc = choose_sparse_pages(page_nums);
+  if (OB_FAIL(rc) || page_nums.empty()) {
+    return rc;
+  }
+
+  Trx *trx = trx_kit_.create_trx(log_manager_);
+  if (nullptr == trx) {
+    LOG_WARN("failed to create trx for vacuum. table=%s", table_->name());
+    return RC::NOMEM;
+  }
+
+  if (!trx_kit_.begin_exclusive(trx)) {
+    LOG_INFO("skip compacting table because other transactions are running. table=%s", table_->name());
+    trx_kit_.destroy_trx(trx);
+    return RC::SUCCESS;
+  }
+
+  // 腾空的页面不能再插入新的记录
+  RecordFileHandler *record_handler = table_->record_handler();
+  for (PageNum page_num : page_nums) {
+    record_handler->remove_free_page(page_num);
+  }
+
+  unique_ptr<VacuumView> view = trx_kit_.create_vacuum_view();
+  rc                          = trx->start_if_need();
+  int moved_num               = 0;
+  for (PageNum page_num : page_nums) {
+    if (OB_FAIL(rc)) {
+      break;
+    }
+
+    rc = move_page_records(trx, *view, page_num, moved_num);
+    if (rc == RC::LOCKED_CONCURRENCY_CONFLICT) {
+      rc = RC::SUCCESS;
+    }
+  }
+
+  if (OB_SUCC(rc)) {
+    rc = trx->commit();
+  } else {
+    LOG_WARN("failed to move records. table=%s, rc=%s", table_->name(), strrc(rc));
+    trx->rollback();
+  }
+
+  // 搬走的旧记录已经提交删除，并且没有其它事务能看到它们，可以直接清理掉
+  if (OB_SUCC(rc)) {
+    stat.moved_records += moved_num;
+
+    rc = create_view(view);
+    if (OB_SUCC(rc)) {
+      rc = purge(*view, page_nums, stat);
+    }
+  }
+
+  for (PageNum page_num : page_nums) {
+    record_handler->add_free_page(page_num);
+  }
+
+  trx_kit_.end_exclusive(trx);
+  trx_kit_.destroy_trx(trx);
+  return rc;
+}
+
+RC TableVacuum::move_page_records(Trx *trx, const VacuumView &view, PageNum page_num, int &moved_num)
+{
+  vector<Record> records;
+  RC             rc = table_->record_handler()->get_page_records(page_num, records);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to read page records. table=%s, page num=%d, rc=%s", table_->name(), page_num, strrc(rc));
+    return rc;
+  }
+
+  for (const Record &record : records) {
+    if (!view.is_movable(table_, record)) {
+      LOG_INFO("page has record that cannot be moved. table=%s, rid=%s",
+          table_->name(), record.rid().to_string().c_str());
+      return RC::LOCKED_CONCURRENCY_CONFLICT;
+    }
+  }
+
+  for (Record &record : records) {
+    Record new_record(record);
+    rc = trx->insert_record(table_, new_record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert moved record. table=%s, rid=%s, rc=%s",
+          table_->name(), record.rid().to_string().c_str(), strrc(rc));
+      return rc;
+    }
+
+    rc = trx->delete_record(table_, record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to delete moved record. table=%s, rid=%s, rc=%s",
+          table_->name(), record.rid().to_string().c_str(), strrc(rc));
+      return rc;
+    }
+    moved_num++;
+  }
+  return rc;
+}
+
+RC TableVacuum::dispose_empty_pages(VacuumStat &stat)
+{
+  vector<RecordPageUsage> usages;
+  RC                      rc = table_->record_handler()->get_page_usages(usages);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get page usages. table=%s, rc=%s", table_->name(), strrc(rc));
+    return rc;
+  }
+
+  for (const RecordPageUsage &usage : usages) {
+    if (usage.record_num != 0) {
+      continue;
+    }
+
+    // 页面可能刚刚又被插入了记录，或者正在被扫描，这时不释放它
+    RC rc2 = table_->record_handler()->dispose_page(usage.page_num);
+    if (OB_SUCC(rc2)) {
+      stat.freed_pages++;
+    }
+  }
+  return rc;
+}
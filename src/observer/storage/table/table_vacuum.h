@@ -0,0 +1,105 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/rc.h"
+#include "common/types.h"
+
+class Table;
+class Trx;
+class TrxKit;
+class VacuumView;
+class CLogManager;
+
+/**
+ * @brief 一次整理(VACUUM)的结果
+ */
+struct VacuumStat
+{
+  int purged_records = 0;  ///< 物理删除的记录个数
+  int moved_records  = 0;  ///< 为了腾空页面而搬走的记录个数
+  int freed_pages    = 0;  ///< 释放的页面个数
+
+  void merge(const VacuumStat &other)
+  {
+    purged_records += other.purged_records;
+    moved_records += other.moved_records;
+    freed_pages += other.freed_pages;
+  }
+};
+
+/**
+ * @brief 整理一张表，回收被删除的记录占用的空间
+ * @details 分成三步：
+ * 1. 清理(purge)：MVCC的删除只是标记了记录的结束事务号，已经对所有事务都不可见的记录在这里物理删除，
+ *    同时删除它们的索引项。清理不记录日志，重放日志时这些记录可能会重新出现，但它们仍然是不可见的，
+ *    下次整理时会再被清理掉；
+ * 2. 压缩(compact)：记录很少的页面，如果其它页面的空闲位置放得下它们的记录，就把记录搬过去。
+ *    搬动是一个普通的系统事务，先插入新的记录再删除旧的记录，所以会正常记录日志。
+ *    搬动时记录的RID会发生变化，为了不影响正在运行的事务，只有当前没有其它事务时才会压缩，
+ *    压缩期间新的事务要等待；
+ * 3. 释放：没有任何记录的页面还给buffer pool，之后可以重新分配。清理之后和压缩之后各做一次。
+ */
+class TableVacuum
+{
+public:
+  TableVacuum(Table *table, TrxKit &trx_kit, CLogManager *log_manager)
+      : table_(table), trx_kit_(trx_kit), log_manager_(log_manager)
+  {}
+
+  RC run(VacuumStat &stat);
+
+private:
+  /**
+   * @brief 创建判断记录是否可以清理的视图
+   * @details 创建视图时会改写已经提交的事务留在记录上的事务号。清理不记录日志，所以要先让这些事务的提交日志落盘，
+   * 否则异步提交的事务在宕机以后会被回滚，它删除的记录却已经被清理掉了
+   */
+  RC create_view(std::unique_ptr<VacuumView> &view);
+
+  /**
+   * @brief 物理删除指定页面上已经对所有事务都不可见的记录
+   */
+  RC purge(const VacuumView &view, const std::vector<PageNum> &page_nums, VacuumStat &stat);
+
+  /**
+   * @brief 把记录很少的页面上的记录搬到其它页面上
+   */
+  RC compact(VacuumStat &stat);
+
+  /**
+   * @brief 选择要腾空的页面
+   */
+  RC choose_sparse_pages(std::vector<PageNum> &page_nums);
+
+  /**
+   * @brief 把一个页面上的记录都搬走
+   * @return 页面上有不能搬动的记录时返回 RC::LOCKED_CONCURRENCY_CONFLICT，此时页面上的记录都没有动过
+   */
+  RC move_page_records(Trx *trx, const VacuumView &view, PageNum page_num, int &moved_num);
+
+  /**
+   * @brief 释放没有任何记录的页面
+   */
+  RC dispose_empty_pages(VacuumStat &stat);
+
+private:
+  Table       *table_ = nullptr;
+  TrxKit      &trx_kit_;
+  CLogManager *log_manager_ = nullptr;
+};
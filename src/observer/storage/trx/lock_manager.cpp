@@ -0,0 +1,197 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include "storage/trx/lock_manager.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "common/log/log.h"
+
+using namespace std;
+using namespace std::chrono;
+
+RC LockManager::try_lock(int64_t trx_id, int32_t table_id, const RID &rid)
+{
+  const LockKey     key{table_id, rid};
+  lock_guard<mutex> guard(lock_);
+  RowLock          &row_lock = locks_[key];
+  if (row_lock.holder == trx_id) {
+    return RC::SUCCESS;
+  }
+  if (row_lock.holder != 0) {
+    return RC::LOCKED_NEED_WAIT;
+  }
+
+  row_lock.holder = trx_id;
+  trx_locks_[trx_id].push_back(key);
+  return RC::SUCCESS;
+}
+
+RC LockManager::lock(int64_t trx_id, int32_t table_id, const RID &rid)
+{
+  const LockKey      key{table_id, rid};
+  unique_lock<mutex> guard(lock_);
+  RowLock           &row_lock = locks_[key];
+  if (row_lock.holder == trx_id) {
+    return RC::SUCCESS;
+  }
+  if (row_lock.holder == 0) {
+    row_lock.holder = trx_id;
+    trx_locks_[trx_id].push_back(key);
+    return RC::SUCCESS;
+  }
+
+  Waiter waiter;
+  waiter.trx_id = trx_id;
+  row_lock.waiters.push_back(&waiter);
+  waiting_for_.emplace(trx_id, key);
+  if (will_deadlock(trx_id, key)) {
+    waiting_for_.erase(trx_id);
+    remove_waiter(key, &waiter);
+    stat_.deadlock_count++;
+    LOG_INFO("deadlock detected while waiting for row lock. trx id=%ld, table id=%d, rid=%s",
+             trx_id, table_id, rid.to_string().c_str());
+    return RC::LOCKED_DEADLOCK;
+  }
+
+  stat_.wait_count++;
+  stat_.waiting_count++;
+  const steady_clock::time_point begin   = steady_clock::now();
+  const bool                     granted = waiter.cond.wait_until(
+      guard, begin + milliseconds(wait_timeout_ms_.load()), [&waiter]() { return waiter.granted; });
+  stat_.waiting_count--;
+  waiting_for_.erase(trx_id);
+  record_wait(begin);
+
+  if (!granted) {
+    remove_waiter(key, &waiter);
+    stat_.timeout_count++;
+    LOG_INFO("timeout while waiting for row lock. trx id=%ld, table id=%d, rid=%s",
+             trx_id, table_id, rid.to_string().c_str());
+    return RC::LOCKED_WAIT_TIMEOUT;
+  }
+  return RC::SUCCESS;
+}
+
+bool LockManager::locked_by_other(int64_t trx_id, int32_t table_id, const RID &rid)
+{
+  lock_guard<mutex> guard(lock_);
+  auto              iter = locks_.find(LockKey{table_id, rid});
+  return iter != locks_.end() && iter->second.holder != 0 && iter->second.holder != trx_id;
+}
+
+void LockManager::release_all(int64_t trx_id)
+{
+  lock_guard<mutex> guard(lock_);
+  auto              trx_iter = trx_locks_.find(trx_id);
+  if (trx_iter == trx_locks_.end()) {
+    return;
+  }
+
+  // 交出锁时会修改 trx_locks_，先把当前事务的锁取出来
+  vector<LockKey> keys = std::move(trx_iter->second);
+  trx_locks_.erase(trx_iter);
+
+  for (const LockKey &key : keys) {
+    auto lock_iter = locks_.find(key);
+    if (lock_iter == locks_.end() || lock_iter->second.holder != trx_id) {
+      continue;
+    }
+
+    RowLock &row_lock = lock_iter->second;
+    if (row_lock.waiters.empty()) {
+      locks_.erase(lock_iter);
+      continue;
+    }
+
+    // 直接交给排在最前面的事务，后来的事务不会插队
+    Waiter *waiter = row_lock.waiters.front();
+    row_lock.waiters.pop_front();
+    row_lock.holder = waiter->trx_id;
+    waiter->granted = true;
+    trx_locks_[waiter->trx_id].push_back(key);
+    waiter->cond.notify_one();
+  }
+}
+
+LockStat LockManager::stat()
+{
+  lock_guard<mutex> guard(lock_);
+  return stat_;
+}
+
+bool LockManager::will_deadlock(int64_t trx_id, const LockKey &key) const
+{
+  // 加入等待之前等待图中没有环，如果有环，一定经过当前事务
+  vector<int64_t>         trx_ids;
+  unordered_set<int64_t> visited;
+  blockers(trx_id, key, trx_ids);
+  while (!trx_ids.empty()) {
+    const int64_t blocker = trx_ids.back();
+    trx_ids.pop_back();
+    if (blocker == trx_id) {
+      return true;
+    }
+    if (!visited.insert(blocker).second) {
+      continue;
+    }
+
+    auto iter = waiting_for_.find(blocker);
+    if (iter != waiting_for_.end()) {
+      blockers(blocker, iter->second, trx_ids);
+    }
+  }
+  return false;
+}
+
+void LockManager::blockers(int64_t trx_id, const LockKey &key, vector<int64_t> &trx_ids) const
+{
+  auto iter = locks_.find(key);
+  if (iter == locks_.end()) {
+    return;
+  }
+
+  const RowLock &row_lock = iter->second;
+  if (row_lock.holder != 0 && row_lock.holder != trx_id) {
+    trx_ids.push_back(row_lock.holder);
+  }
+  for (const Waiter *waiter : row_lock.waiters) {
+    if (waiter->trx_id == trx_id) {
+      break;
+    }
+    trx_ids.push_back(waiter->trx_id);
+  }
+}
+
+void LockManager::remove_waiter(const LockKey &key, Waiter *waiter)
+{
+  auto iter = locks_.find(key);
+  if (iter == locks_.end()) {
+    return;
+  }
+
+  deque<Waiter *> &waiters = iter->second.waiters;
+  waiters.erase(std::remove(waiters.begin(), waiters.end(), waiter), waiters.end());
+  if (iter->second.holder == 0 && waiters.empty()) {
+    locks_.erase(iter);
+  }
+}
+
+void LockManager::record_wait(steady_clock::time_point begin)
+{
+  const int64_t wait_time_us = duration_cast<microseconds>(steady_clock::now() - begin).count();
+  stat_.wait_time_us += wait_time_us;
+  stat_.max_wait_time_us = std::max(stat_.max_wait_time_us, wait_time_us);
+}
@@ -0,0 +1,143 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/rc.h"
+#include "storage/record/record.h"
+
+/**
+ * @brief 行锁的等待统计
+ * @ingroup Transaction
+ */
+struct LockStat
+{
+  int64_t wait_count       = 0;  ///< 等待过的次数
+  int64_t wait_time_us     = 0;  ///< 等待的总时间
+  int64_t max_wait_time_us = 0;  ///< 最长的一次等待
+  int64_t timeout_count    = 0;  ///< 等待超时的次数
+  int64_t deadlock_count   = 0;  ///< 发现死锁的次数
+  int32_t waiting_count    = 0;  ///< 当前正在等待的事务个数
+};
+
+/**
+ * @brief 行锁管理器
+ * @ingroup Transaction
+ * @details 事务修改一条记录之前在记录上加排它锁，事务结束时释放。读不加锁，由读视图判断可见性。
+ * 每把锁有一个持有者和一个先进先出的等待队列，释放时直接交给队列中的第一个事务。
+ * 开始等待之前检查等待图(wait-for graph)：等待者依赖锁的持有者和排在它前面的等待者，
+ * 如果能从这些事务沿着依赖回到自己，就是死锁，由发起等待的事务返回错误。等待超过超时时间也返回错误。
+ * 所有的锁由一个互斥量保护，只有加锁冲突时才需要等待
+ */
+class LockManager
+{
+public:
+  LockManager() = default;
+  ~LockManager() = default;
+
+  /**
+   * @brief 不等待地加锁
+   * @return SUCCESS 加锁成功或者已经持有这把锁，LOCKED_NEED_WAIT 锁被其它事务持有
+   */
+  RC try_lock(int64_t trx_id, int32_t table_id, const RID &rid);
+
+  /**
+   * @brief 加锁，锁被其它事务持有时排队等待
+   * @return SUCCESS 拿到了锁，LOCKED_DEADLOCK 等待会造成死锁，LOCKED_WAIT_TIMEOUT 等待超时
+   */
+  RC lock(int64_t trx_id, int32_t table_id, const RID &rid);
+
+  /**
+   * @brief 记录上的锁是否被其它事务持有
+   */
+  bool locked_by_other(int64_t trx_id, int32_t table_id, const RID &rid);
+
+  /**
+   * @brief 释放事务持有的所有锁，事务提交或回滚之后调用
+   */
+  void release_all(int64_t trx_id);
+
+  /**
+   * @brief 设置等待锁的超时时间(毫秒)
+   */
+  void set_wait_timeout(int timeout_ms) { wait_timeout_ms_.store(timeout_ms); }
+  int  wait_timeout() const { return wait_timeout_ms_.load(); }
+
+  LockStat stat();
+
+private:
+  struct LockKey
+  {
+    int32_t table_id;
+    RID     rid;
+
+    bool operator==(const LockKey &other) const { return table_id == other.table_id && rid == other.rid; }
+  };
+
+  struct LockKeyHasher
+  {
+    size_t operator()(const LockKey &key) const
+    {
+      return (static_cast<size_t>(key.table_id) << 48) ^ (static_cast<size_t>(key.rid.page_num) << 16) ^
+             static_cast<size_t>(key.rid.slot_num);
+    }
+  };
+
+  /**
+   * @brief 一个等待加锁的事务
+   */
+  struct Waiter
+  {
+    int64_t                 trx_id  = 0;
+    bool                    granted = false;
+    std::condition_variable cond;
+  };
+
+  struct RowLock
+  {
+    int64_t              holder = 0;
+    std::deque<Waiter *> waiters;
+  };
+
+private:
+  /**
+   * @brief 事务 trx_id 开始等待 key 上的锁是否会造成死锁
+   */
+  bool will_deadlock(int64_t trx_id, const LockKey &key) const;
+
+  /**
+   * @brief 事务在等待哪些事务：锁的持有者以及排在它前面的等待者
+   */
+  void blockers(int64_t trx_id, const LockKey &key, std::vector<int64_t> &trx_ids) const;
+
+  void remove_waiter(const LockKey &key, Waiter *waiter);
+  void record_wait(std::chrono::steady_clock::time_point begin);
+
+private:
+  std::mutex                                          lock_;
+  std::unordered_map<LockKey, RowLock, LockKeyHasher> locks_;
+  std::unordered_map<int64_t, std::vector<LockKey>>   trx_locks_;    ///< 每个事务持有的锁
+  std::unordered_map<int64_t, LockKey>                waiting_for_;  ///< 正在等待的事务在等哪把锁
+  LockStat                                            stat_;
+  std::atomic<int>                                    wait_timeout_ms_{5000};
+};
@@ -13,17 +13,21 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "storage/trx/mvcc_trx.h"
+#include "common/lang/defer.h"
 #include "storage/clog/clog.h"
 #include "storage/db/db.h"
 #include "storage/field/field.h"
+#include <algorithm>
 #include <limits>
+#include <tuple>
 
 using namespace std;
 
 MvccTrxKit::~MvccTrxKit()
 {
+  // 会话中的事务由会话销毁，这里只剩下恢复时创建的事务
   vector<Trx *> tmp_trxes;
-  tmp_trxes.swap(trxes_);
+  trx_table_.all(tmp_trxes);
 
   for (Trx *trx : tmp_trxes) {
     delete trx;
@@ -33,8 +37,8 @@ MvccTrxKit::~MvccTrxKit()
 RC MvccTrxKit::init()
 {
   fields_ = vector<FieldMeta>{
-      FieldMeta("__trx_xid_begin", AttrType::INTS, 0 /*attr_offset*/, 4 /*attr_len*/, false /*visible*/),
-      FieldMeta("__trx_xid_end", AttrType::INTS, 0 /*attr_offset*/, 4 /*attr_len*/, false /*visible*/)};
+      FieldMeta("__trx_xid_begin", AttrType::INTS, 0 /*attr_offset*/, Xid::LEN /*attr_len*/, false /*visible*/),
+      FieldMeta("__trx_xid_end", AttrType::INTS, 0 /*attr_offset*/, Xid::LEN /*attr_len*/, false /*visible*/)};
 
   LOG_INFO("init mvcc trx kit done.");
   return RC::SUCCESS;
@@ -42,127 +46,439 @@ RC MvccTrxKit::init()
 
 const vector<FieldMeta> *MvccTrxKit::trx_fields() const { return &fields_; }
 
-int32_t MvccTrxKit::next_trx_id() { return ++current_trx_id_; }
+int64_t MvccTrxKit::next_trx_id() { return ++current_trx_id_; }
 
-int32_t MvccTrxKit::max_trx_id() const { return numeric_limits<int32_t>::max(); }
+int64_t MvccTrxKit::max_trx_id() const { return Xid::MAX; }
 
 Trx *MvccTrxKit::create_trx(CLogManager *log_manager)
 {
-  Trx *trx = new MvccTrx(*this, log_manager);
-  if (trx != nullptr) {
-    lock_.lock();
-    trxes_.push_back(trx);
-    lock_.unlock();
-  }
-  return trx;
+  // 事务开始时才分配事务号，那时再放到事务表中
+  return new MvccTrx(*this, log_manager);
 }
 
-Trx *MvccTrxKit::create_trx(int32_t trx_id)
+Trx *MvccTrxKit::create_trx(int64_t trx_id)
 {
   Trx *trx = new MvccTrx(*this, trx_id);
-  if (trx != nullptr) {
-    lock_.lock();
-    trxes_.push_back(trx);
-    if (current_trx_id_ < trx_id) {
-      current_trx_id_ = trx_id;
-    }
-    lock_.unlock();
-  }
+  trx_table_.insert(trx_id, trx);
+  update_trx_id(trx_id);
   return trx;
 }
 
+void MvccTrxKit::update_trx_id(int64_t trx_id)
+{
+  int64_t current = current_trx_id_.load();
+  while (current < trx_id && !current_trx_id_.compare_exchange_weak(current, trx_id)) {
+  }
+}
+
 void MvccTrxKit::destroy_trx(Trx *trx)
 {
-  lock_.lock();
-  for (auto iter = trxes_.begin(), itend = trxes_.end(); iter != itend; ++iter) {
-    if (*iter == trx) {
-      trxes_.erase(iter);
+  trx_table_.remove(trx->id(), trx);
+  delete trx;
+}
+
+Trx *MvccTrxKit::find_trx(int64_t trx_id) { return trx_table_.find(trx_id); }
+
+void MvccTrxKit::all_trxes(std::vector<Trx *> &trxes) { trx_table_.all(trxes); }
+
+/**
+ * @brief 多版本数据的清理视图
+ * @details 已经提交的删除，如果提交事务号比所有正在运行的事务都小，那么没有任何事务能再看到这条记录
+ */
+class MvccVacuumView : public VacuumView
+{
+public:
+  MvccVacuumView(int64_t oldest_active_trx_id, int64_t max_trx_id, UndoStore &undo_store)
+      : oldest_active_trx_id_(oldest_active_trx_id), max_trx_id_(max_trx_id), undo_store_(undo_store)
+  {}
+  virtual ~MvccVacuumView() = default;
+
+  bool is_dead(Table *table, const Record &record) const override
+  {
+    int64_t begin_xid = 0;
+    int64_t end_xid   = 0;
+    get_xids(table, record, begin_xid, end_xid);
+    return !Xid::is_uncommitted(begin_xid) && !Xid::is_uncommitted(end_xid) && end_xid != max_trx_id_ &&
+           end_xid < oldest_active_trx_id_;
+  }
+
+  bool is_movable(Table *table, const Record &record) const override
+  {
+    int64_t begin_xid = 0;
+    int64_t end_xid   = 0;
+    get_xids(table, record, begin_xid, end_xid);
+    // 旧版本通过RID找到，有旧版本的记录不能搬动
+    return !Xid::is_uncommitted(begin_xid) && end_xid == max_trx_id_ &&
+           !undo_store_.contains(table->table_id(), record.rid());
+  }
+
+private:
+  static void get_xids(Table *table, const Record &record, int64_t &begin_xid, int64_t &end_xid)
+  {
+    const pair<const FieldMeta *, int> trx_fields = table->table_meta().trx_fields();
+    ASSERT(trx_fields.second >= 2, "invalid trx fields number. %d", trx_fields.second);
+
+    XidField begin_xid_field(&trx_fields.first[0]);
+    XidField end_xid_field(&trx_fields.first[1]);
+    begin_xid = begin_xid_field.get(record);
+    end_xid   = end_xid_field.get(record);
+  }
+
+private:
+  int64_t    oldest_active_trx_id_;
+  int64_t    max_trx_id_;
+  UndoStore &undo_store_;
+};
+
+unique_ptr<VacuumView> MvccTrxKit::create_vacuum_view()
+{
+  // 记录上还留着未提交标记的事务号时，既不能清理也不能搬动
+  rewrite_committed_xids();
+
+  // 先清理旧版本，被清理掉的记录的RID可能会被重新使用，不能留下它的版本链
+  const int64_t oldest_active_trx_id = this->oldest_active_trx_id();
+  undo_store_.purge(oldest_active_trx_id);
+  return make_unique<MvccVacuumView>(oldest_active_trx_id, max_trx_id(), undo_store_);
+}
+
+void MvccTrxKit::remove_table_versions(int32_t table_id)
+{
+  undo_store_.remove_table(table_id);
+
+  lock_guard<mutex> rewrite_guard(rewrite_lock_);
+  for (UnrewrittenShard &shard : unrewritten_trxes_) {
+    lock_guard<mutex> guard(shard.lock);
+    for (auto &trx_item : shard.trxes) {
+      vector<pair<Table *, RID>> &rids = trx_item.second;
+      rids.erase(remove_if(rids.begin(),
+                     rids.end(),
+                     [table_id](const pair<Table *, RID> &rid) { return rid.first->table_id() == table_id; }),
+          rids.end());
+    }
+  }
+}
+
+void MvccTrxKit::rewrite_committed_xids()
+{
+  lock_guard<mutex> rewrite_guard(rewrite_lock_);
+
+  unordered_map<int64_t, vector<pair<Table *, RID>>> trxes;
+  for (UnrewrittenShard &shard : unrewritten_trxes_) {
+    lock_guard<mutex> guard(shard.lock);
+    trxes.merge(shard.trxes);
+  }
+  if (trxes.empty()) {
+    return;
+  }
+
+  // 按照页面的顺序改写，同一个页面上的记录放在一起
+  vector<tuple<Table *, RID, int64_t, int64_t, int64_t>> records;
+  for (const auto &trx_item : trxes) {
+    int64_t commit_xid = 0;
+    int64_t commit_lsn = -1;
+    TrxStatusTable::Status status = status_table_.get(trx_item.first, &commit_xid, &commit_lsn);
+    ASSERT(status == TrxStatusTable::Status::COMMITTED, "trx to rewrite is not committed. trx id=%ld", trx_item.first);
+    for (const pair<Table *, RID> &rid : trx_item.second) {
+      records.emplace_back(rid.first, rid.second, trx_item.first, commit_xid, commit_lsn);
+    }
+  }
+  sort(records.begin(), records.end(), [](const auto &left, const auto &right) {
+    if (get<0>(left) != get<0>(right)) {
+      return get<0>(left)->table_id() < get<0>(right)->table_id();
+    }
+    return RID::compare(&get<1>(left), &get<1>(right)) < 0;
+  });
+
+  for (const auto &[table, rid, trx_id, commit_xid, commit_lsn] : records) {
+    const pair<const FieldMeta *, int> trx_fields = table->table_meta().trx_fields();
+    XidField begin_xid_field(&trx_fields.first[0]);
+    XidField end_xid_field(&trx_fields.first[1]);
+
+    auto record_updater = [&begin_xid_field, &end_xid_field, trx_id = trx_id, commit_xid = commit_xid](Record &record) {
+      if (begin_xid_field.get(record) == Xid::uncommitted(trx_id)) {
+        begin_xid_field.set(record, commit_xid);
+      }
+      if (end_xid_field.get(record) == Xid::uncommitted(trx_id)) {
+        end_xid_field.set(record, commit_xid);
+      }
+    };
+
+    // 改写是幂等的，不需要记录日志。页面标记为脏页，checkpoint时会写到磁盘。
+    // 页面LSN设置为提交日志的LSN，页面写到磁盘之前提交日志一定已经落盘
+    RC rc = table->visit_record(rid, false /*readonly*/, record_updater, MvccTrx::page_lsn_setter(commit_lsn));
+    ASSERT(rc == RC::SUCCESS, "failed to rewrite committed xids. rid=%s, trx id=%ld, rc=%s",
+           rid.to_string().c_str(), trx_id, strrc(rc));
+  }
+
+  // 记录上已经没有这些事务的事务号了
+  for (const auto &trx_item : trxes) {
+    status_table_.remove(trx_item.first);
+  }
+  LOG_INFO("rewrite committed xids done. trx num=%d, record num=%d",
+           static_cast<int>(trxes.size()), static_cast<int>(records.size()));
+}
+
+void MvccTrxKit::purge_undo()
+{
+  if (undo_store_.version_count() > 0) {
+    undo_store_.purge(oldest_active_trx_id());
+  }
+}
+
+int64_t MvccTrxKit::begin_trx(Trx *trx, ReadView &read_view)
+{
+  int64_t trx_id = 0;
+  while (true) {
+    trx_id = next_trx_id();
+    trx_table_.insert(trx_id, trx);
+
+    // begin_exclusive 先设置独占的事务再检查事务表，这里反过来，两边至少有一个能看到对方
+    Trx *exclusive_trx = exclusive_trx_.load();
+    if (exclusive_trx == nullptr || exclusive_trx == trx) {
       break;
     }
+
+    trx_table_.remove(trx_id, trx);
+    unique_lock<mutex> guard(active_lock_);
+    active_cond_.wait(guard, [this, trx]() {
+      Trx *exclusive_trx = exclusive_trx_.load();
+      return exclusive_trx == nullptr || exclusive_trx == trx;
+    });
   }
-  lock_.unlock();
+  status_table_.begin(trx_id);
 
-  delete trx;
+  // 放到事务表之后再读当前事务号作为高水位。oldest_active_trx_id 先读当前事务号再读事务表，
+  // 如果没有看到这个事务，它读到的事务号也不会比这里的高水位大
+  read_view = ReadView(trx_id, trx_id, current_trx_id_.load() + 1);
+  return trx_id;
+}
+
+void MvccTrxKit::begin_read_only_trx(ReadView &read_view)
+{
+  unique_lock<mutex> guard(active_lock_);
+  active_cond_.wait(guard, [this]() { return exclusive_trx_.load() == nullptr; });
+
+  // 和读写事务一样先登记再读高水位，只是没有自己的事务号，0不会是任何事务的事务号
+  const int64_t low_watermark = current_trx_id_.load() + 1;
+  read_only_views_.insert(low_watermark);
+  oldest_read_only_view_.store(*read_only_views_.begin());
+  read_view = ReadView(0, low_watermark, current_trx_id_.load() + 1);
+}
+
+void MvccTrxKit::end_read_only_trx(const ReadView &read_view)
+{
+  lock_guard<mutex> guard(active_lock_);
+  auto              iter = read_only_views_.find(read_view.low_watermark());
+  ASSERT(iter != read_only_views_.end(), "cannot find read only view. low watermark=%ld", read_view.low_watermark());
+  read_only_views_.erase(iter);
+  oldest_read_only_view_.store(read_only_views_.empty() ? numeric_limits<int64_t>::max() : *read_only_views_.begin());
+}
+
+void MvccTrxKit::refresh_read_view(int64_t trx_id, ReadView &read_view)
+{
+  read_view = ReadView(trx_id, read_view.low_watermark(), current_trx_id_.load() + 1);
+}
+
+int64_t MvccTrxKit::prepare_commit(int64_t trx_id)
+{
+  status_table_.prepare_commit(trx_id);
+  return next_trx_id();
+}
+
+void MvccTrxKit::commit_trx(int64_t trx_id, int64_t commit_xid, int64_t commit_lsn)
+{
+  status_table_.commit(trx_id, commit_xid, commit_lsn);
+}
+
+void MvccTrxKit::abort_trx(int64_t trx_id) { status_table_.abort(trx_id); }
+
+void MvccTrxKit::end_trx(int64_t trx_id, vector<pair<Table *, RID>> &&rids)
+{
+  trx_table_.remove(trx_id);
+  // 没有修改过记录的事务，不会有人再查询它的状态
+  if (status_table_.get(trx_id) != TrxStatusTable::Status::COMMITTED || rids.empty()) {
+    status_table_.remove(trx_id);
+    return;
+  }
+
+  UnrewrittenShard &shard = unrewritten_trxes_[static_cast<uint64_t>(trx_id) % UNREWRITTEN_SHARD_NUM];
+  lock_guard<mutex> guard(shard.lock);
+  shard.trxes.emplace(trx_id, std::move(rids));
+}
+
+int64_t MvccTrxKit::oldest_active_trx_id()
+{
+  const int64_t next_trx_id = current_trx_id_.load() + 1;
+  return std::min({next_trx_id, trx_table_.min_trx_id(), oldest_read_only_view_.load()});
 }
 
-Trx *MvccTrxKit::find_trx(int32_t trx_id)
+bool MvccTrxKit::begin_exclusive(Trx *trx)
 {
-  lock_.lock();
-  for (Trx *trx : trxes_) {
-    if (trx->id() == trx_id) {
-      lock_.unlock();
-      return trx;
+  {
+    lock_guard<mutex> guard(active_lock_);
+    if (exclusive_trx_.load() != nullptr || !read_only_views_.empty()) {
+      return false;
     }
+
+    exclusive_trx_.store(trx);
+    if (trx_table_.empty()) {
+      return true;
+    }
+    exclusive_trx_.store(nullptr);
   }
-  lock_.unlock();
 
-  return nullptr;
+  // 同时开始的事务可能看到了独占的事务，正在等待
+  active_cond_.notify_all();
+  return false;
 }
 
-void MvccTrxKit::all_trxes(std::vector<Trx *> &trxes)
+void MvccTrxKit::end_exclusive(Trx *trx)
 {
-  lock_.lock();
-  trxes = trxes_;
-  lock_.unlock();
+  {
+    lock_guard<mutex> guard(active_lock_);
+    if (exclusive_trx_.load() == trx) {
+      exclusive_trx_.store(nullptr);
+    }
+  }
+  active_cond_.notify_all();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 MvccTrx::MvccTrx(MvccTrxKit &kit, CLogManager *log_manager) : trx_kit_(kit), log_manager_(log_manager) {}
 
-MvccTrx::MvccTrx(MvccTrxKit &kit, int32_t trx_id) : trx_kit_(kit), trx_id_(trx_id)
+MvccTrx::MvccTrx(MvccTrxKit &kit, int64_t trx_id) : trx_kit_(kit), trx_id_(trx_id)
 {
   started_    = true;
   recovering_ = true;
 }
 
-MvccTrx::~MvccTrx() {}
+MvccTrx::~MvccTrx()
+{
+  // 会话关闭时事务可能还没有结束
+  release_locks();
+  if (read_only_) {
+    end_read_only();
+  }
+}
 
 RC MvccTrx::update_record(Table *table, Record &target_record, Record &record)
 {
+  if (read_only_) {
+    LOG_WARN("cannot update record in a read only transaction. table=%s", table->name());
+    return RC::TRX_READ_ONLY;
+  }
+
+  RC rc = lock_record(table, target_record.rid());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 旧版本和回滚时恢复的数据中不能留下其它事务带有未提交标记的事务号，它们的状态在改写记录之后就删除了
+  set_hint_xids(table, target_record, false /*in_page*/);
 
-  Field begin_field;
-  Field end_field;
+  XidField begin_field;
+  XidField end_field;
   trx_fields(table, begin_field, end_field);
 
-  begin_field.set_int(target_record, -trx_id_);
-  end_field.set_int(target_record, trx_kit_.max_trx_id());
+  begin_field.set(record, Xid::uncommitted(trx_id_));
+  end_field.set(record, trx_kit_.max_trx_id());
+
+  // 日志中只记录新旧数据之间发生变化的那一段，新数据后面跟着同样长度的旧数据，恢复时回滚要用旧数据
+  const int   record_size = table->table_meta().record_size();
+  const char *old_data    = target_record.data();
+  const char *new_data    = record.data();
+  int         data_offset = 0;
+  int         data_end    = record_size;
+  while (data_offset < data_end && old_data[data_offset] == new_data[data_offset]) {
+    data_offset++;
+  }
+  while (data_end > data_offset && old_data[data_end - 1] == new_data[data_end - 1]) {
+    data_end--;
+  }
 
-  RC rc = table->update_record(target_record, record);
+  // 当前事务第一次修改这条记录时，保存更新前的数据。如果记录是当前事务插入的，回滚时直接删除即可。
+  // 更新前的数据同时作为旧版本保存到undo中，其它事务在页面上看不到最新版本时读取它
+  Operation  operation(Operation::Type::UPDATE, table, target_record.rid());
+  const bool first_touch = (operations_.count(operation) == 0);
+  UndoStore &undo_store  = trx_kit_.undo_store();
+  if (first_touch) {
+    before_images_.emplace(operation, vector<char>(old_data, old_data + record_size));
+
+    rc = undo_store.push(
+        table->table_id(), target_record.rid(), trx_id_, begin_field.get(target_record), old_data, record_size);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to save old version of record. rid=%s, rc=%s", target_record.rid().to_string().c_str(), strrc(rc));
+      before_images_.erase(operation);
+      return rc;
+    }
+  }
+
+  RecordLogger logger = nullptr;
+  vector<char> log_data;
+  if (data_end > data_offset) {
+    const int change_len = data_end - data_offset;
+    log_data.resize(2 * change_len);
+    memcpy(log_data.data(), new_data + data_offset, change_len);
+    memcpy(log_data.data() + change_len, old_data + data_offset, change_len);
+    logger = [this, table, &log_data, data_offset](const RID &rid) {
+      return append_data_log(
+          CLogType::UPDATE, table, rid, static_cast<int32_t>(log_data.size()), data_offset, log_data.data());
+    };
+  }
+  rc = table->update_record(target_record, record, logger);
   if (rc != RC::SUCCESS) {
+    if (first_touch) {
+      before_images_.erase(operation);
+      undo_store.pop(table->table_id(), record.rid(), trx_id_);
+    }
+
+    // 新的值无法按照页面的编码方式原地存放，把记录搬到其它页面：删除旧的记录，再插入新的记录。
+    // 其它事务通过旧的记录仍然看到更新之前的数据，回滚时也不需要在原来的页面上写回旧值
+    if (rc == RC::RECORD_NOMEM) {
+      LOG_TRACE("cannot update record in place, relocate it. table=%s, rid=%s",
+                table->name(), target_record.rid().to_string().c_str());
+      rc = delete_record(table, target_record);
+      if (OB_SUCC(rc)) {
+        rc = insert_record(table, record);
+      }
+      return rc;
+    }
+
     LOG_WARN("failed to update record into table. rc=%s", strrc(rc));
     return rc;
   }
 
-  rc = log_manager_->append_log(CLogType::UPDATE, trx_id_, table->table_id(), record.rid(), record.len(), 0/*offset*/, record.data());
-  ASSERT(rc == RC::SUCCESS, "failed to append update record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
-         trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
-
-
-  operations_.insert(Operation(Operation::Type::UPDATE, table, record.rid()));
+  operations_.insert(operation);
   return rc;
 }
 
 RC MvccTrx::insert_record(Table *table, Record &record)
 {
-  Field begin_field;
-  Field end_field;
+  if (read_only_) {
+    LOG_WARN("cannot insert record in a read only transaction. table=%s", table->name());
+    return RC::TRX_READ_ONLY;
+  }
+
+  XidField begin_field;
+  XidField end_field;
   trx_fields(table, begin_field, end_field);
 
-  begin_field.set_int(record, -trx_id_);
-  end_field.set_int(record, trx_kit_.max_trx_id());
+  begin_field.set(record, Xid::uncommitted(trx_id_));
+  end_field.set(record, trx_kit_.max_trx_id());
 
-  RC rc = table->insert_record(record);
+  // 插入索引失败时记录会被删掉，删除也要写日志。重做时与删除当前事务插入的记录一样处理
+  auto logger = [this, table, &record](const RID &rid) {
+    return append_data_log(CLogType::INSERT, table, rid, record.len(), 0 /*offset*/, record.data());
+  };
+  auto undo_logger = [this, table](const RID &rid) { return append_data_log(CLogType::DELETE, table, rid); };
+
+  RC rc = table->insert_record(record, logger, undo_logger);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to insert record into table. rc=%s", strrc(rc));
     return rc;
   }
 
-  rc = log_manager_->append_log(
-      CLogType::INSERT, trx_id_, table->table_id(), record.rid(), record.len(), 0 /*offset*/, record.data());
-  ASSERT(rc == RC::SUCCESS, "failed to append insert record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
-      trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
-
   pair<OperationSet::iterator, bool> ret = operations_.insert(Operation(Operation::Type::INSERT, table, record.rid()));
   if (!ret.second) {
     rc = RC::INTERNAL;
@@ -171,41 +487,110 @@ RC MvccTrx::insert_record(Table *table, Record &record)
   return rc;
 }
 
+RC MvccTrx::insert_records(Table *table, vector<Record> &records)
+{
+  if (read_only_) {
+    LOG_WARN("cannot insert records in a read only transaction. table=%s", table->name());
+    return RC::TRX_READ_ONLY;
+  }
+
+  XidField begin_field;
+  XidField end_field;
+  trx_fields(table, begin_field, end_field);
+
+  for (Record &record : records) {
+    begin_field.set(record, Xid::uncommitted(trx_id_));
+    end_field.set(record, trx_kit_.max_trx_id());
+  }
+
+  // 放到同一个页面上的一批记录，日志一起写入日志缓存，不会与其它事务的日志交错
+  auto logger = [this, table, &records](int first, int num) {
+    vector<unique_ptr<CLogRecord>> log_records;
+    log_records.reserve(num);
+    for (int i = first; i < first + num; i++) {
+      const Record &record = records[i];
+      log_records.emplace_back(CLogRecord::build_data_record(
+          CLogType::INSERT, trx_id_, table->table_id(), record.rid(), record.len(), 0 /*offset*/, record.data()));
+    }
+    RC rc = log_manager_->append_logs(log_records);
+    ASSERT(rc == RC::SUCCESS, "failed to append insert record logs. trx id=%ld, table id=%d, record num=%d, rc=%s",
+        trx_id_, table->table_id(), num, strrc(rc));
+    return log_records.back()->header().lsn_;
+  };
+  auto undo_logger = [this, table](const RID &rid) { return append_data_log(CLogType::DELETE, table, rid); };
+
+  RC rc = table->insert_records(records, logger, undo_logger);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to insert records into table. record num=%d, rc=%s", static_cast<int>(records.size()), strrc(rc));
+    return rc;
+  }
+
+  for (const Record &record : records) {
+    pair<OperationSet::iterator, bool> ret =
+        operations_.insert(Operation(Operation::Type::INSERT, table, record.rid()));
+    if (!ret.second) {
+      rc = RC::INTERNAL;
+      LOG_WARN("failed to insert operation(insertion) into operation set: duplicate");
+    }
+  }
+  return rc;
+}
+
 RC MvccTrx::delete_record(Table *table, Record &record)
 {
-  Field begin_field;
-  Field end_field;
+  if (read_only_) {
+    LOG_WARN("cannot delete record in a read only transaction. table=%s", table->name());
+    return RC::TRX_READ_ONLY;
+  }
+
+  XidField begin_field;
+  XidField end_field;
   trx_fields(table, begin_field, end_field);
 
-  int32_t                  begin_xid = begin_field.get_int(record);
-  [[maybe_unused]] int32_t end_xid   = end_field.get_int(record);
+  [[maybe_unused]] int64_t begin_xid = begin_field.get(record);
+  [[maybe_unused]] int64_t end_xid   = end_field.get(record);
   /// 在删除之前，第一次获取record时，就已经对record做了对应的检查，并且保证不会有其它的事务来访问这条数据
-  ASSERT(end_xid > 0, "concurrency conflit: other transaction is updating this record. end_xid=%d, current trx id=%d, rid=%s",
+  ASSERT(!Xid::is_uncommitted(end_xid), "concurrency conflit: other transaction is updating this record. end_xid=%lx, current trx id=%ld, rid=%s",
          end_xid, trx_id_, record.rid().to_string().c_str());
   if (end_xid != trx_kit_.max_trx_id()) {
     // 当前不是多版本数据中的最新记录，不需要删除
     return RC::SUCCESS;
   }
 
-  end_field.set_int(record, -trx_id_);
-  RC rc = log_manager_->append_log(CLogType::DELETE, trx_id_, table->table_id(), record.rid(), 0, 0, nullptr);
-  ASSERT(rc == RC::SUCCESS, "failed to append delete record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
-      trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
-  if (begin_xid == -trx_id_) {
+  RC rc = lock_record(table, record.rid());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  auto logger = [this, table](const RID &rid) { return append_data_log(CLogType::DELETE, table, rid); };
+
+  // 更新过的记录上的开始事务号也是当前事务，只能通过操作的类型区分是不是当前事务插入的
+  OperationSet::iterator op_iter = operations_.find(Operation(Operation::Type::DELETE, table, record.rid()));
+  if (op_iter != operations_.end() && op_iter->type() == Operation::Type::INSERT) {
     // fix：此处是为了修复由当前事务插入而又被当前事务删除时无法正确删除的问题：
     // 在当前事务中创建的记录从来未对外暴露过，未来方便今后添加垃圾回收功能，这里选择直接删除真实记录
     // 就认为记录从来未存在过，此时无论是commit还是rollback都能得到正确的结果，并且需要清空之前的insert
     // operation,避免事务结束时执行
-    auto                                     delete_operation = Operation{Operation::Type::INSERT, table, record.rid()};
-    std::unordered_set<Operation>::size_type delete_result    = operations_.erase(delete_operation);
-    ASSERT(delete_result == 1, "failed to delete insert operation,begin_xid=%d, end_xid=%d, tid=%d, rid:%s",
-        begin_xid, end_xid, trx_id_, record.rid().to_string().c_str());
-    rc = table->delete_record(record);
-    ASSERT(rc == RC::SUCCESS, "failed to delete record in table.table id =%d, rid=%s, begin_xid=%d, end_xid=%d, current trx id = %d",
+    operations_.erase(op_iter);
+    end_field.set(record, Xid::uncommitted(trx_id_));
+    rc = table->delete_record(record, logger);
+    ASSERT(rc == RC::SUCCESS, "failed to delete record in table.table id =%d, rid=%s, begin_xid=%lx, end_xid=%lx, current trx id = %ld",
         table->table_id(), record.rid().to_string().c_str(), begin_xid, end_xid, trx_id_);
     return rc;
   }
 
+  // 扫描出来的记录不一定直接指向页面(比如PAX格式的表)，所以通过visit_record修改页面上的数据
+  end_field.set(record, Xid::uncommitted(trx_id_));
+  auto record_updater = [this, &end_field](Record &page_record) { end_field.set(page_record, Xid::uncommitted(trx_id_)); };
+  rc                  = table->visit_record(record.rid(), false /*readonly*/, record_updater, logger);
+  ASSERT(rc == RC::SUCCESS, "failed to mark record deleted. trx id=%ld, table id=%d, rid=%s, rc=%s",
+      trx_id_, table->table_id(), record.rid().to_string().c_str(), strrc(rc));
+
+  if (op_iter != operations_.end()) {
+    // 当前事务更新过这条记录，提交时会一起设置结束事务号，回滚时恢复更新前的数据也就撤销了删除
+    return RC::SUCCESS;
+  }
+
   pair<OperationSet::iterator, bool> ret = operations_.insert(Operation(Operation::Type::DELETE, table, record.rid()));
   if (!ret.second) {
     LOG_WARN("failed to insert operation(deletion) into operation set: duplicate");
@@ -217,36 +602,160 @@ RC MvccTrx::delete_record(Table *table, Record &record)
 
 RC MvccTrx::visit_record(Table *table, Record &record, bool readonly)
 {
-  Field begin_field;
-  Field end_field;
+  set_hint_xids(table, record, true /*in_page*/);
+
+  XidField begin_field;
+  XidField end_field;
   trx_fields(table, begin_field, end_field);
 
-  int32_t begin_xid = begin_field.get_int(record);
-  int32_t end_xid   = end_field.get_int(record);
+  const int64_t begin_xid = begin_field.get(record);
+  const int64_t end_xid   = end_field.get(record);
 
-  RC rc = RC::SUCCESS;
-  if (begin_xid > 0 && end_xid > 0) {
-    if (trx_id_ >= begin_xid && trx_id_ <= end_xid) {
-      rc = RC::SUCCESS;
-    } else {
-      rc = RC::RECORD_INVISIBLE;
+  // 插入(或者更新)和删除这条记录的事务，对当前事务的读视图是否可见
+  TrxStatusTable &status_table = trx_kit_.status_table();
+  const bool      created      = read_view_.sees(begin_xid, status_table);
+  const bool      deleted      = read_view_.sees(end_xid, status_table);
+
+  if (!readonly) {
+    // 其它还没有结束的事务修改了这条记录，等它结束以后再访问。只有插入了记录的事务不加锁，它的记录本来就看不到
+    auto modified_by_other = [this](int64_t xid) { return Xid::is_uncommitted(xid) && Xid::trx_id(xid) != trx_id_; };
+    if ((modified_by_other(begin_xid) || modified_by_other(end_xid)) &&
+        trx_kit_.lock_manager()->locked_by_other(trx_id_, table->table_id(), record.rid())) {
+      return RC::LOCKED_NEED_WAIT;
     }
-  } else if (begin_xid < 0) {
-    // begin xid 小于0说明是刚插入而且没有提交的数据
-    rc = (-begin_xid == trx_id_) ? RC::SUCCESS : RC::RECORD_INVISIBLE;
-  } else if (end_xid < 0) {
-    // end xid 小于0 说明是正在删除但是还没有提交的数据
-    if (readonly) {
-      // 如果 -end_xid 就是当前事务的事务号，说明是当前事务删除的
-      rc = (-end_xid != trx_id_) ? RC::SUCCESS : RC::RECORD_INVISIBLE;
-    } else {
-      // 如果当前想要修改此条数据，并且不是当前事务删除的，简单的报错
-      // 这是事务并发处理的一种方式，非常简单粗暴。其它的并发处理方法，可以等待，或者让客户端重试
-      // 或者等事务结束后，再检测修改的数据是否有冲突
-      rc = (-end_xid != trx_id_) ? RC::LOCKED_CONCURRENCY_CONFLICT : RC::RECORD_INVISIBLE;
+
+    // 其它事务在当前事务开始之后删除了这条数据，简单的报错
+    if (!deleted && end_xid != trx_kit_.max_trx_id()) {
+      return RC::LOCKED_CONCURRENCY_CONFLICT;
     }
   }
-  return rc;
+
+  if (created) {
+    return deleted ? RC::RECORD_INVISIBLE : RC::SUCCESS;
+  }
+
+  // 最新版本是其它事务插入或者更新的，当前事务可能看得到更新之前的旧版本
+  return visit_old_version(table, record, readonly);
+}
+
+RC MvccTrx::visit_old_version(Table *table, Record &record, bool readonly)
+{
+  UndoStore &undo_store = trx_kit_.undo_store();
+  if (recovering_ || undo_store.version_count() == 0) {
+    return RC::RECORD_INVISIBLE;
+  }
+
+  TrxStatusTable &status_table = trx_kit_.status_table();
+  auto            visible      = [this, &status_table](int64_t begin_xid, int64_t end_xid) {
+    return read_view_.sees(begin_xid, status_table) && !read_view_.sees(end_xid, status_table);
+  };
+
+  int64_t      begin_xid = 0;
+  int64_t      end_xid   = 0;
+  vector<char> data;
+  RC rc = undo_store.find_version(table->table_id(), record.rid(), visible, begin_xid, end_xid, readonly ? &data : nullptr);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  if (!readonly) {
+    // 当前事务能看到的版本已经被其它事务覆盖了，不能在旧版本上修改
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  char *version_data = static_cast<char *>(malloc(data.size()));
+  ASSERT(nullptr != version_data, "failed to allocate memory. size=%d", static_cast<int>(data.size()));
+  memcpy(version_data, data.data(), data.size());
+  record.set_data_owner(version_data, static_cast<int>(data.size()));
+
+  XidField begin_field;
+  XidField end_field;
+  trx_fields(table, begin_field, end_field);
+  begin_field.set(record, begin_xid);
+  end_field.set(record, Xid::is_uncommitted(end_xid) ? trx_kit_.max_trx_id() : end_xid);
+  return RC::SUCCESS;
+}
+
+void MvccTrx::set_hint_xids(Table *table, Record &record, bool in_page)
+{
+  // 只读表的记录可能直接指向只读映射的数据文件，不能写入。设置只读之前已经改写过事务号了
+  if (table->table_meta().read_only()) {
+    return;
+  }
+
+  XidField begin_field;
+  XidField end_field;
+  trx_fields(table, begin_field, end_field);
+
+  TrxStatusTable &status_table = trx_kit_.status_table();
+  for (XidField *field : {&begin_field, &end_field}) {
+    const int64_t xid = field->get(record);
+    if (!Xid::is_uncommitted(xid) || Xid::trx_id(xid) == trx_id_) {
+      continue;
+    }
+
+    int64_t commit_xid = 0;
+    int64_t commit_lsn = -1;
+    if (status_table.get(Xid::trx_id(xid), &commit_xid, &commit_lsn) != TrxStatusTable::Status::COMMITTED) {
+      continue;
+    }
+    if (in_page && (commit_lsn < 0 || log_manager_ == nullptr || log_manager_->durable_lsn() <= commit_lsn)) {
+      continue;
+    }
+    field->set(record, commit_xid);
+  }
+}
+
+RC MvccTrx::wait_for_record(Table *table, const RID &rid)
+{
+  RC rc = trx_kit_.lock_manager()->lock(trx_id_, table->table_id(), rid);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to wait for row lock. trx id=%ld, table=%s, rid=%s, rc=%s",
+             trx_id_, table->name(), rid.to_string().c_str(), strrc(rc));
+    return rc;
+  }
+  holds_locks_ = true;
+
+  // 单语句事务相当于在拿到锁时才开始，之前读到的记录都没有修改过
+  if (single_statement_) {
+    trx_kit_.refresh_read_view(trx_id_, read_view_);
+  }
+  return RC::SUCCESS;
+}
+
+RC MvccTrx::lock_record(Table *table, const RID &rid)
+{
+  RC rc = trx_kit_.lock_manager()->try_lock(trx_id_, table->table_id(), rid);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("record is locked by other trx. trx id=%ld, table=%s, rid=%s",
+             trx_id_, table->name(), rid.to_string().c_str());
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+  holds_locks_ = true;
+  return RC::SUCCESS;
+}
+
+void MvccTrx::release_locks()
+{
+  if (holds_locks_) {
+    trx_kit_.lock_manager()->release_all(trx_id_);
+    holds_locks_ = false;
+  }
+}
+
+void MvccTrx::end_read_only()
+{
+  if (started_) {
+    trx_kit_.end_read_only_trx(read_view_);
+    started_ = false;
+  }
+}
+
+bool MvccTrx::has_old_versions(Table * /*table*/) { return trx_kit_.undo_store().version_count() > 0; }
+
+void MvccTrx::old_version_rids(Table *table, const function<bool(const char *, int)> &match, vector<RID> &rids)
+{
+  trx_kit_.undo_store().collect_rids(table->table_id(), match, rids);
 }
 
 /**
@@ -256,24 +765,30 @@ RC MvccTrx::visit_record(Table *table, Record &record, bool readonly)
  * @param begin_xid_field 返回处理begin_xid的字段
  * @param end_xid_field   返回处理end_xid的字段
  */
-void MvccTrx::trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_field) const
+void MvccTrx::trx_fields(Table *table, XidField &begin_xid_field, XidField &end_xid_field) const
 {
   const TableMeta                        &table_meta = table->table_meta();
   const std::pair<const FieldMeta *, int> trx_fields = table_meta.trx_fields();
   ASSERT(trx_fields.second >= 2, "invalid trx fields number. %d", trx_fields.second);
 
-  begin_xid_field.set_table(table);
   begin_xid_field.set_field(&trx_fields.first[0]);
-  end_xid_field.set_table(table);
   end_xid_field.set_field(&trx_fields.first[1]);
 }
 
 RC MvccTrx::start_if_need()
 {
+  if (!started_ && read_only_) {
+    // 只读事务只需要读视图，不分配事务号，也不写日志
+    trx_kit_.begin_read_only_trx(read_view_);
+    trx_id_  = -1;
+    started_ = true;
+    return RC::SUCCESS;
+  }
+
   if (!started_) {
     ASSERT(operations_.empty(), "try to start a new trx while operations is not empty");
-    trx_id_ = trx_kit_.next_trx_id();
-    LOG_DEBUG("current thread change to new trx with %d", trx_id_);
+    trx_id_ = trx_kit_.begin_trx(this, read_view_);
+    LOG_DEBUG("current thread change to new trx with %ld", trx_id_);
     RC rc = log_manager_->begin_trx(trx_id_);
     ASSERT(rc == RC::SUCCESS, "failed to append log to clog. rc=%s", strrc(rc));
     started_ = true;
@@ -283,84 +798,162 @@ RC MvccTrx::start_if_need()
 
 RC MvccTrx::commit()
 {
-  int32_t commit_id = trx_kit_.next_trx_id();
+  if (read_only_) {
+    end_read_only();
+    return RC::SUCCESS;
+  }
+
+  // 先标记为正在提交，提交日志写入日志缓存以后再标记为已提交，其它事务就能通过事务状态表看到所有修改。
+  // 记录上的事务号不在这里改写，写完提交日志以后把修改过的记录交给 MvccTrxKit，读取时通过事务状态表判断，之后再一起改写
+  int64_t commit_id = trx_kit_.prepare_commit(trx_id_);
   return commit_with_trx_id(commit_id);
 }
 
-RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
+RC MvccTrx::commit_with_trx_id(int64_t commit_xid, LSN redo_lsn /*=-1*/)
 {
-  // TODO 这里存在一个很大的问题，不能让其他事务一次性看到当前事务更新到的数据或同时看不到
   RC rc    = RC::SUCCESS;
   started_ = false;
 
+  // 重做时没有事务状态表可以查询，直接改写记录上的事务号
+  vector<pair<Table *, RID>> rids;
+  const RecordLogger         logger = page_lsn_setter(redo_lsn);
   for (const Operation &operation : operations_) {
-    switch (operation.type()) {
-      case Operation::Type::INSERT:
-      case Operation::Type::UPDATE: {
-        RID rid(operation.page_num(), operation.slot_num());
-        Table *table = operation.table();
-        Field  begin_xid_field, end_xid_field;
-        trx_fields(table, begin_xid_field, end_xid_field);
-
-        auto record_updater = [this, &begin_xid_field, commit_xid](Record &record) {
-          LOG_DEBUG("before commit insert record. trx id=%d, begin xid=%d, commit xid=%d, lbt=%s",
-                    trx_id_, begin_xid_field.get_int(record), commit_xid, lbt());
-          ASSERT(begin_xid_field.get_int(record) == -this->trx_id_, 
-                 "got an invalid record while committing. begin xid=%d, this trx id=%d", 
-                 begin_xid_field.get_int(record), trx_id_);
-
-          begin_xid_field.set_int(record, commit_xid);
-        };
-
-        rc = operation.table()->visit_record(rid, false /*readonly*/, record_updater);
-        ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
-               rid.to_string().c_str(), strrc(rc));
-      } break;
+    Table *table = operation.table();
+    RID    rid(operation.page_num(), operation.slot_num());
 
-      case Operation::Type::DELETE: {
-        Table *table = operation.table();
-        RID    rid(operation.page_num(), operation.slot_num());
-
-        Field begin_xid_field, end_xid_field;
-        trx_fields(table, begin_xid_field, end_xid_field);
-
-        auto record_updater = [this, &end_xid_field, commit_xid](Record &record) {
-          (void)this;
-          ASSERT(end_xid_field.get_int(record) == -trx_id_, 
-                 "got an invalid record while committing. end xid=%d, this trx id=%d", 
-                 end_xid_field.get_int(record), trx_id_);
-
-          end_xid_field.set_int(record, commit_xid);
-        };
+    if (!recovering_) {
+      rids.emplace_back(table, rid);
+      if (operation.type() == Operation::Type::UPDATE) {
+        trx_kit_.undo_store().commit(table->table_id(), rid, trx_id_, commit_xid);
+      }
+      continue;
+    }
 
-        rc = operation.table()->visit_record(rid, false /*readonly*/, record_updater);
-        ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
-               rid.to_string().c_str(), strrc(rc));
-      } break;
+    XidField begin_xid_field, end_xid_field;
+    trx_fields(table, begin_xid_field, end_xid_field);
 
-      default: {
-        ASSERT(false, "unsupported operation. type=%d", static_cast<int>(operation.type()));
+    // 页面在checkpoint时可能已经带着提交后的数据写到了磁盘，之后记录还可能被删除，槽位被其它记录使用，
+    // 所以只改写当前事务的事务号
+    auto record_updater = [this, &begin_xid_field, &end_xid_field, commit_xid](Record &record) {
+      if (begin_xid_field.get(record) == Xid::uncommitted(trx_id_)) {
+        begin_xid_field.set(record, commit_xid);
       }
+      if (end_xid_field.get(record) == Xid::uncommitted(trx_id_)) {
+        end_xid_field.set(record, commit_xid);
+      }
+    };
+
+    rc = table->visit_record(rid, false /*readonly*/, record_updater, logger);
+    if (OB_FAIL(rc)) {
+      LOG_TRACE("record does not exist while committing. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+      rc = RC::SUCCESS;
     }
   }
 
   operations_.clear();
+  before_images_.clear();
+  inserted_images_.clear();
+  update_undos_.clear();
 
   if (!recovering_) {
-    rc = log_manager_->commit_trx(trx_id_, commit_xid);
+    bool committed = false;
+    rc = log_manager_->commit_trx(trx_id_, commit_xid, nullptr /*lsn*/, !async_commit_,
+        [this, commit_xid, &committed](int64_t lsn) {
+          trx_kit_.commit_trx(trx_id_, commit_xid, lsn);
+          committed = true;
+        });
+    // 读视图会一直等待正在提交的事务。没有写入提交日志时也标记为已提交，不过记录上的事务号不会提前写到页面上
+    if (!committed) {
+      trx_kit_.commit_trx(trx_id_, commit_xid, -1 /*commit_lsn*/);
+    }
+  }
+  // 提交日志写入以后才能改写记录上的事务号。交给 MvccTrxKit 之前，checkpoint 还把事务当作正在运行，
+  // 恢复时会重做它的提交日志
+  trx_kit_.end_trx(trx_id_, std::move(rids));
+  if (!recovering_) {
+    log_manager_->end_trx(trx_id_);
   }
-  LOG_TRACE("append trx commit log. trx id=%d, commit_xid=%d, rc=%s", trx_id_, commit_xid, strrc(rc));
+  release_locks();
+  trx_kit_.purge_undo();
+  LOG_TRACE("append trx commit log. trx id=%ld, commit_xid=%ld, rc=%s", trx_id_, commit_xid, strrc(rc));
   return rc;
 }
 
 RC MvccTrx::rollback()
+{
+  if (read_only_) {
+    end_read_only();
+    return RC::SUCCESS;
+  }
+
+  trx_kit_.abort_trx(trx_id_);
+  return rollback_with_lsn(-1);
+}
+
+RC MvccTrx::rollback_with_lsn(LSN redo_lsn)
 {
   RC rc    = RC::SUCCESS;
   started_ = false;
 
+  // 运行时先写回滚日志，恢复每个页面之后、释放页面锁之前把回滚日志的LSN设置到页面上。
+  // 回滚日志落盘以后，还没有恢复完的页面会在重做回滚日志时恢复。
+  // 恢复结束时回滚未完成的事务不会重做日志，也没有回滚日志，页面会在之后的checkpoint中写入磁盘
+  LSN lsn = redo_lsn;
+  if (!recovering_) {
+    rc = log_manager_->rollback_trx(trx_id_, &lsn);
+    ASSERT(rc == RC::SUCCESS, "failed to append trx rollback log. trx id=%ld, rc=%s", trx_id_, strrc(rc));
+  }
+  const RecordLogger logger = page_lsn_setter(lsn);
+
   for (const Operation &operation : operations_) {
+    if (redo_applied(operation.table(), operation.page_num(), redo_lsn)) {
+      // 插入的记录已经从页面上删掉了，索引页面没有记录日志，需要再删除一次索引项
+      RecordImages::iterator image_iter = inserted_images_.find(operation);
+      if (operation.type() == Operation::Type::INSERT && image_iter != inserted_images_.end()) {
+        Record record;
+        record.set_rid(RID(operation.page_num(), operation.slot_num()));
+        record.set_data(image_iter->second.data(), static_cast<int>(image_iter->second.size()));
+        rc = operation.table()->recover_delete_index_entries(record);
+        ASSERT(rc == RC::SUCCESS, "failed to delete index entries while rollback. rid=%s, rc=%s",
+               record.rid().to_string().c_str(), strrc(rc));
+      }
+      continue;
+    }
+
     switch (operation.type()) {
-      // TODO: Operation::Type::UPDATE:
+      case Operation::Type::UPDATE: {
+        Table *table = operation.table();
+        RID    rid(operation.page_num(), operation.slot_num());
+
+        Record current_record;
+        rc = table->get_record(rid, current_record);
+        ASSERT(rc == RC::SUCCESS, "failed to get record while rollback. rid=%s, rc=%s",
+               rid.to_string().c_str(), strrc(rc));
+
+        vector<char> old_data;
+        if (!recovering_) {
+          RecordImages::iterator image_iter = before_images_.find(operation);
+          ASSERT(image_iter != before_images_.end(), "cannot find record image while rollback. rid=%s",
+                 rid.to_string().c_str());
+          old_data.swap(image_iter->second);
+        } else {
+          old_data = build_before_image(table, operation, current_record);
+        }
+
+        // 运行时原地更新以后总能写回旧值，参考 ColumnCodec::can_overwrite。恢复时页面的编码状态可能不同，需要重新编码
+        Record old_record;
+        old_record.set_data(old_data.data(), static_cast<int>(old_data.size()));
+        rc = recovering_ ? table->recover_update_record(current_record, old_record, logger)
+                         : table->update_record(current_record, old_record, logger);
+        ASSERT(rc == RC::SUCCESS, "failed to restore record while rollback. rid=%s, rc=%s",
+               rid.to_string().c_str(), strrc(rc));
+
+        // 页面上已经恢复了更新前的数据，之后再删除旧版本，其它事务总能看到其中的一个
+        if (!recovering_) {
+          trx_kit_.undo_store().pop(table->table_id(), rid, trx_id_);
+        }
+      } break;
+
       case Operation::Type::INSERT: {
         RID    rid(operation.page_num(), operation.slot_num());
         Record record;
@@ -372,7 +965,7 @@ RC MvccTrx::rollback()
         rc = table->get_record(rid, record);
         ASSERT(rc == RC::SUCCESS, "failed to get record while rollback. rid=%s, rc=%s", 
                rid.to_string().c_str(), strrc(rc));
-        rc = table->delete_record(record);
+        rc = table->delete_record(record, logger);
         ASSERT(rc == RC::SUCCESS, "failed to delete record while rollback. rid=%s, rc=%s",
               rid.to_string().c_str(), strrc(rc));
       } break;
@@ -383,18 +976,18 @@ RC MvccTrx::rollback()
 
         ASSERT(rc == RC::SUCCESS, "failed to get record while rollback. rid=%s, rc=%s",
               rid.to_string().c_str(), strrc(rc));
-        Field begin_xid_field, end_xid_field;
+        XidField begin_xid_field, end_xid_field;
         trx_fields(table, begin_xid_field, end_xid_field);
 
         auto record_updater = [this, &end_xid_field](Record &record) {
-          ASSERT(end_xid_field.get_int(record) == -trx_id_, 
-                "got an invalid record while rollback. end xid=%d, this trx id=%d", 
-                end_xid_field.get_int(record), trx_id_);
+          ASSERT(end_xid_field.get(record) == Xid::uncommitted(trx_id_), 
+                "got an invalid record while rollback. end xid=%lx, this trx id=%ld", 
+                end_xid_field.get(record), trx_id_);
 
-          end_xid_field.set_int(record, trx_kit_.max_trx_id());
+          end_xid_field.set(record, trx_kit_.max_trx_id());
         };
 
-        rc = table->visit_record(rid, false /*readonly*/, record_updater);
+        rc = table->visit_record(rid, false /*readonly*/, record_updater, logger);
         ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
                rid.to_string().c_str(), strrc(rc));
       } break;
@@ -406,11 +999,18 @@ RC MvccTrx::rollback()
   }
 
   operations_.clear();
+  before_images_.clear();
+  inserted_images_.clear();
+  update_undos_.clear();
 
+  // 页面都恢复以后 checkpoint 才能不再把事务当作正在运行
   if (!recovering_) {
-    rc = log_manager_->rollback_trx(trx_id_);
+    log_manager_->end_trx(trx_id_);
   }
-  LOG_TRACE("append trx rollback log. trx id=%d, rc=%s", trx_id_, strrc(rc));
+  trx_kit_.end_trx(trx_id_);
+  release_locks();
+  trx_kit_.purge_undo();
+  LOG_TRACE("append trx rollback log. trx id=%ld, rc=%s", trx_id_, strrc(rc));
   return rc;
 }
 
@@ -418,6 +1018,7 @@ RC find_table(Db *db, const CLogRecord &log_record, Table *&table)
 {
   switch (clog_type_from_integer(log_record.header().type_)) {
     case CLogType::INSERT:
+    case CLogType::UPDATE:
     case CLogType::DELETE: {
       const CLogRecordData &data_record = log_record.data_record();
       table                             = db->find_table(data_record.table_id_);
@@ -442,51 +1043,155 @@ RC MvccTrx::redo(Db *db, const CLogRecord &log_record)
     return rc;
   }
 
+  // 并行重做时，同一个事务在不同页面上的日志可能同时重做，访问事务自己的操作集合时需要加锁。
+  // 同一个页面上的日志总是按照顺序重做的
+  const LSN lsn = log_record.header().lsn_;
   switch (log_record.log_type()) {
-      //TODO: CLogType::UPDATE
     case CLogType::INSERT: {
       const CLogRecordData &data_record = log_record.data_record();
       Record                record;
       record.set_data(const_cast<char *>(data_record.data_), data_record.data_len_);
       record.set_rid(data_record.rid_);
-      RC rc = table->recover_insert_record(record);
+
+      Operation operation(Operation::Type::INSERT, table, record.rid());
+      if (redo_applied(table, record.rid().page_num, lsn)) {
+        // 记录已经在页面上了，但是索引页面没有记录日志，需要保证索引项存在。
+        // 页面上的记录可能已经被之后的日志删掉或者换成了别的记录，这时就不需要索引项了
+        Record page_record;
+        const std::pair<const FieldMeta *, int> trx_fields  = table->table_meta().trx_fields();
+        const FieldMeta                        &last_field  = trx_fields.first[trx_fields.second - 1];
+        const int                               data_offset = last_field.offset() + last_field.len();
+        if (OB_SUCC(table->get_record(record.rid(), page_record)) &&
+            0 == memcmp(page_record.data() + data_offset, record.data() + data_offset, record.len() - data_offset)) {
+          rc = table->recover_insert_index_entries(record);
+        }
+      } else {
+        rc = table->recover_insert_record(record, page_lsn_setter(lsn));
+      }
       if (OB_FAIL(rc)) {
         LOG_WARN("failed to recover insert. table=%s, log record=%s, rc=%s",
                  table->name(), log_record.to_string().c_str(), strrc(rc));
         return rc;
       }
-      operations_.insert(Operation(Operation::Type::INSERT, table, record.rid()));
+
+      lock_guard<mutex> guard(redo_lock_);
+      inserted_images_[operation].assign(data_record.data_, data_record.data_ + data_record.data_len_);
+      operations_.insert(operation);
     } break;
 
     case CLogType::DELETE: {
       const CLogRecordData &data_record = log_record.data_record();
-      Field                 begin_field;
-      Field                 end_field;
-      trx_fields(table, begin_field, end_field);
+      const RID            &rid         = data_record.rid_;
+      const bool            applied     = redo_applied(table, rid.page_num, lsn);
+
+      // 与 delete_record 一样，删除当前事务插入的记录时会直接删除真实记录
+      bool              own_record = false;
+      vector<char>      inserted_data;
+      {
+        lock_guard<mutex>      guard(redo_lock_);
+        OperationSet::iterator iter = operations_.find(Operation(Operation::Type::DELETE, table, rid));
+        if (iter != operations_.end() && iter->type() == Operation::Type::INSERT) {
+          own_record = true;
+          operations_.erase(iter);
+
+          RecordImages::iterator image_iter = inserted_images_.find(Operation(Operation::Type::INSERT, table, rid));
+          if (image_iter != inserted_images_.end()) {
+            inserted_data.swap(image_iter->second);
+            inserted_images_.erase(image_iter);
+          }
+        }
+      }
 
-      auto record_updater = [this, &end_field](Record &record) {
-        (void)this;
-        ASSERT(end_field.get_int(record) == trx_kit_.max_trx_id(), 
-               "got an invalid record while committing. end xid=%d, this trx id=%d", 
-               end_field.get_int(record), trx_id_);
+      if (own_record) {
+        Record record;
+        if (!applied) {
+          rc = table->get_record(rid, record);
+          if (OB_SUCC(rc)) {
+            rc = table->delete_record(record, page_lsn_setter(lsn));
+          }
+        } else if (!inserted_data.empty()) {
+          // 记录已经从页面上删掉了，只需要删除索引项
+          record.set_rid(rid);
+          record.set_data(inserted_data.data(), static_cast<int>(inserted_data.size()));
+          rc = table->recover_delete_index_entries(record);
+        }
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to recover delete. table=%s, log record=%s, rc=%s",
+                   table->name(), log_record.to_string().c_str(), strrc(rc));
+          return rc;
+        }
+        break;
+      }
+
+      if (!applied) {
+        XidField begin_field;
+        XidField end_field;
+        trx_fields(table, begin_field, end_field);
 
-        end_field.set_int(record, -trx_id_);
-      };
+        auto record_updater = [this, &end_field](Record &record) {
+          (void)this;
+          // checkpoint时页面可能已经带着这次删除，甚至是提交之后的数据写到了磁盘
+          const int64_t end_xid = end_field.get(record);
+          ASSERT(end_xid == trx_kit_.max_trx_id() || end_xid == Xid::uncommitted(trx_id_) || !Xid::is_uncommitted(end_xid),
+                 "got an invalid record while committing. end xid=%lx, this trx id=%ld", 
+                 end_xid, trx_id_);
+
+          if (end_xid == trx_kit_.max_trx_id()) {
+            end_field.set(record, Xid::uncommitted(trx_id_));
+          }
+        };
 
-      RC rc = table->visit_record(data_record.rid_, false /*readonly*/, record_updater);
-      ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
-             data_record.rid_.to_string().c_str(), strrc(rc));
+        rc = table->visit_record(rid, false /*readonly*/, record_updater, page_lsn_setter(lsn));
+        ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
+               rid.to_string().c_str(), strrc(rc));
+      }
 
-      operations_.insert(Operation(Operation::Type::DELETE, table, data_record.rid_));
+      lock_guard<mutex> guard(redo_lock_);
+      operations_.insert(Operation(Operation::Type::DELETE, table, rid));
+    } break;
+
+    case CLogType::UPDATE: {
+      const CLogRecordData &data_record = log_record.data_record();
+      Operation             operation(Operation::Type::UPDATE, table, data_record.rid_);
+
+      // 日志中是发生变化的那一段新数据，后面跟着同样长度的旧数据
+      const int32_t change_len = data_record.data_len_ / 2;
+      const char   *new_data   = data_record.data_;
+      const char   *old_data   = data_record.data_ + change_len;
+
+      if (!redo_applied(table, data_record.rid_.page_num, lsn)) {
+        Record old_record;
+        rc = table->get_record(data_record.rid_, old_record);
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to get record to redo update. table=%s, log record=%s, rc=%s",
+                   table->name(), log_record.to_string().c_str(), strrc(rc));
+          return rc;
+        }
+
+        // 在页面上的数据上覆盖这一段新数据就是新的记录
+        Record new_record(old_record);
+        memcpy(new_record.data() + data_record.data_offset_, new_data, change_len);
+        rc = table->recover_update_record(old_record, new_record, page_lsn_setter(lsn));
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to recover update. table=%s, log record=%s, rc=%s",
+                   table->name(), log_record.to_string().c_str(), strrc(rc));
+          return rc;
+        }
+      }
+
+      // 页面可能已经带着这次甚至之后的修改写到了磁盘，不能从页面上得到更新前的数据，回滚时用日志中的旧数据
+      lock_guard<mutex> guard(redo_lock_);
+      update_undos_[operation].emplace_back(data_record.data_offset_, vector<char>(old_data, old_data + change_len));
+      operations_.insert(operation);
     } break;
 
     case CLogType::MTR_COMMIT: {
       const CLogRecordCommitData &commit_record = log_record.commit_record();
-      commit_with_trx_id(commit_record.commit_xid_);
+      commit_with_trx_id(commit_record.commit_xid_, lsn);
     } break;
 
     case CLogType::MTR_ROLLBACK: {
-      rollback();
+      rollback_with_lsn(lsn);
     } break;
 
     default: {
@@ -497,3 +1202,66 @@ RC MvccTrx::redo(Db *db, const CLogRecord &log_record)
 
   return RC::SUCCESS;
 }
+
+bool MvccTrx::redo_applied(Table *table, PageNum page_num, LSN redo_lsn) const
+{
+  if (redo_lsn < 0) {
+    return false;
+  }
+
+  LSN page_lsn = 0;
+  RC  rc       = table->get_page_lsn(page_num, page_lsn);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get page lsn. table=%s, page num=%d, rc=%s", table->name(), page_num, strrc(rc));
+    return false;
+  }
+  if (page_lsn >= redo_lsn) {
+    LOG_TRACE("page has applied the log. table=%s, page num=%d, page lsn=%ld, log lsn=%ld",
+              table->name(), page_num, page_lsn, redo_lsn);
+    return true;
+  }
+  return false;
+}
+
+vector<char> MvccTrx::build_before_image(Table *table, const Operation &operation, const Record &current_record)
+{
+  vector<char> data(current_record.data(), current_record.data() + current_record.len());
+
+  // 页面上是当前事务所有更新之后的数据，按照相反的顺序写回每次更新之前的数据
+  UpdateUndos::iterator undo_iter = update_undos_.find(operation);
+  if (undo_iter != update_undos_.end()) {
+    for (auto iter = undo_iter->second.rbegin(); iter != undo_iter->second.rend(); ++iter) {
+      memcpy(data.data() + iter->first, iter->second.data(), iter->second.size());
+    }
+  }
+
+  // 第一次更新时记录还没有被删除，之后被当前事务删除时设置的结束事务号不在更新日志中
+  XidField begin_field;
+  XidField end_field;
+  trx_fields(table, begin_field, end_field);
+
+  Record record;
+  record.set_data(data.data(), static_cast<int>(data.size()));
+  if (end_field.get(record) == Xid::uncommitted(trx_id_)) {
+    end_field.set(record, trx_kit_.max_trx_id());
+  }
+  return data;
+}
+
+LSN MvccTrx::append_data_log(
+    CLogType type, Table *table, const RID &rid, int32_t data_len, int32_t data_offset, const char *data)
+{
+  LSN lsn = 0;
+  RC  rc  = log_manager_->append_log(type, trx_id_, table->table_id(), rid, data_len, data_offset, data, &lsn);
+  ASSERT(rc == RC::SUCCESS, "failed to append record log. type=%s, trx id=%ld, table id=%d, rid=%s, data len=%d, rc=%s",
+         clog_type_name(type), trx_id_, table->table_id(), rid.to_string().c_str(), data_len, strrc(rc));
+  return lsn;
+}
+
+RecordLogger MvccTrx::page_lsn_setter(LSN lsn)
+{
+  if (lsn < 0) {
+    return nullptr;
+  }
+  return [lsn](const RID &) { return lsn; };
+}
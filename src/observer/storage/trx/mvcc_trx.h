@@ -14,9 +14,21 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
+#include "storage/clog/clog.h"
+#include "storage/trx/lock_manager.h"
+#include "storage/trx/read_view.h"
 #include "storage/trx/trx.h"
+#include "storage/trx/trx_status_table.h"
+#include "storage/trx/trx_table.h"
+#include "storage/trx/undo_store.h"
+#include "storage/trx/xid.h"
 
 class CLogManager;
 
@@ -29,44 +41,153 @@ public:
   RC                            init() override;
   const std::vector<FieldMeta> *trx_fields() const override;
   Trx                          *create_trx(CLogManager *log_manager) override;
-  Trx                          *create_trx(int32_t trx_id) override;
+  Trx                          *create_trx(int64_t trx_id) override;
   void                          destroy_trx(Trx *trx) override;
 
   /**
    * @brief 找到对应事务号的事务
-   * @details 当前仅在recover场景下使用
+   * @details 只能找到已经开始还没有结束的事务，当前仅在recover场景下使用
    */
-  Trx *find_trx(int32_t trx_id) override;
+  Trx *find_trx(int64_t trx_id) override;
   void all_trxes(std::vector<Trx *> &trxes) override;
 
+  std::unique_ptr<VacuumView> create_vacuum_view() override;
+
+  bool begin_exclusive(Trx *trx) override;
+  void end_exclusive(Trx *trx) override;
+
+  int64_t current_trx_id() const override { return current_trx_id_.load(); }
+  void    update_trx_id(int64_t trx_id) override;
+
+  void remove_table_versions(int32_t table_id) override;
+  void rewrite_committed_xids() override;
+
+  LockManager *lock_manager() override { return &lock_manager_; }
+
 public:
-  int32_t next_trx_id();
+  int64_t next_trx_id();
+
+  /**
+   * @brief 事务开始时分配事务号，并记录为正在运行的事务
+   * @details 如果有其它事务在独占运行，就等待它结束。只锁事务表和事务状态表中的一个分片
+   * @param read_view 返回事务的读视图，放到事务表之后创建
+   */
+  int64_t begin_trx(Trx *trx, ReadView &read_view);
+
+  /**
+   * @brief 只读事务开始时创建读视图
+   * @details 不分配事务号，也不放到事务表中，只记下读视图的低水位，
+   * 在它结束之前旧版本不会被清理，也不能独占运行
+   */
+  void begin_read_only_trx(ReadView &read_view);
+
+  /**
+   * @brief 只读事务结束，不再需要它的读视图
+   */
+  void end_read_only_trx(const ReadView &read_view);
+
+  /**
+   * @brief 为正在运行的事务重新创建读视图，之前提交的事务都可见
+   */
+  void refresh_read_view(int64_t trx_id, ReadView &read_view);
+
+  /**
+   * @brief 把事务标记为正在提交并分配提交事务号
+   * @details 分配之前先标记为正在提交，读视图遇到这个状态时会等待，参考 ReadView。
+   * 写入提交日志以后再调用 commit_trx 标记为已提交
+   */
+  int64_t prepare_commit(int64_t trx_id);
+
+  /**
+   * @brief 把事务标记为已提交
+   * @details 高水位比提交事务号大的读视图能看到它的所有修改，其它读视图都看不到。
+   * 提交日志写入日志缓存之后才能调用，看到这个事务提交的其它事务，日志都在它的提交日志后面。
+   * 提交时不改写记录，修改过的记录在 end_trx 时交给事务管理器
+   * @param commit_lsn 提交日志的LSN，提交日志落盘之前不能把提交事务号写到页面上
+   */
+  void commit_trx(int64_t trx_id, int64_t commit_xid, int64_t commit_lsn);
+
+  /**
+   * @brief 把事务标记为已回滚，在恢复数据之前调用
+   */
+  void abort_trx(int64_t trx_id);
+
+  /**
+   * @brief 事务提交或回滚后调用
+   * @details 回滚的事务已经恢复了所有修改过的记录，不再需要它在事务状态表中的状态。
+   * 提交的事务要等记录上的事务号改写完才能删除状态，修改过的记录先记下来，等到 rewrite_committed_xids 时再一起改写。
+   * 提交日志写入之后才能调用，否则改写过的页面可能在提交日志之前写到磁盘
+   * @param rids 提交的事务修改过的记录，上面还留着带有未提交标记的事务号
+   */
+  void end_trx(int64_t trx_id, std::vector<std::pair<Table *, RID>> &&rids = {});
+
+  /**
+   * @brief 正在运行的事务中最小的事务号，没有正在运行的事务时返回下一个要分配的事务号
+   * @details 提交事务号比它小的删除操作，对所有正在运行以及将来的事务都是可见的。
+   * 只读事务没有事务号，用它的读视图低水位代替
+   */
+  int64_t oldest_active_trx_id();
+
+  /**
+   * @brief 清理已经没有事务能看到的旧版本
+   */
+  void purge_undo();
+
+  UndoStore      &undo_store() { return undo_store_; }
+  TrxStatusTable &status_table() { return status_table_; }
 
 public:
-  int32_t max_trx_id() const;
+  int64_t max_trx_id() const;
 
 private:
   std::vector<FieldMeta> fields_;  // 存储事务数据需要用到的字段元数据，所有表结构都需要带的
 
-  std::atomic<int32_t> current_trx_id_{0};
+  std::atomic<int64_t> current_trx_id_{0};
+
+  TrxTable trx_table_;  ///< 还没有结束的事务
+
+  /// 保护只读事务的读视图和独占运行的事务，读写事务只在有事务独占运行时才会用到
+  std::mutex              active_lock_;
+  std::condition_variable active_cond_;
+  std::multiset<int64_t>  read_only_views_;  ///< 正在运行的只读事务的读视图低水位
+
+  /// 正在独占运行的事务。开始读写事务时先放到事务表中再检查它，begin_exclusive 先设置它再检查事务表，不会同时成功
+  std::atomic<Trx *> exclusive_trx_{nullptr};
 
-  common::Mutex      lock_;
-  std::vector<Trx *> trxes_;
+  /// 只读事务中最小的读视图低水位，没有只读事务时是 INT64_MAX。在 active_lock_ 内更新，oldest_active_trx_id 不加锁读取
+  std::atomic<int64_t> oldest_read_only_view_{std::numeric_limits<int64_t>::max()};
+
+  UndoStore      undo_store_;    ///< 被更新覆盖的旧版本数据
+  TrxStatusTable status_table_;  ///< 还没有结束的事务，以及记录上的事务号还没有改写的已提交事务的状态
+  LockManager    lock_manager_;  ///< 被修改的记录上的行锁
+
+  /// 已经提交但是记录上的事务号还没有改写的事务，以及它们修改过的记录。按照事务号分片，提交时只锁一个分片
+  struct UnrewrittenShard
+  {
+    std::mutex                                                        lock;
+    std::unordered_map<int64_t, std::vector<std::pair<Table *, RID>>> trxes;
+  };
+  static const int UNREWRITTEN_SHARD_NUM = 16;
+  UnrewrittenShard unrewritten_trxes_[UNREWRITTEN_SHARD_NUM];
+
+  std::mutex rewrite_lock_;  ///< 改写事务号时不能删除表
 };
 
 /**
  * @brief 多版本并发事务
  * @ingroup Transaction
- * TODO 没有垃圾回收
+ * @details 删除的记录只是标记了结束事务号，由VACUUM在它们对所有事务都不可见以后物理删除。
+ * 更新直接覆盖页面上的记录，被覆盖的数据作为旧版本保存在 UndoStore 中，看不到最新版本的事务沿着版本链找到可见的版本
  */
 class MvccTrx : public Trx
 {
 public:
   MvccTrx(MvccTrxKit &trx_kit, CLogManager *log_manager);
-  MvccTrx(MvccTrxKit &trx_kit, int32_t trx_id);  // used for recover
+  MvccTrx(MvccTrxKit &trx_kit, int64_t trx_id);  // used for recover
   virtual ~MvccTrx();
 
   RC insert_record(Table *table, Record &record) override;
+  RC insert_records(Table *table, std::vector<Record> &records) override;
   RC delete_record(Table *table, Record &record) override;
   RC update_record(Table *table, Record &target_record, Record &record) override;
 
@@ -78,31 +199,116 @@ public:
    * @param readonly 是否只读访问
    * @return RC      - SUCCESS 成功
    *                 - RECORD_INVISIBLE 此数据对当前事务不可见，应该跳过
+   *                 - LOCKED_NEED_WAIT 记录被其它还没有结束的事务修改了，需要调用 wait_for_record 等待
    *                 - LOCKED_CONCURRENCY_CONFLICT 与其它事务有冲突
    */
   RC visit_record(Table *table, Record &record, bool readonly) override;
 
+  /**
+   * @brief 排队等待记录上的行锁
+   * @details 持有锁的事务提交以后，当前事务的读视图看不到它的修改，再访问这条记录时返回冲突。
+   * 单语句事务在拿到锁以后重新创建读视图，直接在最新的版本上修改
+   */
+  RC wait_for_record(Table *table, const RID &rid) override;
+
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
 
   RC redo(Db *db, const CLogRecord &log_record) override;
 
-  int32_t id() const override { return trx_id_; }
+  int64_t id() const override { return trx_id_; }
 
-private:
-  RC   commit_with_trx_id(int32_t commit_id);
-  void trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_field) const;
+  bool has_old_versions(Table *table) override;
+  void old_version_rids(
+      Table *table, const std::function<bool(const char *, int)> &match, std::vector<RID> &rids) override;
+
+  /**
+   * @brief 重做日志、回滚或者改写提交事务号时，修改页面之后把页面LSN设置为 lsn。lsn 小于0时不需要设置
+   */
+  static RecordLogger page_lsn_setter(LSN lsn);
 
 private:
-  static const int32_t MAX_TRX_ID = std::numeric_limits<int32_t>::max();
+  /**
+   * @brief 记录的最新版本对当前事务不可见时，查找可见的旧版本
+   * @details 只读访问时把可见的旧版本复制到 record 中。修改时说明记录已经被其它事务更新了，返回冲突
+   */
+  RC visit_old_version(Table *table, Record &record, bool readonly);
+
+  /**
+   * @brief 把记录上已经提交的事务的事务号改写成提交事务号
+   * @details 改写之后再访问这条记录就不需要查询事务状态表了。只读访问时也会改写，
+   * 改写的值不管什么时候写入都是一样的，所以不记录日志，也不把页面标记为脏页，
+   * 页面换出时丢掉了也没关系，rewrite_committed_xids 会再改写一次。
+   * 页面上的记录要等提交日志落盘以后才改写，否则页面可能先于提交日志写到磁盘，宕机以后提交事务号没有对应的提交日志。
+   * 复制出来的记录，比如更新前的数据，会写到当前事务的日志中，这些日志在提交日志之后，不需要等待
+   * @param in_page 记录是否直接指向页面
+   */
+  void set_hint_xids(Table *table, Record &record, bool in_page);
+
+  /**
+   * @brief 修改记录之前加行锁，访问记录时已经确认过没有其它事务持有这把锁
+   */
+  RC lock_record(Table *table, const RID &rid);
+
+  /**
+   * @brief 事务结束时释放所有的行锁，等待的事务这时才能看到事务的结果
+   */
+  void release_locks();
+
+  /**
+   * @brief 只读事务结束，没有需要提交或回滚的修改，只释放读视图
+   */
+  void end_read_only();
+
+  /**
+   * @brief 使用指定的提交事务号提交事务
+   * @param redo_lsn 重做提交日志时是日志的LSN，运行时是-1
+   */
+  RC   commit_with_trx_id(int64_t commit_id, LSN redo_lsn = -1);
+
+  /**
+   * @brief 回滚事务
+   * @param redo_lsn 重做回滚日志时是日志的LSN，运行时以及恢复结束时回滚未完成的事务是-1
+   */
+  RC   rollback_with_lsn(LSN redo_lsn);
+  void trx_fields(Table *table, XidField &begin_xid_field, XidField &end_xid_field) const;
+
+  /**
+   * @brief 重做时判断页面上是否已经有了LSN为 redo_lsn 的日志的修改
+   * @details 页面LSN不小于日志的LSN，说明修改在页面写入磁盘之前就已经做过了，不能再做一遍。
+   * redo_lsn 小于0时表示不是在重做日志
+   */
+  bool redo_applied(Table *table, PageNum page_num, LSN redo_lsn) const;
+
+  /**
+   * @brief 恢复时回滚更新，用重做时保存的日志中的旧数据得到更新之前的记录
+   * @param current_record 页面上当前的记录
+   */
+  std::vector<char> build_before_image(Table *table, const Operation &operation, const Record &current_record);
+
+  /**
+   * @brief 写一条修改记录的日志，在修改页面之后、释放页面锁之前调用，参考 RecordLogger
+   * @return 日志的LSN
+   */
+  LSN append_data_log(CLogType type, Table *table, const RID &rid, int32_t data_len = 0, int32_t data_offset = 0,
+      const char *data = nullptr);
 
 private:
-  using OperationSet = std::unordered_set<Operation, OperationHasher, OperationEqualer>;
+  using OperationSet  = std::unordered_set<Operation, OperationHasher, OperationEqualer>;
+  using RecordImages  = std::unordered_map<Operation, std::vector<char>, OperationHasher, OperationEqualer>;
+  using UpdateUndos   = std::unordered_map<Operation, std::vector<std::pair<int32_t, std::vector<char>>>,
+      OperationHasher, OperationEqualer>;
   MvccTrxKit  &trx_kit_;
   CLogManager *log_manager_ = nullptr;
-  int32_t      trx_id_      = -1;
+  int64_t      trx_id_      = -1;
   bool         started_     = false;
   bool         recovering_  = false;
+  bool         holds_locks_ = false;  ///< 是否加过行锁
+  ReadView     read_view_;  ///< 事务开始时创建的读视图，判断记录是否可见
   OperationSet operations_;
+  RecordImages before_images_;    ///< 被当前事务原地更新的记录在更新前的数据，运行时回滚使用
+  RecordImages inserted_images_;  ///< 重做时当前事务插入的记录数据，页面上已经没有这条记录时用来删除索引项
+  UpdateUndos  update_undos_;     ///< 重做时当前事务每次更新记录的偏移量和旧数据，按照日志的顺序排列
+  std::mutex   redo_lock_;        ///< 并行重做时保护上面几个集合
 };
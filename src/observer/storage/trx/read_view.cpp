@@ -0,0 +1,48 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include "storage/trx/read_view.h"
+#include <thread>
+#include "storage/trx/trx_status_table.h"
+#include "storage/trx/xid.h"
+
+using namespace std;
+
+ReadView::ReadView(int64_t creator_id, int64_t low_watermark, int64_t high_watermark)
+    : creator_id_(creator_id), low_watermark_(low_watermark), high_watermark_(high_watermark)
+{}
+
+bool ReadView::sees(int64_t xid, TrxStatusTable &status_table) const
+{
+  if (!Xid::is_uncommitted(xid)) {
+    return xid < high_watermark_;
+  }
+
+  const int64_t trx_id = Xid::trx_id(xid);
+  if (trx_id == creator_id_) {
+    return true;
+  }
+  if (trx_id >= high_watermark_) {
+    // 提交事务号比事务号大，一定不小于高水位
+    return false;
+  }
+
+  // 还没有改写记录上的事务号的事务。正在提交的事务马上就会拿到提交事务号，等它拿到以后再判断
+  int64_t                commit_xid = 0;
+  TrxStatusTable::Status status     = status_table.get(trx_id, &commit_xid);
+  while (status == TrxStatusTable::Status::COMMITTING) {
+    this_thread::yield();
+    status = status_table.get(trx_id, &commit_xid);
+  }
+  return status == TrxStatusTable::Status::COMMITTED && commit_xid < high_watermark_;
+}
@@ -0,0 +1,49 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#pragma once
+
+#include <stdint.h>
+
+class TrxStatusTable;
+
+/**
+ * @brief 事务的读视图
+ * @ingroup Transaction
+ * @details 事务开始时创建，记录下当时已经提交了哪些事务，之后事务中所有的读都以它为准。
+ * 提交事务号与事务号使用同一个计数器分配，提交事务号比高水位小的事务在创建读视图时就已经提交了，其它事务的修改都不可见。
+ * 事务分配提交事务号之前先在事务状态表中标记为正在提交(COMMITTING)，读到这个状态时等它拿到提交事务号再判断，
+ * 这样创建读视图时不需要和提交互斥，也不需要复制正在运行的事务列表。
+ * 低水位是创建时为这个视图登记的事务号，清理旧版本时不会越过它，参考 MvccTrxKit::oldest_active_trx_id
+ */
+class ReadView
+{
+public:
+  ReadView() = default;
+  ReadView(int64_t creator_id, int64_t low_watermark, int64_t high_watermark);
+
+  /**
+   * @brief 记录上的事务号表示的修改(插入或者删除)，对当前视图是否可见
+   * @param xid 提交事务号，或者带有未提交标记的事务号，参考 Xid
+   */
+  bool sees(int64_t xid, TrxStatusTable &status_table) const;
+
+  int64_t creator_id() const { return creator_id_; }
+  int64_t low_watermark() const { return low_watermark_; }
+  int64_t high_watermark() const { return high_watermark_; }
+
+private:
+  int64_t creator_id_     = 0;
+  int64_t low_watermark_  = 0;
+  int64_t high_watermark_ = 0;
+};
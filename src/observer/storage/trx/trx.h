@@ -14,6 +14,8 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <stddef.h>
 #include <unordered_set>
@@ -33,6 +35,7 @@ See the Mulan PSL v2 for more details. */
 class Db;
 class CLogManager;
 class CLogRecord;
+class LockManager;
 class Trx;
 
 /**
@@ -90,6 +93,29 @@ public:
   }
 };
 
+/**
+ * @brief 整理数据(VACUUM)时判断记录状态的视图
+ * @ingroup Transaction
+ * @details 由 TrxKit::create_vacuum_view 在整理开始时创建，之后的判断都以创建时还在运行的事务为准。
+ * 不支持多版本的事务管理器会直接物理删除记录，所以默认没有需要清理的记录
+ */
+class VacuumView
+{
+public:
+  VacuumView()          = default;
+  virtual ~VacuumView() = default;
+
+  /**
+   * @brief 记录是否已经对所有事务都不可见，可以物理删除
+   */
+  virtual bool is_dead(Table * /*table*/, const Record & /*record*/) const { return false; }
+
+  /**
+   * @brief 记录是否可以搬到其它位置。还没有提交的记录或者正在被删除的记录不能搬动
+   */
+  virtual bool is_movable(Table * /*table*/, const Record & /*record*/) const { return true; }
+};
+
 /**
  * @brief 事务管理器
  * @ingroup Transaction
@@ -115,12 +141,54 @@ public:
   virtual RC                            init()                               = 0;
   virtual const std::vector<FieldMeta> *trx_fields() const                   = 0;
   virtual Trx                          *create_trx(CLogManager *log_manager) = 0;
-  virtual Trx                          *create_trx(int32_t trx_id)           = 0;
-  virtual Trx                          *find_trx(int32_t trx_id)             = 0;
+  virtual Trx                          *create_trx(int64_t trx_id)           = 0;
+  virtual Trx                          *find_trx(int64_t trx_id)             = 0;
   virtual void                          all_trxes(std::vector<Trx *> &trxes) = 0;
 
   virtual void destroy_trx(Trx *trx) = 0;
 
+  /**
+   * @brief 创建一个判断记录是否可以清理的视图
+   */
+  virtual std::unique_ptr<VacuumView> create_vacuum_view() { return std::make_unique<VacuumView>(); }
+
+  /**
+   * @brief 让指定的事务独占运行，整理页面时搬动记录使用
+   * @details 只有当前没有其它正在运行的事务时才会成功，成功以后其它事务要等到 end_exclusive 之后才能开始。
+   * 指定的事务在此之后再开始
+   * @return 是否成功
+   */
+  virtual bool begin_exclusive(Trx * /*trx*/) { return true; }
+  virtual void end_exclusive(Trx * /*trx*/) {}
+
+  /**
+   * @brief 最近分配的事务号，checkpoint时记录下来
+   */
+  virtual int64_t current_trx_id() const { return 0; }
+
+  /**
+   * @brief 恢复时保证之后分配的事务号比 trx_id 大
+   * @details 包括从checkpoint中读取的事务号和重做时遇到的提交事务号
+   */
+  virtual void update_trx_id(int64_t /*trx_id*/) {}
+
+  /**
+   * @brief 删除表上记录的所有旧版本，删除表时调用
+   */
+  virtual void remove_table_versions(int32_t /*table_id*/) {}
+
+  /**
+   * @brief 把已经提交的事务留在记录上的事务号改写成提交事务号
+   * @details 提交时不再改写记录，记录上保留的是带有未提交标记的事务号，读取时通过事务状态表判断是否提交。
+   * checkpoint 和整理表之前调用，改写之后就不再需要这些事务的状态了
+   */
+  virtual void rewrite_committed_xids() {}
+
+  /**
+   * @brief 行锁管理器，不加锁的事务管理器返回空
+   */
+  virtual LockManager *lock_manager() { return nullptr; }
+
 public:
   static TrxKit *create(const char *name);
   static RC      init_global(const char *name);
@@ -138,15 +206,64 @@ public:
   virtual ~Trx() = default;
 
   virtual RC insert_record(Table *table, Record &record) = 0;
+  virtual RC insert_records(Table *table, std::vector<Record> &records) = 0;
   virtual RC delete_record(Table *table, Record &record) = 0;
   virtual RC update_record(Table *table, Record &target_record, Record &record) = 0;
   virtual RC visit_record(Table *table, Record &record, bool readonly) = 0;
 
+  /**
+   * @brief 等待其它事务释放记录上的锁
+   * @details visit_record 返回 RC::LOCKED_NEED_WAIT 时，调用者先释放记录所在的页面，再调用这个函数，
+   * 成功以后当前事务持有这条记录的锁，重新读取并访问这条记录
+   */
+  virtual RC wait_for_record(Table * /*table*/, const RID & /*rid*/) { return RC::SUCCESS; }
+
   virtual RC start_if_need() = 0;
   virtual RC commit()        = 0;
   virtual RC rollback()      = 0;
 
   virtual RC redo(Db *db, const CLogRecord &log_record);
 
-  virtual int32_t id() const = 0;
+  virtual int64_t id() const = 0;
+
+  /**
+   * @brief 表上是否可能有对当前事务可见的旧版本
+   * @details 页面上只有记录的最新版本。按照最新版本跳过页面或者记录的优化，比如页面摘要，在有旧版本时不能使用
+   */
+  virtual bool has_old_versions(Table * /*table*/) { return false; }
+
+  /**
+   * @brief 找出表上有旧版本满足 match 的记录
+   * @details 索引只指向记录的最新版本，用索引查找时，键只在旧版本中出现的记录需要从这里补充
+   */
+  virtual void old_version_rids(
+      Table * /*table*/, const std::function<bool(const char *, int)> & /*match*/, std::vector<RID> & /*rids*/)
+  {}
+
+  /**
+   * @brief 设置提交时是否等待日志落盘
+   * @details 异步提交时提交日志写入日志缓存就返回，宕机时可能丢失最近提交的事务，参考 CLogManager::commit_trx
+   */
+  void set_async_commit(bool async_commit) { async_commit_ = async_commit; }
+  bool async_commit() const { return async_commit_; }
+
+  /**
+   * @brief 设置事务是否只包含当前这一条语句(自动提交)
+   * @details 单语句事务等到行锁以后可以重新创建读视图，在最新的版本上修改，参考 MvccTrx::wait_for_record
+   */
+  void set_single_statement(bool single_statement) { single_statement_ = single_statement; }
+  bool single_statement() const { return single_statement_; }
+
+  /**
+   * @brief 设置事务是否只读，在事务开始之前设置
+   * @details BEGIN READ ONLY 开始的事务，以及自动提交的查询语句都是只读事务。只读事务只需要一个读视图，
+   * 不分配事务号也不记录日志，修改数据时返回 RC::TRX_READ_ONLY
+   */
+  void set_read_only(bool read_only) { read_only_ = read_only; }
+  bool read_only() const { return read_only_; }
+
+protected:
+  bool async_commit_     = false;  ///< 提交时是否不等待日志落盘
+  bool single_statement_ = false;  ///< 是否是自动提交的单语句事务
+  bool read_only_        = false;  ///< 是否是只读事务
 };
@@ -0,0 +1,52 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include "storage/trx/trx_status_table.h"
+
+using namespace std;
+
+void TrxStatusTable::set(int64_t trx_id, Status status, int64_t commit_xid, int64_t commit_lsn /*=-1*/)
+{
+  Shard            &s = shard(trx_id);
+  lock_guard<mutex> guard(s.lock);
+  Entry            &entry = s.entries[trx_id];
+  entry.status            = status;
+  entry.commit_xid        = commit_xid;
+  entry.commit_lsn        = commit_lsn;
+}
+
+void TrxStatusTable::remove(int64_t trx_id)
+{
+  Shard            &s = shard(trx_id);
+  lock_guard<mutex> guard(s.lock);
+  s.entries.erase(trx_id);
+}
+
+TrxStatusTable::Status TrxStatusTable::get(
+    int64_t trx_id, int64_t *commit_xid /*=nullptr*/, int64_t *commit_lsn /*=nullptr*/)
+{
+  Shard            &s = shard(trx_id);
+  lock_guard<mutex> guard(s.lock);
+  auto              iter = s.entries.find(trx_id);
+  if (iter == s.entries.end()) {
+    return Status::UNKNOWN;
+  }
+
+  if (commit_xid != nullptr) {
+    *commit_xid = iter->second.commit_xid;
+  }
+  if (commit_lsn != nullptr) {
+    *commit_lsn = iter->second.commit_lsn;
+  }
+  return iter->second.status;
+}
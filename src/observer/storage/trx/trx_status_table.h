@@ -0,0 +1,83 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#pragma once
+
+#include <stdint.h>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief 事务状态表
+ * @ingroup Transaction
+ * @details 记录每个还没有结束的事务是正在运行、已经提交还是已经回滚，以及提交事务号。
+ * 提交时只需要在这里修改一次状态，所有修改过的记录就同时变成已提交的了。
+ * 记录上还没有改写的事务号(带有未提交标记)通过这里判断是否提交。
+ * 已提交的事务同时记下提交日志的LSN，提交日志落盘之前不能把提交事务号写到页面上，参考 MvccTrx::set_hint_xids。
+ * 事务结束(改写完所有的记录)后删除对应的项
+ */
+class TrxStatusTable
+{
+public:
+  enum class Status
+  {
+    UNKNOWN,    ///< 没有这个事务，已经结束或者从来没有开始过
+    ACTIVE,     ///< 正在运行
+    COMMITTING, ///< 正在分配提交事务号，马上就会变成已提交
+    COMMITTED,  ///< 已经提交
+    ABORTED,    ///< 已经回滚
+  };
+
+public:
+  void begin(int64_t trx_id) { set(trx_id, Status::ACTIVE, 0); }
+  void prepare_commit(int64_t trx_id) { set(trx_id, Status::COMMITTING, 0); }
+  /**
+   * @param commit_lsn 提交日志的LSN，-1表示没有提交日志
+   */
+  void commit(int64_t trx_id, int64_t commit_xid, int64_t commit_lsn = -1)
+  {
+    set(trx_id, Status::COMMITTED, commit_xid, commit_lsn);
+  }
+  void abort(int64_t trx_id) { set(trx_id, Status::ABORTED, 0); }
+  void remove(int64_t trx_id);
+
+  /**
+   * @brief 查询事务的状态
+   * @param commit_xid 不为空并且事务已经提交时返回提交事务号
+   * @param commit_lsn 不为空并且事务已经提交时返回提交日志的LSN
+   */
+  Status get(int64_t trx_id, int64_t *commit_xid = nullptr, int64_t *commit_lsn = nullptr);
+
+private:
+  struct Entry
+  {
+    Status  status     = Status::UNKNOWN;
+    int64_t commit_xid = 0;
+    int64_t commit_lsn = -1;
+  };
+
+  struct Shard
+  {
+    std::mutex                          lock;
+    std::unordered_map<int64_t, Entry> entries;
+  };
+
+  static const int SHARD_NUM = 16;
+
+private:
+  Shard &shard(int64_t trx_id) { return shards_[static_cast<uint64_t>(trx_id) % SHARD_NUM]; }
+  void   set(int64_t trx_id, Status status, int64_t commit_xid, int64_t commit_lsn = -1);
+
+private:
+  Shard shards_[SHARD_NUM];
+};
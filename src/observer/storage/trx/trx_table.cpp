@@ -0,0 +1,73 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include "storage/trx/trx_table.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void TrxTable::insert(int64_t trx_id, Trx *trx)
+{
+  Shard            &s = shard(trx_id);
+  lock_guard<mutex> guard(s.lock);
+  if (s.trxes.emplace(trx_id, trx).second) {
+    s.trx_ids.insert(trx_id);
+    size_.fetch_add(1);
+  }
+  s.min_trx_id.store(*s.trx_ids.begin());
+}
+
+void TrxTable::remove(int64_t trx_id, Trx *trx /*= nullptr*/)
+{
+  Shard            &s = shard(trx_id);
+  lock_guard<mutex> guard(s.lock);
+  auto              iter = s.trxes.find(trx_id);
+  if (iter == s.trxes.end() || (trx != nullptr && iter->second != trx)) {
+    return;
+  }
+
+  s.trxes.erase(iter);
+  s.trx_ids.erase(trx_id);
+  size_.fetch_sub(1);
+  s.min_trx_id.store(s.trx_ids.empty() ? numeric_limits<int64_t>::max() : *s.trx_ids.begin());
+}
+
+Trx *TrxTable::find(int64_t trx_id)
+{
+  Shard            &s = shard(trx_id);
+  lock_guard<mutex> guard(s.lock);
+  auto              iter = s.trxes.find(trx_id);
+  return iter == s.trxes.end() ? nullptr : iter->second;
+}
+
+void TrxTable::all(vector<Trx *> &trxes)
+{
+  trxes.clear();
+  for (Shard &s : shards_) {
+    lock_guard<mutex> guard(s.lock);
+    for (const auto &trx_item : s.trxes) {
+      trxes.push_back(trx_item.second);
+    }
+  }
+}
+
+int64_t TrxTable::min_trx_id() const
+{
+  int64_t min_trx_id = numeric_limits<int64_t>::max();
+  for (const Shard &s : shards_) {
+    min_trx_id = std::min(min_trx_id, s.min_trx_id.load());
+  }
+  return min_trx_id;
+}
@@ -0,0 +1,73 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+class Trx;
+
+/**
+ * @brief 正在运行的事务表
+ * @ingroup Transaction
+ * @details 按照事务号分片，每个分片有自己的锁，开始和结束事务时只锁一个分片，按事务号查找事务是O(1)的。
+ * 每个分片记录自己最小的事务号，查询最老的事务号时不需要加锁，读一遍所有分片的最小值就可以了
+ */
+class TrxTable
+{
+public:
+  TrxTable()  = default;
+  ~TrxTable() = default;
+
+  void insert(int64_t trx_id, Trx *trx);
+
+  /**
+   * @brief 删除事务号对应的事务
+   * @param trx 不为空时，只有事务号对应的正好是这个事务才删除
+   */
+  void remove(int64_t trx_id, Trx *trx = nullptr);
+
+  Trx *find(int64_t trx_id);
+  void all(std::vector<Trx *> &trxes);
+  bool empty() const { return size_.load() == 0; }
+
+  /**
+   * @brief 表中最小的事务号，表为空时返回 INT64_MAX
+   * @details 不加锁，与 insert 和 remove 并发时可能返回已经删除了的事务号，不会漏掉在这之前已经插入的事务
+   */
+  int64_t min_trx_id() const;
+
+private:
+  static const int SHARD_NUM = 16;
+
+  struct Shard
+  {
+    std::mutex                         lock;
+    std::unordered_map<int64_t, Trx *> trxes;
+    std::set<int64_t>                  trx_ids;  ///< 有序的事务号，用来更新最小的事务号
+    std::atomic<int64_t>               min_trx_id{std::numeric_limits<int64_t>::max()};
+  };
+
+  Shard &shard(int64_t trx_id) { return shards_[static_cast<uint64_t>(trx_id) % SHARD_NUM]; }
+
+private:
+  Shard                shards_[SHARD_NUM];
+  std::atomic<int32_t> size_{0};
+};
@@ -0,0 +1,280 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <filesystem>
+
+#include "common/log/log.h"
+#include "storage/trx/undo_store.h"
+
+using namespace std;
+
+UndoStore::~UndoStore()
+{
+  if (spill_fd_ >= 0) {
+    close(spill_fd_);
+    spill_fd_ = -1;
+  }
+}
+
+RC UndoStore::push(int32_t table_id, const RID &rid, int64_t trx_id, int64_t begin_xid, const char *data, int len)
+{
+  UndoVersion version;
+  version.trx_id    = trx_id;
+  version.begin_xid = begin_xid;
+  version.end_xid   = Xid::uncommitted(trx_id);
+  version.len       = len;
+
+  // 先增加计数，保证写临时文件的过程中临时文件不会被清空
+  version_count_++;
+  if (memory_bytes_.load() + len > memory_limit_) {
+    RC rc = spill(data, len, version.spill_offset);
+    if (OB_FAIL(rc)) {
+      version_count_--;
+      return rc;
+    }
+    spilled_bytes_ += len;
+  } else {
+    version.data.reset(new char[len]);
+    memcpy(version.data.get(), data, len);
+    memory_bytes_ += len;
+  }
+
+  Key    key{table_id, rid};
+  Shard &s = shard(key);
+  lock_guard<mutex> guard(s.lock);
+  s.chains[key].push_back(std::move(version));
+  return RC::SUCCESS;
+}
+
+void UndoStore::commit(int32_t table_id, const RID &rid, int64_t trx_id, int64_t commit_xid)
+{
+  Key    key{table_id, rid};
+  Shard &s = shard(key);
+  {
+    lock_guard<mutex> guard(s.lock);
+    auto              iter = s.chains.find(key);
+    if (iter == s.chains.end() || iter->second.back().trx_id != trx_id ||
+        iter->second.back().end_xid != Xid::uncommitted(trx_id)) {
+      return;
+    }
+    iter->second.back().end_xid = commit_xid;
+  }
+
+  lock_guard<mutex> guard(purge_lock_);
+  purge_queue_.emplace_back(commit_xid, key);
+}
+
+void UndoStore::pop(int32_t table_id, const RID &rid, int64_t trx_id)
+{
+  Key               key{table_id, rid};
+  Shard            &s = shard(key);
+  lock_guard<mutex> guard(s.lock);
+  auto              iter = s.chains.find(key);
+  if (iter == s.chains.end() || iter->second.back().trx_id != trx_id ||
+      iter->second.back().end_xid != Xid::uncommitted(trx_id)) {
+    return;
+  }
+
+  release(iter->second.back());
+  iter->second.pop_back();
+  if (iter->second.empty()) {
+    s.chains.erase(iter);
+  }
+}
+
+RC UndoStore::find_version(int32_t table_id, const RID &rid, const function<bool(int64_t, int64_t)> &visible,
+    int64_t &begin_xid, int64_t &end_xid, vector<char> *data)
+{
+  Key               key{table_id, rid};
+  Shard            &s = shard(key);
+  lock_guard<mutex> guard(s.lock);
+  auto              iter = s.chains.find(key);
+  if (iter == s.chains.end()) {
+    return RC::RECORD_INVISIBLE;
+  }
+
+  const Chain &chain = iter->second;
+  for (auto version_iter = chain.rbegin(); version_iter != chain.rend(); ++version_iter) {
+    const UndoVersion &version = *version_iter;
+    if (!visible(version.begin_xid, version.end_xid)) {
+      continue;
+    }
+
+    begin_xid = version.begin_xid;
+    end_xid   = version.end_xid;
+    if (data != nullptr) {
+      data->resize(version.len);
+      return read_data(version, data->data());
+    }
+    return RC::SUCCESS;
+  }
+  return RC::RECORD_INVISIBLE;
+}
+
+bool UndoStore::contains(int32_t table_id, const RID &rid)
+{
+  if (version_count_.load() == 0) {
+    return false;
+  }
+
+  Key               key{table_id, rid};
+  Shard            &s = shard(key);
+  lock_guard<mutex> guard(s.lock);
+  return s.chains.count(key) > 0;
+}
+
+void UndoStore::collect_rids(int32_t table_id, const function<bool(const char *, int)> &match, vector<RID> &rids)
+{
+  if (version_count_.load() == 0) {
+    return;
+  }
+
+  vector<char> data;
+  for (Shard &s : shards_) {
+    lock_guard<mutex> guard(s.lock);
+    for (const auto &[key, chain] : s.chains) {
+      if (key.table_id != table_id) {
+        continue;
+      }
+
+      for (const UndoVersion &version : chain) {
+        data.resize(version.len);
+        if (OB_SUCC(read_data(version, data.data())) && match(data.data(), version.len)) {
+          rids.push_back(key.rid);
+          break;
+        }
+      }
+    }
+  }
+}
+
+void UndoStore::purge(int64_t oldest_active_trx_id)
+{
+  // 提交事务号基本上是按顺序进入队列的，遇到第一个还不能清理的就停下来，剩下的等下次再清理
+  vector<Key> keys;
+  {
+    lock_guard<mutex> guard(purge_lock_);
+    while (!purge_queue_.empty() && purge_queue_.front().first < oldest_active_trx_id) {
+      keys.push_back(purge_queue_.front().second);
+      purge_queue_.pop_front();
+    }
+  }
+
+  for (const Key &key : keys) {
+    Shard            &s = shard(key);
+    lock_guard<mutex> guard(s.lock);
+    auto              iter = s.chains.find(key);
+    if (iter == s.chains.end()) {
+      continue;
+    }
+
+    // 越旧的版本结束事务号越小，从最旧的版本开始清理
+    Chain &chain = iter->second;
+    size_t purge_num = 0;
+    while (purge_num < chain.size() && !Xid::is_uncommitted(chain[purge_num].end_xid) &&
+           chain[purge_num].end_xid < oldest_active_trx_id) {
+      release(chain[purge_num]);
+      purge_num++;
+    }
+    chain.erase(chain.begin(), chain.begin() + purge_num);
+    if (chain.empty()) {
+      s.chains.erase(iter);
+    }
+  }
+}
+
+void UndoStore::remove_table(int32_t table_id)
+{
+  for (Shard &s : shards_) {
+    lock_guard<mutex> guard(s.lock);
+    for (auto iter = s.chains.begin(); iter != s.chains.end();) {
+      if (iter->first.table_id != table_id) {
+        ++iter;
+        continue;
+      }
+
+      for (UndoVersion &version : iter->second) {
+        release(version);
+      }
+      iter = s.chains.erase(iter);
+    }
+  }
+}
+
+RC UndoStore::read_data(const UndoVersion &version, char *buf)
+{
+  if (version.spill_offset < 0) {
+    memcpy(buf, version.data.get(), version.len);
+    return RC::SUCCESS;
+  }
+
+  ssize_t ret = pread(spill_fd_, buf, version.len, version.spill_offset);
+  if (ret != version.len) {
+    LOG_ERROR("failed to read undo data from spill file. offset=%ld, len=%d, ret=%ld, error=%s",
+              version.spill_offset, version.len, ret, strerror(errno));
+    return RC::IOERR_READ;
+  }
+  return RC::SUCCESS;
+}
+
+RC UndoStore::spill(const char *data, int len, int64_t &offset)
+{
+  lock_guard<mutex> guard(spill_lock_);
+  if (spill_fd_ < 0) {
+    string path = (filesystem::temp_directory_path() / "miniob_undo_XXXXXX").string();
+    spill_fd_   = mkstemp(path.data());
+    if (spill_fd_ < 0) {
+      LOG_ERROR("failed to create undo spill file. path=%s, error=%s", path.c_str(), strerror(errno));
+      return RC::IOERR_OPEN;
+    }
+    unlink(path.c_str());
+    LOG_INFO("undo store spills versions to temporary file. memory limit=%ld", memory_limit_);
+  }
+
+  ssize_t ret = pwrite(spill_fd_, data, len, spill_size_);
+  if (ret != len) {
+    LOG_ERROR("failed to write undo data to spill file. offset=%ld, len=%d, ret=%ld, error=%s",
+              spill_size_, len, ret, strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+
+  offset = spill_size_;
+  spill_size_ += len;
+  return RC::SUCCESS;
+}
+
+void UndoStore::release(UndoVersion &version)
+{
+  if (version.spill_offset < 0) {
+    memory_bytes_ -= version.len;
+  } else {
+    spilled_bytes_ -= version.len;
+  }
+  version.data.reset();
+
+  if (--version_count_ == 0) {
+    // 没有旧版本以后临时文件中的数据都不再需要了
+    lock_guard<mutex> guard(spill_lock_);
+    if (version_count_.load() == 0 && spill_size_ > 0) {
+      if (ftruncate(spill_fd_, 0) != 0) {
+        LOG_WARN("failed to truncate undo spill file. error=%s", strerror(errno));
+      } else {
+        spill_size_ = 0;
+      }
+    }
+  }
+}
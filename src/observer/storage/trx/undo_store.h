@@ -0,0 +1,172 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/rc.h"
+#include "storage/record/record.h"
+#include "storage/trx/xid.h"
+
+/**
+ * @brief 记录的旧版本数据
+ * @ingroup Transaction
+ * @details 多版本更新时新数据直接写在原来的位置上，被覆盖的数据作为旧版本保存在UndoStore中。
+ * 版本的事务号单独保存，提交时只修改这里，不需要改动保存的数据。
+ * 旧版本只在运行时使用，重启以后没有正在运行的事务需要它们，所以不需要写到磁盘上
+ */
+struct UndoVersion
+{
+  int64_t trx_id    = 0;   ///< 覆盖这个版本的事务
+  int64_t begin_xid = 0;   ///< 这个版本的开始事务号
+  int64_t end_xid   = 0;   ///< 这个版本的结束事务号，也就是覆盖它的事务的提交事务号。带有未提交标记表示还没有提交
+  int32_t len       = 0;   ///< 数据的长度
+  int64_t spill_offset = -1;  ///< 数据写到临时文件中时在文件中的位置，-1表示数据在内存中
+  std::unique_ptr<char[]> data;
+};
+
+/**
+ * @brief 保存记录旧版本的undo存储
+ * @ingroup Transaction
+ * @details 每条记录的旧版本按照从旧到新的顺序组成一个版本链，使用表ID和RID找到版本链，页面上不需要保存指针。
+ * 版本链按照RID分散在多个分片中，每个分片一把锁。
+ * 旧版本占用的内存超过限制以后，新的旧版本数据会追加到一个临时文件中，读取时再从文件中读出来。
+ * 版本的结束事务号比所有正在运行的事务号都小时，没有事务能再看到它，可以清理掉。
+ * 提交过的版本按照提交顺序放到清理队列中，清理时不需要遍历所有的版本链
+ */
+class UndoStore
+{
+public:
+  UndoStore() = default;
+  ~UndoStore();
+
+  /**
+   * @brief 旧版本在内存中最多占用的字节数，超过以后写到临时文件中
+   */
+  void    set_memory_limit(int64_t bytes) { memory_limit_ = bytes; }
+  int64_t memory_limit() const { return memory_limit_; }
+
+  /**
+   * @brief 事务 trx_id 覆盖记录前，把被覆盖的数据作为最新的旧版本保存下来
+   * @param begin_xid 被覆盖数据的开始事务号
+   */
+  RC push(int32_t table_id, const RID &rid, int64_t trx_id, int64_t begin_xid, const char *data, int len);
+
+  /**
+   * @brief 事务提交后，设置它创建的旧版本的结束事务号
+   */
+  void commit(int32_t table_id, const RID &rid, int64_t trx_id, int64_t commit_xid);
+
+  /**
+   * @brief 事务回滚后，删除它创建的旧版本。调用之前页面上的数据应该已经恢复了
+   */
+  void pop(int32_t table_id, const RID &rid, int64_t trx_id);
+
+  /**
+   * @brief 从新到旧查找第一个可见的旧版本
+   * @param visible 根据版本的开始和结束事务号判断是否可见
+   * @param data 不为空时复制可见版本的数据
+   * @return SUCCESS 找到了可见的版本，RECORD_INVISIBLE 没有可见的版本
+   */
+  RC find_version(int32_t table_id, const RID &rid, const std::function<bool(int64_t, int64_t)> &visible,
+      int64_t &begin_xid, int64_t &end_xid, std::vector<char> *data);
+
+  /**
+   * @brief 记录是否有旧版本
+   */
+  bool contains(int32_t table_id, const RID &rid);
+
+  /**
+   * @brief 找出表上有旧版本满足 match 的所有记录
+   * @details 索引中只有记录最新版本的键，用旧版本的键查找时需要用它补充
+   */
+  void collect_rids(
+      int32_t table_id, const std::function<bool(const char *, int)> &match, std::vector<RID> &rids);
+
+  /**
+   * @brief 清理所有结束事务号比 oldest_active_trx_id 小的旧版本
+   */
+  void purge(int64_t oldest_active_trx_id);
+
+  /**
+   * @brief 删除表上的所有旧版本，删除表时使用
+   */
+  void remove_table(int32_t table_id);
+
+  int64_t version_count() const { return version_count_.load(); }
+  int64_t memory_bytes() const { return memory_bytes_.load(); }
+  int64_t spilled_bytes() const { return spilled_bytes_.load(); }
+
+private:
+  struct Key
+  {
+    int32_t table_id;
+    RID     rid;
+
+    bool operator==(const Key &other) const { return table_id == other.table_id && rid == other.rid; }
+  };
+
+  struct KeyHasher
+  {
+    size_t operator()(const Key &key) const
+    {
+      return (static_cast<size_t>(key.table_id) << 48) ^ (static_cast<size_t>(key.rid.page_num) << 16) ^
+             static_cast<size_t>(key.rid.slot_num);
+    }
+  };
+
+  using Chain = std::vector<UndoVersion>;  ///< 从旧到新的版本链
+
+  struct Shard
+  {
+    std::mutex                               lock;
+    std::unordered_map<Key, Chain, KeyHasher> chains;
+  };
+
+  static const int SHARD_NUM = 16;
+
+private:
+  Shard &shard(const Key &key) { return shards_[KeyHasher()(key) % SHARD_NUM]; }
+
+  /**
+   * @brief 读取版本的数据，数据在临时文件中时从文件中读取
+   * @note 需要持有版本所在分片的锁，保证读取期间临时文件不会被清空
+   */
+  RC read_data(const UndoVersion &version, char *buf);
+
+  RC   spill(const char *data, int len, int64_t &offset);
+  void release(UndoVersion &version);
+
+private:
+  Shard shards_[SHARD_NUM];
+
+  int64_t              memory_limit_ = 64 * 1024 * 1024;
+  std::atomic<int64_t> version_count_{0};
+  std::atomic<int64_t> memory_bytes_{0};
+  std::atomic<int64_t> spilled_bytes_{0};
+
+  std::mutex spill_lock_;          ///< 保护临时文件
+  int        spill_fd_   = -1;     ///< 临时文件，创建后就删除了文件名，进程退出时自动回收
+  int64_t    spill_size_ = 0;      ///< 临时文件当前的大小，新的数据追加在最后
+
+  std::mutex                                 purge_lock_;
+  std::deque<std::pair<int64_t, Key>> purge_queue_;  ///< 按照提交顺序排列的(提交事务号，记录)
+};
@@ -22,11 +22,11 @@ const vector<FieldMeta> *VacuousTrxKit::trx_fields() const { return nullptr; }
 
 Trx *VacuousTrxKit::create_trx(CLogManager *) { return new VacuousTrx; }
 
-Trx *VacuousTrxKit::create_trx(int32_t /*trx_id*/) { return nullptr; }
+Trx *VacuousTrxKit::create_trx(int64_t /*trx_id*/) { return nullptr; }
 
 void VacuousTrxKit::destroy_trx(Trx *) {}
 
-Trx *VacuousTrxKit::find_trx(int32_t /* trx_id */) { return nullptr; }
+Trx *VacuousTrxKit::find_trx(int64_t /* trx_id */) { return nullptr; }
 
 void VacuousTrxKit::all_trxes(std::vector<Trx *> &trxes) { return; }
 
@@ -34,11 +34,21 @@ void VacuousTrxKit::all_trxes(std::vector<Trx *> &trxes) { return; }
 
 RC VacuousTrx::insert_record(Table *table, Record &record) { return table->insert_record(record); }
 
+RC VacuousTrx::insert_records(Table *table, vector<Record> &records) { return table->insert_records(records); }
+
 RC VacuousTrx::delete_record(Table *table, Record &record) { return table->delete_record(record); }
 
 RC VacuousTrx::update_record(Table *table, Record &target_record, Record &record)
 {
-  return table->update_record(target_record, record);
+  RC rc = table->update_record(target_record, record);
+  if (rc == RC::RECORD_NOMEM) {
+    // 新的值无法按照页面的编码方式原地存放，搬到其它页面
+    rc = table->delete_record(target_record);
+    if (OB_SUCC(rc)) {
+      rc = table->insert_record(record);
+    }
+  }
+  return rc;
 }
 
 RC VacuousTrx::visit_record(Table *table, Record &record, bool readonly)
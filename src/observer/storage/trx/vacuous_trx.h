@@ -28,8 +28,8 @@ public:
   RC                            init() override;
   const std::vector<FieldMeta> *trx_fields() const override;
   Trx                          *create_trx(CLogManager *log_manager) override;
-  Trx                          *create_trx(int32_t trx_id) override;
-  Trx                          *find_trx(int32_t trx_id) override;
+  Trx                          *create_trx(int64_t trx_id) override;
+  Trx                          *find_trx(int64_t trx_id) override;
   void                          all_trxes(std::vector<Trx *> &trxes) override;
 
   void destroy_trx(Trx *trx) override;
@@ -42,6 +42,7 @@ public:
   virtual ~VacuousTrx() = default;
 
   RC insert_record(Table *table, Record &record) override;
+  RC insert_records(Table *table, std::vector<Record> &records) override;
   RC delete_record(Table *table, Record &record) override;
   RC update_record(Table *table, Record &target_record, Record &record) override;
   RC visit_record(Table *table, Record &record, bool readonly) override;
@@ -49,5 +50,5 @@ public:
   RC commit() override;
   RC rollback() override;
 
-  int32_t id() const override { return 0; }
+  int64_t id() const override { return 0; }
 };
@@ -0,0 +1,34 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include "storage/trx/xid.h"
+
+#include <string.h>
+
+#include "storage/field/field_meta.h"
+#include "storage/record/record.h"
+
+using namespace std;
+
+int64_t XidField::get(const Record &record) const
+{
+  int64_t xid = 0;
+  memcpy(&xid, record.data() + field_meta_->offset(), sizeof(xid));
+  return xid;
+}
+
+void XidField::set(Record &record, int64_t xid) const
+{
+  memcpy(record.data() + field_meta_->offset(), &xid, sizeof(xid));
+}
@@ -0,0 +1,70 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#pragma once
+
+#include <stdint.h>
+
+class FieldMeta;
+class Record;
+
+/**
+ * @brief 事务号以及记录上保存的事务号的编码
+ * @ingroup Transaction
+ * @details 事务号和提交事务号都是64位的，从同一个计数器分配，实际使用中不会用完，也就不需要处理回绕。
+ * 记录上的开始和结束事务号有三种取值：
+ * - 提交事务号，修改已经提交并且改写过了；
+ * - 带有未提交标记的事务号，修改它的事务还没有提交，或者已经提交但是还没有改写记录；
+ * - MAX，记录还没有被删除(只会出现在结束事务号上)。
+ * 未提交标记单独占一位，事务号本身总是正数，不再用负数表示没有提交
+ */
+class Xid
+{
+public:
+  static constexpr int64_t UNCOMMITTED_FLAG = 1LL << 62;          ///< 未提交标记
+  static constexpr int64_t MAX              = UNCOMMITTED_FLAG - 1;  ///< 记录没有被删除时的结束事务号，也是事务号的上限
+
+  static constexpr int LEN = 8;  ///< 记录上事务号字段的长度
+
+  /**
+   * @brief 事务 trx_id 修改记录时写在记录上的事务号
+   */
+  static int64_t uncommitted(int64_t trx_id) { return trx_id | UNCOMMITTED_FLAG; }
+  static bool    is_uncommitted(int64_t xid) { return (xid & UNCOMMITTED_FLAG) != 0; }
+
+  /**
+   * @brief 带有未提交标记的事务号对应的事务
+   */
+  static int64_t trx_id(int64_t xid) { return xid & ~UNCOMMITTED_FLAG; }
+};
+
+/**
+ * @brief 读写记录上的事务号字段
+ * @details 事务号字段是8个字节。之前创建的4字节字段的表不能直接打开，需要先离线升级，参考 DbXidUpgrade
+ */
+class XidField
+{
+public:
+  XidField() = default;
+  explicit XidField(const FieldMeta *field_meta) : field_meta_(field_meta) {}
+
+  void             set_field(const FieldMeta *field_meta) { field_meta_ = field_meta; }
+  const FieldMeta *meta() const { return field_meta_; }
+
+  int64_t get(const Record &record) const;
+  void    set(Record &record, int64_t xid) const;
+
+private:
+  const FieldMeta *field_meta_ = nullptr;
+};
@@ -18,16 +18,22 @@ See the Mulan PSL v2 for more details. */
 
 using namespace std;
 
-void dump(const char *filename)
+void dump(const char *path)
 {
   CLogFile file;
 
-  RC rc = file.init(filename);
+  RC rc = file.init(path);
   if (OB_FAIL(rc)) {
-    printf("failed to open file: '%s'. syserr=%s, rc=%s\n", filename, strerror(errno), strrc(rc));
+    printf("failed to open clog path: '%s'. syserr=%s, rc=%s\n", path, strerror(errno), strrc(rc));
     return;
   }
 
+  vector<int64_t> segments;
+  file.segments(segments);
+  for (int64_t start_lsn : segments) {
+    printf("segment start_lsn:%" PRId64 "\n", start_lsn);
+  }
+
   CLogRecordIterator iterator;
   rc = iterator.init(file);
   if (OB_FAIL(rc)) {
@@ -35,24 +41,24 @@ void dump(const char *filename)
     return;
   }
 
-  int64_t offset = 0;
-  int     index  = 0;
+  int index = 0;
   for (index++, rc = iterator.next(); OB_SUCC(rc) && iterator.valid(); rc = iterator.next(), ++index) {
     const CLogRecord &log_record = iterator.log_record();
 
-    printf("index:%d, file_offset:%" PRId64 ", %s\n", index, offset, log_record.to_string().c_str());
-    (void)file.offset(offset);
+    printf("index:%d, offset:%" PRId64 ", %s\n", index, log_record.header().lsn_, log_record.to_string().c_str());
   }
 
   if (rc != RC::RECORD_EOF) {
     printf("something error. error=%s\n", strrc(rc));
+  } else if (iterator.torn_tail()) {
+    printf("torn log at the tail. valid end lsn:%" PRId64 ", file end lsn:%" PRId64 "\n", iterator.lsn(), file.end_lsn());
   }
 }
 
 int main(int argc, char *argv[])
 {
   if (argc < 2) {
-    printf("please give me a clog file name\n");
+    printf("please give me a clog path\n");
     return 1;
   }
 
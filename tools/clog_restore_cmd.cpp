@@ -0,0 +1,123 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <inttypes.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "common/global_context.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/clog/clog.h"
+#include "storage/db/db.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+using namespace common;
+
+/*
+ * 时间点恢复(point-in-time recovery)。
+ * 数据库目录是一份基础备份(比如停机时复制的目录，或者执行sync之后复制的目录)，
+ * 工具先把归档的日志补到基础备份中，截断目标位置之后的日志，再打开数据库，
+ * 由正常的恢复流程重做日志并回滚目标位置还没有提交的事务。
+ */
+
+void usage()
+{
+  printf("Usage: clog_restore -d <db path> -a <archive path> [-l lsn] [-x commit xid] [-r redo threads]\n");
+  printf("  -d: database directory copied from a base backup, restored in place\n");
+  printf("  -a: clog archive directory of the database, for example <archive dir>/sys\n");
+  printf("  -l: restore the log before this lsn\n");
+  printf("  -x: restore the transactions committed with xid not greater than this\n");
+  printf("  -r: number of threads to redo logs. 0(default) means redo in one thread\n");
+  printf("restore to the end of the archived log if neither -l nor -x is specified\n");
+}
+
+int main(int argc, char *argv[])
+{
+  string  db_path;
+  string  archive_path;
+  int64_t target_lsn  = -1;
+  int64_t target_xid  = -1;
+  int     redo_worker = 0;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "d:a:l:x:r:h")) > 0) {
+    switch (opt) {
+      case 'd': db_path = optarg; break;
+      case 'a': archive_path = optarg; break;
+      case 'l': target_lsn = strtoll(optarg, nullptr, 10); break;
+      case 'x': target_xid = strtoll(optarg, nullptr, 10); break;
+      case 'r': redo_worker = atoi(optarg); break;
+      case 'h':
+      default: usage(); return 1;
+    }
+  }
+
+  if (db_path.empty() || archive_path.empty()) {
+    usage();
+    return 1;
+  }
+
+  while (db_path.size() > 1 && db_path.back() == '/') {
+    db_path.pop_back();
+  }
+  const size_t pos     = db_path.find_last_of('/');
+  const string db_name = pos == string::npos ? db_path : db_path.substr(pos + 1);
+
+  LoggerFactory::init_default("clog_restore.log", LOG_LEVEL_INFO);
+
+  auto begin_time = chrono::steady_clock::now();
+
+  CLogRestorer restorer(archive_path.c_str(), db_path.c_str());
+  if (target_lsn >= 0) {
+    restorer.set_target_lsn(target_lsn);
+  }
+  if (target_xid >= 0) {
+    restorer.set_target_xid(target_xid);
+  }
+
+  RC rc = restorer.restore();
+  if (OB_FAIL(rc)) {
+    printf("failed to restore clog from archive. rc=%s, see clog_restore.log for details\n", strrc(rc));
+    return 1;
+  }
+  printf("restore clog to lsn %" PRId64 ", last commit xid %" PRId64 "\n", restorer.stop_lsn(), restorer.last_commit_xid());
+
+  // 正常打开数据库，恢复流程会重做日志并回滚没有提交的事务
+  BufferPoolManager bpm;
+  BufferPoolManager::set_instance(&bpm);
+  TrxKit::init_global("mvcc");
+  GCTX.trx_kit_         = TrxKit::instance();
+  GCTX.redo_worker_num_ = redo_worker;
+
+  unique_ptr<Db> db = make_unique<Db>();
+  rc                = db->init(db_name.c_str(), db_path.c_str());
+  if (OB_SUCC(rc)) {
+    rc = db->sync();
+  }
+  db.reset();
+  BufferPoolManager::set_instance(nullptr);
+  if (OB_FAIL(rc)) {
+    printf("failed to recover database. path=%s, rc=%s\n", db_path.c_str(), strrc(rc));
+    return 1;
+  }
+
+  auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - begin_time);
+  printf("restore database done. path=%s, elapsed %ldms\n", db_path.c_str(), static_cast<long>(elapsed.count()));
+  return 0;
+}
@@ -0,0 +1,81 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <inttypes.h>
+#include <getopt.h>
+#include <chrono>
+#include <string>
+
+#include "common/global_context.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/db/db_xid_upgrade.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+using namespace common;
+
+/*
+ * 把事务号改成64位之前的数据库离线升级到当前的格式。
+ * 数据库必须是用旧版本正常关闭的，升级期间不能启动 observer。过程参考 DbXidUpgrade
+ */
+
+void usage()
+{
+  printf("Usage: xid_upgrade -d <db path>\n");
+  printf("  -d: database directory shut down cleanly by the version with 32 bits transaction ids, upgraded in place\n");
+  printf("the upgrade can be run again if it fails. take a new backup after upgrading\n");
+}
+
+int main(int argc, char *argv[])
+{
+  string db_path;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "d:h")) > 0) {
+    switch (opt) {
+      case 'd': db_path = optarg; break;
+      case 'h':
+      default: usage(); return 1;
+    }
+  }
+
+  if (db_path.empty()) {
+    usage();
+    return 1;
+  }
+
+  LoggerFactory::init_default("xid_upgrade.log", LOG_LEVEL_INFO);
+
+  auto begin_time = chrono::steady_clock::now();
+
+  // 新表的事务号字段由事务模块决定
+  BufferPoolManager bpm;
+  BufferPoolManager::set_instance(&bpm);
+  TrxKit::init_global("mvcc");
+  GCTX.trx_kit_ = TrxKit::instance();
+
+  DbXidUpgrade upgrade(db_path.c_str());
+  RC           rc = upgrade.upgrade();
+  BufferPoolManager::set_instance(nullptr);
+  if (OB_FAIL(rc)) {
+    printf("failed to upgrade database. path=%s, rc=%s, see xid_upgrade.log for details\n", db_path.c_str(), strrc(rc));
+    return 1;
+  }
+
+  auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - begin_time);
+  printf("upgrade database done. path=%s, upgraded tables %d, max trx id %" PRId64 ", elapsed %ldms\n",
+      db_path.c_str(), upgrade.upgraded_tables(), upgrade.max_trx_id(), static_cast<long>(elapsed.count()));
+  return 0;
+}
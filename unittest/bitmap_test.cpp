@@ -65,6 +65,10 @@ TEST(test_bitmap, test_bitmap)
   buf3[1] = 0;
   ASSERT_EQ(8, bitmap3.next_unsetted_bit(0));
   ASSERT_EQ(16, bitmap3.next_setted_bit(8));
+
+  // 跳过整个字节后，下一个字节要从第一个位开始查找
+  ASSERT_EQ(8, bitmap3.next_unsetted_bit(7));
+  ASSERT_EQ(16, bitmap3.next_setted_bit(9));
 }
 
 int main(int argc, char **argv)
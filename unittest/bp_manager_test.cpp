@@ -12,7 +12,12 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai.wyl on 2021
 //
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "storage/buffer/disk_buffer_pool.h"
+#include "storage/common/file_copy.h"
 #include "gtest/gtest.h"
 
 void test_get(BPFrameManager &frame_manager)
@@ -125,6 +130,120 @@ TEST(test_frame_manager, test_frame_manager_simple_lru)
   frame_manager.cleanup();
 }
 
+TEST(test_disk_buffer_pool, test_page_lsn)
+{
+  const char *file_name = "test_page_lsn.bp";
+  ::remove(file_name);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(file_name));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(file_name, bp));
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+  const PageNum page_num = frame->page_num();
+
+  // 修改页面的人拿着页面写锁设置LSN
+  frame->write_latch();
+  frame->set_lsn(100);
+  frame->mark_dirty();
+  frame->write_unlatch();
+  ASSERT_EQ(RC::SUCCESS, bp->unpin_page(frame));
+
+  LSN lsn = -1;
+  ASSERT_EQ(RC::SUCCESS, bp->get_page_lsn(page_num, lsn));
+  ASSERT_EQ(100, lsn);
+
+  // 页面写入磁盘之前要先刷到页面LSN的日志
+  LSN flushed_lsn = -1;
+  DiskBufferPool::set_log_flusher([&flushed_lsn](LSN lsn) {
+    flushed_lsn = std::max(flushed_lsn, lsn);
+    return RC::SUCCESS;
+  });
+  ASSERT_EQ(RC::SUCCESS, bp->flush_all_pages());
+  ASSERT_EQ(100, flushed_lsn);
+  DiskBufferPool::set_log_flusher(nullptr);
+
+  // 页面LSN随页面一起持久化
+  ASSERT_EQ(RC::SUCCESS, bpm->close_file(file_name));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(file_name, bp));
+  lsn = -1;
+  ASSERT_EQ(RC::SUCCESS, bp->get_page_lsn(page_num, lsn));
+  ASSERT_EQ(100, lsn);
+  ASSERT_EQ(RC::SUCCESS, bpm->close_file(file_name));
+  delete bpm;
+}
+
+TEST(test_disk_buffer_pool, test_backup)
+{
+  const char *file_name   = "test_backup.bp";
+  const char *backup_name = "test_backup.bp.bak";
+  ::remove(file_name);
+  ::remove(backup_name);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(file_name));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(file_name, bp));
+
+  // 比一次复制的数据量多，备份要分多次拿锁
+  const int            page_count = 300;
+  std::vector<PageNum> page_nums;
+  for (int i = 0; i < page_count; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+    memset(frame->data(), 1, BP_PAGE_DATA_SIZE);
+    frame->mark_dirty();
+    page_nums.push_back(frame->page_num());
+    ASSERT_EQ(RC::SUCCESS, bp->unpin_page(frame));
+  }
+  ASSERT_EQ(RC::SUCCESS, bp->flush_all_pages());
+
+  // 备份的同时不停地修改并刷出页面，复制到的页面可能是任意一个版本，但不能是写了一半的
+  std::atomic_bool stopped{false};
+  std::thread      writer([&]() {
+    for (int round = 2; !stopped.load(); round = round % 100 + 2) {
+      for (PageNum page_num : page_nums) {
+        Frame *frame = nullptr;
+        ASSERT_EQ(RC::SUCCESS, bp->get_this_page(page_num, &frame));
+        frame->write_latch();
+        memset(frame->data(), round, BP_PAGE_DATA_SIZE);
+        frame->mark_dirty();
+        frame->write_unlatch();
+        ASSERT_EQ(RC::SUCCESS, bp->flush_page(*frame));
+        bp->unpin_page(frame);
+      }
+    }
+  });
+
+  IoThrottle throttle(16 * 1024 * 1024);
+  int64_t    copied_bytes = 0;
+  ASSERT_EQ(RC::SUCCESS, bp->backup(backup_name, &throttle, copied_bytes));
+  stopped.store(true);
+  writer.join();
+  ASSERT_EQ(static_cast<int64_t>(page_count + 1) * BP_PAGE_SIZE, copied_bytes);
+
+  DiskBufferPool *backup_bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(backup_name, backup_bp));
+  for (PageNum page_num : page_nums) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, backup_bp->get_this_page(page_num, &frame));
+    const char *data = frame->data();
+    ASSERT_NE(0, data[0]);
+    for (int i = 1; i < BP_PAGE_DATA_SIZE; i++) {
+      ASSERT_EQ(data[0], data[i]) << "torn page " << page_num;
+    }
+    backup_bp->unpin_page(frame);
+  }
+
+  ASSERT_EQ(RC::SUCCESS, bpm->close_file(backup_name));
+  ASSERT_EQ(RC::SUCCESS, bpm->close_file(file_name));
+  delete bpm;
+  ::remove(file_name);
+  ::remove(backup_name);
+}
+
 int main(int argc, char **argv)
 {
 
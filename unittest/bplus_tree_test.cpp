@@ -14,6 +14,8 @@ See the Mulan PSL v2 for more details. */
 
 #include <iostream>
 #include <list>
+#include <set>
+#include <vector>
 
 #include "common/log/log.h"
 #include "sql/parser/parse_defs.h"
@@ -709,6 +711,68 @@ TEST(test_bplus_tree, test_scanner)
   scanner.close();
 }
 
+TEST(test_bplus_tree, test_scanner_release_latches)
+{
+  const char *index_name = "scanner_release.btree";
+  ::remove(index_name);
+  handler = new BplusTreeHandler();
+  handler->create(index_name, INTS, sizeof(int), ORDER, ORDER);
+
+  RC  rc = RC::SUCCESS;
+  RID rid;
+  // 插入数据[1 - 199] 所有奇数
+  for (int i = 0; i < 100; i++) {
+    int key      = i * 2 + 1;
+    rid.page_num = 0;
+    rid.slot_num = key;
+    rc           = handler->insert_entry((const char *)&key, &rid);
+    ASSERT_EQ(RC::SUCCESS, rc);
+  }
+
+  std::set<int> expected_keys;
+  for (int i = 0; i < 100; i++) {
+    expected_keys.insert(i * 2 + 1);
+  }
+
+  // 每返回一条数据就释放页面锁，在释放期间修改B树：
+  // 删除刚返回的数据并在它后面插入一条新数据，或者删除一条还没有返回的数据
+  std::vector<int> scanned_keys;
+  {
+    BplusTreeScanner scanner(*handler);
+    rc = scanner.open(nullptr, 0, true, nullptr, 0, true);
+    ASSERT_EQ(RC::SUCCESS, rc);
+
+    while ((rc = scanner.next_entry(rid)) == RC::SUCCESS) {
+      int key = rid.slot_num;
+      scanned_keys.push_back(key);
+      scanner.release_latches();
+
+      if (key % 10 == 1) {
+        ASSERT_EQ(RC::SUCCESS, handler->delete_entry((const char *)&key, &rid));
+
+        RID new_rid(0, key + 1);
+        int new_key = key + 1;
+        ASSERT_EQ(RC::SUCCESS, handler->insert_entry((const char *)&new_key, &new_rid));
+        expected_keys.insert(new_key);
+      } else if (key % 10 == 5) {
+        RID removed_rid(0, key + 2);
+        int removed_key = key + 2;
+        ASSERT_EQ(RC::SUCCESS, handler->delete_entry((const char *)&removed_key, &removed_rid));
+        expected_keys.erase(removed_key);
+      }
+      ASSERT_EQ(true, handler->validate_tree());
+    }
+    ASSERT_EQ(RC::RECORD_EOF, rc);
+    scanner.close();
+  }
+
+  ASSERT_EQ(std::vector<int>(expected_keys.begin(), expected_keys.end()), scanned_keys);
+
+  handler->close();
+  delete handler;
+  handler = nullptr;
+}
+
 TEST(test_bplus_tree, test_bplus_tree_insert)
 {
   LoggerFactory::init_default("test.log");
@@ -12,19 +12,32 @@ See the Mulan PSL v2 for more details. */
 // Created by huhaosheng.hhs on 2022
 //
 
+#include <filesystem>
 #include <string.h>
+#include <thread>
+#include <vector>
 
 #include "common/log/log.h"
 #include "storage/clog/clog.h"
+#include "storage/clog/clog_archiver.h"
 #include "gtest/gtest.h"
 
+using namespace std;
 using namespace common;
 
+/**
+ * @brief 每个测试使用一个空的日志目录
+ */
+static void reset_clog_path(const char *path)
+{
+  filesystem::remove_all(path);
+  filesystem::create_directories(path);
+}
+
 TEST(test_clog, test_clog)
 {
-  const char *path      = ".";
-  const char *clog_file = "./clog";
-  remove(clog_file);
+  const char *path = "clog_test_basic";
+  reset_clog_path(path);
 
   CLogManager log_mgr;
   RC          rc = log_mgr.init(path);
@@ -44,6 +57,601 @@ TEST(test_clog, test_clog)
   */
 }
 
+TEST(test_clog, test_concurrent_append)
+{
+  const char *path = "clog_test_concurrent";
+  reset_clog_path(path);
+
+  // 段文件比日志缓存小，写入时会跨越多个段文件
+  const int64_t segment_size = 1024 * 1024;
+
+  const int thread_num     = 8;
+  const int record_num     = 20000;  // 每个线程写入的日志个数，总量超过日志缓存的大小
+  const int data_len       = 64;
+  {
+    CLogManager log_mgr;
+    ASSERT_EQ(RC::SUCCESS, log_mgr.init(path, segment_size));
+
+    vector<thread> threads;
+    for (int t = 0; t < thread_num; t++) {
+      threads.emplace_back([&log_mgr, t]() {
+        char data[data_len];
+        for (int i = 0; i < record_num; i++) {
+          memset(data, t, sizeof(data));
+          RID rid(t, i);
+          ASSERT_EQ(RC::SUCCESS, log_mgr.append_log(CLogType::INSERT, t, 1, rid, data_len, 0, data));
+          if (i % 100 == 0) {
+            ASSERT_EQ(RC::SUCCESS, log_mgr.commit_trx(t, i));
+          }
+        }
+      });
+    }
+    for (thread &th : threads) {
+      th.join();
+    }
+    ASSERT_EQ(RC::SUCCESS, log_mgr.sync());
+  }
+
+  CLogFile log_file;
+  ASSERT_EQ(RC::SUCCESS, log_file.init(path));
+  CLogRecordIterator iterator;
+  ASSERT_EQ(RC::SUCCESS, iterator.init(log_file));
+
+  vector<int64_t> segments;
+  log_file.segments(segments);
+  ASSERT_GT(segments.size(), 4UL);
+  for (size_t i = 0; i < segments.size(); i++) {
+    ASSERT_EQ(static_cast<int64_t>(i) * segment_size, segments[i]);
+  }
+
+  // 日志的LSN是连续的，跨越段文件的日志也能完整地读出来
+  int64_t offset     = 0;
+  int     insert_num = 0;
+  RC      rc         = RC::SUCCESS;
+  for (rc = iterator.next(); OB_SUCC(rc) && iterator.valid(); rc = iterator.next()) {
+    const CLogRecord &log_record = iterator.log_record();
+    ASSERT_EQ(offset, log_record.header().lsn_);
+    offset += log_record.serialized_size();
+
+    if (log_record.log_type() == CLogType::INSERT) {
+      const CLogRecordData &data_record = log_record.data_record();
+      ASSERT_EQ(data_len, data_record.data_len_);
+      ASSERT_EQ(log_record.trx_id(), data_record.rid_.page_num);
+      for (int i = 0; i < data_len; i++) {
+        ASSERT_EQ(log_record.trx_id(), data_record.data_[i]);
+      }
+      insert_num++;
+    }
+  }
+  ASSERT_EQ(RC::RECORD_EOF, rc);
+  ASSERT_EQ(thread_num * record_num, insert_num);
+
+  ASSERT_EQ(log_file.end_lsn(), offset);
+}
+
+TEST(test_clog, test_remove_segments)
+{
+  const char *path = "clog_test_remove";
+  reset_clog_path(path);
+
+  const int64_t segment_size = 64 * 1024;
+  const int     data_len     = 100;
+  char          data[data_len];
+  memset(data, 'a', sizeof(data));
+
+  int64_t end_lsn = 0;
+  {
+    CLogManager log_mgr;
+    ASSERT_EQ(RC::SUCCESS, log_mgr.init(path, segment_size));
+    for (int i = 0; i < 5000; i++) {
+      ASSERT_EQ(RC::SUCCESS, log_mgr.append_log(CLogType::INSERT, 1, 1, RID(1, i), data_len, 0, data));
+    }
+    ASSERT_EQ(RC::SUCCESS, log_mgr.commit_trx(1, 2));
+  }
+
+  {
+    // 重新打开时，段文件的大小以文件头中的为准，并且接着原来的结尾继续写
+    CLogFile log_file;
+    ASSERT_EQ(RC::SUCCESS, log_file.init(path));
+    end_lsn = log_file.end_lsn();
+    ASSERT_GT(end_lsn, 5 * segment_size);
+
+    const int64_t remove_lsn = 3 * segment_size + 10;
+    ASSERT_EQ(RC::SUCCESS, log_file.remove_segments_before(remove_lsn));
+
+    vector<int64_t> segments;
+    log_file.segments(segments);
+    ASSERT_EQ(3 * segment_size, segments.front());
+    ASSERT_EQ(3 * segment_size, log_file.start_lsn());
+    ASSERT_FALSE(filesystem::exists(string(path) + "/clog_00000000000000000000"));
+
+    // 删除的位置之前的日志不能再读取
+    CLogRecordIterator iterator;
+    ASSERT_NE(RC::SUCCESS, iterator.init(log_file, 0));
+
+    // 即使所有的数据都在指定的位置之前，也会保留最后一个段文件
+    ASSERT_EQ(RC::SUCCESS, log_file.remove_segments_before(end_lsn + segment_size));
+    log_file.segments(segments);
+    ASSERT_EQ(1UL, segments.size());
+  }
+
+  CLogFile log_file;
+  ASSERT_EQ(RC::SUCCESS, log_file.init(path));
+  ASSERT_EQ(end_lsn, log_file.end_lsn());
+}
+
+TEST(test_clog, test_checkpoint_record)
+{
+  const char *path = "clog_test_checkpoint";
+  reset_clog_path(path);
+
+  CLogCheckpoint checkpoint;
+  checkpoint.begin_lsn_  = 1000;
+  checkpoint.redo_lsn_   = 200;
+  checkpoint.max_trx_id_ = 30;
+  checkpoint.active_trxes_.emplace_back(10, 200);
+  checkpoint.active_trxes_.emplace_back(25, 800);
+
+  int64_t checkpoint_lsn = 0;
+  {
+    CLogManager log_mgr;
+    ASSERT_EQ(RC::SUCCESS, log_mgr.init(path));
+    ASSERT_EQ(RC::SUCCESS, log_mgr.begin_trx(10));
+    CLogRecord *log_record = CLogRecord::build_checkpoint_record(checkpoint);
+    ASSERT_NE(nullptr, log_record);
+    ASSERT_EQ(RC::SUCCESS, log_mgr.append_log(log_record));
+    ASSERT_EQ(RC::SUCCESS, log_mgr.sync());
+  }
+
+  CLogFile log_file;
+  ASSERT_EQ(RC::SUCCESS, log_file.init(path));
+
+  CLogRecordIterator iterator;
+  ASSERT_EQ(RC::SUCCESS, iterator.init(log_file));
+  ASSERT_EQ(RC::SUCCESS, iterator.next());
+  ASSERT_EQ(CLogType::MTR_BEGIN, iterator.log_record().log_type());
+  ASSERT_EQ(RC::SUCCESS, iterator.next());
+  ASSERT_TRUE(iterator.valid());
+  const CLogRecord &log_record = iterator.log_record();
+  ASSERT_EQ(CLogType::CHECKPOINT, log_record.log_type());
+  checkpoint_lsn = log_record.header().lsn_;
+
+  CLogCheckpoint read_checkpoint;
+  ASSERT_EQ(RC::SUCCESS, read_checkpoint.deserialize(log_record.data_record().data_, log_record.data_record().data_len_));
+  ASSERT_EQ(checkpoint.begin_lsn_, read_checkpoint.begin_lsn_);
+  ASSERT_EQ(checkpoint.redo_lsn_, read_checkpoint.redo_lsn_);
+  ASSERT_EQ(checkpoint.max_trx_id_, read_checkpoint.max_trx_id_);
+  ASSERT_EQ(checkpoint.active_trxes_, read_checkpoint.active_trxes_);
+
+  // 从checkpoint日志的位置开始也可以读取
+  CLogRecordIterator checkpoint_iterator;
+  ASSERT_EQ(RC::SUCCESS, checkpoint_iterator.init(log_file, checkpoint_lsn));
+  ASSERT_EQ(RC::SUCCESS, checkpoint_iterator.next());
+  ASSERT_EQ(CLogType::CHECKPOINT, checkpoint_iterator.log_record().log_type());
+
+  // 数据不完整时反序列化失败
+  ASSERT_NE(RC::SUCCESS, read_checkpoint.deserialize(log_record.data_record().data_, log_record.data_record().data_len_ - 1));
+}
+
+TEST(test_clog, test_checkpoint_xid64)
+{
+  // 超过32位的事务号
+  CLogCheckpoint checkpoint;
+  checkpoint.begin_lsn_  = 1000;
+  checkpoint.redo_lsn_   = 200;
+  checkpoint.max_trx_id_ = 5000000030LL;
+  checkpoint.active_trxes_.emplace_back(5000000010LL, 200);
+
+  vector<char> buffer;
+  checkpoint.serialize(buffer);
+  CLogCheckpoint read_checkpoint;
+  ASSERT_EQ(RC::SUCCESS, read_checkpoint.deserialize(buffer.data(), static_cast<int32_t>(buffer.size())));
+  ASSERT_EQ(checkpoint.begin_lsn_, read_checkpoint.begin_lsn_);
+  ASSERT_EQ(checkpoint.max_trx_id_, read_checkpoint.max_trx_id_);
+  ASSERT_EQ(checkpoint.active_trxes_, read_checkpoint.active_trxes_);
+
+  // 升级之前的格式：begin_lsn, redo_lsn, 32位的最大事务号, 事务个数, (32位的事务号, LSN)...
+  vector<char> legacy_buffer;
+  auto         append = [&legacy_buffer](const auto &value) {
+    const char *ptr = reinterpret_cast<const char *>(&value);
+    legacy_buffer.insert(legacy_buffer.end(), ptr, ptr + sizeof(value));
+  };
+  append(int64_t(1000));
+  append(int64_t(200));
+  append(int32_t(30));
+  append(int32_t(2));
+  append(int32_t(10));
+  append(int64_t(200));
+  append(int32_t(25));
+  append(int64_t(800));
+
+  // 正常启动时不能读取，需要先离线升级
+  ASSERT_FALSE(CLogCheckpoint::is_legacy(buffer.data(), static_cast<int32_t>(buffer.size())));
+  ASSERT_TRUE(CLogCheckpoint::is_legacy(legacy_buffer.data(), static_cast<int32_t>(legacy_buffer.size())));
+  ASSERT_NE(RC::SUCCESS, read_checkpoint.deserialize(legacy_buffer.data(), static_cast<int32_t>(legacy_buffer.size())));
+
+  // 离线升级时按照旧格式读取
+  CLogCheckpoint legacy_checkpoint;
+  ASSERT_EQ(RC::SUCCESS,
+      legacy_checkpoint.deserialize_legacy(legacy_buffer.data(), static_cast<int32_t>(legacy_buffer.size())));
+  ASSERT_EQ(1000, legacy_checkpoint.begin_lsn_);
+  ASSERT_EQ(200, legacy_checkpoint.redo_lsn_);
+  ASSERT_EQ(30, legacy_checkpoint.max_trx_id_);
+  ASSERT_EQ((vector<pair<int64_t, int64_t>>{{10, 200}, {25, 800}}), legacy_checkpoint.active_trxes_);
+  ASSERT_NE(RC::SUCCESS,
+      legacy_checkpoint.deserialize_legacy(legacy_buffer.data(), static_cast<int32_t>(legacy_buffer.size()) - 1));
+}
+
+TEST(test_clog, test_compact_encoding)
+{
+  const char *path = "clog_test_encoding";
+  reset_clog_path(path);
+
+  const int data_len = 16;
+  char      data[data_len];
+  memset(data, 'x', sizeof(data));
+  {
+    CLogManager log_mgr;
+    ASSERT_EQ(RC::SUCCESS, log_mgr.init(path));
+    ASSERT_EQ(RC::SUCCESS, log_mgr.begin_trx(3));
+    ASSERT_EQ(RC::SUCCESS, log_mgr.append_log(CLogType::UPDATE, 3, 7, RID(1000, 25), data_len, 300, data));
+    ASSERT_EQ(RC::SUCCESS, log_mgr.append_log(CLogType::DELETE, 3, 7, RID(1001, 0), 0, 0, nullptr));
+    ASSERT_EQ(RC::SUCCESS, log_mgr.commit_trx(3, 100000));
+  }
+
+  CLogFile log_file;
+  ASSERT_EQ(RC::SUCCESS, log_file.init(path));
+  CLogRecordIterator iterator;
+  ASSERT_EQ(RC::SUCCESS, iterator.init(log_file));
+
+  // 小的数字只占一个字节：校验码 + 长度 + 类型 + 事务编号
+  ASSERT_EQ(RC::SUCCESS, iterator.next());
+  ASSERT_EQ(CLogType::MTR_BEGIN, iterator.log_record().log_type());
+  ASSERT_EQ(7, iterator.log_record().serialized_size());
+
+  ASSERT_EQ(RC::SUCCESS, iterator.next());
+  const CLogRecord &update_record = iterator.log_record();
+  ASSERT_EQ(CLogType::UPDATE, update_record.log_type());
+  ASSERT_EQ(3, update_record.trx_id());
+  ASSERT_EQ(7, update_record.data_record().table_id_);
+  ASSERT_EQ(RID(1000, 25), update_record.data_record().rid_);
+  ASSERT_EQ(300, update_record.data_record().data_offset_);
+  ASSERT_EQ(data_len, update_record.data_record().data_len_);
+  ASSERT_EQ(0, memcmp(data, update_record.data_record().data_, data_len));
+
+  ASSERT_EQ(RC::SUCCESS, iterator.next());
+  ASSERT_EQ(CLogType::DELETE, iterator.log_record().log_type());
+  ASSERT_EQ(0, iterator.log_record().data_record().data_len_);
+
+  ASSERT_EQ(RC::SUCCESS, iterator.next());
+  ASSERT_EQ(CLogType::MTR_COMMIT, iterator.log_record().log_type());
+  ASSERT_EQ(100000, iterator.log_record().commit_record().commit_xid_);
+
+  ASSERT_EQ(RC::RECORD_EOF, iterator.next());
+  ASSERT_FALSE(iterator.torn_tail());
+  ASSERT_EQ(log_file.end_lsn(), iterator.lsn());
+}
+
+/**
+ * @brief 修改段文件中指定LSN位置的数据，或者截断段文件
+ */
+static void damage_clog(const char *path, int64_t lsn, bool truncate)
+{
+  string filename = string(path) + "/clog_00000000000000000000";
+  off_t  offset   = static_cast<off_t>(sizeof(CLogSegmentHeader) + lsn);
+  if (truncate) {
+    filesystem::resize_file(filename, offset);
+    return;
+  }
+
+  FILE *file = fopen(filename.c_str(), "r+");
+  ASSERT_NE(nullptr, file);
+  fseek(file, offset, SEEK_SET);
+  int c = fgetc(file);
+  fseek(file, offset, SEEK_SET);
+  fputc(c ^ 0xff, file);
+  fclose(file);
+}
+
+/**
+ * @brief 用 data 覆盖段文件中指定LSN位置的数据，可以写到文件结尾之后
+ */
+static void overwrite_clog(const char *path, int64_t lsn, const char *data, int len)
+{
+  string filename = string(path) + "/clog_00000000000000000000";
+  FILE  *file     = fopen(filename.c_str(), "r+");
+  ASSERT_NE(nullptr, file);
+  fseek(file, static_cast<long>(sizeof(CLogSegmentHeader) + lsn), SEEK_SET);
+  ASSERT_EQ(static_cast<size_t>(len), fwrite(data, 1, len, file));
+  fclose(file);
+}
+
+TEST(test_clog, test_torn_tail)
+{
+  const char *path = "clog_test_torn_tail";
+
+  const int record_num = 100;
+  const int data_len   = 50;
+  char      data[data_len];
+  memset(data, 'a', sizeof(data));
+
+  auto write_logs = [&](vector<int64_t> &lsns) {
+    reset_clog_path(path);
+    CLogManager log_mgr;
+    ASSERT_EQ(RC::SUCCESS, log_mgr.init(path));
+    for (int i = 0; i < record_num; i++) {
+      int64_t lsn = 0;
+      ASSERT_EQ(RC::SUCCESS, log_mgr.append_log(CLogType::INSERT, 1, 1, RID(1, i), data_len, 0, data, &lsn));
+      lsns.push_back(lsn);
+    }
+    ASSERT_EQ(RC::SUCCESS, log_mgr.sync());
+  };
+
+  auto read_logs = [&](CLogFile &log_file, CLogRecordIterator &iterator, int &count) {
+    ASSERT_EQ(RC::SUCCESS, log_file.init(path));
+    ASSERT_EQ(RC::SUCCESS, iterator.init(log_file));
+    count = 0;
+    RC rc = RC::SUCCESS;
+    for (rc = iterator.next(); OB_SUCC(rc) && iterator.valid(); rc = iterator.next()) {
+      count++;
+    }
+  };
+
+  {
+    // 最后一条日志只写了一部分
+    vector<int64_t> lsns;
+    write_logs(lsns);
+    damage_clog(path, lsns.back() + 10, true /*truncate*/);
+
+    CLogFile           log_file;
+    CLogRecordIterator iterator;
+    int                count = 0;
+    read_logs(log_file, iterator, count);
+    ASSERT_EQ(record_num - 1, count);
+    ASSERT_TRUE(iterator.torn_tail());
+    ASSERT_EQ(lsns.back(), iterator.lsn());
+
+    // 截断之后日志就是完整的了
+    ASSERT_EQ(RC::SUCCESS, log_file.truncate(iterator.lsn()));
+    ASSERT_EQ(lsns.back(), log_file.end_lsn());
+  }
+
+  {
+    CLogFile           log_file;
+    CLogRecordIterator iterator;
+    int                count = 0;
+    read_logs(log_file, iterator, count);
+    ASSERT_EQ(record_num - 1, count);
+    ASSERT_FALSE(iterator.torn_tail());
+  }
+
+  {
+    // 最后一条日志写完整了，但是内容不对
+    vector<int64_t> lsns;
+    write_logs(lsns);
+    damage_clog(path, lsns.back() + 20, false /*truncate*/);
+
+    CLogFile           log_file;
+    CLogRecordIterator iterator;
+    int                count = 0;
+    read_logs(log_file, iterator, count);
+    ASSERT_EQ(record_num - 1, count);
+    ASSERT_TRUE(iterator.torn_tail());
+  }
+
+  {
+    // 中间的日志损坏了，不能当作日志的结尾
+    vector<int64_t> lsns;
+    write_logs(lsns);
+    damage_clog(path, lsns[record_num / 2] + 20, false /*truncate*/);
+
+    CLogFile log_file;
+    ASSERT_EQ(RC::SUCCESS, log_file.init(path));
+    CLogRecordIterator iterator;
+    ASSERT_EQ(RC::SUCCESS, iterator.init(log_file));
+    RC  rc    = RC::SUCCESS;
+    int count = 0;
+    for (rc = iterator.next(); OB_SUCC(rc) && iterator.valid(); rc = iterator.next()) {
+      count++;
+    }
+    ASSERT_EQ(RC::LOG_CORRUPTED, rc);
+    ASSERT_EQ(record_num / 2, count);
+  }
+
+  // 中间日志的长度字段损坏了，不管长度是无法解析、指向后面日志的中间还是超过了日志的结尾，都不能当作日志的结尾
+  const char bad_lengths[][2] = {{'\x80', '\x80'}, {'\x00', '\x00'}, {'\x05', '\x00'}, {'\xff', '\x7f'}};
+  for (const char *bad_length : bad_lengths) {
+    vector<int64_t> lsns;
+    write_logs(lsns);
+    const int64_t corrupted_lsn = lsns[record_num / 2];
+    overwrite_clog(path, corrupted_lsn + CLogRecord::CHECKSUM_SIZE, bad_length, 2);
+
+    CLogFile           log_file;
+    CLogRecordIterator iterator;
+    int                count = 0;
+    read_logs(log_file, iterator, count);
+    ASSERT_EQ(record_num / 2, count);
+    ASSERT_FALSE(iterator.torn_tail());
+    ASSERT_EQ(corrupted_lsn, iterator.lsn());
+    ASSERT_EQ(RC::LOG_CORRUPTED, iterator.next());
+  }
+
+  {
+    // 最后一条日志的长度字段损坏了，后面没有完整的日志
+    vector<int64_t> lsns;
+    write_logs(lsns);
+    const char bad_length[2] = {'\xff', '\x7f'};
+    overwrite_clog(path, lsns.back() + CLogRecord::CHECKSUM_SIZE, bad_length, 2);
+
+    CLogFile           log_file;
+    CLogRecordIterator iterator;
+    int                count = 0;
+    read_logs(log_file, iterator, count);
+    ASSERT_EQ(record_num - 1, count);
+    ASSERT_TRUE(iterator.torn_tail());
+    ASSERT_EQ(lsns.back(), iterator.lsn());
+  }
+
+  {
+    // 文件变长了但是数据没有写进去，日志后面都是0
+    vector<int64_t> lsns;
+    write_logs(lsns);
+    CLogFile end_file;
+    ASSERT_EQ(RC::SUCCESS, end_file.init(path));
+    const int64_t end_lsn = end_file.end_lsn();
+    const char    zeros[100] = {0};
+    overwrite_clog(path, end_lsn, zeros, sizeof(zeros));
+
+    CLogFile           log_file;
+    CLogRecordIterator iterator;
+    int                count = 0;
+    read_logs(log_file, iterator, count);
+    ASSERT_EQ(record_num, count);
+    ASSERT_TRUE(iterator.torn_tail());
+    ASSERT_EQ(end_lsn, iterator.lsn());
+  }
+}
+
+TEST(test_clog, test_async_commit)
+{
+  const char *path = "clog_test_async_commit";
+  reset_clog_path(path);
+
+  CLogManager log_mgr;
+  ASSERT_EQ(RC::SUCCESS, log_mgr.init(path));
+  log_mgr.set_async_flush_interval(20);
+
+  ASSERT_EQ(RC::SUCCESS, log_mgr.begin_trx(1));
+  ASSERT_EQ(RC::SUCCESS, log_mgr.commit_trx(1, 2));
+  ASSERT_EQ(log_mgr.current_lsn(), log_mgr.durable_lsn());
+
+  // 异步提交不等待日志落盘，后台线程过一段时间会把日志刷下去
+  ASSERT_EQ(RC::SUCCESS, log_mgr.begin_trx(3));
+  ASSERT_EQ(RC::SUCCESS, log_mgr.commit_trx(3, 4, nullptr /*lsn*/, false /*durable*/));
+  const int64_t commit_end_lsn = log_mgr.current_lsn();
+  ASSERT_LT(log_mgr.durable_lsn(), commit_end_lsn);
+
+  for (int i = 0; i < 100 && log_mgr.durable_lsn() < commit_end_lsn; i++) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+  ASSERT_EQ(commit_end_lsn, log_mgr.durable_lsn());
+}
+
+TEST(test_clog, test_archive_and_restore)
+{
+  const char *path         = "clog_test_archive";
+  const char *base_path    = "clog_test_archive_base";
+  const char *restore_path = "clog_test_archive_restore";
+  const char *archive_path = "clog_test_archive_dir";
+  reset_clog_path(path);
+  filesystem::remove_all(base_path);
+  filesystem::remove_all(archive_path);
+
+  const int64_t segment_size = 4096;
+  const int     data_len     = 100;
+  char          data[data_len];
+  memset(data, 'a', sizeof(data));
+
+  int64_t base_end_lsn = 0;
+  int64_t end_lsn      = 0;
+  {
+    CLogManager log_mgr;
+    ASSERT_EQ(RC::SUCCESS, log_mgr.init(path, segment_size));
+    ASSERT_EQ(RC::SUCCESS, log_mgr.enable_archive(archive_path));
+
+    // 每个事务一条数据日志，提交号是 1000 + 事务号
+    for (int trx_id = 1; trx_id <= 200; trx_id++) {
+      ASSERT_EQ(RC::SUCCESS, log_mgr.append_log(CLogType::INSERT, trx_id, 1, RID(1, trx_id), data_len, 0, data));
+      ASSERT_EQ(RC::SUCCESS, log_mgr.commit_trx(trx_id, 1000 + trx_id));
+
+      if (trx_id == 20) {
+        // 基础备份
+        filesystem::copy(path, base_path, filesystem::copy_options::recursive);
+        base_end_lsn = log_mgr.durable_lsn();
+      }
+    }
+
+    // 只归档写满并且落盘的段文件
+    end_lsn = log_mgr.durable_lsn();
+    ASSERT_EQ(RC::SUCCESS, log_mgr.archiver()->archive());
+    ASSERT_EQ(end_lsn - end_lsn % segment_size, log_mgr.archiver()->archived_lsn());
+
+    CLogArchiveManifest manifest;
+    ASSERT_EQ(RC::SUCCESS, manifest.load(archive_path));
+    ASSERT_EQ(static_cast<size_t>(end_lsn / segment_size), manifest.entries().size());
+    ASSERT_EQ(log_mgr.archiver()->archived_lsn(), manifest.end_lsn());
+  }
+
+  // 恢复到指定的提交号，之后的日志都被截断
+  filesystem::remove_all(restore_path);
+  filesystem::copy(base_path, restore_path, filesystem::copy_options::recursive);
+  {
+    CLogRestorer restorer(archive_path, restore_path);
+    restorer.set_target_xid(1100);
+    ASSERT_EQ(RC::SUCCESS, restorer.restore());
+    ASSERT_EQ(1100, restorer.last_commit_xid());
+
+    CLogFile log_file;
+    ASSERT_EQ(RC::SUCCESS, log_file.init(restore_path));
+    ASSERT_EQ(restorer.stop_lsn(), log_file.end_lsn());
+
+    CLogRecordIterator iterator;
+    ASSERT_EQ(RC::SUCCESS, iterator.init(log_file));
+    int64_t last_commit_xid = -1;
+    RC      rc              = RC::SUCCESS;
+    for (rc = iterator.next(); OB_SUCC(rc) && iterator.valid(); rc = iterator.next()) {
+      if (iterator.log_record().log_type() == CLogType::MTR_COMMIT) {
+        last_commit_xid = iterator.log_record().commit_record().commit_xid_;
+      }
+    }
+    ASSERT_EQ(RC::RECORD_EOF, rc);
+    ASSERT_FALSE(iterator.torn_tail());
+    ASSERT_EQ(1100, last_commit_xid);
+  }
+
+  // 不指定目标时恢复到归档的结尾
+  filesystem::remove_all(restore_path);
+  filesystem::copy(base_path, restore_path, filesystem::copy_options::recursive);
+  {
+    CLogRestorer restorer(archive_path, restore_path);
+    ASSERT_EQ(RC::SUCCESS, restorer.restore());
+
+    // 最后一个归档的段文件结尾可能是半条日志，这部分日志会被丢弃
+    const int64_t archived_lsn = end_lsn - end_lsn % segment_size;
+    ASSERT_LE(restorer.stop_lsn(), archived_lsn);
+    ASSERT_GT(restorer.stop_lsn(), archived_lsn - 2 * data_len);
+    ASSERT_GT(restorer.last_commit_xid(), 1100);
+  }
+
+  // 基础备份中的页面可能已经包含了之后的修改，不能恢复到基础备份之前
+  filesystem::remove_all(restore_path);
+  filesystem::copy(base_path, restore_path, filesystem::copy_options::recursive);
+  {
+    CLogRestorer restorer(archive_path, restore_path);
+    restorer.set_target_xid(1010);
+    ASSERT_EQ(RC::INVALID_ARGUMENT, restorer.restore());
+  }
+
+  // 恢复到基础备份的日志结尾
+  filesystem::remove_all(restore_path);
+  filesystem::copy(base_path, restore_path, filesystem::copy_options::recursive);
+  {
+    CLogRestorer restorer(archive_path, restore_path);
+    restorer.set_target_lsn(base_end_lsn);
+    ASSERT_EQ(RC::SUCCESS, restorer.restore());
+    ASSERT_EQ(base_end_lsn, restorer.stop_lsn());
+    ASSERT_EQ(1020, restorer.last_commit_xid());
+  }
+
+  // 归档比日志还长，说明归档属于别的数据库
+  reset_clog_path(path);
+  {
+    CLogManager log_mgr;
+    ASSERT_EQ(RC::SUCCESS, log_mgr.init(path, segment_size));
+    ASSERT_EQ(RC::INVALID_ARGUMENT, log_mgr.enable_archive(archive_path));
+  }
+}
+
 int main(int argc, char **argv)
 {
   // 分析gtest程序的命令行参数
@@ -0,0 +1,234 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/18.
+//
+
+#include <string.h>
+#include <vector>
+
+#include "storage/record/column_encoding.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+class ColumnMinipageHolder
+{
+public:
+  ColumnMinipageHolder(ColumnEncoding encoding, AttrType type, int len, int capacity)
+  {
+    page_.desc.len      = len;
+    page_.desc.type     = type;
+    page_.desc.encoding = encoding;
+    page_.capacity      = capacity;
+
+    codec_ = ColumnCodec::get(encoding);
+    buffer_.resize(codec_->area_size(page_.desc, capacity));
+    page_.data = buffer_.data();
+    codec_->init(page_);
+  }
+
+  ColumnMinipage    &page() { return page_; }
+  const ColumnCodec *codec() const { return codec_; }
+
+  bool write(SlotNum slot_num, const char *value)
+  {
+    if (!codec_->can_write(page_, slot_num, value)) {
+      return false;
+    }
+    codec_->write(page_, slot_num, value);
+    return true;
+  }
+
+  bool write_int(SlotNum slot_num, int32_t value) { return write(slot_num, reinterpret_cast<const char *>(&value)); }
+
+  int32_t read_int(SlotNum slot_num)
+  {
+    int32_t value = 0;
+    codec_->read(page_, slot_num, reinterpret_cast<char *>(&value));
+    return value;
+  }
+
+private:
+  ColumnMinipage     page_;
+  const ColumnCodec *codec_ = nullptr;
+  vector<char>       buffer_;
+};
+
+TEST(test_column_encoding, test_dict)
+{
+  const int            len = 8;
+  ColumnMinipageHolder holder(ColumnEncoding::DICT_ENCODING, CHARS, len, 100);
+  ASSERT_LT(holder.codec()->area_size(holder.page().desc, 100), len * 100);
+
+  char value[len];
+  for (int i = 0; i < 100; i++) {
+    memset(value, 0, len);
+    snprintf(value, len, "v%d", i % 16);
+    ASSERT_TRUE(holder.write(i, value));
+  }
+
+  // 字典已经满了，新的值无法写入，已有的值仍然可以写入
+  memset(value, 0, len);
+  snprintf(value, len, "new");
+  ASSERT_FALSE(holder.write(0, value));
+  snprintf(value, len, "v3");
+  ASSERT_TRUE(holder.write(0, value));
+
+  char result[len];
+  holder.codec()->read(holder.page(), 0, result);
+  ASSERT_STREQ(result, "v3");
+  holder.codec()->read(holder.page(), 17, result);
+  ASSERT_STREQ(result, "v1");
+
+  // 在字典编号上计算条件
+  EncodedCondition condition;
+  ASSERT_TRUE(holder.codec()->prepare(holder.page(), EQUAL_TO, Value("v5"), condition));
+  ASSERT_TRUE(condition.evaluable);
+  int matched = 0;
+  for (int i = 0; i < 100; i++) {
+    matched += holder.codec()->match(holder.page(), i, condition) ? 1 : 0;
+  }
+  ASSERT_EQ(matched, 6);
+
+  ASSERT_FALSE(holder.codec()->prepare(holder.page(), EQUAL_TO, Value("absent"), condition));
+}
+
+TEST(test_column_encoding, test_rle)
+{
+  const int            capacity = 256;
+  ColumnMinipageHolder holder(ColumnEncoding::RLE_ENCODING, INTS, 4, capacity);
+  ASSERT_LT(holder.codec()->area_size(holder.page().desc, capacity), 4 * capacity);
+
+  // 4个run
+  for (int i = 0; i < 200; i++) {
+    ASSERT_TRUE(holder.write_int(i, i / 50));
+  }
+  for (int i = 0; i < 200; i++) {
+    ASSERT_EQ(holder.read_int(i), i / 50);
+  }
+
+  // 在中间修改会拆分run，修改回来以后会重新合并
+  ASSERT_TRUE(holder.write_int(75, 100));
+  ASSERT_EQ(holder.read_int(74), 1);
+  ASSERT_EQ(holder.read_int(75), 100);
+  ASSERT_EQ(holder.read_int(76), 1);
+  ASSERT_TRUE(holder.write_int(75, 1));
+  ASSERT_EQ(holder.read_int(75), 1);
+
+  // run个数有上限，交替写入不同的值很快就会写满
+  int written = 200;
+  while (written < capacity && holder.write_int(written, written % 2)) {
+    written++;
+  }
+  ASSERT_LT(written, capacity);
+  for (int i = 200; i < written; i++) {
+    ASSERT_EQ(holder.read_int(i), i % 2);
+  }
+
+  EncodedCondition condition;
+  ASSERT_TRUE(holder.codec()->prepare(holder.page(), GREAT_EQUAL, Value(2), condition));
+  ASSERT_TRUE(holder.codec()->match(holder.page(), 150, condition));
+  ASSERT_FALSE(holder.codec()->match(holder.page(), 10, condition));
+}
+
+TEST(test_column_encoding, test_for)
+{
+  const int            capacity = 1000;
+  ColumnMinipageHolder holder(ColumnEncoding::FOR_ENCODING, INTS, 4, capacity);
+  ASSERT_LT(holder.codec()->area_size(holder.page().desc, capacity), 4 * capacity / 2);
+
+  // 基准值由第一个值决定，附近的值(包括负数)都可以放进来
+  const int32_t first = -1000000;
+  for (int i = 0; i < capacity; i++) {
+    ASSERT_TRUE(holder.write_int(i, first + i - capacity / 2));
+  }
+  for (int i = 0; i < capacity; i++) {
+    ASSERT_EQ(holder.read_int(i), first + i - capacity / 2);
+  }
+
+  // 超出表示范围
+  ASSERT_FALSE(holder.write_int(0, first + 100000000));
+  ASSERT_FALSE(holder.write_int(0, first - 100000000));
+
+  EncodedCondition condition;
+  ASSERT_TRUE(holder.codec()->prepare(holder.page(), LESS_THAN, Value(first), condition));
+  ASSERT_TRUE(condition.evaluable);
+  int matched = 0;
+  for (int i = 0; i < capacity; i++) {
+    matched += holder.codec()->match(holder.page(), i, condition) ? 1 : 0;
+  }
+  ASSERT_EQ(matched, capacity / 2);
+}
+
+TEST(test_column_encoding, test_reencode)
+{
+  // FOR：按照保留下来的值重新选择基准值
+  ColumnMinipageHolder for_holder(ColumnEncoding::FOR_ENCODING, INTS, 4, 1000);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(for_holder.write_int(i, i));
+  }
+  const int32_t far_value = 2000000000;
+  ASSERT_FALSE(for_holder.write_int(10, far_value));
+  ASSERT_FALSE(for_holder.codec()->reencode(
+      for_holder.page(), {0, 1}, 10, reinterpret_cast<const char *>(&far_value)));
+  ASSERT_EQ(for_holder.read_int(1), 1);
+  ASSERT_TRUE(for_holder.codec()->reencode(for_holder.page(), {}, 0, reinterpret_cast<const char *>(&far_value)));
+  ASSERT_TRUE(for_holder.write_int(0, far_value));
+  ASSERT_TRUE(for_holder.write_int(1, far_value - 100));
+  ASSERT_EQ(for_holder.read_int(0), far_value);
+  ASSERT_EQ(for_holder.read_int(1), far_value - 100);
+
+  // RLE：在中间只能写入相同的值，重新编码时没有记录的槽位可以归到任何一个run中
+  const int            capacity = 64;
+  ColumnMinipageHolder rle_holder(ColumnEncoding::RLE_ENCODING, INTS, 4, capacity);
+  for (int i = 0; i < 8; i++) {
+    ASSERT_TRUE(rle_holder.write_int(i, i % 2));
+  }
+  ASSERT_FALSE(rle_holder.write_int(9, 0));
+  const int32_t zero = 0;
+  const int32_t one  = 1;
+  ASSERT_TRUE(rle_holder.codec()->can_overwrite(rle_holder.page(), 3, reinterpret_cast<const char *>(&one)));
+  ASSERT_FALSE(rle_holder.codec()->can_overwrite(rle_holder.page(), 2, reinterpret_cast<const char *>(&one)));
+  ASSERT_TRUE(rle_holder.codec()->reencode(rle_holder.page(), {0, 2, 4, 7}, 9, reinterpret_cast<const char *>(&zero)));
+  ASSERT_EQ(rle_holder.read_int(0), 0);
+  ASSERT_EQ(rle_holder.read_int(2), 0);
+  ASSERT_EQ(rle_holder.read_int(4), 0);
+  ASSERT_EQ(rle_holder.read_int(7), 1);
+  ASSERT_EQ(rle_holder.read_int(9), 0);
+
+  // DICT：字典中只保留还在使用的值
+  const int            len = 8;
+  ColumnMinipageHolder dict_holder(ColumnEncoding::DICT_ENCODING, CHARS, len, 100);
+  char                 value[len];
+  for (int i = 0; i < 16; i++) {
+    memset(value, 0, len);
+    snprintf(value, len, "v%d", i);
+    ASSERT_TRUE(dict_holder.write(i, value));
+  }
+  memset(value, 0, len);
+  snprintf(value, len, "new");
+  ASSERT_FALSE(dict_holder.write(16, value));
+  ASSERT_TRUE(dict_holder.codec()->reencode(dict_holder.page(), {3, 5}, 16, value));
+  ASSERT_TRUE(dict_holder.write(16, value));
+
+  char result[len];
+  dict_holder.codec()->read(dict_holder.page(), 5, result);
+  ASSERT_STREQ(result, "v5");
+  dict_holder.codec()->read(dict_holder.page(), 16, result);
+  ASSERT_STREQ(result, "new");
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <string.h>
+
+#include "common/lang/varint.h"
+#include "common/math/crc32c.h"
+#include "gtest/gtest.h"
+
+using namespace common;
+
+TEST(crc32c, test_known_values)
+{
+  // RFC 3720 B.4 中的测试数据
+  const char *digits = "123456789";
+  EXPECT_EQ(0xe3069283U, crc32c(digits, strlen(digits)));
+
+  char zeros[32];
+  memset(zeros, 0, sizeof(zeros));
+  EXPECT_EQ(0x8a9136aaU, crc32c(zeros, sizeof(zeros)));
+
+  char ones[32];
+  memset(ones, 0xff, sizeof(ones));
+  EXPECT_EQ(0x62a8ab43U, crc32c(ones, sizeof(ones)));
+}
+
+TEST(crc32c, test_extend)
+{
+  char data[1000];
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = static_cast<char>(i * 7);
+  }
+
+  const uint32_t expected = crc32c(data, sizeof(data));
+  for (size_t split : {0, 1, 7, 8, 13, 500, 999, 1000}) {
+    EXPECT_EQ(expected, crc32c_extend(crc32c(data, split), data + split, sizeof(data) - split));
+  }
+}
+
+TEST(varint, test_encode_decode)
+{
+  const int64_t values[] = {0, 1, -1, 63, -64, 64, 127, 128, 300, -300, INT32_MAX, INT32_MIN, INT64_MAX, INT64_MIN};
+  for (int64_t value : values) {
+    char          buf[MAX_VARINT_SIZE];
+    const uint64_t raw  = zigzag_encode(value);
+    const int      size = encode_varint(buf, raw);
+    EXPECT_EQ(varint_size(raw), size);
+
+    uint64_t decoded = 0;
+    EXPECT_EQ(size, decode_varint(buf, size, decoded));
+    EXPECT_EQ(value, zigzag_decode(decoded));
+
+    // 数据不完整时解码失败
+    EXPECT_EQ(0, decode_varint(buf, size - 1, decoded));
+  }
+
+  char buf[MAX_VARINT_SIZE];
+  EXPECT_EQ(1, encode_varint(buf, zigzag_encode(-1)));
+  EXPECT_EQ(2, encode_varint(buf, 300));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
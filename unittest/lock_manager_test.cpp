@@ -0,0 +1,133 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <chrono>
+#include <thread>
+
+#include "storage/trx/lock_manager.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(lock_manager, test_try_lock_and_release)
+{
+  LockManager lock_manager;
+  const RID   rid(1, 1);
+  ASSERT_EQ(RC::SUCCESS, lock_manager.try_lock(1, 0, rid));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.try_lock(1, 0, rid));
+  ASSERT_EQ(RC::LOCKED_NEED_WAIT, lock_manager.try_lock(2, 0, rid));
+  ASSERT_TRUE(lock_manager.locked_by_other(2, 0, rid));
+  ASSERT_FALSE(lock_manager.locked_by_other(1, 0, rid));
+
+  // 不同的表上相同的RID是不同的锁
+  ASSERT_EQ(RC::SUCCESS, lock_manager.try_lock(2, 1, rid));
+
+  lock_manager.release_all(1);
+  ASSERT_FALSE(lock_manager.locked_by_other(2, 0, rid));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.try_lock(2, 0, rid));
+  lock_manager.release_all(2);
+  ASSERT_EQ(0, lock_manager.stat().wait_count);
+}
+
+TEST(lock_manager, test_wait_in_order)
+{
+  LockManager lock_manager;
+  const RID   rid(1, 1);
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(1, 0, rid));
+
+  // 事务2先开始等待，锁释放时先交给它
+  vector<int64_t> granted;
+  mutex           granted_lock;
+  auto            waiter = [&](int64_t trx_id) {
+    ASSERT_EQ(RC::SUCCESS, lock_manager.lock(trx_id, 0, rid));
+    {
+      lock_guard<mutex> guard(granted_lock);
+      granted.push_back(trx_id);
+    }
+    lock_manager.release_all(trx_id);
+  };
+  thread first(waiter, 2);
+  while (lock_manager.stat().waiting_count < 1) {
+    this_thread::yield();
+  }
+  thread second(waiter, 3);
+  while (lock_manager.stat().waiting_count < 2) {
+    this_thread::yield();
+  }
+
+  lock_manager.release_all(1);
+  first.join();
+  second.join();
+  ASSERT_EQ((vector<int64_t>{2, 3}), granted);
+
+  const LockStat stat = lock_manager.stat();
+  ASSERT_EQ(2, stat.wait_count);
+  ASSERT_EQ(0, stat.waiting_count);
+  ASSERT_GE(stat.wait_time_us, stat.max_wait_time_us);
+}
+
+TEST(lock_manager, test_timeout)
+{
+  LockManager lock_manager;
+  lock_manager.set_wait_timeout(50);
+  const RID rid(1, 1);
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(1, 0, rid));
+
+  const auto begin = chrono::steady_clock::now();
+  ASSERT_EQ(RC::LOCKED_WAIT_TIMEOUT, lock_manager.lock(2, 0, rid));
+  ASSERT_GE(chrono::steady_clock::now() - begin, chrono::milliseconds(50));
+  ASSERT_EQ(1, lock_manager.stat().timeout_count);
+
+  // 超时的事务已经不在等待队列中了
+  lock_manager.release_all(1);
+  ASSERT_FALSE(lock_manager.locked_by_other(3, 0, rid));
+}
+
+TEST(lock_manager, test_deadlock)
+{
+  LockManager lock_manager;
+  const RID   rid1(1, 1);
+  const RID   rid2(1, 2);
+  const RID   rid3(1, 3);
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(1, 0, rid1));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(2, 0, rid2));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(3, 0, rid3));
+
+  // 1 等 2，2 等 3，3 再等 1 就成环了
+  thread trx1([&]() { ASSERT_EQ(RC::SUCCESS, lock_manager.lock(1, 0, rid2)); });
+  while (lock_manager.stat().waiting_count < 1) {
+    this_thread::yield();
+  }
+  thread trx2([&]() { ASSERT_EQ(RC::SUCCESS, lock_manager.lock(2, 0, rid3)); });
+  while (lock_manager.stat().waiting_count < 2) {
+    this_thread::yield();
+  }
+
+  ASSERT_EQ(RC::LOCKED_DEADLOCK, lock_manager.lock(3, 0, rid1));
+  ASSERT_EQ(1, lock_manager.stat().deadlock_count);
+
+  // 事务3作为牺牲者结束以后，其它事务依次拿到锁
+  lock_manager.release_all(3);
+  trx2.join();
+  lock_manager.release_all(2);
+  trx1.join();
+  lock_manager.release_all(1);
+  ASSERT_EQ(0, lock_manager.stat().waiting_count);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,94 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include <limits>
+
+#include "storage/trx/mvcc_trx.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(read_only_trx, test_read_view)
+{
+  MvccTrxKit trx_kit;
+  ASSERT_EQ(RC::SUCCESS, trx_kit.init());
+
+  Trx     *trx = trx_kit.create_trx(nullptr /*log_manager*/);
+  ReadView trx_view;
+  int64_t  trx_id = trx_kit.begin_trx(trx, trx_view);
+
+  // 只读事务不分配事务号，正在运行的读写事务对它不可见
+  ReadView read_only_view;
+  trx_kit.begin_read_only_trx(read_only_view);
+  ASSERT_EQ(trx_id, trx_kit.current_trx_id());
+  ASSERT_EQ(trx_id + 1, read_only_view.high_watermark());
+  ASSERT_EQ(trx_id + 1, read_only_view.low_watermark());
+  ASSERT_FALSE(read_only_view.sees(Xid::uncommitted(trx_id), trx_kit.status_table()));
+
+  int64_t commit_xid = trx_kit.prepare_commit(trx_id);
+  trx_kit.commit_trx(trx_id, commit_xid, -1 /*commit_lsn*/);
+  trx_kit.end_trx(trx_id);
+  ASSERT_FALSE(read_only_view.sees(commit_xid, trx_kit.status_table()));
+
+  trx_kit.end_read_only_trx(read_only_view);
+  trx_kit.destroy_trx(trx);
+}
+
+TEST(read_only_trx, test_oldest_active_trx_id)
+{
+  MvccTrxKit trx_kit;
+  ASSERT_EQ(RC::SUCCESS, trx_kit.init());
+
+  ReadView read_only_view;
+  trx_kit.begin_read_only_trx(read_only_view);
+  const int64_t low_watermark = read_only_view.low_watermark();
+
+  // 之后开始并提交的事务都不能让最老的事务号越过只读事务的读视图，它还能看到的旧版本不能清理
+  Trx *trx = trx_kit.create_trx(nullptr /*log_manager*/);
+  for (int i = 0; i < 10; i++) {
+    ReadView trx_view;
+    int64_t  trx_id = trx_kit.begin_trx(trx, trx_view);
+    trx_kit.commit_trx(trx_id, trx_kit.prepare_commit(trx_id), -1 /*commit_lsn*/);
+    trx_kit.end_trx(trx_id);
+  }
+  ASSERT_EQ(low_watermark, trx_kit.oldest_active_trx_id());
+
+  // 只读事务结束以后不再限制
+  trx_kit.end_read_only_trx(read_only_view);
+  ASSERT_EQ(trx_kit.current_trx_id() + 1, trx_kit.oldest_active_trx_id());
+  trx_kit.destroy_trx(trx);
+}
+
+TEST(read_only_trx, test_exclusive)
+{
+  MvccTrxKit trx_kit;
+  ASSERT_EQ(RC::SUCCESS, trx_kit.init());
+
+  Trx *trx = trx_kit.create_trx(nullptr /*log_manager*/);
+
+  // 有只读事务在运行时不能独占运行，搬动记录会影响它的读取
+  ReadView read_only_view;
+  trx_kit.begin_read_only_trx(read_only_view);
+  ASSERT_FALSE(trx_kit.begin_exclusive(trx));
+
+  trx_kit.end_read_only_trx(read_only_view);
+  ASSERT_TRUE(trx_kit.begin_exclusive(trx));
+  trx_kit.end_exclusive(trx);
+  trx_kit.destroy_trx(trx);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,110 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include <chrono>
+#include <thread>
+
+#include "storage/trx/read_view.h"
+#include "storage/trx/trx_status_table.h"
+#include "storage/trx/xid.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(read_view, test_committed_xid)
+{
+  TrxStatusTable status_table;
+  ReadView       view(10 /*creator*/, 10 /*low*/, 11 /*high*/);
+
+  ASSERT_TRUE(view.sees(3, status_table));
+  ASSERT_TRUE(view.sees(10, status_table));
+  ASSERT_FALSE(view.sees(11, status_table));
+  ASSERT_FALSE(view.sees(20, status_table));
+}
+
+TEST(read_view, test_uncommitted_xid)
+{
+  TrxStatusTable status_table;
+  status_table.begin(5);
+  status_table.begin(7);
+  status_table.begin(10);
+  ReadView view(10 /*creator*/, 10 /*low*/, 11 /*high*/);
+
+  // 自己的修改总是可见的
+  ASSERT_TRUE(view.sees(Xid::uncommitted(10), status_table));
+
+  // 创建视图时还在运行的事务，之后提交了也看不到，提交事务号不会比高水位小
+  status_table.commit(5, 12);
+  ASSERT_FALSE(view.sees(Xid::uncommitted(5), status_table));
+  ASSERT_FALSE(view.sees(Xid::uncommitted(7), status_table));
+
+  // 视图创建之后才开始的事务
+  status_table.begin(13);
+  status_table.commit(13, 14);
+  ASSERT_FALSE(view.sees(Xid::uncommitted(13), status_table));
+
+  // 视图创建前已经提交，但是还没有改写记录上的事务号
+  status_table.begin(3);
+  status_table.commit(3, 4);
+  ASSERT_TRUE(view.sees(Xid::uncommitted(3), status_table));
+  int64_t commit_xid = 0;
+  ASSERT_EQ(TrxStatusTable::Status::COMMITTED, status_table.get(3, &commit_xid));
+  ASSERT_EQ(4, commit_xid);
+
+  // 回滚的和已经结束(状态表中没有)的事务
+  status_table.begin(2);
+  status_table.abort(2);
+  ASSERT_FALSE(view.sees(Xid::uncommitted(2), status_table));
+  status_table.remove(3);
+  ASSERT_FALSE(view.sees(Xid::uncommitted(3), status_table));
+  ASSERT_EQ(TrxStatusTable::Status::UNKNOWN, status_table.get(3));
+}
+
+TEST(read_view, test_large_xid)
+{
+  // 事务号超过32位以后，比较和未提交标记都不受影响
+  const int64_t  base = 5000000000LL;
+  TrxStatusTable status_table;
+  status_table.begin(base + 1);
+  status_table.begin(base + 3);
+  ReadView view(base + 3 /*creator*/, base + 3 /*low*/, base + 4 /*high*/);
+
+  ASSERT_TRUE(view.sees(base, status_table));
+  ASSERT_FALSE(view.sees(base + 4, status_table));
+  ASSERT_TRUE(view.sees(Xid::uncommitted(base + 3), status_table));
+  ASSERT_FALSE(view.sees(Xid::uncommitted(base + 1), status_table));
+  ASSERT_FALSE(view.sees(Xid::MAX, status_table));
+  ASSERT_EQ(base + 1, Xid::trx_id(Xid::uncommitted(base + 1)));
+}
+
+TEST(read_view, test_committing)
+{
+  TrxStatusTable status_table;
+  status_table.begin(5);
+  status_table.prepare_commit(5);
+  ReadView view(10 /*creator*/, 10 /*low*/, 11 /*high*/);
+
+  // 正在提交的事务要等它拿到提交事务号以后再判断
+  thread committer([&status_table]() {
+    this_thread::sleep_for(chrono::milliseconds(10));
+    status_table.commit(5, 8);
+  });
+  ASSERT_TRUE(view.sees(Xid::uncommitted(5), status_table));
+  committer.join();
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai.wyl on 2022
 //
 
+#include <memory>
 #include <sstream>
 #include <string.h>
 
@@ -180,6 +181,229 @@ TEST(test_record_page_handler, test_record_file_iterator)
   file_scanner.close_scan();
   ASSERT_EQ(count, rids.size() / 2);
 
+  rc = file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr /*condition_filter*/);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  count = 0;
+  std::vector<Record> records;
+  while ((rc = file_scanner.next_batch(records)) == RC::SUCCESS) {
+    ASSERT_FALSE(records.empty());
+    for (const Record &batch_record : records) {
+      ASSERT_EQ(batch_record.rid().page_num, records[0].rid().page_num);
+    }
+    count += static_cast<int>(records.size());
+  }
+  ASSERT_EQ(rc, RC::RECORD_EOF);
+  file_scanner.close_scan();
+  ASSERT_EQ(count, rids.size() / 2);
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
+TEST(test_record_page_handler, test_record_file_batch_insert)
+{
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  RC                 rc  = bpm->create_file(record_manager_file);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  rc = bpm->open_file(record_manager_file, bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  RecordFileHandler file_handler;
+  rc = file_handler.init(bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  const int                 record_insert_num = 1000;
+  std::vector<int>          record_datas(record_insert_num * 5);
+  std::vector<const char *> datas;
+  for (int i = 0; i < record_insert_num; i++) {
+    record_datas[i * 5] = i;
+    datas.push_back(reinterpret_cast<const char *>(&record_datas[i * 5]));
+  }
+
+  std::vector<RID> rids;
+  rc = file_handler.insert_records(datas, 5 * sizeof(int), rids);
+  ASSERT_EQ(rc, RC::SUCCESS);
+  ASSERT_EQ(rids.size(), datas.size());
+
+  // 批量插入的记录是连续放在页面中的，只有页面满了才会换到下一个页面
+  for (int i = 1; i < record_insert_num; i++) {
+    if (rids[i].page_num == rids[i - 1].page_num) {
+      ASSERT_EQ(rids[i].slot_num, rids[i - 1].slot_num + 1);
+    }
+  }
+
+  for (int i = 0; i < record_insert_num; i++) {
+    rc = file_handler.visit_record(rids[i], true /*readonly*/, [i](Record &record) {
+      ASSERT_EQ(0, memcmp(record.data(), &i, sizeof(i)));
+    });
+    ASSERT_EQ(rc, RC::SUCCESS);
+  }
+
+  VacuousTrx        trx;
+  RecordFileScanner file_scanner;
+  rc = file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr /*condition_filter*/);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  int    count = 0;
+  Record record;
+  while (file_scanner.has_next()) {
+    rc = file_scanner.next(record);
+    ASSERT_EQ(rc, RC::SUCCESS);
+    count++;
+  }
+  file_scanner.close_scan();
+  ASSERT_EQ(count, record_insert_num);
+
+  // 原地更新不会改变记录的位置
+  int new_data[5] = {-1, -2, -3, -4, -5};
+  rc = file_handler.update_record(rids[10], reinterpret_cast<const char *>(new_data));
+  ASSERT_EQ(rc, RC::SUCCESS);
+  rc = file_handler.visit_record(rids[10], true /*readonly*/, [&new_data](Record &record) {
+    ASSERT_EQ(0, memcmp(record.data(), new_data, sizeof(new_data)));
+  });
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
+TEST(test_record_page_handler, test_record_logger)
+{
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp));
+
+  // 日志的LSN在释放页面锁之前设置到页面上，页面LSN只会增大
+  LSN          next_lsn = 100;
+  RecordLogger logger   = [&next_lsn](const RID &) { return next_lsn; };
+
+  char record_data[20] = {0};
+  RID  rid;
+  LSN  lsn = -1;
+  ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid, logger));
+  ASSERT_EQ(RC::SUCCESS, bp->get_page_lsn(rid.page_num, lsn));
+  ASSERT_EQ(100, lsn);
+
+  next_lsn       = 50;
+  record_data[0] = 1;
+  ASSERT_EQ(RC::SUCCESS, file_handler.update_record(rid, record_data, logger));
+  ASSERT_EQ(RC::SUCCESS, bp->get_page_lsn(rid.page_num, lsn));
+  ASSERT_EQ(100, lsn);
+
+  next_lsn = 200;
+  ASSERT_EQ(RC::SUCCESS,
+      file_handler.visit_record(rid, false /*readonly*/, [](Record &record) { record.data()[1] = 1; }, logger));
+  ASSERT_EQ(RC::SUCCESS, bp->get_page_lsn(rid.page_num, lsn));
+  ASSERT_EQ(200, lsn);
+
+  // 批量插入时每个页面写一次日志，这批日志覆盖所有的记录
+  const int                 record_num = 1000;
+  std::vector<const char *> datas(record_num, record_data);
+  std::vector<RID>          rids;
+  int                       logged_num = 0;
+  RecordBatchLogger         batch_logger = [&rids, &logged_num](int first, int num) {
+    EXPECT_EQ(logged_num, first);
+    for (int i = first; i < first + num; i++) {
+      EXPECT_EQ(rids[first].page_num, rids[i].page_num);
+    }
+    logged_num += num;
+    return static_cast<LSN>(1000 + first);
+  };
+  ASSERT_EQ(RC::SUCCESS, file_handler.insert_records(datas, sizeof(record_data), rids, batch_logger));
+  ASSERT_EQ(record_num, logged_num);
+  for (int i = 0; i < record_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, bp->get_page_lsn(rids[i].page_num, lsn));
+    ASSERT_GE(lsn, 1000);
+    ASSERT_LE(lsn, 1000 + i);
+  }
+
+  next_lsn = 3000;
+  ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rid, logger));
+  ASSERT_EQ(RC::SUCCESS, bp->get_page_lsn(rid.page_num, lsn));
+  ASSERT_EQ(3000, lsn);
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
+TEST(test_record_page_handler, test_zone_map)
+{
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  RC                 rc  = bpm->create_file(record_manager_file);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  rc = bpm->open_file(record_manager_file, bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  RecordFileHandler file_handler;
+  file_handler.zone_map().init({FieldMeta("id", INTS, 0, sizeof(int), true)});
+  rc = file_handler.init(bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  // 递增插入，每个页面上的取值范围互不相交
+  const int                 record_insert_num = 1000;
+  std::vector<int>          record_datas(record_insert_num * 5);
+  std::vector<const char *> datas;
+  for (int i = 0; i < record_insert_num; i++) {
+    record_datas[i * 5] = i;
+    datas.push_back(reinterpret_cast<const char *>(&record_datas[i * 5]));
+  }
+
+  std::vector<RID> rids;
+  rc = file_handler.insert_records(datas, 5 * sizeof(int), rids);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  const int page_count = static_cast<int>(file_handler.zone_map().pages().size());
+  ASSERT_GT(page_count, 1);
+
+  ZoneMapFilter filter;
+  filter.init(&file_handler.zone_map());
+  ASSERT_TRUE(filter.add_condition(FieldMeta("id", INTS, 0, sizeof(int), true), EQUAL_TO, Value(10)));
+  ASSERT_TRUE(filter.may_match(rids[10].page_num));
+  ASSERT_FALSE(filter.may_match(rids[record_insert_num - 1].page_num));
+  ASSERT_EQ(filter.skippable_page_count(), page_count - 1);
+
+  VacuousTrx        trx;
+  RecordFileScanner file_scanner;
+  rc = file_scanner.open_scan(
+      nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr /*condition_filter*/, &file_handler, &filter);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  bool   found = false;
+  Record record;
+  while (file_scanner.has_next()) {
+    rc = file_scanner.next(record);
+    ASSERT_EQ(rc, RC::SUCCESS);
+    found = found || record.rid() == rids[10];
+  }
+  ASSERT_TRUE(found);
+  ASSERT_EQ(file_scanner.skipped_page_count(), page_count - 1);
+  file_scanner.close_scan();
+
+  // 更新会扩大页面的取值范围
+  int new_data[5] = {10, 0, 0, 0, 0};
+  rc = file_handler.update_record(rids[record_insert_num - 1], reinterpret_cast<const char *>(new_data));
+  ASSERT_EQ(rc, RC::SUCCESS);
+  ASSERT_TRUE(filter.may_match(rids[record_insert_num - 1].page_num));
+  ASSERT_EQ(filter.skippable_page_count(), page_count - 2);
+
   bpm->close_file(record_manager_file);
   delete bpm;
 }
@@ -193,3 +417,168 @@ int main(int argc, char **argv)
   // main函数返回RUN_ALL_TESTS()的运行结果
   return RUN_ALL_TESTS();
 }
+
+TEST(test_record_page_handler, test_pax_record_page_handler)
+{
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  RC                 rc  = bpm->create_file(record_manager_file);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  rc = bpm->open_file(record_manager_file, bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  Frame *frame = nullptr;
+  rc           = bp->allocate_page(&frame);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  // 三列，长度分别是4、8、4
+  const std::vector<ColumnDesc> columns = {{4, INTS}, {8, CHARS}, {4, INTS}};
+  const int              record_size = 16;
+
+  std::unique_ptr<RecordPageHandler> record_page_handle(RecordPageHandler::create(StorageFormat::PAX_FORMAT));
+  rc = record_page_handle->init_empty_page(*bp, frame->page_num(), record_size, columns);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  const int record_num = 20;
+  RID       rids[record_num];
+  char      buf[record_size];
+  for (int i = 0; i < record_num; i++) {
+    memset(buf, i, 4);
+    memset(buf + 4, i + 100, 8);
+    memset(buf + 12, i + 200, 4);
+    rc = record_page_handle->insert_record(buf, &rids[i]);
+    ASSERT_EQ(rc, RC::SUCCESS);
+  }
+
+  Record record;
+  for (int i = 0; i < record_num; i++) {
+    rc = record_page_handle->get_record(&rids[i], &record);
+    ASSERT_EQ(rc, RC::SUCCESS);
+    ASSERT_EQ(record.len(), record_size);
+    ASSERT_EQ(record.data()[0], (char)i);
+    ASSERT_EQ(record.data()[4], (char)(i + 100));
+    ASSERT_EQ(record.data()[15], (char)(i + 200));
+  }
+
+  memset(buf, 7, record_size);
+  rc = record_page_handle->update_record(rids[3], buf);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  rc = record_page_handle->delete_record(&rids[5]);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  // 只读取第一列和第三列，第二列填充为0
+  const std::vector<bool> projection = {true, false, true};
+  RecordPageIterator      iterator;
+  iterator.init(*record_page_handle, 0, &projection);
+
+  int count = 0;
+  while (iterator.has_next()) {
+    rc = iterator.next(record);
+    ASSERT_EQ(rc, RC::SUCCESS);
+
+    const int i = record.rid().slot_num;
+    ASSERT_NE(i, 5);
+    const char first = (i == 3) ? 7 : (char)i;
+    const char third = (i == 3) ? 7 : (char)(i + 200);
+    ASSERT_EQ(record.data()[0], first);
+    ASSERT_EQ(record.data()[4], 0);
+    ASSERT_EQ(record.data()[11], 0);
+    ASSERT_EQ(record.data()[12], third);
+    count++;
+  }
+  ASSERT_EQ(count, record_num - 1);
+
+  record_page_handle->cleanup();
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
+TEST(test_record_page_handler, test_dispose_empty_page)
+{
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  RC                 rc  = bpm->create_file(record_manager_file);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  rc = bpm->open_file(record_manager_file, bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  RecordFileHandler file_handler;
+  rc = file_handler.init(bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  char             record_data[20];
+  std::vector<RID> rids;
+  for (int i = 0; i < 1000; i++) {
+    RID rid;
+    memset(record_data, 0, sizeof(record_data));
+    memcpy(record_data, &i, sizeof(i));
+    rc = file_handler.insert_record(record_data, sizeof(record_data), &rid);
+    ASSERT_EQ(rc, RC::SUCCESS);
+    rids.push_back(rid);
+  }
+
+  std::vector<RecordPageUsage> usages;
+  rc = file_handler.get_page_usages(usages);
+  ASSERT_EQ(rc, RC::SUCCESS);
+  ASSERT_GT(usages.size(), 1);
+
+  // 删除第一个页面上所有的记录
+  const PageNum first_page = rids[0].page_num;
+  int           page_records = 0;
+  for (const RID &rid : rids) {
+    if (rid.page_num == first_page) {
+      page_records++;
+    }
+  }
+
+  std::vector<Record> records;
+  rc = file_handler.get_page_records(first_page, records);
+  ASSERT_EQ(rc, RC::SUCCESS);
+  ASSERT_EQ(static_cast<int>(records.size()), page_records);
+  ASSERT_EQ(records[0].rid().page_num, first_page);
+
+  // 页面上还有记录时不能释放
+  ASSERT_EQ(file_handler.dispose_page(first_page), RC::LOCKED_UNLOCK);
+
+  for (const RID &rid : rids) {
+    if (rid.page_num == first_page) {
+      rc = file_handler.delete_record(&rid);
+      ASSERT_EQ(rc, RC::SUCCESS);
+    }
+  }
+
+  rc = file_handler.dispose_page(first_page);
+  ASSERT_EQ(rc, RC::SUCCESS);
+  ASSERT_EQ(file_handler.dispose_page(first_page), RC::NOTFOUND);
+
+  usages.clear();
+  rc = file_handler.get_page_usages(usages);
+  ASSERT_EQ(rc, RC::SUCCESS);
+  for (const RecordPageUsage &usage : usages) {
+    ASSERT_NE(usage.page_num, first_page);
+  }
+
+  // 释放的页面可以重新分配
+  RID rid;
+  for (int i = 0; i <= page_records; i++) {
+    rc = file_handler.insert_record(record_data, sizeof(record_data), &rid);
+    ASSERT_EQ(rc, RC::SUCCESS);
+  }
+  usages.clear();
+  rc = file_handler.get_page_usages(usages);
+  ASSERT_EQ(rc, RC::SUCCESS);
+  ASSERT_EQ(usages.front().page_num, first_page);
+
+  file_handler.close();
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
@@ -0,0 +1,689 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+
+#include "json/json.h"
+
+#include "common/global_context.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/clog/clog.h"
+#include "storage/db/db.h"
+#include "storage/db/db_backup.h"
+#include "storage/db/db_xid_upgrade.h"
+#include "storage/common/meta_util.h"
+#include "storage/index/index.h"
+#include "storage/table/table.h"
+#include "storage/record/record_manager.h"
+#include "storage/trx/trx.h"
+#include "storage/trx/xid.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace common;
+
+/**
+ * @brief 在子进程中执行 func，结束时直接退出进程，不刷脏页也不写检查点，相当于宕机
+ * @details 事务模块的全局对象只能初始化一次，每次"启动"都放到一个新的子进程中
+ * @return 子进程中的检查是否全部通过
+ */
+static bool run_offline_in_process(const function<void()> &func)
+{
+  pid_t pid = fork();
+  if (pid == 0) {
+    BufferPoolManager::set_instance(new BufferPoolManager());
+    if (TrxKit::init_global("mvcc") != RC::SUCCESS) {
+      _exit(1);
+    }
+    GCTX.trx_kit_ = TrxKit::instance();
+
+    func();
+    _exit(testing::Test::HasFailure() ? 1 : 0);
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/**
+ * @brief 在子进程中打开数据库并执行 func，打开数据库时会做恢复。参考 run_offline_in_process
+ */
+static bool run_in_process(const char *path, const function<void(Db &db)> &func)
+{
+  return run_offline_in_process([path, &func]() {
+    Db *db = new Db();
+    RC  rc = db->init("recovery_test", path);
+    EXPECT_EQ(RC::SUCCESS, rc);
+    if (OB_SUCC(rc)) {
+      func(*db);
+    }
+  });
+}
+
+static void create_table(Db &db, const char *table_name)
+{
+  AttrInfoSqlNode attrs[2];
+  attrs[0].type   = INTS;
+  attrs[0].name   = "id";
+  attrs[0].length = sizeof(int);
+  attrs[1].type   = INTS;
+  attrs[1].name   = "v";
+  attrs[1].length = sizeof(int);
+  ASSERT_EQ(RC::SUCCESS, db.create_table(table_name, 2, attrs, StorageFormat::ROW_FORMAT));
+}
+
+static int field_value(Table *table, const Record &record, const char *field_name)
+{
+  const FieldMeta *field = table->table_meta().field(field_name);
+  return *(const int *)(record.data() + field->offset());
+}
+
+TEST(recovery, test_rollback_uncommitted_update_after_checkpoint)
+{
+  const char *path = "recovery_test_uncommitted_update";
+  filesystem::remove_all(path);
+  filesystem::create_directories(path);
+
+  // 提交一条记录，再在另一个事务中修改它但不提交，检查点把修改过的页面刷到磁盘以后宕机
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    create_table(db, "t");
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    Value  values[2] = {Value(1), Value(100)};
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, record));
+
+    Trx *trx = TrxKit::instance()->create_trx(db.clog_manager());
+    ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+    ASSERT_EQ(RC::SUCCESS, trx->insert_record(table, record));
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+    ASSERT_EQ(RID(1, 0), record.rid());
+
+    Record target_record;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(record.rid(), target_record));
+    values[1] = Value(200);
+    Record new_record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, new_record));
+
+    Trx *update_trx = TrxKit::instance()->create_trx(db.clog_manager());
+    ASSERT_EQ(RC::SUCCESS, update_trx->start_if_need());
+    ASSERT_EQ(RC::SUCCESS, update_trx->update_record(table, target_record, new_record));
+
+    ASSERT_EQ(RC::SUCCESS, db.sync());
+
+    Record flushed_record;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(record.rid(), flushed_record));
+    ASSERT_EQ(200, field_value(table, flushed_record, "v"));
+  }));
+
+  // 恢复时未提交的修改要用日志中的旧数据回滚，新的事务能看到并修改原来的值
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(RID(1, 0), record));
+    ASSERT_EQ(1, field_value(table, record, "id"));
+    ASSERT_EQ(100, field_value(table, record, "v"));
+
+    Trx *trx = TrxKit::instance()->create_trx(db.clog_manager());
+    ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+    ASSERT_EQ(RC::SUCCESS, trx->visit_record(table, record, false /*readonly*/));
+
+    Value  values[2] = {Value(1), Value(300)};
+    Record new_record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, new_record));
+    ASSERT_EQ(RC::SUCCESS, trx->update_record(table, record, new_record));
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+  }));
+
+  // 再次恢复以后还是提交的新值
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(RID(1, 0), record));
+    ASSERT_EQ(300, field_value(table, record, "v"));
+  }));
+}
+
+/**
+ * @brief 异步提交一个更新 v 的事务，提交日志留在日志缓存中
+ */
+static void update_async(Db &db, Table *table, int value)
+{
+  Record target_record;
+  ASSERT_EQ(RC::SUCCESS, table->get_record(RID(1, 0), target_record));
+  Value  values[2] = {Value(1), Value(value)};
+  Record new_record;
+  ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, new_record));
+
+  Trx *trx = TrxKit::instance()->create_trx(db.clog_manager());
+  trx->set_async_commit(true);
+  ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+  ASSERT_EQ(RC::SUCCESS, trx->update_record(table, target_record, new_record));
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  ASSERT_GT(db.clog_manager()->current_lsn(), db.clog_manager()->durable_lsn());
+}
+
+/**
+ * @brief 用一个只读事务扫描一遍表，返回扫描之后页面上记录的开始事务号。只读事务提交时不写日志
+ */
+static void scan_and_get_begin_xid(Db &db, Table *table, int64_t &begin_xid)
+{
+  Trx *trx = TrxKit::instance()->create_trx(db.clog_manager());
+  trx->set_read_only(true);
+  ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+
+  RecordFileScanner scanner;
+  ASSERT_EQ(RC::SUCCESS, table->get_record_scanner(scanner, trx, true /*readonly*/));
+  Record record;
+  int    count = 0;
+  while (scanner.has_next()) {
+    ASSERT_EQ(RC::SUCCESS, scanner.next(record));
+    count++;
+  }
+  ASSERT_EQ(1, count);
+  scanner.close_scan();
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+
+  Record page_record;
+  ASSERT_EQ(RC::SUCCESS, table->get_record(RID(1, 0), page_record));
+  XidField begin_field(&table->table_meta().trx_fields().first[0]);
+  begin_xid = begin_field.get(page_record);
+}
+
+TEST(recovery, test_hint_xids_wait_for_durable_commit)
+{
+  const char *path = "recovery_test_hint_xids";
+  filesystem::remove_all(path);
+  filesystem::create_directories(path);
+
+  // 异步提交的更新，提交日志落盘之前，读取的事务不能把提交事务号写到页面上，落盘以后才可以
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    db.clog_manager()->set_async_flush_interval(3600 * 1000);
+    create_table(db, "t");
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    Value  values[2] = {Value(1), Value(100)};
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, record));
+    Trx *trx = TrxKit::instance()->create_trx(db.clog_manager());
+    ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+    ASSERT_EQ(RC::SUCCESS, trx->insert_record(table, record));
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+    ASSERT_EQ(RC::SUCCESS, db.sync());
+
+    update_async(db, table, 200);
+    int64_t begin_xid = 0;
+    scan_and_get_begin_xid(db, table, begin_xid);
+    ASSERT_TRUE(Xid::is_uncommitted(begin_xid));
+
+    ASSERT_EQ(RC::SUCCESS, db.clog_manager()->sync());
+    scan_and_get_begin_xid(db, table, begin_xid);
+    ASSERT_FALSE(Xid::is_uncommitted(begin_xid));
+  }));
+
+  // 恢复时重做落盘的提交日志。页面写到磁盘之前，日志缓存中的提交日志先落盘
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    db.clog_manager()->set_async_flush_interval(3600 * 1000);
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(RID(1, 0), record));
+    ASSERT_EQ(200, field_value(table, record, "v"));
+
+    update_async(db, table, 300);
+    int64_t begin_xid = 0;
+    scan_and_get_begin_xid(db, table, begin_xid);
+    ASSERT_TRUE(Xid::is_uncommitted(begin_xid));
+
+    ASSERT_EQ(RC::SUCCESS, table->sync());
+    ASSERT_EQ(db.clog_manager()->current_lsn(), db.clog_manager()->durable_lsn());
+  }));
+
+  // 提交日志没有落盘的异步提交在宕机以后丢失，恢复时回滚
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    db.clog_manager()->set_async_flush_interval(3600 * 1000);
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(RID(1, 0), record));
+    ASSERT_EQ(300, field_value(table, record, "v"));
+
+    update_async(db, table, 400);
+    int64_t begin_xid = 0;
+    scan_and_get_begin_xid(db, table, begin_xid);
+    ASSERT_TRUE(Xid::is_uncommitted(begin_xid));
+  }));
+
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(RID(1, 0), record));
+    ASSERT_EQ(300, field_value(table, record, "v"));
+
+    int64_t begin_xid = 0;
+    scan_and_get_begin_xid(db, table, begin_xid);
+    ASSERT_FALSE(Xid::is_uncommitted(begin_xid));
+  }));
+}
+
+/**
+ * @brief 通过索引 index_name 从小到大读取所有的 id
+ */
+static void scan_index(Table *table, const char *index_name, vector<int> &ids)
+{
+  Index *index = table->find_index(index_name);
+  ASSERT_NE(nullptr, index);
+  IndexScanner *scanner = index->create_scanner(nullptr, 0, false, nullptr, 0, false);
+  ASSERT_NE(nullptr, scanner);
+
+  ids.clear();
+  RID rid;
+  while (scanner->next_entry(&rid) == RC::SUCCESS) {
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(rid, record));
+    ids.push_back(field_value(table, record, "id"));
+  }
+  scanner->destroy();
+}
+
+TEST(recovery, test_rebuild_indexes_from_backup)
+{
+  const char *path        = "recovery_test_backup_src";
+  const char *backup_path = "recovery_test_backup_dst";
+  filesystem::remove_all(path);
+  filesystem::remove_all(backup_path);
+  filesystem::create_directories(path);
+
+  static const int record_num = 1000;
+
+  // 备份中的索引是空的，备份之后还在运行的事务的修改由日志恢复
+  ASSERT_TRUE(run_in_process(path, [backup_path](Db &db) {
+    create_table(db, "t");
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    Trx *trx = TrxKit::instance()->create_trx(db.clog_manager());
+    ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+    ASSERT_EQ(RC::SUCCESS, table->create_index(trx, table->table_meta().field("id"), "t_id"));
+    for (int i = record_num - 1; i >= 0; i--) {
+      Value  values[2] = {Value(i), Value(i * 10)};
+      Record record;
+      ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, record));
+      ASSERT_EQ(RC::SUCCESS, trx->insert_record(table, record));
+    }
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+
+    // 没有提交的插入在从备份启动时回滚，索引中也不能有它
+    Trx   *uncommitted_trx = TrxKit::instance()->create_trx(db.clog_manager());
+    Value  values[2]       = {Value(record_num), Value(0)};
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, uncommitted_trx->start_if_need());
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, record));
+    ASSERT_EQ(RC::SUCCESS, uncommitted_trx->insert_record(table, record));
+
+    BackupStat stat;
+    ASSERT_EQ(RC::SUCCESS, db.backup(backup_path, stat));
+    ASSERT_EQ(1, stat.tables);
+  }));
+
+  ASSERT_TRUE(run_in_process(backup_path, [backup_path](Db &db) {
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    vector<int> ids;
+    scan_index(table, "t_id", ids);
+    ASSERT_EQ(record_num, static_cast<int>(ids.size()));
+    for (int i = 0; i < record_num; i++) {
+      ASSERT_EQ(i, ids[i]);
+    }
+
+    const string label_file = string(backup_path) + "/" + DbBackup::LABEL_FILE_NAME;
+    ASSERT_FALSE(filesystem::exists(label_file));
+    ASSERT_TRUE(filesystem::exists(label_file + DbBackup::USED_LABEL_SUFFIX));
+  }));
+
+  // 重建过的索引已经写到磁盘，再次启动时直接使用
+  ASSERT_TRUE(run_in_process(backup_path, [](Db &db) {
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    vector<int> ids;
+    scan_index(table, "t_id", ids);
+    ASSERT_EQ(record_num, static_cast<int>(ids.size()));
+  }));
+}
+
+/**
+ * @brief 通过索引 index_name 读取所有的索引项，不检查记录是否存在
+ */
+static void scan_index_rids(Table *table, const char *index_name, vector<RID> &rids)
+{
+  Index *index = table->find_index(index_name);
+  ASSERT_NE(nullptr, index);
+  IndexScanner *scanner = index->create_scanner(nullptr, 0, false, nullptr, 0, false);
+  ASSERT_NE(nullptr, scanner);
+
+  rids.clear();
+  RID rid;
+  while (scanner->next_entry(&rid) == RC::SUCCESS) {
+    rids.push_back(rid);
+  }
+  scanner->destroy();
+}
+
+static int count_records(Table *table)
+{
+  RecordFileScanner scanner;
+  EXPECT_EQ(RC::SUCCESS, table->get_record_scanner(scanner, nullptr /*trx*/, true /*readonly*/));
+  int    count = 0;
+  Record record;
+  while (scanner.has_next()) {
+    EXPECT_EQ(RC::SUCCESS, scanner.next(record));
+    count++;
+  }
+  scanner.close_scan();
+  return count;
+}
+
+static void make_records(Table *table, const vector<int> &ids, vector<Record> &records)
+{
+  records.clear();
+  records.resize(ids.size());
+  for (size_t i = 0; i < ids.size(); i++) {
+    Value values[2] = {Value(ids[i]), Value(ids[i] * 10)};
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, records[i]));
+  }
+}
+
+TEST(recovery, test_insert_records_with_index)
+{
+  const char *path = "recovery_test_insert_records";
+  filesystem::remove_all(path);
+  filesystem::create_directories(path);
+
+  static const int record_num = 1000;
+
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    // 建表和建索引不记录日志，先刷盘
+    create_table(db, "t");
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+    ASSERT_EQ(RC::SUCCESS, table->create_index(nullptr, table->table_meta().field("id"), "t_id"));
+
+    create_table(db, "t2");
+    Table *table2 = db.find_table("t2");
+    ASSERT_NE(nullptr, table2);
+    ASSERT_EQ(RC::SUCCESS, table2->create_index(nullptr, table2->table_meta().field("id"), "t2_id"));
+    ASSERT_EQ(RC::SUCCESS, db.sync());
+
+    // 一次插入跨越多个页面的一批记录，键值是乱序的，索引中按照键值排好序
+
+    vector<int> ids;
+    for (int i = 0; i < record_num; i++) {
+      ids.push_back(i * 7919 % record_num);
+    }
+    vector<Record> records;
+    make_records(table, ids, records);
+
+    Trx *trx = TrxKit::instance()->create_trx(db.clog_manager());
+    ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+    ASSERT_EQ(RC::SUCCESS, trx->insert_records(table, records));
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+    ASSERT_EQ(RID(1, 0), records.front().rid());
+    ASSERT_GT(records.back().rid().page_num, 1);
+
+    vector<int> index_ids;
+    scan_index(table, "t_id", index_ids);
+    ASSERT_EQ(record_num, static_cast<int>(index_ids.size()));
+    for (int i = 0; i < record_num; i++) {
+      ASSERT_EQ(i, index_ids[i]);
+    }
+
+    // 另一张表中有一个索引项与第6条记录的键值和位置都相同，插入索引时键值重复，整批记录都要回滚
+    make_records(table2, {9, 3, 7, 1, 5, 2, 8, 0, 6, 4}, records);
+    const RID stale_rid(1, 5);
+    ASSERT_EQ(RC::SUCCESS, table2->find_index("t2_id")->insert_entry(records[5].data(), &stale_rid));
+
+    Trx *dup_trx = TrxKit::instance()->create_trx(db.clog_manager());
+    ASSERT_EQ(RC::SUCCESS, dup_trx->start_if_need());
+    ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, dup_trx->insert_records(table2, records));
+    ASSERT_EQ(RC::SUCCESS, dup_trx->rollback());
+
+    ASSERT_EQ(0, count_records(table2));
+    vector<RID> rids;
+    scan_index_rids(table2, "t2_id", rids);
+    ASSERT_EQ(vector<RID>{stale_rid}, rids);
+
+    // 第一张表不受影响
+    ASSERT_EQ(record_num, count_records(table));
+  }));
+
+  // 回滚的记录在恢复后也不能出现，提交的记录和索引都还在
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    Table *table  = db.find_table("t");
+    Table *table2 = db.find_table("t2");
+    ASSERT_NE(nullptr, table);
+    ASSERT_NE(nullptr, table2);
+
+    ASSERT_EQ(record_num, count_records(table));
+    ASSERT_EQ(0, count_records(table2));
+
+    vector<int> index_ids;
+    scan_index(table, "t_id", index_ids);
+    ASSERT_EQ(record_num, static_cast<int>(index_ids.size()));
+    for (int i = 0; i < record_num; i++) {
+      ASSERT_EQ(i, index_ids[i]);
+    }
+  }));
+}
+
+/**
+ * @brief 生成一个事务号改成64位之前的数据库
+ * @details 表 t(id, v) 的事务号字段是4个字节，id 上有索引 t_id，日志以一个旧格式的 checkpoint 结尾。
+ * clean 为 false 时 checkpoint 之后还有一个事务的日志，相当于没有正常关闭
+ */
+static void make_legacy_db(const char *path, bool clean)
+{
+  filesystem::remove_all(path);
+  filesystem::create_directories(path);
+
+  // 先按照当前的格式建表，再把元数据中的事务号字段改成4个字节，用户字段跟着前移
+  ASSERT_TRUE(run_offline_in_process([path]() {
+    AttrInfoSqlNode attrs[2];
+    attrs[0].type   = INTS;
+    attrs[0].name   = "id";
+    attrs[0].length = sizeof(int);
+    attrs[1].type   = INTS;
+    attrs[1].name   = "v";
+    attrs[1].length = sizeof(int);
+
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.create(1, table_meta_file(path, "t").c_str(), "t", path, 2, attrs));
+    ASSERT_EQ(RC::SUCCESS, table.create_index(nullptr, table.table_meta().field("id"), "t_id"));
+  }));
+
+  const string meta_file = table_meta_file(path, "t");
+  Json::Value  table_value;
+  {
+    ifstream is(meta_file);
+    ASSERT_TRUE(Json::Reader().parse(is, table_value));
+  }
+  Json::Value &fields_value = table_value["fields"];
+  int          offset       = 0;
+  for (Json::Value &field_value : fields_value) {
+    const string name = field_value["name"].asString();
+    if (name == "__trx_xid_begin" || name == "__trx_xid_end") {
+      field_value["len"] = 4;
+    }
+    field_value["offset"] = offset;
+    offset += field_value["len"].asInt();
+  }
+  {
+    ofstream os(meta_file, ios::trunc);
+    os << table_value.toStyledString();
+  }
+
+  // 旧格式的记录：开始事务号、结束事务号(INT32_MAX 表示没有删除)、id、v。id=3 的记录在事务号8删除了
+  ASSERT_TRUE(run_offline_in_process([path, clean]() {
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.open("t.table", path, true /*allow_legacy_xid*/));
+    ASSERT_EQ(16, table.table_meta().record_size());
+
+    const int32_t rows[][4] = {{3, 8, 3, 300}, {5, INT32_MAX, 1, 100}, {7, INT32_MAX, 2, 200}};
+    for (const int32_t *row : rows) {
+      char   data[16];
+      Record record;
+      memcpy(data, row, sizeof(data));
+      record.set_data(data, sizeof(data));
+      ASSERT_EQ(RC::SUCCESS, table.insert_record(record));
+    }
+    ASSERT_EQ(RC::SUCCESS, table.sync());
+
+    // begin_lsn, redo_lsn, 32位的最大事务号, 事务个数
+    CLogManager log_manager;
+    ASSERT_EQ(RC::SUCCESS, log_manager.init(path));
+    vector<char> buffer;
+    auto         append = [&buffer](const auto &value) {
+      const char *ptr = reinterpret_cast<const char *>(&value);
+      buffer.insert(buffer.end(), ptr, ptr + sizeof(value));
+    };
+    const int64_t checkpoint_lsn = log_manager.current_lsn();
+    append(checkpoint_lsn);
+    append(checkpoint_lsn);
+    append(int32_t(9));
+    append(int32_t(0));
+    CLogRecord *checkpoint_record = CLogRecord::build_data_record(CLogType::CHECKPOINT,
+        -1 /*trx_id*/, -1 /*table_id*/, RID(-1, -1), static_cast<int32_t>(buffer.size()), 0 /*data_offset*/, buffer.data());
+    int64_t lsn = -1;
+    ASSERT_EQ(RC::SUCCESS, log_manager.append_log(checkpoint_record, &lsn));
+    ASSERT_EQ(checkpoint_lsn, lsn);
+    if (!clean) {
+      ASSERT_EQ(RC::SUCCESS, log_manager.append_log(CLogRecord::build_mtr_record(CLogType::MTR_BEGIN, 10)));
+    }
+    ASSERT_EQ(RC::SUCCESS, log_manager.sync());
+    ASSERT_EQ(RC::SUCCESS, CLogManager::write_control_file(path, checkpoint_lsn));
+  }));
+}
+
+TEST(recovery, test_upgrade_legacy_xid_db)
+{
+  const char *path = "recovery_test_xid_upgrade";
+  make_legacy_db(path, true /*clean*/);
+
+  // 不升级不能打开
+  ASSERT_FALSE(run_in_process(path, [](Db &db) {}));
+
+  ASSERT_TRUE(run_offline_in_process([path]() {
+    DbXidUpgrade upgrade(path);
+    ASSERT_EQ(RC::SUCCESS, upgrade.upgrade());
+    ASSERT_EQ(1, upgrade.upgraded_tables());
+    ASSERT_EQ(9, upgrade.max_trx_id());
+  }));
+
+  // 再执行一次什么都不做
+  ASSERT_TRUE(run_offline_in_process([path]() {
+    DbXidUpgrade upgrade(path);
+    ASSERT_EQ(RC::SUCCESS, upgrade.upgrade());
+    ASSERT_EQ(0, upgrade.upgraded_tables());
+  }));
+  ASSERT_FALSE(filesystem::exists(string(path) + "/xid_upgrade"));
+
+  // 记录上的事务号扩展成8个字节，新的事务号从旧的最大事务号之后开始分配，索引重新建立
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+    ASSERT_EQ(Xid::LEN, table->table_meta().trx_fields().first[0].len());
+
+    vector<int> ids;
+    scan_index(table, "t_id", ids);
+    ASSERT_EQ((vector<int>{1, 2, 3}), ids);
+
+    Trx *trx = TrxKit::instance()->create_trx(db.clog_manager());
+    ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+    ASSERT_GT(trx->id(), 9);
+
+    XidField          begin_field(&table->table_meta().trx_fields().first[0]);
+    XidField          end_field(&table->table_meta().trx_fields().first[1]);
+    RecordFileScanner scanner;
+    ASSERT_EQ(RC::SUCCESS, table->get_record_scanner(scanner, trx, true /*readonly*/));
+    map<int, int> values;
+    Record        record;
+    while (scanner.has_next()) {
+      ASSERT_EQ(RC::SUCCESS, scanner.next(record));
+      values[field_value(table, record, "id")] = field_value(table, record, "v");
+      if (field_value(table, record, "id") == 1) {
+        ASSERT_EQ(5, begin_field.get(record));
+        ASSERT_EQ(Xid::MAX, end_field.get(record));
+      }
+    }
+    scanner.close_scan();
+    ASSERT_EQ((map<int, int>{{1, 100}, {2, 200}}), values);
+
+    Value  new_values[2] = {Value(4), Value(400)};
+    Record new_record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, new_values, new_record));
+    ASSERT_EQ(RC::SUCCESS, trx->insert_record(table, new_record));
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+  }));
+
+  ASSERT_TRUE(run_in_process(path, [](Db &db) {
+    Table *table = db.find_table("t");
+    ASSERT_NE(nullptr, table);
+
+    vector<int> ids;
+    scan_index(table, "t_id", ids);
+    ASSERT_EQ((vector<int>{1, 2, 3, 4}), ids);
+  }));
+}
+
+TEST(recovery, test_upgrade_unclean_legacy_xid_db)
+{
+  const char *path = "recovery_test_xid_upgrade_unclean";
+  make_legacy_db(path, false /*clean*/);
+
+  // checkpoint 之后还有日志，升级失败，表保持原来的格式
+  ASSERT_TRUE(run_offline_in_process([path]() {
+    DbXidUpgrade upgrade(path);
+    ASSERT_EQ(RC::INVALID_ARGUMENT, upgrade.upgrade());
+
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.open("t.table", path, true /*allow_legacy_xid*/));
+    ASSERT_EQ(4, table.table_meta().trx_fields().first[0].len());
+  }));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  LoggerFactory::init_default("recovery_test.log", LOG_LEVEL_INFO);
+  return RUN_ALL_TESTS();
+}
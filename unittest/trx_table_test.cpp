@@ -0,0 +1,63 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include <limits>
+#include <vector>
+
+#include "storage/trx/trx_table.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(trx_table, test_find_and_min)
+{
+  TrxTable table;
+  ASSERT_TRUE(table.empty());
+  ASSERT_EQ(numeric_limits<int64_t>::max(), table.min_trx_id());
+
+  // 只用作指针的值，不会访问
+  vector<char> trxes(100);
+  auto         trx = [&trxes](int64_t trx_id) { return reinterpret_cast<Trx *>(&trxes[trx_id]); };
+  for (int64_t trx_id = 1; trx_id < 100; trx_id++) {
+    table.insert(trx_id, trx(trx_id));
+  }
+  ASSERT_FALSE(table.empty());
+  ASSERT_EQ(1, table.min_trx_id());
+  ASSERT_EQ(trx(50), table.find(50));
+  ASSERT_EQ(nullptr, table.find(100));
+
+  // 同一个事务号对应的不是这个事务时不删除
+  table.remove(1, trx(2));
+  ASSERT_EQ(trx(1), table.find(1));
+
+  table.remove(1);
+  table.remove(2, trx(2));
+  ASSERT_EQ(nullptr, table.find(1));
+  ASSERT_EQ(3, table.min_trx_id());
+
+  vector<Trx *> all;
+  table.all(all);
+  ASSERT_EQ(97, static_cast<int>(all.size()));
+
+  for (int64_t trx_id = 3; trx_id < 100; trx_id++) {
+    table.remove(trx_id);
+  }
+  ASSERT_TRUE(table.empty());
+  ASSERT_EQ(numeric_limits<int64_t>::max(), table.min_trx_id());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
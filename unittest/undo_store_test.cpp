@@ -0,0 +1,128 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+#include <string.h>
+#include <vector>
+
+#include "storage/trx/undo_store.h"
+#include "storage/trx/xid.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+/**
+ * @brief 版本的数据就是一个整数，方便检查读到的是哪个版本
+ */
+static RC find_visible(UndoStore &store, const RID &rid, int64_t trx_id, int &value)
+{
+  auto visible = [trx_id](int64_t begin_xid, int64_t end_xid) {
+    return trx_id >= begin_xid && (Xid::is_uncommitted(end_xid) ? Xid::trx_id(end_xid) != trx_id : trx_id <= end_xid);
+  };
+
+  int64_t      begin_xid = 0;
+  int64_t      end_xid   = 0;
+  vector<char> data;
+  RC           rc = store.find_version(1 /*table_id*/, rid, visible, begin_xid, end_xid, &data);
+  if (OB_SUCC(rc)) {
+    memcpy(&value, data.data(), sizeof(value));
+  }
+  return rc;
+}
+
+TEST(test_undo_store, test_version_chain)
+{
+  UndoStore store;
+  RID       rid(1, 1);
+
+  // 事务2在事务1之后开始，事务3把值从10改成20并提交，提交事务号是4
+  int value = 10;
+  ASSERT_EQ(RC::SUCCESS, store.push(1, rid, 3, 1 /*begin_xid*/, reinterpret_cast<const char *>(&value), sizeof(value)));
+  ASSERT_TRUE(store.contains(1, rid));
+  ASSERT_EQ(1, store.version_count());
+
+  int got = 0;
+  ASSERT_EQ(RC::SUCCESS, find_visible(store, rid, 2, got));
+  ASSERT_EQ(10, got);
+  // 覆盖旧版本的事务自己看不到旧版本
+  ASSERT_EQ(RC::RECORD_INVISIBLE, find_visible(store, rid, 3, got));
+
+  store.commit(1, rid, 3, 4);
+  ASSERT_EQ(RC::SUCCESS, find_visible(store, rid, 2, got));
+  ASSERT_EQ(10, got);
+  ASSERT_EQ(RC::RECORD_INVISIBLE, find_visible(store, rid, 5, got));
+
+  // 事务6把值改成30，旧版本从新到旧排列
+  value = 20;
+  ASSERT_EQ(RC::SUCCESS, store.push(1, rid, 6, 4 /*begin_xid*/, reinterpret_cast<const char *>(&value), sizeof(value)));
+  ASSERT_EQ(RC::SUCCESS, find_visible(store, rid, 5, got));
+  ASSERT_EQ(20, got);
+  ASSERT_EQ(RC::SUCCESS, find_visible(store, rid, 2, got));
+  ASSERT_EQ(10, got);
+
+  // 回滚只删除自己创建的版本
+  store.pop(1, rid, 3);
+  ASSERT_EQ(2, store.version_count());
+  store.pop(1, rid, 6);
+  ASSERT_EQ(1, store.version_count());
+
+  // 事务2还在运行时不能清理
+  store.purge(2);
+  ASSERT_EQ(1, store.version_count());
+  store.purge(5);
+  ASSERT_EQ(0, store.version_count());
+  ASSERT_FALSE(store.contains(1, rid));
+  ASSERT_EQ(0, store.memory_bytes());
+}
+
+TEST(test_undo_store, test_spill)
+{
+  UndoStore store;
+  store.set_memory_limit(64 * sizeof(int));
+
+  const int record_num = 1000;
+  for (int i = 0; i < record_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, store.push(1, RID(1, i), 2, 1, reinterpret_cast<const char *>(&i), sizeof(i)));
+  }
+  ASSERT_EQ(record_num, store.version_count());
+  ASSERT_LE(store.memory_bytes(), store.memory_limit());
+  ASSERT_GT(store.spilled_bytes(), 0);
+
+  for (int i = 0; i < record_num; i++) {
+    int got = -1;
+    ASSERT_EQ(RC::SUCCESS, find_visible(store, RID(1, i), 1, got));
+    ASSERT_EQ(i, got);
+  }
+
+  vector<RID> rids;
+  store.collect_rids(1, [](const char *data, int) { return *reinterpret_cast<const int *>(data) % 100 == 0; }, rids);
+  ASSERT_EQ(static_cast<size_t>(record_num / 100), rids.size());
+
+  for (int i = 0; i < record_num; i++) {
+    store.commit(1, RID(1, i), 2, 3);
+  }
+  store.purge(4);
+  ASSERT_EQ(0, store.version_count());
+  ASSERT_EQ(0, store.spilled_bytes());
+
+  // 清空以后临时文件重新从头使用
+  int value = 7;
+  ASSERT_EQ(RC::SUCCESS, store.push(1, RID(2, 1), 5, 4, reinterpret_cast<const char *>(&value), sizeof(value)));
+  store.remove_table(1);
+  ASSERT_EQ(0, store.version_count());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
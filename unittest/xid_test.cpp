@@ -0,0 +1,44 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by annya on 2026/10/19.
+//
+
+#include <string.h>
+
+#include "storage/field/field_meta.h"
+#include "storage/record/record.h"
+#include "storage/trx/xid.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(xid, test_xid_field)
+{
+  char   data[Xid::LEN] = {0};
+  Record record;
+  record.set_data(data, sizeof(data));
+
+  FieldMeta field_meta("__trx_xid_begin", AttrType::INTS, 0, Xid::LEN, false);
+  XidField  field(&field_meta);
+
+  const int64_t xids[] = {1, 5000000000LL, Xid::uncommitted(5000000000LL), Xid::MAX};
+  for (int64_t xid : xids) {
+    field.set(record, xid);
+    ASSERT_EQ(xid, field.get(record));
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}